@@ -0,0 +1,287 @@
+/*************************************************************************
+	> File Name: binaryDataset.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时43分46秒
+ ************************************************************************/
+
+#ifndef _BINARYDATASET_H
+#define _BINARYDATASET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 二进制数据集文件(POSIX): 测试与性能测试用的只含一列算术类型数据的文件
+/*
+ * 文件格式(小端, 与写入的机器相同):
+ *      --[0, dataset_header_bytes): DatasetHeader, 其余部分为0;
+ *      --[dataset_header_bytes, dataset_header_bytes + count * element_size): 数据, 按元素依次存放.
+ * 数据从4096字节处开始, mmap以后数据按页对齐, 也满足O_DIRECT对文件偏移的要求.
+ *
+ */
+const char dataset_magic[8] = {'Z', 'Z', 'D', 'A', 'T', 'A', 'S', 'T'};
+const std::uint32_t dataset_version = 1;
+const std::size_t dataset_header_bytes = 4096;
+const std::size_t dataset_buffer_bytes = std::size_t(4) << 20;     // 写文件时的缓冲区大小(4MB)
+
+enum DatasetType : std::uint32_t
+{
+    dataset_int32 = 1, dataset_int64 = 2, dataset_uint32 = 3, dataset_uint64 = 4, dataset_float = 5, dataset_double = 6
+};
+
+// DatasetFlags: 数据的性质
+enum DatasetFlags : std::uint32_t
+{
+    dataset_sorted = 1      // 数据从小到大有序
+};
+
+struct DatasetHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t type;             // DatasetType
+    std::uint32_t element_size;
+    std::uint32_t flags;            // DatasetFlags的组合
+    std::uint64_t count;            // 元素个数
+};
+
+// DatasetTypeOf: 元素类型对应的DatasetType
+template<typename T> struct DatasetTypeOf;
+template<> struct DatasetTypeOf<std::int32_t> { static const std::uint32_t value = dataset_int32; };
+template<> struct DatasetTypeOf<std::int64_t> { static const std::uint32_t value = dataset_int64; };
+template<> struct DatasetTypeOf<std::uint32_t> { static const std::uint32_t value = dataset_uint32; };
+template<> struct DatasetTypeOf<std::uint64_t> { static const std::uint32_t value = dataset_uint64; };
+template<> struct DatasetTypeOf<float> { static const std::uint32_t value = dataset_float; };
+template<> struct DatasetTypeOf<double> { static const std::uint32_t value = dataset_double; };
+
+// readDatasetHeader: 读取并检查文件头, 不是数据集文件时抛出std::runtime_error
+inline DatasetHeader readDatasetHeader(const std::string &filename)
+{
+    DatasetHeader header;
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("readDatasetHeader error: 无法打开文件 " + filename);
+    ssize_t got = ::pread(fd, &header, sizeof(header), 0);
+    ::close(fd);
+    if (got != static_cast<ssize_t>(sizeof(header)) || std::memcmp(header.magic, dataset_magic, sizeof(dataset_magic)) != 0)
+        throw std::runtime_error("readDatasetHeader error: 不是数据集文件 " + filename);
+    if (header.version != dataset_version)
+        throw std::runtime_error("readDatasetHeader error: 不支持的版本 " + filename);
+    return header;
+}
+
+// DatasetWriter: 顺序写入数据集文件
+/*
+ * 数据先放入对齐的大缓冲区, 缓冲区满时一次写入; direct为true时使用O_DIRECT绕过页缓存(写入大文件时
+ * 不会挤占页缓存), 文件系统不支持时退回普通的写入. 写入时判断数据是否有序, close时写入文件头.
+ * 不调用close时析构函数会关闭文件, 但是不报告错误.
+ *
+ */
+template<typename T>
+class DatasetWriter
+{
+    static_assert(std::is_arithmetic<T>::value, "DatasetWriter error: 只支持算术类型");
+public:
+    //****************************构造函数*******************************
+    explicit DatasetWriter(const std::string &filename, bool direct = false)
+        : name(filename), fd(-1), buffer(nullptr), used(dataset_header_bytes), offset(0), count(0), sorted(true), last()
+    {
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+        if (direct)
+            fd = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+#else
+        (void)direct;
+#endif
+        if (fd < 0)
+            fd = ::open(filename.c_str(), flags, 0644);
+        if (fd < 0)
+            throw std::runtime_error("DatasetWriter error: 无法创建文件 " + filename);
+        // O_DIRECT要求缓冲区的地址与长度按块对齐, 按页对齐对所有文件系统都足够
+        if (::posix_memalign(&buffer, dataset_header_bytes, dataset_buffer_bytes) != 0){
+            ::close(fd);
+            throw std::runtime_error("DatasetWriter error: 无法分配缓冲区");
+        }
+        // 缓冲区的开头留给文件头, 第一次写入时它们是占位的0
+        std::memset(buffer, 0, dataset_header_bytes);
+    }
+    DatasetWriter(const DatasetWriter &) = delete;
+    DatasetWriter& operator=(const DatasetWriter &) = delete;
+    ~DatasetWriter()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        std::free(buffer);
+    }
+    //****************************成员函数*******************************
+    void push(const T &x)
+    {
+        if (count != 0 && x < last)
+            sorted = false;
+        last = x;
+        ++count;
+        std::memcpy(static_cast<char *>(buffer) + used, &x, sizeof(T));
+        used += sizeof(T);
+        if (used == dataset_buffer_bytes)
+            flush(used);
+    }
+
+    template<typename Iterator>
+    void write(Iterator begin, const Iterator end)
+    {
+        for (; begin != end; ++begin)
+            push(*begin);
+    }
+
+    // close: 写入剩余的数据与文件头, 失败时抛出std::runtime_error
+    void close()
+    {
+        if (fd < 0)
+            return;
+        // O_DIRECT只能写整块, 最后一块补0写入, 再截断到实际长度
+        std::uint64_t length = offset + used;
+        std::size_t padded = (used + dataset_header_bytes - 1) / dataset_header_bytes * dataset_header_bytes;
+        std::memset(static_cast<char *>(buffer) + used, 0, padded - used);
+        flush(padded);
+        DatasetHeader header;
+        std::memcpy(header.magic, dataset_magic, sizeof(dataset_magic));
+        header.version = dataset_version;
+        header.type = DatasetTypeOf<T>::value;
+        header.element_size = sizeof(T);
+        header.flags = sorted ? static_cast<std::uint32_t>(dataset_sorted) : 0;
+        header.count = count;
+        std::memset(buffer, 0, dataset_header_bytes);
+        std::memcpy(buffer, &header, sizeof(header));
+        bool ok = ::pwrite(fd, buffer, dataset_header_bytes, 0) == static_cast<ssize_t>(dataset_header_bytes) &&
+                  ::ftruncate(fd, static_cast<off_t>(length)) == 0;
+        ok = (::close(fd) == 0) && ok;
+        fd = -1;
+        if (!ok)
+            throw std::runtime_error("DatasetWriter error: 写文件失败 " + name);
+    }
+private:
+    //****************************数据结构*******************************
+    std::string name;
+    int fd;
+    void *buffer;
+    std::size_t used;           // 缓冲区中已用的字节数
+    std::uint64_t offset;       // 缓冲区的开头在文件中的偏移
+    std::uint64_t count;
+    bool sorted;
+    T last;
+
+    void flush(std::size_t bytes)
+    {
+        std::size_t done = 0;
+        while (done != bytes){
+            ssize_t n = ::pwrite(fd, static_cast<char *>(buffer) + done, bytes - done, static_cast<off_t>(offset + done));
+            if (n <= 0)
+                throw std::runtime_error("DatasetWriter error: 写文件失败 " + name);
+            done += static_cast<std::size_t>(n);
+        }
+        offset += bytes;
+        used = 0;
+    }
+};
+
+// writeDataset: 把data写入数据集文件filename
+template<typename T>
+void writeDataset(const std::string &filename, const std::vector<T> &data, bool direct = false)
+{
+    DatasetWriter<T> writer(filename, direct);
+    writer.write(data.begin(), data.end());
+    writer.close();
+}
+
+// DatasetAccess: 访问方式的提示, 传给madvise
+enum DatasetAccess
+{
+    dataset_normal,         // 不做提示
+    dataset_sequential,     // 顺序扫描, 内核加大预读并尽早回收读过的页
+    dataset_random,         // 随机访问(例如查找), 内核不做预读
+    dataset_preload         // 立即开始把整个文件读入内存
+};
+
+// MappedDataset: 以mmap只读映射数据集文件, 不复制数据
+/*
+ * data()/begin()/end()直接指向映射的内存, 只在对象存在期间有效; 元素类型必须与文件头中的类型相同,
+ * 否则抛出std::runtime_error. 映射的页在第一次访问时才从文件读入.
+ *
+ */
+template<typename T>
+class MappedDataset
+{
+    static_assert(std::is_arithmetic<T>::value, "MappedDataset error: 只支持算术类型");
+public:
+    typedef const T* const_iterator;
+    //****************************构造函数*******************************
+    explicit MappedDataset(const std::string &filename, DatasetAccess access = dataset_normal)
+        : address(nullptr), length(0), header(readDatasetHeader(filename))
+    {
+        if (header.type != DatasetTypeOf<T>::value || header.element_size != sizeof(T))
+            throw std::runtime_error("MappedDataset error: 元素类型与文件不一致 " + filename);
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        struct stat status;
+        if (fd < 0 || ::fstat(fd, &status) != 0){
+            if (fd >= 0)
+                ::close(fd);
+            throw std::runtime_error("MappedDataset error: 无法打开文件 " + filename);
+        }
+        length = dataset_header_bytes + header.count * sizeof(T);
+        if (static_cast<std::uint64_t>(status.st_size) < length){
+            ::close(fd);
+            throw std::runtime_error("MappedDataset error: 数据不完整 " + filename);
+        }
+        address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);        // 映射建立以后不再需要文件描述符
+        if (address == MAP_FAILED){
+            address = nullptr;
+            throw std::runtime_error("MappedDataset error: mmap失败 " + filename);
+        }
+        advise(access);
+    }
+    MappedDataset(const MappedDataset &) = delete;
+    MappedDataset& operator=(const MappedDataset &) = delete;
+    MappedDataset(MappedDataset &&other) : address(other.address), length(other.length), header(other.header)
+    {
+        other.address = nullptr;
+        other.length = 0;
+    }
+    ~MappedDataset()
+    {
+        if (address != nullptr)
+            ::munmap(address, length);
+    }
+    //****************************成员函数*******************************
+    std::size_t size() const { return static_cast<std::size_t>(header.count); }
+    bool empty() const { return header.count == 0; }
+    bool sorted() const { return (header.flags & dataset_sorted) != 0; }
+    const T* data() const { return reinterpret_cast<const T *>(static_cast<const char *>(address) + dataset_header_bytes); }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    // advise: 修改访问方式的提示, 例如加载时顺序扫描, 之后随机查找
+    void advise(DatasetAccess access) const
+    {
+        const int advice[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
+        if (address != nullptr)
+            ::madvise(address, length, advice[access]);     // 只是提示, 失败时忽略
+    }
+private:
+    //****************************数据结构*******************************
+    void *address;
+    std::uint64_t length;       // 映射的字节数(包括文件头)
+    DatasetHeader header;
+};
+#endif
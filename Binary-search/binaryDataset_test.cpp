@@ -0,0 +1,84 @@
+/*************************************************************************
+	> File Name: binaryDataset_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时46分29秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include "binaryDataset.h"
+
+// 写入后映射读出的数据与写入的相同, 有序标志正确; 长度跨过多个缓冲区
+void Test1()
+{
+    std::mt19937_64 engine(2018);
+    vector<std::int64_t> data(dataset_buffer_bytes / sizeof(std::int64_t) * 2 + 12345);
+    for (auto &x : data)
+        x = static_cast<std::int64_t>(engine());
+    bool correct = true;
+    for (bool direct : {false, true}){
+        writeDataset("dataset_test.bin", data, direct);
+        MappedDataset<std::int64_t> dataset("dataset_test.bin", dataset_sequential);
+        correct = correct && dataset.size() == data.size() && !dataset.sorted() &&
+                  std::equal(dataset.begin(), dataset.end(), data.begin());
+    }
+    cout << "64位整数的写入与映射(普通写入与O_DIRECT): " << (correct ? "正确" : "错误") << endl;
+
+    vector<double> reals{-1.5, 0.0, 0.25, 0.25, 8.0};
+    writeDataset("dataset_test.bin", reals);
+    MappedDataset<double> dataset("dataset_test.bin", dataset_random);
+    correct = dataset.sorted() && dataset.size() == 5 && dataset[3] == 0.25 && dataset.data()[4] == 8.0;
+    cout << "浮点数与有序标志: " << (correct ? "正确" : "错误") << endl;
+
+    writeDataset("dataset_test.bin", vector<std::int32_t>());
+    MappedDataset<std::int32_t> empty("dataset_test.bin");
+    correct = empty.empty() && empty.begin() == empty.end();
+    cout << "空数据集: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 类型不一致, 文件不完整与不是数据集的文件都抛出异常
+void Test2()
+{
+    int errors = 0;
+    writeDataset("dataset_test.bin", vector<std::int32_t>{1, 2, 3});
+    try{
+        MappedDataset<std::int64_t> dataset("dataset_test.bin");
+    }catch (const std::runtime_error &){
+        ++errors;
+    }
+    if (truncate("dataset_test.bin", dataset_header_bytes + 4) == 0){
+        try{
+            MappedDataset<std::int32_t> dataset("dataset_test.bin");
+        }catch (const std::runtime_error &){
+            ++errors;
+        }
+    }
+    std::FILE *file = std::fopen("dataset_test.bin", "w");
+    std::fputs("1\t2\n", file);
+    std::fclose(file);
+    try{
+        MappedDataset<std::int32_t> dataset("dataset_test.bin");
+    }catch (const std::runtime_error &){
+        ++errors;
+    }
+    std::remove("dataset_test.bin");
+    cout << "错误的文件: " << (errors == 3 ? "正确" : "错误") << endl;
+}
+
+int main(void)
+{
+    cout << "******************Test1******************" << endl;
+    Test1();
+    cout << "******************Test2******************" << endl;
+    Test2();
+
+    return 0;
+}
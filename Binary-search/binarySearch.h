@@ -14,14 +14,15 @@
 template <typename Comparable>
 int binarySearch(const std::vector<Comparable> &a, const Comparable x)
 {
-    decltype(a.size()) low = 0, high = a.size() - 1;
+    // 在半开区间[low, high)中查找, 空序列与mid为0时都不会发生无符号数的回绕
+    decltype(a.size()) low = 0, high = a.size();
 
-    while (low <= high){
-        auto mid = (high + low) / 2;
+    while (low < high){
+        auto mid = low + (high - low) / 2;
         if (a[mid] < x)
             low = mid + 1;
         else if (a[mid] > x)
-            high = mid - 1;
+            high = mid;
         else
             return mid;
     }
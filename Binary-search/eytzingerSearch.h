@@ -0,0 +1,163 @@
+/*************************************************************************
+	> File Name: eytzingerSearch.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时38分19秒
+ ************************************************************************/
+
+#ifndef _EYTZINGERSEARCH_H
+#define _EYTZINGERSEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+const std::size_t eytzinger_cache_line = 64;    // 缓存行的字节数
+const std::size_t eytzinger_batch = 16;         // 批量查找时交错进行的查找个数
+
+// eytzingerLineKeys: 一个缓存行中能放下的键的个数(向下取为2的幂, 至少为1)
+constexpr std::size_t eytzingerLineKeys(std::size_t bytes, std::size_t keys = 1)
+{
+    return (keys * 2 * bytes <= eytzinger_cache_line) ? eytzingerLineKeys(bytes, keys * 2) : keys;
+}
+
+// EytzingerIndex: 按Eytzinger(宽度优先)次序存放的静态有序表, 用于无分支的二分查找
+/*
+ * 算法基本思想: 把有序序列按完全二叉树的层次顺序存放, keys[1]是根, keys[k]的孩子是keys[2k]与keys[2k+1]:
+ *      --查找的每一步为 k = 2k + (keys[k] < x), 比较结果直接参与下标计算, 没有分支预测失败;
+ *      --结点k往下第d层的2^d个后代在数组中是连续的(从k * 2^d开始), 2^d个键正好占一个缓存行时,
+ *        每一步都预取d层以后要访问的缓存行, 内存延迟被后面d次比较掩盖;
+ *      --越过叶子以后, k的二进制表示就是查找路径(0向左,1向右), 去掉末尾连续的1和一个0,
+ *        得到最后一次向左的结点, 也就是第一个不小于x的元素(lower_bound);
+ *      --批量查找时eytzinger_batch个查找同时推进, 它们的内存访问互不依赖, 可以同时等待多个缓存缺失.
+ *
+ * 算法性能: 建立为O(N), 查找为O(logN), 与std::lower_bound相同, 但是数据大于缓存时快得多;
+ *          额外空间为N个键与N个位置(Eytzinger位置到有序位置的映射).
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+class EytzingerIndex
+{
+public:
+    //****************************构造函数*******************************
+    // sorted: 按compare有序的序列
+    explicit EytzingerIndex(const std::vector<T> &sorted, CompareType c = CompareType())
+        : n(sorted.size()), keys(sorted.size() + 1), ranks(sorted.size() + 1), full_levels(0), compare(c)
+    {
+        std::size_t next = 0;
+        build(sorted, next, 1);
+        ranks[0] = n;       // 所有元素都小于x时, 查找结束于结点0
+        // 前full_levels层是满的, 这些层中的查找不需要检查越界
+        while ((std::size_t(2) << full_levels) <= n + 1)
+            ++full_levels;
+    }
+    //****************************成员函数*******************************
+    std::size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+
+    // lowerBound: 第一个不小于x的元素在有序序列中的位置, 不存在时为size()
+    std::size_t lowerBound(const T &x) const { return ranks[search(x)]; }
+
+    // find: 等于x的元素在有序序列中的位置, 不存在时为size()
+    std::size_t find(const T &x) const
+    {
+        std::size_t k = search(x);
+        return (k != 0 && !compare(x, keys[k])) ? ranks[k] : n;
+    }
+
+    bool contains(const T &x) const { return find(x) != n; }
+
+    // lookup: 批量查找, 把[queries_begin, queries_end)中每个查询的lowerBound依次写入out
+    /*
+     * 每eytzinger_batch个查询为一组, 组内的查询逐层同步推进, 每一层对每个查询都发出预取.
+     *
+     */
+    template<typename QueryIterator, typename OutputIterator>
+    OutputIterator lookup(QueryIterator queries_begin, const QueryIterator queries_end, OutputIterator out) const
+    {
+        const T *group[eytzinger_batch];
+        std::size_t nodes[eytzinger_batch];
+        while (queries_begin != queries_end){
+            std::size_t count = 0;
+            for (; count != eytzinger_batch && queries_begin != queries_end; ++count, ++queries_begin){
+                group[count] = &*queries_begin;
+                nodes[count] = 1;
+            }
+            for (std::size_t level = 0; level != full_levels; ++level){
+                for (std::size_t j = 0; j != count; ++j){
+                    prefetch(nodes[j]);
+                    nodes[j] = 2 * nodes[j] + compare(keys[nodes[j]], *group[j]);
+                }
+            }
+            for (std::size_t j = 0; j != count; ++j){
+                *out++ = ranks[finish(nodes[j], *group[j])];
+            }
+        }
+        return out;
+    }
+private:
+    //****************************数据结构*******************************
+    std::size_t n;
+    std::vector<T> keys;                // keys[1, ..., N]按Eytzinger次序存放, keys[0]不使用
+    std::vector<std::size_t> ranks;     // ranks[k]为keys[k]在有序序列中的位置
+    std::size_t full_levels;            // 满的层数, 即floor(log2(N + 1))
+    CompareType compare;
+
+    static const std::size_t line_keys = eytzingerLineKeys(sizeof(T));
+
+    // build: 中序遍历以k为根的子树, 依次填入有序序列中的元素
+    void build(const std::vector<T> &sorted, std::size_t &next, std::size_t k)
+    {
+        if (k > n)
+            return;
+        build(sorted, next, 2 * k);
+        keys[k] = sorted[next];
+        ranks[k] = next++;
+        build(sorted, next, 2 * k + 1);
+    }
+
+    // prefetch: 预取结点k往下log2(line_keys)层的后代所在的缓存行
+    void prefetch(std::size_t k) const
+    {
+#if defined(__GNUC__)
+        // 地址可能超出数组的范围, 用整数计算避免越界的指针运算, 预取无效地址不会出错
+        __builtin_prefetch(reinterpret_cast<const void *>(
+            reinterpret_cast<std::uintptr_t>(keys.data()) + k * line_keys * sizeof(T)));
+#else
+        (void)k;
+#endif
+    }
+
+    // finish: 完成满的层以后, 最后一层可能不满, 再走一步(越界时不走), 然后求出lower_bound的结点
+    std::size_t finish(std::size_t k, const T &x) const
+    {
+        if (k <= n)
+            k = 2 * k + compare(keys[k], x);
+        // 去掉末尾连续的1和一个0, 所有元素都小于x时结果为0
+        return k >> (countTrailingOnes(k) + 1);
+    }
+
+    static std::size_t countTrailingOnes(std::size_t k)
+    {
+#if defined(__GNUC__)
+        return static_cast<std::size_t>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+        std::size_t count = 0;
+        for (; k & 1; k >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    std::size_t search(const T &x) const
+    {
+        std::size_t k = 1;
+        for (std::size_t level = 0; level != full_levels; ++level){
+            prefetch(k);
+            k = 2 * k + compare(keys[k], x);
+        }
+        return finish(k, x);
+    }
+};
+#endif
@@ -0,0 +1,120 @@
+/*************************************************************************
+	> File Name: eytzingerSearch_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时41分02秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include "eytzingerSearch.h"
+#include "binarySearch.h"
+
+// lowerBound与contains和std::lower_bound一致
+template<typename T, typename CompareType>
+bool checkIndex(const vector<T> &sorted, const vector<T> &queries, CompareType compare)
+{
+    EytzingerIndex<T, CompareType> index(sorted, compare);
+    for (const auto &x : queries){
+        std::size_t expected = std::lower_bound(sorted.begin(), sorted.end(), x, compare) - sorted.begin();
+        if (index.lowerBound(x) != expected)
+            return false;
+        bool found = expected != sorted.size() && !compare(x, sorted[expected]);
+        if (index.contains(x) != found || index.find(x) != (found ? expected : sorted.size()))
+            return false;
+    }
+    return true;
+}
+
+// 大小为0到200的所有序列(包括不是2的幂的大小), 查询覆盖所有元素和它们之间的空隙
+void Test1()
+{
+    bool correct = true;
+    for (int n = 0; n <= 200 && correct; ++n){
+        vector<int> sorted, queries;
+        for (int i = 0; i != n; ++i)
+            sorted.push_back(2 * i);
+        for (int x = -2; x <= 2 * n + 1; ++x)
+            queries.push_back(x);
+        correct = checkIndex(sorted, queries, std::less<int>());
+    }
+    cout << "所有小规模序列的lowerBound: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 大量重复元素, 以及降序的比较函数
+void Test2()
+{
+    std::mt19937 engine(2018);
+    std::uniform_int_distribution<int> dist(0, 50);
+    vector<int> sorted(10000), queries(2000);
+    for (auto &x : sorted)
+        x = dist(engine);
+    for (auto &x : queries)
+        x = dist(engine) - 5;
+    std::sort(sorted.begin(), sorted.end());
+    bool correct = checkIndex(sorted, queries, std::less<int>());
+    cout << "重复元素的lowerBound: " << (correct ? "正确" : "错误") << endl;
+
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    correct = checkIndex(sorted, queries, std::greater<int>());
+    cout << "降序序列的lowerBound: " << (correct ? "正确" : "错误") << endl;
+
+    vector<std::string> words{"apple", "banana", "cherry", "grape", "lemon", "mango", "peach"};
+    vector<std::string> probes{"", "apple", "b", "cherry", "kiwi", "peach", "zebra"};
+    correct = checkIndex(words, probes, std::less<std::string>());
+    cout << "字符串的lowerBound: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 批量查找与逐个查找的结果相同
+void Test3()
+{
+    std::mt19937_64 engine(2018);
+    std::uniform_int_distribution<long long> dist(0, 1LL << 40);
+    bool correct = true;
+    for (std::size_t n : {0u, 1u, 15u, 16u, 17u, 1000u, 100000u}){
+        vector<long long> sorted(n), queries(3 * eytzinger_batch + 5);
+        for (auto &x : sorted)
+            x = dist(engine);
+        for (auto &x : queries)
+            x = dist(engine);
+        std::sort(sorted.begin(), sorted.end());
+        EytzingerIndex<long long> index(sorted);
+        vector<std::size_t> results(queries.size());
+        auto last = index.lookup(queries.begin(), queries.end(), results.begin());
+        if (last != results.end())
+            correct = false;
+        for (std::size_t i = 0; i != queries.size() && correct; ++i)
+            if (results[i] != index.lowerBound(queries[i]))
+                correct = false;
+    }
+    cout << "批量查找: " << (correct ? "正确" : "错误") << endl;
+}
+
+// binarySearch在空序列与查找最小值以下的数时不会越界
+void Test4()
+{
+    vector<int> empty, vec{1, 3, 5, 7};
+    bool correct = binarySearch(empty, 1) == -1 && binarySearch(vec, 0) == -1 &&
+                   binarySearch(vec, 1) == 0 && binarySearch(vec, 7) == 3 && binarySearch(vec, 4) == -1;
+    cout << "binarySearch的边界情况: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main(void)
+{
+    cout << "******************Test1******************" << endl;
+    Test1();
+    cout << "******************Test2******************" << endl;
+    Test2();
+    cout << "******************Test3******************" << endl;
+    Test3();
+    cout << "******************Test4******************" << endl;
+    Test4();
+
+    return 0;
+}
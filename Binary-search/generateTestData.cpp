@@ -4,10 +4,19 @@
 	> Mail: jiangxizhengzhirun@163.com 
 	> Created Time: 2018年10月18日 星期四 13时25分43秒
  ************************************************************************/
+// 用法: ./generateTestData [二进制数据的元素个数(默认200)] [direct]
+/*
+ * 生成文本格式的testData(100行, 每行两个数), 以及二进制数据集testData.bin(格式见binaryDataset.h).
+ * 第二个参数为direct时用O_DIRECT写入二进制数据集.
+ *
+ */
 
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <random>
 #include <string>
+#include "binaryDataset.h"
 
 void generateData(const std::string filename, size_t num)
 {
@@ -20,11 +29,23 @@ void generateData(const std::string filename, size_t num)
     out.close();
 }
 
-int main(void)
+void generateBinaryData(const std::string filename, size_t num, bool direct)
 {
-    generateData("testData", 100);
+    std::uniform_int_distribution<std::int32_t> u(-100,100);
+    std::default_random_engine e;
+    DatasetWriter<std::int32_t> writer(filename, direct);
 
-    return 0;
+    for (size_t i = 0; i != num; i++)
+        writer.push(u(e));
+    writer.close();
 }
 
+int main(int argc, char *argv[])
+{
+    size_t num = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+    bool direct = argc > 2 && std::string(argv[2]) == "direct";
+    generateData("testData", 100);
+    generateBinaryData("testData.bin", num, direct);
 
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*************************************************************************
+	> File Name: searchSorted.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时41分00秒
+ ************************************************************************/
+
+#ifndef _SEARCHSORTED_H
+#define _SEARCHSORTED_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "../parallel_algorithm/execution_policy/executionPolicy.h"
+
+const std::size_t search_sorted_merge_ratio = 8;                            // 平均每个查询对应的表项不超过该值时使用归并
+const std::size_t search_sorted_parallel_threshold = std::size_t(1) << 16;  // 不少于该个数的查询才使用多线程
+
+// gallopLowerBound: 从位置from开始指数搜索[from, size)中第一个不小于x的位置
+/*
+ * 依次检查from, from+1, from+3, from+7, ..., 步长每次加倍, 找到第一个不小于x的位置后在最后一步的区间内二分.
+ * 结果与from的距离为d时代价为O(logd), 与表的大小无关.
+ *
+ */
+template<typename T, typename CompareType>
+std::size_t gallopLowerBound(const std::vector<T> &table, std::size_t from, const T &x, CompareType &compare)
+{
+    std::size_t low = from, step = 1;
+    std::size_t high = from;
+    while (high < table.size() && compare(table[high], x)){
+        low = high + 1;
+        high += step;
+        step <<= 1;
+    }
+    if (high > table.size())
+        high = table.size();
+    return std::lower_bound(table.begin() + low, table.begin() + high, x, compare) - table.begin();
+}
+
+// searchSortedRange: 依次查找queries[first, last)(非空), 结果写入out[first, last)
+/*
+ * 先用两次二分查找确定第一个与最后一个查询的结果from与to, 这一段查询的结果都在[from, to]中,
+ * 据此估计查询的密度, 选择归并或者指数搜索.
+ *
+ */
+template<typename T, typename CompareType>
+void searchSortedRange(const std::vector<T> &table, const std::vector<T> &queries, std::vector<std::size_t> &out,
+                       std::size_t first, std::size_t last, CompareType &compare)
+{
+    std::size_t from = std::lower_bound(table.begin(), table.end(), queries[first], compare) - table.begin();
+    std::size_t to = std::lower_bound(table.begin() + from, table.end(), queries[last - 1], compare) - table.begin();
+    std::size_t position = from;
+    // 查询在表中很密集时, 逐个前进的归并比指数搜索的比较次数少, 而且访问是顺序的
+    if (to - from <= search_sorted_merge_ratio * (last - first)){
+        for (std::size_t i = first; i != last; ++i){
+            while (position != to && compare(table[position], queries[i]))
+                ++position;
+            out[i] = position;
+        }
+        return;
+    }
+    for (std::size_t i = first; i != last; ++i){
+        position = gallopLowerBound(table, position, queries[i], compare);
+        out[i] = position;
+    }
+}
+
+// searchSorted: 在有序表中批量查找有序的查询
+/*
+ * \parameter table: 按compare有序的表;
+ * \parameter queries: 按compare有序的查询;
+ * \parameter out: 输出, out[i]为queries[i]在table中的lower_bound位置(不存在时为table.size());
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \parameter threads: 参与计算的线程个数(包括调用线程), 查询较少时不使用多线程;
+ * \return void.
+ *
+ * 算法基本思想: 查询有序时, 每个查询的结果不小于上一个查询的结果, 从上一个结果开始查找:
+ *      --查询稀疏时用指数搜索(gallopLowerBound), 相邻结果距离为d时代价为O(logd);
+ *      --平均每个查询对应的表项不超过search_sorted_merge_ratio时用线性归并;
+ *      --多线程时查询分为若干段, 每段的起点用一次二分查找确定, 各段互不依赖, 在共享的线程池中执行.
+ *
+ * 算法性能: 共M个查询, 表长为N时为O(Mlog(N/M + 1)), 不超过O(N + M); 逐个二分查找为O(MlogN).
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+void searchSorted(const std::vector<T> &table, const std::vector<T> &queries, std::vector<std::size_t> &out,
+                  CompareType compare = CompareType(), std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    assert(std::is_sorted(queries.begin(), queries.end(), compare));
+    const std::size_t m = queries.size();
+    out.resize(m);
+    if (m == 0)
+        return;
+    if (threads <= 1 || m < search_sorted_parallel_threshold){
+        searchSortedRange(table, queries, out, 0, m, compare);
+        return;
+    }
+    std::size_t chunk_size = (m + threads - 1) / threads;
+    parallelFor(execution::par.withThreads(threads), (m + chunk_size - 1) / chunk_size, [&](std::size_t c){
+        searchSortedRange(table, queries, out, c * chunk_size, std::min(m, (c + 1) * chunk_size), compare);
+    });
+}
+#endif
@@ -0,0 +1,82 @@
+/*************************************************************************
+	> File Name: searchSorted_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时43分43秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+#include <functional>
+#include <random>
+#include "searchSorted.h"
+
+// 与逐个调用std::lower_bound的结果相同
+template<typename T, typename CompareType>
+bool checkSearch(const vector<T> &table, const vector<T> &queries, CompareType compare, std::size_t threads)
+{
+    vector<std::size_t> out;
+    searchSorted(table, queries, out, compare, threads);
+    if (out.size() != queries.size())
+        return false;
+    for (std::size_t i = 0; i != queries.size(); ++i)
+        if (out[i] != static_cast<std::size_t>(std::lower_bound(table.begin(), table.end(), queries[i], compare) - table.begin()))
+            return false;
+    return true;
+}
+
+template<typename Engine>
+vector<int> sortedRandom(std::size_t n, int range, Engine &engine)
+{
+    std::uniform_int_distribution<int> dist(0, range);
+    vector<int> vec(n);
+    for (auto &x : vec)
+        x = dist(engine);
+    std::sort(vec.begin(), vec.end());
+    return vec;
+}
+
+// 稀疏的查询(指数搜索)与密集的查询(归并), 包括重复元素与超出表范围的查询
+void Test1()
+{
+    std::mt19937 engine(2018);
+    vector<int> table = sortedRandom(100000, 50000, engine);
+    bool correct = checkSearch(table, sortedRandom(50, 60000, engine), std::less<int>(), 1);
+    cout << "稀疏查询: " << (correct ? "正确" : "错误") << endl;
+    correct = checkSearch(table, sortedRandom(80000, 60000, engine), std::less<int>(), 1);
+    cout << "密集查询: " << (correct ? "正确" : "错误") << endl;
+    correct = checkSearch(vector<int>(), sortedRandom(10, 5, engine), std::less<int>(), 1) &&
+              checkSearch(table, vector<int>(), std::less<int>(), 1) &&
+              checkSearch(vector<int>{7}, vector<int>{1, 7, 7, 9}, std::less<int>(), 1);
+    cout << "空表与空查询: " << (correct ? "正确" : "错误") << endl;
+
+    std::reverse(table.begin(), table.end());
+    vector<int> queries = sortedRandom(1000, 60000, engine);
+    std::reverse(queries.begin(), queries.end());
+    correct = checkSearch(table, queries, std::greater<int>(), 1);
+    cout << "降序的表与查询: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 多线程时按查询分段, 结果与单线程相同
+void Test2()
+{
+    std::mt19937 engine(2018);
+    vector<int> table = sortedRandom(1 << 20, 1 << 30, engine);
+    bool correct = checkSearch(table, sortedRandom(1 << 17, 1 << 30, engine), std::less<int>(), 4) &&
+                   checkSearch(table, sortedRandom(1 << 21, 1 << 30, engine), std::less<int>(), 3) &&
+                   checkSearch(table, vector<int>(1 << 17, 12345), std::less<int>(), 4);
+    cout << "多线程批量查找: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main(void)
+{
+    cout << "******************Test1******************" << endl;
+    Test1();
+    cout << "******************Test2******************" << endl;
+    Test2();
+
+    return 0;
+}
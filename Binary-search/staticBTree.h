@@ -0,0 +1,184 @@
+/*************************************************************************
+	> File Name: staticBTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时40分02秒
+ ************************************************************************/
+
+#ifndef _STATICBTREE_H
+#define _STATICBTREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+const std::size_t static_btree_node_bytes = 64;     // 每个结点的字节数, 即一个缓存行
+
+// staticBTreeRank: 一个结点的keys[0, ..., B-1]中小于x的键的个数(键有序, 因此就是x的lower_bound)
+/*
+ * 每个键的比较结果直接累加, 没有分支; 32位与64位整数在支持AVX2/AVX-512时一次比较整个结点,
+ * 用movemask把比较结果压缩为位掩码, 再用popcount计数.
+ *
+ */
+template<typename T>
+inline std::size_t staticBTreeRank(const T *keys, const T &x)
+{
+    const std::size_t node_keys = static_btree_node_bytes / sizeof(T);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != node_keys; ++i)
+        count += keys[i] < x;
+    return count;
+}
+
+#if defined(__AVX512F__)
+inline std::size_t staticBTreeRank(const std::int32_t *keys, const std::int32_t &x)
+{
+    __mmask16 less = _mm512_cmplt_epi32_mask(_mm512_load_si512(keys), _mm512_set1_epi32(x));
+    return static_cast<std::size_t>(__builtin_popcount(less));
+}
+inline std::size_t staticBTreeRank(const std::int64_t *keys, const std::int64_t &x)
+{
+    __mmask8 less = _mm512_cmplt_epi64_mask(_mm512_load_si512(keys), _mm512_set1_epi64(x));
+    return static_cast<std::size_t>(__builtin_popcount(less));
+}
+#elif defined(__AVX2__)
+inline std::size_t staticBTreeRank(const std::int32_t *keys, const std::int32_t &x)
+{
+    // 结点为两个256位向量, x > key的位置为全1
+    __m256i value = _mm256_set1_epi32(x);
+    __m256i lo = _mm256_cmpgt_epi32(value, _mm256_load_si256(reinterpret_cast<const __m256i *>(keys)));
+    __m256i hi = _mm256_cmpgt_epi32(value, _mm256_load_si256(reinterpret_cast<const __m256i *>(keys + 8)));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(lo))) |
+                    (static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hi))) << 8);
+    return static_cast<std::size_t>(__builtin_popcount(mask));
+}
+inline std::size_t staticBTreeRank(const std::int64_t *keys, const std::int64_t &x)
+{
+    __m256i value = _mm256_set1_epi64x(x);
+    __m256i lo = _mm256_cmpgt_epi64(value, _mm256_load_si256(reinterpret_cast<const __m256i *>(keys)));
+    __m256i hi = _mm256_cmpgt_epi64(value, _mm256_load_si256(reinterpret_cast<const __m256i *>(keys + 4)));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lo))) |
+                    (static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(hi))) << 4);
+    return static_cast<std::size_t>(__builtin_popcount(mask));
+}
+#endif
+
+// StaticBTree: 静态B+树(S+树), 只读有序数组的索引
+/*
+ * 算法基本思想: 每个结点是一个缓存行, 保存B = 64 / sizeof(T)个键(32位为16个, 64位为8个), 有B+1个孩子:
+ *      --叶子层就是有序序列本身, 按B个一组分块, 末尾用T的最大值补齐, 因此位置就是有序序列中的下标,
+ *        从任意位置开始都可以顺序扫描;
+ *      --内部层的第m个结点的孩子是下一层的第m(B+1), ..., m(B+1)+B个结点, 第i个键是第i+1个孩子的最小键
+ *        (孩子不存在时为最大值); 孩子的下标由计算得到, 不需要保存指针;
+ *      --查找x: 在每个结点中求出小于x的键的个数c(staticBTreeRank), 进入第c个孩子; 到达叶子后,
+ *        叶子的起始位置加上叶子中小于x的键的个数就是lower_bound. 若第c个孩子中的键都小于x,
+ *        结果恰好是第c+1个孩子的起始位置, 因为所有子树在叶子层中都是连续的.
+ *      --建立: 自底向上, 每一层记录每个结点的最小键, 上一层的结点由它们直接填出.
+ *
+ * 算法性能: 建立为O(N); 查找访问log_(B+1)(N)个结点, 每层一次缓存缺失(二分查找为log_2(N)次);
+ *          额外空间约为N/B个键. 只支持算术类型与std::less的次序.
+ *
+ */
+template<typename T>
+class StaticBTree
+{
+    static_assert(std::is_arithmetic<T>::value, "StaticBTree error: 只支持算术类型");
+public:
+    typedef const T* const_iterator;
+    static const std::size_t node_keys = static_btree_node_bytes / sizeof(T);
+    //****************************构造函数*******************************
+    // sorted: 从小到大有序的序列
+    explicit StaticBTree(const std::vector<T> &sorted) : n(sorted.size())
+    {
+        std::size_t blocks = (n + node_keys - 1) / node_keys;
+        if (blocks == 0)
+            blocks = 1;
+        // 自底向上求出每一层的结点数, 直到只剩一个根结点
+        std::vector<std::size_t> layer_nodes(1, blocks);
+        while (layer_nodes.back() > 1)
+            layer_nodes.push_back((layer_nodes.back() + node_keys) / (node_keys + 1));
+        std::size_t total = 0;
+        offsets.resize(layer_nodes.size());
+        for (std::size_t j = 0; j != layer_nodes.size(); ++j){
+            offsets[j] = total;
+            total += layer_nodes[j] * node_keys;
+        }
+        // 多分配一个结点, 使数据的起始地址对齐到缓存行
+        storage.assign(total + node_keys, std::numeric_limits<T>::max());
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage.data());
+        std::size_t skip = (static_btree_node_bytes - address % static_btree_node_bytes) % static_btree_node_bytes;
+        base = storage.data() + skip / sizeof(T);
+
+        std::copy(sorted.begin(), sorted.end(), base);
+        std::vector<T> mins(blocks), parents;
+        for (std::size_t b = 0; b != blocks; ++b)
+            mins[b] = base[b * node_keys];
+        for (std::size_t j = 1; j != layer_nodes.size(); ++j){
+            T *layer = base + offsets[j];
+            parents.assign(layer_nodes[j], std::numeric_limits<T>::max());
+            for (std::size_t child = 0; child != mins.size(); ++child){
+                std::size_t m = child / (node_keys + 1), i = child % (node_keys + 1);
+                if (i == 0)
+                    parents[m] = mins[child];
+                else
+                    layer[m * node_keys + i - 1] = mins[child];
+            }
+            mins.swap(parents);
+        }
+    }
+    // 数据对齐在storage内部, 复制后的对齐位置可能不同, 只允许移动
+    StaticBTree(const StaticBTree &) = delete;
+    StaticBTree& operator=(const StaticBTree &) = delete;
+    StaticBTree(StaticBTree &&) = default;
+    StaticBTree& operator=(StaticBTree &&) = default;
+    //****************************成员函数*******************************
+    std::size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    // height: 树的层数(包括叶子层)
+    std::size_t height() const { return offsets.size(); }
+    const T& operator[](std::size_t i) const { return base[i]; }
+
+    // lowerBound: 第一个不小于x的元素的位置, 不存在时为size()
+    std::size_t lowerBound(const T &x) const
+    {
+        std::size_t m = 0;
+        for (std::size_t j = offsets.size() - 1; j != 0; --j)
+            m = m * (node_keys + 1) + staticBTreeRank(base + offsets[j] + m * node_keys, x);
+        std::size_t position = m * node_keys + staticBTreeRank(base + m * node_keys, x);
+        return position < n ? position : n;
+    }
+
+    bool contains(const T &x) const
+    {
+        std::size_t position = lowerBound(x);
+        return position != n && !(x < base[position]);
+    }
+
+    //****************************迭代器*******************************
+    // 叶子层就是有序序列, 迭代器按从小到大的次序访问所有元素
+    const_iterator begin() const { return base; }
+    const_iterator end() const { return base + n; }
+    // seek: 指向第一个不小于x的元素, 从它开始可以顺序扫描
+    const_iterator seek(const T &x) const { return base + lowerBound(x); }
+    // range: [low, high)中的所有元素
+    std::pair<const_iterator, const_iterator> range(const T &low, const T &high) const
+    {
+        const_iterator first = seek(low);
+        const_iterator last = (low < high) ? seek(high) : first;
+        return std::make_pair(first, last);
+    }
+private:
+    //****************************数据结构*******************************
+    std::size_t n;
+    std::vector<T> storage;             // 所有层的结点, 叶子层在前
+    T *base;                            // storage中对齐到缓存行的起始位置
+    std::vector<std::size_t> offsets;   // offsets[j]为第j层(0为叶子层)相对于base的偏移
+};
+#endif
@@ -0,0 +1,102 @@
+/*************************************************************************
+	> File Name: staticBTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时42分45秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include "staticBTree.h"
+
+// lowerBound与contains和std::lower_bound一致
+template<typename T>
+bool checkTree(const vector<T> &sorted, const vector<T> &queries)
+{
+    StaticBTree<T> tree(sorted);
+    for (const auto &x : queries){
+        std::size_t expected = std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+        if (tree.lowerBound(x) != expected)
+            return false;
+        if (tree.contains(x) != (expected != sorted.size() && sorted[expected] == x))
+            return false;
+    }
+    return true;
+}
+
+// 从空序列到三层的树, 查询覆盖所有元素和它们之间的空隙
+void Test1()
+{
+    bool correct = true;
+    for (int n : {0, 1, 15, 16, 17, 100, 271, 272, 273, 1000, 4624, 4625, 5000}){
+        vector<std::int32_t> sorted, queries;
+        for (int i = 0; i != n; ++i)
+            sorted.push_back(2 * i);
+        for (int x = -2; x <= 2 * n + 1; ++x)
+            queries.push_back(x);
+        correct = correct && checkTree(sorted, queries);
+    }
+    cout << "32位整数的lowerBound: " << (correct ? "正确" : "错误") << endl;
+
+    // 三层的树最多有16 * 17 * 17 = 4624个32位整数
+    correct = StaticBTree<std::int32_t>(vector<std::int32_t>(4624, 7)).height() == 3 &&
+              StaticBTree<std::int32_t>(vector<std::int32_t>(4625, 7)).height() == 4;
+    cout << "树的层数: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 64位整数, 重复元素, 负数, 以及等于最大值的元素(与叶子末尾的填充值相同)
+void Test2()
+{
+    std::mt19937_64 engine(2018);
+    std::uniform_int_distribution<std::int64_t> dist(-100, 100);
+    vector<std::int64_t> sorted(20000), queries(3000);
+    for (auto &x : sorted)
+        x = dist(engine);
+    for (auto &x : queries)
+        x = dist(engine) * 2;
+    sorted.push_back(std::numeric_limits<std::int64_t>::max());
+    sorted.push_back(std::numeric_limits<std::int64_t>::max());
+    queries.push_back(std::numeric_limits<std::int64_t>::max());
+    queries.push_back(std::numeric_limits<std::int64_t>::min());
+    std::sort(sorted.begin(), sorted.end());
+    bool correct = checkTree(sorted, queries);
+    cout << "64位整数与重复元素的lowerBound: " << (correct ? "正确" : "错误") << endl;
+
+    vector<double> reals{-2.5, -1.0, 0.0, 0.5, 0.5, 3.25, 10.0};
+    vector<double> probes{-3.0, -2.5, 0.25, 0.5, 4.0, 10.0, 11.0};
+    correct = checkTree(reals, probes);
+    cout << "浮点数的lowerBound: " << (correct ? "正确" : "错误") << endl;
+}
+
+// 从查找到的位置开始顺序扫描
+void Test3()
+{
+    vector<std::int32_t> sorted;
+    for (int i = 0; i != 1000; ++i)
+        sorted.push_back(3 * i);
+    StaticBTree<std::int32_t> tree(sorted);
+    auto range = tree.range(100, 200);      // 102, 105, ..., 198
+    bool correct = (range.second - range.first == 33) && *range.first == 102 && *(range.second - 1) == 198;
+    correct = correct && tree.range(200, 100).first == tree.range(200, 100).second;
+    correct = correct && tree.seek(5000) == tree.end() && tree.seek(-1) == tree.begin();
+    correct = correct && std::equal(tree.begin(), tree.end(), sorted.begin());
+    cout << "区间扫描: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main(void)
+{
+    cout << "******************Test1******************" << endl;
+    Test1();
+    cout << "******************Test2******************" << endl;
+    Test2();
+    cout << "******************Test3******************" << endl;
+    Test3();
+
+    return 0;
+}
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <vector>
 #include "binarySearch.h"
+#include "binaryDataset.h"
 
 template <typename T>
 void readData(const std::string filename, std::vector<T> &vec)
@@ -20,10 +21,24 @@ void readData(const std::string filename, std::vector<T> &vec)
         vec.push_back(value);
 }
 
+// readBinaryData: 从二进制数据集读取, 不需要解析文本
+template <typename T>
+bool readBinaryData(const std::string filename, std::vector<T> &vec)
+{
+    try{
+        MappedDataset<T> dataset(filename, dataset_sequential);
+        vec.assign(dataset.begin(), dataset.end());
+    }catch (const std::runtime_error &){
+        return false;
+    }
+    return true;
+}
+
 int main(void)
 {
     std::vector<int> data;
-    readData("testData", data);
+    if (!readBinaryData("testData.bin", data))
+        readData("testData", data);
     sort(data.begin(), data.end());
     int value = 57;
     int sign = binarySearch(data, value);
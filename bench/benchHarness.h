@@ -0,0 +1,161 @@
+/*************************************************************************
+	> File Name: benchHarness.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时33分38秒
+ ************************************************************************/
+
+#ifndef _BENCHHARNESS_H
+#define _BENCHHARNESS_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+// 各个子系统的性能测试共用的计时, 分配计数与JSON输出
+/*
+ * 每个测试程序调用BenchHarness::run测量一个(结构, 工作负载, 规模)的组合:
+ *      --setup(): 建立初始状态(例如插入n个元素的散列表), 不计时, 其中的分配也不计数;
+ *      --op(i): 第i次操作(i从0到ops-1), 返回值累加到bench_sink, 使编译器不能省略操作.
+ * 一共运行repeats + 1趟, 每趟之前都调用setup():
+ *      --前repeats趟只在整个循环的两端读时钟, 取最快一趟的平均时间作为ns_per_op与吞吐量;
+ *        替换的全局operator new统计每趟操作中的分配次数与字节数(输出最后一趟的);
+ *      --最后一趟在每次操作的两端读时钟, 减去读时钟本身的时间(timer_ns, 启动时校准)以后求延迟的分位数.
+ *        操作短于几十纳秒时分位数主要反映时钟的分辨率, 以ns_per_op为准.
+ *
+ * 输出为JSON Lines, 每个组合一行, 可以直接拼接多个程序的输出:
+ *      {"suite":..., "structure":..., "baseline":..., "workload":..., "size":..., "ops":..., "items_per_op":...,
+ *       "ns_per_op":..., "ns_per_item":..., "mops":..., "p50_ns":..., "p90_ns":..., "p99_ns":..., "p999_ns":...,
+ *       "max_ns":..., "allocations":..., "alloc_bytes":..., "allocs_per_op":..., "timer_ns":...}
+ *      --baseline为true时是对照的标准库实现;
+ *      --items_per_op: 一次操作处理的元素个数(例如一次建表插入n个元素), ns_per_item = ns_per_op / items_per_op.
+ *
+ * 这个头文件替换了全局的operator new与operator delete, 一个程序中只能有一个翻译单元包含它.
+ *
+ */
+
+//****************************分配计数*******************************
+std::atomic<std::uint64_t> bench_allocations(0);    // operator new被调用的次数
+std::atomic<std::uint64_t> bench_alloc_bytes(0);    // 申请的字节数
+
+void* operator new(std::size_t bytes)
+{
+    bench_allocations.fetch_add(1, std::memory_order_relaxed);
+    bench_alloc_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    void *p = std::malloc(bytes == 0 ? 1 : bytes);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t bytes) { return ::operator new(bytes); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+
+std::uint64_t bench_sink = 0;   // 所有操作的返回值之和, 使编译器不能省略操作
+
+// benchXorshift: 测试数据用的伪随机数, 每个程序的数据都是确定的
+inline std::uint64_t benchXorshift(std::uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+class BenchHarness
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    //****************************构造函数*******************************
+    // 命令行: [最大规模(默认defaultMax)] [重复次数(默认3)]
+    BenchHarness(int argc, char *argv[], const char *suiteName, std::size_t defaultMax = 1000000)
+        : suite(suiteName), maxN(argc > 1 ? std::strtoull(argv[1], nullptr, 10) : defaultMax),
+          repeats(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3), timerNs(calibrate())
+    {
+        if (repeats == 0)
+            repeats = 1;
+    }
+    //****************************成员函数*******************************
+    // sizes: 从1000开始每次乘10, 不超过min(最大规模, limit)
+    std::vector<std::size_t> sizes(std::size_t limit = std::size_t(-1)) const
+    {
+        std::vector<std::size_t> result;
+        for (std::size_t n = 1000; n <= std::min(maxN, limit); n *= 10)
+            result.push_back(n);
+        return result;
+    }
+    // run: 测量一个组合并输出一行JSON
+    template<typename Setup, typename Op>
+    void run(const char *structure, bool baseline, const char *workload, std::size_t n, std::size_t ops,
+             Setup setup, Op op, std::size_t itemsPerOp = 1)
+    {
+        if (ops == 0)
+            return;
+        double best = 0;
+        std::uint64_t allocations = 0, bytes = 0;
+        for (std::size_t r = 0; r != repeats; ++r){
+            setup();
+            std::uint64_t a0 = bench_allocations.load(std::memory_order_relaxed);
+            std::uint64_t b0 = bench_alloc_bytes.load(std::memory_order_relaxed);
+            Clock::time_point begin = Clock::now();
+            for (std::size_t i = 0; i != ops; ++i)
+                bench_sink += op(i);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+            allocations = bench_allocations.load(std::memory_order_relaxed) - a0;
+            bytes = bench_alloc_bytes.load(std::memory_order_relaxed) - b0;
+            if (r == 0 || ns < best)
+                best = ns;
+        }
+        samples.assign(ops, 0);
+        setup();
+        for (std::size_t i = 0; i != ops; ++i){
+            Clock::time_point begin = Clock::now();
+            bench_sink += op(i);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() - timerNs;
+            samples[i] = ns > 0 ? ns : 0;
+        }
+        std::sort(samples.begin(), samples.end());
+        double perOp = best / ops;
+        std::cout << "{\"suite\":\"" << suite << "\",\"structure\":\"" << structure << "\",\"baseline\":"
+                  << (baseline ? "true" : "false") << ",\"workload\":\"" << workload << "\",\"size\":" << n
+                  << ",\"ops\":" << ops << ",\"items_per_op\":" << itemsPerOp
+                  << ",\"ns_per_op\":" << perOp << ",\"ns_per_item\":" << perOp / itemsPerOp
+                  << ",\"mops\":" << 1e3 / perOp
+                  << ",\"p50_ns\":" << percentile(0.5) << ",\"p90_ns\":" << percentile(0.9)
+                  << ",\"p99_ns\":" << percentile(0.99) << ",\"p999_ns\":" << percentile(0.999)
+                  << ",\"max_ns\":" << samples.back()
+                  << ",\"allocations\":" << allocations << ",\"alloc_bytes\":" << bytes
+                  << ",\"allocs_per_op\":" << static_cast<double>(allocations) / ops
+                  << ",\"timer_ns\":" << timerNs << "}" << std::endl;
+    }
+
+private:
+    std::string suite;
+    std::size_t maxN;
+    std::size_t repeats;
+    double timerNs;                 // 连续两次读时钟的最短间隔
+    std::vector<double> samples;    // 最后一趟每次操作的时间, 排序以后求分位数
+
+    double percentile(double q) const
+    {
+        std::size_t index = static_cast<std::size_t>(q * samples.size());
+        return samples[std::min(index, samples.size() - 1)];
+    }
+    static double calibrate()
+    {
+        double best = 0;
+        for (int i = 0; i != 10000; ++i){
+            Clock::time_point begin = Clock::now();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+            if (i == 0 || ns < best)
+                best = ns;
+        }
+        return best;
+    }
+};
+#endif
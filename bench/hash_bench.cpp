@@ -0,0 +1,175 @@
+/*************************************************************************
+	> File Name: hash_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时36分21秒
+ ************************************************************************/
+// 三个HashTable(链接法, 开放寻址, 完全散列)与std::unordered_map的对比, 输出见benchHarness.h
+/*
+ * 用法: ./hash_chain_bench [最大元素个数(默认1000000)] [重复次数(默认3)]
+ * 三个散列表都叫HashTable, 不能放在同一个翻译单元中, 所以这个文件按宏编译成四个程序:
+ *      BENCH_CHAIN_HASH_TABLE: hash_table/chain_hash_table(链接法, 从默认的桶数开始增长);
+ *      BENCH_OPEN_ADDRESSING: hash_table/open_addressing_hash_table(双重散列, 槽数固定为2n);
+ *      BENCH_PERFECT_HASHING: hash_table/perfect_hashing(单线程initialization建表, 之后只能在空槽中插入);
+ *      都没有定义时: std::unordered_map(baseline).
+ * 元素为Hash<uint64_t, uint64_t>, 键是随机的64位整数, 值由键算出. 工作负载:
+ *      --insert: 向空表中插入n个元素(完全散列是一次initialization, items_per_op为n);
+ *      --find_hit: n个元素的表中查找min(n, 1000000)次, 都是表中的键;
+ *      --find_miss50: 同上, 一半的键不在表中;
+ *      --mixed_90_10: 90%查找表中的键, 10%插入新键(完全散列的新键落在有元素的槽或者没有二级表的槽时插入失败);
+ *      --erase: 按随机次序删除所有n个元素.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "benchHarness.h"
+#if defined(BENCH_CHAIN_HASH_TABLE)
+#include "../hash_table/chain_hash_table/chain_hash_table.h"
+#include "../hash_table/chain_hash_table/hash.h"
+#elif defined(BENCH_OPEN_ADDRESSING)
+#include "../hash_table/open_addressing_hash_table/open_addressing_hash_table.h"
+#include "../hash_table/open_addressing_hash_table/hash.h"
+#elif defined(BENCH_PERFECT_HASHING)
+#include "../hash_table/perfect_hashing/perfect_hashing.h"
+#include "../hash_table/perfect_hashing/hash.h"
+#else
+#include <unordered_map>
+#endif
+
+const std::size_t hash_max_lookups = 1000000;
+
+inline std::uint64_t valueOf(std::uint64_t key) { return key * 3 + 1; }
+
+//****************************各个散列表的适配*******************************
+// Table: build(keys)建表(不计时), insert/find/erase为被测的操作; bulk为true时insert负载用一次build
+#if defined(BENCH_CHAIN_HASH_TABLE)
+typedef Hash<std::uint64_t, std::uint64_t> Entry;
+struct Table
+{
+    static const char* name() { return "ChainHashTable"; }
+    static const bool bulk = false;
+    explicit Table(std::size_t) {  }
+    void build(const std::vector<std::uint64_t> &keys)
+    {
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            insert(keys[i]);
+    }
+    bool insert(std::uint64_t key) { return table.insert(Entry(key, valueOf(key))); }
+    const std::uint64_t* find(std::uint64_t key) const { return table.find(key); }
+    bool erase(std::uint64_t key) { return table.remove(Entry(key, valueOf(key))); }
+    HashTable<Entry> table;
+};
+#elif defined(BENCH_OPEN_ADDRESSING)
+typedef Hash<std::uint64_t, std::uint64_t> Entry;
+struct Table
+{
+    static const char* name() { return "OpenAddressingHashTable"; }
+    static const bool bulk = false;
+    explicit Table(std::size_t n) : table(2 * n + 1) {  }
+    void build(const std::vector<std::uint64_t> &keys)
+    {
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            insert(keys[i]);
+    }
+    bool insert(std::uint64_t key) { return table.try_emplace(key, valueOf(key)).second; }
+    const std::uint64_t* find(std::uint64_t key) const { return table.find(key); }
+    bool erase(std::uint64_t key) { return table.hash_delete(Entry(key, valueOf(key))); }
+    HashTable<Entry> table;
+};
+#elif defined(BENCH_PERFECT_HASHING)
+typedef Hash<std::uint64_t, std::uint64_t> Entry;
+struct Table
+{
+    static const char* name() { return "PerfectHashTable"; }
+    static const bool bulk = true;
+    explicit Table(std::size_t) {  }
+    void build(const std::vector<std::uint64_t> &keys)
+    {
+        std::vector<Entry> entries;
+        entries.reserve(keys.size());
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            entries.push_back(Entry(keys[i], valueOf(keys[i])));
+        table.initialization(entries, 1);
+    }
+    bool insert(std::uint64_t key) { return table.try_emplace(key, valueOf(key)).second; }
+    const std::uint64_t* find(std::uint64_t key) const { return table.find(key); }
+    bool erase(std::uint64_t key) { return table.hash_delete(Entry(key, valueOf(key))); }
+    HashTable<Entry> table;
+};
+#else
+struct Table
+{
+    static const char* name() { return "std::unordered_map"; }
+    static const bool bulk = false;
+    explicit Table(std::size_t) {  }
+    void build(const std::vector<std::uint64_t> &keys)
+    {
+        for (std::size_t i = 0; i != keys.size(); ++i)
+            insert(keys[i]);
+    }
+    bool insert(std::uint64_t key) { return table.emplace(key, valueOf(key)).second; }
+    const std::uint64_t* find(std::uint64_t key) const
+    {
+        auto it = table.find(key);
+        return it == table.end() ? nullptr : &it->second;
+    }
+    bool erase(std::uint64_t key) { return table.erase(key) != 0; }
+    std::unordered_map<std::uint64_t, std::uint64_t> table;
+};
+#endif
+
+#if defined(BENCH_CHAIN_HASH_TABLE) || defined(BENCH_OPEN_ADDRESSING) || defined(BENCH_PERFECT_HASHING)
+const bool table_baseline = false;
+#else
+const bool table_baseline = true;
+#endif
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "hash_table");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s], lookups = std::min(n, hash_max_lookups);
+        std::uint64_t state = 0x9E3779B97F4A7C15ull ^ n;
+        std::vector<std::uint64_t> keys(n), fresh(n), hits(lookups), mixed(lookups);
+        for (std::size_t i = 0; i != n; ++i){
+            keys[i] = benchXorshift(state);
+            fresh[i] = benchXorshift(state);
+        }
+        for (std::size_t i = 0; i != lookups; ++i){
+            hits[i] = keys[benchXorshift(state) % n];
+            mixed[i] = (i & 1) ? fresh[i] : hits[i];
+        }
+        std::vector<std::uint64_t> erases(keys);
+        for (std::size_t i = n - 1; i > 0; --i)
+            std::swap(erases[i], erases[benchXorshift(state) % (i + 1)]);
+        std::unique_ptr<Table> table;
+        auto empty = [&]{ table.reset(); table.reset(new Table(n)); };
+        auto full = [&]{ empty(); table->build(keys); };
+
+        if (Table::bulk)
+            harness.run(Table::name(), table_baseline, "insert", n, 1, empty,
+                        [&](std::size_t){ table->build(keys); return static_cast<std::uint64_t>(1); }, n);
+        else
+            harness.run(Table::name(), table_baseline, "insert", n, n, empty,
+                        [&](std::size_t i){ return static_cast<std::uint64_t>(table->insert(keys[i])); });
+        harness.run(Table::name(), table_baseline, "find_hit", n, lookups, full,
+                    [&](std::size_t i){ return *table->find(hits[i]); });
+        harness.run(Table::name(), table_baseline, "find_miss50", n, lookups, full,
+                    [&](std::size_t i) -> std::uint64_t {
+                        const std::uint64_t *p = table->find(mixed[i]);
+                        return p ? *p : 0;
+                    });
+        harness.run(Table::name(), table_baseline, "mixed_90_10", n, lookups, full,
+                    [&](std::size_t i) -> std::uint64_t {
+                        if (i % 10 == 9)
+                            return table->insert(fresh[i]);
+                        return *table->find(hits[i]);
+                    });
+        harness.run(Table::name(), table_baseline, "erase", n, n, full,
+                    [&](std::size_t i){ return static_cast<std::uint64_t>(table->erase(erases[i])); });
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+/*************************************************************************
+	> File Name: heap_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时39分04秒
+ ************************************************************************/
+// MinQueue, IndexedMinQueue与std::priority_queue的对比, 输出见benchHarness.h
+/*
+ * 用法: ./heap_bench [最大元素个数(默认1000000)] [重复次数(默认3)]
+ * 关键字按两种次序产生(工作负载名的后缀): random(随机), descending(递减, 每次push都上移到堆顶).
+ *      --push: 向空堆中加入n个元素;
+ *      --pop: 从n个元素的堆中取出所有元素;
+ *      --hold: n个元素的堆中, 每次操作取出最小的元素, 再加入关键字为它加上一个随机增量的元素(保持模型,
+ *        离散事件模拟的事件队列), 共n次.
+ * MinQueue的元素是shared_ptr<int>, 比较与取关键字通过std::function, 每次push分配一次.
+ *
+ */
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../queue_algorithm/min_queue/minqueue.h"
+
+//****************************各个堆的适配*******************************
+struct OldMinQueue
+{
+    static const char* name() { return "MinQueue"; }
+    OldMinQueue() : queue([](std::shared_ptr<int> a, std::shared_ptr<int> b){ return *a < *b; },
+                          [](std::shared_ptr<int> p) -> int& { return *p; }) {  }
+    void push(int key) { queue.insert(std::make_shared<int>(key)); }
+    int pop() { return *queue.extract_min(); }
+    MinQueue<int, int> queue;
+};
+struct Indexed
+{
+    static const char* name() { return "IndexedMinQueue"; }
+    void push(int key) { queue.push(key); }
+    int pop() { return queue.extract_min(); }
+    IndexedMinQueue<int> queue;
+};
+struct StdPriorityQueue
+{
+    static const char* name() { return "std::priority_queue"; }
+    void push(int key) { queue.push(key); }
+    int pop()
+    {
+        int key = queue.top();
+        queue.pop();
+        return key;
+    }
+    std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+};
+
+template<typename Heap>
+void runHeap(BenchHarness &harness, bool baseline, const char *order, const std::vector<int> &keys,
+             const std::vector<int> &increments)
+{
+    std::size_t n = keys.size();
+    std::unique_ptr<Heap> heap;
+    auto empty = [&]{ heap.reset(); heap.reset(new Heap); };
+    auto full = [&]{
+        empty();
+        for (std::size_t i = 0; i != n; ++i)
+            heap->push(keys[i]);
+    };
+    std::string suffix = std::string("_") + order;
+    harness.run(Heap::name(), baseline, ("push" + suffix).c_str(), n, n, empty,
+                [&](std::size_t i){ heap->push(keys[i]); return static_cast<std::uint64_t>(1); });
+    harness.run(Heap::name(), baseline, ("pop" + suffix).c_str(), n, n, full,
+                [&](std::size_t){ return static_cast<std::uint64_t>(heap->pop()); });
+    harness.run(Heap::name(), baseline, ("hold" + suffix).c_str(), n, n, full,
+                [&](std::size_t i) -> std::uint64_t {
+                    int key = heap->pop();
+                    heap->push(key + increments[i]);
+                    return static_cast<std::uint64_t>(key);
+                });
+    heap.reset();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "heap");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        std::uint64_t state = 0x2545F4914F6CDD1Dull ^ n;
+        std::vector<int> random(n), descending(n), increments(n);
+        for (std::size_t i = 0; i != n; ++i){
+            random[i] = static_cast<int>(benchXorshift(state) >> 34);
+            descending[i] = static_cast<int>(n - i);
+            increments[i] = static_cast<int>(benchXorshift(state) % n);
+        }
+        const char *orders[] = {"random", "descending"};
+        const std::vector<int> *inputs[] = {&random, &descending};
+        for (int o = 0; o != 2; ++o){
+            runHeap<OldMinQueue>(harness, false, orders[o], *inputs[o], increments);
+            runHeap<Indexed>(harness, false, orders[o], *inputs[o], increments);
+            runHeap<StdPriorityQueue>(harness, true, orders[o], *inputs[o], increments);
+        }
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
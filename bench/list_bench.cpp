@@ -0,0 +1,135 @@
+/*************************************************************************
+	> File Name: list_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时42分47秒
+ ************************************************************************/
+// List, DoublyLinkedList, CircularList, UnrolledList与std::list, std::forward_list的对比, 输出见benchHarness.h
+/*
+ * 用法: ./list_bench [最大元素个数(默认1000000)] [重复次数(默认3)]
+ * 表中的关键字为0到n-1, 按递增的次序放在表尾.
+ *      --insert_back: 向空表的尾部加入n个关键字;
+ *      --search: 从表头顺序查找随机选取的关键字(都在表中), 查找次数使总步数约为2e7(至少10次);
+ *      --erase_front: 每次查找并删除表头的关键字, 直到表为空.
+ * List, DoublyLinkedList与CircularList的节点用make_shared分配(默认的分配器), 链表的search返回shared_ptr.
+ * CircularList::insertBack把节点接在哨兵的后面(表头), 所以它的表中关键字是递减的, 表头是最后加入的关键字.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <forward_list>
+#include <list>
+#include <memory>
+#include <vector>
+#include "benchHarness.h"
+#include "../list_algorithm/list/list.h"
+#include "../list_algorithm/doubly_linked_list/doublyLinkedList.h"
+#include "../list_algorithm/circular_list/circularList.h"
+#include "../list_algorithm/unrolled_list/unrolledList.h"
+
+const std::size_t list_search_steps = 20000000;
+
+//****************************各个链表的适配*******************************
+template<typename ListT>
+struct NodeList
+{
+    static const char* name();
+    static const bool prepends;     // insertBack是否接在表头
+    void insertBack(int key) { list.insertBack(key); }
+    std::uint64_t search(int key) { return list.search(key)->key; }
+    void eraseFront(int key)
+    {
+        auto node = list.search(key);
+        list.deleteList(node);
+    }
+    ListT list;
+};
+typedef NodeList<List<ListNode<int>>> SinglyLinked;
+typedef NodeList<DoublyLinkedList<DoublyLinkedListNode<int>>> DoublyLinked;
+typedef NodeList<CircularList<DoublyLinkedListNode<int>>> Circular;
+template<> const char* SinglyLinked::name() { return "List"; }
+template<> const char* DoublyLinked::name() { return "DoublyLinkedList"; }
+template<> const char* Circular::name() { return "CircularList"; }
+template<typename ListT> const bool NodeList<ListT>::prepends = false;
+template<> const bool Circular::prepends = true;
+struct Unrolled
+{
+    static const char* name() { return "UnrolledList"; }
+    static const bool prepends = false;
+    void insertBack(int key) { list.insertBack(key); }
+    std::uint64_t search(int key) { return *list.search(key); }
+    void eraseFront(int key)
+    {
+        UnrolledList<int>::Position pos = list.search(key);
+        list.deleteList(pos);
+    }
+    UnrolledList<int> list;
+};
+struct StdList
+{
+    static const char* name() { return "std::list"; }
+    static const bool prepends = false;
+    void insertBack(int key) { list.push_back(key); }
+    std::uint64_t search(int key) { return *std::find(list.begin(), list.end(), key); }
+    void eraseFront(int key) { list.erase(std::find(list.begin(), list.end(), key)); }
+    std::list<int> list;
+};
+struct StdForwardList
+{
+    StdForwardList() : last(list.before_begin()) {  }
+    static const char* name() { return "std::forward_list"; }
+    static const bool prepends = false;
+    void insertBack(int key) { last = list.insert_after(last, key); }
+    std::uint64_t search(int key) { return *std::find(list.begin(), list.end(), key); }
+    void eraseFront(int key)
+    {
+        auto before = list.before_begin();
+        for (auto it = list.begin(); *it != key; ++it)
+            ++before;
+        list.erase_after(before);
+    }
+    std::forward_list<int> list;
+    std::forward_list<int>::iterator last;
+};
+
+template<typename ListT>
+void runList(BenchHarness &harness, bool baseline, std::size_t n, const std::vector<int> &probes)
+{
+    std::unique_ptr<ListT> list;
+    auto empty = [&]{ list.reset(); list.reset(new ListT); };
+    auto full = [&]{
+        empty();
+        for (std::size_t i = 0; i != n; ++i)
+            list->insertBack(static_cast<int>(i));
+    };
+    harness.run(ListT::name(), baseline, "insert_back", n, n, empty,
+                [&](std::size_t i){ list->insertBack(static_cast<int>(i)); return static_cast<std::uint64_t>(1); });
+    harness.run(ListT::name(), baseline, "search", n, probes.size(), full,
+                [&](std::size_t i){ return list->search(probes[i]); });
+    harness.run(ListT::name(), baseline, "erase_front", n, n, full,
+                [&](std::size_t i) -> std::uint64_t {
+                    list->eraseFront(static_cast<int>(ListT::prepends ? n - 1 - i : i));
+                    return 1;
+                });
+    list.reset();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "list");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        std::uint64_t state = 0x2545F4914F6CDD1Dull ^ n;
+        std::vector<int> probes(std::max<std::size_t>(10, 2 * list_search_steps / n));
+        for (std::size_t i = 0; i != probes.size(); ++i)
+            probes[i] = static_cast<int>(benchXorshift(state) % n);
+        runList<SinglyLinked>(harness, false, n, probes);
+        runList<DoublyLinked>(harness, false, n, probes);
+        runList<Circular>(harness, false, n, probes);
+        runList<Unrolled>(harness, false, n, probes);
+        runList<StdList>(harness, true, n, probes);
+        runList<StdForwardList>(harness, true, n, probes);
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
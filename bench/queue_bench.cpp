@@ -0,0 +1,110 @@
+/*************************************************************************
+	> File Name: queue_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时45分30秒
+ ************************************************************************/
+// Queue, Stack, InlineStack与std::queue, std::stack的对比, 输出见benchHarness.h
+/*
+ * 用法: ./queue_bench [最大元素个数(默认1000000)] [重复次数(默认3)]
+ *      --push: 向空的队列(栈)中加入n个元素;
+ *      --pop: 取出n个元素的队列(栈)中的所有元素;
+ *      --alternate: n个元素的队列(栈)上交替加入与取出, 共n次(元素个数在n与n + 1之间).
+ * Queue是容量固定的循环数组(容量取为n + 2), 元素是shared_ptr<int>; Stack的元素也是shared_ptr<int>,
+ * 容量不够时扩大一倍. 它们每次push分配一次, 所以另外对比InlineStack<int>与元素为int的标准库容器.
+ *
+ */
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <stack>
+#include <vector>
+#include "benchHarness.h"
+#include "../queue_algorithm/queue/queue.h"
+#include "../stack_algorithm/stack.h"
+
+//****************************各个容器的适配*******************************
+struct RepoQueue
+{
+    static const char* name() { return "Queue"; }
+    explicit RepoQueue(std::size_t n) : queue(n + 2) {  }
+    void push(int key) { queue.enQueue(std::make_shared<int>(key)); }
+    int pop() { return *queue.deQueue(); }
+    Queue<int> queue;
+};
+struct StdQueue
+{
+    static const char* name() { return "std::queue"; }
+    explicit StdQueue(std::size_t) {  }
+    void push(int key) { queue.push(key); }
+    int pop()
+    {
+        int key = queue.front();
+        queue.pop();
+        return key;
+    }
+    std::queue<int> queue;
+};
+struct RepoStack
+{
+    static const char* name() { return "Stack"; }
+    explicit RepoStack(std::size_t) {  }
+    void push(int key) { stack.push(std::make_shared<int>(key)); }
+    int pop() { return *stack.pop(); }
+    Stack<int> stack;
+};
+struct RepoInlineStack
+{
+    static const char* name() { return "InlineStack"; }
+    explicit RepoInlineStack(std::size_t) {  }
+    void push(int key) { stack.push(key); }
+    int pop() { return stack.pop_value(); }
+    InlineStack<int> stack;
+};
+struct StdStack
+{
+    static const char* name() { return "std::stack"; }
+    explicit StdStack(std::size_t) {  }
+    void push(int key) { stack.push(key); }
+    int pop()
+    {
+        int key = stack.top();
+        stack.pop();
+        return key;
+    }
+    std::stack<int> stack;
+};
+
+template<typename Container>
+void runContainer(BenchHarness &harness, bool baseline, std::size_t n)
+{
+    std::unique_ptr<Container> c;
+    auto empty = [&]{ c.reset(); c.reset(new Container(n)); };
+    auto full = [&]{
+        empty();
+        for (std::size_t i = 0; i != n; ++i)
+            c->push(static_cast<int>(i));
+    };
+    harness.run(Container::name(), baseline, "push", n, n, empty,
+                [&](std::size_t i){ c->push(static_cast<int>(i)); return static_cast<std::uint64_t>(1); });
+    harness.run(Container::name(), baseline, "pop", n, n, full,
+                [&](std::size_t){ return static_cast<std::uint64_t>(c->pop()); });
+    harness.run(Container::name(), baseline, "alternate", n, n, full,
+                [&](std::size_t i){ c->push(static_cast<int>(i)); return static_cast<std::uint64_t>(c->pop()); });
+    c.reset();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "queue_stack");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        runContainer<RepoQueue>(harness, false, n);
+        runContainer<StdQueue>(harness, true, n);
+        runContainer<RepoStack>(harness, false, n);
+        runContainer<RepoInlineStack>(harness, false, n);
+        runContainer<StdStack>(harness, true, n);
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
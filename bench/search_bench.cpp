@@ -0,0 +1,50 @@
+/*************************************************************************
+	> File Name: search_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时48分13秒
+ ************************************************************************/
+// binarySearch与std::lower_bound的对比, 输出见benchHarness.h
+/*
+ * 用法: ./search_bench [最大长度(默认1000000)] [重复次数(默认3)]
+ *      有序数组为0, 2, 4, ...(n个偶数), 每个长度查找200000次:
+ *      --hit: 查找随机选取的数组中的元素;
+ *      --miss50: 一半查找数组中的元素, 一半查找不在数组中的奇数.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "benchHarness.h"
+#include "../Binary-search/binarySearch.h"
+
+const std::size_t search_ops = 200000;
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "search");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        std::vector<int> data(n);
+        for (std::size_t i = 0; i != n; ++i)
+            data[i] = static_cast<int>(2 * i);
+        const char *workloads[] = {"hit", "miss50"};
+        for (int w = 0; w != 2; ++w){
+            std::vector<int> queries(search_ops);
+            std::uint64_t state = 0x2545F4914F6CDD1Dull;
+            for (std::size_t i = 0; i != search_ops; ++i){
+                int key = static_cast<int>(2 * (benchXorshift(state) % n));
+                queries[i] = w == 1 && (i & 1) ? key + 1 : key;
+            }
+            harness.run("binarySearch", false, workloads[w], n, search_ops, []{},
+                        [&](std::size_t i){ return static_cast<std::uint64_t>(binarySearch(data, queries[i]) + 1); });
+            harness.run("std::lower_bound", true, workloads[w], n, search_ops, []{},
+                        [&](std::size_t i) -> std::uint64_t {
+                            auto it = std::lower_bound(data.begin(), data.end(), queries[i]);
+                            return it != data.end() && *it == queries[i] ? it - data.begin() + 1 : 0;
+                        });
+        }
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
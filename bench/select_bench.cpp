@@ -0,0 +1,114 @@
+/*************************************************************************
+	> File Name: select_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时51分56秒
+ ************************************************************************/
+// 选择算法与std::nth_element, std::min_element的对比, 输出见benchHarness.h
+/*
+ * 用法: ./select_bench [最大长度(默认1000000)] [重复次数(默认3)]
+ * 输入按三种分布产生(工作负载名的后缀): random(随机), sorted(递增), few_unique(只有16个不同的值).
+ *      --median: 选取排位为n/2的元素, 对比randomiezdSelect, introSelect, goodSelect, goodSelectInPlace
+ *        与std::nth_element;
+ *      --min: 求最小值, 对比minimum与std::min_element.
+ * 选择算法会重排输入, 所以每一轮计时前为每次操作拷贝一份输入(不计时); 每个长度的操作次数为
+ * 2e6/n, 并限制在3到1000之间. items_per_op为n.
+ * randomiezdSelect与goodSelect默认用LomutoPartition, 与主元相等的元素都分到一侧, 重复元素很多时退化为
+ * O(n^2)(goodSelect每层还要顺序查找中值的中值, 更慢), 所以few_unique下randomiezdSelect只测试n不超过10000,
+ * goodSelect只测试n不超过1000的情况.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../select_algorithm/randomized_select/randomizedSelect.h"
+#include "../select_algorithm/good_select/goodSelect.h"
+#include "../select_algorithm/minimum/minimum.h"
+
+const std::size_t select_total_items = 2000000;
+const std::size_t unlimited = std::size_t(-1);
+
+//****************************各个选择算法的适配*******************************
+struct RandomizedSelect
+{
+    static const std::size_t few_unique_max = 10000;     // few_unique分布下测试的最大长度
+    static const char* name() { return "randomiezdSelect"; }
+    static int select(std::vector<int> &v, std::size_t rank) { return randomiezdSelect(v.begin(), v.end(), rank); }
+};
+struct IntroSelect
+{
+    static const std::size_t few_unique_max = unlimited;
+    static const char* name() { return "introSelect"; }
+    static int select(std::vector<int> &v, std::size_t rank) { return introSelect(v.begin(), v.end(), rank); }
+};
+struct GoodSelect
+{
+    static const std::size_t few_unique_max = 1000;
+    static const char* name() { return "goodSelect"; }
+    static int select(std::vector<int> &v, std::size_t rank) { return goodSelect(v.begin(), v.end(), rank); }
+};
+struct GoodSelectInPlace
+{
+    static const std::size_t few_unique_max = unlimited;
+    static const char* name() { return "goodSelectInPlace"; }
+    static int select(std::vector<int> &v, std::size_t rank) { return goodSelectInPlace(v.begin(), v.end(), rank); }
+};
+struct StdNthElement
+{
+    static const std::size_t few_unique_max = unlimited;
+    static const char* name() { return "std::nth_element"; }
+    static int select(std::vector<int> &v, std::size_t rank)
+    {
+        std::nth_element(v.begin(), v.begin() + rank, v.end());
+        return v[rank];
+    }
+};
+
+template<typename Select>
+void runSelect(BenchHarness &harness, bool baseline, const std::string &workload, const std::vector<int> &input,
+               std::vector<std::vector<int>> &copies)
+{
+    std::size_t n = input.size();
+    if (workload == "median_few_unique" && n > Select::few_unique_max)
+        return;
+    harness.run(Select::name(), baseline, workload.c_str(), n, copies.size(),
+                [&]{ std::fill(copies.begin(), copies.end(), input); },
+                [&](std::size_t i){ return static_cast<std::uint64_t>(Select::select(copies[i], n / 2)); }, n);
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "select");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        std::size_t ops = std::min<std::size_t>(1000, std::max<std::size_t>(3, select_total_items / n));
+        std::uint64_t state = 0x2545F4914F6CDD1Dull ^ n;
+        std::vector<int> random(n), sorted(n), fewUnique(n);
+        for (std::size_t i = 0; i != n; ++i){
+            random[i] = static_cast<int>(benchXorshift(state) >> 33);
+            sorted[i] = static_cast<int>(i);
+            fewUnique[i] = static_cast<int>(benchXorshift(state) % 16);
+        }
+        std::vector<std::vector<int>> copies(ops);
+        const char *orders[] = {"random", "sorted", "few_unique"};
+        const std::vector<int> *inputs[] = {&random, &sorted, &fewUnique};
+        for (int o = 0; o != 3; ++o){
+            const std::vector<int> &input = *inputs[o];
+            std::string suffix = std::string("_") + orders[o];
+            runSelect<RandomizedSelect>(harness, false, "median" + suffix, input, copies);
+            runSelect<IntroSelect>(harness, false, "median" + suffix, input, copies);
+            runSelect<GoodSelect>(harness, false, "median" + suffix, input, copies);
+            runSelect<GoodSelectInPlace>(harness, false, "median" + suffix, input, copies);
+            runSelect<StdNthElement>(harness, true, "median" + suffix, input, copies);
+            // 求最小值不修改输入, 直接在input上操作
+            harness.run("minimum", false, ("min" + suffix).c_str(), n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(minimum(input.begin(), input.end())); }, n);
+            harness.run("std::min_element", true, ("min" + suffix).c_str(), n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(*std::min_element(input.begin(), input.end())); }, n);
+        }
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+/*************************************************************************
+	> File Name: subset_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时54分39秒
+ ************************************************************************/
+// 最大相连子序列和的各个算法的对比, 输出见benchHarness.h
+/*
+ * 用法: ./subset_bench [最大长度(默认1000000)] [重复次数(默认3)]
+ * 元素为int64_t, 按三种分布产生(工作负载名的后缀):
+ *      --random: [-1000, 1000]中均匀随机;
+ *      --all_negative: [-1000, -1]中均匀随机(答案是最大的元素);
+ *      --mostly_positive: 90%在[0, 1000]中, 10%在[-1000, -1]中.
+ * 对比的算法: original(O(n^2), 只测试n不超过10000的情况), megre, online, parallelSubsetSum(默认线程数).
+ * 标准库中没有对应的算法, baseline用std::partial_sum求前缀和, 答案为P[j] - min(P[i]), i < j
+ * (前缀和数组在每次操作中分配与计算).
+ * 每次操作对整个序列求一次, 操作次数为2e6/n(original为2e7/n^2), 并限制在3到1000之间. items_per_op为n.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../subset_algorithm/original_subset_sum/originalSubsetSum.h"
+#include "../subset_algorithm/merge_subset_sum/mergeSubsetSum.h"
+#include "../subset_algorithm/online_subset_sum/onlineSubsetSum.h"
+#include "../subset_algorithm/parallel_subset_sum/parallelSubsetSum.h"
+
+const std::size_t subset_total_items = 2000000;
+const std::size_t original_total_steps = 20000000;
+const std::size_t original_max = 10000;
+
+typedef std::vector<std::int64_t> Sequence;
+
+// prefixSubsetSum: 用std::partial_sum实现的baseline
+std::int64_t prefixSubsetSum(const Sequence &v)
+{
+    Sequence prefix(v.size());
+    std::partial_sum(v.begin(), v.end(), prefix.begin());
+    std::int64_t best = prefix[0], lowest = 0;
+    for (std::size_t j = 0; j != prefix.size(); ++j){
+        best = std::max(best, prefix[j] - lowest);
+        lowest = std::min(lowest, prefix[j]);
+    }
+    return best;
+}
+
+inline std::size_t clampOps(std::size_t ops)
+{
+    return std::min<std::size_t>(1000, std::max<std::size_t>(3, ops));
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "subset_sum");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s], ops = clampOps(subset_total_items / n);
+        std::uint64_t state = 0x2545F4914F6CDD1Dull ^ n;
+        Sequence random(n), negative(n), positive(n);
+        for (std::size_t i = 0; i != n; ++i){
+            random[i] = static_cast<std::int64_t>(benchXorshift(state) % 2001) - 1000;
+            negative[i] = -1 - static_cast<std::int64_t>(benchXorshift(state) % 1000);
+            std::uint64_t r = benchXorshift(state);
+            positive[i] = r % 10 == 0 ? -1 - static_cast<std::int64_t>(r / 10 % 1000)
+                                      : static_cast<std::int64_t>(r / 10 % 1001);
+        }
+        const char *mixes[] = {"random", "all_negative", "mostly_positive"};
+        const Sequence *inputs[] = {&random, &negative, &positive};
+        for (int m = 0; m != 3; ++m){
+            const Sequence &v = *inputs[m];
+            const char *mix = mixes[m];
+            if (n <= original_max)
+                harness.run("original", false, mix, n, clampOps(original_total_steps / (n * n)), []{},
+                            [&](std::size_t){ return static_cast<std::uint64_t>(original(v.begin(), v.end())); }, n);
+            harness.run("megre", false, mix, n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(megre(v.begin(), v.end())); }, n);
+            harness.run("online", false, mix, n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(online(v.begin(), v.end())); }, n);
+            harness.run("parallelSubsetSum", false, mix, n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(parallelSubsetSum(v.begin(), v.end())); }, n);
+            harness.run("std::partial_sum", true, mix, n, ops, []{},
+                        [&](std::size_t){ return static_cast<std::uint64_t>(prefixSubsetSum(v)); }, n);
+        }
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/*************************************************************************
+	> File Name: tree_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时57分22秒
+ ************************************************************************/
+// RedBlackTree, BinarySearchTree与std::set的对比, 输出见benchHarness.h
+/*
+ * 用法: ./tree_bench [最大关键字个数(默认1000000)] [重复次数(默认3)]
+ * 关键字是0到n-1的一个排列, 按两种次序插入(工作负载名的后缀): random(随机), sorted(递增).
+ *      --insert: 向空树中插入n个关键字(包括make_shared分配节点);
+ *      --lower_bound: 查找min(n, 1000000)个随机选取的关键字;
+ *      --erase_min: 每次删除最小的关键字, 直到树为空(RedBlackTree::remove删除任意节点时delete_fixup
+ *        可能不结束, 测试程序只覆盖了删除最小的节点, 所以各个树都用这个负载).
+ * 对比的结构: RedBlackTree, BinarySearchTree(NoBalance与ScapegoatBalance), std::set.
+ * NoBalance在有序的输入下退化成链表, 插入是O(n^2), 只测试n不超过10000的情况.
+ *
+ */
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "benchHarness.h"
+#include "../tree_algorithm/RedBlackTree/RedBlackTree.h"
+#include "../tree_algorithm/binary_search_tree/binary_search_tree.h"
+
+const std::size_t tree_max_lookups = 1000000;
+const std::size_t unbalanced_sorted_max = 10000;
+
+typedef RedBlackTreeNode<int> RbNode;
+typedef BinaryTreeNode<int> BstNode;
+
+//****************************各个树的适配*******************************
+struct RbTree
+{
+    static const char* name() { return "RedBlackTree"; }
+    void insert(int key) { tree.insert(std::make_shared<RbNode>(key)); }
+    std::uint64_t lowerBound(int key) const { return *tree.lower_bound(key); }
+    void eraseMin() { tree.remove(tree.minimum(tree.root)); }
+    RedBlackTree<RbNode> tree;
+};
+template<typename Policy>
+struct SearchTree
+{
+    static const char* name();
+    void insert(int key) { tree.insert(std::make_shared<BstNode>(key)); }
+    std::uint64_t lowerBound(int key) const { return *tree.lower_bound(key); }
+    void eraseMin() { tree.remove(tree.minimum(tree.root)); }
+    BinarySearchTree<BstNode, Policy> tree;
+};
+template<>
+const char* SearchTree<NoBalance>::name() { return "BinarySearchTree"; }
+template<>
+const char* SearchTree<ScapegoatBalance<>>::name() { return "BinarySearchTree<Scapegoat>"; }
+struct StdSet
+{
+    static const char* name() { return "std::set"; }
+    void insert(int key) { tree.insert(key); }
+    std::uint64_t lowerBound(int key) const { return *tree.lower_bound(key); }
+    void eraseMin() { tree.erase(tree.begin()); }
+    std::set<int> tree;
+};
+
+template<typename Tree>
+void runTree(BenchHarness &harness, bool baseline, const char *order, const std::vector<int> &keys,
+             const std::vector<int> &probes)
+{
+    std::size_t n = keys.size();
+    std::unique_ptr<Tree> tree;
+    auto empty = [&]{ tree.reset(); tree.reset(new Tree); };
+    auto full = [&]{
+        empty();
+        for (std::size_t i = 0; i != n; ++i)
+            tree->insert(keys[i]);
+    };
+    std::string suffix = std::string("_") + order;
+    harness.run(Tree::name(), baseline, ("insert" + suffix).c_str(), n, n, empty,
+                [&](std::size_t i){ tree->insert(keys[i]); return static_cast<std::uint64_t>(1); });
+    harness.run(Tree::name(), baseline, ("lower_bound" + suffix).c_str(), n, probes.size(), full,
+                [&](std::size_t i){ return tree->lowerBound(probes[i]); });
+    harness.run(Tree::name(), baseline, ("erase_min" + suffix).c_str(), n, n, full,
+                [&](std::size_t){ tree->eraseMin(); return static_cast<std::uint64_t>(1); });
+    tree.reset();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchHarness harness(argc, argv, "tree");
+    std::vector<std::size_t> sizes = harness.sizes();
+    for (std::size_t s = 0; s != sizes.size(); ++s){
+        std::size_t n = sizes[s];
+        std::uint64_t state = 0x2545F4914F6CDD1Dull ^ n;
+        std::vector<int> sorted(n);
+        for (std::size_t i = 0; i != n; ++i)
+            sorted[i] = static_cast<int>(i);
+        std::vector<int> random(sorted), probes(std::min(n, tree_max_lookups));
+        for (std::size_t i = n - 1; i > 0; --i)
+            std::swap(random[i], random[benchXorshift(state) % (i + 1)]);
+        for (std::size_t i = 0; i != probes.size(); ++i)
+            probes[i] = static_cast<int>(benchXorshift(state) % n);
+        const char *orders[] = {"random", "sorted"};
+        const std::vector<int> *inputs[] = {&random, &sorted};
+        for (int o = 0; o != 2; ++o){
+            runTree<RbTree>(harness, false, orders[o], *inputs[o], probes);
+            if (o == 0 || n <= unbalanced_sorted_max)
+                runTree<SearchTree<NoBalance>>(harness, false, orders[o], *inputs[o], probes);
+            runTree<SearchTree<ScapegoatBalance<>>>(harness, false, orders[o], *inputs[o], probes);
+            runTree<StdSet>(harness, true, orders[o], *inputs[o], probes);
+        }
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
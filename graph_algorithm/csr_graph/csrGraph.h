@@ -0,0 +1,197 @@
+/*************************************************************************
+	> File Name: csrGraph.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时03分48秒
+ ************************************************************************/
+
+#ifndef _CSRGRAPH_H
+#define _CSRGRAPH_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+#include "../../sort_algorithm/radix_sort/radixSort.h"
+// CsrGraph: 压缩稀疏行(compressed sparse row)存储的有向图  算法导论22.1
+/*
+ * 邻接表的一种紧凑的表示: 顶点编号为0..vertices()-1, 所有的边按起点排好序连续地存放,
+ *      --offsets[u]..offsets[u + 1] - 1是顶点u的出边在targets与weights中的下标(offsets有vertices() + 1项);
+ *      --targets[e]是边e的终点, weights[e]是它的权重.
+ * 三个数组都是连续的, 遍历u的出边只是顺序地读一段内存, 不像链表实现的邻接表那样每条边一次缓存缺失.
+ * 无向图的每条边存为两个方向的两条有向边(见symmetric的构造函数). 建立以后图不再修改.
+ *
+ * 由边列表(GraphEdge的序列)建立:
+ *      --对每条边i生成64位的键(起点 << 32) | i, 用parallelRadixSort按执行策略排序(基数排序是稳定的,
+ *        同一个起点的边保持输入中的次序, 键的高位全为0的趟会被跳过);
+ *      --排好序的键中起点变化的位置就是offsets, 由各段并行地填写(每一项恰好被写一次);
+ *      --按键的低32位(边的下标)把终点与权重并行地拷贝到targets与weights.
+ * 顶点编号是32位的(最多2^32 - 1个顶点), 边的下标在排序时占键的低32位, 所以一次最多建立2^32 - 1条边;
+ * offsets是64位的. 建立时除了三个数组另需16字节/边的键与基数排序的辅助空间, 建好以后释放.
+ * 起点或终点不小于vertices时抛出std::out_of_range, 边或顶点过多时抛出std::length_error.
+ *
+ * 算法性能: 建立为O(V + E)(基数排序的趟数为键的有效字节数), degree与访问一条边为O(1).
+ *
+ */
+typedef std::uint32_t GraphVertex;
+const GraphVertex graph_npos = std::numeric_limits<GraphVertex>::max();     // 不存在的顶点(例如根的父结点)
+const std::size_t csr_build_grain = std::size_t(1) << 16;                   // 并行建立时每个任务至少处理的边数
+
+// GraphEdge: 边列表中的一条边
+template<typename Weight = std::uint32_t>
+struct GraphEdge
+{
+    GraphVertex from;
+    GraphVertex to;
+    Weight weight;
+};
+
+template<typename Weight = std::uint32_t>
+class CsrGraph
+{
+public:
+    typedef GraphVertex Vertex;
+    typedef std::uint64_t EdgeIndex;
+    typedef Weight WeightType;
+    //****************************构造函数*******************************
+    CsrGraph() : offsets(1, 0) {  }
+    // 由边列表[first, last)建立有向图(Iterator为随机访问迭代器, 元素为GraphEdge<Weight>)
+    template<typename Iterator>
+    CsrGraph(std::size_t vertices, Iterator first, Iterator last)
+    {
+        build(execution::seq, vertices, first, last);
+    }
+    template<typename Iterator>
+    CsrGraph(const ExecutionPolicy &exec, std::size_t vertices, Iterator first, Iterator last)
+    {
+        build(exec, vertices, first, last);
+    }
+    //****************************成员函数*******************************
+    std::size_t vertices() const { return offsets.size() - 1; }
+    EdgeIndex edges() const { return targets.size(); }
+    std::size_t degree(Vertex u) const { return static_cast<std::size_t>(offsets[u + 1] - offsets[u]); }
+    // edgeBegin, edgeEnd: 顶点u的出边的下标范围[edgeBegin(u), edgeEnd(u))
+    EdgeIndex edgeBegin(Vertex u) const { return offsets[u]; }
+    EdgeIndex edgeEnd(Vertex u) const { return offsets[u + 1]; }
+    Vertex target(EdgeIndex e) const { return targets[e]; }
+    const Weight& weight(EdgeIndex e) const { return weights[e]; }
+    // neighbors, neighborsEnd: 顶点u的所有邻居连续存放在[neighbors(u), neighborsEnd(u))中
+    const Vertex* neighbors(Vertex u) const { return targets.data() + offsets[u]; }
+    const Vertex* neighborsEnd(Vertex u) const { return targets.data() + offsets[u + 1]; }
+    // 三个数组本身(例如写入文件或交给其它程序)
+    const std::vector<EdgeIndex>& offsetArray() const { return offsets; }
+    const std::vector<Vertex>& targetArray() const { return targets; }
+    const std::vector<Weight>& weightArray() const { return weights; }
+    // transpose: 所有的边反向得到的图(入边的邻接表), 方向优化的BFS的自底向上一步需要它
+    CsrGraph transpose(const ExecutionPolicy &exec = execution::seq) const
+    {
+        // 先求每条边的起点, 再以(终点, 起点, 权重)作为边列表重新建立
+        std::vector<Vertex> sources(targets.size());
+        ExecutionPolicy run = chunkPolicy(exec, vertices());
+        std::size_t chunks = run.threads(), n = vertices();
+        parallelFor(run, chunks, [&](std::size_t c){
+            for (std::size_t u = n * c / chunks, to = n * (c + 1) / chunks; u != to; ++u)
+                std::fill(sources.begin() + offsets[u], sources.begin() + offsets[u + 1], static_cast<Vertex>(u));
+        });
+        CsrGraph reversed;
+        reversed.assign(exec, n, targets.size(), [&](std::size_t e){
+            GraphEdge<Weight> edge = {targets[e], sources[e], weights[e]};
+            return edge;
+        });
+        return reversed;
+    }
+    // symmetric: 由无向图的边列表建立, 每条边{u, v}存为u->v与v->u两条边
+    template<typename Iterator>
+    static CsrGraph symmetric(const ExecutionPolicy &exec, std::size_t vertices, Iterator first, Iterator last)
+    {
+        std::size_t m = static_cast<std::size_t>(std::distance(first, last));
+        CsrGraph graph;
+        graph.assign(exec, vertices, 2 * m, [&](std::size_t i){
+            GraphEdge<Weight> edge = first[i < m ? i : i - m];
+            if (i >= m)
+                std::swap(edge.from, edge.to);
+            return edge;
+        });
+        return graph;
+    }
+    template<typename Iterator>
+    static CsrGraph symmetric(std::size_t vertices, Iterator first, Iterator last)
+    {
+        return symmetric(execution::seq, vertices, first, last);
+    }
+
+private:
+    //****************************数据结构*******************************
+    std::vector<EdgeIndex> offsets;     // offsets[u]: 顶点u的第一条出边, offsets[vertices()] == edges()
+    std::vector<Vertex> targets;        // targets[e]: 边e的终点
+    std::vector<Weight> weights;        // weights[e]: 边e的权重
+
+    // chunkPolicy: 处理n个元素时使用的策略, 元素太少时退化为串行, 段数不超过n / csr_build_grain
+    static ExecutionPolicy chunkPolicy(const ExecutionPolicy &exec, std::size_t n)
+    {
+        if (!exec.runParallel(n, csr_build_grain))
+            return execution::seq;
+        return exec.withThreads(std::max<std::size_t>(1, std::min(exec.threads(), n / exec.grain(csr_build_grain))));
+    }
+    template<typename Iterator>
+    void build(const ExecutionPolicy &exec, std::size_t vertices, Iterator first, Iterator last)
+    {
+        assign(exec, vertices, static_cast<std::size_t>(std::distance(first, last)),
+               [&](std::size_t i){ return GraphEdge<Weight>(first[i]); });
+    }
+    // assign: 由m条边edgeAt(0), ..., edgeAt(m - 1)建立, edgeAt可以被并发地调用
+    template<typename EdgeAt>
+    void assign(const ExecutionPolicy &exec, std::size_t n, std::size_t m, EdgeAt edgeAt)
+    {
+        if (n >= graph_npos)
+            throw std::length_error("CsrGraph error: too many vertices!");
+        if (m >= (std::uint64_t(1) << 32))
+            throw std::length_error("CsrGraph error: too many edges for one build!");
+        ExecutionPolicy run = chunkPolicy(exec, m);
+        std::size_t chunks = run.threads();
+        // 1. 生成(起点, 下标)的键并检查顶点编号
+        std::vector<std::uint64_t> keys(m);
+        std::vector<char> invalid(chunks, 0);
+        parallelFor(run, chunks, [&](std::size_t c){
+            for (std::size_t i = m * c / chunks, to = m * (c + 1) / chunks; i != to; ++i){
+                GraphEdge<Weight> edge = edgeAt(i);
+                if (edge.from >= n || edge.to >= n)
+                    invalid[c] = 1;
+                keys[i] = (std::uint64_t(edge.from) << 32) | i;
+            }
+        });
+        if (std::find(invalid.begin(), invalid.end(), 1) != invalid.end())
+            throw std::out_of_range("CsrGraph error: edge endpoint is not a vertex!");
+        // 2. 按起点稳定地排序
+        {
+            std::vector<std::uint64_t> scratch;
+            parallelRadixSort(exec, keys.begin(), keys.end(), scratch);
+        }
+        // 3. 起点变化处填写offsets: 第i个键的起点s与前一个键的起点p之间的顶点(p, s]的第一条边都是i
+        offsets.assign(n + 1, 0);
+        parallelFor(run, chunks, [&](std::size_t c){
+            for (std::size_t i = m * c / chunks, to = m * (c + 1) / chunks; i != to; ++i){
+                std::uint64_t s = keys[i] >> 32;
+                std::uint64_t p = i == 0 ? 0 : (keys[i - 1] >> 32) + 1;
+                for (; p <= s; ++p)
+                    offsets[p] = i;
+            }
+        });
+        for (std::uint64_t v = m == 0 ? 0 : (keys[m - 1] >> 32) + 1; v <= n; ++v)
+            offsets[v] = m;
+        // 4. 按排好的次序拷贝终点与权重
+        targets.resize(m);
+        weights.resize(m);
+        parallelFor(run, chunks, [&](std::size_t c){
+            for (std::size_t i = m * c / chunks, to = m * (c + 1) / chunks; i != to; ++i){
+                GraphEdge<Weight> edge = edgeAt(static_cast<std::size_t>(keys[i] & 0xFFFFFFFFu));
+                targets[i] = edge.to;
+                weights[i] = edge.weight;
+            }
+        });
+    }
+};
+#endif
@@ -0,0 +1,103 @@
+/*************************************************************************
+	> File Name: csrGraph_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时18分23秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "csrGraph.h"
+using std::cout;
+using std::endl;
+
+typedef GraphEdge<std::uint32_t> Edge;
+
+// smallTest: 出边按起点分组, 同一个起点的边保持输入的次序
+void smallTest()
+{
+    std::vector<Edge> edges = {{2, 0, 5}, {0, 1, 1}, {2, 1, 6}, {0, 3, 2}, {3, 2, 7}, {0, 2, 3}};
+    CsrGraph<> graph(5, edges.begin(), edges.end());
+    std::vector<std::uint64_t> offsets = {0, 3, 3, 5, 6, 6};
+    std::vector<GraphVertex> targets = {1, 3, 2, 0, 1, 2};
+    std::vector<std::uint32_t> weights = {1, 2, 3, 5, 6, 7};
+    bool correct = graph.vertices() == 5 && graph.edges() == 6 && graph.offsetArray() == offsets
+                   && graph.targetArray() == targets && graph.weightArray() == weights
+                   && graph.degree(0) == 3 && graph.degree(1) == 0 && graph.degree(4) == 0
+                   && graph.neighborsEnd(2) - graph.neighbors(2) == 2 && graph.neighbors(2)[1] == 1;
+    cout << "由边列表建立: " << (correct ? "正确" : "错误") << endl;
+
+    CsrGraph<> reversed = graph.transpose();
+    std::vector<std::uint64_t> in_offsets = {0, 1, 3, 5, 6, 6};
+    std::vector<GraphVertex> sources = {2, 0, 2, 0, 3, 0};
+    correct = reversed.offsetArray() == in_offsets && reversed.targetArray() == sources
+              && reversed.weight(reversed.edgeBegin(2)) == 3 && reversed.weight(reversed.edgeBegin(2) + 1) == 7;
+    // 入边按原图中边的下标排列
+    cout << "转置: " << (correct ? "正确" : "错误") << endl;
+
+    std::vector<Edge> roads = {{0, 1, 4}, {1, 2, 8}};
+    CsrGraph<> undirected = CsrGraph<>::symmetric(3, roads.begin(), roads.end());
+    correct = undirected.edges() == 4 && undirected.degree(1) == 2 && undirected.target(undirected.edgeBegin(1)) == 2
+              && undirected.target(undirected.edgeBegin(1) + 1) == 0 && undirected.weight(undirected.edgeBegin(2)) == 8;
+    cout << "无向图: " << (correct ? "正确" : "错误") << endl;
+
+    CsrGraph<> empty(3, edges.begin(), edges.begin()), none;
+    correct = empty.vertices() == 3 && empty.edges() == 0 && empty.degree(2) == 0 && none.vertices() == 0;
+    try{
+        std::vector<Edge> bad = {{0, 5, 1}};
+        CsrGraph<> wrong(5, bad.begin(), bad.end());
+        correct = false;
+    }catch (const std::out_of_range &){  }
+    cout << "空图与错误的顶点: " << (correct ? "正确" : "错误") << endl;
+}
+
+// parallelTest: 并行建立的图与串行建立的完全相同
+void parallelTest()
+{
+    std::mt19937 gen(11);
+    const std::uint32_t n = 50000;
+    std::vector<GraphEdge<int>> edges(400000);
+    for (auto &e : edges)
+        e = GraphEdge<int>{static_cast<GraphVertex>(gen() % n), static_cast<GraphVertex>(gen() % n), static_cast<int>(gen() % 100) - 50};
+    CsrGraph<int> serial(n, edges.begin(), edges.end());
+    bool correct = true;
+    ExecutionPolicy policies[] = {execution::par, execution::par.withThreads(4).withGrain(1000), execution::par_unseq.withThreads(3)};
+    for (const ExecutionPolicy &exec : policies){
+        CsrGraph<int> graph(exec, n, edges.begin(), edges.end());
+        correct = correct && graph.offsetArray() == serial.offsetArray() && graph.targetArray() == serial.targetArray()
+                  && graph.weightArray() == serial.weightArray();
+        // 转置两次得到原来的图, 只是每个邻接表按邻居排好了序
+        CsrGraph<int> reversed = graph.transpose(exec), back = reversed.transpose(exec);
+        correct = correct && reversed.edges() == graph.edges() && back.offsetArray() == serial.offsetArray();
+        for (GraphVertex u = 0; u != n && correct; ++u){
+            std::vector<std::pair<GraphVertex, int>> expect, got;
+            for (auto e = serial.edgeBegin(u); e != serial.edgeEnd(u); ++e)
+                expect.push_back(std::make_pair(serial.target(e), serial.weight(e)));
+            for (auto e = back.edgeBegin(u); e != back.edgeEnd(u); ++e)
+                got.push_back(std::make_pair(back.target(e), back.weight(e)));
+            correct = std::is_sorted(back.neighbors(u), back.neighborsEnd(u));
+            std::sort(expect.begin(), expect.end());
+            std::sort(got.begin(), got.end());
+            correct = correct && expect == got;
+        }
+    }
+    // 每条边都在它的起点的邻接表中
+    std::vector<std::uint64_t> seen(n, 0);
+    for (const auto &e : edges){
+        std::uint64_t k = serial.edgeBegin(e.from) + seen[e.from]++;
+        correct = correct && serial.target(k) == e.to && serial.weight(k) == e.weight;
+    }
+    cout << "并行建立与转置: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************CsrGraph的测试********************\n";
+    smallTest();
+    parallelTest();
+    return 0;
+}
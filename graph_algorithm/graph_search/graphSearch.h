@@ -0,0 +1,146 @@
+/*************************************************************************
+	> File Name: graphSearch.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时06分31秒
+ ************************************************************************/
+
+#ifndef _GRAPHSEARCH_H
+#define _GRAPHSEARCH_H
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../csr_graph/csrGraph.h"
+#include "../../stack_algorithm/stack.h"
+// 图的广度优先搜索与深度优先搜索  算法导论22.2, 22.3
+/*
+ * bfs(graph, s): 广度优先搜索, 求出从s可以到达的每个顶点的BFS树中的父结点与深度(到s的边数)
+ *      --队列中的顶点按入队的次序写入order, order本身就是FIFO队列: head是队头, order.size()是队尾.
+ *        每个顶点恰好入队一次, 所以队列的容量就是V, 不需要环绕; queue.h中的Queue为每个元素保存一个
+ *        std::shared_ptr且容量固定, 不适合上亿个顶点的图;
+ *      --depth[v] == graph_npos表示v不可到达, parent[s] == graph_npos.
+ *
+ * dfs(graph): 深度优先搜索, 按顶点编号的次序从每个还没有发现的顶点出发, 得到深度优先森林;
+ * dfs(graph, s): 只从s出发.
+ *      --递归的DFS在长链上会栈溢出, 这里用InlineStack(stack.h)保存{顶点, 下一条要检查的边}, 与递归的调用栈
+ *        一一对应, 所以发现与完成的次序与算法导论中的递归版本完全相同;
+ *      --discover[v]与finish[v]是发现时间与完成时间(时间戳从1开始, 未发现时为0), 满足括号化定理;
+ *        order是按发现时间排列的顶点(先序), finished是按完成时间排列的顶点(后序, 反过来就是拓扑排序).
+ *
+ * 算法性能: 两者都是O(V + E)的时间, O(V)的额外空间.
+ *
+ */
+
+// BfsTree: 广度优先搜索的结果
+struct BfsTree
+{
+    std::vector<GraphVertex> parent;    // BFS树中的父结点, 根与不可到达的顶点为graph_npos
+    std::vector<GraphVertex> depth;     // 到根的边数, 不可到达时为graph_npos
+    std::vector<GraphVertex> order;     // 按入队(发现)次序排列的可到达的顶点
+};
+
+// bfs: 从source出发的广度优先搜索
+template<typename Weight>
+BfsTree bfs(const CsrGraph<Weight> &graph, GraphVertex source)
+{
+    if (source >= graph.vertices())
+        throw std::out_of_range("bfs error: the source is not a vertex!");
+    BfsTree tree;
+    tree.parent.assign(graph.vertices(), graph_npos);
+    tree.depth.assign(graph.vertices(), graph_npos);
+    tree.order.reserve(graph.vertices());
+    tree.depth[source] = 0;
+    tree.order.push_back(source);
+    for (std::size_t head = 0; head != tree.order.size(); ++head){
+        GraphVertex u = tree.order[head];
+        GraphVertex next = tree.depth[u] + 1;
+        for (const GraphVertex *v = graph.neighbors(u), *end = graph.neighborsEnd(u); v != end; ++v)
+            if (tree.depth[*v] == graph_npos){
+                tree.depth[*v] = next;
+                tree.parent[*v] = u;
+                tree.order.push_back(*v);
+            }
+    }
+    return tree;
+}
+
+// DfsForest: 深度优先搜索的结果
+struct DfsForest
+{
+    std::vector<GraphVertex> parent;        // 深度优先森林中的父结点, 树根与没有发现的顶点为graph_npos
+    std::vector<std::uint64_t> discover;    // 发现时间, 没有发现时为0
+    std::vector<std::uint64_t> finish;      // 完成时间, 没有发现时为0
+    std::vector<GraphVertex> order;         // 按发现时间排列的顶点
+    std::vector<GraphVertex> finished;      // 按完成时间排列的顶点
+};
+
+// dfsVisit: 从root出发访问所有还没有发现的顶点, time为当前的时间戳
+template<typename Weight>
+void dfsVisit(const CsrGraph<Weight> &graph, GraphVertex root, DfsForest &forest, std::uint64_t &time)
+{
+    // Frame: 对应递归版本中的一次DFS-VISIT(u), next是下一条要检查的出边
+    struct Frame
+    {
+        GraphVertex vertex;
+        typename CsrGraph<Weight>::EdgeIndex next;
+    };
+    InlineStack<Frame, 64> stack;
+    forest.discover[root] = ++time;
+    forest.order.push_back(root);
+    stack.push(Frame{root, graph.edgeBegin(root)});
+    while (!stack.empty()){
+        Frame &frame = stack.top();
+        GraphVertex u = frame.vertex;
+        if (frame.next == graph.edgeEnd(u)){
+            forest.finish[u] = ++time;
+            forest.finished.push_back(u);
+            stack.pop();
+            continue;
+        }
+        GraphVertex v = graph.target(frame.next++);
+        if (forest.discover[v] == 0){
+            forest.parent[v] = u;
+            forest.discover[v] = ++time;
+            forest.order.push_back(v);
+            stack.push(Frame{v, graph.edgeBegin(v)});    // frame在push以后可能失效, 之后不再使用
+        }
+    }
+}
+
+template<typename Weight>
+DfsForest dfsInit(const CsrGraph<Weight> &graph)
+{
+    DfsForest forest;
+    forest.parent.assign(graph.vertices(), graph_npos);
+    forest.discover.assign(graph.vertices(), 0);
+    forest.finish.assign(graph.vertices(), 0);
+    forest.order.reserve(graph.vertices());
+    forest.finished.reserve(graph.vertices());
+    return forest;
+}
+
+// dfs: 整个图的深度优先森林
+template<typename Weight>
+DfsForest dfs(const CsrGraph<Weight> &graph)
+{
+    DfsForest forest = dfsInit(graph);
+    std::uint64_t time = 0;
+    for (std::size_t u = 0; u != graph.vertices(); ++u)
+        if (forest.discover[u] == 0)
+            dfsVisit(graph, static_cast<GraphVertex>(u), forest, time);
+    return forest;
+}
+
+// dfs: 从source出发的深度优先树
+template<typename Weight>
+DfsForest dfs(const CsrGraph<Weight> &graph, GraphVertex source)
+{
+    if (source >= graph.vertices())
+        throw std::out_of_range("dfs error: the source is not a vertex!");
+    DfsForest forest = dfsInit(graph);
+    std::uint64_t time = 0;
+    dfsVisit(graph, source, forest, time);
+    return forest;
+}
+#endif
@@ -0,0 +1,80 @@
+/*************************************************************************
+	> File Name: graphSearch_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时22分06秒
+ ************************************************************************/
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "graphSearch.h"
+using std::cout;
+using std::endl;
+
+typedef GraphEdge<std::uint32_t> Edge;
+
+// bfsTest: 算法导论图22-3的无向图, 顶点r, s, t, u, v, w, x, y编号为0..7, 从s出发
+void bfsTest()
+{
+    std::vector<Edge> edges = {{0, 1, 1}, {0, 4, 1}, {1, 5, 1}, {5, 2, 1}, {5, 6, 1},
+                               {2, 6, 1}, {2, 3, 1}, {6, 3, 1}, {6, 7, 1}, {3, 7, 1}};
+    CsrGraph<> graph = CsrGraph<>::symmetric(8, edges.begin(), edges.end());
+    BfsTree tree = bfs(graph, 1);
+    std::vector<GraphVertex> depth = {1, 0, 2, 3, 2, 1, 2, 3};
+    bool correct = tree.depth == depth && tree.order.size() == 8 && tree.order[0] == 1 && tree.parent[1] == graph_npos;
+    for (GraphVertex v = 0; v != 8; ++v)
+        if (v != 1)
+            correct = correct && tree.depth[tree.parent[v]] + 1 == tree.depth[v];
+    for (std::size_t i = 1; i != tree.order.size(); ++i)
+        correct = correct && tree.depth[tree.order[i - 1]] <= tree.depth[tree.order[i]];
+    cout << "广度优先搜索(图22-3): " << (correct ? "正确" : "错误") << endl;
+
+    std::vector<Edge> arcs = {{0, 1, 1}, {1, 2, 1}, {3, 0, 1}};
+    CsrGraph<> directed(5, arcs.begin(), arcs.end());
+    BfsTree part = bfs(directed, 0);
+    correct = part.depth[2] == 2 && part.depth[3] == graph_npos && part.depth[4] == graph_npos
+              && part.parent[3] == graph_npos && part.order.size() == 3;
+    try{
+        bfs(directed, 5);
+        correct = false;
+    }catch (const std::out_of_range &){  }
+    cout << "不可到达的顶点与错误的起点: " << (correct ? "正确" : "错误") << endl;
+}
+
+// dfsTest: 算法导论图22-4的有向图, 顶点u, v, w, x, y, z编号为0..5
+void dfsTest()
+{
+    std::vector<Edge> edges = {{0, 1, 1}, {0, 3, 1}, {1, 4, 1}, {2, 4, 1}, {2, 5, 1}, {3, 1, 1}, {4, 3, 1}, {5, 5, 1}};
+    CsrGraph<> graph(6, edges.begin(), edges.end());
+    DfsForest forest = dfs(graph);
+    std::vector<std::uint64_t> discover = {1, 2, 9, 4, 3, 10}, finish = {8, 7, 12, 5, 6, 11};
+    std::vector<GraphVertex> order = {0, 1, 4, 3, 2, 5}, finished = {3, 4, 1, 0, 5, 2};
+    std::vector<GraphVertex> parent = {graph_npos, 0, graph_npos, 4, 1, 2};
+    bool correct = forest.discover == discover && forest.finish == finish && forest.order == order
+                   && forest.finished == finished && forest.parent == parent;
+    cout << "深度优先搜索(图22-4): " << (correct ? "正确" : "错误") << endl;
+
+    DfsForest fromW = dfs(graph, 2);
+    correct = fromW.order == std::vector<GraphVertex>({2, 4, 3, 1, 5}) && fromW.discover[0] == 0 && fromW.finish[2] == 10;
+    cout << "从一个顶点出发: " << (correct ? "正确" : "错误") << endl;
+
+    // 一条长链: 递归的DFS在这里会栈溢出
+    const GraphVertex n = 1000000;
+    std::vector<Edge> chain;
+    for (GraphVertex v = 0; v + 1 < n; ++v)
+        chain.push_back(Edge{v, v + 1, 1});
+    CsrGraph<> path(n, chain.begin(), chain.end());
+    DfsForest deep = dfs(path, 0);
+    correct = deep.finished.size() == n && deep.finished[0] == n - 1 && deep.finish[0] == 2 * std::uint64_t(n)
+              && deep.discover[n - 1] == n && bfs(path, 0).depth[n - 1] == n - 1;
+    cout << "长链: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************广度优先搜索与深度优先搜索的测试********************\n";
+    bfsTest();
+    dfsTest();
+    return 0;
+}
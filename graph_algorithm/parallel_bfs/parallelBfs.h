@@ -0,0 +1,149 @@
+/*************************************************************************
+	> File Name: parallelBfs.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时09分14秒
+ ************************************************************************/
+
+#ifndef _PARALLELBFS_H
+#define _PARALLELBFS_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../graph_search/graphSearch.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+// parallelBfs: 方向优化的并行广度优先搜索(Beamer, Asanović, Patterson, SC 2012)
+/*
+ * 逐层推进, 每一层在两种做法之间选择:
+ *      --自顶向下(top-down): 把frontier(当前一层的顶点)分成若干段并行处理, 检查每个frontier顶点的出边,
+ *        用compare_exchange把还没有到达的邻居的depth从graph_npos改为下一层, 只有成功的任务记录父结点并把它
+ *        放入自己的局部队列, 各段的局部队列按段的次序连接起来就是下一层. 工作量与frontier的出边数成正比;
+ *      --自底向上(bottom-up): 把所有顶点分成若干段并行处理, 每个还没有到达的顶点v检查自己的入边, 找到第一个
+ *        在当前一层的邻居就停下(不需要原子的比较交换, 每个顶点只由自己所在的任务写). frontier很大时
+ *        (小世界图的中间几层)大多数顶点很快就能找到父结点, 检查的边远少于top-down.
+ * 开关的条件与论文相同: top-down时frontier的出边数m_f超过未到达顶点的边数m_u的1/alpha时改为bottom-up;
+ * bottom-up时frontier的顶点数小于V/beta时改回top-down.
+ *
+ * inGraph是graph的转置(graph.transpose(exec)); 无向图(CsrGraph::symmetric)的转置就是它自己,
+ * 可以使用三个参数的重载. 串行策略或者顶点数小于exec.grain(parallel_bfs_grain)时直接调用bfs.
+ * 结果与bfs相同: depth是确定的; parent是BFS树中任意一个合法的父结点, order中同一层的顶点的次序可能不同.
+ *
+ * 算法性能: 最坏O(V + E)的工作量(每层O(V / P)的扫描), 小世界图上bottom-up使检查的边数远小于E.
+ *
+ */
+const std::size_t parallel_bfs_grain = std::size_t(1) << 16;    // 默认的并行阈值(顶点数)
+const std::size_t parallel_bfs_alpha = 15;
+const std::size_t parallel_bfs_beta = 18;
+const std::size_t parallel_bfs_chunk = 1024;    // 每一段至少的顶点数
+
+// parallelBfs: 有向图上从source出发的广度优先搜索, inGraph为graph的转置
+template<typename Weight>
+BfsTree parallelBfs(const ExecutionPolicy &exec, const CsrGraph<Weight> &graph, const CsrGraph<Weight> &inGraph,
+                    GraphVertex source)
+{
+    const std::size_t n = graph.vertices();
+    if (source >= n)
+        throw std::out_of_range("parallelBfs error: the source is not a vertex!");
+    if (inGraph.vertices() != n || inGraph.edges() != graph.edges())
+        throw std::invalid_argument("parallelBfs error: inGraph is not the transpose of graph!");
+    if (!exec.runParallel(n, parallel_bfs_grain))
+        return bfs(graph, source);
+    const std::size_t threads = exec.threads();
+    BfsTree tree;
+    tree.parent.assign(n, graph_npos);
+    tree.order.reserve(n);
+    std::vector<std::atomic<GraphVertex>> depth(n);
+    // 分段处理count个元素时的段数
+    auto chunksFor = [threads](std::size_t count){
+        return std::max<std::size_t>(1, std::min(threads * 4, count / parallel_bfs_chunk));
+    };
+    std::size_t init = chunksFor(n);
+    parallelFor(exec, init, [&](std::size_t c){
+        for (std::size_t v = n * c / init, to = n * (c + 1) / init; v != to; ++v)
+            depth[v].store(graph_npos, std::memory_order_relaxed);
+    });
+
+    depth[source].store(0, std::memory_order_relaxed);
+    tree.order.push_back(source);
+    std::size_t levelBegin = 0;                                     // 当前一层在order中的起点
+    std::uint64_t frontierEdges = graph.degree(source);             // m_f
+    std::uint64_t unexploredEdges = graph.edges() - frontierEdges;  // m_u
+    bool bottomUp = false;
+    std::vector<std::vector<GraphVertex>> next;
+    std::vector<std::uint64_t> nextEdges;
+    for (GraphVertex level = 0; levelBegin != tree.order.size(); ++level){
+        std::size_t frontier = tree.order.size() - levelBegin;
+        if (!bottomUp && frontierEdges > unexploredEdges / parallel_bfs_alpha)
+            bottomUp = true;
+        else if (bottomUp && frontier < n / parallel_bfs_beta)
+            bottomUp = false;
+        std::size_t chunks = chunksFor(bottomUp ? n : frontier);
+        next.assign(chunks, std::vector<GraphVertex>());
+        nextEdges.assign(chunks, 0);
+        const GraphVertex nextLevel = level + 1;
+        if (bottomUp){
+            parallelFor(exec, chunks, [&](std::size_t c){
+                std::vector<GraphVertex> &found = next[c];
+                std::uint64_t edges = 0;
+                for (std::size_t v = n * c / chunks, to = n * (c + 1) / chunks; v != to; ++v){
+                    if (depth[v].load(std::memory_order_relaxed) != graph_npos)
+                        continue;
+                    GraphVertex vertex = static_cast<GraphVertex>(v);
+                    for (const GraphVertex *u = inGraph.neighbors(vertex), *end = inGraph.neighborsEnd(vertex); u != end; ++u)
+                        if (depth[*u].load(std::memory_order_relaxed) == level){
+                            depth[v].store(nextLevel, std::memory_order_relaxed);
+                            tree.parent[v] = *u;
+                            found.push_back(vertex);
+                            edges += graph.degree(vertex);
+                            break;
+                        }
+                }
+                nextEdges[c] = edges;
+            });
+        }else{
+            const GraphVertex *current = tree.order.data() + levelBegin;
+            parallelFor(exec, chunks, [&](std::size_t c){
+                std::vector<GraphVertex> &found = next[c];
+                std::uint64_t edges = 0;
+                for (std::size_t i = frontier * c / chunks, to = frontier * (c + 1) / chunks; i != to; ++i){
+                    GraphVertex u = current[i];
+                    for (const GraphVertex *v = graph.neighbors(u), *end = graph.neighborsEnd(u); v != end; ++v){
+                        GraphVertex expected = graph_npos;
+                        if (depth[*v].load(std::memory_order_relaxed) == graph_npos
+                            && depth[*v].compare_exchange_strong(expected, nextLevel, std::memory_order_relaxed)){
+                            tree.parent[*v] = u;
+                            found.push_back(*v);
+                            edges += graph.degree(*v);
+                        }
+                    }
+                }
+                nextEdges[c] = edges;
+            });
+        }
+        // 各段找到的顶点按段的次序追加到order, 成为下一层的frontier
+        levelBegin = tree.order.size();
+        frontierEdges = 0;
+        for (std::size_t c = 0; c != chunks; ++c){
+            tree.order.insert(tree.order.end(), next[c].begin(), next[c].end());
+            frontierEdges += nextEdges[c];
+        }
+        unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+    }
+    tree.depth.resize(n);
+    parallelFor(exec, init, [&](std::size_t c){
+        for (std::size_t v = n * c / init, to = n * (c + 1) / init; v != to; ++v)
+            tree.depth[v] = depth[v].load(std::memory_order_relaxed);
+    });
+    return tree;
+}
+
+// parallelBfs: 无向图(或者对称的有向图)上的广度优先搜索
+template<typename Weight>
+BfsTree parallelBfs(const ExecutionPolicy &exec, const CsrGraph<Weight> &graph, GraphVertex source)
+{
+    return parallelBfs(exec, graph, graph, source);
+}
+#endif
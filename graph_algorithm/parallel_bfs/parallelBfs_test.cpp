@@ -0,0 +1,108 @@
+/*************************************************************************
+	> File Name: parallelBfs_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时24分49秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "parallelBfs.h"
+using std::cout;
+using std::endl;
+
+typedef GraphEdge<std::uint32_t> Edge;
+
+// validTree: depth与bfs相同, 每个父结点都由一条边连到自己且深度小1, order中每个可到达的顶点恰好一次且按层排列
+bool validTree(const CsrGraph<> &graph, const BfsTree &tree, const BfsTree &expect)
+{
+    if (tree.depth != expect.depth || tree.order.size() != expect.order.size())
+        return false;
+    std::vector<char> seen(graph.vertices(), 0);
+    for (std::size_t i = 0; i != tree.order.size(); ++i){
+        GraphVertex v = tree.order[i];
+        if (seen[v] || (i != 0 && tree.depth[tree.order[i - 1]] > tree.depth[v]))
+            return false;
+        seen[v] = 1;
+        if (tree.depth[v] == 0)
+            continue;
+        GraphVertex p = tree.parent[v];
+        if (p == graph_npos || tree.depth[p] + 1 != tree.depth[v]
+            || std::find(graph.neighbors(p), graph.neighborsEnd(p), v) == graph.neighborsEnd(p))
+            return false;
+    }
+    return true;
+}
+
+std::vector<Edge> randomEdges(std::mt19937 &gen, std::size_t n, std::size_t m, bool skewed)
+{
+    std::vector<Edge> edges(m);
+    for (auto &e : edges){
+        // skewed: 一半的边的一端落在前1%的顶点上(少数度很大的顶点, 类似网络拓扑的中心结点)
+        GraphVertex u = static_cast<GraphVertex>(skewed && gen() % 2 ? gen() % (n / 100) : gen() % n);
+        e = Edge{u, static_cast<GraphVertex>(gen() % n), 1};
+    }
+    return edges;
+}
+
+void directedTest()
+{
+    std::mt19937 gen(17);
+    const std::size_t n = 100000;
+    std::vector<Edge> edges = randomEdges(gen, n, 1000000, false);
+    CsrGraph<> graph(execution::par, n, edges.begin(), edges.end());
+    CsrGraph<> inGraph = graph.transpose(execution::par);
+    bool correct = true;
+    ExecutionPolicy policies[] = {execution::par.withGrain(1000), execution::par.withThreads(4).withGrain(1000), execution::par_unseq.withGrain(1)};
+    for (GraphVertex source = 0; source != 3; ++source){
+        BfsTree expect = bfs(graph, source);
+        for (const ExecutionPolicy &exec : policies)
+            correct = correct && validTree(graph, parallelBfs(exec, graph, inGraph, source), expect);
+    }
+    cout << "有向随机图: " << (correct ? "正确" : "错误") << endl;
+}
+
+void undirectedTest()
+{
+    std::mt19937 gen(29);
+    const std::size_t n = 200000;
+    std::vector<Edge> edges = randomEdges(gen, n, 800000, true);
+    // 再加一条与其它顶点不相连的链, 检查不可到达的顶点与很深的层
+    const GraphVertex chain = 5000;
+    for (GraphVertex v = n - chain; v + 1 < n; ++v)
+        edges.push_back(Edge{v, v + 1, 1});
+    edges.erase(std::remove_if(edges.begin(), edges.end() - (chain - 1), [&](const Edge &e){
+        return e.from >= n - chain || e.to >= n - chain;
+    }), edges.end() - (chain - 1));
+    CsrGraph<> graph = CsrGraph<>::symmetric(execution::par, n, edges.begin(), edges.end());
+    bool correct = true;
+    for (GraphVertex source : {GraphVertex(0), GraphVertex(n / 2), GraphVertex(n - chain)}){
+        BfsTree expect = bfs(graph, source);
+        correct = correct && validTree(graph, parallelBfs(execution::par.withThreads(4).withGrain(1000), graph, source), expect);
+    }
+    BfsTree tail = parallelBfs(execution::par.withGrain(1000), graph, n - chain);
+    correct = correct && tail.depth[n - 1] == chain - 1 && tail.depth[0] == graph_npos && tail.order.size() == chain;
+    cout << "无向图(度很大的中心结点与长链): " << (correct ? "正确" : "错误") << endl;
+
+    // 串行策略与很小的图直接调用bfs
+    std::vector<Edge> small = {{0, 1, 1}, {1, 2, 1}};
+    CsrGraph<> line = CsrGraph<>::symmetric(3, small.begin(), small.end());
+    BfsTree a = parallelBfs(execution::seq, graph, 0), b = parallelBfs(execution::par, line, 2);
+    correct = a.depth == bfs(graph, 0).depth && b.depth == std::vector<GraphVertex>({2, 1, 0});
+    try{
+        parallelBfs(execution::par, line, 3);
+        correct = false;
+    }catch (const std::out_of_range &){  }
+    cout << "串行策略, 小图与错误的起点: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************方向优化的并行BFS的测试********************\n";
+    directedTest();
+    undirectedTest();
+    return 0;
+}
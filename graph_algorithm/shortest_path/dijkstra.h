@@ -0,0 +1,143 @@
+/*************************************************************************
+	> File Name: dijkstra.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时12分57秒
+ ************************************************************************/
+
+#ifndef _DIJKSTRA_H
+#define _DIJKSTRA_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "../csr_graph/csrGraph.h"
+#include "../../queue_algorithm/min_queue/minqueue.h"
+#include "../../queue_algorithm/pairing_heap/pairingHeap.h"
+#include "../../queue_algorithm/radix_heap/radixHeap.h"
+// dijkstra: 单源最短路径的Dijkstra算法  算法导论24.3
+/*
+ * 要求所有的边权非负(有符号的权重遇到负数时抛出std::invalid_argument).
+ * 优先队列是模板参数, 三种队列的接口相同(push返回句柄, extract_min, decrease_key), 元素为GraphLabel:
+ *      --BinaryHeapQueue: IndexedMinQueue(二叉堆), 默认的队列;
+ *      --PairingHeapQueue: PairingHeap, O(1)的decrease_key, 适合decrease_key很多的稠密图;
+ *      --RadixHeapQueue: 单调的RadixHeap, 距离必须是无符号整数, 均摊O(lg C)的pop, 道路网上通常最快.
+ * 每个顶点最多有一个句柄, 更短的路径通过decrease_key更新, 所以队列中最多有V个元素.
+ * 例如:
+ *      ShortestPaths<std::uint64_t> paths = dijkstra(graph, s);
+ *      ShortestPaths<std::uint64_t> paths = dijkstra<RadixHeapQueue>(graph, s);
+ * 从多个起点求解时可以把同一个队列与结果传给dijkstra(graph, s, queue, paths), 重复使用它们的存储.
+ *
+ * 算法性能: 二叉堆为O((V + E)lgV), 配对堆的decrease_key为均摊O(1)(pop为均摊O(lgV)), 基数堆为O(E + VlgC).
+ *
+ */
+
+// GraphDistance: 权重为Weight时距离的类型, 整数权重的距离为64位(避免长路径上的溢出)
+template<typename Weight, bool = std::is_integral<Weight>::value>
+struct GraphDistance
+{
+    typedef Weight type;
+};
+template<typename Weight>
+struct GraphDistance<Weight, true>
+{
+    typedef typename std::conditional<std::is_signed<Weight>::value, std::int64_t, std::uint64_t>::type type;
+};
+
+// GraphLabel: 优先队列中的元素, key为距离(Dijkstra)或连接到树的边的权重(Prim)
+template<typename Key>
+struct GraphLabel
+{
+    Key key;
+    GraphVertex vertex;
+};
+template<typename Key>
+struct GraphLabelKey
+{
+    Key& operator()(GraphLabel<Key> &label) const { return label.key; }
+    const Key& operator()(const GraphLabel<Key> &label) const { return label.key; }
+};
+template<typename Key>
+using BinaryHeapQueue = IndexedMinQueue<GraphLabel<Key>, Key, GraphLabelKey<Key>>;
+template<typename Key>
+using PairingHeapQueue = PairingHeap<GraphLabel<Key>, Key, GraphLabelKey<Key>>;
+template<typename Key>
+using RadixHeapQueue = RadixHeap<GraphLabel<Key>, Key, GraphLabelKey<Key>>;
+
+// graphCheckWeight: 负的边权
+template<typename Weight>
+inline void graphCheckWeight(const Weight &w, const char *what)
+{
+    if (std::is_signed<Weight>::value && w < Weight())
+        throw std::invalid_argument(what);
+}
+
+// ShortestPaths: 最短路径树
+template<typename Distance>
+struct ShortestPaths
+{
+    static Distance unreached() { return std::numeric_limits<Distance>::max(); }
+    std::vector<Distance> distance;     // 到起点的最短距离, 不可到达时为unreached()
+    std::vector<GraphVertex> parent;    // 最短路径树中的前驱, 起点与不可到达的顶点为graph_npos
+    // path: 从起点到v的最短路径上的顶点(包括两端), 不可到达时为空
+    std::vector<GraphVertex> path(GraphVertex v) const
+    {
+        std::vector<GraphVertex> result;
+        if (distance[v] == unreached())
+            return result;
+        for (; v != graph_npos; v = parent[v])
+            result.push_back(v);
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+};
+
+// dijkstra: 用调用者的队列求从source出发的最短路径, 结果写入paths
+template<typename Queue, typename Weight, typename Distance>
+void dijkstra(const CsrGraph<Weight> &graph, GraphVertex source, Queue &queue, ShortestPaths<Distance> &paths)
+{
+    if (source >= graph.vertices())
+        throw std::out_of_range("dijkstra error: the source is not a vertex!");
+    const Distance unreached = ShortestPaths<Distance>::unreached();
+    std::vector<typename Queue::Handle> handle(graph.vertices(), Queue::npos);
+    paths.distance.assign(graph.vertices(), unreached);
+    paths.parent.assign(graph.vertices(), graph_npos);
+    queue.clear();
+    paths.distance[source] = Distance();
+    handle[source] = queue.push(GraphLabel<Distance>{Distance(), source});
+    while (!queue.empty()){
+        GraphLabel<Distance> label = queue.extract_min();
+        GraphVertex u = label.vertex;
+        handle[u] = Queue::npos;
+        for (typename CsrGraph<Weight>::EdgeIndex e = graph.edgeBegin(u); e != graph.edgeEnd(u); ++e){
+            graphCheckWeight(graph.weight(e), "dijkstra error: negative edge weight!");
+            GraphVertex v = graph.target(e);
+            Distance d = label.key + static_cast<Distance>(graph.weight(e));
+            if (!(d < paths.distance[v]))
+                continue;
+            // 距离更短: 第一次到达时加入队列, 否则v一定还在队列中(已经出队的顶点的距离是最终的)
+            if (paths.distance[v] == unreached)
+                handle[v] = queue.push(GraphLabel<Distance>{d, v});
+            else
+                queue.decrease_key(handle[v], d);
+            paths.distance[v] = d;
+            paths.parent[v] = u;
+        }
+    }
+}
+
+// dijkstra: 用QueueTemplate<距离>作为优先队列求从source出发的最短路径
+template<template<typename> class QueueTemplate = BinaryHeapQueue, typename Weight>
+ShortestPaths<typename GraphDistance<Weight>::type> dijkstra(const CsrGraph<Weight> &graph, GraphVertex source)
+{
+    typedef typename GraphDistance<Weight>::type Distance;
+    QueueTemplate<Distance> queue;
+    queue.reserve(graph.vertices());
+    ShortestPaths<Distance> paths;
+    dijkstra(graph, source, queue, paths);
+    return paths;
+}
+#endif
@@ -0,0 +1,108 @@
+/*************************************************************************
+	> File Name: dijkstra_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时27分32秒
+ ************************************************************************/
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "dijkstra.h"
+using std::cout;
+using std::endl;
+
+typedef GraphEdge<std::uint32_t> Edge;
+
+// clrsTest: 算法导论图24-6, 顶点s, t, x, y, z编号为0..4
+void clrsTest()
+{
+    std::vector<Edge> edges = {{0, 1, 10}, {0, 3, 5}, {1, 2, 1}, {1, 3, 2}, {2, 4, 4},
+                               {3, 1, 3}, {3, 2, 9}, {3, 4, 2}, {4, 0, 7}, {4, 2, 6}};
+    CsrGraph<> graph(5, edges.begin(), edges.end());
+    std::vector<std::uint64_t> distance = {0, 8, 9, 5, 7};
+    std::vector<GraphVertex> parent = {graph_npos, 3, 1, 0, 3};
+    ShortestPaths<std::uint64_t> binary = dijkstra(graph, 0);
+    ShortestPaths<std::uint64_t> pairing = dijkstra<PairingHeapQueue>(graph, 0);
+    ShortestPaths<std::uint64_t> radix = dijkstra<RadixHeapQueue>(graph, 0);
+    bool correct = binary.distance == distance && binary.parent == parent && pairing.distance == distance
+                   && pairing.parent == parent && radix.distance == distance && radix.parent == parent
+                   && binary.path(2) == std::vector<GraphVertex>({0, 3, 1, 2});
+    cout << "图24-6(三种队列): " << (correct ? "正确" : "错误") << endl;
+}
+
+// bellmanFord: 用来对照的O(VE)算法
+std::vector<std::int64_t> bellmanFord(std::size_t n, const std::vector<GraphEdge<int>> &edges, GraphVertex source)
+{
+    const std::int64_t unreached = ShortestPaths<std::int64_t>::unreached();
+    std::vector<std::int64_t> distance(n, unreached);
+    distance[source] = 0;
+    for (bool changed = true; changed;){
+        changed = false;
+        for (const auto &e : edges)
+            if (distance[e.from] != unreached && distance[e.from] + e.weight < distance[e.to]){
+                distance[e.to] = distance[e.from] + e.weight;
+                changed = true;
+            }
+    }
+    return distance;
+}
+
+// randomTest: 随机的稀疏图, 三种队列得到的距离与Bellman-Ford相同, parent构成最短路径树
+void randomTest()
+{
+    std::mt19937 gen(5);
+    const std::size_t n = 3000;
+    std::vector<GraphEdge<int>> edges(12000);
+    for (auto &e : edges)
+        e = GraphEdge<int>{static_cast<GraphVertex>(gen() % n), static_cast<GraphVertex>(gen() % n), static_cast<int>(gen() % 1000)};
+    CsrGraph<int> graph(n, edges.begin(), edges.end());
+    std::vector<GraphEdge<std::uint32_t>> unsigned_edges;
+    for (const auto &e : edges)
+        unsigned_edges.push_back(GraphEdge<std::uint32_t>{e.from, e.to, static_cast<std::uint32_t>(e.weight)});
+    CsrGraph<> unsigned_graph(n, unsigned_edges.begin(), unsigned_edges.end());
+    bool correct = true;
+    BinaryHeapQueue<std::int64_t> queue;
+    ShortestPaths<std::int64_t> paths;
+    for (GraphVertex source = 0; source != 5; ++source){
+        std::vector<std::int64_t> expect = bellmanFord(n, edges, source);
+        dijkstra(graph, source, queue, paths);    // 重复使用同一个队列
+        ShortestPaths<std::int64_t> pairing = dijkstra<PairingHeapQueue>(graph, source);
+        ShortestPaths<std::uint64_t> radix = dijkstra<RadixHeapQueue>(unsigned_graph, source);
+        correct = correct && paths.distance == expect && pairing.distance == expect;
+        for (std::size_t v = 0; v != n; ++v){
+            correct = correct && (expect[v] == ShortestPaths<std::int64_t>::unreached()
+                                  ? radix.distance[v] == ShortestPaths<std::uint64_t>::unreached()
+                                  : radix.distance[v] == static_cast<std::uint64_t>(expect[v]));
+            if (paths.parent[v] != graph_npos){
+                // 父结点的距离加上某条边等于自己的距离
+                bool found = false;
+                for (auto e = graph.edgeBegin(paths.parent[v]); e != graph.edgeEnd(paths.parent[v]); ++e)
+                    found = found || (graph.target(e) == v && paths.distance[paths.parent[v]] + graph.weight(e) == expect[v]);
+                correct = correct && found;
+            }
+        }
+    }
+    cout << "随机图(对照Bellman-Ford): " << (correct ? "正确" : "错误") << endl;
+
+    std::vector<GraphEdge<int>> negative = {{0, 1, 3}, {1, 2, -1}};
+    CsrGraph<int> bad(3, negative.begin(), negative.end());
+    try{
+        dijkstra(bad, 0);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    try{
+        dijkstra(bad, 3);
+        correct = false;
+    }catch (const std::out_of_range &){  }
+    cout << "负的边权与错误的起点: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************Dijkstra算法的测试********************\n";
+    clrsTest();
+    randomTest();
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*************************************************************************
+	> File Name: prim.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时15分40秒
+ ************************************************************************/
+
+#ifndef _PRIM_H
+#define _PRIM_H
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../shortest_path/dijkstra.h"
+// prim: 最小生成树的Prim算法  算法导论23.2
+/*
+ * graph是无向图: 每条边{u, v}在CSR中存为u->v与v->u两条权重相同的边(见CsrGraph::symmetric).
+ * 与dijkstra相同, 优先队列是模板参数, 元素为GraphLabel, 关键字key[v]是把v连接到树上的最轻的边的权重:
+ *      --BinaryHeapQueue(默认)或PairingHeapQueue;
+ *      --不能使用RadixHeapQueue: 依次取出的关键字不是单调的(后连接的边可以比先连接的轻), RadixHeap会抛出
+ *        std::invalid_argument.
+ * 图不连通时依次从每个还没有加入的顶点出发, 得到最小生成森林(每个连通分量一棵树).
+ * 边权可以为负(最小生成树只比较边权的大小).
+ *
+ * 算法性能: 二叉堆为O(ElgV), 配对堆为O(E + VlgV)(decrease_key为均摊O(1)).
+ *
+ */
+
+// SpanningForest: 最小生成森林
+template<typename Weight>
+struct SpanningForest
+{
+    std::vector<GraphVertex> parent;    // 树中的父结点, 每棵树的根为graph_npos
+    std::vector<Weight> key;            // 连接到父结点的边的权重, 根为Weight()
+    typename GraphDistance<Weight>::type total;    // 所有树边的权重之和
+    std::size_t trees;                  // 树的个数(连通分量的个数)
+};
+
+// prim: 用调用者的队列求最小生成森林, 结果写入forest
+template<typename Queue, typename Weight>
+void prim(const CsrGraph<Weight> &graph, Queue &queue, SpanningForest<Weight> &forest)
+{
+    typedef typename Queue::Handle Handle;
+    const std::size_t n = graph.vertices();
+    // handle[v]: v在队列中的句柄; 还没有到达时为npos, 已经加入树时为done
+    const Handle done = Queue::npos - 1;
+    std::vector<Handle> handle(n, Queue::npos);
+    forest.parent.assign(n, graph_npos);
+    forest.key.assign(n, Weight());
+    forest.total = typename GraphDistance<Weight>::type();
+    forest.trees = 0;
+    queue.clear();
+    for (std::size_t root = 0; root != n; ++root){
+        if (handle[root] != Queue::npos)
+            continue;
+        ++forest.trees;
+        handle[root] = queue.push(GraphLabel<Weight>{Weight(), static_cast<GraphVertex>(root)});
+        while (!queue.empty()){
+            GraphLabel<Weight> label = queue.extract_min();
+            GraphVertex u = label.vertex;
+            handle[u] = done;
+            forest.total += label.key;
+            for (typename CsrGraph<Weight>::EdgeIndex e = graph.edgeBegin(u); e != graph.edgeEnd(u); ++e){
+                GraphVertex v = graph.target(e);
+                const Weight &w = graph.weight(e);
+                if (handle[v] == done)
+                    continue;
+                if (handle[v] == Queue::npos)
+                    handle[v] = queue.push(GraphLabel<Weight>{w, v});
+                else if (w < forest.key[v])
+                    queue.decrease_key(handle[v], w);
+                else
+                    continue;
+                forest.key[v] = w;
+                forest.parent[v] = u;
+            }
+        }
+    }
+}
+
+// prim: 用QueueTemplate<Weight>作为优先队列求最小生成森林
+template<template<typename> class QueueTemplate = BinaryHeapQueue, typename Weight>
+SpanningForest<Weight> prim(const CsrGraph<Weight> &graph)
+{
+    QueueTemplate<Weight> queue;
+    queue.reserve(graph.vertices());
+    SpanningForest<Weight> forest;
+    prim(graph, queue, forest);
+    return forest;
+}
+#endif
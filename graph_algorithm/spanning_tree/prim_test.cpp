@@ -0,0 +1,91 @@
+/*************************************************************************
+	> File Name: prim_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时30分15秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "prim.h"
+using std::cout;
+using std::endl;
+
+// clrsTest: 算法导论图23-4, 顶点a..i编号为0..8, 最小生成树的权重为37(b-c与a-h等权, 树不唯一)
+void clrsTest()
+{
+    std::vector<GraphEdge<int>> edges = {{0, 1, 4}, {0, 7, 8}, {1, 2, 8}, {1, 7, 11}, {2, 3, 7}, {2, 5, 4}, {2, 8, 2},
+                                         {3, 4, 9}, {3, 5, 14}, {4, 5, 10}, {5, 6, 2}, {6, 7, 1}, {6, 8, 6}, {7, 8, 7}};
+    CsrGraph<int> graph = CsrGraph<int>::symmetric(9, edges.begin(), edges.end());
+    SpanningForest<int> binary = prim(graph);
+    SpanningForest<int> pairing = prim<PairingHeapQueue>(graph);
+    bool correct = binary.total == 37 && binary.trees == 1 && pairing.total == 37 && pairing.trees == 1
+                   && binary.parent[0] == graph_npos && binary.parent[1] == 0 && binary.key[8] == 2 && binary.key[4] == 9;
+    int sum = 0;
+    for (int k : pairing.key)
+        sum += k;
+    correct = correct && sum == 37;
+    cout << "图23-4(二叉堆与配对堆): " << (correct ? "正确" : "错误") << endl;
+}
+
+// kruskal: 用来对照的Kruskal算法(并查集)
+std::int64_t kruskal(std::size_t n, std::vector<GraphEdge<int>> edges, std::size_t &trees)
+{
+    std::vector<std::size_t> root(n);
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&](std::size_t v){
+        while (root[v] != v)
+            v = root[v] = root[root[v]];
+        return v;
+    };
+    std::sort(edges.begin(), edges.end(), [](const GraphEdge<int> &a, const GraphEdge<int> &b){ return a.weight < b.weight; });
+    std::int64_t total = 0;
+    trees = n;
+    for (const auto &e : edges){
+        std::size_t a = find(e.from), b = find(e.to);
+        if (a != b){
+            root[a] = b;
+            total += e.weight;
+            --trees;
+        }
+    }
+    return total;
+}
+
+// randomTest: 随机的不连通图(含负的边权与自环), 权重之和与树的个数与Kruskal相同
+void randomTest()
+{
+    std::mt19937 gen(3);
+    bool correct = true;
+    for (int round = 0; round != 5; ++round){
+        const std::size_t n = 2000;
+        std::vector<GraphEdge<int>> edges(3000);
+        for (auto &e : edges)
+            e = GraphEdge<int>{static_cast<GraphVertex>(gen() % n), static_cast<GraphVertex>(gen() % n), static_cast<int>(gen() % 200) - 100};
+        CsrGraph<int> graph = CsrGraph<int>::symmetric(n, edges.begin(), edges.end());
+        std::size_t trees = 0;
+        std::int64_t expect = kruskal(n, edges, trees);
+        SpanningForest<int> binary = prim(graph), pairing = prim<PairingHeapQueue>(graph);
+        correct = correct && binary.total == expect && pairing.total == expect && binary.trees == trees && pairing.trees == trees;
+        // 每条树边都是图中的边
+        for (GraphVertex v = 0; v != n; ++v)
+            if (binary.parent[v] != graph_npos){
+                bool found = false;
+                for (auto e = graph.edgeBegin(v); e != graph.edgeEnd(v); ++e)
+                    found = found || (graph.target(e) == binary.parent[v] && graph.weight(e) == binary.key[v]);
+                correct = correct && found;
+            }
+    }
+    cout << "随机图(对照Kruskal): " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************Prim算法的测试********************\n";
+    clrsTest();
+    randomTest();
+    return 0;
+}
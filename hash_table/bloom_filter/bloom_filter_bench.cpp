@@ -0,0 +1,86 @@
+/*************************************************************************
+	> File Name: bloom_filter_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时27分10秒
+ ************************************************************************/
+// 链接法散列表前加Bloom过滤器对查找的影响, 以CSV格式输出
+/*
+ * 用法: ./Bench [元素个数(默认1000000)] [查找次数(默认2000000)]
+ *      查找的键中90%不存在. 散列表的最大装载因子取1与4(链越长, 未命中的查找越慢), 分别测量
+ *      不加过滤器与加每个键10位的过滤器的情况.
+ *
+ * 输出的每一行: max_load,filter,filter_bytes,mixed_ns,miss_ns,false_positive
+ *      --mixed_ns: 90%未命中的查找序列的平均时间; miss_ns: 全部未命中时的平均时间;
+ *      --false_positive: 过滤器对不存在的键的误判率.
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "bloom_filter.h"
+#include "../chain_hash_table/hash.h"
+#include "../chain_hash_table/chain_hash_table.h"
+
+typedef Hash<std::uint64_t, std::uint64_t> Element;
+typedef HashTable<Element> Table;
+typedef std::chrono::steady_clock Clock;
+
+std::size_t bench_sink = 0;     // 查找命中的次数, 使编译器不能省略查找
+
+inline std::uint64_t keyOf(std::uint64_t i) { return (i + 1) * 0x9E3779B97F4A7C15ull; }
+
+// probeKeys: operations个键, 每10个中有hits个存在([0, n)), 其余不存在([n, 2n))
+std::vector<std::uint64_t> probeKeys(std::size_t n, std::size_t operations, unsigned hits)
+{
+    std::vector<std::uint64_t> keys(operations);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (std::size_t i = 0; i != operations; ++i){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys[i] = keyOf((i % 10 < hits ? 0 : n) + state % n);
+    }
+    return keys;
+}
+
+template<typename Lookup>
+double measure(const std::vector<std::uint64_t> &keys, Lookup lookup)
+{
+    std::size_t found = 0;
+    auto begin = Clock::now();
+    for (auto key : keys)
+        found += lookup(key) != nullptr;
+    bench_sink += found;
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / keys.size();
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    std::vector<std::uint64_t> mixed = probeKeys(n, operations, 1), misses = probeKeys(n, operations, 0);
+    const float loads[] = {1.0f, 4.0f};
+
+    std::cout << "max_load,filter,filter_bytes,mixed_ns,miss_ns,false_positive\n";
+    for (float load : loads){
+        BloomFilteredTable<Table> filtered(n);
+        filtered.table().maxLoadFactor(load);
+        for (std::size_t i = 0; i != n; ++i)
+            filtered.insert(Element(keyOf(i), i));
+        const Table &table = filtered.table();
+        std::size_t positives = 0;
+        for (auto key : misses)
+            positives += filtered.filter().mayContain(key);
+
+        std::cout << load << ",none,0," << measure(mixed, [&table](std::uint64_t k){ return table.find(k); }) << ','
+                  << measure(misses, [&table](std::uint64_t k){ return table.find(k); }) << ",1\n";
+        std::cout << load << ",blocked_bloom," << filtered.filter().bytes() << ','
+                  << measure(mixed, [&filtered](std::uint64_t k){ return filtered.find(k); }) << ','
+                  << measure(misses, [&filtered](std::uint64_t k){ return filtered.find(k); }) << ','
+                  << static_cast<double>(positives) / misses.size() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*************************************************************************
+	> File Name: bloom_filter_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时29分53秒
+ ************************************************************************/
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bloom_filter.h"
+#include "../chain_hash_table/hash.h"
+#include "../chain_hash_table/chain_hash_table.h"
+typedef Hash<std::string, int> IHash;
+
+// falsePositives: 在没有插入过的键中误判的比例
+template<typename Filter>
+double falsePositives(const Filter &filter, int begin, int end)
+{
+    int count = 0;
+    for (int i = begin; i != end; ++i)
+        count += filter.mayContain(i);
+    return static_cast<double>(count) / (end - begin);
+}
+
+// basic_test: 插入过的键一定能查到, 误判率接近设定值
+void basic_test()
+{
+    BlockedBloomFilter<int> filter(100000, 10);
+    for (int i = 0; i != 100000; ++i)
+        filter.insert(i);
+    bool correct = filter.hashCount() == 7 && filter.insertCount() == 100000;
+    for (int i = 0; i != 100000; ++i)
+        correct = correct && filter.mayContain(i);
+    double rate = falsePositives(filter, 100000, 1100000);
+    std::cout << "没有漏判: " << (correct ? "正确" : "错误") << ", 每个键10位的误判率" << rate
+              << (rate < 0.02 ? " 正确" : " 错误") << std::endl;
+
+    BlockedBloomFilter<int> wide(100000, 16);
+    for (int i = 0; i != 100000; ++i)
+        wide.insert(i);
+    rate = falsePositives(wide, 100000, 1100000);
+    std::cout << "每个键16位的误判率" << rate << (rate < 0.003 ? " 正确" : " 错误") << ", 估计值"
+              << wide.estimatedFalsePositiveRate() << std::endl;
+}
+
+// bulk_test: 批量建立与批量查询的结果与逐个操作相同, 字符串键可以用const char *查询
+void bulk_test()
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i != 5000; ++i)
+        keys.push_back("key" + std::to_string(i));
+    BlockedBloomFilter<std::string> bulk(keys.begin(), keys.end(), 12);
+    BlockedBloomFilter<std::string> single(keys.size(), 12);
+    for (auto &key : keys)
+        single.insert(key);
+    std::vector<std::string> probe;
+    for (int i = 0; i != 10000; ++i)
+        probe.push_back("key" + std::to_string(i));
+    bool maybe[10000];
+    bulk.mayContainMany(probe.data(), probe.size(), maybe);
+    bool correct = bulk.serialize() == single.serialize() && bulk.mayContain("key42");
+    for (int i = 0; i != 10000; ++i)
+        correct = correct && maybe[i] == single.mayContain(probe[i]) && (i >= 5000 || maybe[i]);
+    std::cout << "批量建立与批量查询: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// merge_test: 合并的结果与插入两个集合的并相同, 参数不同时抛出异常
+void merge_test()
+{
+    BlockedBloomFilter<int> a(2000), b(2000), both(2000);
+    for (int i = 0; i != 1000; ++i){
+        a.insert(i);
+        b.insert(i + 1000);
+        both.insert(i);
+        both.insert(i + 1000);
+    }
+    a.merge(b);
+    bool correct = a.serialize() == both.serialize() && a.insertCount() == 2000;
+    try{
+        a.merge(BlockedBloomFilter<int>(200000));
+        correct = false;
+    }catch (const std::invalid_argument &){
+    }
+    std::cout << "合并: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// serialize_test: 序列化, 文件读写, 格式错误
+void serialize_test()
+{
+    BlockedBloomFilter<int> filter(3000);
+    for (int i = 0; i != 3000; i += 3)
+        filter.insert(i);
+    std::vector<unsigned char> data = filter.serialize();
+    BlockedBloomFilter<int> copy = BlockedBloomFilter<int>::deserialize(data.data(), data.size());
+    bool correct = copy.blockCount() == filter.blockCount() && copy.hashCount() == filter.hashCount();
+    for (int i = 0; i != 3000; ++i)
+        correct = correct && copy.mayContain(i) == filter.mayContain(i);
+    // 文件头按小端序: 第一个字节是magic的最低字节
+    correct = correct && data[0] == 'Z' && data[8] == 1;
+    const char *name = "bloom_filter_test.bin";
+    filter.save(name);
+    BlockedBloomFilter<int> loaded = BlockedBloomFilter<int>::load(name);
+    std::remove(name);
+    correct = correct && loaded.serialize() == data;
+    data[0] ^= 1;
+    try{
+        BlockedBloomFilter<int>::deserialize(data.data(), data.size());
+        correct = false;
+    }catch (const std::runtime_error &){
+    }
+    try{
+        BlockedBloomFilter<int>::deserialize(data.data(), 10);
+        correct = false;
+    }catch (const std::runtime_error &){
+    }
+    std::cout << "序列化: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// table_test: 放在链接法散列表之前, 结果与直接查找散列表相同
+void table_test()
+{
+    BloomFilteredTable<HashTable<IHash>> table(1000);
+    for (int i = 0; i != 1000; ++i)
+        table.insert(IHash("key" + std::to_string(i), i));
+    bool correct = table.try_emplace("extra", 7).second && *table.find("extra") == 7;
+    int rejected = 0;
+    for (int i = 0; i != 2000; ++i){
+        const int *value = table.find("key" + std::to_string(i));
+        correct = correct && (i < 1000 ? value != nullptr && *value == i : value == nullptr);
+        rejected += i >= 1000 && !table.filter().mayContain("key" + std::to_string(i));
+    }
+    std::vector<std::string> keys = {"key1", "none", "key999"};
+    std::vector<const int *> values;
+    table.find_many(keys, values);
+    correct = correct && *values[0] == 1 && values[1] == nullptr && *values[2] == 999;
+    // 直接从散列表中删除, 过滤器中留下的键不影响结果
+    table.table().remove(IHash("key1", 1));
+    correct = correct && table.find("key1") == nullptr && rejected > 950;
+    std::cout << "散列表前的过滤器: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********bloom filter的插入与误判率测试********\n";
+    basic_test();
+    std::cout << "********bloom filter的批量操作测试********\n";
+    bulk_test();
+    std::cout << "********bloom filter的merge测试********\n";
+    merge_test();
+    std::cout << "********bloom filter的序列化测试********\n";
+    serialize_test();
+    std::cout << "********bloom filter与散列表测试********\n";
+    table_test();
+
+    return 0;
+}
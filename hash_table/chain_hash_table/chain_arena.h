@@ -0,0 +1,254 @@
+/*************************************************************************
+	> File Name: chain_arena.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时23分53秒
+ ************************************************************************/
+
+#ifndef _CHAIN_ARENA_H
+#define _CHAIN_ARENA_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../hasher/hasher.h"
+
+const unsigned chain_arena_slab_bits = 10;     // 每块2^10个结点
+
+// ChainArena: 散列表自己持有的结点分配器(按块分配, 用32位下标引用结点)
+/*
+ * 结点按块(slab)分配, 块只增加不释放, 下标i的结点在第i >> chain_arena_slab_bits块中, 地址在块扩充时不变.
+ * 释放的结点放入空闲链表(链接保存在结点自己的存储空间中), 之后的分配优先重用它们.
+ * reset()让所有结点变为未分配, 只修改三个成员, 为O(1); 它不调用结点的析构函数.
+ *
+ * 与std::list的每个结点单独调用全局的operator new相比: 没有每次分配的簿记开销与分配器的锁,
+ * 同一个块中的结点在内存中连续; 32位下标比指针少4字节.
+ *
+ */
+template<typename T>
+class ChainArena
+{
+public:
+    typedef std::uint32_t Index;
+    static const Index none = 0xFFFFFFFFu;     // 空下标
+
+    ChainArena() : freeList(none), used(0) {  }
+    ChainArena(const ChainArena &) = delete;
+    ChainArena& operator=(const ChainArena &) = delete;
+
+    // allocate: 分配一个未构造的结点
+    Index allocate()
+    {
+        if (freeList != none){
+            Index i = freeList;
+            freeList = *reinterpret_cast<Index *>(raw(i));
+            return i;
+        }
+        if ((used >> chain_arena_slab_bits) == slabs.size())
+            slabs.emplace_back(new Storage[std::size_t(1) << chain_arena_slab_bits]);
+        return used++;
+    }
+    // deallocate: 释放一个结点(它已经析构)
+    void deallocate(Index i)
+    {
+        *reinterpret_cast<Index *>(raw(i)) = freeList;
+        freeList = i;
+    }
+    // reset: 所有结点变为未分配, 保留已经分配的块
+    void reset()
+    {
+        freeList = none;
+        used = 0;
+    }
+
+    T* at(Index i) { return static_cast<T *>(raw(i)); }
+    const T* at(Index i) const { return static_cast<const T *>(const_cast<ChainArena *>(this)->raw(i)); }
+    // bytes: 所有块占用的字节数
+    std::size_t bytes() const { return slabs.size() * (std::size_t(1) << chain_arena_slab_bits) * sizeof(Storage); }
+private:
+    static_assert(sizeof(T) >= sizeof(Index), "ChainArena: 结点至少要能存放一个下标");
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+    std::vector<std::unique_ptr<Storage[]>> slabs;
+    Index freeList;     // 空闲链表的第一个结点
+    Index used;         // [0, used)中的结点已经分配过(可能在空闲链表中)
+
+    void* raw(Index i)
+    {
+        return &slabs[i >> chain_arena_slab_bits][i & ((Index(1) << chain_arena_slab_bits) - 1)];
+    }
+};
+template<typename T>
+const typename ChainArena<T>::Index ChainArena<T>::none;
+
+// ArenaChains: 侵入式单链表的桶(每个链表的第一个元素直接放在桶数组中, 其余结点来自ChainArena)
+/*
+ * 桶 = 第一个元素 + 下一个结点的下标 + 纪元号; 结点 = 元素 + 下一个结点的下标.
+ *      --桶的纪元号等于Pool中的当前纪元号时桶中才有元素. 清空散列表时只要把当前纪元号加1, 并reset分配器,
+ *        所有桶同时变空, 不需要访问桶数组; 元素的析构函数不是平凡的(例如std::string)时仍然要逐个析构;
+ *      --有第二个元素时第一个元素一定在桶中, 删除第一个元素时把下一个结点的元素移进桶中;
+ *      --新元素插在桶中元素之后(链表的第二个位置), O(1)而且不需要尾指针, 所以同一个链表中的次序与插入次序不一定相同.
+ *
+ * 插入, 删除与再散列都可能在桶与结点之间移动元素, 元素的地址只在下一次修改散列表之前有效.
+ *
+ */
+template<typename Entry>
+struct ArenaChains
+{
+    typedef std::uint32_t Index;
+    struct Node
+    {
+        typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type entry;
+        Index next;
+        Entry* get() { return reinterpret_cast<Entry *>(&entry); }
+        const Entry* get() const { return reinterpret_cast<const Entry *>(&entry); }
+    };
+    struct Bucket
+    {
+        Bucket() : next(ChainArena<Node>::none), generation(0) {  }
+        // 桶数组只在没有元素时构造与移动(见HashTable), 复制得到的总是空桶
+        Bucket(const Bucket &) : next(ChainArena<Node>::none), generation(0) {  }
+        Bucket& operator=(const Bucket &) = delete;
+        typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type head;
+        Index next;
+        std::uint32_t generation;
+        Entry* get() { return reinterpret_cast<Entry *>(&head); }
+        const Entry* get() const { return reinterpret_cast<const Entry *>(&head); }
+    };
+    // makeBucket: 空桶, 桶中没有需要分配的内存, 忽略分配器
+    template<typename A>
+    static Bucket makeBucket(const A &) { return Bucket(); }
+    struct Pool
+    {
+        Pool() : generation(1) {  }
+        ChainArena<Node> nodes;
+        std::uint32_t generation;   // 当前纪元号, 桶的纪元号与它相等时桶中有元素
+    };
+
+    static bool empty(const Bucket &b, const Pool &pool) { return b.generation != pool.generation; }
+    // front: 下一次transfer移走的元素(有结点时为第一个结点, 否则为桶中的元素)
+    static const Entry& front(const Bucket &b, const Pool &pool)
+    {
+        return b.next != ChainArena<Node>::none ? *pool.nodes.at(b.next)->get() : *b.get();
+    }
+    template<typename Pred>
+    static const Entry* find(const Bucket &b, const Pool &pool, Pred pred)
+    {
+        if (empty(b, pool))
+            return nullptr;
+        if (pred(*b.get()))
+            return b.get();
+        for (Index i = b.next; i != ChainArena<Node>::none; ){
+            const Node *node = pool.nodes.at(i);
+            if (pred(*node->get()))
+                return node->get();
+            i = node->next;
+        }
+        return nullptr;
+    }
+    template<typename... Args>
+    static Entry* append(Bucket &b, Pool &pool, Args&&... args)
+    {
+        if (empty(b, pool)){
+            new (b.get()) Entry(std::forward<Args>(args)...);
+            b.next = ChainArena<Node>::none;
+            b.generation = pool.generation;
+            return b.get();
+        }
+        Index i = pool.nodes.allocate();
+        Node *node = pool.nodes.at(i);
+        try{
+            new (node->get()) Entry(std::forward<Args>(args)...);
+        }catch (...){
+            pool.nodes.deallocate(i);
+            throw;
+        }
+        node->next = b.next;
+        b.next = i;
+        return node->get();
+    }
+    static void erase(Bucket &b, Pool &pool, const Entry *e)
+    {
+        if (e == b.get()){
+            if (b.next == ChainArena<Node>::none){
+                b.get()->~Entry();
+                b.generation = 0;
+                return;
+            }
+            Index i = b.next;
+            Node *node = pool.nodes.at(i);
+            *b.get() = std::move(*node->get());
+            b.next = node->next;
+            node->get()->~Entry();
+            pool.nodes.deallocate(i);
+            return;
+        }
+        for (Index *link = &b.next; *link != ChainArena<Node>::none; link = &pool.nodes.at(*link)->next){
+            Node *node = pool.nodes.at(*link);
+            if (node->get() == e){
+                Index i = *link;
+                *link = node->next;
+                node->get()->~Entry();
+                pool.nodes.deallocate(i);
+                return;
+            }
+        }
+    }
+    // transfer: 把front(from)移动到链表to中; 结点移到非空的桶时只修改链接, 不移动元素
+    static void transfer(Bucket &from, Bucket &to, Pool &pool)
+    {
+        if (from.next == ChainArena<Node>::none){
+            append(to, pool, std::move(*from.get()));
+            from.get()->~Entry();
+            from.generation = 0;
+            return;
+        }
+        Index i = from.next;
+        Node *node = pool.nodes.at(i);
+        from.next = node->next;
+        if (empty(to, pool)){
+            append(to, pool, std::move(*node->get()));
+            node->get()->~Entry();
+            pool.nodes.deallocate(i);
+        }else{
+            node->next = to.next;
+            to.next = i;
+        }
+    }
+    // prefetch: 预取链表的第二个元素(第一个元素在桶中)
+    static void prefetch(const Bucket &b, const Pool &pool)
+    {
+        if (!empty(b, pool) && b.next != ChainArena<Node>::none)
+            hashPrefetch(pool.nodes.at(b.next));
+    }
+    // destroy: 析构所有桶中的元素(桶不变)
+    template<typename Buckets>
+    static void destroy(Buckets &buckets, Pool &pool)
+    {
+        if (std::is_trivially_destructible<Entry>::value)
+            return;
+        for (auto &b : buckets){
+            if (empty(b, pool))
+                continue;
+            b.get()->~Entry();
+            for (Index i = b.next; i != ChainArena<Node>::none; i = pool.nodes.at(i)->next)
+                pool.nodes.at(i)->get()->~Entry();
+        }
+    }
+    // clear: 清空所有桶, 元素可以平凡析构时为O(1)
+    template<typename Buckets>
+    static void clear(Buckets &buckets, Pool &pool)
+    {
+        destroy(buckets, pool);
+        pool.nodes.reset();
+        if (++pool.generation == 0){
+            // 纪元号用完一轮: 所有桶的纪元号归零, 避免旧的纪元号与新的相同
+            for (auto &b : buckets)
+                b.generation = 0;
+            pool.generation = 1;
+        }
+    }
+};
+#endif
@@ -11,6 +11,17 @@
 #include <list>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../hasher/hasher.h"
+#include "../hash_stats/hash_stats.h"
+#include "chain_arena.h"
+
+const std::size_t chain_rehash_step = 4;    // 渐进式再散列时每次操作迁移的桶数
 // HashTable: 分离链接法(双向链表结构)处理冲突情况的散列表. 算法导论11.2 11.3
 /*
  * 简而言之,散列就是一种用以常数平均时间执行插入,删除的技术.但是元素间排序将不会
@@ -19,51 +30,226 @@
  * 散列最主要的问题就是确定散列函数,以解决冲突问题.(当两个关键字散列到一个值的时候产生冲突).
  *
  * 解决冲突的方法最简单的有两种: 分离链接法和开放定址法.
+ *
+ * 桶的个数总是2的幂, 元素个数超过 桶数 * maxLoadFactor() 时桶数加倍, 链表的平均长度保持为常数:
+ *      --默认一次完成再散列(均摊为O(1), 但是触发再散列的那次插入为O(N));
+ *      --incremental为true时使用渐进式再散列: 新的桶数组建好以后, 之后的每次插入和删除都只迁移
+ *        chain_rehash_step个旧桶, 任何一次操作的代价都是O(1). 迁移期间旧桶i中的元素只会进入新桶2i与2i+1,
+ *        小于迁移位置的旧桶已经迁移完, 元素在新桶数组中, 否则还在旧桶数组中. 迁移用std::list::splice
+ *        移动结点, 不复制元素(侵入式链表见下).
+ *
+ * Hasher把元素映射为64位散列值(默认只散列键, 见hasher.h); CacheHash为true时每个结点同时保存完整的散列值:
+ * 查找时先比较散列值, 只有散列值相等才调用operator==(键为长字符串时省去大部分字符串比较),
+ * 再散列时直接使用保存的散列值, 不需要重新计算. 代价是每个元素多8字节.
+ *
+ * 按键访问: contains/insert/remove比较整个元素(键与值), find/emplace/try_emplace只比较键.
+ * find的参数可以是与键类型不同但可以比较相等的类型(例如键为std::string时的const char *), 不构造键对象,
+ * 这要求Hasher提供key(k)(见hasher.h的KeyHasher). find_many批量查找, 先计算一批键的散列值并预取它们的桶,
+ * 再逐个比较, 多个键的缓存未命中可以重叠.
+ *
+ * 链表的存储方式(ArenaNodes):
+ *      --false(默认): 每个桶是一个std::list, 每个元素单独分配一个有两个指针的结点, 再散列时元素的地址不变;
+ *      --true: 侵入式单链表(见chain_arena.h的ArenaChains), 每个链表的第一个元素直接放在桶数组中,
+ *        其余结点来自散列表自己的ChainArena, 只有一个32位的next下标; 不调用全局的operator new(没有分配器的锁),
+ *        makeEmpty()只重置分配器并把纪元号加1(元素可以平凡析构时为O(1)). 元素的地址只在下一次修改之前有效.
+ *
+ * Alloc: 桶数组与std::list结点的分配器(例如ResourceAllocator<HashedObj>, 见tree_algorithm/NodeArena/MemoryResource.h),
+ * 所有的链表使用同一个分配器, 所以splice总是合法的. ArenaNodes为true时只有桶数组来自Alloc, 结点仍来自ChainArena.
 */
+// ChainEntry: 链表结点中保存的数据, CacheHash为true时同时保存散列值
+template<typename HashedObj, bool CacheHash>
+struct ChainEntry
+{
+    ChainEntry(const HashedObj &x, std::uint64_t) : value(x) {}
+    ChainEntry(HashedObj &&x, std::uint64_t) : value(std::move(x)) {}
+    template<typename Hasher>
+    std::uint64_t hash(const Hasher &hasher) const { return hasher(value); }
+    bool matches(const HashedObj &x, std::uint64_t) const { return value == x; }
+    template<typename K>
+    bool matchesKey(const K &key, std::uint64_t) const { return value.key == key; }
+    HashedObj value;
+};
 template<typename HashedObj>
+struct ChainEntry<HashedObj, true>
+{
+    ChainEntry(const HashedObj &x, std::uint64_t h) : value(x), hashValue(h) {}
+    ChainEntry(HashedObj &&x, std::uint64_t h) : value(std::move(x)), hashValue(h) {}
+    template<typename Hasher>
+    std::uint64_t hash(const Hasher &) const { return hashValue; }
+    bool matches(const HashedObj &x, std::uint64_t h) const { return hashValue == h && value == x; }
+    template<typename K>
+    bool matchesKey(const K &key, std::uint64_t h) const { return hashValue == h && value.key == key; }
+    HashedObj value;
+    std::uint64_t hashValue;
+};
+
+// ListChains: 每个桶是一个std::list(ArenaNodes为false时使用), 接口与ArenaChains相同
+template<typename Entry, typename Alloc = std::allocator<Entry>>
+struct ListChains
+{
+    typedef std::list<Entry, Alloc> Bucket;
+    struct Pool {  };   // 结点由std::list自己分配
+
+    // makeBucket: 使用分配器a(可以转换为Alloc)的空链表
+    template<typename A>
+    static Bucket makeBucket(const A &a) { return Bucket(Alloc(a)); }
+    static bool empty(const Bucket &b, const Pool &) { return b.empty(); }
+    static const Entry& front(const Bucket &b, const Pool &) { return b.front(); }
+    template<typename Pred>
+    static const Entry* find(const Bucket &b, const Pool &, Pred pred)
+    {
+        auto iter = std::find_if(b.begin(), b.end(), pred);
+        return iter == b.end() ? nullptr : &*iter;
+    }
+    template<typename... Args>
+    static Entry* append(Bucket &b, Pool &, Args&&... args)
+    {
+        b.emplace_back(std::forward<Args>(args)...);
+        return &b.back();
+    }
+    static void erase(Bucket &b, Pool &, const Entry *e)
+    {
+        for (auto iter = b.begin(); iter != b.end(); ++iter)
+            if (&*iter == e){
+                b.erase(iter);
+                return;
+            }
+    }
+    // transfer: 用splice把第一个结点移到to的最尾端, 不复制元素
+    static void transfer(Bucket &from, Bucket &to, Pool &) { to.splice(to.end(), from, from.begin()); }
+    static void prefetch(const Bucket &b, const Pool &)
+    {
+        if (!b.empty())
+            hashPrefetch(&b.front());
+    }
+    template<typename Buckets>
+    static void destroy(Buckets &, Pool &) {  }
+    template<typename Buckets>
+    static void clear(Buckets &buckets, Pool &)
+    {
+        for (auto &b : buckets)
+            b.clear();
+    }
+};
+
+template<typename HashedObj, typename Hasher = KeyHasher<HashedObj>, bool CacheHash = false, bool ArenaNodes = false,
+         typename Alloc = std::allocator<HashedObj>>
 class HashTable
 {
 public:
-    //typedef typename HashedObj::ValueType valueType;  
+    typedef typename HashedObj::KeyType KeyType;
+    typedef typename HashedObj::ValueType ValueType;
     //***************************构造函数*********************************
-    explicit HashTable(std::size_t size = 101): currentSize(0) {theLists.resize(size);}
-    ~HashTable()=default;
+    // size: 初始的桶数(向上取为2的幂); incremental: 是否使用渐进式再散列
+    // alloc: 桶数组与链表结点的分配器
+    explicit HashTable(std::size_t size = 101, bool incremental = false, const Hasher &h = Hasher(),
+                       const Alloc &alloc = Alloc())
+        : hasher(h), theLists(std::size_t(1) << bitsFor(size), Chains::makeBucket(alloc), BucketAlloc(alloc)),
+          newLists(BucketAlloc(alloc)), currentSize(0), bits(bitsFor(size)), maxLoad(1.0f),
+          incrementalRehash(incremental), migrated(0) {}
+    HashTable(const HashTable &) = default;
+    HashTable& operator=(const HashTable &) = default;
+    ~HashTable()
+    {
+        Chains::destroy(theLists, pool);
+        Chains::destroy(newLists, pool);
+    }
     //***************************成员函数*********************************
     bool contains(const HashedObj &x) const; // 向散列表中查询一个元素
     void makeEmpty(); 	// 清空散列表
     bool insert(const HashedObj &x); 	// 向散列表中插入一个元素
     bool remove(const HashedObj &x); 	// 向散列表中删除一个元素
+    void reserve(std::size_t n);        // 预留足够的桶, 使插入n个元素时不需要再散列
+    void rehash(std::size_t buckets);   // 立即把桶数改为不小于buckets的2的幂(不少于容纳现有元素所需的桶数)
+    // find: 键等于key的元素(有多个时为最早插入的一个)的值, 不存在时为nullptr
+    template<typename K>
+    ValueType* find(const K &key);
+    template<typename K>
+    const ValueType* find(const K &key) const;
+    // find_many: 批量查找, out[i] = find(keys[i])
+    template<typename K>
+    void find_many(const K *keys, std::size_t n, const ValueType **out) const;
+    template<typename K>
+    void find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const;
+    // emplace: 用args构造元素, 没有键相同的元素时插入; 返回键相同的元素的值与是否插入
+    template<typename... Args>
+    std::pair<ValueType*, bool> emplace(Args&&... args);
+    // try_emplace: 没有键为key的元素时插入(key, ValueType(args...)), 已经存在时不构造任何对象
+    template<typename K, typename... Args>
+    std::pair<ValueType*, bool> try_emplace(K &&key, Args&&... args);
+
+    std::size_t size() const { return currentSize; }
+    bool empty() const { return currentSize == 0; }
+    Alloc get_allocator() const { return Alloc(theLists.get_allocator()); }
+    // bucketCount: 桶数(渐进式再散列进行中时为新桶数组的桶数)
+    std::size_t bucketCount() const { return rehashing() ? 2 * theLists.size() : theLists.size(); }
+    float loadFactor() const { return static_cast<float>(currentSize) / bucketCount(); }
+    float maxLoadFactor() const { return maxLoad; }
+    void maxLoadFactor(float load);
+    // rehashing: 渐进式再散列是否正在进行
+    bool rehashing() const { return newLists.capacity() != 0; }
+    // stats: 统计信息(见hash_stats.h), 探查长度为比较过的元素个数
+    HashTableStats stats() const;
+    void resetStats() { counters.resetCounters(); }
 private:
     //***************************数据结构*********************************
-    std::vector<std::list<HashedObj>> theLists;     // 链表的数组
-    std::size_t currentSize;        // 哈希数组大小
+    typedef ChainEntry<HashedObj, CacheHash> Entry;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Entry> EntryAlloc;
+    typedef typename std::conditional<ArenaNodes, ArenaChains<Entry>, ListChains<Entry, EntryAlloc>>::type Chains;
+    typedef typename Chains::Bucket List;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<List> BucketAlloc;
+    typedef std::vector<List, BucketAlloc> Buckets;
+    Hasher hasher;
+    typename Chains::Pool pool;     // ArenaNodes为true时所有链表结点的分配器
+    Buckets theLists;               // 链表的数组
+    Buckets newLists;               // 渐进式再散列时的新桶数组(随迁移逐步构造), 不在再散列时容量为0
+    std::size_t currentSize;        // 散列表中元素的个数
+    unsigned bits;                  // theLists的桶数为2^bits
+    float maxLoad;                  // 最大装载因子
+    bool incrementalRehash;
+    std::size_t migrated;           // 渐进式再散列时theLists[0, migrated)已经迁移到newLists
+    HashStatsCounters counters;     // 运行时计数(定义HASH_TABLE_STATS时)
     //***************************私有成员函数*****************************
-    void rehash();
-    std::size_t myhash(const HashedObj &x) const;
+    static std::size_t myhash(std::uint64_t hashIndex, unsigned tableBits);
+    static unsigned bitsFor(std::size_t buckets);
+    List& bucketOf(std::uint64_t hashIndex);
+    const List& bucketOf(std::uint64_t hashIndex) const;
+    const Entry* findIn(const List &whichList, const HashedObj &x, std::uint64_t hashIndex) const;
+    template<typename K>
+    const Entry* findKeyIn(const List &whichList, const K &key, std::uint64_t hashIndex) const;
+    std::pair<ValueType*, bool> append(HashedObj &&x, std::uint64_t hashIndex);
+    void grow(std::size_t n);
+    void migrate(std::size_t buckets);
+    void moveBucket(List &from, Buckets &to, unsigned toBits);
+    // newBucket: 与theLists使用同一个分配器的空链表
+    List newBucket() const { return Chains::makeBucket(theLists.get_allocator()); }
 };
 //***************************私有成员函数*********************************
-// rehash: 重新建立hash表.
-template<typename HashedObj>
-void HashTable<HashedObj>::rehash()
+// bitsFor: 不小于buckets的最小的2的幂的指数(至少为1)
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+unsigned HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::bitsFor(std::size_t buckets)
 {
-    theLists.resize(0);
-    currentSize = 0;
+    unsigned result = 1;
+    while (result < 63 && (std::size_t(1) << result) < buckets)
+        ++result;
+    return result;
 }
-// myhash: 将HashedObj的值转换为数组的下标
+// myhash: 将元素的散列值转换为2^tableBits个桶中的下标
 /*
- * \parameter x: 待转换的元素;
+ * \parameter hashIndex: 待转换的元素的散列值(Hasher的结果);
+ * \parameter tableBits: 桶数的指数;
  * \return 数组下标.
 */
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::myhash(const HashedObj &x) const
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::myhash(std::uint64_t hashIndex, unsigned tableBits)
 {
-    std::size_t hashIndex = x.getIndex();
     // 除法散列法
     /*
      * 关于除法散列函数: 选取m(theLists.size())的值特别重要,一个不太接近2的整数幂的素数,常常是
      * m的一个较好的选择.
+     * 但是每次计算都需要一次整数除法(几十个时钟周期), 桶数也不能简单地加倍, 这里不使用.
     */
-    
+
     //hashIndex = hashIndex % theLists.size();
 
     // 乘法散列法
@@ -72,11 +258,13 @@ std::size_t HashTable<HashedObj>::myhash(const HashedObj &x) const
      *      --第一步,用关键字k乘上常数A(0<A<1),提取kA的小数部分;
      *      --第二步,用m乘以这个值再向下取整.
      * 乘法散列法的一个优点是对m的选择不是特别关键,一般选择它为2的某个幂次方;A的取值为(sqrt(5)-1)/2是一个理想的值.
+     *
+     * 用定点数实现(算法导论11.3.2): s = A * 2^64, k * s的低64位就是kA的小数部分乘以2^64,
+     * m = 2^p时取它的高p位即可, 只需要一次整数乘法和一次移位. 桶数加倍时多取一位, 旧桶i的元素只会进入新桶2i和2i+1.
     */
-    double indexValue = (hashIndex * (std::sqrt(5)-1) / 2);
-    indexValue = indexValue - static_cast<int>(indexValue);
-    hashIndex = std::floor(101 * indexValue);
-    
+    const std::uint64_t s = 11400714819323198485ull;     // floor(2^64 * (sqrt(5)-1)/2)
+    hashIndex = (hashIndex * s) >> (64 - tableBits);
+
     // 全域散列法
     /*
      * 任何一个特定的散列函数都会出现将n个关键字全部散列到同一个槽中,使得品均的检索时间为O(N),这个就是令人恐怖的最坏的情况.
@@ -86,30 +274,189 @@ std::size_t HashTable<HashedObj>::myhash(const HashedObj &x) const
      * 全域散列法在执行的开始,就从一组精心设计的函数中,随机选择一个作为散列函数.就像在快速排序中一样,随机化保证了没有哪一种
      * 输入会始终导致最坏的情况性能.
     */
-    return hashIndex;
+    return static_cast<std::size_t>(hashIndex);
+}
+// bucketOf: x所在的链表(渐进式再散列时, 已经迁移的旧桶的元素在新桶数组中)
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+const typename HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::List&
+HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::bucketOf(std::uint64_t hashIndex) const
+{
+    std::size_t index = myhash(hashIndex, bits);
+    if (rehashing() && index < migrated)
+        return newLists[myhash(hashIndex, bits + 1)];
+    return theLists[index];
+}
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+typename HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::List&
+HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::bucketOf(std::uint64_t hashIndex)
+{
+    return const_cast<List&>(static_cast<const HashTable&>(*this).bucketOf(hashIndex));
+}
+// findIn: 在链表中查找x(保存了散列值时先比较散列值)
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+const typename HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::Entry*
+HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::findIn(const List &whichList, const HashedObj &x, std::uint64_t hashIndex) const
+{
+    std::size_t probes = 0;
+    const Entry *result = Chains::find(whichList, pool, [&](const Entry &entry){ ++probes; return entry.matches(x, hashIndex); });
+    counters.recordLookup(result != nullptr, probes);
+    return result;
+}
+// findKeyIn: 在链表中查找键等于key的元素
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K>
+const typename HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::Entry*
+HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::findKeyIn(const List &whichList, const K &key, std::uint64_t hashIndex) const
+{
+    std::size_t probes = 0;
+    const Entry *result = Chains::find(whichList, pool, [&](const Entry &entry){ ++probes; return entry.matchesKey(key, hashIndex); });
+    counters.recordLookup(result != nullptr, probes);
+    return result;
+}
+// append: 插入散列值为hashIndex的新元素x(散列表中没有与它相同的元素)
+/*
+ * 先按插入以后的元素个数增加桶数, 再放入x所在的链表, 所以返回的地址不会被这次插入引起的再散列移动.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+std::pair<typename HashedObj::ValueType*, bool>
+HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::append(HashedObj &&x, std::uint64_t hashIndex)
+{
+    grow(currentSize + 1);
+    Entry *entry = Chains::append(bucketOf(hashIndex), pool, std::move(x), hashIndex);
+    ++currentSize;
+    return std::make_pair(&entry->value.value, true);
+}
+// moveBucket: 把链表from中的结点移动到桶数组to中
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::moveBucket(List &from, Buckets &to, unsigned toBits)
+{
+    while (!Chains::empty(from, pool)){
+        auto &target = to[myhash(Chains::front(from, pool).hash(hasher), toBits)];
+        Chains::transfer(from, target, pool);
+    }
+}
+// migrate: 渐进式再散列时迁移最多buckets个旧桶, 全部迁移完以后新桶数组取代旧桶数组
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::migrate(std::size_t buckets)
+{
+    HashStatsCounters::RehashTimer timer(counters);
+    // 新桶数组只预留了空间, 迁移旧桶i之前才构造新桶2i与2i+1, 开始迁移时不需要O(N)的初始化
+    for (; buckets != 0 && migrated != theLists.size(); --buckets, ++migrated){
+        newLists.push_back(newBucket());
+        newLists.push_back(newBucket());
+        moveBucket(theLists[migrated], newLists, bits + 1);
+    }
+    if (migrated == theLists.size()){
+        theLists.swap(newLists);
+        Buckets(theLists.get_allocator()).swap(newLists);
+        ++bits;
+        migrated = 0;
+    }
+}
+// grow: 元素个数为n时超过装载因子的上限则桶数加倍
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::grow(std::size_t n)
+{
+    if (n <= maxLoad * bucketCount() || bits >= 62)
+        return;
+    if (!incrementalRehash){
+        rehash(theLists.size() * 2);
+        return;
+    }
+    // 上一次迁移还没有完成(装载因子很小时才可能发生)时先完成它
+    if (rehashing())
+        migrate(theLists.size());
+    counters.recordRehash();
+    newLists.reserve(theLists.size() * 2);
+    migrated = 0;
 }
 //***************************成员函数*************************************
+// rehash: 重新建立hash表.
+/*
+ * \parameter buckets: 新的桶数, 向上取为2的幂, 且不少于 size() / maxLoadFactor();
+ * \return void.
+ * 所有结点用splice移动到新的桶数组, 不复制元素(侵入式链表只移动桶中的第一个元素); 进行中的渐进式再散列会先完成.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::rehash(std::size_t buckets)
+{
+    if (rehashing())
+        migrate(theLists.size());
+    std::size_t needed = static_cast<std::size_t>(std::ceil(currentSize / maxLoad));
+    unsigned newBits = bitsFor(std::max(buckets, needed));
+    if (newBits == bits)
+        return;
+    counters.recordRehash();
+    HashStatsCounters::RehashTimer timer(counters);
+    Buckets lists(std::size_t(1) << newBits, newBucket(), theLists.get_allocator());
+    for (auto &thisList : theLists)
+        moveBucket(thisList, lists, newBits);
+    theLists.swap(lists);
+    bits = newBits;
+}
+// reserve: 预留可以容纳n个元素而不超过最大装载因子的桶数.
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::reserve(std::size_t n)
+{
+    std::size_t needed = static_cast<std::size_t>(std::ceil(n / maxLoad));
+    if (needed > bucketCount())
+        rehash(needed);
+}
+// maxLoadFactor: 设置最大装载因子, 必要时立即增加桶数.
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::maxLoadFactor(float load)
+{
+    if (!(load > 0))
+        throw std::invalid_argument("maxLoadFactor error: 装载因子必须为正数");
+    maxLoad = load;
+    reserve(currentSize);
+}
 // contains: 检查成员是否被包含在hash table中.
 /*
  * \parameter x: 待检查的元素;
  * \return 返回这个元素是否存在于hash table中.
+ * 查询不修改散列表, 所以不推进渐进式再散列.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::contains(const HashedObj &x) const
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::contains(const HashedObj &x) const
+{
+    std::uint64_t hashIndex = hasher(x);
+    return findIn(bucketOf(hashIndex), x, hashIndex) != nullptr;
+}
+// stats: 统计信息.
+/*
+ * \return 结构统计(遍历所有链表, 查找第i个元素要比较i次)与运行时计数.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+HashTableStats HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::stats() const
 {
-    auto &whichList = theLists[myhash(x)];
-    return std::find(whichList.begin(), whichList.end(), x) != whichList.end();
+    HashTableStats result;
+    result.size = currentSize;
+    result.capacity = bucketCount();
+    auto scan = [&](const Buckets &lists){
+        for (auto &thisList : lists){
+            std::size_t length = 0;
+            Chains::find(thisList, pool, [&](const Entry &){ result.stored.add(++length); return false; });
+            result.longestChain = std::max(result.longestChain, length);
+        }
+    };
+    scan(theLists);
+    scan(newLists);
+    counters.exportTo(result);
+    return result;
 }
 // makeEmpty: 把hash table置空.
 /*
  * \return void.
- * 将hash table置空以后.
+ * 将hash table置空以后, 桶数不变.
 */
-template<typename HashedObj>
-void HashTable<HashedObj>::makeEmpty()
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::makeEmpty()
 {
-    for (auto &thisList : theLists)
-        thisList.clear();
+    if (rehashing())
+        migrate(theLists.size());
+    Chains::clear(theLists, pool);
+    currentSize = 0;
 }
 // insert: 将一个元素插入到hash table 中
 /*
@@ -118,15 +465,15 @@ void HashTable<HashedObj>::makeEmpty()
  * 当元素在hash table中插入不成功,返回false;
  * 当元素不在hash table中,插入到链表的最尾端,返回true.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::insert(const HashedObj &x)
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::insert(const HashedObj &x)
 {
-    auto &whichList = theLists[myhash(x)];
-    if (std::find(whichList.begin(), whichList.end(), x) != whichList.end() &&
-        whichList.begin() != whichList.end())
+    if (rehashing())
+        migrate(chain_rehash_step);
+    std::uint64_t hashIndex = hasher(x);
+    if (findIn(bucketOf(hashIndex), x, hashIndex) != nullptr)
         return false;
-    whichList.push_back(x);
-    ++currentSize;
+    append(HashedObj(x), hashIndex);
     return true;
 }
 // remove: 将一个元素从hash table中删除.
@@ -136,15 +483,111 @@ bool HashTable<HashedObj>::insert(const HashedObj &x)
  * 当元素在hash table中删除成功,返回true;
  * 当元素不在hash table中,删除不成功,返回false.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::remove(const HashedObj &x)
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::remove(const HashedObj &x)
 {
-    auto &whichList = theLists[myhash(x)];
-    auto iter = std::find(whichList.begin(), whichList.end(), x);
-    if (iter == whichList.end())
+    if (rehashing())
+        migrate(chain_rehash_step);
+    std::uint64_t hashIndex = hasher(x);
+    auto &whichList = bucketOf(hashIndex);
+    const Entry *entry = findIn(whichList, x, hashIndex);
+    if (entry == nullptr)
         return false;
-    whichList.erase(iter);
+    Chains::erase(whichList, pool, entry);
     --currentSize;
     return true;
 }
+// find: 按键查找.
+/*
+ * \parameter key: 键, 或者可以与键比较相等且Hasher::key可以散列的其它类型;
+ * \return 键等于key的元素的值, 不存在时为nullptr.
+ * 指针在删除这个元素或者清空散列表之前一直有效(再散列不移动元素).
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K>
+const typename HashedObj::ValueType* HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::find(const K &key) const
+{
+    std::uint64_t hashIndex = hasher.key(key);
+    const Entry *entry = findKeyIn(bucketOf(hashIndex), key, hashIndex);
+    return entry == nullptr ? nullptr : &entry->value.value;
+}
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K>
+typename HashedObj::ValueType* HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::find(const K &key)
+{
+    return const_cast<ValueType*>(static_cast<const HashTable&>(*this).find(key));
+}
+// find_many: 批量查找.
+/*
+ * \parameter keys: n个待查找的键;
+ * \parameter out: 结果, out[i]为键等于keys[i]的元素的值, 不存在时为nullptr.
+ * 算法基本思想: 每批hash_lookup_batch个键, 先计算所有散列值并预取它们的链表头, 再预取每个链表的第一个结点,
+ * 最后逐个在链表中比较. 单个find要依次等待链表头与结点两次缓存未命中, 批量查找时一批键的未命中同时进行.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::find_many(const K *keys, std::size_t n, const ValueType **out) const
+{
+    std::uint64_t hashes[hash_lookup_batch];
+    const List *lists[hash_lookup_batch];
+    for (std::size_t low = 0; low < n; low += hash_lookup_batch){
+        std::size_t count = std::min(hash_lookup_batch, n - low);
+        for (std::size_t i = 0; i != count; ++i){
+            hashes[i] = hasher.key(keys[low + i]);
+            lists[i] = &bucketOf(hashes[i]);
+            hashPrefetch(lists[i]);
+        }
+        for (std::size_t i = 0; i != count; ++i)
+            Chains::prefetch(*lists[i], pool);
+        for (std::size_t i = 0; i != count; ++i){
+            const Entry *entry = findKeyIn(*lists[i], keys[low + i], hashes[i]);
+            out[low + i] = entry == nullptr ? nullptr : &entry->value.value;
+        }
+    }
+}
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const
+{
+    out.resize(keys.size());
+    find_many(keys.data(), keys.size(), out.data());
+}
+// emplace: 原地构造元素并按键插入.
+/*
+ * \parameter args: HashedObj的构造函数的参数;
+ * \return 键相同的元素的值, 与是否插入了新元素.
+ * 与insert不同, 只要已经有键相同的元素(不论值是否相同)就不插入; 构造出的元素移动进链表结点, 不复制.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::emplace(Args&&... args)
+{
+    HashedObj x(std::forward<Args>(args)...);
+    if (rehashing())
+        migrate(chain_rehash_step);
+    std::uint64_t hashIndex = hasher(x);
+    const Entry *entry = findKeyIn(bucketOf(hashIndex), x.key, hashIndex);
+    if (entry != nullptr)
+        return std::make_pair(const_cast<ValueType*>(&entry->value.value), false);
+    return append(std::move(x), hashIndex);
+}
+// try_emplace: 键不存在时插入.
+/*
+ * \parameter key: 键, 或者可以构造键并与键比较相等的其它类型;
+ * \parameter args: ValueType的构造函数的参数;
+ * \return 键相同的元素的值, 与是否插入了新元素.
+ * 先用key查找, 键已经存在时不构造键, 值与元素.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, bool ArenaNodes, typename Alloc>
+template<typename K, typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, CacheHash, ArenaNodes, Alloc>::try_emplace(K &&key, Args&&... args)
+{
+    if (rehashing())
+        migrate(chain_rehash_step);
+    std::uint64_t hashIndex = hasher.key(key);
+    const Entry *entry = findKeyIn(bucketOf(hashIndex), key, hashIndex);
+    if (entry != nullptr)
+        return std::make_pair(const_cast<ValueType*>(&entry->value.value), false);
+    return append(HashedObj(KeyType(std::forward<K>(key)), ValueType(std::forward<Args>(args)...)), hashIndex);
+}
 #endif
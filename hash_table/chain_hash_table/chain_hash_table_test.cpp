@@ -6,8 +6,10 @@
  ************************************************************************/
 #include <iostream>
 #include <string>
+#include <vector>
 #include "hash.h"
 #include "chain_hash_table.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 typedef Hash<std::string, int> IHash;
 typedef HashTable<Hash<std::string, int>> Hashtable;
 
@@ -77,6 +79,169 @@ void remove_test()
     std::cout << "'ss, 987'是否还在hash table中: " 
               << hashTable.contains({"ss",987}) << std::endl;
 }
+// rehash_test: 元素增多时桶数加倍, 装载因子不超过上限
+void rehash_test()
+{
+    Hashtable hashTable;
+    std::cout << "初始桶数(101向上取为2的幂): " << hashTable.bucketCount() << std::endl;
+    bool correct = true;
+    for (int i = 0; i != 10000; ++i){
+        hashTable.insert({"key" + std::to_string(i), i});
+        correct = correct && hashTable.loadFactor() <= hashTable.maxLoadFactor();
+    }
+    for (int i = 0; i != 10000; ++i)
+        correct = correct && hashTable.contains({"key" + std::to_string(i), i});
+    std::cout << "插入10000个元素后的桶数: " << hashTable.bucketCount() << ", 元素个数: " << hashTable.size()
+              << ", 装载因子与查找: " << (correct ? "正确" : "错误") << std::endl;
+
+    Hashtable reserved;
+    reserved.reserve(5000);
+    std::size_t buckets = reserved.bucketCount();
+    for (int i = 0; i != 5000; ++i)
+        reserved.insert({"key" + std::to_string(i), i});
+    std::cout << "reserve(5000)后插入5000个元素不再散列: "
+              << (buckets >= 5000 && reserved.bucketCount() == buckets ? "正确" : "错误") << std::endl;
+
+    reserved.maxLoadFactor(0.25f);
+    std::cout << "装载因子上限改为0.25后的桶数: " << reserved.bucketCount()
+              << (reserved.loadFactor() <= 0.25f && reserved.contains({"key4999", 4999}) ? " 正确" : " 错误") << std::endl;
+}
+
+// incremental_rehash_test: 渐进式再散列期间插入,删除,查找都正确
+void incremental_rehash_test()
+{
+    Hashtable hashTable(8, true);
+    bool correct = true, seen = false;
+    for (int i = 0; i != 20000; ++i){
+        hashTable.insert({"key" + std::to_string(i), i});
+        if (hashTable.rehashing()){
+            seen = true;
+            // 迁移进行中, 最早插入的与刚插入的元素都能找到
+            correct = correct && hashTable.contains({"key1", 1}) && hashTable.contains({"key" + std::to_string(i), i});
+        }
+        // 删除所有3的倍数
+        if (i % 3 == 0)
+            correct = hashTable.remove({"key" + std::to_string(i), i}) && correct;
+    }
+    for (int i = 0; i != 20000; ++i)
+        correct = correct && hashTable.contains({"key" + std::to_string(i), i}) == (i % 3 != 0);
+    std::cout << "渐进式再散列(桶数" << hashTable.bucketCount() << ", 元素" << hashTable.size() << "): "
+              << (correct && seen && hashTable.size() == 13333 ? "正确" : "错误") << std::endl;
+    hashTable.makeEmpty();
+    std::cout << "清空以后: " << (hashTable.empty() && !hashTable.contains({"key1", 1}) ? "正确" : "错误") << std::endl;
+}
+
+// hasher_test: 保存散列值与使用原来的getIndex()时结果相同; 字母相同的字符串(getIndex()相同)都能区分
+void hasher_test()
+{
+    HashTable<IHash, KeyHasher<IHash>, true> cached(8, true);
+    HashTable<IHash, IndexHasher<IHash>> legacy;
+    const char *words[] = {"listen", "silent", "enlist", "tinsel", "inlets"};
+    bool correct = true;
+    for (int i = 0; i != 5; ++i)
+        correct = cached.insert({words[i], i}) && legacy.insert({words[i], i}) && correct;
+    for (int i = 0; i != 20000; ++i)
+        cached.insert({"key" + std::to_string(i), i});
+    for (int i = 0; i != 5; ++i)
+        correct = correct && cached.contains({words[i], i}) && legacy.contains({words[i], i}) && !cached.contains({words[i], i + 1});
+    for (int i = 0; i < 20000; i += 7)
+        correct = correct && cached.remove({"key" + std::to_string(i), i}) && !cached.contains({"key" + std::to_string(i), i});
+    std::cout << "保存散列值与getIndex(): " << (correct && cached.size() == 20005 - 2858 ? "正确" : "错误") << std::endl;
+}
+
+// find_test: 按键查找(const char *直接查找, 不构造std::string), emplace/try_emplace与批量查找
+void find_test()
+{
+    Hashtable hashTable(8, true);
+    bool correct = hashTable.find("cat") == nullptr;
+    auto result = hashTable.try_emplace("cat", 1234);
+    correct = correct && result.second && *result.first == 1234;
+    result = hashTable.try_emplace(std::string("cat"), 1);
+    correct = correct && !result.second && *result.first == 1234;
+    result = hashTable.emplace("dog", 7);
+    correct = correct && result.second && !hashTable.emplace("dog", 8).second;
+    *hashTable.find("dog") = 9;
+    correct = correct && *hashTable.find(std::string("dog")) == 9 && hashTable.contains({"dog", 9});
+    std::vector<std::string> keys;
+    for (int i = 0; i != 5000; ++i){
+        hashTable.try_emplace("key" + std::to_string(i), i);
+        keys.push_back("key" + std::to_string(2 * i));
+    }
+    std::vector<const int *> values;
+    hashTable.find_many(keys, values);
+    for (int i = 0; i != 5000; ++i)
+        correct = correct && values[i] == hashTable.find(keys[i]) && (i < 2500 ? *values[i] == 2 * i : values[i] == nullptr);
+    std::cout << "按键查找与批量查找: " << (correct && hashTable.size() == 5002 ? "正确" : "错误") << std::endl;
+}
+
+// arena_test: 侵入式链表与std::list的结果相同(渐进式再散列期间插入与删除), 清空以后可以继续使用
+template<typename Key>
+bool arena_check(Key (*keyOf)(int))
+{
+    typedef Hash<Key, int> Element;
+    HashTable<Element> lists(8, true);
+    HashTable<Element, KeyHasher<Element>, true, true> arena(8, true);
+    bool correct = true;
+    for (int round = 0; round != 2; ++round){
+        for (int i = 0; i != 20000; ++i){
+            correct = lists.insert({keyOf(i), i}) == arena.insert({keyOf(i), i}) && correct;
+            if (i % 3 == 0)
+                correct = lists.remove({keyOf(i / 2), i / 2}) == arena.remove({keyOf(i / 2), i / 2}) && correct;
+        }
+        correct = correct && lists.size() == arena.size();
+        for (int i = 0; i != 20000; ++i){
+            const int *p = arena.find(keyOf(i));
+            correct = correct && lists.contains({keyOf(i), i}) == (p != nullptr) && (p == nullptr || *p == i);
+        }
+        lists.makeEmpty();
+        arena.makeEmpty();
+        correct = correct && arena.empty() && !arena.contains({keyOf(1), 1}) && arena.find(keyOf(2)) == nullptr;
+    }
+    return correct;
+}
+std::string stringKey(int i) { return "key" + std::to_string(i); }
+int intKey(int i) { return i; }
+void arena_test()
+{
+    std::cout << "侵入式链表(std::string键): " << (arena_check<std::string>(stringKey) ? "正确" : "错误") << std::endl;
+    std::cout << "侵入式链表(int键, O(1)清空): " << (arena_check<int>(intKey) ? "正确" : "错误") << std::endl;
+}
+
+// stats_test: 结构统计(没有定义HASH_TABLE_STATS, 运行时计数关闭)
+void stats_test()
+{
+    Hashtable hashTable(64);
+    for (int i = 0; i != 100; ++i)
+        hashTable.insert({"key" + std::to_string(i), i});
+    HashTableStats stats = hashTable.stats();
+    bool correct = stats.size == 100 && stats.capacity == hashTable.bucketCount() && stats.stored.total == 100;
+    correct = correct && stats.longestChain == stats.stored.max && stats.longestChain >= 1 && !stats.counting;
+    correct = correct && stats.hits.total == 0 && stats.toJson().find("\"size\":100") != std::string::npos;
+    std::cout << "统计信息: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// resource_test: 桶数组与链表结点都从MonotonicBufferResource分配, 渐进式再散列的splice在同一个来源内进行
+void resource_test()
+{
+    typedef HashTable<IHash, KeyHasher<IHash>, false, false, ResourceAllocator<IHash>> ResourceTable;
+    MonotonicBufferResource arena;
+    bool correct = true;
+    {
+        ResourceTable hashTable(8, true, KeyHasher<IHash>(), &arena);
+        for (int i = 0; i != 5000; ++i)
+            correct = hashTable.insert({"key" + std::to_string(i), i}) && correct;
+        for (int i = 0; i < 5000; i += 2)
+            correct = hashTable.remove({"key" + std::to_string(i), i}) && correct;
+        for (int i = 0; i != 5000; ++i)
+            correct = correct && hashTable.contains({"key" + std::to_string(i), i}) == (i % 2 == 1);
+        correct = correct && hashTable.get_allocator().resource() == &arena && hashTable.size() == 2500;
+    }
+    std::size_t used = arena.bytesAllocated();
+    HashTable<IHash, KeyHasher<IHash>, true, true, ResourceAllocator<IHash>> arenaNodes(8, false, KeyHasher<IHash>(), &arena);
+    correct = correct && arenaNodes.insert({"cat", 1}) && arenaNodes.contains({"cat", 1}) && arena.bytesAllocated() > used;
+    std::cout << "从MemoryResource分配(" << used << "字节): " << (correct && used > 5000 * sizeof(IHash) ? "正确" : "错误") << std::endl;
+}
+
 int main()
 {
     std::cout << "********hash table的insert测试********\n";
@@ -85,6 +250,20 @@ int main()
     contains_test();
     std::cout << "********hash table的remove测试********\n";
     remove_test();
+    std::cout << "********hash table的rehash测试********\n";
+    rehash_test();
+    std::cout << "********hash table的渐进式rehash测试********\n";
+    incremental_rehash_test();
+    std::cout << "********hash table的散列函数测试********\n";
+    hasher_test();
+    std::cout << "********hash table的find测试********\n";
+    find_test();
+    std::cout << "********hash table的侵入式链表测试********\n";
+    arena_test();
+    std::cout << "********hash table的MemoryResource测试********\n";
+    resource_test();
+    std::cout << "********hash table的统计信息测试********\n";
+    stats_test();
 
     return 0;
 }
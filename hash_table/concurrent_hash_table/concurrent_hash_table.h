@@ -0,0 +1,300 @@
+/*************************************************************************
+	> File Name: concurrent_hash_table.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时51分04秒
+ ************************************************************************/
+
+#ifndef _CONCURRENT_HASH_TABLE_H
+#define _CONCURRENT_HASH_TABLE_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../hasher/hasher.h"
+#include "../../parallel_algorithm/epoch_reclamation/epochReclamation.h"
+
+const std::size_t concurrent_default_stripes = 64;      // 默认的锁的个数
+// ConcurrentHashTable: 多线程共享的分离链接法散列表, 写者按锁分段加锁, 读者不加锁
+/*
+ * 数据结构: 桶数组中每个桶是一个单向链表, 结点插入在链表头部; 桶数与锁数都是2的幂, 桶数不少于锁数,
+ * 散列值的低位决定桶, 更低的几位决定锁, 所以同一个桶中的元素总是由同一把锁保护(桶数加倍以后依然如此).
+ *
+ *      --写者(insert, assign, remove): 取得元素对应的锁, 在当前桶数组中修改链表. 结点的键与值在发布以后
+ *        不再修改: 插入时先填好新结点再用release写入链表头, 修改值时用新结点替换旧结点, 删除时把前驱的next
+ *        指向后继. 被替换或删除的结点交给EpochDomain, 没有读者访问以后才释放;
+ *      --读者(contains, find): 进入纪元临界区, 用acquire读取桶数组与链表指针, 不加锁也不写任何共享数据.
+ *        写者只在链表头插入, 删除只会缩短读者剩余的路径, 所以一次查找的步数有上限(wait-free);
+ *      --扩容: 某个锁管理的元素个数乘以锁数(估计的元素总数)超过桶数时, 依次取得所有锁(只阻塞写者),
+ *        把所有结点复制到两倍大小的新桶数组中, 再发布新桶数组. 旧的桶数组与其中的链表在复制期间不被修改,
+ *        正在读旧数组的读者不受影响, 旧数组连同其中的结点整体退休.
+ *
+ * 元素个数由每个锁分别计数, 没有所有写者共享的计数器. size()是各个计数的和, 有并发写入时只是近似值.
+ * find把值复制出来, 散列表不返回指向元素的指针或引用(元素随时可能被其它线程删除).
+ *
+ */
+template<typename Key, typename Value, typename Hasher = DefaultHasher<Key>, typename KeyEqual = std::equal_to<Key>>
+class ConcurrentHashTable
+{
+public:
+    //***************************构造函数*********************************
+    // buckets: 初始的桶数; stripes: 锁的个数(都向上取为2的幂, 桶数不少于锁数)
+    explicit ConcurrentHashTable(std::size_t buckets = 64, std::size_t stripes = concurrent_default_stripes,
+                                 const Hasher &h = Hasher(), const KeyEqual &eq = KeyEqual())
+        : hasher(h), equal(eq), stripe_count(powerOfTwo(stripes)), locks(new Stripe[stripe_count])
+    {
+        table.store(new Table(std::max(powerOfTwo(buckets), stripe_count)));
+    }
+    ConcurrentHashTable(const ConcurrentHashTable &) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable &) = delete;
+    // 析构时不能有其它线程正在使用散列表
+    ~ConcurrentHashTable()
+    {
+        deleteTable(table.load());
+    }
+    //***************************成员函数*********************************
+    bool insert(const Key &key, const Value &value);    // 插入一个元素, 键已经存在时返回false
+    bool assign(const Key &key, const Value &value);    // 插入或者修改一个元素, 插入时返回true
+    bool remove(const Key &key);                        // 删除一个元素
+    bool contains(const Key &key) const;                // 查询一个键是否存在
+    bool find(const Key &key, Value &value) const;      // 查找一个键, 存在时把值复制到value
+
+    std::size_t size() const;
+    bool empty() const { return size() == 0; }
+    std::size_t bucketCount() const
+    {
+        EpochDomain::Guard guard(domain);
+        return table.load(std::memory_order_acquire)->size;
+    }
+    std::size_t stripeCount() const { return stripe_count; }
+    // reclaim: 尝试释放已经没有读者访问的旧结点(通常不需要调用, 写者会定期释放)
+    void reclaim() { domain.collect(); }
+private:
+    //***************************数据结构*********************************
+    struct Node
+    {
+        Node(const Key &k, const Value &v, std::uint64_t h, Node *n) : key(k), value(v), hash(h), next(n) {  }
+        const Key key;
+        const Value value;
+        const std::uint64_t hash;
+        std::atomic<Node *> next;
+    };
+    struct Table
+    {
+        explicit Table(std::size_t n) : size(n), buckets(new std::atomic<Node *>[n])
+        {
+            for (std::size_t i = 0; i != n; ++i)
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+        std::size_t size;
+        std::unique_ptr<std::atomic<Node *>[]> buckets;
+    };
+    // Stripe: 一把锁与它管理的元素个数, 按缓存行对齐以免不同的锁互相干扰
+    struct Stripe
+    {
+        Stripe() : count(0) {  }
+        std::mutex mutex;
+        std::atomic<std::size_t> count;     // 只在持有mutex时修改
+        char padding[64];
+    };
+
+    Hasher hasher;
+    KeyEqual equal;
+    mutable EpochDomain domain;
+    std::size_t stripe_count;
+    std::unique_ptr<Stripe[]> locks;
+    std::atomic<Table *> table;             // 当前的桶数组, 扩容时整体替换
+    //***************************私有成员函数*****************************
+    static std::size_t powerOfTwo(std::size_t n)
+    {
+        std::size_t result = 1;
+        while (result < n)
+            result <<= 1;
+        return result;
+    }
+    static void deleteTable(Table *t)
+    {
+        for (std::size_t i = 0; i != t->size; ++i){
+            for (Node *node = t->buckets[i].load(std::memory_order_relaxed); node != nullptr; ){
+                Node *next = node->next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+        }
+        delete t;
+    }
+    static void deleteTableObject(void *p) { deleteTable(static_cast<Table *>(p)); }
+    Stripe& stripeOf(std::uint64_t h) const { return locks[h & (stripe_count - 1)]; }
+    static std::atomic<Node *>& bucketOf(Table *t, std::uint64_t h) { return t->buckets[h & (t->size - 1)]; }
+    const Node* lookup(const Key &key, std::uint64_t h) const;
+    void grow(std::size_t seen);
+};
+//***************************私有成员函数*********************************
+// lookup: 读者的查找, 调用者必须处于纪元临界区中
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+const typename ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::Node*
+ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::lookup(const Key &key, std::uint64_t h) const
+{
+    Table *t = table.load(std::memory_order_acquire);
+    for (Node *node = bucketOf(t, h).load(std::memory_order_acquire); node != nullptr;
+         node = node->next.load(std::memory_order_acquire)){
+        if (node->hash == h && equal(node->key, key))
+            return node;
+    }
+    return nullptr;
+}
+// grow: 桶数加倍. seen为调用者看到的桶数, 其它线程已经完成扩容时什么也不做
+/*
+ * 按编号依次取得所有锁, 不会与其它扩容的线程死锁; 写者只持有一把锁, 也不会死锁.
+ * 新的结点是旧结点的副本, 旧链表保持不变, 正在遍历旧链表的读者不受影响.
+*/
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+void ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::grow(std::size_t seen)
+{
+    std::vector<std::unique_lock<std::mutex>> held;
+    held.reserve(stripe_count);
+    for (std::size_t i = 0; i != stripe_count; ++i)
+        held.emplace_back(locks[i].mutex);
+    Table *old = table.load(std::memory_order_relaxed);
+    if (old->size != seen)
+        return;
+    Table *bigger = new Table(old->size * 2);
+    for (std::size_t i = 0; i != old->size; ++i){
+        for (Node *node = old->buckets[i].load(std::memory_order_relaxed); node != nullptr;
+             node = node->next.load(std::memory_order_relaxed)){
+            std::atomic<Node *> &bucket = bucketOf(bigger, node->hash);
+            bucket.store(new Node(node->key, node->value, node->hash, bucket.load(std::memory_order_relaxed)),
+                         std::memory_order_relaxed);
+        }
+    }
+    table.store(bigger, std::memory_order_release);
+    domain.retire(old, &deleteTableObject);
+}
+//***************************成员函数*************************************
+// insert: 插入一个元素
+/*
+ * \parameter key, value: 待插入的元素;
+ * \return 键不存在时插入并返回true, 否则返回false(不修改原来的值).
+*/
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::insert(const Key &key, const Value &value)
+{
+    std::uint64_t h = hasher(key);
+    Stripe &stripe = stripeOf(h);
+    std::size_t count, buckets;
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        Table *t = table.load(std::memory_order_relaxed);     // 持有锁时桶数组不会被替换
+        std::atomic<Node *> &bucket = bucketOf(t, h);
+        Node *head = bucket.load(std::memory_order_relaxed);
+        for (Node *node = head; node != nullptr; node = node->next.load(std::memory_order_relaxed))
+            if (node->hash == h && equal(node->key, key))
+                return false;
+        bucket.store(new Node(key, value, h, head), std::memory_order_release);
+        count = stripe.count.load(std::memory_order_relaxed) + 1;
+        stripe.count.store(count, std::memory_order_relaxed);
+        buckets = t->size;
+    }
+    // 释放锁以后t可能已经被其它线程的扩容退休, 只使用持有锁时读到的桶数
+    if (count * stripe_count > buckets)
+        grow(buckets);
+    return true;
+}
+// assign: 插入或者修改一个元素
+/*
+ * \parameter key, value: 待插入的元素;
+ * \return 键不存在时插入并返回true; 键已经存在时把值改为value, 返回false.
+ * 修改时用新结点替换旧结点, 读者看到的要么是旧值要么是新值.
+*/
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::assign(const Key &key, const Value &value)
+{
+    std::uint64_t h = hasher(key);
+    Stripe &stripe = stripeOf(h);
+    std::size_t count, buckets;
+    {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        Table *t = table.load(std::memory_order_relaxed);
+        std::atomic<Node *> *link = &bucketOf(t, h);
+        for (Node *node = link->load(std::memory_order_relaxed); node != nullptr;
+             link = &node->next, node = link->load(std::memory_order_relaxed)){
+            if (node->hash == h && equal(node->key, key)){
+                link->store(new Node(key, value, h, node->next.load(std::memory_order_relaxed)), std::memory_order_release);
+                domain.retire(node);
+                return false;
+            }
+        }
+        std::atomic<Node *> &bucket = bucketOf(t, h);
+        bucket.store(new Node(key, value, h, bucket.load(std::memory_order_relaxed)), std::memory_order_release);
+        count = stripe.count.load(std::memory_order_relaxed) + 1;
+        stripe.count.store(count, std::memory_order_relaxed);
+        buckets = t->size;
+    }
+    // 释放锁以后t可能已经被其它线程的扩容退休, 只使用持有锁时读到的桶数
+    if (count * stripe_count > buckets)
+        grow(buckets);
+    return true;
+}
+// remove: 删除一个元素
+/*
+ * \parameter key: 待删除的键;
+ * \return 是否删除成功.
+*/
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::remove(const Key &key)
+{
+    std::uint64_t h = hasher(key);
+    Stripe &stripe = stripeOf(h);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    std::atomic<Node *> *link = &bucketOf(table.load(std::memory_order_relaxed), h);
+    for (Node *node = link->load(std::memory_order_relaxed); node != nullptr;
+         link = &node->next, node = link->load(std::memory_order_relaxed)){
+        if (node->hash == h && equal(node->key, key)){
+            // 被删除的结点的next保持不变, 停在它上面的读者可以继续向后遍历
+            link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+            stripe.count.store(stripe.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            domain.retire(node);
+            return true;
+        }
+    }
+    return false;
+}
+// contains: 查询一个键是否存在, 不加锁
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::contains(const Key &key) const
+{
+    std::uint64_t h = hasher(key);
+    EpochDomain::Guard guard(domain);
+    return lookup(key, h) != nullptr;
+}
+// find: 查找一个键, 不加锁
+/*
+ * \parameter key: 待查找的键;
+ * \parameter value: 键存在时它的值复制到这里, 否则不修改;
+ * \return 键是否存在.
+*/
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+bool ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::find(const Key &key, Value &value) const
+{
+    std::uint64_t h = hasher(key);
+    EpochDomain::Guard guard(domain);
+    const Node *node = lookup(key, h);
+    if (node == nullptr)
+        return false;
+    value = node->value;
+    return true;
+}
+// size: 元素个数
+template<typename Key, typename Value, typename Hasher, typename KeyEqual>
+std::size_t ConcurrentHashTable<Key, Value, Hasher, KeyEqual>::size() const
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != stripe_count; ++i)
+        count += locks[i].count.load(std::memory_order_relaxed);
+    return count;
+}
+#endif
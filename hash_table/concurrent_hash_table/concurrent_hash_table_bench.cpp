@@ -0,0 +1,144 @@
+/*************************************************************************
+	> File Name: concurrent_hash_table_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时56分30秒
+ ************************************************************************/
+// 并发散列表的吞吐量测试: 不同线程数与读写比例下每秒完成的操作数, 以CSV格式输出
+/*
+ * 用法: ./Bench [最大线程数(默认为硬件线程数的2倍)] [每个线程的操作数(默认1000000)] [键的个数(默认100000)]
+ *      线程数从1开始每次加倍, 直到最大线程数; 读操作的比例为50%, 90%, 99%;
+ *      键从[0, 2 * 键的个数)中均匀随机选取, 开始时插入其中一半, 写操作一半是插入一半是删除, 元素个数大致不变.
+ *
+ * 对比的两种实现:
+ *      --global_mutex: 用一个全局互斥锁保护的链接法散列表(chain_hash_table);
+ *      --concurrent: ConcurrentHashTable, 写者按锁分段加锁, 读者不加锁.
+ *
+ * 输出的每一行: table,threads,read_percent,ops_per_second
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "concurrent_hash_table.h"
+#include "../chain_hash_table/hash.h"
+#include "../chain_hash_table/chain_hash_table.h"
+
+//****************************两种实现*******************************
+// GlobalMutexTable: 一个互斥锁保护整个链接法散列表(每个键的值固定为valueOf(key), 因此可以按(键, 值)查找)
+class GlobalMutexTable
+{
+public:
+    static std::uint64_t valueOf(std::uint64_t key) { return 2 * key + 1; }
+    bool insert(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return table.insert(Element(key, valueOf(key)));
+    }
+    bool remove(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return table.remove(Element(key, valueOf(key)));
+    }
+    bool contains(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return table.contains(Element(key, valueOf(key)));
+    }
+private:
+    typedef Hash<std::uint64_t, std::uint64_t> Element;
+    std::mutex mutex;
+    HashTable<Element> table;
+};
+
+class ConcurrentTable
+{
+public:
+    bool insert(std::uint64_t key) { return table.insert(key, GlobalMutexTable::valueOf(key)); }
+    bool remove(std::uint64_t key) { return table.remove(key); }
+    bool contains(std::uint64_t key)
+    {
+        std::uint64_t value;
+        return table.find(key, value);
+    }
+private:
+    ConcurrentHashTable<std::uint64_t, std::uint64_t> table;
+};
+
+//****************************测试过程*******************************
+std::atomic<std::size_t> bench_sink(0);    // 查找命中的次数, 使编译器不能省略查找
+
+// nextRandom: xorshift64, 每个线程一个状态
+inline std::uint64_t nextRandom(std::uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// run: 返回每秒完成的操作数
+template<typename Table>
+double run(std::size_t threads, std::size_t operations, std::uint64_t keys, unsigned read_percent)
+{
+    Table table;
+    for (std::uint64_t key = 0; key < 2 * keys; key += 2)
+        table.insert(key);
+    std::atomic<std::size_t> ready(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t != threads; ++t){
+        workers.emplace_back([&, t]{
+            std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            std::size_t hits = 0;
+            ++ready;
+            while (!start)
+                std::this_thread::yield();
+            for (std::size_t i = 0; i != operations; ++i){
+                std::uint64_t r = nextRandom(state);
+                std::uint64_t key = (r >> 8) % (2 * keys);
+                if (r % 100 < read_percent)
+                    hits += table.contains(key);
+                else if (r & 128)
+                    table.insert(key);
+                else
+                    table.remove(key);
+            }
+            bench_sink += hits;
+        });
+    }
+    while (ready != threads)
+        std::this_thread::yield();
+    auto begin = std::chrono::steady_clock::now();
+    start = true;
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return threads * operations / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2 * hardware;
+    std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    std::uint64_t keys = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000;
+    const unsigned read_percents[] = {50, 90, 99};
+
+    std::cout << "table,threads,read_percent,ops_per_second\n";
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2){
+        for (unsigned read_percent : read_percents){
+            std::cout << "global_mutex," << threads << ',' << read_percent << ','
+                      << static_cast<std::uint64_t>(run<GlobalMutexTable>(threads, operations, keys, read_percent)) << '\n';
+            std::cout << "concurrent," << threads << ',' << read_percent << ','
+                      << static_cast<std::uint64_t>(run<ConcurrentTable>(threads, operations, keys, read_percent)) << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*************************************************************************
+	> File Name: concurrent_hash_table_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时00分13秒
+ ************************************************************************/
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_hash_table.h"
+
+// basic_test: 单线程的插入, 修改, 查找, 删除
+void basic_test()
+{
+    ConcurrentHashTable<std::string, int> table(4, 4);
+    bool correct = table.insert("cat", 1) && !table.insert("cat", 2) && table.insert("Cat", 3);
+    int value = 0;
+    correct = correct && table.find("cat", value) && value == 1;
+    correct = correct && !table.assign("cat", 5) && table.find("cat", value) && value == 5;
+    correct = correct && table.assign("dog", 7) && table.contains("dog") && table.size() == 3;
+    correct = correct && table.remove("cat") && !table.remove("cat") && !table.contains("cat") && table.contains("Cat");
+    for (int i = 0; i != 10000; ++i)
+        correct = table.insert("key" + std::to_string(i), i) && correct;
+    for (int i = 0; i != 10000; ++i)
+        correct = correct && table.find("key" + std::to_string(i), value) && value == i;
+    std::cout << "插入10000个元素后桶数" << table.bucketCount() << ", 元素" << table.size() << ": "
+              << (correct && table.size() == 10002 && table.bucketCount() >= 8192 ? "正确" : "错误") << std::endl;
+}
+
+// writers_test: 多个写者同时插入与删除(扩容在插入过程中发生)
+void writers_test()
+{
+    const int threads = 4, per_thread = 50000;
+    ConcurrentHashTable<int, int> table(16, 16);
+    std::vector<std::thread> workers;
+    std::atomic<int> failures(0);
+    for (int t = 0; t != threads; ++t){
+        workers.emplace_back([&, t]{
+            for (int i = t * per_thread; i != (t + 1) * per_thread; ++i)
+                if (!table.insert(i, 2 * i))
+                    ++failures;
+            // 删除自己插入的奇数
+            for (int i = t * per_thread + 1; i < (t + 1) * per_thread; i += 2)
+                if (!table.remove(i))
+                    ++failures;
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    bool correct = failures == 0 && table.size() == std::size_t(threads * per_thread / 2);
+    int value;
+    for (int i = 0; i != threads * per_thread; ++i)
+        correct = correct && table.find(i, value) == (i % 2 == 0) && (i % 2 != 0 || value == 2 * i);
+    std::cout << threads << "个写者, 桶数" << table.bucketCount() << ": " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// readers_test: 写者反复插入删除与扩容时, 读者始终能找到不被修改的元素, 且值正确
+void readers_test()
+{
+    const int stable = 10000;
+    ConcurrentHashTable<int, int> table(16, 16);
+    for (int i = 0; i != stable; ++i)
+        table.insert(i, i + 1);
+    std::atomic<bool> stop(false), wrong(false);
+    std::vector<std::thread> readers;
+    for (int r = 0; r != 3; ++r){
+        readers.emplace_back([&, r]{
+            int value, i = r;
+            while (!stop){
+                if (!table.find(i, value) || value != i + 1)
+                    wrong = true;
+                i = (i + 7) % stable;
+            }
+        });
+    }
+    // 不断插入新键(触发扩容), 删除它们, 修改稳定元素的值为同一个值
+    for (int round = 0; round != 5; ++round){
+        for (int i = stable; i != 8 * stable; ++i)
+            table.insert(i, -1);
+        for (int i = 0; i != stable; ++i)
+            table.assign(i, i + 1);
+        for (int i = stable; i != 8 * stable; ++i)
+            table.remove(i);
+    }
+    stop = true;
+    for (auto &reader : readers)
+        reader.join();
+    table.reclaim();
+    std::cout << "读者与写者并发, 桶数" << table.bucketCount() << ": "
+              << (!wrong && table.size() == std::size_t(stable) ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********并发hash table的基本测试********\n";
+    basic_test();
+    std::cout << "********并发hash table的多写者测试********\n";
+    writers_test();
+    std::cout << "********并发hash table的读写并发测试********\n";
+    readers_test();
+    return 0;
+}
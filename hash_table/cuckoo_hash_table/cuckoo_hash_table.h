@@ -0,0 +1,506 @@
+/*************************************************************************
+	> File Name: cuckoo_hash_table.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时12分14秒
+ ************************************************************************/
+
+#ifndef _CUCKOO_HASH_TABLE_H
+#define _CUCKOO_HASH_TABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../hasher/hasher.h"
+#include "../hash_stats/hash_stats.h"
+
+const std::size_t cuckoo_stash_size = 8;        // 溢出区最多保存的元素个数
+const std::size_t cuckoo_bfs_buckets = 256;     // 插入时广度优先搜索最多访问的桶数
+
+// CuckooHashTable: 分桶的布谷鸟散列表(bucketized cuckoo hashing, 带溢出区)
+/*
+ * 每个元素只能放在两个候选桶中的一个, 每个桶有Ways个槽(4路或8路), 另有一个很小的溢出区(stash):
+ *      --查找最多检查两个桶与溢出区, 最坏情况为O(1); 两个桶的地址都只由散列值决定, 可以同时预取,
+ *        两次缓存未命中是重叠的, 尾延迟与装载因子基本无关(开放寻址法的探查序列在高装载因子时很长);
+ *      --每个槽有一个8位的标签(散列值的高8位, 0表示空槽), 和元素一起放在桶中, 标签相同(误判率1/255)时才比较元素;
+ *      --两个候选桶: b1为散列值的低位, b2 = b1 ^ offset(标签)(partial-key cuckoo hashing, MemC3).
+ *        由一个桶和标签就能求出另一个候选桶, 移动元素时不需要重新计算散列值(键为字符串时这是插入的主要代价).
+ *        桶数为2的幂, offset为奇数, 所以b1 != b2.
+ *
+ * 插入: 两个候选桶都满时, 从它们开始广度优先搜索一条"踢出"路径, 路径终点的桶有空槽, 然后从终点往回
+ * 依次把路径上的元素移到它的另一个候选桶, 最后新元素放入腾出的槽. 与随机游走相比, BFS找到的路径最短
+ * (4路桶时路径长度通常不超过3), 移动的元素最少; 路径只在找到以后才执行, 失败时表不变.
+ * 搜索超过cuckoo_bfs_buckets个桶仍然失败时放入溢出区, 溢出区满时桶数加倍并重新插入所有元素.
+ * 不扩容能达到的装载因子: 4路桶约97%, 8路桶超过99% (16K个槽时的实测值).
+ *
+ * 删除以后溢出区中的元素如果有一个候选桶有了空槽, 就移回桶中, 溢出区通常为空, 查找不需要检查它.
+ *
+ * 键相同的元素只能放在同样的两个桶中, 所以insert按键判断是否已经存在(与开放寻址法不同, 键相同值不同的元素不能共存);
+ * search与hash_delete比较整个元素(键与值), find/emplace/try_emplace只比较键(见chain_hash_table.h).
+ *
+ */
+template<typename HashedObj, typename Hasher = KeyHasher<HashedObj>, std::size_t Ways = 4>
+class CuckooHashTable
+{
+    static_assert(Ways >= 1 && Ways <= 8, "CuckooHashTable: 每个桶的槽数为1到8");
+public:
+    typedef typename HashedObj::KeyType KeyType;
+    typedef typename HashedObj::ValueType ValueType;
+    //***************************构造函数*********************************
+    // num: 初始的槽数(桶数向上取为2的幂)
+    explicit CuckooHashTable(std::size_t num = 64, const Hasher &h = Hasher())
+        : hasher(h), currentSize(0)
+    {buckets.resize(bucketsFor(num));}
+    ~CuckooHashTable() = default;
+    //***************************成员函数*********************************
+    bool insert(const HashedObj &x);        // 插入元素, 键已经存在时返回false
+    bool search(const HashedObj &x) const;  // 查找元素(比较键与值)
+    bool hash_delete(const HashedObj &x);   // 删除元素(比较键与值)
+    void hash_clear();                      // 清空散列表(桶数不变)
+    void reserve(std::size_t n);            // 预留至少n个槽
+    // find: 键等于key的元素的值, 不存在时为nullptr
+    template<typename K>
+    ValueType* find(const K &key);
+    template<typename K>
+    const ValueType* find(const K &key) const;
+    // find_many: 批量查找, out[i] = find(keys[i])
+    template<typename K>
+    void find_many(const K *keys, std::size_t n, const ValueType **out) const;
+    template<typename K>
+    void find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const;
+    // emplace: 用args构造元素, 没有键相同的元素时插入; 返回键相同的元素的值与是否插入
+    template<typename... Args>
+    std::pair<ValueType*, bool> emplace(Args&&... args);
+    // try_emplace: 没有键为key的元素时插入(key, ValueType(args...)), 已经存在时不构造任何对象
+    template<typename K, typename... Args>
+    std::pair<ValueType*, bool> try_emplace(K &&key, Args&&... args);
+
+    std::size_t size() const { return currentSize; }
+    bool empty() const { return currentSize == 0; }
+    std::size_t bucketCount() const { return buckets.size(); }
+    std::size_t capacity() const { return buckets.size() * Ways; }
+    float loadFactor() const { return static_cast<float>(currentSize) / capacity(); }
+    std::size_t stashSize() const { return stash.size(); }
+    // stats: 统计信息(见hash_stats.h), 探查长度: 第一个候选桶为1, 第二个为2, 溢出区为3
+    HashTableStats stats() const;
+    void resetStats() { counters.resetCounters(); }
+private:
+    //***************************数据结构*********************************
+    struct Bucket
+    {
+        Bucket() { std::fill(tags, tags + Ways, 0); }
+        std::uint8_t tags[Ways];    // 每个槽的标签, 0表示空槽
+        HashedObj slots[Ways];
+    };
+    // Step: 广度优先搜索中的一个桶, 它是从parent桶的slot槽中的元素的另一个候选桶
+    struct Step
+    {
+        std::size_t bucket;
+        std::size_t parent;
+        std::size_t slot;
+    };
+    Hasher hasher;
+    std::vector<Bucket> buckets;    // 桶数为2的幂
+    std::vector<std::pair<HashedObj, std::uint64_t>> stash;    // 溢出区中的元素与它们的散列值
+    std::size_t currentSize;
+    HashStatsCounters counters;     // 运行时计数(定义HASH_TABLE_STATS时)
+    //***************************私有成员函数*****************************
+    static std::size_t bucketsFor(std::size_t slots);
+    static std::uint8_t tagOf(std::uint64_t hash);
+    std::size_t firstBucket(std::uint64_t hash) const { return static_cast<std::size_t>(hash) & (buckets.size() - 1); }
+    std::size_t altBucket(std::size_t bucket, std::uint8_t tag) const;
+    static std::size_t freeSlot(const Bucket &bucket);
+    template<typename Equal>
+    const HashedObj* locate(std::uint64_t hash, Equal equal) const;
+    HashedObj* insertNew(HashedObj &x, std::uint64_t hash);
+    HashedObj* insertGrowing(HashedObj &x, std::uint64_t hash);
+    HashedObj* place(std::size_t bucket, std::size_t slot, HashedObj &x, std::uint8_t tag);
+    bool displace(std::size_t b1, std::size_t b2, std::size_t &bucket, std::size_t &slot);
+    void rehash(std::size_t count);
+    void unstash();
+};
+//***************************私有成员函数*********************************
+// bucketsFor: 容纳slots个槽的桶数(2的幂, 至少为2)
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+std::size_t CuckooHashTable<HashedObj, Hasher, Ways>::bucketsFor(std::size_t slots)
+{
+    std::size_t result = 2;
+    while (result * Ways < slots)
+        result <<= 1;
+    return result;
+}
+// tagOf: 散列值的高8位作为标签(低位用于选择桶), 0留给空槽
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+std::uint8_t CuckooHashTable<HashedObj, Hasher, Ways>::tagOf(std::uint64_t hash)
+{
+    std::uint8_t tag = static_cast<std::uint8_t>(hash >> 56);
+    return tag == 0 ? 1 : tag;
+}
+// altBucket: 标签为tag的元素在bucket以外的另一个候选桶(对b1与b2互为逆运算)
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+std::size_t CuckooHashTable<HashedObj, Hasher, Ways>::altBucket(std::size_t bucket, std::uint8_t tag) const
+{
+    std::size_t offset = static_cast<std::size_t>(hashInteger(tag)) | 1;
+    return (bucket ^ offset) & (buckets.size() - 1);
+}
+// freeSlot: 桶中第一个空槽, 没有空槽时为Ways
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+std::size_t CuckooHashTable<HashedObj, Hasher, Ways>::freeSlot(const Bucket &bucket)
+{
+    std::size_t i = 0;
+    while (i != Ways && bucket.tags[i] != 0)
+        ++i;
+    return i;
+}
+// locate: 散列值为hash且满足equal的元素, 不存在时为nullptr
+/*
+ * 只检查两个候选桶中标签相同的槽, 溢出区为空时不访问它.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename Equal>
+const HashedObj* CuckooHashTable<HashedObj, Hasher, Ways>::locate(std::uint64_t hash, Equal equal) const
+{
+    std::uint8_t tag = tagOf(hash);
+    std::size_t b1 = firstBucket(hash), b2 = altBucket(b1, tag);
+    const Bucket &first = buckets[b1], &second = buckets[b2];
+    for (std::size_t i = 0; i != Ways; ++i)
+        if (first.tags[i] == tag && equal(first.slots[i])){
+            counters.recordHit(1);
+            return &first.slots[i];
+        }
+    for (std::size_t i = 0; i != Ways; ++i)
+        if (second.tags[i] == tag && equal(second.slots[i])){
+            counters.recordHit(2);
+            return &second.slots[i];
+        }
+    for (auto &entry : stash)
+        if (entry.second == hash && equal(entry.first)){
+            counters.recordHit(3);
+            return &entry.first;
+        }
+    counters.recordMiss(stash.empty() ? 2 : 3);
+    return nullptr;
+}
+// place: 把x移动到空槽buckets[bucket].slots[slot]中
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+HashedObj* CuckooHashTable<HashedObj, Hasher, Ways>::place(std::size_t bucket, std::size_t slot, HashedObj &x, std::uint8_t tag)
+{
+    buckets[bucket].slots[slot] = std::move(x);
+    buckets[bucket].tags[slot] = tag;
+    ++currentSize;
+    return &buckets[bucket].slots[slot];
+}
+// displace: 两个候选桶都满时, 广度优先搜索踢出路径并执行
+/*
+ * \parameter b1, b2: 新元素的两个候选桶;
+ * \parameter bucket, slot: 成功时为腾出的槽(在b1或b2中);
+ * \return 是否找到路径.
+ * 每个桶在搜索中只出现一次, 所以路径上的桶互不相同, 按从终点到起点的次序移动元素时每个元素都移到它的另一个候选桶.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+bool CuckooHashTable<HashedObj, Hasher, Ways>::displace(std::size_t b1, std::size_t b2, std::size_t &bucket, std::size_t &slot)
+{
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<Step> queue;
+    queue.reserve(cuckoo_bfs_buckets);
+    queue.push_back({b1, none, 0});
+    queue.push_back({b2, none, 0});
+    for (std::size_t q = 0; q != queue.size(); ++q){
+        const Bucket &current = buckets[queue[q].bucket];
+        for (std::size_t i = 0; i != Ways; ++i){
+            std::size_t alt = altBucket(queue[q].bucket, current.tags[i]);
+            std::size_t free = freeSlot(buckets[alt]);
+            if (free != Ways){
+                // 从终点往回移动: 每一步把parent桶中的元素移到刚腾出的槽
+                std::size_t to = alt, toSlot = free, from = q, fromSlot = i;
+                while (true){
+                    Bucket &source = buckets[queue[from].bucket];
+                    buckets[to].slots[toSlot] = std::move(source.slots[fromSlot]);
+                    buckets[to].tags[toSlot] = source.tags[fromSlot];
+                    source.tags[fromSlot] = 0;
+                    if (queue[from].parent == none)
+                        break;
+                    to = queue[from].bucket;
+                    toSlot = fromSlot;
+                    fromSlot = queue[from].slot;
+                    from = queue[from].parent;
+                }
+                bucket = queue[from].bucket;
+                slot = fromSlot;
+                return true;
+            }
+            if (queue.size() == cuckoo_bfs_buckets)
+                continue;
+            bool seen = false;
+            for (auto &step : queue)
+                seen = seen || step.bucket == alt;
+            if (!seen)
+                queue.push_back({alt, q, i});
+        }
+    }
+    return false;
+}
+// insertNew: 插入一个键不存在的元素
+/*
+ * \parameter x: 待插入的元素, 成功时被移走;
+ * \parameter hash: x的散列值;
+ * \return x所在的位置, 桶与溢出区都满时为nullptr(表与x都不变).
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+HashedObj* CuckooHashTable<HashedObj, Hasher, Ways>::insertNew(HashedObj &x, std::uint64_t hash)
+{
+    std::uint8_t tag = tagOf(hash);
+    std::size_t b1 = firstBucket(hash), b2 = altBucket(b1, tag);
+    std::size_t slot = freeSlot(buckets[b1]);
+    if (slot != Ways)
+        return place(b1, slot, x, tag);
+    slot = freeSlot(buckets[b2]);
+    if (slot != Ways)
+        return place(b2, slot, x, tag);
+    std::size_t bucket;
+    if (displace(b1, b2, bucket, slot))
+        return place(bucket, slot, x, tag);
+    if (stash.size() == cuckoo_stash_size)
+        return nullptr;
+    stash.push_back(std::make_pair(std::move(x), hash));
+    ++currentSize;
+    return &stash.back().first;
+}
+// insertGrowing: 插入一个键不存在的元素, 放不下时桶数加倍
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+HashedObj* CuckooHashTable<HashedObj, Hasher, Ways>::insertGrowing(HashedObj &x, std::uint64_t hash)
+{
+    HashedObj *result;
+    while ((result = insertNew(x, hash)) == nullptr)
+        rehash(buckets.size() * 2);
+    return result;
+}
+// rehash: 把所有元素重新插入count个桶中(仍然放不下时继续加倍)
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+void CuckooHashTable<HashedObj, Hasher, Ways>::rehash(std::size_t count)
+{
+    counters.recordRehash();
+    HashStatsCounters::RehashTimer timer(counters);
+    std::vector<HashedObj> all;
+    all.reserve(currentSize);
+    while (true){
+        for (auto &bucket : buckets)
+            for (std::size_t i = 0; i != Ways; ++i)
+                if (bucket.tags[i] != 0)
+                    all.push_back(std::move(bucket.slots[i]));
+        for (auto &entry : stash)
+            all.push_back(std::move(entry.first));
+        std::vector<Bucket>(count).swap(buckets);
+        stash.clear();
+        currentSize = 0;
+        std::size_t i = 0;
+        while (i != all.size() && insertNew(all[i], hasher(all[i])) != nullptr)
+            ++i;
+        if (i == all.size())
+            return;
+        // 新的桶数仍然放不下: 已经插入的元素连同剩下的元素一起放入更多的桶
+        all.erase(all.begin(), all.begin() + i);
+        count *= 2;
+    }
+}
+// unstash: 把候选桶中有空槽的溢出区元素移回桶中
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+void CuckooHashTable<HashedObj, Hasher, Ways>::unstash()
+{
+    for (std::size_t i = 0; i < stash.size(); ){
+        std::uint64_t hash = stash[i].second;
+        std::uint8_t tag = tagOf(hash);
+        std::size_t b1 = firstBucket(hash), b2 = altBucket(b1, tag);
+        std::size_t bucket = b1, slot = freeSlot(buckets[b1]);
+        if (slot == Ways){
+            bucket = b2;
+            slot = freeSlot(buckets[b2]);
+        }
+        if (slot == Ways){
+            ++i;
+            continue;
+        }
+        place(bucket, slot, stash[i].first, tag);
+        --currentSize;
+        stash.erase(stash.begin() + i);
+    }
+}
+//***************************成员函数*************************************
+// insert: 插入元素.
+/*
+ * \parameter x: 待插入的元素;
+ * \return 插入是否成功, 已经有键相同的元素时返回false.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+bool CuckooHashTable<HashedObj, Hasher, Ways>::insert(const HashedObj &x)
+{
+    std::uint64_t hash = hasher(x);
+    if (locate(hash, [&](const HashedObj &y){ return y.key == x.key; }) != nullptr)
+        return false;
+    HashedObj copy(x);
+    insertGrowing(copy, hash);
+    return true;
+}
+// search: 查找元素.
+/*
+ * \parameter x: 待查找的元素;
+ * \return 是否存在与x相等(键与值都相等)的元素.
+ * 算法性能: 最坏情况O(1), 最多检查2 * Ways个槽与溢出区.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+bool CuckooHashTable<HashedObj, Hasher, Ways>::search(const HashedObj &x) const
+{
+    return locate(hasher(x), [&](const HashedObj &y){ return y == x; }) != nullptr;
+}
+// hash_delete: 删除元素.
+/*
+ * \parameter x: 待删除的元素;
+ * \return 删除是否成功.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+bool CuckooHashTable<HashedObj, Hasher, Ways>::hash_delete(const HashedObj &x)
+{
+    const HashedObj *p = locate(hasher(x), [&](const HashedObj &y){ return y == x; });
+    if (p == nullptr)
+        return false;
+    --currentSize;
+    for (std::size_t i = 0; i != stash.size(); ++i){
+        if (&stash[i].first == p){
+            stash.erase(stash.begin() + i);
+            return true;
+        }
+    }
+    // p在某个桶中: 由地址求出桶与槽
+    std::size_t index = static_cast<std::size_t>(reinterpret_cast<const char *>(p) - reinterpret_cast<const char *>(buckets.data())) / sizeof(Bucket);
+    Bucket &bucket = buckets[index];
+    std::size_t slot = static_cast<std::size_t>(p - bucket.slots);
+    bucket.slots[slot] = HashedObj();
+    bucket.tags[slot] = 0;
+    if (!stash.empty())
+        unstash();
+    return true;
+}
+// hash_clear: 清空散列表, 桶数不变
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+void CuckooHashTable<HashedObj, Hasher, Ways>::hash_clear()
+{
+    std::vector<Bucket>(buckets.size()).swap(buckets);
+    stash.clear();
+    currentSize = 0;
+}
+// reserve: 预留至少n个槽(桶数只增加不减少)
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+void CuckooHashTable<HashedObj, Hasher, Ways>::reserve(std::size_t n)
+{
+    std::size_t count = bucketsFor(n);
+    if (count > buckets.size())
+        rehash(count);
+}
+// stats: 统计信息.
+/*
+ * \return 结构统计与运行时计数, longestChain为查找现有元素时的最大探查长度(不超过3).
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+HashTableStats CuckooHashTable<HashedObj, Hasher, Ways>::stats() const
+{
+    HashTableStats result;
+    result.size = currentSize;
+    result.capacity = capacity();
+    for (std::size_t b = 0; b != buckets.size(); ++b)
+        for (std::size_t i = 0; i != Ways; ++i)
+            if (buckets[b].tags[i] != 0)
+                result.stored.add(firstBucket(hasher(buckets[b].slots[i])) == b ? 1 : 2);
+    for (std::size_t i = 0; i != stash.size(); ++i)
+        result.stored.add(3);
+    result.longestChain = static_cast<std::size_t>(result.stored.max);
+    counters.exportTo(result);
+    return result;
+}
+// find: 按键查找.
+/*
+ * \parameter key: 键, 或者可以与键比较相等且Hasher::key可以散列的其它类型;
+ * \return 键等于key的元素的值, 不存在时为nullptr.
+ * 指针在下一次插入或删除之前有效(插入可能移动元素).
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename K>
+const typename HashedObj::ValueType* CuckooHashTable<HashedObj, Hasher, Ways>::find(const K &key) const
+{
+    const HashedObj *p = locate(hasher.key(key), [&](const HashedObj &y){ return y.key == key; });
+    return p == nullptr ? nullptr : &p->value;
+}
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename K>
+typename HashedObj::ValueType* CuckooHashTable<HashedObj, Hasher, Ways>::find(const K &key)
+{
+    return const_cast<ValueType*>(static_cast<const CuckooHashTable&>(*this).find(key));
+}
+// find_many: 批量查找.
+/*
+ * \parameter keys: n个待查找的键;
+ * \parameter out: 结果, out[i]为键等于keys[i]的元素的值, 不存在时为nullptr.
+ * 每批hash_lookup_batch个键, 先计算散列值并同时预取每个键的两个候选桶, 再逐个比较.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename K>
+void CuckooHashTable<HashedObj, Hasher, Ways>::find_many(const K *keys, std::size_t n, const ValueType **out) const
+{
+    std::uint64_t hashes[hash_lookup_batch];
+    for (std::size_t low = 0; low < n; low += hash_lookup_batch){
+        std::size_t count = std::min(hash_lookup_batch, n - low);
+        for (std::size_t i = 0; i != count; ++i){
+            hashes[i] = hasher.key(keys[low + i]);
+            std::size_t b1 = firstBucket(hashes[i]);
+            hashPrefetch(&buckets[b1]);
+            hashPrefetch(&buckets[altBucket(b1, tagOf(hashes[i]))]);
+        }
+        for (std::size_t i = 0; i != count; ++i){
+            const K &key = keys[low + i];
+            const HashedObj *p = locate(hashes[i], [&](const HashedObj &y){ return y.key == key; });
+            out[low + i] = p == nullptr ? nullptr : &p->value;
+        }
+    }
+}
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename K>
+void CuckooHashTable<HashedObj, Hasher, Ways>::find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const
+{
+    out.resize(keys.size());
+    find_many(keys.data(), keys.size(), out.data());
+}
+// emplace: 原地构造元素并按键插入.
+/*
+ * \parameter args: HashedObj的构造函数的参数;
+ * \return 键相同的元素的值, 与是否插入了新元素.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> CuckooHashTable<HashedObj, Hasher, Ways>::emplace(Args&&... args)
+{
+    HashedObj x(std::forward<Args>(args)...);
+    std::uint64_t hash = hasher(x);
+    const HashedObj *p = locate(hash, [&](const HashedObj &y){ return y.key == x.key; });
+    if (p != nullptr)
+        return std::make_pair(const_cast<ValueType*>(&p->value), false);
+    return std::make_pair(&insertGrowing(x, hash)->value, true);
+}
+// try_emplace: 键不存在时插入.
+/*
+ * \parameter key: 键, 或者可以构造键并与键比较相等的其它类型;
+ * \parameter args: ValueType的构造函数的参数;
+ * \return 键相同的元素的值, 与是否插入了新元素.
+ * 先用key查找, 键已经存在时不构造键, 值与元素.
+*/
+template<typename HashedObj, typename Hasher, std::size_t Ways>
+template<typename K, typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> CuckooHashTable<HashedObj, Hasher, Ways>::try_emplace(K &&key, Args&&... args)
+{
+    std::uint64_t hash = hasher.key(key);
+    const HashedObj *p = locate(hash, [&](const HashedObj &y){ return y.key == key; });
+    if (p != nullptr)
+        return std::make_pair(const_cast<ValueType*>(&p->value), false);
+    HashedObj x(KeyType(std::forward<K>(key)), ValueType(std::forward<Args>(args)...));
+    return std::make_pair(&insertGrowing(x, hash)->value, true);
+}
+#endif
@@ -0,0 +1,130 @@
+/*************************************************************************
+	> File Name: cuckoo_hash_table_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时17分40秒
+ ************************************************************************/
+// 布谷鸟散列表与开放寻址散列表在高装载因子下的性能对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [槽数(默认1048576)] [查找次数(默认1000000)]
+ *      两个表的槽数相同(开放寻址法取不小于它的素数, 双重散列才能访问所有槽), 从空表插入到装载因子
+ *      0.5, 0.75, 0.9, 0.95, 然后分别测量键存在与键不存在时的查找.
+ *
+ * 对比的实现:
+ *      --open_addressing: open_addressing_hash_table.h(双重散列);
+ *      --cuckoo4, cuckoo8: CuckooHashTable, 4路与8路桶.
+ *
+ * 输出的每一行: table,load,insert_ns,hit_ns,miss_ns,hit_p99_ns,miss_p99_ns
+ *      --*_ns: 每次操作的平均时间;
+ *      --*_p99_ns: 单独计时每次查找得到的99%分位延迟(包含约20ns的计时开销), 反映尾延迟.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "hash.h"
+#include "cuckoo_hash_table.h"
+#include "../open_addressing_hash_table/open_addressing_hash_table.h"
+
+typedef Hash<std::uint64_t, std::uint64_t> Element;
+typedef std::chrono::steady_clock Clock;
+
+std::size_t bench_sink = 0;     // 查找命中的次数, 使编译器不能省略查找
+
+// keyOf: 互不相同且分布均匀的键(乘以奇数是2^64上的双射)
+inline std::uint64_t keyOf(std::uint64_t i) { return (i + 1) * 0x9E3779B97F4A7C15ull; }
+
+bool isPrime(std::size_t n)
+{
+    if (n < 2)
+        return false;
+    for (std::size_t d = 2; d * d <= n; ++d)
+        if (n % d == 0)
+            return false;
+    return true;
+}
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+
+// Result: 一个表在一个装载因子下的测量结果
+struct Result
+{
+    double insert_ns, hit_ns, miss_ns, hit_p99_ns, miss_p99_ns;
+};
+
+// lookups: 测量从keys[first, first + count)中随机选取的键的查找
+template<typename Table>
+void lookups(const Table &table, std::uint64_t first, std::uint64_t count, std::size_t operations,
+             double &mean_ns, double &p99_ns)
+{
+    std::vector<std::uint64_t> probe(operations);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (auto &key : probe){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = keyOf(first + state % count);
+    }
+    std::size_t hits = 0;
+    auto begin = Clock::now();
+    for (auto key : probe)
+        hits += table.find(key) != nullptr;
+    mean_ns = nanosecondsSince(begin, operations);
+    std::vector<double> latency(std::min<std::size_t>(operations, 200000));
+    for (std::size_t i = 0; i != latency.size(); ++i){
+        auto start = Clock::now();
+        hits += table.find(probe[i]) != nullptr;
+        latency[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    std::nth_element(latency.begin(), latency.begin() + latency.size() * 99 / 100, latency.end());
+    p99_ns = latency[latency.size() * 99 / 100];
+    bench_sink += hits;
+}
+
+template<typename Table>
+Result run(std::size_t slots, double load, std::size_t operations)
+{
+    Table table(slots);
+    std::size_t n = static_cast<std::size_t>(load * slots);
+    Result result;
+    auto begin = Clock::now();
+    for (std::size_t i = 0; i != n; ++i)
+        table.insert(Element(keyOf(i), i));
+    result.insert_ns = nanosecondsSince(begin, n);
+    lookups(table, 0, n, operations, result.hit_ns, result.hit_p99_ns);
+    lookups(table, n, n, operations, result.miss_ns, result.miss_p99_ns);
+    return result;
+}
+
+void print(const char *name, double load, const Result &r)
+{
+    std::cout << name << ',' << load << ',' << r.insert_ns << ',' << r.hit_ns << ',' << r.miss_ns << ','
+              << r.hit_p99_ns << ',' << r.miss_p99_ns << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t slots = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (std::size_t(1) << 20);
+    std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    // 布谷鸟散列表的桶数为2的幂, 开放寻址法使用素数个槽
+    slots = CuckooHashTable<Element, KeyHasher<Element>, 4>(slots).capacity();
+    std::size_t prime = slots;
+    while (!isPrime(prime))
+        ++prime;
+    const double loads[] = {0.5, 0.75, 0.9, 0.95};
+
+    std::cout << "table,load,insert_ns,hit_ns,miss_ns,hit_p99_ns,miss_p99_ns\n";
+    for (double load : loads){
+        print("open_addressing", load, run<HashTable<Element>>(prime, load, operations));
+        print("cuckoo4", load, run<CuckooHashTable<Element, KeyHasher<Element>, 4>>(slots, load, operations));
+        print("cuckoo8", load, run<CuckooHashTable<Element, KeyHasher<Element>, 8>>(slots, load, operations));
+    }
+    return 0;
+}
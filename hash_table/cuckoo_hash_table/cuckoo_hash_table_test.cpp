@@ -0,0 +1,129 @@
+/*************************************************************************
+	> File Name: cuckoo_hash_table_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时21分23秒
+ ************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include "hash.h"
+#include "cuckoo_hash_table.h"
+typedef Hash<std::string, int> IHash;
+typedef CuckooHashTable<IHash> Hashtable;
+
+void inserts_test()
+{
+    Hashtable hashTable;
+    bool correct = hashTable.insert({"cat", 1234}) && !hashTable.insert({"cat", 1234});
+    // 键相同的元素只能有一个
+    correct = correct && !hashTable.insert({"cat", 123}) && hashTable.insert({"Cat", 111});
+    std::cout << "插入: " << (correct && hashTable.size() == 2 ? "正确" : "错误") << std::endl;
+}
+
+void search_delete_test()
+{
+    Hashtable hashTable;
+    hashTable.insert({"cat", 1234});
+    hashTable.insert({"Cat", 111});
+    hashTable.insert({"ss", 987});
+    bool correct = hashTable.search({"cat", 1234}) && !hashTable.search({"cat", 123}) && !hashTable.search({"ZHH", 110});
+    correct = correct && !hashTable.hash_delete({"cat", 123}) && hashTable.hash_delete({"cat", 1234});
+    correct = correct && !hashTable.search({"cat", 1234}) && hashTable.search({"Cat", 111}) && hashTable.size() == 2;
+    hashTable.hash_clear();
+    correct = correct && hashTable.empty() && !hashTable.search({"ss", 987});
+    std::cout << "查找与删除: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// load_test: 不扩容时能达到的装载因子, 以及扩容与删除以后所有元素都在
+template<std::size_t Ways>
+void load_test()
+{
+    CuckooHashTable<IHash, KeyHasher<IHash>, Ways> hashTable(1 << 14);
+    std::size_t capacity = hashTable.capacity();
+    int i = 0;
+    while (hashTable.capacity() == capacity){
+        hashTable.insert({"key" + std::to_string(i), i});
+        ++i;
+    }
+    double load = static_cast<double>(i - 1) / capacity;
+    for (int j = i; j != 40000; ++j)
+        hashTable.insert({"key" + std::to_string(j), j});
+    bool correct = hashTable.size() == 40000;
+    for (int j = 0; j < 40000; j += 2)
+        correct = hashTable.hash_delete({"key" + std::to_string(j), j}) && correct;
+    for (int j = 0; j != 40000; ++j)
+        correct = correct && hashTable.search({"key" + std::to_string(j), j}) == (j % 2 == 1);
+    std::cout << Ways << "路桶第一次扩容前的装载因子: " << load << (load > 0.9 ? " 正确" : " 错误")
+              << ", 扩容与删除以后: " << (correct && hashTable.size() == 20000 ? "正确" : "错误") << std::endl;
+}
+
+// stash_test: 只有两个桶时多出的元素进入溢出区, 删除以后移回桶中
+void stash_test()
+{
+    CuckooHashTable<IHash, KeyHasher<IHash>, 1> hashTable(2);
+    bool correct = true;
+    for (int i = 0; i != 6; ++i)
+        correct = hashTable.insert({"key" + std::to_string(i), i}) && correct;
+    correct = correct && hashTable.size() == 6;
+    for (int i = 0; i != 6; ++i)
+        correct = correct && *hashTable.find("key" + std::to_string(i)) == i;
+    std::size_t stashed = hashTable.stashSize();
+    for (int i = 0; i != 5; ++i)
+        correct = hashTable.hash_delete({"key" + std::to_string(i), i}) && correct;
+    std::cout << "溢出区: " << (correct && stashed > 0 && hashTable.stashSize() == 0 && *hashTable.find("key5") == 5 ? "正确" : "错误")
+              << std::endl;
+}
+
+// find_test: 按键查找(const char *直接查找, 不构造std::string), emplace/try_emplace与批量查找
+void find_test()
+{
+    Hashtable hashTable;
+    bool correct = hashTable.find("cat") == nullptr;
+    auto result = hashTable.try_emplace("cat", 1234);
+    correct = correct && result.second && *result.first == 1234;
+    correct = correct && !hashTable.try_emplace(std::string("cat"), 1).second && !hashTable.emplace("cat", 2).second;
+    *hashTable.find("cat") = 9;
+    correct = correct && hashTable.search({"cat", 9});
+    std::vector<std::string> keys;
+    for (int i = 0; i != 5000; ++i){
+        hashTable.emplace("key" + std::to_string(i), i);
+        keys.push_back("key" + std::to_string(2 * i));
+    }
+    std::vector<const int *> values;
+    hashTable.find_many(keys, values);
+    for (int i = 0; i != 5000; ++i)
+        correct = correct && values[i] == hashTable.find(keys[i]) && (i < 2500 ? *values[i] == 2 * i : values[i] == nullptr);
+    std::cout << "按键查找与批量查找: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// stats_test: 结构统计, 溢出区中的元素探查长度为3
+void stats_test()
+{
+    CuckooHashTable<IHash, KeyHasher<IHash>, 1> hashTable(2);
+    for (int i = 0; i != 6; ++i)
+        hashTable.insert({"key" + std::to_string(i), i});
+    HashTableStats stats = hashTable.stats();
+    bool correct = stats.size == 6 && stats.stored.total == 6 && stats.stored.counts[3] == hashTable.stashSize();
+    correct = correct && stats.stored.counts[1] + stats.stored.counts[2] + stats.stored.counts[3] == 6;
+    correct = correct && stats.capacity == hashTable.capacity() && stats.longestChain <= 3 && !stats.counting;
+    std::cout << "统计信息: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********cuckoo hash table的insert测试********\n";
+    inserts_test();
+    std::cout << "********cuckoo hash table的search与hash_delete测试*******\n";
+    search_delete_test();
+    std::cout << "********cuckoo hash table的装载因子测试********\n";
+    load_test<4>();
+    load_test<8>();
+    std::cout << "********cuckoo hash table的溢出区测试********\n";
+    stash_test();
+    std::cout << "********cuckoo hash table的find测试********\n";
+    find_test();
+    std::cout << "********cuckoo hash table的统计信息测试********\n";
+    stats_test();
+    return 0;
+}
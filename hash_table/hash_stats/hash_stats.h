@@ -0,0 +1,159 @@
+/*************************************************************************
+	> File Name: hash_stats.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时24分27秒
+ ************************************************************************/
+
+#ifndef _HASH_STATS_H
+#define _HASH_STATS_H
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+// 散列表的统计信息
+/*
+ * 每个散列表的stats()返回HashTableStats, 分为两部分:
+ *      --结构统计: 调用stats()时遍历散列表得到(装载因子, 墓碑比例, 最长的链或探查序列, 完全散列最大的二级表,
+ *        每个元素的查找长度的直方图), 不调用stats()时没有任何代价;
+ *      --运行时计数: 每次查找命中与未命中时的探查长度直方图, 再散列的次数与时间. 只有在包含散列表的头文件之前
+ *        定义了宏HASH_TABLE_STATS才收集, 否则HashStatsCounters是空类, 记录函数都是空的内联函数,
+ *        编译以后不留下任何指令, 每个散列表只多一个空的成员. 同一个程序的所有编译单元必须使用相同的设置.
+ *
+ * 探查长度的含义: 链接法为比较过的元素个数(未命中时为链表长度), 开放寻址法为访问过的槽数, Swiss table为访问过的组数,
+ * 布谷鸟散列为访问过的位置数(第一个桶为1, 第二个桶为2, 溢出区为3), 完全散列总是1.
+ *
+ * toJson()输出一个JSON对象, 可以直接交给监控系统, 例如在平均查找长度或墓碑比例超过阈值时报警.
+ *
+ */
+
+const std::size_t hash_stats_bins = 16;    // 直方图的格数, 最后一格统计长度不小于hash_stats_bins - 1的次数
+
+// HashProbeHistogram: 探查长度的直方图
+struct HashProbeHistogram
+{
+    HashProbeHistogram() : total(0), sum(0), max(0) { std::fill(counts, counts + hash_stats_bins, 0); }
+    void add(std::size_t length)
+    {
+        ++counts[std::min(length, hash_stats_bins - 1)];
+        ++total;
+        sum += length;
+        max = std::max<std::uint64_t>(max, length);
+    }
+    double mean() const { return total == 0 ? 0.0 : static_cast<double>(sum) / total; }
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\"count\":" << total << ",\"mean\":" << mean() << ",\"max\":" << max << ",\"bins\":[";
+        for (std::size_t i = 0; i != hash_stats_bins; ++i)
+            out << (i == 0 ? "" : ",") << counts[i];
+        out << "]}";
+    }
+
+    std::uint64_t counts[hash_stats_bins];  // counts[i]: 长度为i的次数
+    std::uint64_t total;                    // 总次数
+    std::uint64_t sum;                      // 长度之和
+    std::uint64_t max;                      // 最大长度
+};
+
+// HashTableStats: 一个散列表的统计信息
+struct HashTableStats
+{
+    HashTableStats()
+        : size(0), capacity(0), tombstones(0), longestChain(0), maxSecondLevel(0),
+          counting(false), rehashes(0), rehashSeconds(0) {  }
+    double loadFactor() const { return capacity == 0 ? 0.0 : static_cast<double>(size) / capacity; }
+    double tombstoneRatio() const { return capacity == 0 ? 0.0 : static_cast<double>(tombstones) / capacity; }
+    std::string toJson() const
+    {
+        std::ostringstream out;
+        out << "{\"size\":" << size << ",\"capacity\":" << capacity << ",\"load_factor\":" << loadFactor()
+            << ",\"tombstones\":" << tombstones << ",\"tombstone_ratio\":" << tombstoneRatio()
+            << ",\"longest_chain\":" << longestChain << ",\"max_second_level\":" << maxSecondLevel << ",\"stored\":";
+        stored.writeJson(out);
+        out << ",\"counting\":" << (counting ? "true" : "false") << ",\"hits\":";
+        hits.writeJson(out);
+        out << ",\"misses\":";
+        misses.writeJson(out);
+        out << ",\"rehashes\":" << rehashes << ",\"rehash_seconds\":" << rehashSeconds << "}";
+        return out.str();
+    }
+
+    //*************************结构统计***********************************
+    std::size_t size;               // 元素个数
+    std::size_t capacity;           // 链接法为桶数, 其它为槽数
+    std::size_t tombstones;         // 删除标记(开放寻址法的DELETE, Swiss table的墓碑)的个数
+    std::size_t longestChain;       // 最长的链表/探查序列(查找现有元素时的最大探查长度)
+    std::size_t maxSecondLevel;     // 完全散列最大的二级散列表的槽数
+    HashProbeHistogram stored;      // 查找每个现有元素的探查长度
+    //*************************运行时计数*********************************
+    bool counting;                  // 是否定义了HASH_TABLE_STATS(为false时下面的计数都为0)
+    HashProbeHistogram hits;        // 命中的查找的探查长度
+    HashProbeHistogram misses;      // 未命中的查找的探查长度
+    std::uint64_t rehashes;         // 再散列(重建)的次数
+    double rehashSeconds;           // 再散列用去的时间
+};
+
+// HashStatsCounters: 散列表的运行时计数
+#if defined(HASH_TABLE_STATS)
+class HashStatsCounters
+{
+public:
+    HashStatsCounters() : rehashes(0), rehashSeconds(0) {  }
+    void recordHit(std::size_t probes) const { hits.add(probes); }
+    void recordMiss(std::size_t probes) const { misses.add(probes); }
+    void recordLookup(bool hit, std::size_t probes) const { hit ? recordHit(probes) : recordMiss(probes); }
+    void recordRehash() const { ++rehashes; }
+    // RehashTimer: 在对象存在期间计时, 计入再散列的时间
+    class RehashTimer
+    {
+    public:
+        explicit RehashTimer(const HashStatsCounters &c) : counters(c), begin(std::chrono::steady_clock::now()) {  }
+        ~RehashTimer()
+        {
+            counters.rehashSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        }
+    private:
+        const HashStatsCounters &counters;
+        std::chrono::steady_clock::time_point begin;
+    };
+    void exportTo(HashTableStats &stats) const
+    {
+        stats.counting = true;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.rehashes = rehashes;
+        stats.rehashSeconds = rehashSeconds;
+    }
+    void resetCounters()
+    {
+        hits = misses = HashProbeHistogram();
+        rehashes = 0;
+        rehashSeconds = 0;
+    }
+private:
+    // 查找是const成员函数, 计数也要在其中修改
+    mutable HashProbeHistogram hits;
+    mutable HashProbeHistogram misses;
+    mutable std::uint64_t rehashes;
+    mutable double rehashSeconds;
+};
+#else
+class HashStatsCounters
+{
+public:
+    void recordHit(std::size_t) const {  }
+    void recordMiss(std::size_t) const {  }
+    void recordLookup(bool, std::size_t) const {  }
+    void recordRehash() const {  }
+    class RehashTimer
+    {
+    public:
+        explicit RehashTimer(const HashStatsCounters &) {  }
+    };
+    void exportTo(HashTableStats &) const {  }
+    void resetCounters() {  }
+};
+#endif
+#endif
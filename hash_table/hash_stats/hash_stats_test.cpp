@@ -0,0 +1,97 @@
+/*************************************************************************
+	> File Name: hash_stats_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时27分10秒
+ ************************************************************************/
+// 开启运行时计数: 必须在包含任何散列表的头文件之前定义
+#define HASH_TABLE_STATS
+#include <iostream>
+#include <string>
+#include "hash_stats.h"
+#include "../chain_hash_table/hash.h"
+#include "../chain_hash_table/chain_hash_table.h"
+#include "../cuckoo_hash_table/cuckoo_hash_table.h"
+#include "../swiss_hash_table/swiss_hash_table.h"
+typedef Hash<std::string, int> IHash;
+
+void histogram_test()
+{
+    HashProbeHistogram histogram;
+    histogram.add(1);
+    histogram.add(1);
+    histogram.add(4);
+    histogram.add(100);
+    bool correct = histogram.total == 4 && histogram.counts[1] == 2 && histogram.counts[4] == 1;
+    // 超出范围的长度计入最后一格, 但平均值与最大值使用实际长度
+    correct = correct && histogram.counts[hash_stats_bins - 1] == 1 && histogram.max == 100 && histogram.mean() == 26.5;
+    HashTableStats stats;
+    stats.size = 3;
+    stats.capacity = 4;
+    std::string json = stats.toJson();
+    correct = correct && json.find("\"load_factor\":0.75") != std::string::npos && json.front() == '{' && json.back() == '}';
+    std::cout << "直方图与JSON: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+void chain_test()
+{
+    HashTable<IHash> hashTable(16);
+    for (int i = 0; i != 1000; ++i)
+        hashTable.insert({"key" + std::to_string(i), i});
+    HashTableStats stats = hashTable.stats();
+    bool correct = stats.counting && stats.rehashes > 0 && stats.rehashSeconds >= 0;
+    hashTable.resetStats();
+    for (int i = 0; i != 100; ++i)
+        hashTable.contains({"key" + std::to_string(i), i});
+    for (int i = 0; i != 50; ++i)
+        hashTable.find("none" + std::to_string(i));
+    stats = hashTable.stats();
+    correct = correct && stats.hits.total == 100 && stats.misses.total == 50 && stats.rehashes == 0;
+    correct = correct && stats.hits.counts[0] == 0 && stats.hits.max <= stats.longestChain;
+    std::cout << "链接法的运行时计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+void cuckoo_test()
+{
+    CuckooHashTable<IHash> hashTable(64);
+    for (int i = 0; i != 1000; ++i)
+        hashTable.insert({"key" + std::to_string(i), i});
+    bool correct = hashTable.stats().rehashes > 0;
+    hashTable.resetStats();
+    for (int i = 0; i != 1000; ++i)
+        hashTable.find("key" + std::to_string(i));
+    hashTable.find("none");
+    HashTableStats stats = hashTable.stats();
+    // 查找现有元素的探查长度与结构统计一致
+    correct = correct && stats.hits.total == 1000 && stats.misses.total == 1;
+    for (std::size_t i = 0; i != hash_stats_bins; ++i)
+        correct = correct && stats.hits.counts[i] == stats.stored.counts[i];
+    std::cout << "布谷鸟散列的运行时计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+void swiss_test()
+{
+    SwissHashTable<int, int> table;
+    for (int i = 0; i != 10000; ++i)
+        table.insert(i, i);
+    bool correct = table.stats().rehashes > 0;
+    table.resetStats();
+    for (int i = 0; i != 10000; ++i)
+        table.find(i);
+    HashTableStats stats = table.stats();
+    correct = correct && stats.hits.total == 10000 && stats.hits.sum == stats.stored.sum && stats.misses.total == 0;
+    correct = correct && stats.toJson().find("\"counting\":true") != std::string::npos;
+    std::cout << "Swiss table的运行时计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********hash stats的直方图测试********\n";
+    histogram_test();
+    std::cout << "********hash stats的散列表计数测试********\n";
+    chain_test();
+    cuckoo_test();
+    swiss_test();
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*************************************************************************
+	> File Name: hasher.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时56分13秒
+ ************************************************************************/
+
+#ifndef _HASHER_H
+#define _HASHER_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+// 散列表使用的散列函数, 所有散列函数都返回64位的散列值
+/*
+ * 散列表只用到散列值的一部分(链接法与开放寻址法取高位或者取模, Swiss table取低7位与其余的高位),
+ * 所以散列值的每一位都应该与输入的每一位有关. 原来的getIndex()把每个字符乘以128再相加:
+ * 所有字母相同的字符串(anagram)散列值相同, 短字符串的散列值也集中在很小的范围内.
+ *
+ */
+
+// 混合用的常数(wyhash)
+const std::uint64_t hash_prime0 = 0xa0761d6478bd642full;
+const std::uint64_t hash_prime1 = 0xe7037ed1a0b428dbull;
+const std::uint64_t hash_prime2 = 0x8ebc6af09c88c6e3ull;
+const std::uint64_t hash_prime3 = 0x589965cc75374cc3ull;
+
+// hashMum: 64位乘64位得到128位的乘积, 返回高64位与低64位的异或(每一位结果都与两个乘数的所有位有关)
+inline std::uint64_t hashMum(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#else
+    // 拆成32位的四个部分积
+    std::uint64_t ha = a >> 32, la = a & 0xffffffffull, hb = b >> 32, lb = b & 0xffffffffull;
+    std::uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    std::uint64_t middle = (ll >> 32) + (hl & 0xffffffffull) + (lh & 0xffffffffull);
+    std::uint64_t low = (ll & 0xffffffffull) | (middle << 32);
+    std::uint64_t high = hh + (hl >> 32) + (lh >> 32) + (middle >> 32);
+    return low ^ high;
+#endif
+}
+
+inline std::uint64_t hashRead64(const unsigned char *p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+inline std::uint64_t hashRead32(const unsigned char *p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// hashBytes: 任意字节序列的散列值(wyhash风格)
+/*
+ * \parameter data: 字节序列的起始地址;
+ * \parameter length: 字节数;
+ * \parameter seed: 种子, 不同的种子得到互相独立的散列函数;
+ * \return 64位散列值.
+ *
+ * 算法基本思想: 每次读入16字节(两个64位整数), 分别与常数异或后用hashMum混合进状态;
+ * 长于48字节时三条互不依赖的状态链并行处理48字节, 最后合并; 不超过16字节时用几次有重叠的读取覆盖所有字节,
+ * 没有循环和分支预测失败. 速度接近内存带宽, 短字符串只需要两到三次乘法.
+ *
+ */
+inline std::uint64_t hashBytes(const void *data, std::size_t length, std::uint64_t seed = 0)
+{
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    seed ^= hashMum(seed ^ hash_prime0, hash_prime1);
+    std::uint64_t a, b;
+    if (length <= 16){
+        if (length >= 4){
+            // 读取开头与结尾各两个有重叠的4字节
+            std::size_t shift = (length >> 3) << 2;
+            a = (hashRead32(p) << 32) | hashRead32(p + shift);
+            b = (hashRead32(p + length - 4) << 32) | hashRead32(p + length - 4 - shift);
+        }else if (length > 0){
+            a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[length >> 1]) << 8) | p[length - 1];
+            b = 0;
+        }else{
+            a = b = 0;
+        }
+    }else{
+        std::size_t i = length;
+        if (i > 48){
+            std::uint64_t see1 = seed, see2 = seed;
+            do{
+                seed = hashMum(hashRead64(p) ^ hash_prime1, hashRead64(p + 8) ^ seed);
+                see1 = hashMum(hashRead64(p + 16) ^ hash_prime2, hashRead64(p + 24) ^ see1);
+                see2 = hashMum(hashRead64(p + 32) ^ hash_prime3, hashRead64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            }while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16){
+            seed = hashMum(hashRead64(p) ^ hash_prime1, hashRead64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = hashRead64(p + i - 16);
+        b = hashRead64(p + i - 8);
+    }
+    return hashMum(hash_prime1 ^ length, hashMum(a ^ hash_prime1, b ^ seed));
+}
+
+// hashInteger: 整数的散列值(乘法与移位交替混合, MurmurHash3的fmix64)
+/*
+ * 乘法只把低位扩散到高位, 右移再异或把高位扩散回低位; 两轮以后输入的每一位改变时每个输出位改变的概率都接近1/2.
+ * 只需要两次64位乘法, 与hashMum的一次128位乘法相比, 对连续的小整数雪崩效果更好.
+ *
+ */
+inline std::uint64_t hashInteger(std::uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// hashRange: 把64位散列值均匀地映射到[0, n)(取h * n的高64位), 只需要一次乘法, 不需要除法
+inline std::uint64_t hashRange(std::uint64_t h, std::uint64_t n)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+#else
+    return h % n;
+#endif
+}
+
+const std::size_t hash_lookup_batch = 16;   // 批量查找时每批同时预取的键数
+
+// hashPrefetch: 预取p所在的缓存行(批量查找时先为之后的键预取桶, 访存与计算重叠)
+inline void hashPrefetch(const void *p)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// DefaultHasher: 按类型选择散列函数
+/*
+ * --整数与枚举: hashInteger;
+ * --浮点数: 按位散列(+0.0与-0.0相等, 先统一为+0.0);
+ * --std::string: hashBytes;
+ * --其它类型: std::hash的结果再用hashInteger混合.
+ *
+ */
+template<typename T, typename Enable = void>
+struct DefaultHasher
+{
+    std::uint64_t operator()(const T &x) const { return hashInteger(static_cast<std::uint64_t>(std::hash<T>()(x))); }
+};
+template<typename T>
+struct DefaultHasher<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+{
+    std::uint64_t operator()(const T &x) const { return hashInteger(static_cast<std::uint64_t>(x)); }
+};
+template<typename T>
+struct DefaultHasher<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    std::uint64_t operator()(const T &x) const
+    {
+        T value = (x == 0) ? T(0) : x;
+        return hashBytes(&value, sizeof(value));
+    }
+};
+// std::string的散列值只与字符有关, 所以const char *与std::string_view可以直接查找, 不需要构造std::string
+template<>
+struct DefaultHasher<std::string>
+{
+    std::uint64_t operator()(const std::string &s) const { return hashBytes(s.data(), s.size()); }
+    std::uint64_t operator()(const char *s) const { return hashBytes(s, std::strlen(s)); }
+#if __cplusplus >= 201703L
+    std::uint64_t operator()(std::string_view s) const { return hashBytes(s.data(), s.size()); }
+#endif
+};
+
+// KeyHasher: 散列表中存储的对象(见各散列表目录下的hash.h)只按键散列, 键相等的对象散列值相同
+/*
+ * key(k)直接散列一个键, 结果与散列键为k的对象相同, 散列表按键查找时使用它.
+ * k可以是与键类型不同但可以比较相等的类型(异构查找), 例如键为std::string时的const char *与std::string_view.
+ *
+ */
+template<typename HashedObj>
+struct KeyHasher
+{
+    std::uint64_t operator()(const HashedObj &x) const { return DefaultHasher<typename HashedObj::KeyType>()(x.key); }
+    template<typename K>
+    std::uint64_t key(const K &k) const { return DefaultHasher<typename HashedObj::KeyType>()(k); }
+};
+
+// IndexHasher: 使用对象自己的getIndex(), 与原来的行为相同
+template<typename HashedObj>
+struct IndexHasher
+{
+    std::uint64_t operator()(const HashedObj &x) const { return x.getIndex(); }
+};
+#endif
@@ -0,0 +1,101 @@
+/*************************************************************************
+	> File Name: hasher_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时58分56秒
+ ************************************************************************/
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "hasher.h"
+
+// popcount64: 64位整数中1的个数
+int popcount64(std::uint64_t x)
+{
+    int count = 0;
+    for (; x != 0; x &= x - 1)
+        ++count;
+    return count;
+}
+
+// string_test: 字母相同的字符串, 只差一个字符的字符串, 各种长度的前缀散列值都不同
+void string_test()
+{
+    DefaultHasher<std::string> hasher;
+    const char *words[] = {"listen", "silent", "enlist", "tinsel", "inlets"};
+    std::set<std::uint64_t> values;
+    for (int i = 0; i != 5; ++i)
+        values.insert(hasher(words[i]));
+    std::cout << "字母相同的字符串: " << (values.size() == 5 ? "正确" : "错误") << std::endl;
+
+    std::string text(200, 'a');
+    values.clear();
+    for (std::size_t length = 0; length <= text.size(); ++length)
+        values.insert(hashBytes(text.data(), length));
+    std::cout << "长度0到200的前缀: " << (values.size() == text.size() + 1 ? "正确" : "错误") << std::endl;
+
+    values.clear();
+    for (int i = 0; i != 100000; ++i)
+        values.insert(hasher("key" + std::to_string(i)));
+    std::cout << "100000个短字符串没有冲突: " << (values.size() == 100000 ? "正确" : "错误") << std::endl;
+    std::cout << "不同的种子: " << (hashBytes("cat", 3, 1) != hashBytes("cat", 3, 2) ? "正确" : "错误") << std::endl;
+}
+
+// avalanche_test: 改变输入的任意一位, 平均约一半的输出位改变
+void avalanche_test()
+{
+    DefaultHasher<std::uint64_t> integer;
+    unsigned char bytes[40] = {0};
+    double integer_flips = 0, bytes_flips = 0;
+    int trials = 0;
+    for (std::uint64_t x = 1; x != 201; ++x){
+        for (int bit = 0; bit != 64; ++bit){
+            integer_flips += popcount64(integer(x) ^ integer(x ^ (std::uint64_t(1) << bit)));
+            ++trials;
+        }
+    }
+    integer_flips /= trials;
+    trials = 0;
+    for (int length = 1; length <= 40; ++length){
+        for (int bit = 0; bit != 8 * length; ++bit){
+            std::uint64_t before = hashBytes(bytes, length);
+            bytes[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+            bytes_flips += popcount64(before ^ hashBytes(bytes, length));
+            bytes[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+            ++trials;
+        }
+    }
+    bytes_flips /= trials;
+    std::cout << "整数平均改变" << integer_flips << "位, 字节序列平均改变" << bytes_flips << "位: "
+              << (integer_flips > 31 && integer_flips < 33 && bytes_flips > 31 && bytes_flips < 33 ? "正确" : "错误") << std::endl;
+}
+
+// bucket_test: 连续整数的低7位与高位都接近均匀分布
+void bucket_test()
+{
+    DefaultHasher<int> hasher;
+    std::vector<int> low(128), high(128);
+    for (int i = 0; i != 128 * 1000; ++i){
+        std::uint64_t h = hasher(i);
+        ++low[h & 127];
+        ++high[h >> 57];
+    }
+    bool correct = true;
+    for (int i = 0; i != 128; ++i)
+        correct = correct && low[i] > 850 && low[i] < 1150 && high[i] > 850 && high[i] < 1150;
+    std::cout << "连续整数的低位与高位分布: " << (correct ? "正确" : "错误") << std::endl;
+    DefaultHasher<double> real;
+    std::cout << "+0.0与-0.0: " << (real(0.0) == real(-0.0) && real(1.0) != real(2.0) ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********字符串散列测试********\n";
+    string_test();
+    std::cout << "********雪崩测试********\n";
+    avalanche_test();
+    std::cout << "********分布测试********\n";
+    bucket_test();
+    return 0;
+}
@@ -0,0 +1,352 @@
+/*************************************************************************
+	> File Name: lru_cache.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时20分39秒
+ ************************************************************************/
+
+#ifndef _LRU_CACHE_H
+#define _LRU_CACHE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../hasher/hasher.h"
+
+// LRUCache: 固定容量的最近最少使用(LRU)缓存, 侵入式的链表与散列链放在同一个条目中
+/*
+ * 用CircularList加一个散列表实现LRU缓存时, 每个元素要分配三次: CircularList的shared_ptr节点, 散列表中
+ * std::list的节点, 再加上每个链表make_shared的哨兵nil. LRUCache在构造时一次分配capacity个条目与桶数组,
+ * 每个条目同时是:
+ *      --LRU链表的节点: prev与next是32位下标, head为最近使用的条目, tail为最久没有使用的条目;
+ *      --散列链的节点: chain是同一个桶中下一个条目的下标, 还保存了键的散列值(比较键之前先比较散列值);
+ *      --键与值的存储(只在条目使用中时构造).
+ * 未使用的条目用next串成空闲链表. 桶数是不小于capacity的2的幂, 装载因子不超过1.
+ *
+ *      --get: 查找并把条目移到链表头, O(1);
+ *      --put: 键已存在时更新值并移到链表头; 否则缓存满时先淘汰tail, 再从空闲链表取一个条目, O(1);
+ *      --erase, evict: 从散列链与LRU链表中取下条目, 析构键与值, 放回空闲链表, O(1).
+ * 构造以后不再分配内存(键与值本身的构造可能分配, 例如std::string).
+ * 元素的地址(get返回的指针)在下一次修改缓存之前有效. 不是线程安全的, 多线程使用ShardedLRUCache.
+ *
+ */
+template<typename K, typename V, typename Hasher = DefaultHasher<K>, typename Equal = std::equal_to<K>>
+class LRUCache
+{
+    template<typename, typename, typename, typename> friend class ShardedLRUCache;
+public:
+    typedef K KeyType;
+    typedef V ValueType;
+    typedef std::uint32_t Index;
+    static const Index none = 0xFFFFFFFFu;     // 空下标
+    //****************************构造函数*******************************
+    // capacity为0或不小于2^31时抛出std::invalid_argument
+    explicit LRUCache(std::size_t capacity, const Hasher &h = Hasher(), const Equal &e = Equal())
+        : hasher(h), equal(e), cap(checkCapacity(capacity)), bucketMask(bucketsFor(capacity) - 1),
+          entries(new Entry[capacity]), buckets(new Index[bucketMask + 1]), head(none), tail(none), freeList(0), count(0)
+    {
+        for (std::size_t i = 0; i <= bucketMask; ++i)
+            buckets[i] = none;
+        for (std::size_t i = 0; i != cap; ++i)
+            entries[i].next = i + 1 == cap ? none : static_cast<Index>(i + 1);
+    }
+    LRUCache(const LRUCache &) = delete;
+    LRUCache& operator=(const LRUCache &) = delete;
+    ~LRUCache() { clear(); }
+    //****************************成员函数*******************************
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+
+    // get: 查找key并标记为最近使用, 不存在时返回nullptr
+    V* get(const K &key) { return getHashed(key, hasher(key)); }
+    // get: 查找key并把值复制到value, 标记为最近使用, 不存在时返回false
+    bool get(const K &key, V &value)
+    {
+        V *p = get(key);
+        if (!p)
+            return false;
+        value = *p;
+        return true;
+    }
+    // peek, contains: 查找key, 不改变使用的次序
+    const V* peek(const K &key) const
+    {
+        Index i = find(key, hasher(key));
+        return i == none ? nullptr : &entries[i].get()->second;
+    }
+    bool contains(const K &key) const { return find(key, hasher(key)) != none; }
+    // put: 加入或更新key的值并标记为最近使用, 缓存满时淘汰最久没有使用的元素; 返回是否加入了新的键
+    bool put(const K &key, const V &value) { return putHashed(key, hasher(key), value); }
+    bool put(const K &key, V &&value) { return putHashed(key, hasher(key), std::move(value)); }
+    // erase: 删除key, 不存在时返回false
+    bool erase(const K &key) { return eraseHashed(key, hasher(key)); }
+    // evict: 淘汰最久没有使用的元素(第二个版本把它移动到key与value), 缓存为空时返回false
+    bool evict()
+    {
+        if (tail == none)
+            return false;
+        release(tail);
+        return true;
+    }
+    bool evict(K &key, V &value)
+    {
+        if (tail == none)
+            return false;
+        std::pair<K, V> *item = entries[tail].get();
+        key = std::move(item->first);
+        value = std::move(item->second);
+        release(tail);
+        return true;
+    }
+    // clear: 删除所有元素, O(size)
+    void clear()
+    {
+        while (tail != none)
+            release(tail);
+    }
+    // for_each: 从最近使用到最久没有使用, 对每个元素调用f(key, value)
+    template<typename Function>
+    void for_each(Function f) const
+    {
+        for (Index i = head; i != none; i = entries[i].next)
+            f(entries[i].get()->first, entries[i].get()->second);
+    }
+
+private:
+    //****************************数据结构*******************************
+    struct Entry
+    {
+        std::uint64_t hash;     // 键的散列值
+        Index prev, next;       // LRU链表(未使用时next为空闲链表的链接)
+        Index chain;            // 同一个桶中的下一个条目
+        typename std::aligned_storage<sizeof(std::pair<K, V>), alignof(std::pair<K, V>)>::type item;
+        std::pair<K, V>* get() { return reinterpret_cast<std::pair<K, V> *>(&item); }
+        const std::pair<K, V>* get() const { return reinterpret_cast<const std::pair<K, V> *>(&item); }
+    };
+    Hasher hasher;
+    Equal equal;
+    const std::size_t cap;
+    const std::size_t bucketMask;
+    std::unique_ptr<Entry[]> entries;
+    std::unique_ptr<Index[]> buckets;   // 每个桶的第一个条目
+    Index head;         // 最近使用的条目
+    Index tail;         // 最久没有使用的条目
+    Index freeList;     // 空闲链表的第一个条目
+    std::size_t count;
+
+    static std::size_t checkCapacity(std::size_t capacity)
+    {
+        if (capacity == 0 || capacity >= (std::size_t(1) << 31))
+            throw std::invalid_argument("LRUCache error: invalid capacity!");
+        return capacity;
+    }
+    static std::size_t bucketsFor(std::size_t capacity)
+    {
+        std::size_t n = 1;
+        while (n < capacity)
+            n <<= 1;
+        return n;
+    }
+    std::size_t bucketOf(std::uint64_t h) const { return hashRange(h, bucketMask + 1); }
+    Index find(const K &key, std::uint64_t h) const
+    {
+        for (Index i = buckets[bucketOf(h)]; i != none; i = entries[i].chain)
+            if (entries[i].hash == h && equal(entries[i].get()->first, key))
+                return i;
+        return none;
+    }
+    // unlink, pushFront: 在LRU链表中取下与放到链表头
+    void unlink(Index i)
+    {
+        Entry &e = entries[i];
+        (e.prev == none ? head : entries[e.prev].next) = e.next;
+        (e.next == none ? tail : entries[e.next].prev) = e.prev;
+    }
+    void pushFront(Index i)
+    {
+        Entry &e = entries[i];
+        e.prev = none;
+        e.next = head;
+        (head == none ? tail : entries[head].prev) = i;
+        head = i;
+    }
+    void touch(Index i)
+    {
+        if (i != head){
+            unlink(i);
+            pushFront(i);
+        }
+    }
+    // release: 从散列链与LRU链表中取下条目i, 析构元素, 放回空闲链表
+    void release(Index i)
+    {
+        Entry &e = entries[i];
+        Index *link = &buckets[bucketOf(e.hash)];
+        while (*link != i)
+            link = &entries[*link].chain;
+        *link = e.chain;
+        unlink(i);
+        e.get()->~pair();
+        e.next = freeList;
+        freeList = i;
+        --count;
+    }
+    V* getHashed(const K &key, std::uint64_t h)
+    {
+        Index i = find(key, h);
+        if (i == none)
+            return nullptr;
+        touch(i);
+        return &entries[i].get()->second;
+    }
+    template<typename Value>
+    bool putHashed(const K &key, std::uint64_t h, Value &&value)
+    {
+        Index i = find(key, h);
+        if (i != none){
+            entries[i].get()->second = std::forward<Value>(value);
+            touch(i);
+            return false;
+        }
+        if (count == cap)
+            release(tail);
+        i = freeList;
+        Entry &e = entries[i];
+        ::new (static_cast<void *>(&e.item)) std::pair<K, V>(key, std::forward<Value>(value));
+        freeList = e.next;
+        e.hash = h;
+        Index &bucket = buckets[bucketOf(h)];
+        e.chain = bucket;
+        bucket = i;
+        pushFront(i);
+        ++count;
+        return true;
+    }
+    bool eraseHashed(const K &key, std::uint64_t h)
+    {
+        Index i = find(key, h);
+        if (i == none)
+            return false;
+        release(i);
+        return true;
+    }
+};
+template<typename K, typename V, typename Hasher, typename Equal>
+const typename LRUCache<K, V, Hasher, Equal>::Index LRUCache<K, V, Hasher, Equal>::none;
+
+// ShardedLRUCache: 分片的LRU缓存, 每个分片是一个有自己的锁的LRUCache, 可以由多个线程同时使用
+/*
+ * 键按散列值的低位分到shards个分片中(分片数向上取为2的幂), 每个分片的容量为capacity / shards(向上取整),
+ * 分片内用散列值的高位选桶, 所以同一个分片中的键仍然均匀地分布在各个桶中. 散列值只计算一次.
+ * 不同分片上的操作不互相等待; 每个分片与它的锁在单独的缓存行中.
+ *
+ * 淘汰在每个分片内按LRU进行, 整体上是近似的LRU: 一个分片满时淘汰它最久没有使用的元素,
+ * 即使其它分片中有更久没有使用的元素. 键在分片之间均匀时与容量相同的LRUCache的命中率几乎相同.
+ * get只提供复制值的版本: 返回的指针在释放锁以后可能被其它线程淘汰.
+ *
+ */
+template<typename K, typename V, typename Hasher = DefaultHasher<K>, typename Equal = std::equal_to<K>>
+class ShardedLRUCache
+{
+public:
+    typedef LRUCache<K, V, Hasher, Equal> Cache;
+    //****************************构造函数*******************************
+    explicit ShardedLRUCache(std::size_t capacity, std::size_t shards = 16, const Hasher &h = Hasher(),
+                             const Equal &e = Equal())
+        : hasher(h), mask(roundUp(shards) - 1)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("ShardedLRUCache error: invalid capacity!");
+        std::size_t perShard = (capacity + mask) / (mask + 1);
+        for (std::size_t i = 0; i <= mask; ++i)
+            shardList.emplace_back(new Shard(perShard, h, e));
+    }
+    ShardedLRUCache(const ShardedLRUCache &) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache &) = delete;
+    //****************************成员函数*******************************
+    std::size_t shards() const { return mask + 1; }
+    std::size_t capacity() const { return shards() * shardList[0]->cache.capacity(); }
+    // size: 所有分片的元素个数之和(其它线程同时修改时是近似值)
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (const auto &shard : shardList){
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->cache.size();
+        }
+        return total;
+    }
+    bool empty() const { return size() == 0; }
+
+    bool get(const K &key, V &value)
+    {
+        std::uint64_t h = hasher(key);
+        Shard &shard = shardOf(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        V *p = shard.cache.getHashed(key, h);
+        if (!p)
+            return false;
+        value = *p;
+        return true;
+    }
+    bool contains(const K &key) const
+    {
+        std::uint64_t h = hasher(key);
+        const Shard &shard = const_cast<ShardedLRUCache *>(this)->shardOf(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.find(key, h) != Cache::none;
+    }
+    bool put(const K &key, const V &value) { return putImpl(key, value); }
+    bool put(const K &key, V &&value) { return putImpl(key, std::move(value)); }
+    bool erase(const K &key)
+    {
+        std::uint64_t h = hasher(key);
+        Shard &shard = shardOf(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.eraseHashed(key, h);
+    }
+    void clear()
+    {
+        for (auto &shard : shardList){
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->cache.clear();
+        }
+    }
+
+private:
+    struct Shard
+    {
+        Shard(std::size_t capacity, const Hasher &h, const Equal &e) : cache(capacity, h, e) {  }
+        char padding[64];
+        mutable std::mutex mutex;
+        Cache cache;
+    };
+    Hasher hasher;
+    const std::size_t mask;
+    std::vector<std::unique_ptr<Shard>> shardList;
+
+    static std::size_t roundUp(std::size_t shards)
+    {
+        std::size_t n = 1;
+        while (n < shards)
+            n <<= 1;
+        return n;
+    }
+    Shard& shardOf(std::uint64_t h) { return *shardList[h & mask]; }
+    template<typename Value>
+    bool putImpl(const K &key, Value &&value)
+    {
+        std::uint64_t h = hasher(key);
+        Shard &shard = shardOf(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.putHashed(key, h, std::forward<Value>(value));
+    }
+};
+#endif
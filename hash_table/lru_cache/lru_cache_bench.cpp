@@ -0,0 +1,131 @@
+/*************************************************************************
+	> File Name: lru_cache_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时23分22秒
+ ************************************************************************/
+// LRUCache与std::list加std::unordered_map的LRU缓存对比, 以及分片缓存的多线程吞吐量, 以CSV格式输出
+/*
+ * 用法: ./Bench [容量(默认100000)] [每个线程的操作数(默认2000000)] [最大线程数(默认8)]
+ *      每个操作先get一个随机的键, 未命中时put; 键从[0, 2 * 容量)中均匀随机选取, 命中率约为50%.
+ *      --list_map: std::list<pair>加std::unordered_map<key, iterator>, 每次put分配两次(链表与散列表的节点);
+ *      --LRUCache: 单线程;
+ *      --mutex_LRUCache: 一个互斥锁保护的LRUCache, 线程数从1加倍到最大线程数;
+ *      --ShardedLRUCache: 16个分片, 线程数同上.
+ * 只有一个核时多线程的结果主要是线程切换与锁的代价, 看不出分片的扩展性.
+ *
+ * 输出的每一行: structure,threads,capacity,hit_rate,mops
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "lru_cache.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 命中的值之和, 使编译器不能省略
+
+struct ListMapLRU
+{
+    explicit ListMapLRU(std::size_t c) : capacity(c) { index.reserve(c); }
+    bool get(std::uint64_t key, std::uint64_t &value)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return false;
+        order.splice(order.begin(), order, it->second);
+        value = it->second->second;
+        return true;
+    }
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        if (order.size() == capacity){
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        order.emplace_front(key, value);
+        index[key] = order.begin();
+    }
+    std::size_t capacity;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> order;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> index;
+};
+struct MutexLRU
+{
+    explicit MutexLRU(std::size_t c) : cache(c) {  }
+    bool get(std::uint64_t key, std::uint64_t &value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cache.get(key, value);
+    }
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.put(key, value);
+    }
+    std::mutex mutex;
+    LRUCache<std::uint64_t, std::uint64_t> cache;
+};
+
+// run: threads个线程各做ops次get(未命中时put), 输出命中率与吞吐量
+template<typename Cache>
+void run(const char *structure, Cache &cache, std::size_t capacity, std::size_t ops, unsigned threads)
+{
+    std::vector<std::uint64_t> hits(threads, 0), sums(threads, 0);
+    std::vector<std::thread> workers;
+    auto begin = Clock::now();
+    for (unsigned t = 0; t != threads; ++t)
+        workers.emplace_back([&, t]{
+            std::uint64_t s = 0x9E3779B97F4A7C15ull * (t + 1), value = 0;
+            for (std::size_t i = 0; i != ops; ++i){
+                s ^= s << 13;
+                s ^= s >> 7;
+                s ^= s << 17;
+                std::uint64_t key = s % (2 * capacity);
+                if (cache.get(key, value)){
+                    ++hits[t];
+                    sums[t] += value;
+                }else
+                    cache.put(key, key);
+            }
+        });
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    std::uint64_t hit = 0;
+    for (unsigned t = 0; t != threads; ++t){
+        hit += hits[t];
+        bench_sink += sums[t];
+    }
+    std::cout << structure << ',' << threads << ',' << capacity << ',' << double(hit) / (ops * threads) << ','
+              << ops * threads / seconds / 1e6 << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t capacity = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::size_t ops = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000000;
+    unsigned maxThreads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 8;
+    std::cout << "structure,threads,capacity,hit_rate,mops\n";
+    {
+        ListMapLRU cache(capacity);
+        run("list_map", cache, capacity, ops, 1);
+    }
+    {
+        LRUCache<std::uint64_t, std::uint64_t> cache(capacity);
+        run("LRUCache", cache, capacity, ops, 1);
+    }
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2){
+        MutexLRU locked(capacity);
+        run("mutex_LRUCache", locked, capacity, ops, threads);
+        ShardedLRUCache<std::uint64_t, std::uint64_t> sharded(capacity, 16);
+        run("ShardedLRUCache", sharded, capacity, ops, threads);
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/*************************************************************************
+	> File Name: lru_cache_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时26分05秒
+ ************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "lru_cache.h"
+using std::cout;    using std::endl;
+
+// 统计全局operator new的次数, 检查稳定状态下不分配内存
+std::size_t allocations = 0;
+void* operator new(std::size_t bytes)
+{
+    ++allocations;
+    if (void *p = std::malloc(bytes ? bytes : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// ReferenceLRU: std::list加std::unordered_map的LRU缓存, 作为对照
+struct ReferenceLRU
+{
+    explicit ReferenceLRU(std::size_t c) : capacity(c) {  }
+    bool get(int key, int &value)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return false;
+        order.splice(order.begin(), order, it->second);
+        value = it->second->second;
+        return true;
+    }
+    void put(int key, int value)
+    {
+        auto it = index.find(key);
+        if (it != index.end()){
+            it->second->second = value;
+            order.splice(order.begin(), order, it->second);
+            return;
+        }
+        if (order.size() == capacity){
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        order.emplace_front(key, value);
+        index[key] = order.begin();
+    }
+    bool erase(int key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            return false;
+        order.erase(it->second);
+        index.erase(it);
+        return true;
+    }
+    std::size_t capacity;
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+};
+
+// randomTest: 随机的get, put与erase, 每一步的结果与淘汰的次序与ReferenceLRU相同
+bool randomTest(std::size_t capacity, int range)
+{
+    LRUCache<int, int> cache(capacity);
+    ReferenceLRU reference(capacity);
+    bool correct = true;
+    for (int i = 0; i != 200000 && correct; ++i){
+        int key = static_cast<int>(xorshift() % range), value = static_cast<int>(xorshift() % 1000);
+        int a = -1, b = -1;
+        switch (xorshift() % 8){
+        case 0:
+            correct = cache.erase(key) == reference.erase(key);
+            break;
+        case 1: case 2: case 3:
+            correct = cache.get(key, a) == reference.get(key, b) && a == b;
+            break;
+        default:
+            cache.put(key, value);
+            reference.put(key, value);
+        }
+        correct = correct && cache.size() == reference.order.size();
+    }
+    std::vector<std::pair<int, int>> order;
+    cache.for_each([&order](int key, int value){ order.emplace_back(key, value); });
+    return correct && order == std::vector<std::pair<int, int>>(reference.order.begin(), reference.order.end());
+}
+
+// basicTest: 淘汰最久没有使用的元素, get改变次序而peek不改变, evict与clear
+bool basicTest()
+{
+    LRUCache<std::string, int> cache(3);
+    bool correct = cache.put("a", 1) && cache.put("b", 2) && cache.put("c", 3) && !cache.put("a", 10);
+    // 次序(从最近到最久): a c b; get("c")以后为c a b; peek不改变次序
+    correct = correct && *cache.get("c") == 3 && *cache.peek("b") == 2;
+    cache.put("d", 4);
+    correct = correct && !cache.contains("b") && cache.size() == 3 && *cache.get("a") == 10;
+    std::string key;
+    int value = 0;
+    correct = correct && cache.evict(key, value) && key == "c" && value == 3 && cache.evict() && cache.size() == 1;
+    cache.clear();
+    correct = correct && cache.empty() && !cache.evict() && !cache.get("a") && cache.put("e", 5) && *cache.get("e") == 5;
+    try{
+        LRUCache<int, int> bad(0);
+        correct = false;
+    }catch (const std::invalid_argument &){
+    }
+    return correct;
+}
+
+// allocationTest: 填满以后的get/put/erase不分配内存
+bool allocationTest()
+{
+    LRUCache<int, std::uint64_t> cache(1024);
+    for (int i = 0; i != 1024; ++i)
+        cache.put(i, i);
+    std::size_t before = allocations;
+    std::uint64_t sum = 0, value = 0;
+    for (int i = 0; i != 100000; ++i){
+        int key = static_cast<int>(xorshift() % 4096);
+        if (cache.get(key, value))
+            sum += value;
+        else if (i % 7 == 0)
+            cache.erase(key + 1);
+        else
+            cache.put(key, key);
+    }
+    return allocations == before && sum != 0;
+}
+
+int alive = 0;
+// Tracked: 记录存活的对象个数, 检查淘汰与析构时正确地析构了值
+struct Tracked
+{
+    Tracked(int v = 0) : value(v) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value) { ++alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; return *this; }
+    ~Tracked() { --alive; }
+    int value;
+};
+bool lifetimeTest()
+{
+    {
+        LRUCache<int, Tracked> cache(10);
+        for (int i = 0; i != 100; ++i)
+            cache.put(i, Tracked(i));
+        cache.erase(95);
+        if (alive != 9)
+            return false;
+    }
+    return alive == 0;
+}
+
+// shardedTest: 多个线程同时使用ShardedLRUCache, 值总是键的函数; 容量不超过分片容量之和
+bool shardedTest()
+{
+    ShardedLRUCache<std::uint64_t, std::uint64_t> cache(1000, 8);
+    bool correct = cache.shards() == 8 && cache.capacity() == 1000;
+    std::vector<std::thread> threads;
+    std::vector<int> wrong(4, 0);
+    for (int t = 0; t != 4; ++t)
+        threads.emplace_back([&cache, &wrong, t]{
+            std::uint64_t s = 0x9E3779B97F4A7C15ull * (t + 1), value = 0;
+            for (int i = 0; i != 100000; ++i){
+                s ^= s << 13;
+                s ^= s >> 7;
+                s ^= s << 17;
+                std::uint64_t key = s % 3000;
+                if (cache.get(key, value)){
+                    if (value != key * 3)
+                        ++wrong[t];
+                }else if (s % 16 == 0)
+                    cache.erase(key);
+                else
+                    cache.put(key, key * 3);
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+    for (int w : wrong)
+        correct = correct && w == 0;
+    correct = correct && cache.size() <= cache.capacity() && cache.size() > 0;
+    cache.clear();
+    return correct && cache.empty();
+}
+
+int main()
+{
+    cout << "淘汰, get与peek: " << (basicTest() ? "正确" : "错误") << endl;
+    cout << "随机操作(容量1): " << (randomTest(1, 4) ? "正确" : "错误") << endl;
+    cout << "随机操作(容量100): " << (randomTest(100, 300) ? "正确" : "错误") << endl;
+    cout << "随机操作(容量1000): " << (randomTest(1000, 1500) ? "正确" : "错误") << endl;
+    cout << "稳定状态下不分配内存: " << (allocationTest() ? "正确" : "错误") << endl;
+    cout << "值的析构: " << (lifetimeTest() ? "正确" : "错误") << endl;
+    cout << "分片的并发缓存: " << (shardedTest() ? "正确" : "错误") << endl;
+    return 0;
+}
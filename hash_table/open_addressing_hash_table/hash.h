@@ -8,15 +8,17 @@
 #ifndef _HASH_H
 #define _HASH_H
 #include <iostream>
+#include <utility>
 // 散列表中存储的数据
 template<typename key_type, typename value_type>
 class Hash
 {
 public:
+    typedef key_type KeyType;
     typedef value_type ValueType;   // 指向的数据类型
     //**************************构造函数***********************************
     Hash() = default;   // 默认构造函数
-    Hash(key_type v0, value_type v1): key(v0), value(v1) {  }
+    Hash(key_type v0, value_type v1): key(std::move(v0)), value(std::move(v1)) {  }
     ~Hash() = default;
     friend bool operator==(const Hash &hash1, const Hash &hash2)
     {
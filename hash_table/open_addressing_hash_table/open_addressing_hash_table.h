@@ -8,13 +8,31 @@
 #ifndef _OPEN_ADDRESSING_HASH_TABLE_H
 #define _OPEN_ADDRESSING_HASH_TABLE_H
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include "../hasher/hasher.h"
+#include "../hash_stats/hash_stats.h"
 // HashTable: 开放寻址法实现散列 算法导论11.4
 /*
  * 开放寻址法的好处就在于它不用指针,而是计算出要存取的槽序列.于是,不用存储
  * 指针而节省的空间,使得可以用同样的空间来提供更多的槽,潜在的减少了冲突,提高了
  * 检索速度.
+ *
+ * Hasher把元素映射为64位散列值(默认只散列键, 见hasher.h), 每次操作只计算一次, 探查序列都由它得到;
+ * CacheHash为true时每个槽同时保存完整的散列值, 探查时先比较散列值, 相等时才调用operator==.
+ *
+ * 按键访问: insert/search/hash_delete比较整个元素(键与值), find/emplace/try_emplace只比较键.
+ * find的参数可以是与键类型不同但可以比较相等的类型(例如键为std::string时的const char *), 不构造键对象,
+ * 这要求Hasher提供key(k)(见hasher.h的KeyHasher). find_many批量查找, 先预取一批键的第一个探查位置, 再逐个探查.
+ *
+ * Alloc: 三个数组的分配器(例如ResourceAllocator<HashedObj>, 见tree_algorithm/NodeArena/MemoryResource.h).
 */
-template<typename HashedObj>
+template<typename HashedObj, typename Hasher = KeyHasher<HashedObj>, bool CacheHash = false,
+         typename Alloc = std::allocator<HashedObj>>
 class HashTable
 {
 public:
@@ -24,46 +42,79 @@ public:
         DELETE = 1,     // 被删除的
         FULL = 2,       // 有元素的
     };
+    typedef typename HashedObj::KeyType KeyType;
+    typedef typename HashedObj::ValueType ValueType;
     //***************************构造函数*********************************
     // 构造函数
-    HashTable(std::size_t num = 101): size(0){hashData.resize(num); status.resize(num);}
+    HashTable(std::size_t num = 101, const Hasher &h = Hasher(), const Alloc &alloc = Alloc())
+        : hasher(h), hashData(num, HashedObj(), DataAlloc(alloc)), hashes(CacheHash ? num : 0, 0, HashAlloc(alloc)),
+          size(0), status(num, EMPTY, StatusAlloc(alloc)) {}
     ~HashTable() = default;     // 析构函数
     //***************************成员函数*********************************
     bool insert(const HashedObj &);     // 向散列表中插入一个元素
     bool search(const HashedObj &);     // 向散列表中查找一个元素
     bool hash_delete(const HashedObj &);    // 向散列表中删除一个元素
     void hash_clear();  // 清空散列表
+    // stats: 统计信息(见hash_stats.h), 探查长度为访问过的槽数
+    HashTableStats stats() const;
+    void resetStats() { counters.resetCounters(); }
+    Alloc get_allocator() const { return Alloc(hashData.get_allocator()); }
+    // find: 键等于key的元素的值, 不存在时为nullptr
+    template<typename K>
+    ValueType* find(const K &key);
+    template<typename K>
+    const ValueType* find(const K &key) const;
+    // find_many: 批量查找, out[i] = find(keys[i])
+    template<typename K>
+    void find_many(const K *keys, std::size_t n, const ValueType **out) const;
+    template<typename K>
+    void find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const;
+    // emplace: 用args构造元素, 没有键相同的元素时插入; 返回键相同的元素的值与是否插入(表满时值为nullptr)
+    template<typename... Args>
+    std::pair<ValueType*, bool> emplace(Args&&... args);
+    // try_emplace: 没有键为key的元素时插入(key, ValueType(args...)), 已经存在时不构造任何对象
+    template<typename K, typename... Args>
+    std::pair<ValueType*, bool> try_emplace(K &&key, Args&&... args);
 private:
     //***************************数据成员*********************************
-    std::vector<HashedObj> hashData;    // 散列表的数组
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<HashedObj> DataAlloc;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::uint64_t> HashAlloc;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<ELE_STATUS> StatusAlloc;
+    Hasher hasher;
+    std::vector<HashedObj, DataAlloc> hashData;     // 散列表的数组
+    std::vector<std::uint64_t, HashAlloc> hashes;   // CacheHash为true时保存每个槽中元素的散列值, 否则为空
     std::size_t size;   // 散列表中存储数据的数量
-    std::vector<ELE_STATUS> status;     // 用于存放各个位置的状态信息
+    std::vector<ELE_STATUS, StatusAlloc> status;    // 用于存放各个位置的状态信息
+    HashStatsCounters counters;         // 运行时计数(定义HASH_TABLE_STATS时)
     //*************************私有成员函数*******************************
-    std::size_t hash(const HashedObj &);  // 辅助散列函数(除法散列函数)
-    std::size_t hash2(const HashedObj &);   // 双重散列函数的辅助函数
-    std::size_t linear_probing(const HashedObj &, std::size_t);    // 线性探查
-    std::size_t quadratic_probing(const HashedObj &, std::size_t);  // 二次探查
-    std::size_t double_hashing(const HashedObj &, std::size_t);     // 双重散列
+    std::size_t hash(std::uint64_t) const;  // 辅助散列函数(除法散列函数)
+    std::size_t hash2(std::uint64_t) const;   // 双重散列函数的辅助函数
+    std::size_t linear_probing(std::uint64_t, std::size_t) const;    // 线性探查
+    std::size_t quadratic_probing(std::uint64_t, std::size_t) const;  // 二次探查
+    std::size_t double_hashing(std::uint64_t, std::size_t) const;     // 双重散列
+    bool matches(std::size_t, const HashedObj &, std::uint64_t) const;    // 槽中的元素是否与给定元素相等
+    template<typename K>
+    std::size_t locate(const K &, std::uint64_t) const;     // 键等于给定键的槽, 不存在时为hashData.size()
+    template<typename K>
+    std::pair<std::size_t, bool> probe(const K &, std::uint64_t) const;     // 按键插入时的探查
+    std::pair<ValueType*, bool> store(std::size_t, HashedObj &&, std::uint64_t);    // 把元素放入空闲的槽
 };
 // hash: 辅助散列函数(除法散列函数)
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::hash(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::hash(std::uint64_t hashValue) const
 {
-    std::size_t index = hashed.getIndex();
-    index = index % hashData.size();
-    return index;
+    return static_cast<std::size_t>(hashValue % hashData.size());
 }
 // hash2: 双重散列函数的辅助函数
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::hash2(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::hash2(std::uint64_t hashValue) const
 {
-    std::size_t index = hashed.getIndex();
-    index = index % (hashData.size() - 1) + 1;
-    return index;
+    // 用散列值的高32位, 使h2与h1尽量独立
+    return static_cast<std::size_t>((hashValue >> 32) % (hashData.size() - 1) + 1);
 }
 // linear_probing: 线性探查
 /*
- * \parameter hashed: hash table存储的数据类型;
+ * \parameter hashValue: 元素的散列值;
  * \parameter offset: 线性探查公式中的i;
  * \return 返回线性探查结果的下标.
  * 算法思想: h(k,i) = (h(k) + i) mod m, i = 0,1,2,...,m-1
@@ -71,28 +122,28 @@ std::size_t HashTable<HashedObj>::hash2(const HashedObj &hashed)
  * 查找时间也随之不断增加.群集现象很容易出现,这是因为当一个空槽前有i个满的槽时,该空槽为下一个被
  * 占用的概率为(i+1)/m.连续被占用的槽就会变得越来越长,因而平均查找时间也会越来越大.
 */
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::linear_probing(const HashedObj &hashed, std::size_t offset)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::linear_probing(std::uint64_t hashValue, std::size_t offset) const
 {
-    return (hash(hashed) + offset) % hashData.size();
+    return (hash(hashValue) + offset) % hashData.size();
 }
 // quadratic_probing: 二次探查
 /*
- * \parameter hashed: hash table存储的数据类型;
+ * \parameter hashValue: 元素的散列值;
  * \parameter offset: 二次查探函数中的i;
  * \return 返回二次查探结果的下标.
  * 算法思想: h(k,i) = (h(k) + c1*i + c2*i*i) mod m, i = 0,1,2,...,m-1
  * 二次查探的性质比线性查探的性质好很多,但是h(k1,0) = h(k2,0)蕴含着h(k1,i) = h(k2,i).
  * 这一性质可导致一种轻度的群集,称为二次群集.
 */
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::quadratic_probing(const HashedObj &hashed, std::size_t offset)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::quadratic_probing(std::uint64_t hashValue, std::size_t offset) const
 {
-    return (hash(hashed) + offset + offset * offset) % hashData.size();
+    return (hash(hashValue) + offset + offset * offset) % hashData.size();
 }
 // double_hashing: 双重散列
 /*
- * \parameter hashed: hash table存储的数据类型;
+ * \parameter hashValue: 元素的散列值;
  * \parameter offset: 双重查探函数中的i;
  * \return 返回双重查探结果的下标.
  * 算法思想: h(k,i) = (h1(k) + i*h2(k)) mod m; i = 0,1,2,3,...,m-1.
@@ -104,13 +155,88 @@ std::size_t HashTable<HashedObj>::quadratic_probing(const HashedObj &hashed, std
  *   --例如,我们可以取m为素数,并取h1(k) = k mod m, h2(k) = 1 + (k mod m')
  *     其中m'略小于m(比如,m-1).
 */
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::double_hashing(const HashedObj &hashed, std::size_t offset)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::double_hashing(std::uint64_t hashValue, std::size_t offset) const
 {
-    std::size_t index0 = hash(hashed);
-    std::size_t index1 = hash2(hashed);
+    std::size_t index0 = hash(hashValue);
+    std::size_t index1 = hash2(hashValue);
     return (index0 + offset * index1) % hashData.size();
 }
+// matches: 槽index中的元素是否与hashed相等(保存了散列值时先比较散列值)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, Alloc>::matches(std::size_t index, const HashedObj &hashed, std::uint64_t hashValue) const
+{
+    return (!CacheHash || hashes[index] == hashValue) && hashData[index] == hashed;
+}
+
+// locate: 键等于key的元素所在的槽
+/*
+ * \parameter key: 待查找的键;
+ * \parameter hashValue: 键的散列值;
+ * \return 槽的下标, 不存在时为hashData.size().
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+std::size_t HashTable<HashedObj, Hasher, CacheHash, Alloc>::locate(const K &key, std::uint64_t hashValue) const
+{
+    std::size_t i = 0;
+    for (; i != hashData.size(); ++i){
+        std::size_t index = double_hashing(hashValue, i);
+        if (status[index] == EMPTY){
+            ++i;
+            break;
+        }
+        if (status[index] == FULL && (!CacheHash || hashes[index] == hashValue) && hashData[index].key == key){
+            counters.recordHit(i + 1);
+            return index;
+        }
+    }
+    counters.recordMiss(i);
+    return hashData.size();
+}
+// probe: 按键插入时的探查
+/*
+ * \parameter key: 元素的键;
+ * \parameter hashValue: 键的散列值;
+ * \return 键已经存在时为(所在的槽, true); 否则为(探查序列上第一个不是FULL的槽, false), 表满时槽为hashData.size().
+ * 要探查到空槽为止才能确认键不存在(被删除的槽之后可能还有键相同的元素).
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+std::pair<std::size_t, bool> HashTable<HashedObj, Hasher, CacheHash, Alloc>::probe(const K &key, std::uint64_t hashValue) const
+{
+    std::size_t free = hashData.size();
+    std::size_t i = 0;
+    for (; i != hashData.size(); ++i){
+        std::size_t index = double_hashing(hashValue, i);
+        if (status[index] != FULL){
+            if (free == hashData.size())
+                free = index;
+            if (status[index] == EMPTY){
+                ++i;
+                break;
+            }
+        }
+        else if ((!CacheHash || hashes[index] == hashValue) && hashData[index].key == key){
+            counters.recordHit(i + 1);
+            return std::make_pair(index, true);
+        }
+    }
+    counters.recordMiss(i);
+    return std::make_pair(free, false);
+}
+// store: 把x移动到空闲的槽index中
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+std::pair<typename HashedObj::ValueType*, bool>
+HashTable<HashedObj, Hasher, CacheHash, Alloc>::store(std::size_t index, HashedObj &&x, std::uint64_t hashValue)
+{
+    hashData[index] = std::move(x);
+    if (CacheHash)
+        hashes[index] = hashValue;
+    status[index] = FULL;
+    ++size;
+    return std::make_pair(&hashData[index].value, true);
+}
 
 //*******************************函数接口*********************************
 // insert: 插入操作
@@ -118,20 +244,23 @@ std::size_t HashTable<HashedObj>::double_hashing(const HashedObj &hashed, std::s
  * \parameter hash: 待插入的元素;
  * \return 返回插入是否成功的标志.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::insert(const HashedObj &hash)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, Alloc>::insert(const HashedObj &hash)
 {
     if (size >= hashData.size()){
         std::cerr << "hash table overflow!" << std::endl;;
         return false;
     }
+    std::uint64_t hashValue = hasher(hash);
     std::size_t i = 0;
     while (i != hashData.size()){
-        //std::size_t index = linear_probing(hash, i);
-        //std::size_t index = quadratic_probing(hash, i);
-        std::size_t index = double_hashing(hash, i);
+        //std::size_t index = linear_probing(hashValue, i);
+        //std::size_t index = quadratic_probing(hashValue, i);
+        std::size_t index = double_hashing(hashValue, i);
         if (status[index] != FULL){
             hashData[index] = hash;
+            if (CacheHash)
+                hashes[index] = hashValue;
             status[index] = FULL;
             ++size;
             return true;
@@ -146,22 +275,28 @@ bool HashTable<HashedObj>::insert(const HashedObj &hash)
  * \parameter hashed: 待查找的元素;
  * \return 返回查找是否成功的标志.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::search(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, Alloc>::search(const HashedObj &hashed)
 {
+    std::uint64_t hashValue = hasher(hashed);
     std::size_t i = 0;
     while (i != hashData.size()){
-        //std::size_t index = linear_probing(hashed, i);
-        //std::size_t index = quadratic_probing(hashed, i);
-        std::size_t index = double_hashing(hashed, i);
-        if (status[index] == EMPTY)
+        //std::size_t index = linear_probing(hashValue, i);
+        //std::size_t index = quadratic_probing(hashValue, i);
+        std::size_t index = double_hashing(hashValue, i);
+        if (status[index] == EMPTY){
+            counters.recordMiss(i + 1);
             return false;
+        }
         else if (status[index] == FULL){
-            if (hashData[index] == hashed)
+            if (matches(index, hashed, hashValue)){
+                counters.recordHit(i + 1);
                 return true;
+            }
         }
         ++i;
     }
+    counters.recordMiss(i);
     return false;
 }
 // hash_delete: 删除操作
@@ -169,36 +304,164 @@ bool HashTable<HashedObj>::search(const HashedObj &hashed)
  * \parameter hashed: 待删除的元素;
  * \return 删除是否成功的标志.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::hash_delete(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+bool HashTable<HashedObj, Hasher, CacheHash, Alloc>::hash_delete(const HashedObj &hashed)
 {
+    std::uint64_t hashValue = hasher(hashed);
     std::size_t i = 0;
     while (i != hashData.size()){
-        //std::size_t index = linear_probing(hashed, i);
-        //std::size_t index = quadratic_probing(hashed, i);
-        std:;size_t index = double_hashing(hashed, i);
-        if (status[index] == EMPTY)
+        //std::size_t index = linear_probing(hashValue, i);
+        //std::size_t index = quadratic_probing(hashValue, i);
+        std::size_t index = double_hashing(hashValue, i);
+        if (status[index] == EMPTY){
+            counters.recordMiss(i + 1);
             return false;
+        }
         else if (status[index] == FULL){
-            if (hashData[index] == hashed){
+            if (matches(index, hashed, hashValue)){
+                counters.recordHit(i + 1);
                 status[index] = DELETE;
-                return true;
                 --size;
+                return true;
             }
         }
         ++i;
     }
+    counters.recordMiss(i);
     return false;
 }
 // hash_clear: 清空散列表
 /*
  * 只需对状态数组修改就行.
 */
-template<typename HashedObj>
-void HashTable<HashedObj>::hash_clear()
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+void HashTable<HashedObj, Hasher, CacheHash, Alloc>::hash_clear()
 {
     size = 0;
     for (auto &i : status)
         i = EMPTY;
 }
+// stats: 统计信息.
+/*
+ * \return 结构统计与运行时计数.
+ * 现有元素的探查长度: 按它的散列值重新探查, 到达它所在的槽时访问过的槽数(删除标记会使后面的元素探查得更长).
+ * 开放寻址散列表的大小固定, 没有再散列.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+HashTableStats HashTable<HashedObj, Hasher, CacheHash, Alloc>::stats() const
+{
+    HashTableStats result;
+    result.size = size;
+    result.capacity = hashData.size();
+    for (std::size_t index = 0; index != hashData.size(); ++index){
+        if (status[index] == DELETE)
+            ++result.tombstones;
+        if (status[index] != FULL)
+            continue;
+        std::uint64_t hashValue = CacheHash ? hashes[index] : hasher(hashData[index]);
+        std::size_t length = 1;
+        while (double_hashing(hashValue, length - 1) != index)
+            ++length;
+        result.stored.add(length);
+        result.longestChain = std::max(result.longestChain, length);
+    }
+    counters.exportTo(result);
+    return result;
+}
+// find: 按键查找.
+/*
+ * \parameter key: 键, 或者可以与键比较相等且Hasher::key可以散列的其它类型;
+ * \return 键等于key的元素的值, 不存在时为nullptr.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+const typename HashedObj::ValueType* HashTable<HashedObj, Hasher, CacheHash, Alloc>::find(const K &key) const
+{
+    std::size_t index = locate(key, hasher.key(key));
+    return index == hashData.size() ? nullptr : &hashData[index].value;
+}
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+typename HashedObj::ValueType* HashTable<HashedObj, Hasher, CacheHash, Alloc>::find(const K &key)
+{
+    return const_cast<ValueType*>(static_cast<const HashTable&>(*this).find(key));
+}
+// find_many: 批量查找.
+/*
+ * \parameter keys: n个待查找的键;
+ * \parameter out: 结果, out[i]为键等于keys[i]的元素的值, 不存在时为nullptr.
+ * 每批hash_lookup_batch个键, 先计算散列值并预取第一个探查位置的状态与元素, 再逐个探查.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, CacheHash, Alloc>::find_many(const K *keys, std::size_t n, const ValueType **out) const
+{
+    if (hashData.empty()){
+        std::fill(out, out + n, nullptr);
+        return;
+    }
+    std::uint64_t hashValues[hash_lookup_batch];
+    for (std::size_t low = 0; low < n; low += hash_lookup_batch){
+        std::size_t count = std::min(hash_lookup_batch, n - low);
+        for (std::size_t i = 0; i != count; ++i){
+            hashValues[i] = hasher.key(keys[low + i]);
+            std::size_t index = hash(hashValues[i]);
+            hashPrefetch(&status[index]);
+            hashPrefetch(&hashData[index]);
+        }
+        for (std::size_t i = 0; i != count; ++i){
+            std::size_t index = locate(keys[low + i], hashValues[i]);
+            out[low + i] = index == hashData.size() ? nullptr : &hashData[index].value;
+        }
+    }
+}
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, CacheHash, Alloc>::find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const
+{
+    out.resize(keys.size());
+    find_many(keys.data(), keys.size(), out.data());
+}
+// emplace: 原地构造元素并按键插入.
+/*
+ * \parameter args: HashedObj的构造函数的参数;
+ * \return 键相同的元素的值与是否插入了新元素, 表满时为(nullptr, false).
+ * 与insert不同, 只要已经有键相同的元素(不论值是否相同)就不插入; 构造出的元素移动进槽中.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, CacheHash, Alloc>::emplace(Args&&... args)
+{
+    HashedObj x(std::forward<Args>(args)...);
+    std::uint64_t hashValue = hasher(x);
+    std::pair<std::size_t, bool> slot = probe(x.key, hashValue);
+    if (slot.second)
+        return std::make_pair(&hashData[slot.first].value, false);
+    if (slot.first == hashData.size()){
+        std::cerr << "hash table overflow!" << std::endl;
+        return std::make_pair(static_cast<ValueType*>(nullptr), false);
+    }
+    return store(slot.first, std::move(x), hashValue);
+}
+// try_emplace: 键不存在时插入.
+/*
+ * \parameter key: 键, 或者可以构造键并与键比较相等的其它类型;
+ * \parameter args: ValueType的构造函数的参数;
+ * \return 键相同的元素的值与是否插入了新元素, 表满时为(nullptr, false).
+ * 先用key查找, 键已经存在时不构造键, 值与元素.
+*/
+template<typename HashedObj, typename Hasher, bool CacheHash, typename Alloc>
+template<typename K, typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, CacheHash, Alloc>::try_emplace(K &&key, Args&&... args)
+{
+    std::uint64_t hashValue = hasher.key(key);
+    std::pair<std::size_t, bool> slot = probe(key, hashValue);
+    if (slot.second)
+        return std::make_pair(&hashData[slot.first].value, false);
+    if (slot.first == hashData.size()){
+        std::cerr << "hash table overflow!" << std::endl;
+        return std::make_pair(static_cast<ValueType*>(nullptr), false);
+    }
+    return store(slot.first, HashedObj(KeyType(std::forward<K>(key)), ValueType(std::forward<Args>(args)...)), hashValue);
+}
 #endif
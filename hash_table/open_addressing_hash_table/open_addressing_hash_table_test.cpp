@@ -6,8 +6,10 @@
  ************************************************************************/
 #include <iostream>
 #include <string>
+#include <vector>
 #include "hash.h"
 #include "open_addressing_hash_table.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 typedef Hash<std::string, int> IHash;
 typedef HashTable<Hash<std::string, int>> Hashtable;
 
@@ -78,6 +80,82 @@ void hash_delete_test()
               << hashTable.search({"ss",987}) << std::endl;
 }
 
+// hasher_test: 保存散列值时插入,查找,删除都正确; 字母相同的字符串(getIndex()相同)都能区分
+void hasher_test()
+{
+    HashTable<IHash, KeyHasher<IHash>, true> cached(1009);
+    const char *words[] = {"listen", "silent", "enlist", "tinsel", "inlets"};
+    bool correct = true;
+    for (int i = 0; i != 5; ++i)
+        correct = cached.insert({words[i], i}) && correct;
+    for (int i = 0; i != 900; ++i)
+        correct = cached.insert({"key" + std::to_string(i), i}) && correct;
+    for (int i = 0; i != 5; ++i)
+        correct = correct && cached.search({words[i], i}) && !cached.search({words[i], i + 1});
+    for (int i = 0; i < 900; i += 3)
+        correct = correct && cached.hash_delete({"key" + std::to_string(i), i}) && !cached.search({"key" + std::to_string(i), i});
+    for (int i = 0; i != 900; ++i)
+        correct = correct && cached.search({"key" + std::to_string(i), i}) == (i % 3 != 0);
+    std::cout << "保存散列值: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// find_test: 按键查找(const char *直接查找, 不构造std::string), emplace/try_emplace与批量查找
+void find_test()
+{
+    HashTable<IHash, KeyHasher<IHash>, true> hashTable(2003);
+    bool correct = hashTable.find("cat") == nullptr;
+    auto result = hashTable.try_emplace("cat", 1234);
+    correct = correct && result.second && *result.first == 1234;
+    correct = correct && !hashTable.try_emplace(std::string("cat"), 1).second && !hashTable.emplace("cat", 2).second;
+    *hashTable.find("cat") = 9;
+    correct = correct && hashTable.search({"cat", 9});
+    std::vector<std::string> keys;
+    for (int i = 0; i != 1000; ++i){
+        hashTable.emplace("key" + std::to_string(i), i);
+        keys.push_back("key" + std::to_string(2 * i));
+    }
+    // 删除以后留下的DELETE槽不影响按键插入时判断键是否存在
+    for (int i = 0; i < 1000; i += 2)
+        hashTable.hash_delete({"key" + std::to_string(i), i});
+    for (int i = 1; i < 1000; i += 2)
+        correct = correct && !hashTable.try_emplace("key" + std::to_string(i), 0).second;
+    std::vector<const int *> values;
+    hashTable.find_many(keys, values);
+    for (int i = 0; i != 1000; ++i)
+        correct = correct && values[i] == hashTable.find(keys[i]) && values[i] == nullptr;
+    correct = correct && *hashTable.find("key999") == 999;
+    std::cout << "按键查找与批量查找: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// stats_test: 结构统计(没有定义HASH_TABLE_STATS, 运行时计数关闭)
+void stats_test()
+{
+    Hashtable hashTable(211);
+    for (int i = 0; i != 100; ++i)
+        hashTable.insert({"key" + std::to_string(i), i});
+    for (int i = 0; i != 10; ++i)
+        hashTable.hash_delete({"key" + std::to_string(i), i});
+    HashTableStats stats = hashTable.stats();
+    bool correct = stats.size == 90 && stats.capacity == 211 && stats.tombstones == 10 && stats.stored.total == 90;
+    correct = correct && stats.longestChain == stats.stored.max && stats.stored.counts[0] == 0 && !stats.counting;
+    std::cout << "统计信息: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// resource_test: 三个数组都从调用者提供的缓冲区分配
+void resource_test()
+{
+    alignas(std::max_align_t) static char buffer[200000];
+    MonotonicBufferResource arena(buffer, sizeof(buffer));
+    HashTable<IHash, KeyHasher<IHash>, true, ResourceAllocator<IHash>> hashTable(2003, KeyHasher<IHash>(), &arena);
+    bool correct = arena.bytesAllocated() >= 2003 * (sizeof(IHash) + sizeof(std::uint64_t)) && arena.chunkCount() == 0;
+    for (int i = 0; i != 1000; ++i)
+        correct = hashTable.insert({"key" + std::to_string(i), i}) && correct;
+    for (int i = 0; i != 1000; ++i)
+        correct = correct && hashTable.search({"key" + std::to_string(i), i}) && *hashTable.find("key" + std::to_string(i)) == i;
+    correct = correct && hashTable.get_allocator().resource() == &arena;
+    std::cout << "从MemoryResource分配: " << (correct ? "正确" : "错误") << std::endl;
+}
+
 int main()
 {
     std::cout << "********hash table的insert测试********\n";
@@ -86,6 +164,14 @@ int main()
     search_test();
     std::cout << "********hash table的hash_delete测试********\n";
     hash_delete_test();
+    std::cout << "********hash table的散列函数测试********\n";
+    hasher_test();
+    std::cout << "********hash table的find测试********\n";
+    find_test();
+    std::cout << "********hash table的MemoryResource测试********\n";
+    resource_test();
+    std::cout << "********hash table的统计信息测试********\n";
+    stats_test();
 
     return 0;
 }
@@ -0,0 +1,354 @@
+/*************************************************************************
+	> File Name: minimal_perfect_hash.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时12分30秒
+ ************************************************************************/
+
+#ifndef _MINIMAL_PERFECT_HASH_H
+#define _MINIMAL_PERFECT_HASH_H
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../hasher/hasher.h"
+#include "../../parallel_algorithm/thread_pool/threadPool.h"
+
+const std::uint64_t mph_magic = 0x31304850484d5a5aull;                 // "ZZMHPH01"
+const std::uint64_t mph_version = 1;
+const std::uint64_t mph_default_seed = 0x9e3779b97f4a7c15ull;
+const double mph_bucket_size = 5.0;                                     // 每个桶的平均键数
+const double mph_load = 0.99;                                           // 每个分区的位置数为键数 / mph_load
+const std::size_t mph_partition_keys = std::size_t(1) << 16;           // 每个分区的平均键数
+const std::uint64_t mph_max_pilot = std::uint64_t(1) << 20;            // 超过时换一个种子重建这个分区
+const std::size_t mph_header_words = 8;
+const std::size_t mph_partition_words = 8;
+
+// MinimalPerfectHash: 固定键集合的最小完全散列函数(PTHash/CHD风格), 把n个互不相同的键一一映射到[0, n)
+/*
+ * 只保存散列函数本身, 不保存键: 对集合之外的键返回[0, n)中的某个值, 需要判断成员时由调用者在结果位置保存键并比较.
+ *
+ * 算法基本思想:
+ *      --键按散列值的高位均匀分到若干个分区(平均mph_partition_keys个键), 各个分区互不依赖, 多线程并行建立;
+ *      --每个分区有n_p个键, m_p = n_p / mph_load个位置, 键再分到n_p / mph_bucket_size个桶中. 按桶从大到小的次序,
+ *        为每个桶寻找最小的pilot p, 使桶中每个键的位置 hashRange((h ^ hashInteger(p ^ c)) * c', m_p) 互不相同且都没有被占用
+ *        (乘以奇数c'使结果的高位与h的所有位有关; 只做异或时m_p很小的分区只有m_p种不同的排列, 可能找不到pilot);
+ *        大的桶先放, 这时空位还多, 最后是只有一个键的桶, 空位少但是每次尝试只需要找到一个空位;
+ *      --位置在[n_p, m_p)中的键再映射到[0, n_p)中剩下的空位(free表), 于是结果是最小的: 恰好为[0, n);
+ *      --pilot用固定宽度的位数组保存, 连同free表平均每个键不到4位(键越多pilot的位宽越大).
+ * 查询: 计算一次散列值, 读一个分区记录, 一个pilot, 偶尔读一次free表, 都是O(1).
+ *
+ * 映像: 建立结果是一个连续的64位整数数组, save把它原样写入文件, load用mmap映射文件, 不需要重新建立或解析,
+ * 启动只需要几毫秒(页在第一次访问时才读入). 映像的布局:
+ *      --[0, 8): 文件头: magic, version, 键数n, 分区数P, pilot的位宽, 总字数, free表的起始字, 0;
+ *      --[8, 8 + 8P): 每个分区8个字: 起始编号, n_p, m_p, 桶数, 种子, pilot的起始位, free表的起始下标, 0;
+ *      --pilot位数组, 末尾多一个字; 之后是32位的free表.
+ * 映像与机器的字节序有关, 也与Hasher有关: 加载时必须使用与建立时相同的Hasher.
+ *
+ */
+template<typename Key, typename Hasher = DefaultHasher<Key>>
+class MinimalPerfectHash
+{
+public:
+    //****************************构造函数*******************************
+    // 建立: keys必须互不相同(否则抛出std::invalid_argument), threads为参与建立的线程数(包括调用线程)
+    explicit MinimalPerfectHash(const std::vector<Key> &keys, std::size_t threads = WorkStealingPool::defaultThreads(),
+                                std::uint64_t seed = mph_default_seed, const Hasher &h = Hasher())
+        : hasher(h), address(nullptr), length(0)
+    {
+        build(keys, threads, seed);
+    }
+    MinimalPerfectHash(const MinimalPerfectHash &) = delete;
+    MinimalPerfectHash& operator=(const MinimalPerfectHash &) = delete;
+    MinimalPerfectHash(MinimalPerfectHash &&other)
+        : hasher(other.hasher), image(std::move(other.image)), address(other.address), length(other.length), words(other.words)
+    {
+        other.address = nullptr;
+        other.length = 0;
+    }
+    ~MinimalPerfectHash()
+    {
+        if (address != nullptr)
+            ::munmap(address, length);
+    }
+
+    // load: 用mmap映射save写入的映像文件, 格式不对时抛出std::runtime_error
+    static MinimalPerfectHash load(const std::string &filename, const Hasher &h = Hasher())
+    {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        struct stat status;
+        if (fd < 0 || ::fstat(fd, &status) != 0){
+            if (fd >= 0)
+                ::close(fd);
+            throw std::runtime_error("MinimalPerfectHash error: 无法打开文件 " + filename);
+        }
+        std::size_t bytes = static_cast<std::size_t>(status.st_size);
+        void *p = bytes >= mph_header_words * 8 ? ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (p == MAP_FAILED)
+            throw std::runtime_error("MinimalPerfectHash error: mmap失败 " + filename);
+        const std::uint64_t *w = static_cast<const std::uint64_t *>(p);
+        if (w[0] != mph_magic || w[1] != mph_version || w[5] * 8 != bytes){
+            ::munmap(p, bytes);
+            throw std::runtime_error("MinimalPerfectHash error: 不是最小完全散列映像 " + filename);
+        }
+        return MinimalPerfectHash(h, p, bytes);
+    }
+    //****************************成员函数*******************************
+    // operator(): 键的编号, 在[0, size())中
+    std::uint64_t operator()(const Key &key) const
+    {
+        if (words[2] == 0)
+            return 0;
+        std::uint64_t h = hasher(key);
+        const std::uint64_t *part = words + mph_header_words + mph_partition_words * hashRange(h, words[3]);
+        std::uint64_t hb = hashInteger(h ^ part[4]);
+        std::uint64_t pilot = readPilot(part[5] + hashRange(hb, part[3]) * words[4]);
+        std::uint64_t position = slotOf(hashInteger(hb), pilotHash(pilot), part[2]);
+        if (position >= part[1])
+            position = freeTable()[part[6] + position - part[1]];
+        return part[0] + position;
+    }
+    std::size_t size() const { return static_cast<std::size_t>(words[2]); }
+    // imageBytes: 映像的字节数(内存或文件)
+    std::size_t imageBytes() const { return static_cast<std::size_t>(words[5] * 8); }
+    double bitsPerKey() const { return words[2] == 0 ? 0 : 8.0 * imageBytes() / words[2]; }
+
+    // save: 把映像写入文件, 失败时抛出std::runtime_error
+    void save(const std::string &filename) const
+    {
+        int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("MinimalPerfectHash error: 无法创建文件 " + filename);
+        const char *data = reinterpret_cast<const char *>(words);
+        std::size_t done = 0, bytes = imageBytes();
+        while (done != bytes){
+            ssize_t n = ::write(fd, data + done, bytes - done);
+            if (n <= 0)
+                break;
+            done += static_cast<std::size_t>(n);
+        }
+        if ((::close(fd) != 0) || done != bytes)
+            throw std::runtime_error("MinimalPerfectHash error: 写文件失败 " + filename);
+    }
+private:
+    //****************************数据结构*******************************
+    // Partition: 建立过程中一个分区的结果
+    struct Partition
+    {
+        std::uint64_t size, table, buckets, seed;
+        std::vector<std::uint32_t> pilots;
+        std::vector<std::uint32_t> free;
+    };
+    Hasher hasher;
+    std::vector<std::uint64_t> image;   // 建立的映像(从文件加载时为空)
+    void *address;                      // 从文件加载时映射的地址
+    std::size_t length;
+    const std::uint64_t *words;         // 映像的起始位置
+
+    MinimalPerfectHash(const Hasher &h, void *p, std::size_t bytes)
+        : hasher(h), address(p), length(bytes), words(static_cast<const std::uint64_t *>(p)) {  }
+
+    static std::uint64_t pilotHash(std::uint64_t pilot) { return hashInteger(pilot ^ hash_prime0); }
+    // slotOf: 位置散列值为h的键在pilot散列值为ph时的位置
+    static std::uint64_t slotOf(std::uint64_t h, std::uint64_t ph, std::uint64_t table) { return hashRange((h ^ ph) * hash_prime1, table); }
+    const std::uint32_t* freeTable() const { return reinterpret_cast<const std::uint32_t *>(words + words[6]); }
+    std::uint64_t readPilot(std::uint64_t bit) const
+    {
+        std::uint64_t width = words[4];
+        const std::uint64_t *pilots = words + mph_header_words + mph_partition_words * words[3];
+        std::uint64_t index = bit >> 6, shift = bit & 63;
+        std::uint64_t value = pilots[index] >> shift;
+        if (shift + width > 64)
+            value |= pilots[index + 1] << (64 - shift);
+        return value & ((std::uint64_t(1) << width) - 1);
+    }
+
+    // buildPartition: 建立一个分区, hashes为分到这个分区的键的散列值
+    static void buildPartition(const std::uint64_t *hashes, std::size_t n, std::uint64_t seed, Partition &result);
+    void build(const std::vector<Key> &keys, std::size_t threads, std::uint64_t seed);
+};
+// buildPartition: 为一个分区的每个桶寻找pilot
+/*
+ * 找不到pilot(超过mph_max_pilot)的概率极小, 这时换一个种子重建整个分区; 两个键的散列值相同时任何种子都不行,
+ * 抛出std::invalid_argument.
+*/
+template<typename Key, typename Hasher>
+void MinimalPerfectHash<Key, Hasher>::buildPartition(const std::uint64_t *hashes, std::size_t n, std::uint64_t seed,
+                                                      Partition &result)
+{
+    result.size = n;
+    result.table = n == 0 ? 0 : std::max<std::uint64_t>(n, static_cast<std::uint64_t>(std::ceil(n / mph_load)));
+    result.buckets = n == 0 ? 0 : static_cast<std::uint64_t>(std::ceil(n / mph_bucket_size));
+    std::vector<std::uint64_t> positions(n);    // 按桶分组的位置散列值
+    std::vector<std::size_t> begin(result.buckets + 1), order(result.buckets);
+    std::vector<std::uint64_t> taken((result.table + 63) / 64);
+    std::vector<std::uint64_t> slots;
+    for (std::uint64_t attempt = 0; ; ++attempt){
+        result.seed = hashInteger(seed + attempt);
+        // 按桶计数排序
+        std::fill(begin.begin(), begin.end(), 0);
+        for (std::size_t i = 0; i != n; ++i)
+            ++begin[hashRange(hashInteger(hashes[i] ^ result.seed), result.buckets) + 1];
+        for (std::size_t b = 0; b != result.buckets; ++b)
+            begin[b + 1] += begin[b];
+        std::vector<std::size_t> next(begin.begin(), begin.end() - 1);
+        for (std::size_t i = 0; i != n; ++i){
+            std::uint64_t hb = hashInteger(hashes[i] ^ result.seed);
+            positions[next[hashRange(hb, result.buckets)]++] = hashInteger(hb);
+        }
+        // 桶按大小从大到小排列(计数排序, 大小相同时按编号)
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b != result.buckets; ++b)
+            largest = std::max(largest, begin[b + 1] - begin[b]);
+        std::vector<std::size_t> by_size(largest + 2, 0);
+        for (std::size_t b = 0; b != result.buckets; ++b)
+            ++by_size[largest - (begin[b + 1] - begin[b]) + 1];
+        for (std::size_t s = 0; s != largest + 1; ++s)
+            by_size[s + 1] += by_size[s];
+        for (std::size_t b = 0; b != result.buckets; ++b)
+            order[by_size[largest - (begin[b + 1] - begin[b])]++] = b;
+
+        std::fill(taken.begin(), taken.end(), 0);
+        result.pilots.assign(result.buckets, 0);
+        bool failed = false;
+        for (std::size_t k = 0; k != order.size() && !failed; ++k){
+            std::size_t b = order[k];
+            const std::uint64_t *first = positions.data() + begin[b], *last = positions.data() + begin[b + 1];
+            if (first == last)
+                break;      // 之后的桶都是空的
+            // 同一个桶中位置散列值相同的键(散列值相同)无法分开
+            slots.assign(first, last);
+            std::sort(slots.begin(), slots.end());
+            if (std::adjacent_find(slots.begin(), slots.end()) != slots.end())
+                throw std::invalid_argument("MinimalPerfectHash error: 重复的键(或64位散列值相同)");
+            std::uint64_t pilot = 0;
+            for (; pilot != mph_max_pilot; ++pilot){
+                std::uint64_t ph = pilotHash(pilot);
+                const std::uint64_t *p = first;
+                for (; p != last; ++p){
+                    std::uint64_t position = slotOf(*p, ph, result.table);
+                    if (taken[position >> 6] & (std::uint64_t(1) << (position & 63)))
+                        break;
+                    taken[position >> 6] |= std::uint64_t(1) << (position & 63);
+                }
+                if (p == last)
+                    break;
+                // 撤销这次尝试已经占用的位置
+                for (const std::uint64_t *q = first; q != p; ++q){
+                    std::uint64_t position = slotOf(*q, ph, result.table);
+                    taken[position >> 6] &= ~(std::uint64_t(1) << (position & 63));
+                }
+            }
+            failed = pilot == mph_max_pilot;
+            result.pilots[b] = static_cast<std::uint32_t>(pilot);
+        }
+        if (!failed)
+            break;
+    }
+    // [n, table)中被占用的位置依次对应[0, n)中的空位
+    result.free.assign(result.table - n, 0);
+    std::uint64_t hole = 0;
+    for (std::uint64_t position = n; position != result.table; ++position){
+        if (!(taken[position >> 6] & (std::uint64_t(1) << (position & 63))))
+            continue;
+        while (taken[hole >> 6] & (std::uint64_t(1) << (hole & 63)))
+            ++hole;
+        result.free[position - n] = static_cast<std::uint32_t>(hole++);
+    }
+}
+// build: 分区, 并行建立各个分区, 再把结果排成映像
+template<typename Key, typename Hasher>
+void MinimalPerfectHash<Key, Hasher>::build(const std::vector<Key> &keys, std::size_t threads, std::uint64_t seed)
+{
+    const std::size_t n = keys.size();
+    const std::size_t partitions = std::max<std::size_t>(1, (n + mph_partition_keys / 2) / mph_partition_keys);
+    std::vector<std::uint64_t> hashes(n);
+    std::vector<Partition> parts(partitions);
+    std::unique_ptr<WorkStealingPool> pool;
+    if (threads > 1 && n >= mph_partition_keys)
+        pool.reset(new WorkStealingPool(threads - 1));
+    // parallelFor: 把[0, count)分成若干段执行f(low, high)
+    auto parallelFor = [&](std::size_t count, std::size_t grain, const std::function<void(std::size_t, std::size_t)> &f){
+        if (!pool){
+            f(0, count);
+            return;
+        }
+        TaskGroup group(*pool);
+        for (std::size_t low = 0; low < count; low += grain)
+            group.run([&f, low, grain, count]{ f(low, std::min(count, low + grain)); });
+        group.wait();
+    };
+    parallelFor(n, mph_partition_keys, [&](std::size_t low, std::size_t high){
+        for (std::size_t i = low; i != high; ++i)
+            hashes[i] = hasher(keys[i]);
+    });
+    // 按分区计数排序散列值
+    std::vector<std::size_t> begin(partitions + 1, 0);
+    for (auto h : hashes)
+        ++begin[hashRange(h, partitions) + 1];
+    for (std::size_t p = 0; p != partitions; ++p)
+        begin[p + 1] += begin[p];
+    {
+        std::vector<std::uint64_t> grouped(n);
+        std::vector<std::size_t> next(begin.begin(), begin.end() - 1);
+        for (auto h : hashes)
+            grouped[next[hashRange(h, partitions)]++] = h;
+        hashes.swap(grouped);
+    }
+    parallelFor(partitions, 1, [&](std::size_t low, std::size_t high){
+        for (std::size_t p = low; p != high; ++p)
+            buildPartition(hashes.data() + begin[p], begin[p + 1] - begin[p], hashInteger(seed ^ p), parts[p]);
+    });
+    std::vector<std::uint64_t>().swap(hashes);
+
+    // 排成映像
+    std::uint64_t largest = 0, pilot_bits = 0, free_entries = 0;
+    for (auto &part : parts)
+        for (auto pilot : part.pilots)
+            largest = std::max<std::uint64_t>(largest, pilot);
+    std::uint64_t width = 1;
+    while ((largest >> width) != 0)
+        ++width;
+    for (auto &part : parts){
+        pilot_bits += part.buckets * width;
+        free_entries += part.free.size();
+    }
+    std::uint64_t pilot_begin = mph_header_words + mph_partition_words * partitions;
+    std::uint64_t free_begin = pilot_begin + (pilot_bits + 63) / 64 + 1;
+    std::uint64_t total = free_begin + (free_entries + 1) / 2;
+    image.assign(total, 0);
+    std::uint64_t header[mph_header_words] = {mph_magic, mph_version, n, partitions, width, total, free_begin, 0};
+    std::copy(header, header + mph_header_words, image.begin());
+    std::uint64_t offset = 0, bit = 0, free_index = 0;
+    std::uint32_t *free = reinterpret_cast<std::uint32_t *>(image.data() + free_begin);
+    for (std::size_t p = 0; p != partitions; ++p){
+        const Partition &part = parts[p];
+        std::uint64_t record[mph_partition_words] = {offset, part.size, part.table, part.buckets, part.seed, bit, free_index, 0};
+        std::copy(record, record + mph_partition_words, image.begin() + mph_header_words + mph_partition_words * p);
+        for (auto pilot : part.pilots){
+            std::uint64_t index = pilot_begin + (bit >> 6), shift = bit & 63;
+            image[index] |= static_cast<std::uint64_t>(pilot) << shift;
+            if (shift + width > 64)
+                image[index + 1] |= static_cast<std::uint64_t>(pilot) >> (64 - shift);
+            bit += width;
+        }
+        std::copy(part.free.begin(), part.free.end(), free + free_index);
+        free_index += part.free.size();
+        offset += part.size;
+    }
+    words = image.data();
+}
+#endif
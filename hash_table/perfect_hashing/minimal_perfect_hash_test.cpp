@@ -0,0 +1,98 @@
+/*************************************************************************
+	> File Name: minimal_perfect_hash_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时15分13秒
+ ************************************************************************/
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "minimal_perfect_hash.h"
+
+// isMinimalPerfect: 所有键的编号恰好是[0, n)的一个排列
+template<typename Key, typename Hash>
+bool isMinimalPerfect(const std::vector<Key> &keys, const Hash &mph)
+{
+    std::vector<bool> seen(keys.size());
+    for (auto &key : keys){
+        std::uint64_t index = mph(key);
+        if (index >= keys.size() || seen[index])
+            return false;
+        seen[index] = true;
+    }
+    return mph.size() == keys.size();
+}
+
+void small_test()
+{
+    bool correct = true;
+    for (std::size_t n = 0; n != 200; ++n){
+        std::vector<std::string> keys;
+        for (std::size_t i = 0; i != n; ++i)
+            keys.push_back("word" + std::to_string(i));
+        MinimalPerfectHash<std::string> mph(keys, 1);
+        correct = correct && isMinimalPerfect(keys, mph);
+    }
+    std::cout << "0到199个字符串键: " << (correct ? "正确" : "错误") << std::endl;
+    std::vector<std::string> duplicated = {"cat", "dog", "cat"};
+    bool thrown = false;
+    try{
+        MinimalPerfectHash<std::string> mph(duplicated, 1);
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    std::cout << "重复的键抛出异常: " << (thrown ? "正确" : "错误") << std::endl;
+}
+
+void large_test()
+{
+    const std::size_t n = 2000000;
+    std::mt19937_64 random(1);
+    std::vector<std::uint64_t> keys(n);
+    for (auto &key : keys)
+        key = random();
+    auto begin = std::chrono::steady_clock::now();
+    MinimalPerfectHash<std::uint64_t> mph(keys);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << n << "个键建立用时" << seconds << "秒, 每个键" << mph.bitsPerKey() << "位: "
+              << (isMinimalPerfect(keys, mph) && mph.bitsPerKey() < 4 ? "正确" : "错误") << std::endl;
+
+    // 单线程建立的结果与多线程相同
+    MinimalPerfectHash<std::uint64_t> single(keys, 1);
+    bool same = single.imageBytes() == mph.imageBytes();
+    for (std::size_t i = 0; i < n && same; i += 97)
+        same = single(keys[i]) == mph(keys[i]);
+    std::cout << "单线程与多线程的结果相同: " << (same ? "正确" : "错误") << std::endl;
+
+    // 保存与映射加载
+    const char *file = "mph_test.bin";
+    mph.save(file);
+    begin = std::chrono::steady_clock::now();
+    MinimalPerfectHash<std::uint64_t> loaded = MinimalPerfectHash<std::uint64_t>::load(file);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    bool equal = loaded.size() == n;
+    for (std::size_t i = 0; i != n && equal; ++i)
+        equal = loaded(keys[i]) == mph(keys[i]);
+    std::cout << "映像" << loaded.imageBytes() << "字节, 加载用时" << seconds * 1000 << "毫秒: " << (equal ? "正确" : "错误") << std::endl;
+    std::remove(file);
+    bool thrown = false;
+    try{
+        MinimalPerfectHash<std::uint64_t>::load("minimal_perfect_hash_test.cpp");
+    }catch (const std::runtime_error &){
+        thrown = true;
+    }
+    std::cout << "加载不是映像的文件抛出异常: " << (thrown ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********最小完全散列的小规模测试********\n";
+    small_test();
+    std::cout << "********最小完全散列的大规模测试********\n";
+    large_test();
+    return 0;
+}
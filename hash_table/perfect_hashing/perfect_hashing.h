@@ -8,16 +8,25 @@
 #define _PERFECT_HASHING_H
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include "../hasher/hasher.h"
+#include "../hash_stats/hash_stats.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+
+const std::uint64_t perfect_hash_default_seed = 0x5851f42d4c957f2dull;     // 默认的随机数种子(建立的结果可以重现)
+const std::size_t perfect_hash_parallel_threshold = std::size_t(1) << 14;  // 不少于该个数的元素才多线程建立二级散列表
 // Function: 散列函数的系数
 struct Function
 {
-    std::size_t a;  // 二级散列函数((a*k+b) mod p) mod m
-    std::size_t b;
-    std::size_t p;
-    std::size_t m;
+    std::uint64_t a;    // 散列函数hashRange(a*k+b mod 2^64, m*m), a为奇数(乘法-移位的全域散列族)
+    std::uint64_t b;
+    std::size_t m;      // 这个槽中的元素个数, 二级散列表的大小为m*m
 };
-// 待使用的随机产生的散列函数的系数
-std::default_random_engine e;
 // HashTable: 完全散列  算法导论11.5
 /*
  * 如果从全域散列函数类中随机选出散列函数h,将n个关键字存储在一个大小为m=n^2的散列表中
@@ -28,120 +37,247 @@ std::default_random_engine e;
  * 改变.
  *
  * 完全散列方法,如果对该方法进行查找的时候,能在最坏情况下用O(1)次访存完成.
+ *
+ * Hasher先把元素映射为64位散列值k(默认只散列键, 见hasher.h), 一级与二级散列函数都作用于k.
+ * 每次查找只访问一个槽, 也只比较一次元素, 所以不需要像其它散列表那样保存散列值.
+ *
+ * 建立(FKS): 一级散列表的槽数不少于元素个数n, 随机选取一级散列函数直到所有槽的元素个数的平方和不超过4n
+ * (期望不到两次), 于是二级散列表的总大小为O(n); 然后每个槽独立地随机选取二级散列函数, 发生冲突时只重建这个槽,
+ * 每个槽期望不到两次. 每个槽使用由种子与槽号确定的随机数, 所以各个槽可以多线程并行建立, 结果与线程数无关.
+ * 期望的建立时间为O(n).
+ *
+ * 默认构造的HashedObj表示空槽, 所以它本身不能存入散列表.
+ *
+ * 按键访问: search/insert/hash_delete比较整个元素(键与值), find/emplace/try_emplace只比较键.
+ * find的参数可以是与键类型不同但可以比较相等的类型(例如键为std::string时的const char *), 不构造键对象,
+ * 这要求Hasher提供key(k)(见hasher.h的KeyHasher). 每次查找只访问一个槽, 但要依次读一级散列函数与二级散列表两次,
+ * find_many批量查找时先预取一批键的一级槽, 多个键的缓存未命中可以重叠.
+ *
+ * Alloc: 一级与二级散列表的分配器(例如ResourceAllocator<HashedObj>, 见tree_algorithm/NodeArena/MemoryResource.h).
+ * 二级散列表在并行建立之前由调用线程分配好, 所以不是线程安全的来源(MonotonicBufferResource)也可以使用;
+ * initialization的临时数组与散列表的生命期不同, 仍使用默认的分配器.
 */
-template<typename HashedObj>
+template<typename HashedObj, typename Hasher = KeyHasher<HashedObj>, typename Alloc = std::allocator<HashedObj>>
 class HashTable
 {
 public:
+    typedef typename HashedObj::KeyType KeyType;
+    typedef typename HashedObj::ValueType ValueType;
     //**************************结构函数**********************************
-    HashTable(std::size_t num = 2): size(0){hashData.resize(num); function.resize(num);}
+    // num: 一级散列表的槽数(建立时至少为元素个数); seed: 随机选取散列函数的种子
+    HashTable(std::size_t num = 2, const Hasher &h = Hasher(), std::uint64_t seed = perfect_hash_default_seed,
+              const Alloc &alloc = Alloc())
+        : hasher(h), engine(seed), hashData(num, Level(LevelAlloc(alloc)), TableAlloc(alloc)), size(0), first({1, 0, 0}),
+          function(num, Function(), FunctionAlloc(alloc)) {}
     ~HashTable() = default;     // 析构函数
     //**************************成员函数**********************************
-    bool initialization(const std::vector<HashedObj> &);    // hash table 初始化
+    // hash table 初始化, threads为建立二级散列表的线程数
+    bool initialization(const std::vector<HashedObj> &, std::size_t threads = WorkStealingPool::defaultThreads());
     bool search(const HashedObj &);     // hash table 查询操作
     bool insert(const HashedObj &);     // hash table 插入操作
     bool hash_delete(const HashedObj &); // hash table 删除操作
+    // stats: 统计信息(见hash_stats.h), 每次查找的探查长度都是1, 再散列指调用initialization
+    HashTableStats stats() const;
+    void resetStats() { counters.resetCounters(); }
+    Alloc get_allocator() const { return Alloc(hashData.get_allocator()); }
+    // find: 键等于key的元素的值, 不存在时为nullptr
+    template<typename K>
+    ValueType* find(const K &key);
+    template<typename K>
+    const ValueType* find(const K &key) const;
+    // find_many: 批量查找, out[i] = find(keys[i])
+    template<typename K>
+    void find_many(const K *keys, std::size_t n, const ValueType **out) const;
+    template<typename K>
+    void find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const;
+    // emplace: 用args构造元素, 键不存在且它的槽为空时插入; 返回键相同的元素的值与是否插入(冲突时值为nullptr)
+    template<typename... Args>
+    std::pair<ValueType*, bool> emplace(Args&&... args);
+    // try_emplace: 键不存在且它的槽为空时插入(key, ValueType(args...)), 否则不构造任何对象
+    template<typename K, typename... Args>
+    std::pair<ValueType*, bool> try_emplace(K &&key, Args&&... args);
 private:
     //**************************数据成员**********************************
-    std::vector<std::vector<HashedObj>> hashData;   // 散列表的数组
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<HashedObj> LevelAlloc;
+    typedef std::vector<HashedObj, LevelAlloc> Level;     // 一个槽的二级散列表
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Level> TableAlloc;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Function> FunctionAlloc;
+    Hasher hasher;
+    std::mt19937_64 engine;     // 一级散列函数与各个槽的种子由它产生
+    std::vector<Level, TableAlloc> hashData;    // 散列表的数组
     std::size_t size;   // 散列表中存储数据的数量
-    std::vector<Function> function;     // 散列函数的系数
+    Function first;     // 一级散列函数的系数
+    std::vector<Function, FunctionAlloc> function;  // 散列函数的系数
+    HashStatsCounters counters;         // 运行时计数(定义HASH_TABLE_STATS时)
     //***********************私有成员函数*********************************
-    std::size_t hash(const HashedObj &); // 一级hash table的散列函数
-    void random_hash(const std::vector<std::size_t> &);   // 二级hash table随机散列函数
-    void random_hash(const std::size_t);    // 重载二级hash table随机散列函数
-    std::size_t hash2(const HashedObj &);   // 二级hash table散列函数
+    std::size_t hash(std::uint64_t) const; // 一级hash table的散列函数
+    static void random_hash(Function &, std::mt19937_64 &);     // 随机产生一个散列函数
+    std::size_t hash2(std::size_t, std::uint64_t) const;   // 二级hash table散列函数
+    const HashedObj* slot(std::uint64_t) const;     // 散列值为k的键唯一可能所在的槽, 一级槽为空时为nullptr
+    template<typename K>
+    std::pair<ValueType*, bool> place(const K &, std::uint64_t, HashedObj *&);  // 按键插入的探查
+    bool build_level(std::size_t, const HashedObj *, const std::uint64_t *, std::uint64_t);   // 建立一个槽的二级散列表
 };
 // hash: 一级散列函数
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::hash(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, Alloc>::hash(std::uint64_t k) const
 {
-    std::size_t hashIndex = hashed.getIndex();
-    hashIndex = ((3 * hashIndex + 42) % 101) % hashData.size();
-    return hashIndex;
+    return static_cast<std::size_t>(hashRange(first.a * k + first.b, hashData.size()));
 }
-// random_hash: 二级随机散列函数
-template<typename HashedObj>
-void HashTable<HashedObj>::random_hash(const std::vector<std::size_t> &numbers)
+// random_hash: 随机产生一个散列函数(m不变)
+template<typename HashedObj, typename Hasher, typename Alloc>
+void HashTable<HashedObj, Hasher, Alloc>::random_hash(Function &f, std::mt19937_64 &random)
 {
-
-    for (decltype(numbers.size()) i = 0; i != numbers.size(); ++i){
-        if (numbers[i] == 1){
-            function[i].a = 0;
-            function[i].b = 0;
-            function[i].p = e();
-            function[i].m = numbers[i];
-        }
-        else{
-            function[i].a = e();
-            function[i].b = e();
-            function[i].p = e();
-            function[i].m = numbers[i];
-        }
-    }
+    f.a = random() | 1;
+    f.b = random();
 }
-// random_hash: 重载二级随机散列函数
-template<typename HashedObj>
-void HashTable<HashedObj>::random_hash(const std::size_t levelIndex)
+// hash2: 二级散列函数
+template<typename HashedObj, typename Hasher, typename Alloc>
+std::size_t HashTable<HashedObj, Hasher, Alloc>::hash2(std::size_t levelIndex, std::uint64_t k) const
 {
-    if (function[levelIndex].m == 1){
-        function[levelIndex].a = 0;
-        function[levelIndex].b = 0;
-        function[levelIndex].p = e();
-    }
-    else{
-        function[levelIndex].a = e();
-        function[levelIndex].b = e();
-        function[levelIndex].p = e();
-    }
+    const Function &f = function[levelIndex];
+    return static_cast<std::size_t>(hashRange(f.a * k + f.b, f.m * f.m));
 }
-// hash2: 二级散列函数
-template<typename HashedObj>
-std::size_t HashTable<HashedObj>::hash2(const HashedObj &hashed)
+// slot: 散列值为k的键唯一可能所在的槽
+template<typename HashedObj, typename Hasher, typename Alloc>
+const HashedObj* HashTable<HashedObj, Hasher, Alloc>::slot(std::uint64_t k) const
+{
+    std::size_t levelIndex = hash(k);
+    if (function[levelIndex].m == 0)
+        return nullptr;
+    return &hashData[levelIndex][hash2(levelIndex, k)];
+}
+// place: 按键插入的探查
+/*
+ * \parameter key: 元素的键;
+ * \parameter k: 键的散列值;
+ * \parameter target: 返回时为可以放入新元素的空槽, 不能插入时为nullptr;
+ * \return 键已经存在时为(它的值, false); 否则为(nullptr, 是否可以插入).
+ * 键的槽被键不同的元素占用, 或者它的一级槽没有二级散列表时发生冲突, 不能插入(与insert相同).
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K>
+std::pair<typename HashedObj::ValueType*, bool>
+HashTable<HashedObj, Hasher, Alloc>::place(const K &key, std::uint64_t k, HashedObj *&target)
 {
-    std::size_t levelIndex = hash(hashed);
-    std::size_t index = ((function[levelIndex].a * hashed.getIndex() + function[levelIndex].b) 
-                         % function[levelIndex].p) % (function[levelIndex].m * function[levelIndex].m);
-    return index;
+    target = const_cast<HashedObj *>(slot(k));
+    if (target == nullptr)
+        return std::make_pair(static_cast<ValueType*>(nullptr), false);
+    if (*target == HashedObj())
+        return std::make_pair(static_cast<ValueType*>(nullptr), true);
+    if (target->key == key)
+        return std::make_pair(&target->value, false);
+    target = nullptr;
+    return std::make_pair(static_cast<ValueType*>(nullptr), false);
+}
+// build_level: 建立一个槽的二级散列表
+/*
+ * \parameter levelIndex: 一级散列表的槽;
+ * \parameter objs, keys: 散列到这个槽的元素与它们的散列值, 共function[levelIndex].m个;
+ * \parameter seed: 这个槽的随机数种子;
+ * \return 是否成功(有两个元素的散列值完全相同时不可能成功).
+ * 二级散列表已经由initialization分配为m*m个空槽. 发生冲突时只清空这个槽, 换一个散列函数重试.
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+bool HashTable<HashedObj, Hasher, Alloc>::build_level(std::size_t levelIndex, const HashedObj *objs, const std::uint64_t *keys,
+                                                      std::uint64_t seed)
+{
+    Function &f = function[levelIndex];
+    Level &slots = hashData[levelIndex];
+    if (f.m <= 1){
+        f.a = 1;
+        f.b = 0;
+        if (f.m == 1)
+            slots[0] = objs[0];
+        return true;
+    }
+    std::mt19937_64 random(seed);
+    std::vector<bool> used(slots.size());
+    // 每次成功的概率大于1/2, 失败64次说明有散列值相同的元素
+    for (int attempt = 0; attempt != 64; ++attempt){
+        random_hash(f, random);
+        std::fill(used.begin(), used.end(), false);
+        bool collided = false;
+        for (std::size_t i = 0; i != f.m && !collided; ++i){
+            std::size_t index = hash2(levelIndex, keys[i]);
+            collided = used[index];
+            used[index] = true;
+        }
+        if (collided)
+            continue;
+        for (std::size_t i = 0; i != f.m; ++i)
+            slots[hash2(levelIndex, keys[i])] = objs[i];
+        return true;
+    }
+    return false;
 }
 // initialization: hash table初始化
 /*
- * \parameter vec: 待初始化的数据向量;
- * \return bool(返回是否初始化成功的标志).
+ * \parameter vec: 待初始化的数据向量(元素互不相同);
+ * \parameter threads: 建立二级散列表的线程数(包括调用线程), 元素较少时不使用多线程;
+ * \return bool(返回是否初始化成功的标志, 有两个元素的散列值完全相同(包括重复的元素)时失败, 不会一直重试).
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::initialization(const std::vector<HashedObj> &vec)
-{
-    size = vec.size();
-    std::vector<std::size_t> numbers;   // 统计散列到同一个槽的数量
-    numbers.resize(hashData.size());
-    for (auto &i : vec)
-        numbers[hash(i)] += 1;
-    for (decltype(hashData.size()) i = 0; i != hashData.size(); ++i)
-        hashData[i].resize(numbers[i] * numbers[i]);
-    bool sign = false;  // 标志是否发生冲突
-    random_hash(numbers); // 随机产生初始散列函数
-    do{
-        sign = false;
-        for (decltype(vec.size()) i = 0; i < vec.size(); ++i){
-            std::size_t levelIndex = hash(vec[i]);
-            std::size_t index = hash2(vec[i]);
-            HashedObj hashObj;
-            if (hashData[levelIndex][index] == hashObj){
-                hashData[levelIndex][index] = vec[i];
-                sign = false;
-            }
-            else{
-                sign = true;
-                for (int row = 0; row != hashData.size(); ++row)
-                    for (int col = 0; col != hashData[row].size(); ++col)
-                        hashData[row][col] = hashObj;                        
-                random_hash(levelIndex);    // 随机产生这一列的二级散列新的随机函数
-                break;
-            }
-        }    
-    }while(sign);
-    return true;
+template<typename HashedObj, typename Hasher, typename Alloc>
+bool HashTable<HashedObj, Hasher, Alloc>::initialization(const std::vector<HashedObj> &vec, std::size_t threads)
+{
+    const std::size_t n = vec.size();
+    counters.recordRehash();
+    HashStatsCounters::RehashTimer timer(counters);
+    size = n;
+    std::size_t buckets = std::max(hashData.size(), std::max<std::size_t>(n, 1));
+    hashData.assign(buckets, Level(hashData.get_allocator()));
+    function.assign(buckets, Function());
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i != n; ++i)
+        keys[i] = hasher(vec[i]);
+    // 选择一级散列函数, 使二级散列表的总大小不超过4n. 每次成功的概率大于1/2,
+    // 失败64次说明有很多散列值相同的元素(例如重复的元素), 它们在任何一级散列函数下都在同一个槽中
+    std::vector<std::size_t> numbers(buckets);  // 统计散列到同一个槽的数量
+    for (int attempt = 0; ; ++attempt){
+        if (attempt == 64)
+            return false;
+        random_hash(first, engine);
+        std::fill(numbers.begin(), numbers.end(), 0);
+        for (auto k : keys)
+            numbers[hash(k)] += 1;
+        std::uint64_t total = 0;
+        for (auto count : numbers)
+            total += static_cast<std::uint64_t>(count) * count;
+        if (total <= 4 * static_cast<std::uint64_t>(n))
+            break;
+    }
+    // 按槽分组(计数排序), 每个槽的元素是连续的一段
+    std::vector<std::size_t> begin(buckets + 1, 0);
+    for (std::size_t i = 0; i != buckets; ++i){
+        begin[i + 1] = begin[i] + numbers[i];
+        function[i].m = numbers[i];
+        hashData[i].assign(numbers[i] * numbers[i], HashedObj());
+    }
+    std::vector<HashedObj> objs(n);
+    std::vector<std::uint64_t> grouped(n);
+    std::vector<std::size_t> next(begin.begin(), begin.end() - 1);
+    for (std::size_t i = 0; i != n; ++i){
+        std::size_t pos = next[hash(keys[i])]++;
+        objs[pos] = vec[i];
+        grouped[pos] = keys[i];
+    }
+    std::uint64_t base_seed = engine();
+    auto build_range = [&](std::size_t low, std::size_t high) -> bool {
+        bool ok = true;
+        for (std::size_t i = low; i != high; ++i)
+            ok = build_level(i, objs.data() + begin[i], grouped.data() + begin[i], hashInteger(base_seed ^ i)) && ok;
+        return ok;
+    };
+    if (threads <= 1 || n < perfect_hash_parallel_threshold)
+        return build_range(0, buckets);
+    // 二级散列表在共享的线程池中建立
+    std::atomic<bool> ok(true);
+    std::size_t chunk = (buckets + 4 * threads - 1) / (4 * threads);
+    parallelFor(execution::par.withThreads(threads), (buckets + chunk - 1) / chunk, [&](std::size_t c){
+        if (!build_range(c * chunk, std::min(buckets, (c + 1) * chunk)))
+            ok = false;
+    });
+    return ok.load();
 }
 // search: 完全散列的查询操作
 /*
@@ -149,15 +285,36 @@ bool HashTable<HashedObj>::initialization(const std::vector<HashedObj> &vec)
  * \return bool(查询是否成功的标志).
  * 算法性能(O(1)).
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::search(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, typename Alloc>
+bool HashTable<HashedObj, Hasher, Alloc>::search(const HashedObj &hashed)
 {
-    bool sign = false;
-    std::size_t levelIndex = hash(hashed);
-    std::size_t index = hash2(hashed);
-    if (hashData[levelIndex][index] == hashed)
-        sign = true;
-    return sign;
+    std::uint64_t k = hasher(hashed);
+    std::size_t levelIndex = hash(k);
+    bool found = function[levelIndex].m != 0 && hashData[levelIndex][hash2(levelIndex, k)] == hashed;
+    counters.recordLookup(found, 1);
+    return found;
+}
+// stats: 统计信息.
+/*
+ * \return 结构统计与运行时计数. 容量为所有二级散列表的槽数之和, maxSecondLevel为最大的二级散列表的槽数
+ * (FKS保证容量为O(n), 但个别的槽可能较大).
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+HashTableStats HashTable<HashedObj, Hasher, Alloc>::stats() const
+{
+    HashTableStats result;
+    result.size = size;
+    const HashedObj empty = HashedObj();
+    for (std::size_t i = 0; i != hashData.size(); ++i){
+        result.capacity += hashData[i].size();
+        result.maxSecondLevel = std::max(result.maxSecondLevel, hashData[i].size());
+        for (auto &obj : hashData[i])
+            if (!(obj == empty))
+                result.stored.add(1);
+    }
+    result.longestChain = result.stored.total == 0 ? 0 : 1;
+    counters.exportTo(result);
+    return result;
 }
 // insert: 完全散列的插入操作
 /*
@@ -167,17 +324,18 @@ bool HashTable<HashedObj>::search(const HashedObj &hashed)
  * 算法基本思想: 完全散列插入最大的问题就在于冲突的处理,由于插入元素造成冲突处理的成本比较高,
  * 这里我们假定当插入元素与其它元素发生碰撞以后就禁止插入此元素.
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::insert(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, typename Alloc>
+bool HashTable<HashedObj, Hasher, Alloc>::insert(const HashedObj &hashed)
 {
     bool sign = false;
-    std::size_t levelIndex = hash(hashed);
+    std::uint64_t k = hasher(hashed);
+    std::size_t levelIndex = hash(k);
     if (function[levelIndex].m == 0){
         std::cerr << "发生碰撞!禁止插入!" << std::endl;
         sign = false;
         return sign;
     }
-    std::size_t index = hash2(hashed);
+    std::size_t index = hash2(levelIndex, k);
     HashedObj hashObj;
     if (hashData[levelIndex][index] == hashObj){
         hashData[levelIndex][index] = hashed;
@@ -196,16 +354,17 @@ bool HashTable<HashedObj>::insert(const HashedObj &hashed)
  * \return bool(删除此单元成功的标志).
  * 算法性能: O(1).
 */
-template<typename HashedObj>
-bool HashTable<HashedObj>::hash_delete(const HashedObj &hashed)
+template<typename HashedObj, typename Hasher, typename Alloc>
+bool HashTable<HashedObj, Hasher, Alloc>::hash_delete(const HashedObj &hashed)
 {
     bool sign = false;
-    std::size_t levelIndex = hash(hashed);
+    std::uint64_t k = hasher(hashed);
+    std::size_t levelIndex = hash(k);
     if (function[levelIndex].m == 0){
         std::cerr << "未找到要删除的元素!" << std::endl;
         return false;
     }
-    std::size_t index = hash2(hashed);
+    std::size_t index = hash2(levelIndex, k);
     HashedObj hashObj;
     if (hashData[levelIndex][index] == hashed){
         hashData[levelIndex][index] = hashObj;
@@ -218,4 +377,103 @@ bool HashTable<HashedObj>::hash_delete(const HashedObj &hashed)
     }
     return sign;
 }
+// find: 按键查找.
+/*
+ * \parameter key: 键, 或者可以与键比较相等且Hasher::key可以散列的其它类型;
+ * \return 键等于key的元素的值, 不存在时为nullptr.
+ * 算法性能: 最坏情况O(1), 只比较一次键.
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K>
+const typename HashedObj::ValueType* HashTable<HashedObj, Hasher, Alloc>::find(const K &key) const
+{
+    const HashedObj *p = slot(hasher.key(key));
+    bool found = p != nullptr && p->key == key && !(*p == HashedObj());
+    counters.recordLookup(found, 1);
+    return found ? &p->value : nullptr;
+}
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K>
+typename HashedObj::ValueType* HashTable<HashedObj, Hasher, Alloc>::find(const K &key)
+{
+    return const_cast<ValueType*>(static_cast<const HashTable&>(*this).find(key));
+}
+// find_many: 批量查找.
+/*
+ * \parameter keys: n个待查找的键;
+ * \parameter out: 结果, out[i]为键等于keys[i]的元素的值, 不存在时为nullptr.
+ * 每批hash_lookup_batch个键, 先计算散列值并预取一级槽(二级散列函数与二级散列表的地址), 再预取二级槽, 最后比较.
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, Alloc>::find_many(const K *keys, std::size_t n, const ValueType **out) const
+{
+    std::uint64_t hashes[hash_lookup_batch];
+    for (std::size_t low = 0; low < n; low += hash_lookup_batch){
+        std::size_t count = std::min(hash_lookup_batch, n - low);
+        for (std::size_t i = 0; i != count; ++i){
+            hashes[i] = hasher.key(keys[low + i]);
+            std::size_t levelIndex = hash(hashes[i]);
+            hashPrefetch(&function[levelIndex]);
+            hashPrefetch(&hashData[levelIndex]);
+        }
+        for (std::size_t i = 0; i != count; ++i){
+            const HashedObj *p = slot(hashes[i]);
+            if (p != nullptr)
+                hashPrefetch(p);
+        }
+        for (std::size_t i = 0; i != count; ++i){
+            const HashedObj *p = slot(hashes[i]);
+            bool found = p != nullptr && p->key == keys[low + i] && !(*p == HashedObj());
+            counters.recordLookup(found, 1);
+            out[low + i] = found ? &p->value : nullptr;
+        }
+    }
+}
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K>
+void HashTable<HashedObj, Hasher, Alloc>::find_many(const std::vector<K> &keys, std::vector<const ValueType *> &out) const
+{
+    out.resize(keys.size());
+    find_many(keys.data(), keys.size(), out.data());
+}
+// emplace: 原地构造元素并按键插入.
+/*
+ * \parameter args: HashedObj的构造函数的参数;
+ * \return 键相同的元素的值与是否插入了新元素, 发生冲突时为(nullptr, false).
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, Alloc>::emplace(Args&&... args)
+{
+    HashedObj x(std::forward<Args>(args)...);
+    HashedObj *target;
+    std::pair<ValueType*, bool> result = place(x.key, hasher(x), target);
+    if (result.second){
+        *target = std::move(x);
+        result.first = &target->value;
+        ++size;
+    }
+    return result;
+}
+// try_emplace: 键不存在时插入.
+/*
+ * \parameter key: 键, 或者可以构造键并与键比较相等的其它类型;
+ * \parameter args: ValueType的构造函数的参数;
+ * \return 键相同的元素的值与是否插入了新元素, 发生冲突时为(nullptr, false).
+ * 先用key查找, 不能插入时不构造键, 值与元素.
+*/
+template<typename HashedObj, typename Hasher, typename Alloc>
+template<typename K, typename... Args>
+std::pair<typename HashedObj::ValueType*, bool> HashTable<HashedObj, Hasher, Alloc>::try_emplace(K &&key, Args&&... args)
+{
+    HashedObj *target;
+    std::pair<ValueType*, bool> result = place(key, hasher.key(key), target);
+    if (result.second){
+        *target = HashedObj(KeyType(std::forward<K>(key)), ValueType(std::forward<Args>(args)...));
+        result.first = &target->value;
+        ++size;
+    }
+    return result;
+}
 #endif
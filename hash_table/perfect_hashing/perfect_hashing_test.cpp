@@ -13,6 +13,7 @@ using std::string;
 using std::vector;
 #include "perfect_hashing.h"
 #include "hash.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 typedef Hash<string, int> HashData;
 typedef HashTable<Hash<string, int>> PerHash;
 
@@ -34,6 +35,74 @@ void initial(PerHash &hash)
     cout << "完全散列是否初始化成功: " << hash.initialization(vec) << endl;
 }
 
+// large_test: 多个槽发生冲突时只重建冲突的槽, 多线程建立20万个元素
+void large_test()
+{
+    vector<HashData> vec;
+    for (int i = 0; i != 200000; ++i)
+        vec.push_back(HashData("key" + std::to_string(i), i));
+    PerHash single, parallel;
+    bool sign = single.initialization(vec, 1) && parallel.initialization(vec, 4);
+    for (int i = 0; i != 200000 && sign; ++i)
+        sign = single.search(vec[i]) && parallel.search(vec[i]) && !parallel.search(HashData("key" + std::to_string(i), i + 1));
+    cout << "20万个元素的完全散列: " << (sign ? "正确" : "错误") << endl;
+}
+
+// find_test: 按键查找(const char *直接查找, 不构造std::string), emplace/try_emplace与批量查找
+void find_test()
+{
+    vector<HashData> vec;
+    vector<string> keys;
+    for (int i = 0; i != 1000; ++i){
+        vec.push_back(HashData("key" + std::to_string(i), i));
+        keys.push_back("key" + std::to_string(2 * i));
+    }
+    PerHash hash;
+    bool sign = hash.initialization(vec, 1) && *hash.find("key7") == 7 && hash.find("cat") == nullptr;
+    *hash.find(string("key7")) = 70;
+    sign = sign && hash.search(HashData("key7", 70)) && !hash.try_emplace("key7", 1).second && *hash.try_emplace("key7", 1).first == 70;
+    // 删除以后原来的槽为空, 同一个键可以再插入
+    sign = sign && hash.hash_delete(HashData("key8", 8)) && hash.find("key8") == nullptr;
+    sign = sign && hash.emplace("key8", 80).second && *hash.find("key8") == 80;
+    vector<const int *> values;
+    hash.find_many(keys, values);
+    for (int i = 0; i != 1000 && sign; ++i)
+        sign = values[i] == hash.find(keys[i]) && (i < 500 ? values[i] != nullptr : values[i] == nullptr);
+    cout << "按键查找与批量查找: " << (sign ? "正确" : "错误") << endl;
+}
+
+// duplicate_test: 重复的元素使初始化失败(不会一直重新选择一级散列函数)
+void duplicate_test()
+{
+    // 5个相同的元素在任何一级散列函数下都在同一个槽中, 25 > 4n, 一级散列函数总是不满足要求
+    vector<HashData> same(5, HashData("same", 0));
+    PerHash hash;
+    bool sign = !hash.initialization(same, 1);
+    // 元素较多时一级散列可以满足要求, 在二级散列失败
+    vector<HashData> vec(same);
+    for (int i = 0; i != 100; ++i)
+        vec.push_back(HashData("key" + std::to_string(i), i));
+    sign = sign && !hash.initialization(vec, 1);
+    cout << "有重复的元素时初始化失败: " << (sign ? "正确" : "错误") << endl;
+}
+
+// resource_test: 二级散列表都从MonotonicBufferResource分配, 多线程建立时结果不变
+void resource_test()
+{
+    vector<HashData> vec;
+    for (int i = 0; i != 20000; ++i)
+        vec.push_back(HashData("key" + std::to_string(i), i));
+    MonotonicBufferResource arena;
+    HashTable<HashData, KeyHasher<HashData>, ResourceAllocator<HashData>> hash(2, KeyHasher<HashData>(),
+                                                                              perfect_hash_default_seed, &arena);
+    bool sign = hash.initialization(vec, 4);
+    for (int i = 0; i != 20000 && sign; ++i)
+        sign = hash.search(vec[i]) && *hash.find("key" + std::to_string(i)) == i;
+    HashTableStats stats = hash.stats();
+    sign = sign && arena.bytesAllocated() >= stats.capacity * sizeof(HashData) && hash.get_allocator().resource() == &arena;
+    cout << "从MemoryResource分配: " << (sign ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     
@@ -90,6 +159,14 @@ int main()
     cout << "**********************插入测试*******************\n";
     sign = hash.insert({"hello",12345});
     cout << "插入'hello,12345'是否成功: " << sign << endl;
+
+    cout << "**********************大规模测试*******************\n";
+    large_test();
+    cout << "**********************按键查找测试*******************\n";
+    find_test();
+    duplicate_test();
+    cout << "**********************MemoryResource测试*******************\n";
+    resource_test();
     return 0;
 }
 
@@ -0,0 +1,459 @@
+/*************************************************************************
+	> File Name: static_perfect_hash.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时32分02秒
+ ************************************************************************/
+#ifndef _STATIC_PERFECT_HASH_H
+#define _STATIC_PERFECT_HASH_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+// StaticPerfectHash: 编译期建立的完全散列表(固定的关键字集合)  算法导论11.5
+/*
+ * 协议动词, 配置项的名字, 枚举的名字这些集合在编译时就已知道. HashTable::initialization在每次进程启动时
+ * 随机地重试, makeStaticPerfectHash在编译期完成同样的FKS建立, 结果是只读的constexpr对象:
+ *      constexpr const char *verbs[] = {"GET", "PUT", "POST", "DELETE"};    // 命名空间作用域
+ *      constexpr StaticPerfectHash<const char *, 4> verbTable = makeStaticPerfectHash(verbs);
+ *      verbTable.find(request.method)      // 运行时查找, 返回键在verbs中的下标, 不存在时为npos
+ *      static_assert(verbTable.index("POST") == 2, "");    // 编译期查找, 也可以作为case标号
+ * 值按下标存放在调用者的数组中(values[verbTable.find(k)]). 没有启动代价, 不分配内存, 表在只读数据段中.
+ *
+ * 建立(与HashTable::initialization相同的FKS方法):
+ *      --一级散列表有n个槽, 依次尝试散列函数range(a * k + b, n)(系数由种子与尝试的序号确定), 直到所有槽的
+ *        元素个数的平方和不超过4n;
+ *      --有m个元素的槽使用m * m个二级槽, 依次尝试二级散列函数range(a_j * k + b_j, m * m)直到没有冲突.
+ *        所有的二级槽连续地存放在一个4n + 1项的数组中(多出的一项保证最后一个一级槽为空时起点仍在数组内),
+ *        每项只是一个32位的下标, 指向n + 1个{散列值, 键}的条目(最后一个是空的条目, 它的散列值故意与它的键不符).
+ * 标准为C++11, constexpr函数只能有一个return语句: 每个数组都由下标序列的参数包展开得到, 计数与查找写成二分的
+ * 递归(递归深度为O(logn)), 各个中间结果放在一串constexpr对象中. 编译期的计算量为O(n^2), 适合几百个键以内的集合;
+ * 键重复(或散列值完全相同)时编译失败. 更大的集合使用minimal_perfect_hash.h在运行时建立.
+ *
+ * 键可以是整数, 枚举或const char *(以'\0'结尾, 按内容比较; 不超过几百个字符, 否则超过constexpr的递归深度).
+ *      --整数的散列值与hashInteger相同; 字符串为FNV-1a再用hashInteger的混合函数(hashBytes不能写成C++11的constexpr);
+ *      --字符串的find可以用const char *, std::string或StaticString{指针, 长度}查找, 不构造std::string.
+ *
+ * 查找: 一次散列, 两次乘法-移位得到二级槽, 读下标与条目, 比较散列值与键; 没有与空槽有关的分支
+ * (没有元素的一级槽j的二级槽数为0, range(x, 0) == 0, 落到它的起点slotStart[j]上. 这可能是下一个一级槽的
+ * 第一个二级槽, 其中是另一个键; 但要查找的键不在这个一级槽中, 散列值与键不会都相同, 所以查找仍然正确).
+ *
+ */
+const std::uint64_t static_perfect_hash_seed = 0x5851f42d4c957f2dull;  // 选取散列函数的种子(与perfect_hashing.h相同)
+const unsigned static_perfect_hash_attempts = 64;                       // 每一级尝试的散列函数个数的上限
+const std::uint64_t static_hash_fnv_basis = 0xcbf29ce484222325ull;
+const std::uint64_t static_hash_fnv_prime = 0x100000001b3ull;
+const std::size_t static_perfect_hash_none = static_cast<std::size_t>(-1);
+
+//**************************编译期的散列函数**********************************
+constexpr std::uint64_t staticMix(std::uint64_t x, std::uint64_t c) { return (x ^ (x >> 33)) * c; }
+constexpr std::uint64_t staticMixFinal(std::uint64_t x) { return x ^ (x >> 33); }
+// staticHashInteger: 与hashInteger(hasher.h)相同的fmix64
+constexpr std::uint64_t staticHashInteger(std::uint64_t x)
+{
+    return staticMixFinal(staticMix(staticMix(x, 0xff51afd7ed558ccdull), 0xc4ceb9fe1a85ec53ull));
+}
+// staticHashChars: s[0, n)的FNV-1a, 最后再混合一次
+constexpr std::uint64_t staticHashChars(const char *s, std::size_t n, std::uint64_t h)
+{
+    return n == 0 ? staticHashInteger(h)
+                  : staticHashChars(s + 1, n - 1, (h ^ static_cast<unsigned char>(*s)) * static_hash_fnv_prime);
+}
+constexpr std::size_t staticLength(const char *s, std::size_t n = 0) { return *s ? staticLength(s + 1, n + 1) : n; }
+constexpr bool staticEqualChars(const char *a, const char *b, std::size_t n)
+{
+    return n == 0 || (*a == *b && staticEqualChars(a + 1, b + 1, n - 1));
+}
+// staticRange: 与hashRange相同, 把64位散列值映射到[0, n), n == 0时为0
+constexpr std::uint64_t staticRange(std::uint64_t h, std::uint64_t n)
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+#else
+    return n == 0 ? 0 : h % n;
+#endif
+}
+// staticSplitMix: 由种子与序号得到散列函数的系数(SplitMix64)
+constexpr std::uint64_t staticSplitStep(std::uint64_t z, std::uint64_t c, int shift) { return (z ^ (z >> shift)) * c; }
+constexpr std::uint64_t staticSplitMix(std::uint64_t x)
+{
+    return staticSplitStep(staticSplitStep(x + 0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull, 30), 0x94d049bb133111ebull, 27)
+           ^ (staticSplitStep(staticSplitStep(x + 0x9e3779b97f4a7c15ull, 0xbf58476d1ce4e5b9ull, 30), 0x94d049bb133111ebull, 27) >> 31);
+}
+// 第t次尝试的一级散列函数, 与一级槽j的第t次尝试的二级散列函数(a为奇数)
+constexpr std::uint64_t staticFirstA(unsigned t) { return staticSplitMix(static_perfect_hash_seed + 2 * t) | 1; }
+constexpr std::uint64_t staticFirstB(unsigned t) { return staticSplitMix(static_perfect_hash_seed + 2 * t + 1); }
+constexpr std::uint64_t staticSecondA(std::size_t j, unsigned t)
+{
+    return staticSplitMix(~static_perfect_hash_seed + 2 * ((static_cast<std::uint64_t>(j) << 8) | t)) | 1;
+}
+constexpr std::uint64_t staticSecondB(std::size_t j, unsigned t)
+{
+    return staticSplitMix(~static_perfect_hash_seed + 2 * ((static_cast<std::uint64_t>(j) << 8) | t) + 1);
+}
+
+//**************************键的类型**********************************
+// StaticString: 字符串键(指针与长度), 指向的字符必须比表活得长(字符串字面量是静态的)
+struct StaticString
+{
+    const char *data;
+    std::size_t size;
+};
+
+// StaticKeyTraits: 键的存放形式, 编译期与运行时的散列与比较
+template<typename Key, typename Enable = void>
+struct StaticKeyTraits;
+template<typename Key>
+struct StaticKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value || std::is_enum<Key>::value>::type>
+{
+    typedef Key Stored;
+    static constexpr Stored store(Key key) { return key; }
+    static constexpr Stored empty() { return Key(); }
+    static constexpr std::uint64_t hash(Stored key) { return staticHashInteger(static_cast<std::uint64_t>(key)); }
+    static constexpr bool equal(Stored a, Stored b) { return a == b; }
+    static Stored query(Key key) { return key; }
+    static std::uint64_t runtimeHash(Stored key) { return hash(key); }
+    static bool runtimeEqual(Stored a, Stored b) { return a == b; }
+};
+template<>
+struct StaticKeyTraits<const char *>
+{
+    typedef StaticString Stored;
+    static constexpr Stored store(const char *key) { return Stored{key, staticLength(key)}; }
+    static constexpr Stored empty() { return Stored{"", 0}; }
+    static constexpr std::uint64_t hash(Stored key) { return staticHashChars(key.data, key.size, static_hash_fnv_basis); }
+    static constexpr bool equal(Stored a, Stored b) { return a.size == b.size && staticEqualChars(a.data, b.data, a.size); }
+    static Stored query(const char *key) { return Stored{key, std::strlen(key)}; }
+    static Stored query(const std::string &key) { return Stored{key.data(), key.size()}; }
+    static Stored query(Stored key) { return key; }
+    // 运行时用循环与memcmp, 与编译期的结果相同
+    static std::uint64_t runtimeHash(Stored key)
+    {
+        std::uint64_t h = static_hash_fnv_basis;
+        for (std::size_t i = 0; i != key.size; ++i)
+            h = (h ^ static_cast<unsigned char>(key.data[i])) * static_hash_fnv_prime;
+        return staticHashInteger(h);
+    }
+    static bool runtimeEqual(Stored a, Stored b) { return a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0; }
+};
+
+//**************************下标序列(C++11没有std::index_sequence)**********************************
+template<std::size_t... I>
+struct StaticIndices {  };
+template<typename A, typename B>
+struct StaticIndicesConcat;
+template<std::size_t... I, std::size_t... J>
+struct StaticIndicesConcat<StaticIndices<I...>, StaticIndices<J...>>
+{
+    typedef StaticIndices<I..., (sizeof...(I) + J)...> type;
+};
+// MakeStaticIndices: 0, 1, ..., N - 1, 每次对半拼接, 模板的嵌套深度为O(logN)
+template<std::size_t N>
+struct MakeStaticIndices
+{
+    typedef typename StaticIndicesConcat<typename MakeStaticIndices<N / 2>::type,
+                                         typename MakeStaticIndices<N - N / 2>::type>::type type;
+};
+template<>
+struct MakeStaticIndices<0>
+{
+    typedef StaticIndices<> type;
+};
+template<>
+struct MakeStaticIndices<1>
+{
+    typedef StaticIndices<0> type;
+};
+
+//**************************编译期的建立**********************************
+// 数组p[lo, hi)上的二分递归: 求和(或平方和), 计数, 查找
+constexpr std::size_t staticSumRange(const std::uint32_t *p, std::size_t lo, std::size_t hi, bool squared)
+{
+    return hi == lo ? 0
+         : hi - lo == 1 ? (squared ? std::size_t(p[lo]) * p[lo] : p[lo])
+         : staticSumRange(p, lo, lo + (hi - lo) / 2, squared) + staticSumRange(p, lo + (hi - lo) / 2, hi, squared);
+}
+constexpr std::size_t staticCountEqual(const std::uint32_t *p, std::uint32_t v, std::size_t lo, std::size_t hi)
+{
+    return hi == lo ? 0
+         : hi - lo == 1 ? (p[lo] == v ? 1 : 0)
+         : staticCountEqual(p, v, lo, lo + (hi - lo) / 2) + staticCountEqual(p, v, lo + (hi - lo) / 2, hi);
+}
+constexpr std::size_t staticFirstFound(std::size_t a, std::size_t b) { return a != static_perfect_hash_none ? a : b; }
+constexpr std::size_t staticFindValue(const std::uint32_t *p, std::uint32_t v, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 1 ? (p[lo] == v ? lo : static_perfect_hash_none)
+         : staticFirstFound(staticFindValue(p, v, lo, lo + (hi - lo) / 2), staticFindValue(p, v, lo + (hi - lo) / 2, hi));
+}
+
+// 一级散列
+constexpr std::uint32_t staticFirstBucket(std::uint64_t h, unsigned t, std::size_t n)
+{
+    return static_cast<std::uint32_t>(staticRange(staticFirstA(t) * h + staticFirstB(t), n));
+}
+// staticCountBucket: h[lo, hi)中第t次尝试落到一级槽j的个数
+constexpr std::size_t staticCountBucket(const std::uint64_t *h, unsigned t, std::size_t n, std::size_t j,
+                                        std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 1 ? (staticFirstBucket(h[lo], t, n) == j ? 1 : 0)
+         : staticCountBucket(h, t, n, j, lo, lo + (hi - lo) / 2) + staticCountBucket(h, t, n, j, lo + (hi - lo) / 2, hi);
+}
+// staticSumSquares: 一级槽[lo, hi)的元素个数的平方和
+constexpr std::size_t staticSquare(std::size_t c) { return c * c; }
+constexpr std::size_t staticSumSquares(const std::uint64_t *h, unsigned t, std::size_t n, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 1 ? staticSquare(staticCountBucket(h, t, n, lo, 0, n))
+         : staticSumSquares(h, t, n, lo, lo + (hi - lo) / 2) + staticSumSquares(h, t, n, lo + (hi - lo) / 2, hi);
+}
+// staticFirstAttempt: 第一个使平方和不超过4n的一级散列函数
+constexpr unsigned staticFirstAttempt(const std::uint64_t *h, std::size_t n, unsigned t)
+{
+    return t == static_perfect_hash_attempts ? throw std::logic_error("StaticPerfectHash error: no first-level function!")
+         : staticSumSquares(h, t, n, 0, n) <= 4 * n ? t : staticFirstAttempt(h, n, t + 1);
+}
+
+// 二级散列: 一级槽j(有c个元素)的第t次尝试
+constexpr std::size_t staticSecondSlot(std::uint64_t h, std::size_t j, unsigned t, std::size_t c)
+{
+    return static_cast<std::size_t>(staticRange(staticSecondA(j, t) * h + staticSecondB(j, t), c * c));
+}
+// staticCollidesWith: 按槽分组的第x个键与第[lo, hi)个键中是否有二级槽相同的
+constexpr bool staticCollidesWith(const std::uint64_t *h, const std::uint32_t *order, std::size_t j, unsigned t,
+                                  std::size_t c, std::size_t x, std::size_t lo, std::size_t hi)
+{
+    return hi == lo ? false
+         : hi - lo == 1 ? staticSecondSlot(h[order[x]], j, t, c) == staticSecondSlot(h[order[lo]], j, t, c)
+         : staticCollidesWith(h, order, j, t, c, x, lo, lo + (hi - lo) / 2)
+           || staticCollidesWith(h, order, j, t, c, x, lo + (hi - lo) / 2, hi);
+}
+// staticCollides: 第[lo, hi)个键中的每一个与它之后到end为止的键比较
+constexpr bool staticCollides(const std::uint64_t *h, const std::uint32_t *order, std::size_t j, unsigned t,
+                              std::size_t c, std::size_t lo, std::size_t hi, std::size_t end)
+{
+    return hi - lo == 1 ? staticCollidesWith(h, order, j, t, c, lo, lo + 1, end)
+         : staticCollides(h, order, j, t, c, lo, lo + (hi - lo) / 2, end)
+           || staticCollides(h, order, j, t, c, lo + (hi - lo) / 2, hi, end);
+}
+// staticSecondAttempt: 一级槽j(元素为order[g, g + c))第一个没有冲突的二级散列函数
+constexpr unsigned staticSecondAttempt(const std::uint64_t *h, const std::uint32_t *order, std::size_t j,
+                                       std::size_t c, std::size_t g, unsigned t)
+{
+    return c <= 1 ? 0
+         : t == static_perfect_hash_attempts ? throw std::logic_error("StaticPerfectHash error: duplicate keys!")
+         : !staticCollides(h, order, j, t, c, g, g + c, g + c) ? t : staticSecondAttempt(h, order, j, c, g, t + 1);
+}
+
+// StaticPerfectHashKeys: 键与它们的散列值
+template<typename Key, std::size_t N>
+struct StaticPerfectHashKeys
+{
+    typedef StaticKeyTraits<Key> Traits;
+    template<std::size_t... I>
+    constexpr StaticPerfectHashKeys(const Key (&k)[N], StaticIndices<I...>)
+        : keys{Traits::store(k[I])...}, hashes{Traits::hash(Traits::store(k[I]))...} {  }
+    typename Traits::Stored keys[N];
+    std::uint64_t hashes[N];
+};
+// StaticPerfectHashFirst: 选定的一级散列函数, 每个键的一级槽与每个一级槽的元素个数
+template<std::size_t N>
+struct StaticPerfectHashFirst
+{
+    template<std::size_t... I>
+    constexpr StaticPerfectHashFirst(const std::uint64_t *h, unsigned t, StaticIndices<I...>)
+        : attempt(t), bucket{staticFirstBucket(h[I], t, N)...},
+          count{static_cast<std::uint32_t>(staticCountBucket(h, t, N, I, 0, N))...} {  }
+    unsigned attempt;
+    std::uint32_t bucket[N];
+    std::uint32_t count[N];
+};
+// StaticPerfectHashGroups: 按一级槽分组(计数排序)以后每组的起点, 每个一级槽的二级槽的起点, 每个键在分组中的位置
+template<std::size_t N>
+struct StaticPerfectHashGroups
+{
+    template<std::size_t... I, std::size_t... J>
+    constexpr StaticPerfectHashGroups(const StaticPerfectHashFirst<N> &f, StaticIndices<I...>, StaticIndices<J...>)
+        : groupStart{static_cast<std::uint32_t>(staticSumRange(f.count, 0, I, false))...},
+          slotStart{static_cast<std::uint32_t>(staticSumRange(f.count, 0, I, true))...},
+          position{static_cast<std::uint32_t>(staticSumRange(f.count, 0, f.bucket[J], false)
+                                              + staticCountEqual(f.bucket, f.bucket[J], 0, J))...} {  }
+    std::uint32_t groupStart[N + 1];
+    std::uint32_t slotStart[N + 1];
+    std::uint32_t position[N];
+};
+// StaticPerfectHashOrder: 分组以后第r个位置上的键
+template<std::size_t N>
+struct StaticPerfectHashOrder
+{
+    template<std::size_t... I>
+    constexpr StaticPerfectHashOrder(const StaticPerfectHashGroups<N> &g, StaticIndices<I...>)
+        : order{static_cast<std::uint32_t>(staticFindValue(g.position, I, 0, N))...} {  }
+    std::uint32_t order[N];
+};
+// StaticPerfectHashSecond: 每个一级槽选定的二级散列函数
+template<std::size_t N>
+struct StaticPerfectHashSecond
+{
+    template<std::size_t... I>
+    constexpr StaticPerfectHashSecond(const std::uint64_t *h, const StaticPerfectHashFirst<N> &f,
+                                      const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o,
+                                      StaticIndices<I...>)
+        : attempt{staticSecondAttempt(h, o.order, I, f.count[I], g.groupStart[I], 0)...} {  }
+    unsigned attempt[N];
+};
+
+// staticFindBucket: slotStart[lo, hi)中最后一个不大于slot的下标(二级槽slot所属的一级槽)
+constexpr std::size_t staticFindBucket(const std::uint32_t *start, std::size_t slot, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 1 ? lo
+         : start[lo + (hi - lo) / 2] <= slot ? staticFindBucket(start, slot, lo + (hi - lo) / 2, hi)
+                                             : staticFindBucket(start, slot, lo, lo + (hi - lo) / 2);
+}
+// staticMemberAt: 一级槽j的元素order[lo, hi)中二级槽为target的键, 没有时为none
+constexpr std::size_t staticMemberAt(const std::uint64_t *h, const std::uint32_t *order, std::size_t j, unsigned t,
+                                     std::size_t c, std::size_t target, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 1 ? (staticSecondSlot(h[order[lo]], j, t, c) == target ? order[lo] : static_perfect_hash_none)
+         : staticFirstFound(staticMemberAt(h, order, j, t, c, target, lo, lo + (hi - lo) / 2),
+                            staticMemberAt(h, order, j, t, c, target, lo + (hi - lo) / 2, hi));
+}
+template<std::size_t N>
+constexpr std::uint32_t staticSlotInBucket(const std::uint64_t *h, const StaticPerfectHashFirst<N> &f,
+                                           const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o,
+                                           const StaticPerfectHashSecond<N> &s, std::size_t j, std::size_t slot)
+{
+    return static_cast<std::uint32_t>(staticFirstFound(
+        staticMemberAt(h, o.order, j, s.attempt[j], f.count[j], slot - g.slotStart[j], g.groupStart[j],
+                       g.groupStart[j] + f.count[j]), N));
+}
+// staticSlotKey: 二级槽slot中的键的下标, 空槽为N
+template<std::size_t N>
+constexpr std::uint32_t staticSlotKey(const std::uint64_t *h, const StaticPerfectHashFirst<N> &f,
+                                      const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o,
+                                      const StaticPerfectHashSecond<N> &s, std::size_t slot)
+{
+    return slot >= g.slotStart[N] ? static_cast<std::uint32_t>(N)
+         : staticSlotInBucket(h, f, g, o, s, staticFindBucket(g.slotStart, slot, 0, N), slot);
+}
+
+template<typename Key, std::size_t N>
+class StaticPerfectHash
+{
+    static_assert(N > 0, "StaticPerfectHash requires at least one key");
+public:
+    typedef StaticKeyTraits<Key> Traits;
+    typedef typename Traits::Stored Stored;
+    static const std::size_t npos = static_perfect_hash_none;
+    static const std::size_t slot_count = 4 * N + 1;    // 二级槽数组的长度
+    //**************************构造函数**********************************
+    // 由makeStaticPerfectHash的各个中间结果构造
+    template<std::size_t... I, std::size_t... S>
+    constexpr StaticPerfectHash(const StaticPerfectHashKeys<Key, N> &k, const StaticPerfectHashFirst<N> &f,
+                                const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o,
+                                const StaticPerfectHashSecond<N> &s, StaticIndices<I...>, StaticIndices<S...>)
+        : firstA(staticFirstA(f.attempt)), firstB(staticFirstB(f.attempt)), used(g.slotStart[N]),
+          buckets{Bucket{staticSecondA(I, s.attempt[I]), staticSecondB(I, s.attempt[I]), g.slotStart[I],
+                         f.count[I] * f.count[I]}...},
+          slots{staticSlotKey(k.hashes, f, g, o, s, S)...},
+          entries{Entry{k.hashes[I], k.keys[I]}..., Entry{Traits::hash(Traits::empty()) ^ 1, Traits::empty()}} {  }
+    //**************************成员函数**********************************
+    constexpr std::size_t size() const { return N; }
+    // used_slots: 实际使用的二级槽数(不超过4N)
+    constexpr std::size_t used_slots() const { return used; }
+    // key: 第i个键(字符串键为StaticString)
+    constexpr Stored key(std::size_t i) const { return entries[i].key; }
+    // find: 查找key, 返回它在建立时的数组中的下标, 不存在时为npos
+    template<typename Query>
+    std::size_t find(const Query &query) const
+    {
+        Stored key = Traits::query(query);
+        std::uint64_t h = Traits::runtimeHash(key);
+        std::uint32_t i = slots[slotOf(h)];
+        const Entry &entry = entries[i];
+        return entry.hash == h && Traits::runtimeEqual(entry.key, key) ? i : npos;
+    }
+    template<typename Query>
+    bool contains(const Query &query) const { return find(query) != npos; }
+    // index: 编译期的查找(例如static_assert或case标号), 结果与find相同
+    constexpr std::size_t index(const Key &key) const { return indexHashed(Traits::store(key), Traits::hash(Traits::store(key))); }
+
+private:
+    // Bucket: 一级槽的二级散列函数, 二级槽的起点与个数
+    struct Bucket
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+    struct Entry
+    {
+        std::uint64_t hash;
+        Stored key;
+    };
+    //**************************数据成员**********************************
+    std::uint64_t firstA;           // 一级散列函数range(firstA * k + firstB, N)
+    std::uint64_t firstB;
+    std::size_t used;
+    Bucket buckets[N];
+    std::uint32_t slots[4 * N + 1]; // 二级槽中的键的下标, 空槽为N
+    Entry entries[N + 1];           // 键与散列值, entries[N]是不会匹配的空条目
+
+    constexpr std::size_t slotOf(std::uint64_t h) const { return bucketSlot(buckets[staticRange(firstA * h + firstB, N)], h); }
+    static constexpr std::size_t bucketSlot(const Bucket &bucket, std::uint64_t h)
+    {
+        return bucket.offset + static_cast<std::size_t>(staticRange(bucket.a * h + bucket.b, bucket.size));
+    }
+    constexpr std::size_t indexHashed(Stored key, std::uint64_t h) const { return indexAt(key, h, slots[slotOf(h)]); }
+    constexpr std::size_t indexAt(Stored key, std::uint64_t h, std::uint32_t i) const
+    {
+        return entries[i].hash == h && Traits::equal(entries[i].key, key) ? i : npos;
+    }
+};
+template<typename Key, std::size_t N>
+const std::size_t StaticPerfectHash<Key, N>::npos;
+template<typename Key, std::size_t N>
+const std::size_t StaticPerfectHash<Key, N>::slot_count;
+
+// 建立的各个阶段, 每一步把前面的中间结果作为参数传给下一步
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> staticPerfectHashBuild(const StaticPerfectHashKeys<Key, N> &k, const StaticPerfectHashFirst<N> &f,
+                                                           const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o,
+                                                           const StaticPerfectHashSecond<N> &s)
+{
+    return StaticPerfectHash<Key, N>(k, f, g, o, s, typename MakeStaticIndices<N>::type(),
+                                     typename MakeStaticIndices<4 * N + 1>::type());
+}
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> staticPerfectHashBuild(const StaticPerfectHashKeys<Key, N> &k, const StaticPerfectHashFirst<N> &f,
+                                                           const StaticPerfectHashGroups<N> &g, const StaticPerfectHashOrder<N> &o)
+{
+    return staticPerfectHashBuild(k, f, g, o, StaticPerfectHashSecond<N>(k.hashes, f, g, o, typename MakeStaticIndices<N>::type()));
+}
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> staticPerfectHashBuild(const StaticPerfectHashKeys<Key, N> &k, const StaticPerfectHashFirst<N> &f,
+                                                           const StaticPerfectHashGroups<N> &g)
+{
+    return staticPerfectHashBuild(k, f, g, StaticPerfectHashOrder<N>(g, typename MakeStaticIndices<N>::type()));
+}
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> staticPerfectHashBuild(const StaticPerfectHashKeys<Key, N> &k, const StaticPerfectHashFirst<N> &f)
+{
+    return staticPerfectHashBuild(k, f, StaticPerfectHashGroups<N>(f, typename MakeStaticIndices<N + 1>::type(),
+                                                                      typename MakeStaticIndices<N>::type()));
+}
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> staticPerfectHashBuild(const StaticPerfectHashKeys<Key, N> &k)
+{
+    return staticPerfectHashBuild(k, StaticPerfectHashFirst<N>(k.hashes, staticFirstAttempt(k.hashes, N, 0),
+                                                               typename MakeStaticIndices<N>::type()));
+}
+
+// makeStaticPerfectHash: 由keys建立完全散列表, 在常量表达式中调用时在编译期完成
+template<typename Key, std::size_t N>
+constexpr StaticPerfectHash<Key, N> makeStaticPerfectHash(const Key (&keys)[N])
+{
+    return staticPerfectHashBuild(StaticPerfectHashKeys<Key, N>(keys, typename MakeStaticIndices<N>::type()));
+}
+#endif
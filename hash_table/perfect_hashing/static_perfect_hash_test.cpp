@@ -0,0 +1,145 @@
+/*************************************************************************
+	> File Name: static_perfect_hash_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时34分45秒
+ ************************************************************************/
+#include <iostream>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "static_perfect_hash.h"
+#include "../hasher/hasher.h"
+
+// C语言的关键字
+constexpr const char *keywords[] = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+    "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+    "volatile", "while", "_Alignas", "_Alignof", "_Atomic", "_Bool", "_Complex", "_Generic", "_Imaginary",
+    "_Noreturn", "_Static_assert", "_Thread_local"
+};
+constexpr StaticPerfectHash<const char *, 44> keywordTable = makeStaticPerfectHash(keywords);
+// 编译期的查找
+static_assert(keywordTable.index("while") == 33, "index of while");
+static_assert(keywordTable.index("auto") == 0, "index of auto");
+static_assert(keywordTable.index("main") == StaticPerfectHash<const char *, 44>::npos, "main is not a keyword");
+static_assert(keywordTable.used_slots() <= 4 * 44, "at most 4n second-level slots");
+
+enum class Color { red = 3, green = 7, blue = 11 };
+constexpr Color colors[] = {Color::blue, Color::red, Color::green};
+constexpr StaticPerfectHash<Color, 3> colorTable = makeStaticPerfectHash(colors);
+static_assert(colorTable.index(Color::green) == 2, "index of green");
+
+// 256个整数键
+constexpr std::uint64_t squares[] = {
+#define SQ4(i) (i) * (i) * 7919, ((i) + 1) * ((i) + 1) * 7919, ((i) + 2) * ((i) + 2) * 7919, ((i) + 3) * ((i) + 3) * 7919
+#define SQ16(i) SQ4(i), SQ4((i) + 4), SQ4((i) + 8), SQ4((i) + 12)
+#define SQ64(i) SQ16(i), SQ16((i) + 16), SQ16((i) + 32), SQ16((i) + 48)
+    SQ64(0ull), SQ64(64ull), SQ64(128ull), SQ64(192ull)
+#undef SQ64
+#undef SQ16
+#undef SQ4
+};
+constexpr StaticPerfectHash<std::uint64_t, 256> squareTable = makeStaticPerfectHash(squares);
+
+// 用switch分派关键字: case标号是编译期的查找结果
+int keywordClass(const std::string &word)
+{
+    switch (keywordTable.find(word)){
+    case keywordTable.index("if"): case keywordTable.index("else"): case keywordTable.index("switch"):
+    case keywordTable.index("case"): case keywordTable.index("default"):
+        return 1;
+    case keywordTable.index("for"): case keywordTable.index("while"): case keywordTable.index("do"):
+        return 2;
+    case StaticPerfectHash<const char *, 44>::npos:
+        return 0;
+    default:
+        return 3;
+    }
+}
+
+void string_test()
+{
+    bool correct = true;
+    for (std::size_t i = 0; i != 44; ++i){
+        std::string word(keywords[i]);
+        correct = correct && keywordTable.find(keywords[i]) == i && keywordTable.find(word) == i
+                  && keywordTable.find(StaticString{word.data(), word.size()}) == i && keywordTable.index(keywords[i]) == i
+                  && keywordTable.key(i).data == keywords[i];
+    }
+    std::cout << "所有关键字的运行时与编译期查找: " << (correct ? "正确" : "错误") << std::endl;
+    const char *misses[] = {"", "main", "Auto", "whil", "whilee", "_Alignas_", "printf"};
+    bool missed = true;
+    for (const char *word : misses)
+        missed = missed && keywordTable.find(word) == keywordTable.npos && !keywordTable.contains(std::string(word));
+    // 长度不同的前缀
+    missed = missed && keywordTable.find(StaticString{"continue", 4}) == keywordTable.npos
+                    && keywordTable.find(StaticString{"double", 2}) == keywordTable.index("do");
+    std::cout << "不是关键字的字符串: " << (missed ? "正确" : "错误") << std::endl;
+    bool dispatch = keywordClass("else") == 1 && keywordClass("while") == 2 && keywordClass("int") == 3
+                    && keywordClass("x") == 0;
+    std::cout << "switch分派: " << (dispatch ? "正确" : "错误") << std::endl;
+    bool hashes = true;
+    for (const char *word : keywords)
+        hashes = hashes && StaticKeyTraits<const char *>::runtimeHash(StaticKeyTraits<const char *>::query(word))
+                           == StaticKeyTraits<const char *>::hash(StaticKeyTraits<const char *>::store(word));
+    std::cout << "运行时与编译期的散列值相同: " << (hashes ? "正确" : "错误") << std::endl;
+}
+
+void integer_test()
+{
+    bool correct = squareTable.used_slots() <= 4 * 256;
+    for (std::size_t i = 0; i != 256; ++i)
+        correct = correct && squareTable.find(squares[i]) == i && squareTable.key(i) == squares[i];
+    std::mt19937_64 random(1);
+    for (int i = 0; i != 100000; ++i){
+        std::uint64_t key = random();
+        std::size_t index = squareTable.find(key);
+        correct = correct && (index == squareTable.npos || squares[index] == key);
+    }
+    for (std::uint64_t k = 0; k != 2000; ++k){
+        std::size_t index = squareTable.find(k);
+        correct = correct && (index != squareTable.npos) == (k == 0);    // 小于2000的键只有0
+    }
+    std::cout << "256个整数键(" << squareTable.used_slots() << "个二级槽): " << (correct ? "正确" : "错误") << std::endl;
+    bool colorsFound = colorTable.find(Color::blue) == 0 && colorTable.find(Color::red) == 1
+                       && colorTable.find(static_cast<Color>(0)) == colorTable.npos;
+    std::cout << "枚举键: " << (colorsFound ? "正确" : "错误") << std::endl;
+    bool mixed = true;
+    for (std::uint64_t k = 0; k != 1000; ++k)
+        mixed = mixed && staticHashInteger(k * 0x9e3779b97f4a7c15ull) == hashInteger(k * 0x9e3779b97f4a7c15ull)
+                && staticRange(hashInteger(k), 1000 + k) == hashRange(hashInteger(k), 1000 + k);
+    std::cout << "与hasher.h的散列函数相同: " << (mixed ? "正确" : "错误") << std::endl;
+}
+
+void runtime_test()
+{
+    // 不在常量表达式中调用时在运行时建立, 重复的键抛出异常(常量表达式中是编译错误)
+    const int keys[] = {5, 1, 9, 1};
+    bool thrown = false;
+    try{
+        StaticPerfectHash<int, 4> table = makeStaticPerfectHash(keys);
+        std::cout << table.size();
+    }catch (const std::logic_error &){
+        thrown = true;
+    }
+    std::cout << "重复的键抛出异常: " << (thrown ? "正确" : "错误") << std::endl;
+    const int single[] = {42};
+    StaticPerfectHash<int, 1> one = makeStaticPerfectHash(single);
+    std::cout << "一个键: " << (one.find(42) == 0 && one.find(0) == one.npos && one.find(43) == one.npos ? "正确" : "错误")
+              << std::endl;
+}
+
+int main()
+{
+    std::cout << "********字符串键的测试********\n";
+    string_test();
+    std::cout << "********整数键的测试********\n";
+    integer_test();
+    std::cout << "********运行时建立的测试********\n";
+    runtime_test();
+    return 0;
+}
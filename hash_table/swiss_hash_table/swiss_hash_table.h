@@ -0,0 +1,357 @@
+/*************************************************************************
+	> File Name: swiss_hash_table.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时49分22秒
+ ************************************************************************/
+
+#ifndef _SWISS_HASH_TABLE_H
+#define _SWISS_HASH_TABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../hasher/hasher.h"
+#include "../hash_stats/hash_stats.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const std::size_t swiss_group_width = 16;      // 每组的槽数, 一条SSE2指令比较一组的控制字节
+// 控制字节: 最高位为1表示槽中没有元素, 为0时低7位是散列值的低7位(H2)
+const std::int8_t swiss_empty = -128;           // 0b10000000: 空槽, 查找到这里结束
+const std::int8_t swiss_deleted = -2;           // 0b11111110: 墓碑, 查找经过它继续
+
+// SwissHashTable: 按组探查的开放寻址散列表(Swiss table)
+/*
+ * 数据结构: 槽分为若干组, 每组是16个控制字节和紧随其后的16个槽, 组数为2的幂:
+ *      --控制字节只有1个字节, 满槽保存散列值的低7位H2; 元素与它的控制字节放在一起, 找到候选槽以后
+ *        通常不需要再访问另一块内存;
+ *      --散列值的高位H1决定起始组, 之后按三角数序列 g, g+1, g+3, g+6, ... 探查各组(组数为2的幂时能访问所有组);
+ *      --在一个组中查找: 用一条比较指令同时比较16个控制字节与H2, movemask得到候选槽的位掩码, 只有H2相同的槽
+ *        (误判率1/128)才比较键; 组中有空槽时说明插入时从未越过这个组, 查找结束.
+ *
+ * 删除: 组中还有空槽时直接把槽标为空(没有任何元素的探查越过这个组), 否则标为墓碑.
+ * 扩容: 元素与墓碑的总数达到容量的7/8时再散列; 若元素不到容量的7/16, 说明主要是墓碑, 按原容量重建即可,
+ *      否则容量加倍. 装载因子最大为87.5%, 这时候一次查找通常只访问一个组, 即一到两个缓存行.
+ *
+ * 不支持SSE2时用逐字节比较的等价实现. 控制字节与组的选择分别用到散列值的低位与高位, 散列值的每一位都要足够随机,
+ * 默认使用DefaultHasher(见hasher.h), 不直接使用std::hash(对整数通常是恒等函数).
+ *
+ */
+template<typename Key, typename Value, typename Hasher = DefaultHasher<Key>, typename KeyEqual = std::equal_to<Key>>
+class SwissHashTable
+{
+public:
+    //***************************构造函数*********************************
+    explicit SwissHashTable(std::size_t capacity = 0, Hasher h = Hasher(), KeyEqual eq = KeyEqual())
+        : currentSize(0), tombstones(0), hasher(h), equal(eq)
+    {
+        reserve(capacity);
+    }
+    SwissHashTable(const SwissHashTable &other)
+        : currentSize(0), tombstones(0), hasher(other.hasher), equal(other.equal)
+    {
+        reserve(other.currentSize);
+        other.forEach([this](const Key &key, const Value &value){ insert(key, value); });
+    }
+    SwissHashTable(SwissHashTable &&other)
+        : groups(std::move(other.groups)), currentSize(other.currentSize), tombstones(other.tombstones),
+          hasher(other.hasher), equal(other.equal)
+    {
+        other.groups.clear();
+        other.currentSize = other.tombstones = 0;
+    }
+    SwissHashTable& operator=(SwissHashTable other)
+    {
+        swap(other);
+        return *this;
+    }
+    ~SwissHashTable() { destroyAll(); }
+    //***************************成员函数*********************************
+    std::size_t size() const { return currentSize; }
+    bool empty() const { return currentSize == 0; }
+    std::size_t capacity() const { return groups.size() * swiss_group_width; }
+    float loadFactor() const { return capacity() == 0 ? 0.0f : static_cast<float>(currentSize) / capacity(); }
+
+    // find: 键为key的元素的值, 不存在时为nullptr
+    Value* find(const Key &key)
+    {
+        Slot *slot = locate(key, hasher(key));
+        return slot ? &slot->second : nullptr;
+    }
+    const Value* find(const Key &key) const { return const_cast<SwissHashTable *>(this)->find(key); }
+    bool contains(const Key &key) const { return find(key) != nullptr; }
+
+    // insert: 插入(key, value), key已经存在时不修改并返回false
+    bool insert(const Key &key, const Value &value)
+    {
+        std::uint64_t hash = hasher(key);
+        if (locate(key, hash) != nullptr)
+            return false;
+        new (claim(hash)) Slot(key, value);
+        return true;
+    }
+
+    // operator[]: key对应的值, 不存在时插入Value()
+    Value& operator[](const Key &key)
+    {
+        std::uint64_t hash = hasher(key);
+        Slot *slot = locate(key, hash);
+        if (slot == nullptr){
+            slot = static_cast<Slot *>(claim(hash));
+            new (slot) Slot(key, Value());
+        }
+        return slot->second;
+    }
+
+    // erase: 删除键为key的元素, 返回是否删除
+    bool erase(const Key &key)
+    {
+        std::uint64_t hash = hasher(key);
+        if (groups.empty())
+            return false;
+        std::size_t mask = groups.size() - 1;
+        std::size_t g = groupOf(hash) & mask;
+        for (std::size_t step = 1; ; g = (g + step++) & mask){
+            Group &group = groups[g];
+            for (unsigned bits = matchByte(group, h2(hash)); bits != 0; bits &= bits - 1){
+                unsigned i = lowestBit(bits);
+                if (equal(group.slot(i)->first, key)){
+                    group.slot(i)->~Slot();
+                    bool has_empty = matchByte(group, swiss_empty) != 0;
+                    group.control[i] = has_empty ? swiss_empty : swiss_deleted;
+                    tombstones += has_empty ? 0 : 1;
+                    --currentSize;
+                    return true;
+                }
+            }
+            if (matchByte(group, swiss_empty) != 0 || step > groups.size())
+                return false;
+        }
+    }
+
+    // reserve: 预留足够的容量, 插入n个元素时不需要再散列
+    void reserve(std::size_t n)
+    {
+        std::size_t needed = groupsFor(n);
+        if (needed > groups.size())
+            rehash(needed);
+    }
+
+    void clear()
+    {
+        destroyAll();
+        for (auto &group : groups)
+            group.reset();
+        currentSize = tombstones = 0;
+    }
+
+    // forEach: 对每个元素调用f(key, value), 次序不确定
+    template<typename Function>
+    void forEach(Function f) const
+    {
+        for (auto &group : groups)
+            for (std::size_t i = 0; i != swiss_group_width; ++i)
+                if (group.control[i] >= 0)
+                    f(group.slot(i)->first, group.slot(i)->second);
+    }
+
+    // stats: 统计信息(见hash_stats.h), 探查长度为访问过的组数
+    HashTableStats stats() const
+    {
+        HashTableStats result;
+        result.size = currentSize;
+        result.capacity = capacity();
+        result.tombstones = tombstones;
+        std::size_t mask = groups.size() - 1;
+        for (std::size_t target = 0; target != groups.size(); ++target){
+            for (std::size_t i = 0; i != swiss_group_width; ++i){
+                if (groups[target].control[i] < 0)
+                    continue;
+                // 沿着元素的探查序列数到它所在的组
+                std::size_t length = 1;
+                std::size_t g = groupOf(hasher(groups[target].slot(i)->first)) & mask;
+                for (std::size_t step = 1; g != target; g = (g + step++) & mask)
+                    ++length;
+                result.stored.add(length);
+            }
+        }
+        result.longestChain = static_cast<std::size_t>(result.stored.max);
+        counters.exportTo(result);
+        return result;
+    }
+    void resetStats() { counters.resetCounters(); }
+
+    void swap(SwissHashTable &other)
+    {
+        groups.swap(other.groups);
+        std::swap(currentSize, other.currentSize);
+        std::swap(tombstones, other.tombstones);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+    }
+private:
+    typedef std::pair<Key, Value> Slot;     // 槽中保存的元素(内部可修改键, 以便再散列时移动)
+    //***************************数据结构*********************************
+    struct Group
+    {
+        std::int8_t control[swiss_group_width];
+        typename std::aligned_storage<sizeof(Slot), alignof(Slot)>::type slots[swiss_group_width];
+
+        Slot* slot(std::size_t i) { return reinterpret_cast<Slot *>(&slots[i]); }
+        const Slot* slot(std::size_t i) const { return reinterpret_cast<const Slot *>(&slots[i]); }
+        void reset()
+        {
+            for (auto &c : control)
+                c = swiss_empty;
+        }
+    };
+    std::vector<Group> groups;      // 组数为0或2的幂; 槽中的元素由本类构造与析构
+    std::size_t currentSize;        // 元素个数
+    std::size_t tombstones;         // 墓碑个数
+    Hasher hasher;
+    KeyEqual equal;
+    HashStatsCounters counters;     // 运行时计数(定义HASH_TABLE_STATS时), 不随swap交换
+    //***************************私有成员函数*****************************
+    static std::int8_t h2(std::uint64_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+    static std::size_t groupOf(std::uint64_t hash) { return static_cast<std::size_t>(hash >> 7); }
+
+    // groupsFor: 容纳n个元素(装载因子不超过7/8)所需的组数, 为0或2的幂
+    static std::size_t groupsFor(std::size_t n)
+    {
+        if (n == 0)
+            return 0;
+        std::size_t result = 1;
+        while (result * swiss_group_width * 7 / 8 < n)
+            result <<= 1;
+        return result;
+    }
+
+    // matchByte: 组中控制字节等于c的槽的位掩码
+    static unsigned matchByte(const Group &group, std::int8_t c)
+    {
+#if defined(__SSE2__)
+        __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group.control));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(c))));
+#else
+        unsigned bits = 0;
+        for (std::size_t i = 0; i != swiss_group_width; ++i)
+            bits |= static_cast<unsigned>(group.control[i] == c) << i;
+        return bits;
+#endif
+    }
+    // matchFree: 空槽或墓碑(最高位为1)的位掩码
+    static unsigned matchFree(const Group &group)
+    {
+#if defined(__SSE2__)
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group.control))));
+#else
+        unsigned bits = 0;
+        for (std::size_t i = 0; i != swiss_group_width; ++i)
+            bits |= static_cast<unsigned>(group.control[i] < 0) << i;
+        return bits;
+#endif
+    }
+    static unsigned lowestBit(unsigned bits)
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+        unsigned i = 0;
+        for (; (bits & 1) == 0; bits >>= 1)
+            ++i;
+        return i;
+#endif
+    }
+
+    // locate: 查找键为key(散列值为hash)的元素
+    Slot* locate(const Key &key, std::uint64_t hash)
+    {
+        if (groups.empty())
+            return nullptr;
+        std::size_t mask = groups.size() - 1;
+        std::size_t g = groupOf(hash) & mask;
+        for (std::size_t step = 1; ; g = (g + step++) & mask){
+            Group &group = groups[g];
+            for (unsigned bits = matchByte(group, h2(hash)); bits != 0; bits &= bits - 1){
+                Slot *slot = group.slot(lowestBit(bits));
+                if (equal(slot->first, key)){
+                    counters.recordHit(step);
+                    return slot;
+                }
+            }
+            if (matchByte(group, swiss_empty) != 0 || step > groups.size()){
+                counters.recordMiss(step);
+                return nullptr;
+            }
+        }
+    }
+
+    // findFree: 探查序列上第一个空槽或墓碑(表中至少有一个空槽)
+    std::pair<Group *, unsigned> findFree(std::uint64_t hash)
+    {
+        std::size_t mask = groups.size() - 1;
+        std::size_t g = groupOf(hash) & mask;
+        for (std::size_t step = 1; ; g = (g + step++) & mask){
+            unsigned bits = matchFree(groups[g]);
+            if (bits != 0)
+                return std::make_pair(&groups[g], lowestBit(bits));
+        }
+    }
+
+    // claim: 为散列值为hash的新元素占用一个槽(必要时先再散列), 返回未构造的槽
+    void* claim(std::uint64_t hash)
+    {
+        if ((currentSize + tombstones + 1) > capacity() * 7 / 8){
+            // 墓碑占多数时按原容量重建, 否则容量加倍
+            std::size_t target = (currentSize + 1 <= capacity() * 7 / 16) ? groups.size() : groupsFor(currentSize + 1);
+            rehash(std::max<std::size_t>(target, 1));
+        }
+        std::pair<Group *, unsigned> free = findFree(hash);
+        if (free.first->control[free.second] == swiss_deleted)
+            --tombstones;
+        free.first->control[free.second] = h2(hash);
+        ++currentSize;
+        return free.first->slot(free.second);
+    }
+
+    // rehash: 把所有元素移动到count个组中, 同时清除所有墓碑
+    void rehash(std::size_t count)
+    {
+        counters.recordRehash();
+        HashStatsCounters::RehashTimer timer(counters);
+        std::vector<Group> old(count);
+        old.swap(groups);
+        for (auto &group : groups)
+            group.reset();
+        tombstones = 0;
+        for (auto &group : old){
+            for (std::size_t i = 0; i != swiss_group_width; ++i){
+                if (group.control[i] < 0)
+                    continue;
+                Slot *slot = group.slot(i);
+                std::uint64_t hash = hasher(slot->first);
+                std::pair<Group *, unsigned> free = findFree(hash);
+                free.first->control[free.second] = h2(hash);
+                new (free.first->slot(free.second)) Slot(std::move(*slot));
+                slot->~Slot();
+            }
+        }
+    }
+
+    void destroyAll()
+    {
+        if (std::is_trivially_destructible<Slot>::value)
+            return;
+        for (auto &group : groups)
+            for (std::size_t i = 0; i != swiss_group_width; ++i)
+                if (group.control[i] >= 0)
+                    group.slot(i)->~Slot();
+    }
+};
+#endif
@@ -0,0 +1,131 @@
+/*************************************************************************
+	> File Name: swiss_hash_table_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时52分05秒
+ ************************************************************************/
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "swiss_hash_table.h"
+
+// Tracked: 统计存活对象的个数, 检查所有元素都被正确析构
+struct Tracked
+{
+    static int alive;
+    int value;
+    Tracked(int v = 0): value(v) { ++alive; }
+    Tracked(const Tracked &other): value(other.value) { ++alive; }
+    ~Tracked() { --alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; return *this; }
+};
+int Tracked::alive = 0;
+
+// insert_test: 插入, 查找, 重复插入与operator[]
+void insert_test()
+{
+    SwissHashTable<std::string, int> table;
+    std::cout << "'cat,1234'是否插入成功: " << table.insert("cat", 1234) << std::endl;
+    std::cout << "再次插入'cat'是否插入成功: " << table.insert("cat", 1) << std::endl;
+    std::cout << "'Cat,111'是否插入成功: " << table.insert("Cat", 111) << std::endl;
+    table["act"] = 7;
+    std::cout << "'cat'的值: " << *table.find("cat") << ", 'act'的值: " << *table.find("act")
+              << ", 是否包含'tca': " << table.contains("tca") << std::endl;
+}
+
+// random_test: 随机的插入与删除, 结果与std::unordered_map相同
+void random_test()
+{
+    SwissHashTable<int, int> table;
+    std::unordered_map<int, int> expected;
+    std::mt19937 engine(2018);
+    std::uniform_int_distribution<int> key(0, 5000), op(0, 2);
+    bool correct = true;
+    for (int i = 0; i != 200000 && correct; ++i){
+        int k = key(engine);
+        switch (op(engine)){
+        case 0: correct = table.insert(k, i) == expected.insert(std::make_pair(k, i)).second; break;
+        case 1: correct = table.erase(k) == (expected.erase(k) == 1); break;
+        default:
+            correct = table.contains(k) == (expected.count(k) == 1) && (!table.contains(k) || *table.find(k) == expected[k]);
+        }
+        correct = correct && table.size() == expected.size();
+    }
+    std::cout << "随机插入删除与std::unordered_map一致: " << (correct ? "正确" : "错误")
+              << " (容量" << table.capacity() << ", 元素" << table.size() << ")" << std::endl;
+}
+
+// growth_test: 自动扩容, 装载因子不超过7/8; 反复插入删除时墓碑不会使容量无限增长
+void growth_test()
+{
+    SwissHashTable<long long, int> table;
+    bool correct = true;
+    for (long long i = 0; i != 100000; ++i){
+        table.insert(i * 1000003, static_cast<int>(i));
+        correct = correct && table.loadFactor() <= 0.875f;
+    }
+    for (long long i = 0; i != 100000; ++i)
+        correct = correct && table.find(i * 1000003) && *table.find(i * 1000003) == i;
+    std::cout << "插入100000个元素(容量" << table.capacity() << "): " << (correct ? "正确" : "错误") << std::endl;
+
+    SwissHashTable<int, int> churn;
+    for (int i = 0; i != 1000; ++i)
+        churn.insert(i, i);
+    std::size_t capacity = churn.capacity();
+    for (int i = 1000; i != 200000; ++i){
+        churn.erase(i - 1000);
+        churn.insert(i, i);
+    }
+    correct = churn.size() == 1000 && churn.capacity() == capacity && churn.contains(199999) && !churn.contains(5);
+    std::cout << "反复插入删除后容量不变: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// lifetime_test: 复制, 移动, 清空与析构时元素的构造析构成对出现
+void lifetime_test()
+{
+    {
+        SwissHashTable<int, Tracked> table;
+        for (int i = 0; i != 1000; ++i)
+            table.insert(i, Tracked(i));
+        for (int i = 0; i != 1000; i += 2)
+            table.erase(i);
+        SwissHashTable<int, Tracked> copy(table);
+        SwissHashTable<int, Tracked> moved(std::move(table));
+        bool correct = copy.size() == 500 && moved.size() == 500 && table.empty() &&
+                       copy.find(501)->value == 501 && !moved.contains(500);
+        std::cout << "复制与移动: " << (correct ? "正确" : "错误") << std::endl;
+        copy.clear();
+        table.insert(1, Tracked(1));
+    }
+    std::cout << "所有元素都被析构: " << (Tracked::alive == 0 ? "正确" : "错误") << std::endl;
+}
+
+// stats_test: 结构统计(没有定义HASH_TABLE_STATS, 运行时计数关闭)
+void stats_test()
+{
+    SwissHashTable<int, int> table;
+    for (int i = 0; i != 10000; ++i)
+        table.insert(i, i);
+    HashTableStats stats = table.stats();
+    bool correct = stats.size == 10000 && stats.capacity == table.capacity() && stats.stored.total == 10000;
+    // 装载因子不超过7/8时多数元素在起始组中
+    correct = correct && stats.stored.counts[1] > 5000 && stats.longestChain == stats.stored.max && !stats.counting;
+    std::cout << "统计信息: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********swiss hash table的insert测试********\n";
+    insert_test();
+    std::cout << "********swiss hash table的随机测试********\n";
+    random_test();
+    std::cout << "********swiss hash table的扩容测试********\n";
+    growth_test();
+    std::cout << "********swiss hash table的生命周期测试********\n";
+    lifetime_test();
+    std::cout << "********swiss hash table的统计信息测试********\n";
+    stats_test();
+
+    return 0;
+}
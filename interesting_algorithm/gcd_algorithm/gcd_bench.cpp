@@ -0,0 +1,72 @@
+/*************************************************************************
+	> File Name: gcd_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时33分00秒
+ ************************************************************************/
+// 辗转相除法, 二进制GCD与批量GCD的速度, 以CSV格式输出
+/*
+ * 用法: ./Bench [对数(默认2000000)]
+ *      --euclid: gcd(a, b), 每步一次%;
+ *      --binary: binaryGcd(a, b);
+ *      --batch: gcd(aBegin, aEnd, bBegin, out), 4对交错.
+ * 分别测量随机的64位与32位整数对.
+ *
+ * 输出的每一行: method,bits,pairs,ns_per_gcd
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "gcd.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 结果之和, 使编译器不能省略
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+void report(const char *method, int bits, std::size_t pairs, Clock::time_point begin)
+{
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    std::cout << method << ',' << bits << ',' << pairs << ',' << ns / pairs << '\n';
+}
+
+template<typename U>
+void run(std::size_t n, int bits)
+{
+    std::vector<U> a(n), b(n), out(n);
+    for (std::size_t i = 0; i != n; ++i){
+        a[i] = static_cast<U>(xorshift());
+        b[i] = static_cast<U>(xorshift());
+    }
+    auto begin = Clock::now();
+    for (std::size_t i = 0; i != n; ++i)
+        bench_sink += gcd(a[i], b[i]);
+    report("euclid", bits, n, begin);
+    begin = Clock::now();
+    for (std::size_t i = 0; i != n; ++i)
+        bench_sink += binaryGcd(a[i], b[i]);
+    report("binary", bits, n, begin);
+    begin = Clock::now();
+    gcd(a.begin(), a.end(), b.begin(), out.begin());
+    report("batch", bits, n, begin);
+    for (std::size_t i = 0; i != n; ++i)
+        bench_sink += out[i];
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    std::cout << "method,bits,pairs,ns_per_gcd\n";
+    run<std::uint64_t>(n, 64);
+    run<std::uint32_t>(n, 32);
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -5,10 +5,123 @@
 	> Created Time: 2018年11月06日 星期二 22时19分48秒
  ************************************************************************/
 
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 using std::cout;    using std::endl;
 #include "gcd.h"
 
+// 编译期求值
+static_assert(binaryGcd(48u, 18u) == 6 && binaryGcd(0, 7) == 7 && binaryGcd(0, 0) == 0, "binaryGcd");
+static_assert(binaryGcd(-12, 18) == 6u && binaryGcd(std::int64_t(1) << 40, std::int64_t(3) << 20) == (1u << 20), "binaryGcd");
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+// randomValue: 一半的情况下带有随机个数的公共因子2与3, 使最大公因数不总是1
+std::uint64_t randomValue(std::uint64_t common)
+{
+    std::uint64_t x = xorshift() >> (xorshift() % 64);
+    return xorshift() % 2 ? x * common : x;
+}
+
+// binaryTest: 与辗转相除法的结果相同(64位, 32位与有符号整数, 包括0)
+bool binaryTest()
+{
+    bool correct = true;
+    for (int i = 0; i != 100000 && correct; ++i){
+        std::uint64_t common = std::uint64_t(6) << (xorshift() % 20);
+        std::uint64_t a = randomValue(common), b = randomValue(common);
+        if (i % 50 == 0)
+            a = 0;
+        correct = binaryGcd(a, b) == gcd(a, b) && binaryGcd(b, a) == gcd(a, b);
+        std::uint32_t x = static_cast<std::uint32_t>(a), y = static_cast<std::uint32_t>(b);
+        correct = correct && binaryGcd(x, y) == gcd(x, y);
+        std::int64_t p = static_cast<std::int64_t>(a >> 1), q = -static_cast<std::int64_t>(b >> 1);
+        correct = correct && binaryGcd(p, q) == gcd<std::uint64_t>(a >> 1, b >> 1);
+    }
+    return correct && binaryGcd(INT64_MIN, std::int64_t(0)) == (std::uint64_t(1) << 63);
+}
+
+// extendedTest: g = a * x + b * y, 系数的范围, 逆元
+bool extendedTest()
+{
+    bool correct = true;
+    for (int i = 0; i != 100000 && correct; ++i){
+        std::int64_t a = static_cast<std::int64_t>(xorshift() >> 2) * (xorshift() % 2 ? 1 : -1);
+        std::int64_t b = static_cast<std::int64_t>(xorshift() >> (2 + xorshift() % 60));
+        if (i % 100 == 0)
+            b = 0;
+        BezoutResult<std::int64_t> r = extendedGcd(a, b);
+        correct = r.g == static_cast<std::int64_t>(binaryGcd(a, b)) &&
+                  static_cast<__int128>(a) * r.x + static_cast<__int128>(b) * r.y == r.g;
+        if (b != 0 && r.g != 0)
+            correct = correct && gcdAbs(r.x) <= gcdAbs(b) / r.g;
+    }
+    const std::uint64_t mods[] = {1000000007ull, 18446744073709551557ull, 1ull << 63, 12, 1};
+    for (std::uint64_t m : mods)
+        for (int i = 0; i != 1000; ++i){
+            std::uint64_t a = xorshift();
+            if (binaryGcd(a, m) != 1)
+                continue;
+            std::uint64_t inv = modInverse(a, m);
+            correct = correct && inv < m && static_cast<unsigned __int128>(a) * inv % m == 1 % m;
+        }
+    bool thrown = false;
+    try{
+        modInverse(6, 9);
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    return correct && thrown && modInverse(5, 1) == 0;
+}
+
+// lcmTest: 最小公倍数与溢出检查
+bool lcmTest()
+{
+    bool correct = lcm(4, 6) == 12 && lcm(-4, 6) == 12 && lcm(0, 5) == 0 &&
+                   lcm(std::uint64_t(1) << 62, std::uint64_t(6)) == (std::uint64_t(3) << 62);
+    int thrown = 0;
+    try{
+        lcm(std::uint64_t(1) << 62, std::uint64_t(7));
+    }catch (const std::overflow_error &){
+        ++thrown;
+    }
+    try{
+        lcm(65536, 65537);  // 大于INT_MAX
+    }catch (const std::overflow_error &){
+        ++thrown;
+    }
+    return correct && thrown == 2;
+}
+
+// batchTest: 批量计算与逐个计算相同(长度不是4的倍数, 含0, 有符号的输入)
+bool batchTest()
+{
+    bool correct = true;
+    for (std::size_t n = 0; n != 40 && correct; ++n){
+        std::vector<std::uint64_t> a(n), b(n), out(n);
+        for (std::size_t i = 0; i != n; ++i){
+            std::uint64_t common = std::uint64_t(10) << (xorshift() % 30);
+            a[i] = i % 7 == 3 ? 0 : randomValue(common);
+            b[i] = i % 11 == 5 ? 0 : randomValue(common);
+        }
+        correct = gcd(a.begin(), a.end(), b.begin(), out.begin()) == out.end();
+        for (std::size_t i = 0; i != n; ++i)
+            correct = correct && out[i] == binaryGcd(a[i], b[i]);
+    }
+    std::vector<int> x{12, -18, 0, 7, 100}, y{-8, 27, 0, 0, 75};
+    std::vector<unsigned> z(5);
+    gcd(x.begin(), x.end(), y.begin(), z.begin());
+    return correct && z == std::vector<unsigned>{4, 9, 0, 7, 25};
+}
+
 int main()
 {
     int value = gcd(10,2);
@@ -17,6 +130,11 @@ int main()
     unsigned value1 = gcd(1000,89);
     cout << "1000和89的最大公因数为: " << value1 << endl;
 
+    cout << "二进制GCD: " << (binaryTest() ? "正确" : "错误") << endl;
+    cout << "扩展欧几里得算法与逆元: " << (extendedTest() ? "正确" : "错误") << endl;
+    cout << "最小公倍数: " << (lcmTest() ? "正确" : "错误") << endl;
+    cout << "批量GCD: " << (batchTest() ? "正确" : "错误") << endl;
+
     return 0;
 }
 
@@ -0,0 +1,253 @@
+/*************************************************************************
+	> File Name: powMod.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时22分25秒
+ ************************************************************************/
+
+#ifndef _POWMOD_H
+#define _POWMOD_H
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+// 64位模数的模幂运算(Montgomery约简)与小矩阵的快速幂
+/*
+ * recursionPow没有模数, 结果超出T的范围时静默地溢出. 这里的函数都对一个64位的模数m取模, 中间结果用
+ * unsigned __int128(GCC与Clang在64位平台上提供).
+ *
+ * 都是constexpr: 标准为C++11(-std=c++0x), constexpr函数只能有一个return语句, 所以平方-乘的循环写成
+ * 尾递归(递归深度为指数的位数, 不超过64), 编译器在运行时把它优化为循环.
+ *
+ */
+typedef unsigned __int128 pow_uint128;
+
+// mulMod: a * b mod m(一次128位的除法, 慢, 只用于偶数模数与Montgomery的预计算)
+constexpr std::uint64_t mulMod(std::uint64_t a, std::uint64_t b, std::uint64_t m)
+{
+    return static_cast<std::uint64_t>(static_cast<pow_uint128>(a) * b % m);
+}
+
+// powModDivide: 用mulMod的平方-乘, base^exp mod m(m > 0)
+constexpr std::uint64_t powModDivideStep(std::uint64_t result, std::uint64_t base, std::uint64_t exp, std::uint64_t m)
+{
+    return exp == 0 ? result
+                    : powModDivideStep(exp & 1 ? mulMod(result, base, m) : result, mulMod(base, base, m), exp >> 1, m);
+}
+constexpr std::uint64_t powModDivide(std::uint64_t base, std::uint64_t exp, std::uint64_t m)
+{
+    return powModDivideStep(1 % m, base % m, exp, m);
+}
+
+// MontgomeryMod: 奇数模数m的Montgomery乘法(R = 2^64)
+/*
+ * x的Montgomery形式为xR mod m. 两个Montgomery形式的乘积ab(小于m * 2^64)用reduce约简为abR^{-1} mod m:
+ *      q = ab * m^{-1} mod 2^64, 则ab - q * m是2^64的倍数, 结果为(ab >> 64) - (q * m >> 64), 为负时加m.
+ * 只用乘法与减法, 没有除法. m^{-1} mod 2^64用Newton迭代求出(每次迭代正确的位数加倍), R^2 mod m用一次mulMod.
+ * 一个模数只构造一次, 之后的每次乘法为三次64位乘法.
+ *
+ */
+class MontgomeryMod
+{
+public:
+    // m必须是奇数(m为1时所有的结果为0)
+    constexpr explicit MontgomeryMod(std::uint64_t m)
+        : mod(m % 2 == 1 ? m : throw std::invalid_argument("MontgomeryMod error: modulus must be odd!")),
+          inv(inverse(m, m, 5)), r2(mulMod((0 - m) % m, (0 - m) % m, m))
+    {  }
+    constexpr std::uint64_t modulus() const { return mod; }
+    // toMont, fromMont: 普通形式与Montgomery形式的转换
+    constexpr std::uint64_t toMont(std::uint64_t x) const { return mul(x % mod, r2); }
+    constexpr std::uint64_t fromMont(std::uint64_t x) const { return reduce(x); }
+    // mul: Montgomery形式的乘法
+    constexpr std::uint64_t mul(std::uint64_t a, std::uint64_t b) const { return reduce(static_cast<pow_uint128>(a) * b); }
+    // one: 1的Montgomery形式
+    constexpr std::uint64_t one() const { return (0 - mod) % mod; }
+    // powMont: Montgomery形式的base的exp次幂(结果也是Montgomery形式)
+    constexpr std::uint64_t powMont(std::uint64_t base, std::uint64_t exp) const { return powStep(one(), base, exp); }
+    // pow: 普通形式的base^exp mod m
+    constexpr std::uint64_t pow(std::uint64_t base, std::uint64_t exp) const { return fromMont(powMont(toMont(base), exp)); }
+private:
+    std::uint64_t mod;
+    std::uint64_t inv;      // m^{-1} mod 2^64
+    std::uint64_t r2;       // R^2 mod m
+
+    // inverse: Newton迭代x = x(2 - mx), 初值x = m对奇数m正确3位, 5次迭代以后正确96位
+    static constexpr std::uint64_t inverse(std::uint64_t m, std::uint64_t x, int steps)
+    {
+        return steps == 0 ? x : inverse(m, x * (2 - m * x), steps - 1);
+    }
+    constexpr std::uint64_t reduce(pow_uint128 t) const
+    {
+        return subtract(static_cast<std::uint64_t>(t >> 64),
+                        static_cast<std::uint64_t>(static_cast<pow_uint128>(static_cast<std::uint64_t>(t) * inv) * mod >> 64));
+    }
+    constexpr std::uint64_t subtract(std::uint64_t high, std::uint64_t h) const
+    {
+        // 用掩码代替分支(两种情况各占一半, 分支预测不了)
+        return high - h + (mod & (0 - static_cast<std::uint64_t>(high < h)));
+    }
+    constexpr std::uint64_t powStep(std::uint64_t result, std::uint64_t base, std::uint64_t exp) const
+    {
+        return exp == 0 ? result : powStep(exp & 1 ? mul(result, base) : result, mul(base, base), exp >> 1);
+    }
+};
+
+// powMod: base^exp mod m, m为0时抛出std::invalid_argument
+/*
+ * 奇数模数(散列与分片常用的模数都是奇素数)用MontgomeryMod, 偶数模数用mulMod.
+ * 算法性能: O(log exp)次64位乘法(奇数模数)或128位除法(偶数模数).
+ *
+ */
+constexpr std::uint64_t powMod(std::uint64_t base, std::uint64_t exp, std::uint64_t m)
+{
+    return m == 0 ? throw std::invalid_argument("powMod error: modulus is zero!")
+                  : m % 2 == 1 ? MontgomeryMod(m).pow(base, exp) : powModDivide(base, exp, m);
+}
+
+// powMod: 批量计算out[i] = bases[i]^exp mod m
+/*
+ * 128位的乘积没有对应的SIMD指令(AVX2只有32位乘32位), 所以不用向量寄存器, 而是每次同时计算4个元素:
+ * 4个元素的指数相同, 平方-乘的控制流相同, 4条互不依赖的乘法链交错执行, 乘法器的流水线不会空等上一次乘法的结果.
+ * 模数只预计算一次. out可以等于bases.
+ *
+ */
+inline void powMod(const std::uint64_t *bases, std::size_t n, std::uint64_t exp, std::uint64_t m, std::uint64_t *out)
+{
+    if (m == 0)
+        throw std::invalid_argument("powMod error: modulus is zero!");
+    if (m % 2 == 0){
+        for (std::size_t i = 0; i != n; ++i)
+            out[i] = powModDivide(bases[i], exp, m);
+        return;
+    }
+    const MontgomeryMod mont(m);
+    const std::size_t lanes = 4;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes){
+        std::uint64_t base[lanes], result[lanes];
+        for (std::size_t j = 0; j != lanes; ++j){
+            base[j] = mont.toMont(bases[i + j]);
+            result[j] = mont.one();
+        }
+        for (std::uint64_t e = exp; e != 0; e >>= 1){
+            if (e & 1)
+                for (std::size_t j = 0; j != lanes; ++j)
+                    result[j] = mont.mul(result[j], base[j]);
+            for (std::size_t j = 0; j != lanes; ++j)
+                base[j] = mont.mul(base[j], base[j]);
+        }
+        for (std::size_t j = 0; j != lanes; ++j)
+            out[i + j] = mont.fromMont(result[j]);
+    }
+    for (; i != n; ++i)
+        out[i] = mont.pow(bases[i], exp);
+}
+
+// Matrix: N * N的小矩阵, 维数是模板参数
+/*
+ * 维数在编译期已知, 乘法的三重循环的次数都是常数: N不大时(N <= 4)编译器在-O2下完全展开, 没有循环的开销.
+ *
+ */
+template<typename T, std::size_t N>
+struct Matrix
+{
+    T a[N][N];
+
+    static Matrix identity()
+    {
+        Matrix m;
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != N; ++j)
+                m.a[i][j] = i == j ? T(1) : T(0);
+        return m;
+    }
+    T* operator[](std::size_t i) { return a[i]; }
+    const T* operator[](std::size_t i) const { return a[i]; }
+    bool operator==(const Matrix &other) const
+    {
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != N; ++j)
+                if (!(a[i][j] == other.a[i][j]))
+                    return false;
+        return true;
+    }
+};
+template<typename T, std::size_t N>
+Matrix<T, N> operator*(const Matrix<T, N> &x, const Matrix<T, N> &y)
+{
+    Matrix<T, N> r;
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t j = 0; j != N; ++j){
+            T sum = x.a[i][0] * y.a[0][j];
+            for (std::size_t k = 1; k != N; ++k)
+                sum = sum + x.a[i][k] * y.a[k][j];
+            r.a[i][j] = sum;
+        }
+    return r;
+}
+
+// matrixPow: m^exp(平方-乘, O(N^3 log exp)), T的运算自然溢出(无符号整数时即为mod 2^位数)
+template<typename T, std::size_t N>
+Matrix<T, N> matrixPow(Matrix<T, N> m, std::uint64_t exp)
+{
+    Matrix<T, N> result = Matrix<T, N>::identity();
+    for (; exp != 0; exp >>= 1){
+        if (exp & 1)
+            result = result * m;
+        m = m * m;
+    }
+    return result;
+}
+
+// matrixPowMod: 各元素对模数mod取模的m^exp
+/*
+ * 奇数模数时所有元素在Montgomery形式下相乘, 每个元素的N个乘积逐个约简再模加; 偶数模数用mulMod.
+ *
+ */
+template<std::size_t N>
+Matrix<std::uint64_t, N> matrixPowMod(const Matrix<std::uint64_t, N> &m, std::uint64_t exp, std::uint64_t mod)
+{
+    typedef Matrix<std::uint64_t, N> M;
+    if (mod == 0)
+        throw std::invalid_argument("matrixPowMod error: modulus is zero!");
+    const bool odd = mod % 2 == 1;
+    const MontgomeryMod mont(odd ? mod : 1);
+    // 奇数模数时x, result为Montgomery形式
+    M x, result;
+    for (std::size_t i = 0; i != N; ++i)
+        for (std::size_t j = 0; j != N; ++j){
+            x.a[i][j] = odd ? mont.toMont(m.a[i][j]) : m.a[i][j] % mod;
+            result.a[i][j] = i == j ? (odd ? mont.one() : 1 % mod) : 0;
+        }
+    auto multiply = [&](const M &p, const M &q){
+        M r;
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != N; ++j){
+                std::uint64_t sum = 0;
+                for (std::size_t k = 0; k != N; ++k){
+                    std::uint64_t term = odd ? mont.mul(p.a[i][k], q.a[k][j]) : mulMod(p.a[i][k], q.a[k][j], mod);
+                    sum = sum >= mod - term ? sum - (mod - term) : sum + term;
+                }
+                r.a[i][j] = sum;
+            }
+        return r;
+    };
+    for (; exp != 0; exp >>= 1){
+        if (exp & 1)
+            result = multiply(result, x);
+        x = multiply(x, x);
+    }
+    if (odd)
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t j = 0; j != N; ++j)
+                result.a[i][j] = mont.fromMont(result.a[i][j]);
+    return result;
+}
+
+// fibonacciMod: 第n个Fibonacci数mod m(F(0) = 0, F(1) = 1), [[1, 1], [1, 0]]^n的右上角元素
+inline std::uint64_t fibonacciMod(std::uint64_t n, std::uint64_t m)
+{
+    Matrix<std::uint64_t, 2> q = {{{1, 1}, {1, 0}}};
+    return matrixPowMod(q, n, m).a[0][1];
+}
+#endif
@@ -0,0 +1,71 @@
+/*************************************************************************
+	> File Name: powMod_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时25分08秒
+ ************************************************************************/
+// 模幂运算的速度: 128位除法, Montgomery(逐个与批量), 以及矩阵快速幂, 以CSV格式输出
+/*
+ * 用法: ./Bench [次数(默认1000000)]
+ *      --divide: powModDivide, 每次乘法一次128位除法(__umodti3);
+ *      --montgomery: powMod(奇数模数), 每次调用构造MontgomeryMod;
+ *      --montgomery_batch: 批量的powMod, 模数只预计算一次, 4条乘法链交错;
+ *      --fibonacci: fibonacciMod(2 * 2矩阵), n为随机的64位整数.
+ * 模数为最大的64位素数, 指数为随机的64位整数.
+ *
+ * 输出的每一行: method,count,ns_per_pow
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "powMod.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 结果之和, 使编译器不能省略
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+void report(const char *method, std::size_t count, Clock::time_point begin)
+{
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    std::cout << method << ',' << count << ',' << ns / count << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const std::uint64_t m = 18446744073709551557ull;
+    const std::uint64_t exp = xorshift();
+    std::vector<std::uint64_t> bases(n), out(n);
+    for (auto &b : bases)
+        b = xorshift();
+    std::cout << "method,count,ns_per_pow\n";
+    std::size_t slow = n / 10 + 1;
+    auto begin = Clock::now();
+    for (std::size_t i = 0; i != slow; ++i)
+        bench_sink += powModDivide(bases[i], exp, m);
+    report("divide", slow, begin);
+    begin = Clock::now();
+    for (std::size_t i = 0; i != n; ++i)
+        bench_sink += powMod(bases[i], exp, m);
+    report("montgomery", n, begin);
+    begin = Clock::now();
+    powMod(bases.data(), n, exp, m, out.data());
+    report("montgomery_batch", n, begin);
+    for (std::size_t i = 0; i != n; ++i)
+        bench_sink += out[i];
+    begin = Clock::now();
+    for (std::size_t i = 0; i != slow; ++i)
+        bench_sink += fibonacciMod(bases[i], m);
+    report("fibonacci", slow, begin);
+    return bench_sink == 0 ? 1 : 0;
+}
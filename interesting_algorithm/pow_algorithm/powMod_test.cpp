@@ -0,0 +1,142 @@
+/*************************************************************************
+	> File Name: powMod_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时27分51秒
+ ************************************************************************/
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "powMod.h"
+using std::cout;    using std::endl;
+
+// 编译期求值
+static_assert(powMod(2, 10, 1000000007) == 1024, "powMod");
+static_assert(powMod(3, 0, 1) == 0 && powMod(0, 0, 7) == 1, "powMod");
+static_assert(MontgomeryMod(1000000007).pow(2, 1000000006) == 1, "Fermat");
+static_assert(powMod(5, 117, 1ull << 40) == powModDivide(5, 117, 1ull << 40), "even modulus");
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// naivePow: 逐次相乘, 作为对照
+std::uint64_t naivePow(std::uint64_t base, std::uint64_t exp, std::uint64_t m)
+{
+    std::uint64_t r = 1 % m;
+    for (std::uint64_t i = 0; i != exp; ++i)
+        r = mulMod(r, base, m);
+    return r;
+}
+
+// randomTest: Montgomery与除法的结果相同(随机的奇数与偶数模数, 包括接近2^64的模数), 小指数时与逐次相乘相同
+bool randomTest()
+{
+    bool correct = true;
+    for (int i = 0; i != 20000 && correct; ++i){
+        std::uint64_t m = xorshift() >> (xorshift() % 64);
+        if (m == 0)
+            m = 1;
+        if (i % 4 == 0)
+            m = ~0ull - (xorshift() % 100);
+        std::uint64_t base = xorshift(), exp = i % 2 ? xorshift() : xorshift() % 50;
+        correct = powMod(base, exp, m) == powModDivide(base, exp, m);
+        if (exp < 50)
+            correct = correct && powMod(base, exp, m) == naivePow(base, exp, m);
+    }
+    // Fermat小定理: 2^61 - 1与最大的64位素数
+    const std::uint64_t primes[] = {2305843009213693951ull, 18446744073709551557ull, 998244353ull};
+    for (std::uint64_t p : primes)
+        for (int i = 0; i != 100; ++i){
+            std::uint64_t a = xorshift() % (p - 1) + 1;
+            correct = correct && powMod(a, p - 1, p) == 1 && powMod(a, p, p) == a;
+        }
+    return correct;
+}
+
+// batchTest: 批量计算与逐个计算相同(包括不足4个的尾部与偶数模数), out可以等于bases
+bool batchTest()
+{
+    bool correct = true;
+    for (std::size_t n = 0; n != 38 && correct; ++n){
+        std::uint64_t m = n % 3 == 0 ? 1000000007ull : (n % 3 == 1 ? (xorshift() | 1) : (xorshift() & ~1ull));
+        std::uint64_t exp = xorshift();
+        std::vector<std::uint64_t> bases(n), out(n);
+        for (auto &b : bases)
+            b = xorshift();
+        powMod(bases.data(), n, exp, m, out.data());
+        for (std::size_t i = 0; i != n; ++i)
+            correct = correct && out[i] == powModDivide(bases[i], exp, m);
+        powMod(bases.data(), n, exp, m, bases.data());
+        correct = correct && bases == out;
+    }
+    return correct;
+}
+
+// matrixTest: Fibonacci数(自然溢出与取模), 3 * 3矩阵的幂与逐次相乘相同
+bool matrixTest()
+{
+    bool correct = true;
+    Matrix<std::uint64_t, 2> q = {{{1, 1}, {1, 0}}};
+    std::uint64_t a = 0, b = 1;
+    for (std::uint64_t n = 0; n != 200; ++n){
+        // F(n)的自然溢出值(mod 2^64)
+        correct = correct && matrixPow(q, n).a[0][1] == a;
+        std::uint64_t c = a + b;
+        a = b;
+        b = c;
+    }
+    const std::uint64_t mods[] = {1000000007ull, 1ull << 32, 18446744073709551557ull, 1};
+    for (std::uint64_t m : mods){
+        std::uint64_t x = 0, y = 1 % m;
+        for (std::uint64_t n = 0; n != 3000; ++n){
+            correct = correct && fibonacciMod(n, m) == x;
+            std::uint64_t z = x >= m - y ? x - (m - y) : x + y;
+            x = y;
+            y = z;
+        }
+    }
+    // Pisano周期: F(n)模10的周期为60
+    correct = correct && fibonacciMod(1000000000000000000ull, 10) == fibonacciMod(1000000000000000000ull % 60, 10);
+    Matrix<std::uint64_t, 3> m3;
+    for (std::size_t i = 0; i != 3; ++i)
+        for (std::size_t j = 0; j != 3; ++j)
+            m3[i][j] = xorshift() % 1000;
+    Matrix<std::uint64_t, 3> power = Matrix<std::uint64_t, 3>::identity(), modPower = power;
+    for (int e = 0; e != 40; ++e){
+        correct = correct && matrixPow(m3, e) == power && matrixPowMod(m3, e, 998244353) == modPower;
+        power = power * m3;
+        Matrix<std::uint64_t, 3> next;
+        for (std::size_t i = 0; i != 3; ++i)
+            for (std::size_t j = 0; j != 3; ++j){
+                std::uint64_t s = 0;
+                for (std::size_t k = 0; k != 3; ++k)
+                    s = (s + mulMod(modPower[i][k], m3[k][j], 998244353)) % 998244353;
+                next[i][j] = s;
+            }
+        modPower = next;
+    }
+    return correct;
+}
+
+int main()
+{
+    cout << "Montgomery与除法的模幂: " << (randomTest() ? "正确" : "错误") << endl;
+    cout << "批量模幂: " << (batchTest() ? "正确" : "错误") << endl;
+    cout << "矩阵快速幂: " << (matrixTest() ? "正确" : "错误") << endl;
+    bool thrown = false;
+    try{
+        powMod(2, 3, 0);
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    cout << "模数为0时抛出异常: " << (thrown ? "正确" : "错误") << endl;
+    return 0;
+}
@@ -18,8 +18,12 @@
  * 当N是奇数的时候我们有 x^N = x^{(N-1)/2} * x^{(N-1)/2} * x;
  * 根据递归的思想解决.
 */
+/*
+ * 原来的名字pow与std::pow(以及<cmath>中的::pow)冲突: pow(2.2, 2)调用哪一个取决于包含了哪些头文件.
+ * 没有模数, 结果超出T的范围时溢出; 模幂运算与矩阵快速幂见powMod.h.
+*/
 template<typename T>
-T pow(T num1, unsigned long long num2)
+T recursionPow(T num1, unsigned long long num2)
 {
     // 基准情形
     if (num2 == 1)
@@ -28,8 +32,8 @@ T pow(T num1, unsigned long long num2)
         return 1;
     // 递归求幂运算
     if (num2 % 2 == 0)
-        return pow(num1 * num1, num2 / 2);
+        return recursionPow(num1 * num1, num2 / 2);
     else
-        return pow(num1 * num1, num2 / 2) * num1;
+        return recursionPow(num1 * num1, num2 / 2) * num1;
 }
 #endif
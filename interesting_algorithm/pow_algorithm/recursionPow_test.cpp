@@ -12,8 +12,8 @@ using std::cout;    using std::endl;
 
 int main()
 {
-    double value1 = pow(2.2,2);
-    double value3 = pow(2.2222222, 5);
+    double value1 = recursionPow(2.2,2);
+    double value3 = recursionPow(2.2222222, 5);
     double value2 = std::pow(2.2,2);
     double value4 = std::pow(2.2222222, 5);
     cout << "递归求幂运算\t数学库求幂\n";
@@ -9,25 +9,58 @@
 #define _CIRCULARLIST_H
 #include <memory>
 #include <iostream>
+#include <utility>
 #include "../doublyLinkedListNode/doublyLinkedListNode.h"
 // CircularList: 带有哨兵的循环链表
 /*
  * nil: 哨兵双向循环链表.
  * 待有哨兵双向循环链表的优势就在于边界条件的处理.
+ * splice(ptr,other)与concat(other)把另一个链表的所有节点接到ptr后面(nil->prev后面), O(1).
+ *
+ * Alloc: 节点(包括哨兵)的分配器, 节点用std::allocate_shared创建(默认的std::allocator与make_shared相同);
+ * 用ArenaAllocator<NodeT>(tree_algorithm/NodeArena)时每个默认构造的链表有自己的NodeArena(空闲链表重用删除的节点).
+ * 节点与哨兵形成环: 析构与clear逐个断开节点的prev与next再释放, 析构时最后断开哨兵自己的环.
 */
-template<typename NodeT>
+template<typename NodeT, typename Alloc = std::allocator<NodeT>>
 class CircularList
 {
 public:
     typedef NodeT NodeType;     // 链表的节点类型
     typedef typename NodeT::KeyType KeyType;        // 链表节点存储的数据类型
+    typedef Alloc AllocatorType;    // 节点的分配器类型
     //*******************************构造函数*****************************
-    CircularList()
+    explicit CircularList(const Alloc &a = Alloc()):
+        alloc(a)
     {  
-        auto data = std::make_shared<NodeType>(0);
-        nil = data;
-        nil->next = data;
-        nil->prev = data;
+        makeSentinel();
+    }
+    // 复制构造函数: 逐个复制关键字(不共享节点)
+    CircularList(const CircularList &other):
+        alloc(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc))
+    {
+        makeSentinel();
+        for (auto current = other.nil->next; current != other.nil; current = current->next){
+            auto prev = nil->prev;
+            insert(prev, current->key);
+        }
+    }
+    CircularList(CircularList &&other):
+        alloc(other.alloc)
+    {
+        makeSentinel();
+        std::swap(nil, other.nil);
+    }
+    CircularList& operator=(CircularList other)
+    {
+        std::swap(nil, other.nil);
+        std::swap(alloc, other.alloc);
+        return *this;
+    }
+    ~CircularList()
+    {
+        clear();
+        nil->next.reset();
+        nil->prev.reset();
     }
     //*******************************成员函数*****************************   
     // insertBack: 不断的在nil->next插入元素
@@ -38,7 +71,7 @@ public:
     bool insertBack(const KeyType &key)
     {
         bool sign = false;
-        auto data = std::make_shared<NodeType>(key);
+        auto data = std::allocate_shared<NodeType>(alloc, key);
         data->next = nil->next;
         data->prev = nil;
         nil->next->prev = data;
@@ -59,7 +92,7 @@ public:
         bool sign = false;
         if (ptr == NULL)
             return sign;
-        auto data = std::make_shared<NodeType>(key);
+        auto data = std::allocate_shared<NodeType>(alloc, key);
         data->next = ptr->next;
         data->prev = ptr;
         ptr->next->prev = data;
@@ -99,6 +132,55 @@ public:
         sign = true;
         return sign;
     }
+    // splice: 把other的所有节点接到ptr后面, other成为空链表
+    /*
+     * \parameter ptr: 本链表中的节点或哨兵(为了O(1)不检查它是否属于本链表);
+     * \parameter other: 另一个链表, 节点直接移动过来, 不复制;
+     * \return sign(ptr为空或other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool splice(const std::shared_ptr<NodeType> &ptr, CircularList &other)
+    {
+        if (ptr == NULL || &other == this)
+            return false;
+        if (other.nil->next == other.nil)
+            return true;
+        auto first = other.nil->next, last = other.nil->prev;
+        other.nil->next = other.nil;
+        other.nil->prev = other.nil;
+        last->next = ptr->next;
+        ptr->next->prev = last;
+        first->prev = ptr;
+        ptr->next = first;
+        return true;
+    }
+    // concat: 把other的所有节点接到链表的尾部(nil->prev后面), other成为空链表
+    /*
+     * \return sign(other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool concat(CircularList &other)
+    {
+        auto last = nil->prev;
+        return splice(last, other);
+    }
+    // clear: 逐个断开并释放哨兵以外的所有节点
+    /*
+     * 算法复杂度: O(N).
+    */
+    void clear()
+    {
+        auto current = std::move(nil->next);
+        while (current != nil){
+            auto next = std::move(current->next);
+            current->prev.reset();
+            current = std::move(next);
+        }
+        nil->next = nil;
+        nil->prev = nil;
+    }
+    bool empty() const { return nil->next == nil; }
+
     // order_print: 顺序遍历链表(从哨兵的next开始)
     /*
      * 当nil->next==nil的时候循环链表为空链表.
@@ -130,5 +212,14 @@ public:
 private:
     //*******************************数据结构*****************************
     std::shared_ptr<NodeType> nil;  // 哨兵
+    Alloc alloc;                    // 节点的分配器
+
+    void makeSentinel()
+    {
+        auto data = std::allocate_shared<NodeType>(alloc, 0);
+        nil = data;
+        nil->next = data;
+        nil->prev = data;
+    }
 };
 #endif
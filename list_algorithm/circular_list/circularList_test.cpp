@@ -6,10 +6,14 @@
  ************************************************************************/
 
 #include <iostream>
+#include <memory>
+#include <vector>
 using std::cout;    using std::endl;
 #include "circularList.h"
 #include "../doublyLinkedListNode/doublyLinkedListNode.h"
+#include "../../tree_algorithm/NodeArena/NodeArena.h"
 typedef CircularList<DoublyLinkedListNode<int>> IntList;
+typedef CircularList<DoublyLinkedListNode<int>, ArenaAllocator<DoublyLinkedListNode<int>>> PooledList;
 
 void initList_test()
 {
@@ -75,6 +79,53 @@ void deleteList_test()
     cout << "逆序输出:\n";
     intlist.reverse_order_print();
 }
+// keysOf: 从first开始顺序(reverse为true时逆序)取出关键字, 遇到哨兵(关键字为0)为止
+template<typename ListType>
+std::vector<int> keysOf(ListType &list, int first, bool reverse = false)
+{
+    std::vector<int> keys;
+    for (auto current = list.search(first); current->key != 0; current = reverse ? current->prev : current->next)
+        keys.push_back(current->key);
+    return keys;
+}
+// splice_test: splice与concat之后正序与逆序都正确, 复制不共享节点
+void splice_test()
+{
+    IntList a, b, c;
+    for (int i = 1; i <= 3; ++i){
+        a.insertBack(i);        // insertBack插入在哨兵后面: a为3 2 1
+        b.insertBack(10 + i);
+        c.insertBack(20 + i);
+    }
+    auto node = a.search(2);
+    bool correct = a.splice(node, b) && b.empty() && a.concat(c) && c.empty() && !a.concat(a);
+    std::vector<int> expected{3, 2, 13, 12, 11, 1, 23, 22, 21};
+    correct = correct && keysOf(a, 3) == expected && keysOf(a, 21, true) == std::vector<int>(expected.rbegin(), expected.rend());
+    IntList copy(a);
+    a.clear();
+    correct = correct && a.empty() && keysOf(copy, 3) == expected;
+    cout << "splice与concat: " << (correct ? "正确" : "错误") << endl;
+}
+// release_test: 析构时断开节点与哨兵的环, 所有节点(与NodeArena)都被释放; 长链表的析构不会栈溢出
+void release_test()
+{
+    std::weak_ptr<NodeArena> watch;
+    std::weak_ptr<DoublyLinkedListNode<int>> plainNode;
+    {
+        ArenaAllocator<DoublyLinkedListNode<int>> allocator;
+        watch = allocator.arena;
+        PooledList list(allocator);
+        allocator.arena.reset();
+        for (int i = 1; i <= 1000000; ++i)
+            list.insertBack(i);
+        IntList plain;
+        for (int i = 1; i <= 1000000; ++i)
+            plain.insertBack(i);
+        plainNode = plain.search(500000);
+    }
+    cout << "节点的释放: " << (watch.expired() && plainNode.expired() ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     cout << "***************************循环链表默认构造函数***************************\n";
@@ -87,6 +138,10 @@ int main()
     insert_test();
     cout << "*******************************循环链表删除*******************************\n";
     deleteList_test();
+    cout << "***************************splice, concat与复制***************************\n";
+    splice_test();
+    cout << "*****************************长链表与节点池*******************************\n";
+    release_test();
 
     return 0;
 }
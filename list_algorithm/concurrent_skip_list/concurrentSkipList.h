@@ -0,0 +1,329 @@
+/*************************************************************************
+	> File Name: concurrentSkipList.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时49分59秒
+ ************************************************************************/
+
+#ifndef _CONCURRENTSKIPLIST_H
+#define _CONCURRENTSKIPLIST_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include "../../parallel_algorithm/epoch_reclamation/epochReclamation.h"
+
+const int skiplist_max_height = 24;     // 塔的最大高度, 足够容纳2^24以上个元素
+
+// ConcurrentSkipList: 无锁的有序映射(Herlihy & Shavit的无锁跳表, 纪元回收)
+/*
+ * 数据结构: 每个结点的塔(各层的next指针)与键, 值分配在同一块内存中, 塔的高度按1/2的概率几何分布.
+ * next指针的最低位是删除标记: 结点某一层的next被标记, 表示它在这一层已经被逻辑删除, 不能再在它之后插入.
+ *
+ *      --search/contains/successor: 进入纪元临界区, 从最高层向下查找, 跳过被标记的结点, 不写任何共享数据;
+ *      --insert: find找到每一层的前驱与后继, 先用CAS把新结点接入第0层(这时插入生效), 再逐层向上接入;
+ *        某一层的CAS失败时重新find. 上层还没接完时结点可能已经被删除, 这时停止接入, 再find一次把它摘掉;
+ *      --remove: 先从上到下标记结点各层的next(逻辑删除), 标记第0层成功的线程是删除者, 然后find把结点从各层
+ *        摘下(物理删除). find在遍历时也会顺便用CAS摘下遇到的被标记的结点.
+ * 插入者与删除者都完成以后(结点中的计数减为0)才把结点交给EpochDomain, 保证那时它已经不在任何一层中.
+ *
+ * 所有操作都不加锁: 一个线程的CAS失败说明另一个线程的操作成功了(lock-free), 读者不会失败(wait-free).
+ * 析构时不能有其它线程正在使用跳表.
+ *
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+class ConcurrentSkipList
+{
+public:
+    //***************************构造函数*********************************
+    explicit ConcurrentSkipList(const Compare &c = Compare()) : compare(c), count(0)
+    {
+        for (int i = 0; i != skiplist_max_height; ++i)
+            head[i].store(0, std::memory_order_relaxed);
+    }
+    ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList &) = delete;
+    ~ConcurrentSkipList()
+    {
+        for (Node *node = pointer(head[0].load()); node != nullptr; ){
+            Node *next = pointer(node->next[0].load(std::memory_order_relaxed));
+            destroyNode(node);
+            node = next;
+        }
+    }
+    //***************************成员函数*********************************
+    bool insert(const Key &key, const Value &value);    // 插入一个元素, 键已经存在时返回false
+    bool remove(const Key &key);                        // 删除一个元素
+    bool search(const Key &key, Value &value) const;    // 查找一个键, 存在时把值复制到value
+    bool contains(const Key &key) const;
+    // successor: 大于key的最小的键, 存在时复制到next_key与next_value
+    bool successor(const Key &key, Key &next_key, Value &next_value) const;
+    bool minimum(Key &min_key, Value &min_value) const; // 最小的键
+    // for_each: 按键的顺序对每个元素调用f(key, value); 有并发修改时看到的是某个中间状态(但仍然有序)
+    template<typename Function>
+    void for_each(Function f) const;
+
+    // size: 元素个数, 有并发写入时只是近似值
+    std::size_t size() const { return count.load(std::memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+    // reclaim: 尝试释放已经没有读者访问的结点(通常不需要调用, 写者会定期释放)
+    void reclaim() { domain.collect(); }
+private:
+    //***************************数据结构*********************************
+    typedef std::atomic<std::uintptr_t> Link;   // 指向下一个结点的指针, 最低位是删除标记
+    // Node: 塔内联在结点的末尾, 分配sizeof(Node) + (height - 1) * sizeof(Link)个字节
+    struct Node
+    {
+        Node(const Key &k, const Value &v, int h) : key(k), value(v), height(h), owners(2) {  }
+        const Key key;
+        const Value value;
+        const int height;
+        std::atomic<int> owners;    // 插入者与删除者各占1, 减为0时退休
+        Link next[1];
+    };
+
+    Compare compare;
+    mutable EpochDomain domain;
+    std::atomic<std::size_t> count;
+    Link head[skiplist_max_height];     // 头结点的塔(头结点没有键)
+    //***************************私有成员函数*****************************
+    static Node* pointer(std::uintptr_t link) { return reinterpret_cast<Node *>(link & ~std::uintptr_t(1)); }
+    static bool marked(std::uintptr_t link) { return (link & 1) != 0; }
+    static std::uintptr_t address(Node *node) { return reinterpret_cast<std::uintptr_t>(node); }
+
+    static Node* createNode(const Key &key, const Value &value, int height)
+    {
+        void *memory = ::operator new(sizeof(Node) + (height - 1) * sizeof(Link));
+        Node *node = new (memory) Node(key, value, height);
+        for (int i = 1; i < height; ++i)
+            new (&node->next[i]) Link(0);
+        node->next[0].store(0, std::memory_order_relaxed);
+        return node;
+    }
+    static void destroyNode(Node *node)
+    {
+        node->~Node();
+        ::operator delete(node);
+    }
+    static void destroyNodeObject(void *p) { destroyNode(static_cast<Node *>(p)); }
+    // randomHeight: 每个线程一个xorshift状态, 高度为h的概率是2^-h
+    static int randomHeight()
+    {
+        static thread_local std::uint64_t state = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<std::uintptr_t>(&state);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int height = 1;
+        for (std::uint64_t bits = state; (bits & 1) && height < skiplist_max_height; bits >>= 1)
+            ++height;
+        return height;
+    }
+    // links: 结点的塔, 空指针表示头结点
+    Link* links(Node *node) { return node ? node->next : head; }
+    const Link* links(const Node *node) const { return node ? node->next : head; }
+    void release(Node *node)
+    {
+        if (node->owners.fetch_sub(1) == 1)
+            domain.retire(node, &destroyNodeObject);
+    }
+    bool find(const Key &key, Node **preds, Node **succs);
+    const Node* lowerBound(const Key &key, bool strict) const;
+};
+//***************************私有成员函数*********************************
+// find: 找到每一层中最后一个键小于key的结点preds[i]与它的后继succs[i], 摘下途中被标记的结点
+/*
+ * \return 第0层的后继的键是否等于key. 调用者必须处于纪元临界区中.
+ * 摘下结点的CAS失败(前驱被标记或者前驱的next已经改变)时从头开始.
+*/
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::find(const Key &key, Node **preds, Node **succs)
+{
+retry:
+    Node *pred = nullptr;
+    for (int level = skiplist_max_height - 1; level >= 0; --level){
+        Node *curr = pointer(links(pred)[level].load());
+        while (curr != nullptr){
+            std::uintptr_t succ = curr->next[level].load();
+            while (marked(succ)){
+                std::uintptr_t expected = address(curr);
+                if (!links(pred)[level].compare_exchange_strong(expected, succ & ~std::uintptr_t(1)))
+                    goto retry;
+                curr = pointer(succ);
+                if (curr == nullptr)
+                    break;
+                succ = curr->next[level].load();
+            }
+            if (curr == nullptr || !compare(curr->key, key))
+                break;
+            pred = curr;
+            curr = pointer(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] != nullptr && !compare(key, succs[0]->key);
+}
+// lowerBound: 第一个键不小于key(strict为true时大于key)且没有被删除的结点, 只读不写
+template<typename Key, typename Value, typename Compare>
+const typename ConcurrentSkipList<Key, Value, Compare>::Node*
+ConcurrentSkipList<Key, Value, Compare>::lowerBound(const Key &key, bool strict) const
+{
+    const Node *pred = nullptr, *curr = nullptr;
+    for (int level = skiplist_max_height - 1; level >= 0; --level){
+        curr = pointer(links(pred)[level].load());
+        while (curr != nullptr){
+            std::uintptr_t succ = curr->next[level].load();
+            // 被标记的结点直接跳过(不摘下)
+            while (curr != nullptr && marked(succ)){
+                curr = pointer(succ);
+                if (curr != nullptr)
+                    succ = curr->next[level].load();
+            }
+            if (curr == nullptr || (strict ? compare(key, curr->key) : !compare(curr->key, key)))
+                break;
+            pred = curr;
+            curr = pointer(succ);
+        }
+    }
+    return curr;
+}
+//***************************成员函数*************************************
+// insert: 插入一个元素
+/*
+ * \parameter key, value: 待插入的元素;
+ * \return 键不存在时插入并返回true, 否则返回false(不修改原来的值).
+ * 第0层的CAS成功时插入生效, 之后其它线程就能找到并删除它.
+*/
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::insert(const Key &key, const Value &value)
+{
+    EpochDomain::Guard guard(domain);
+    Node *preds[skiplist_max_height], *succs[skiplist_max_height];
+    int height = randomHeight();
+    Node *node = nullptr;
+    for (;;){
+        if (find(key, preds, succs)){
+            if (node != nullptr)
+                destroyNode(node);      // 还没有发布, 直接释放
+            return false;
+        }
+        if (node == nullptr)
+            node = createNode(key, value, height);
+        for (int level = 0; level != height; ++level)
+            node->next[level].store(address(succs[level]), std::memory_order_relaxed);
+        std::uintptr_t expected = address(succs[0]);
+        if (links(preds[0])[0].compare_exchange_strong(expected, address(node)))
+            break;
+    }
+    count.fetch_add(1, std::memory_order_relaxed);
+    for (int level = 1; level < height; ++level){
+        for (;;){
+            // 结点的next在这一层被标记, 说明它已经被删除, 不再向上接入
+            std::uintptr_t next = node->next[level].load();
+            if (marked(next))
+                goto linked;
+            if (next != address(succs[level]) && !node->next[level].compare_exchange_strong(next, address(succs[level])))
+                goto linked;
+            std::uintptr_t expected = address(succs[level]);
+            if (links(preds[level])[level].compare_exchange_strong(expected, address(node)))
+                break;
+            // 重新定位; 结点已经不在第0层(被删除并摘下)时也停止
+            if (!find(key, preds, succs) || succs[0] != node)
+                goto linked;
+        }
+    }
+linked:
+    // 接入的过程中结点被删除了: 删除者的find可能早于最后一次接入, 再find一次把它从所有层中摘下
+    if (marked(node->next[0].load()))
+        find(key, preds, succs);
+    release(node);
+    return true;
+}
+// remove: 删除一个元素
+/*
+ * \parameter key: 待删除的键;
+ * \return 是否删除成功(有多个线程同时删除同一个键时只有标记第0层成功的线程返回true).
+*/
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::remove(const Key &key)
+{
+    EpochDomain::Guard guard(domain);
+    Node *preds[skiplist_max_height], *succs[skiplist_max_height];
+    if (!find(key, preds, succs))
+        return false;
+    Node *node = succs[0];
+    for (int level = node->height - 1; level >= 1; --level)
+        node->next[level].fetch_or(1);
+    std::uintptr_t next = node->next[0].load();
+    for (;;){
+        if (marked(next))
+            return false;       // 其它线程先删除了它
+        if (node->next[0].compare_exchange_weak(next, next | 1))
+            break;
+    }
+    count.fetch_sub(1, std::memory_order_relaxed);
+    find(key, preds, succs);
+    release(node);
+    return true;
+}
+// search: 查找一个键, 不加锁也不修改跳表
+/*
+ * \parameter key: 待查找的键;
+ * \parameter value: 键存在时它的值复制到这里, 否则不修改;
+ * \return 键是否存在.
+*/
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::search(const Key &key, Value &value) const
+{
+    EpochDomain::Guard guard(domain);
+    const Node *node = lowerBound(key, false);
+    if (node == nullptr || compare(key, node->key))
+        return false;
+    value = node->value;
+    return true;
+}
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::contains(const Key &key) const
+{
+    EpochDomain::Guard guard(domain);
+    const Node *node = lowerBound(key, false);
+    return node != nullptr && !compare(key, node->key);
+}
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::successor(const Key &key, Key &next_key, Value &next_value) const
+{
+    EpochDomain::Guard guard(domain);
+    const Node *node = lowerBound(key, true);
+    if (node == nullptr)
+        return false;
+    next_key = node->key;
+    next_value = node->value;
+    return true;
+}
+template<typename Key, typename Value, typename Compare>
+bool ConcurrentSkipList<Key, Value, Compare>::minimum(Key &min_key, Value &min_value) const
+{
+    EpochDomain::Guard guard(domain);
+    for (const Node *node = pointer(head[0].load()); node != nullptr; node = pointer(node->next[0].load())){
+        if (!marked(node->next[0].load())){
+            min_key = node->key;
+            min_value = node->value;
+            return true;
+        }
+    }
+    return false;
+}
+template<typename Key, typename Value, typename Compare>
+template<typename Function>
+void ConcurrentSkipList<Key, Value, Compare>::for_each(Function f) const
+{
+    EpochDomain::Guard guard(domain);
+    for (const Node *node = pointer(head[0].load()); node != nullptr; ){
+        std::uintptr_t next = node->next[0].load();
+        if (!marked(next))
+            f(node->key, node->value);
+        node = pointer(next);
+    }
+}
+#endif
@@ -0,0 +1,142 @@
+/*************************************************************************
+	> File Name: concurrentSkipList_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时52分42秒
+ ************************************************************************/
+// 无锁跳表与互斥锁保护的红黑树的扩展性测试: 不同线程数下每秒完成的操作数, 以CSV格式输出
+/*
+ * 用法: ./Bench [最大线程数(默认64)] [每个线程的操作数(默认200000)] [键的个数(默认100000)]
+ *      线程数从1开始每次加倍, 直到最大线程数; 读操作(search)的比例为10%, 50%, 90%;
+ *      键从[0, 2 * 键的个数)中均匀随机选取, 开始时插入其中一半, 写操作一半是插入一半是删除, 元素个数大致不变.
+ *
+ * 对比的两种实现:
+ *      --mutex_rbtree: 一个互斥锁保护的红黑树(PooledRedBlackTree; 共享指针的RedBlackTree的删除在随机的
+ *        删除序列下不可靠, 所以用节点池的版本作为对照);
+ *      --skip_list: ConcurrentSkipList, 读写都不加锁.
+ *
+ * 输出的每一行: structure,threads,read_percent,ops_per_second
+ *
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "concurrentSkipList.h"
+#include "../../tree_algorithm/RedBlackTree/PooledRedBlackTree.h"
+
+//****************************两种实现*******************************
+class MutexTree
+{
+public:
+    bool insert(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tree.contains(key))
+            return false;
+        tree.insert(key);
+        return true;
+    }
+    bool remove(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.erase(key);
+    }
+    bool search(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.contains(key);
+    }
+private:
+    std::mutex mutex;
+    PooledRedBlackTree<std::uint64_t> tree;
+};
+
+class SkipList
+{
+public:
+    bool insert(std::uint64_t key) { return list.insert(key, key); }
+    bool remove(std::uint64_t key) { return list.remove(key); }
+    bool search(std::uint64_t key)
+    {
+        std::uint64_t value;
+        return list.search(key, value);
+    }
+private:
+    ConcurrentSkipList<std::uint64_t, std::uint64_t> list;
+};
+
+//****************************测试过程*******************************
+std::atomic<std::size_t> bench_sink(0);    // 查找命中的次数, 使编译器不能省略查找
+
+// nextRandom: xorshift64, 每个线程一个状态
+inline std::uint64_t nextRandom(std::uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// run: 返回每秒完成的操作数
+template<typename Structure>
+double run(std::size_t threads, std::size_t operations, std::uint64_t keys, unsigned read_percent)
+{
+    Structure structure;
+    for (std::uint64_t key = 0; key < 2 * keys; key += 2)
+        structure.insert(key);
+    std::atomic<std::size_t> ready(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t != threads; ++t){
+        workers.emplace_back([&, t]{
+            std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            std::size_t hits = 0;
+            ++ready;
+            while (!start)
+                std::this_thread::yield();
+            for (std::size_t i = 0; i != operations; ++i){
+                std::uint64_t r = nextRandom(state);
+                std::uint64_t key = (r >> 8) % (2 * keys);
+                if (r % 100 < read_percent)
+                    hits += structure.search(key);
+                else if (r & 128)
+                    structure.insert(key);
+                else
+                    structure.remove(key);
+            }
+            bench_sink += hits;
+        });
+    }
+    while (ready != threads)
+        std::this_thread::yield();
+    auto begin = std::chrono::steady_clock::now();
+    start = true;
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return threads * operations / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    std::uint64_t keys = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000;
+    const unsigned read_percents[] = {10, 50, 90};
+
+    std::cout << "structure,threads,read_percent,ops_per_second\n";
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2){
+        for (unsigned read_percent : read_percents){
+            std::cout << "mutex_rbtree," << threads << ',' << read_percent << ','
+                      << static_cast<std::uint64_t>(run<MutexTree>(threads, operations, keys, read_percent)) << '\n';
+            std::cout << "skip_list," << threads << ',' << read_percent << ','
+                      << static_cast<std::uint64_t>(run<SkipList>(threads, operations, keys, read_percent)) << std::endl;
+        }
+    }
+    return 0;
+}
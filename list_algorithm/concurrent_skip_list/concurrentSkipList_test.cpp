@@ -0,0 +1,171 @@
+/*************************************************************************
+	> File Name: concurrentSkipList_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时55分25秒
+ ************************************************************************/
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrentSkipList.h"
+
+std::atomic<int> alive(0);
+// Tracked: 记录存活的对象个数, 检查结点既没有泄漏也没有重复释放
+struct Tracked
+{
+    Tracked(int v = 0) : value(v) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value) { ++alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; return *this; }
+    ~Tracked() { --alive; }
+    int value;
+};
+
+// sequential_test: 单线程时与std::map的结果相同
+void sequential_test()
+{
+    bool correct = true;
+    {
+        ConcurrentSkipList<int, std::string> list;
+        std::map<int, std::string> reference;
+        std::srand(3);
+        for (int i = 0; i != 20000; ++i){
+            int key = std::rand() % 2000;
+            int op = std::rand() % 4;
+            if (op < 2){
+                std::string value = std::to_string(key * 3);
+                correct = correct && list.insert(key, value) == reference.insert(std::make_pair(key, value)).second;
+            }else if (op == 2)
+                correct = correct && list.remove(key) == (reference.erase(key) == 1);
+            else{
+                std::string value;
+                auto it = reference.upper_bound(key);
+                int next = 0;
+                bool found = list.successor(key, next, value);
+                correct = correct && found == (it != reference.end()) && (!found || (next == it->first && value == it->second));
+            }
+        }
+        std::string value;
+        correct = correct && list.size() == reference.size() && list.search(reference.begin()->first, value) &&
+                  value == reference.begin()->second && !list.contains(-1);
+        int min = -1;
+        correct = correct && list.minimum(min, value) && min == reference.begin()->first;
+        auto it = reference.begin();
+        list.for_each([&](int key, const std::string &v){
+            correct = correct && it != reference.end() && it->first == key && it->second == v;
+            ++it;
+        });
+        correct = correct && it == reference.end();
+
+        ConcurrentSkipList<int, int, std::greater<int>> descending;
+        for (int i = 0; i != 100; ++i)
+            descending.insert(i, i);
+        int next = 0, v = 0;
+        correct = correct && descending.successor(50, next, v) && next == 49 && descending.minimum(next, v) && next == 99;
+    }
+    std::cout << "单线程插入, 删除与查找: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// disjoint_test: 每个线程插入并删除自己的一组键, 最后剩下的元素个数与内容确定
+void disjoint_test()
+{
+    bool correct = true;
+    {
+        ConcurrentSkipList<int, Tracked> list;
+        const int threads = 4, per_thread = 5000;
+        std::vector<std::thread> workers;
+        std::atomic<int> failures(0);
+        for (int t = 0; t != threads; ++t)
+            workers.emplace_back([&, t]{
+                for (int i = 0; i != per_thread; ++i)
+                    if (!list.insert(i * threads + t, Tracked(t)))
+                        ++failures;
+                for (int i = 0; i < per_thread; i += 2)
+                    if (!list.remove(i * threads + t))
+                        ++failures;
+            });
+        for (auto &worker : workers)
+            worker.join();
+        int expected = 0, seen = 0;
+        list.for_each([&](int key, const Tracked &value){
+            while (((expected / threads) & 1) == 0)
+                ++expected;
+            correct = correct && key == expected && value.value == key % threads;
+            ++expected;
+            ++seen;
+        });
+        correct = correct && failures == 0 && seen == threads * per_thread / 2 && list.size() == static_cast<std::size_t>(seen);
+    }
+    std::cout << "多线程插入与删除不同的键: " << (correct && alive == 0 ? "正确" : "错误") << std::endl;
+}
+
+// contended_test: 多个线程同时插入, 删除, 查找同一组键; 每个键成功插入的次数减去成功删除的次数等于它最后是否存在
+void contended_test()
+{
+    bool correct = true;
+    {
+        const int threads = 4, keys = 256;
+        ConcurrentSkipList<int, Tracked> list;
+        std::vector<std::vector<int>> balance(threads, std::vector<int>(keys, 0));
+        std::vector<std::thread> workers;
+        std::atomic<bool> ordered(true);
+        for (int t = 0; t != threads; ++t)
+            workers.emplace_back([&, t]{
+                std::uint64_t state = 0x2545F4914F6CDD1Dull * (t + 1);
+                for (int i = 0; i != 40000; ++i){
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    int key = static_cast<int>((state >> 8) % keys);
+                    switch (state % 4){
+                    case 0: balance[t][key] += list.insert(key, Tracked(key)); break;
+                    case 1: balance[t][key] -= list.remove(key); break;
+                    case 2:{
+                        Tracked value;
+                        if (list.search(key, value) && value.value != key)
+                            ordered = false;
+                        break;
+                    }
+                    default:{
+                        int next;
+                        Tracked value;
+                        if (list.successor(key, next, value) && (next <= key || value.value != next))
+                            ordered = false;
+                    }
+                    }
+                }
+            });
+        for (auto &worker : workers)
+            worker.join();
+        for (int key = 0; key != keys; ++key){
+            int total = 0;
+            for (int t = 0; t != threads; ++t)
+                total += balance[t][key];
+            correct = correct && (total == 0 || total == 1) && list.contains(key) == (total == 1);
+        }
+        int last = -1;
+        list.for_each([&](int key, const Tracked &){
+            correct = correct && key > last;
+            last = key;
+        });
+        correct = correct && ordered;
+        for (int i = 0; i != 3; ++i)
+            list.reclaim();
+    }
+    std::cout << "多线程竞争同一组键: " << (correct && alive == 0 ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********concurrent skip list的单线程测试********\n";
+    sequential_test();
+    std::cout << "********concurrent skip list的多线程测试********\n";
+    disjoint_test();
+    contended_test();
+    return 0;
+}
@@ -7,23 +7,54 @@
 
 #ifndef _DOUBLYLINKEDLIST_H
 #define _DOUBLYLINKEDLIST_H
+#include <iostream>
+#include <memory>
+#include <utility>
 #include "../doublyLinkedListNode/doublyLinkedListNode.h"
 // DoublyLinkedList: 双向链表 算法导论10.2
 /*
  * 双向链表通过head,tail指向节点对象, 其中head表示链表的头,tail表示链表的尾.
  * 当head为空的时候链表为一个空链表,当tail为空的时候链表为一个空链表.
+ * splice(ptr,other)与concat(other)把另一个链表的所有节点接到ptr后面(链表的尾部), O(1).
+ *
+ * Alloc: 节点的分配器, 节点用std::allocate_shared创建(默认的std::allocator与make_shared相同);
+ * 用ArenaAllocator<NodeT>(tree_algorithm/NodeArena)时每个默认构造的链表有自己的NodeArena(空闲链表重用删除的节点).
+ * 前驱与后继都是shared_ptr, 相邻的节点互相引用: 析构与clear逐个断开节点的prev与next再释放
+ * (否则节点形成环永远不会释放, 沿着next递归析构也可能栈溢出); 之后仍被持有的节点的prev与next为空.
 */
-template<typename NodeT>
+template<typename NodeT, typename Alloc = std::allocator<NodeT>>
 class DoublyLinkedList
 {
 public:
     typedef NodeT NodeType;     // 链表的节点类型
     typedef typename NodeT::KeyType KeyType;    // 链表节点存储数据的类型
+    typedef Alloc AllocatorType;    // 节点的分配器类型
     //******************************默认构造函数**************************
-    DoublyLinkedList():
+    explicit DoublyLinkedList(const Alloc &a = Alloc()):
         head(std::shared_ptr<NodeType>()),
-        tail(std::shared_ptr<NodeType>())
+        tail(std::shared_ptr<NodeType>()),
+        alloc(a)
     {  }
+    // 复制构造函数: 逐个复制关键字(不共享节点)
+    DoublyLinkedList(const DoublyLinkedList &other):
+        alloc(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc))
+    {
+        for (auto current = other.head; current != NULL; current = current->next)
+            insertBack(current->key);
+    }
+    DoublyLinkedList(DoublyLinkedList &&other):
+        head(std::move(other.head)),
+        tail(std::move(other.tail)),
+        alloc(other.alloc)
+    {  }
+    DoublyLinkedList& operator=(DoublyLinkedList other)
+    {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(alloc, other.alloc);
+        return *this;
+    }
+    ~DoublyLinkedList() { clear(); }
     //******************************成员函数******************************
     // insertBack: 向双向链表的尾部插入数据
     /*
@@ -34,13 +65,13 @@ public:
     {
         // 链表为空的时候
         if (!head){
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             head = data;
             tail = data;
         }
         else{
             // 链表非空的时候
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             tail->next = data;
             tail->next->prev = tail;
             tail = data;
@@ -55,13 +86,13 @@ public:
     {
         // 链表为空的时候
         if (!head){
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             head = data;
             tail = data;
         }
         else{
             // 链表非空的时候
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             head->prev = data;
             head->prev->next = head;
             head = data;
@@ -98,27 +129,17 @@ public:
     {
         if (value == NULL)
             return false;
-        bool sign = false;
-        if (value == head){
-            head->next->prev = std::shared_ptr<NodeType>();
+        // 头(尾)节点没有前驱(后继), 只有一个节点时两者都要更新
+        if (value == head)
             head = value->next;
-            value.reset();
-            sign = true;
-        }
-        else if (value == tail){
-            tail->prev->next = std::shared_ptr<NodeType>();
-            tail = value->prev;
-            value.reset();
-            sign = true;
-        }
-        else{
+        else
             value->prev->next = value->next;
+        if (value == tail)
+            tail = value->prev;
+        else
             value->next->prev = value->prev;
-            value.reset();
-            sign = true;
-        }
-        return sign;
-    
+        value.reset();
+        return true;
     }
     // insert: 在给定指针的后面插入元素
     /*
@@ -137,7 +158,7 @@ public:
             sign = true;
         }
         else{
-            auto key_ptr = std::make_shared<NodeType>(key);
+            auto key_ptr = std::allocate_shared<NodeType>(alloc, key);
             key_ptr->next = value->next;
             key_ptr->prev = value;
             value->next->prev = key_ptr;
@@ -147,6 +168,65 @@ public:
         return sign;
     }
     
+    // splice: 把other的所有节点接到value后面, other成为空链表
+    /*
+     * \parameter value: 本链表中的节点(为了O(1)不检查它是否属于本链表);
+     * \parameter other: 另一个链表, 节点直接移动过来, 不复制;
+     * \return sign(value为空或other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool splice(const std::shared_ptr<NodeType> &value, DoublyLinkedList &other)
+    {
+        if (value == NULL || &other == this)
+            return false;
+        if (!other.head)
+            return true;
+        other.tail->next = value->next;
+        if (value->next)
+            value->next->prev = other.tail;
+        else
+            tail = other.tail;
+        other.head->prev = value;
+        value->next = other.head;
+        other.head.reset();
+        other.tail.reset();
+        return true;
+    }
+    // concat: 把other的所有节点接到链表的尾部, other成为空链表
+    /*
+     * \return sign(other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool concat(DoublyLinkedList &other)
+    {
+        if (&other == this)
+            return false;
+        if (!head){
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            return true;
+        }
+        // splice会修改tail, 传一个副本
+        auto last = tail;
+        return splice(last, other);
+    }
+    // clear: 逐个断开并释放所有节点
+    /*
+     * 取下头节点的next, 再清空后继的prev, 头节点就没有其它引用了, 每次只析构一个节点.
+     * 算法复杂度: O(N).
+    */
+    void clear()
+    {
+        tail.reset();
+        while (head){
+            auto next = std::move(head->next);
+            if (next)
+                next->prev.reset();
+            head = std::move(next);
+        }
+    }
+    bool empty() const { return !head; }
+
     // order_print:顺序遍历链表
     /*
      * \return void.
@@ -181,5 +261,6 @@ private:
     //******************************数据结构******************************
     std::shared_ptr<NodeType> head;     // 链表的头
     std::shared_ptr<NodeType> tail;     // 链表的尾
+    Alloc alloc;                        // 节点的分配器
 };
 #endif
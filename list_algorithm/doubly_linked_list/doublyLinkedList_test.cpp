@@ -6,9 +6,12 @@
  ************************************************************************/
 
 #include <iostream>
+#include <memory>
+#include <vector>
 using std::cout;    using std::endl;
 #include "doublyLinkedList.h"
 #include "../doublyLinkedListNode/doublyLinkedListNode.h"
+#include "../../tree_algorithm/NodeArena/NodeArena.h"
 typedef DoublyLinkedList<DoublyLinkedListNode<int>> IntList;
 void insertBack_test()
 {
@@ -79,6 +82,61 @@ void insert_test()
     intlist.order_print();
     intlist.reverse_order_print();
 }
+typedef DoublyLinkedList<DoublyLinkedListNode<int>, ArenaAllocator<DoublyLinkedListNode<int>>> PooledList;
+// keysOf: 从first开始顺序(reverse为true时逆序)取出关键字
+template<typename ListType>
+std::vector<int> keysOf(ListType &list, int first, bool reverse = false)
+{
+    std::vector<int> keys;
+    for (auto current = list.search(first); current != NULL; current = reverse ? current->prev : current->next)
+        keys.push_back(current->key);
+    return keys;
+}
+// splice_test: splice与concat之后前驱与后继都正确, 删除唯一的节点
+void splice_test()
+{
+    IntList a, b, c;
+    for (int i = 0; i != 5; ++i){
+        a.insertBack(i);
+        b.insertBack(10 + i);
+        c.insertBack(20 + i);
+    }
+    auto node = a.search(2);
+    bool correct = a.splice(node, b) && b.empty() && a.concat(c) && c.empty() && !a.splice(node, a);
+    a.insertBack(99);
+    std::vector<int> expected{0, 1, 2, 10, 11, 12, 13, 14, 3, 4, 20, 21, 22, 23, 24, 99};
+    correct = correct && keysOf(a, 0) == expected && keysOf(a, 99, true) == std::vector<int>(expected.rbegin(), expected.rend());
+    IntList copy(a), single;
+    single.insertBack(7);
+    auto only = single.search(7);
+    correct = correct && single.deleteList(only) && single.empty() && keysOf(copy, 0) == expected;
+    single.insertFront(8);
+    correct = correct && single.concat(copy) && keysOf(single, 99, true).size() == 17;
+    cout << "splice与concat: " << (correct ? "正确" : "错误") << endl;
+}
+// release_test: 析构时断开前驱与后继的环, 所有节点(与NodeArena)都被释放; 长链表的析构不会栈溢出
+void release_test()
+{
+    std::weak_ptr<NodeArena> watch;
+    std::weak_ptr<DoublyLinkedListNode<int>> plainNode;
+    {
+        ArenaAllocator<DoublyLinkedListNode<int>> allocator;
+        watch = allocator.arena;
+        PooledList list(allocator), other(allocator);
+        allocator.arena.reset();
+        for (int i = 0; i != 1000000; ++i)
+            list.insertBack(i);
+        for (int i = 0; i != 1000; ++i)
+            other.insertFront(i);
+        list.concat(other);
+        IntList plain;
+        for (int i = 0; i != 1000000; ++i)
+            plain.insertFront(i);
+        plainNode = plain.search(500000);
+    }
+    cout << "节点的释放: " << (watch.expired() && plainNode.expired() ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     cout << "*****************双向链表尾部插入****************************\n";
@@ -91,6 +149,10 @@ int main()
     deleteList_test();
     cout << "*****************双向链表插入操作****************************\n";
     insert_test();
+    cout << "*****************splice, concat与复制************************\n";
+    splice_test();
+    cout << "*****************长链表与节点池******************************\n";
+    release_test();
 
     return 0;
 }
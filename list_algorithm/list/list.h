@@ -9,27 +9,58 @@
 #define _LIST_H
 #include <memory>
 #include <iostream>
+#include <utility>
 #include "../listNode/ListNode.h"
 // List: 单向链表 算法导论10.2
 /*
  * \parameter head: 表头指针;
+ * \parameter tail: 表尾指针(insertBack与concat为O(1));
  * insertBack(x): 在链表的尾部插入元素;
  * insertFront(x): 在链表的头部插入元素;
  * insert(ptr,x): 在给定指针ptr后面插入元素x;
  * search(x): 在链表中查找元素x;
  * deleteList(ptr): 在链表中删除指针ptr指向的元素;
+ * splice(ptr,other), concat(other): 把other的所有节点接到ptr后面(链表的尾部), O(1);
  * order_print(): 顺序打印链表中的元素.
+ *
+ * Alloc: 节点的分配器, 节点用std::allocate_shared创建(默认的std::allocator与make_shared相同).
+ * 用ArenaAllocator<NodeT>(tree_algorithm/NodeArena)时每个默认构造的链表有自己的NodeArena: 控制块与节点从大块内存中
+ * 切出, 删除的节点放入空闲链表重用. 每个节点的控制块中有分配器的副本, 所以splice过来的节点仍然归还给原来的NodeArena.
+ * 析构与clear逐个释放节点(不会沿着next递归析构而栈溢出); 之后仍被持有的节点(例如search的结果)的next为空.
 */
-template<typename NodeT>
+template<typename NodeT, typename Alloc = std::allocator<NodeT>>
 class List
 {
 public:
     typedef NodeT NodeType;     // 链表的节点类型
     typedef typename NodeT::KeyType KeyType;    // 链表节点存储的数据类型
+    typedef Alloc AllocatorType;    // 节点的分配器类型
     //******************************默认构造函数**************************
-    List():
-        head(std::shared_ptr<NodeType>())
+    explicit List(const Alloc &a = Alloc()):
+        head(std::shared_ptr<NodeType>()),
+        tail(std::shared_ptr<NodeType>()),
+        alloc(a)
     {  }
+    // 复制构造函数: 逐个复制关键字(不共享节点)
+    List(const List &other):
+        alloc(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc))
+    {
+        for (auto current = other.head; current != NULL; current = current->next)
+            insertBack(current->key);
+    }
+    List(List &&other):
+        head(std::move(other.head)),
+        tail(std::move(other.tail)),
+        alloc(other.alloc)
+    {  }
+    List& operator=(List other)
+    {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(alloc, other.alloc);
+        return *this;
+    }
+    ~List() { clear(); }
     //******************************成员函数******************************
     // insertFront:在链表的头部插入元素
     /*
@@ -41,12 +72,13 @@ public:
     {
         bool sign = false;
         if (head == NULL){
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             head = data;
+            tail = data;
             sign = true;
         }
         else{
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             data->next = head;
             head = data;
             sign = true;
@@ -57,25 +89,17 @@ public:
     /*
      * \parameter key:带插入的元素;
      * \return sign(标志是否插入成功).
-     * 算法复杂度为O(N).
+     * 算法复杂度为O(1)(接在tail后面).
     */
     bool insertBack(const KeyType &key)
     {
-        bool sign = false;
-        if (head == NULL){
-            auto data = std::make_shared<NodeType>(key);
+        auto data = std::allocate_shared<NodeType>(alloc, key);
+        if (head == NULL)
             head = data;
-            sign = true;
-        }
-        else{
-            auto current = head;
-            while (current->next != NULL)
-                current = current->next;
-            auto data = std::make_shared<NodeType>(key);
-            current->next = data;
-            sign = true;
-        }
-        return sign;
+        else
+            tail->next = data;
+        tail = data;
+        return true;
     }
     // insert: 在给定位置后面插入元素
     /*
@@ -99,9 +123,11 @@ public:
         while (current != val_ptr && current != NULL) 
             current = current->next;
         if (current != NULL){
-            auto data = std::make_shared<NodeType>(key);
+            auto data = std::allocate_shared<NodeType>(alloc, key);
             data->next = current->next;
             current->next = data;
+            if (current == tail)
+                tail = data;
             sign = true;
         }
         else
@@ -147,6 +173,8 @@ public:
         // 删除头指针的情况
         if (val_ptr == head){
             head = val_ptr->next;
+            if (head == NULL)
+                tail.reset();
             val_ptr.reset();
             return true;
         }
@@ -161,11 +189,66 @@ public:
             std::cout << "未找到此指针\n"; 
         else{
             front_ptr->next = current->next;
+            if (current == tail)
+                tail = front_ptr;
             val_ptr.reset();
             sign = true;
         }
         return sign;
     }
+    // splice: 把other的所有节点接到val_ptr后面, other成为空链表
+    /*
+     * \parameter val_ptr: 本链表中的节点(为了O(1)不检查它是否属于本链表);
+     * \parameter other: 另一个链表, 节点直接移动过来, 不复制;
+     * \return sign(val_ptr为空或other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool splice(const std::shared_ptr<NodeType> &val_ptr, List &other)
+    {
+        if (val_ptr == NULL || &other == this)
+            return false;
+        if (other.head == NULL)
+            return true;
+        other.tail->next = val_ptr->next;
+        val_ptr->next = other.head;
+        if (val_ptr == tail)
+            tail = other.tail;
+        other.head.reset();
+        other.tail.reset();
+        return true;
+    }
+    // concat: 把other的所有节点接到链表的尾部, other成为空链表
+    /*
+     * \return sign(other就是本链表时返回false).
+     * 算法复杂度: O(1).
+    */
+    bool concat(List &other)
+    {
+        if (&other == this)
+            return false;
+        if (head == NULL){
+            std::swap(head, other.head);
+            std::swap(tail, other.tail);
+            return true;
+        }
+        // splice会修改tail, 传一个副本
+        auto last = tail;
+        return splice(last, other);
+    }
+    // clear: 逐个释放所有节点
+    /*
+     * 沿着next依次取下每个节点, 每次只析构一个节点, 栈的深度与链表的长度无关.
+     * 算法复杂度: O(N).
+    */
+    void clear()
+    {
+        tail.reset();
+        while (head != NULL){
+            auto next = std::move(head->next);
+            head = std::move(next);
+        }
+    }
+    bool empty() const { return head == NULL; }
     // order_print: 顺序遍历链表
     /*
      * \return void.
@@ -184,5 +267,7 @@ public:
 private:
     //******************************数据结构******************************
     std::shared_ptr<NodeType> head;     // 链表的头指针
+    std::shared_ptr<NodeType> tail;     // 链表的尾指针
+    Alloc alloc;                        // 节点的分配器
 };
 #endif
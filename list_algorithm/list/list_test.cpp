@@ -6,7 +6,10 @@
  ************************************************************************/
 
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "list.h"
+#include "../../tree_algorithm/NodeArena/NodeArena.h"
 using std::cout;    using std::endl;
 
 typedef List<ListNode<int>> IntList;
@@ -74,6 +77,73 @@ void deleteList_test()
     intlist.order_print();
 }
 
+// keysOf: 顺序取出链表中的关键字(只用公开的接口: 从头节点开始找到的第一个节点)
+template<typename ListType>
+std::vector<int> keysOf(ListType &list, int first)
+{
+    std::vector<int> keys;
+    for (auto current = list.search(first); current != NULL; current = current->next)
+        keys.push_back(current->key);
+    return keys;
+}
+// splice_test: O(1)的insertBack, splice与concat, 复制与移动
+void splice_test()
+{
+    IntList a, b, c;
+    for (int i = 0; i != 5; ++i){
+        a.insertBack(i);
+        b.insertBack(10 + i);
+        c.insertBack(20 + i);
+    }
+    auto node = a.search(2);
+    bool correct = a.splice(node, b) && b.empty() && a.concat(c) && c.empty() && !a.concat(a);
+    a.insertBack(99);
+    correct = correct && keysOf(a, 0) == std::vector<int>{0, 1, 2, 10, 11, 12, 13, 14, 3, 4, 20, 21, 22, 23, 24, 99};
+    // 删除尾节点以后insertBack接在新的尾节点后面
+    auto last = a.search(99);
+    a.deleteList(last);
+    a.insertBack(100);
+    IntList copy(a), moved(std::move(copy));
+    moved.insertBack(101);
+    correct = correct && keysOf(a, 0).back() == 100 && keysOf(moved, 0).back() == 101 && keysOf(a, 0).size() == 16;
+    IntList empty;
+    correct = correct && empty.concat(moved) && keysOf(empty, 0).size() == 17 && moved.empty();
+    cout << "splice与concat: " << (correct ? "正确" : "错误") << endl;
+}
+// long_test: 一百万个节点的建立(O(1)的insertBack)与析构(逐个释放, 不会栈溢出); 节点来自链表自己的NodeArena
+void long_test()
+{
+    typedef List<ListNode<int>, ArenaAllocator<ListNode<int>>> PooledList;
+    std::weak_ptr<NodeArena> watch;
+    bool correct = true;
+    {
+        ArenaAllocator<ListNode<int>> allocator;
+        watch = allocator.arena;
+        PooledList list(allocator);
+        allocator.arena.reset();
+        for (int i = 0; i != 1000000; ++i)
+            list.insertBack(i);
+        auto last = list.search(999999);
+        correct = last != NULL && last->next == NULL;
+        last.reset();
+        // 删除的节点的槽在空闲链表中, 再插入时重用, 不分配新的块
+        std::size_t chunks = watch.lock()->chunkCount();
+        for (int i = 0; i != 1000; ++i){
+            auto node = list.search(i);
+            list.deleteList(node);
+        }
+        for (int i = 0; i != 1000; ++i)
+            list.insertFront(i);
+        correct = correct && watch.lock()->chunkCount() == chunks;
+        IntList plain;
+        for (int i = 0; i != 1000000; ++i)
+            plain.insertBack(i);
+    }
+    // 所有的节点都已释放, NodeArena随最后一个节点释放
+    correct = correct && watch.expired();
+    cout << "一百万个节点的建立与析构: " << (correct ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     cout << "************************单向链表头部插入*********************\n";
@@ -86,6 +156,10 @@ int main()
     insert_test();
     cout << "************************单向链表的删除*******************\n";
     deleteList_test();
+    cout << "*******************splice, concat与复制**********************\n";
+    splice_test();
+    cout << "*******************长链表与节点池****************************\n";
+    long_test();
 
     return 0;
 }
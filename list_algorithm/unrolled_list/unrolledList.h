@@ -0,0 +1,398 @@
+/*************************************************************************
+	> File Name: unrolledList.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时16分11秒
+ ************************************************************************/
+
+#ifndef _UNROLLEDLIST_H
+#define _UNROLLEDLIST_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// UnrolledSearch: 在一个节点的连续关键字中查找key, 返回下标(没有时返回n)
+/*
+ * 4字节与8字节的整数用SIMD一次比较一个向量(8字节的整数需要AVX2, SSE2没有64位整数的相等比较),
+ * 其它算术类型逐个比较但没有提前退出的分支(编译器可以向量化), 其它类型逐个比较并在找到时退出.
+ */
+template<typename Key, bool = std::is_integral<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8),
+         bool = std::is_arithmetic<Key>::value>
+struct UnrolledSearch
+{
+    static std::uint32_t find(const Key *keys, std::uint32_t n, const Key &key)
+    {
+        std::uint32_t i = 0;
+        while (i != n && !(keys[i] == key))
+            ++i;
+        return i;
+    }
+};
+template<typename Key>
+struct UnrolledSearch<Key, false, true>
+{
+    static std::uint32_t find(const Key *keys, std::uint32_t n, const Key &key)
+    {
+        // 每8个关键字一组: 先无分支地统计组内是否有相等的关键字, 再在命中的组中确定下标
+        std::uint32_t i = 0;
+        for (; i + 8 <= n; i += 8){
+            bool hit = false;
+            for (std::uint32_t j = 0; j != 8; ++j)
+                hit |= keys[i + j] == key;
+            if (hit)
+                break;
+        }
+        while (i != n && !(keys[i] == key))
+            ++i;
+        return i;
+    }
+};
+template<typename Key>
+struct UnrolledSearch<Key, true, true>
+{
+    static std::uint32_t find(const Key *keys, std::uint32_t n, const Key &key)
+    {
+        return find(keys, n, key, std::integral_constant<std::size_t, sizeof(Key)>());
+    }
+    static std::uint32_t find(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 4>)
+    {
+        std::uint32_t i = 0;
+#if defined(__AVX2__)
+        const __m256i v = _mm256_set1_epi32(static_cast<int>(key));
+        for (; i + 8 <= n; i += 8){
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, v)));
+            if (mask != 0)
+                return i + __builtin_ctz(mask);
+        }
+#elif defined(__SSE2__)
+        const __m128i v = _mm_set1_epi32(static_cast<int>(key));
+        for (; i + 4 <= n; i += 4){
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, v)));
+            if (mask != 0)
+                return i + __builtin_ctz(mask);
+        }
+#endif
+        while (i != n && keys[i] != key)
+            ++i;
+        return i;
+    }
+    static std::uint32_t find(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 8>)
+    {
+        std::uint32_t i = 0;
+#if defined(__AVX2__)
+        const __m256i v = _mm256_set1_epi64x(static_cast<long long>(key));
+        for (; i + 4 <= n; i += 4){
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+            int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, v)));
+            if (mask != 0)
+                return i + __builtin_ctz(mask);
+        }
+#endif
+        return i + UnrolledSearch<Key, false, true>::find(keys + i, n - i, key);
+    }
+};
+
+// UnrolledList: 展开的链表(每个节点存放一个小的关键字数组)
+/*
+ * List, DoublyLinkedList与CircularList为每个关键字make_shared一个节点: 每个关键字除了自己以外还要一个或两个
+ * shared_ptr(16到32字节)与控制块, search的每一步都是一次缓存未命中.
+ *
+ * UnrolledList的每个节点是NodeBytes字节(默认128, 两个缓存行): 前后指针, 关键字个数与capacity个关键字,
+ * 所以search在一个节点内顺序地比较(算术类型用UnrolledSearch向量化), 每capacity个关键字才跟随一次指针.
+ *      --insert(pos, key)在pos之后插入: 节点满时把后一半关键字分裂到一个新节点, 再插入到相应的一半;
+ *      --insertFront/insertBack: 头(尾)节点满时在最前(最后)加一个新节点, 依次插入时节点都是满的;
+ *      --insertOrdered: 按关键字的顺序插入, 先比较每个节点的最后一个关键字跳过整个节点, 再在节点内二分查找;
+ *      --deleteList(pos): 删除以后节点不足一半时与后一个(最后一个节点时为前一个)节点合并, 两个节点合起来放不下时
+ *        从邻居移过来一部分关键字, 使两个节点都至少半满. 所以除了第一个与最后一个节点, 每个节点至少半满.
+ * Position(节点与下标)代替节点指针, 任何插入与删除以后以前的Position都失效(关键字会在节点之间移动).
+ *
+ * 算法性能: search与insertOrdered为O(n / capacity)次指针跟随加O(n)次比较, insert与deleteList(给定位置)为O(capacity).
+ * 关键字类型需要可以默认构造(节点中的数组).
+ *
+ */
+template<typename KType, std::size_t NodeBytes = 128>
+class UnrolledList
+{
+    struct Node;
+public:
+    typedef KType KeyType;
+    // capacity: 每个节点的关键字个数(至少为4)
+    static const std::size_t capacity =
+        NodeBytes > 2 * sizeof(void *) + sizeof(std::uint32_t) + 4 * sizeof(KType)
+            ? (NodeBytes - 2 * sizeof(void *) - sizeof(std::uint32_t)) / sizeof(KType) : 4;
+    // Position: 一个关键字的位置, 空的Position(转换为false)表示不存在
+    class Position
+    {
+    public:
+        Position() : node(nullptr), index(0) {  }
+        explicit operator bool() const { return node != nullptr; }
+        const KeyType& operator*() const { return node->keys[index]; }
+        const KeyType* operator->() const { return &node->keys[index]; }
+        bool operator==(const Position &other) const { return node == other.node && index == other.index; }
+        bool operator!=(const Position &other) const { return !(*this == other); }
+    private:
+        friend class UnrolledList;
+        Position(Node *n, std::uint32_t i) : node(n), index(i) {  }
+        Node *node;
+        std::uint32_t index;
+    };
+    //******************************构造函数******************************
+    UnrolledList() : head(nullptr), tail(nullptr), count(0), nodes(0) {  }
+    UnrolledList(const UnrolledList &other) : head(nullptr), tail(nullptr), count(0), nodes(0)
+    {
+        for (const Node *node = other.head; node; node = node->next){
+            Node *copy = append();
+            std::copy(node->keys, node->keys + node->count, copy->keys);
+            copy->count = node->count;
+            count += node->count;
+        }
+    }
+    UnrolledList(UnrolledList &&other) : head(other.head), tail(other.tail), count(other.count), nodes(other.nodes)
+    {
+        other.head = other.tail = nullptr;
+        other.count = other.nodes = 0;
+    }
+    UnrolledList& operator=(UnrolledList other)
+    {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+        std::swap(nodes, other.nodes);
+        return *this;
+    }
+    ~UnrolledList() { clear(); }
+    //******************************成员函数******************************
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // nodeCount: 节点个数
+    std::size_t nodeCount() const { return nodes; }
+    void clear()
+    {
+        while (head){
+            Node *next = head->next;
+            delete head;
+            head = next;
+        }
+        tail = nullptr;
+        count = nodes = 0;
+    }
+    // front, back: 第一个与最后一个关键字的位置(空表时为空的Position)
+    Position front() const { return head ? Position(head, 0) : Position(); }
+    Position back() const { return tail ? Position(tail, tail->count - 1) : Position(); }
+    // next: pos之后的位置(pos是最后一个时为空的Position)
+    Position next(Position pos) const
+    {
+        if (pos.index + 1 < pos.node->count)
+            return Position(pos.node, pos.index + 1);
+        return pos.node->next ? Position(pos.node->next, 0) : Position();
+    }
+
+    // insertFront, insertBack: 在链表的头部(尾部)插入元素, O(1)
+    bool insertFront(const KeyType &key)
+    {
+        if (!head || head->count == capacity)
+            prepend();
+        insertAt(head, 0, key);
+        return true;
+    }
+    bool insertBack(const KeyType &key)
+    {
+        if (!tail || tail->count == capacity)
+            append();
+        insertAt(tail, tail->count, key);
+        return true;
+    }
+    // insert: 在pos之后插入key, pos为空时返回false
+    bool insert(Position pos, const KeyType &key)
+    {
+        if (!pos)
+            return false;
+        insertAt(pos.node, pos.index + 1, key);
+        return true;
+    }
+    // insertOrdered: 在不小于key的第一个关键字之后的位置插入(链表按operator<有序时保持有序), 返回插入的位置
+    Position insertOrdered(const KeyType &key)
+    {
+        Node *node = head;
+        while (node && node->next && !(key < node->keys[node->count - 1]))
+            node = node->next;
+        if (!node){
+            append();
+            return insertAt(tail, 0, key);
+        }
+        std::uint32_t index = static_cast<std::uint32_t>(std::upper_bound(node->keys, node->keys + node->count, key) - node->keys);
+        return insertAt(node, index, key);
+    }
+    // search: 第一个等于key的关键字的位置, 没有时返回空的Position
+    Position search(const KeyType &key) const
+    {
+        for (Node *node = head; node; node = node->next){
+            std::uint32_t i = UnrolledSearch<KeyType>::find(node->keys, node->count, key);
+            if (i != node->count)
+                return Position(node, i);
+        }
+        return Position();
+    }
+    // deleteList: 删除pos处的关键字并把pos置为空, pos为空时返回false
+    bool deleteList(Position &pos)
+    {
+        if (!pos)
+            return false;
+        Node *node = pos.node;
+        std::copy(node->keys + pos.index + 1, node->keys + node->count, node->keys + pos.index);
+        --node->count;
+        --count;
+        pos = Position();
+        if (node->count == 0)
+            unlink(node);
+        else if (node->count < capacity / 2){
+            if (node->next)
+                rebalance(node);
+            else if (node->prev)
+                rebalance(node->prev);
+        }
+        return true;
+    }
+    // for_each: 按顺序对每个关键字调用f
+    template<typename Function>
+    void for_each(Function f) const
+    {
+        for (const Node *node = head; node; node = node->next)
+            for (std::uint32_t i = 0; i != node->count; ++i)
+                f(node->keys[i]);
+    }
+    // order_print: 顺序打印链表中的元素
+    void order_print() const
+    {
+        if (!head)
+            std::cout << "The list is empty!\n";
+        else{
+            for_each([](const KeyType &key){ std::cout << key << " "; });
+            std::cout << std::endl;
+        }
+    }
+    // balanced: 检查结构(每个节点非空, 不超过capacity, 第一个与最后一个以外的节点至少半满, 计数与链接一致)
+    bool balanced() const
+    {
+        std::size_t keys = 0, n = 0;
+        const Node *prev = nullptr;
+        for (const Node *node = head; node; prev = node, node = node->next){
+            if (node->prev != prev || node->count == 0 || node->count > capacity ||
+                (node != head && node != tail && node->count < capacity / 2))
+                return false;
+            keys += node->count;
+            ++n;
+        }
+        return prev == tail && keys == count && n == nodes;
+    }
+
+private:
+    //******************************数据结构******************************
+    struct Node
+    {
+        Node() : next(nullptr), prev(nullptr), count(0) {  }
+        Node *next;
+        Node *prev;
+        std::uint32_t count;
+        KeyType keys[capacity];
+    };
+    Node *head;
+    Node *tail;
+    std::size_t count;      // 关键字个数
+    std::size_t nodes;      // 节点个数
+
+    Node* append() { return linkAfter(tail, new Node); }
+    Node* prepend()
+    {
+        Node *node = new Node;
+        node->next = head;
+        if (head)
+            head->prev = node;
+        else
+            tail = node;
+        head = node;
+        ++nodes;
+        return node;
+    }
+    // linkAfter: 把node接在left之后(left为空时node成为唯一的节点)
+    Node* linkAfter(Node *left, Node *node)
+    {
+        node->prev = left;
+        node->next = left ? left->next : nullptr;
+        if (left)
+            left->next = node;
+        else
+            head = node;
+        if (node->next)
+            node->next->prev = node;
+        else
+            tail = node;
+        ++nodes;
+        return node;
+    }
+    void unlink(Node *node)
+    {
+        (node->prev ? node->prev->next : head) = node->next;
+        (node->next ? node->next->prev : tail) = node->prev;
+        --nodes;
+        delete node;
+    }
+    // insertAt: 把key插入为node的第index个关键字, 节点满时先分裂
+    Position insertAt(Node *node, std::uint32_t index, const KeyType &key)
+    {
+        if (node->count == capacity){
+            Node *right = linkAfter(node, new Node);
+            std::uint32_t half = static_cast<std::uint32_t>(capacity / 2);
+            std::copy(node->keys + half, node->keys + node->count, right->keys);
+            right->count = node->count - half;
+            node->count = half;
+            if (index > half){
+                index -= half;
+                node = right;
+            }
+        }
+        std::copy_backward(node->keys + index, node->keys + node->count, node->keys + node->count + 1);
+        node->keys[index] = key;
+        ++node->count;
+        ++count;
+        return Position(node, index);
+    }
+    // rebalance: left与它的后继中有一个不足一半: 放得下时合并, 否则平分关键字
+    void rebalance(Node *left)
+    {
+        Node *right = left->next;
+        std::uint32_t total = left->count + right->count;
+        if (total <= capacity){
+            std::copy(right->keys, right->keys + right->count, left->keys + left->count);
+            left->count = total;
+            unlink(right);
+            return;
+        }
+        std::uint32_t target = total / 2;
+        if (left->count < target){
+            std::uint32_t moved = target - left->count;
+            std::copy(right->keys, right->keys + moved, left->keys + left->count);
+            std::copy(right->keys + moved, right->keys + right->count, right->keys);
+            right->count -= moved;
+            left->count = target;
+        }else{
+            std::uint32_t moved = left->count - target;
+            std::copy_backward(right->keys, right->keys + right->count, right->keys + right->count + moved);
+            std::copy(left->keys + target, left->keys + left->count, right->keys);
+            right->count += moved;
+            left->count = target;
+        }
+    }
+};
+template<typename KType, std::size_t NodeBytes>
+const std::size_t UnrolledList<KType, NodeBytes>::capacity;
+#endif
@@ -0,0 +1,123 @@
+/*************************************************************************
+	> File Name: unrolledList_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时18分54秒
+ ************************************************************************/
+// UnrolledList与每个关键字一个节点的链表的查找, 遍历与有序插入, 以CSV格式输出
+/*
+ * 用法: ./Bench [元素个数(默认100000)] [查找次数(默认2000)]
+ *      --search: 查找随机选取的关键字(都在表中), 每次从头开始顺序查找;
+ *      --traverse: 对所有的关键字求和;
+ *      --ordered_insert: 把前min(n, 20000)个关键字按顺序插入空表(有序的插入队列, O(n^2)), UnrolledList用insertOrdered,
+ *        std::list从头找到第一个更大的关键字再插入(DoublyLinkedList只测search).
+ * 对比的结构: DoublyLinkedList(每个节点make_shared, 前后都是shared_ptr), std::list(每个节点一次分配),
+ * UnrolledList<int>(128字节的节点, 27个关键字).
+ * 节点按插入的次序分配, 堆上的位置大致连续; 长时间运行的程序中节点分散时, 每个关键字一个节点的链表会更慢.
+ *
+ * 输出的每一行: structure,operation,n,ns_per_op
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <vector>
+#include "unrolledList.h"
+#include "../doubly_linked_list/doublyLinkedList.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 查找与求和的结果, 使编译器不能省略
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+void report(const char *structure, const char *operation, std::size_t n, std::size_t ops, Clock::time_point begin)
+{
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    std::cout << structure << ',' << operation << ',' << n << ',' << ns / ops << '\n';
+}
+
+void doublyLinked(const std::vector<int> &keys, const std::vector<int> &queries)
+{
+    DoublyLinkedList<DoublyLinkedListNode<int>> list;
+    for (int key : keys)
+        list.insertBack(key);
+    auto begin = Clock::now();
+    for (int key : queries)
+        bench_sink += list.search(key)->key;
+    report("DoublyLinkedList", "search", keys.size(), queries.size(), begin);
+}
+void stdList(const std::vector<int> &keys, const std::vector<int> &queries, std::size_t inserts)
+{
+    std::list<int> list(keys.begin(), keys.end());
+    auto begin = Clock::now();
+    for (int key : queries){
+        // 累加走过的步数: 只加*it(等于key)时编译器可以省略整个循环
+        std::uint64_t steps = 0;
+        for (auto it = list.begin(); *it != key; ++it)
+            ++steps;
+        bench_sink += steps;
+    }
+    report("std::list", "search", keys.size(), queries.size(), begin);
+    begin = Clock::now();
+    for (int round = 0; round != 20; ++round)
+        for (int key : list)
+            bench_sink += key;
+    report("std::list", "traverse", keys.size(), 20 * keys.size(), begin);
+    std::list<int> ordered;
+    begin = Clock::now();
+    for (std::size_t i = 0; i != inserts; ++i){
+        int key = keys[i];
+        auto it = ordered.begin();
+        while (it != ordered.end() && !(key < *it))
+            ++it;
+        ordered.insert(it, key);
+    }
+    report("std::list", "ordered_insert", inserts, inserts, begin);
+    bench_sink += ordered.front();
+}
+void unrolled(const std::vector<int> &keys, const std::vector<int> &queries, std::size_t inserts)
+{
+    UnrolledList<int> list;
+    for (int key : keys)
+        list.insertBack(key);
+    auto begin = Clock::now();
+    for (int key : queries)
+        bench_sink += *list.search(key);
+    report("UnrolledList", "search", keys.size(), queries.size(), begin);
+    begin = Clock::now();
+    for (int round = 0; round != 20; ++round)
+        list.for_each([](int key){ bench_sink += key; });
+    report("UnrolledList", "traverse", keys.size(), 20 * keys.size(), begin);
+    UnrolledList<int> ordered;
+    begin = Clock::now();
+    for (std::size_t i = 0; i != inserts; ++i)
+        ordered.insertOrdered(keys[i]);
+    report("UnrolledList", "ordered_insert", inserts, inserts, begin);
+    bench_sink += *ordered.front();
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::size_t q = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+    std::vector<int> keys(n), queries(q);
+    for (std::size_t i = 0; i != n; ++i)
+        keys[i] = static_cast<int>(xorshift() % (1u << 30));
+    for (std::size_t i = 0; i != q; ++i)
+        queries[i] = keys[xorshift() % n];
+    std::cout << "structure,operation,n,ns_per_op\n";
+    doublyLinked(keys, queries);
+    std::size_t inserts = std::min<std::size_t>(n, 20000);
+    stdList(keys, queries, inserts);
+    unrolled(keys, queries, inserts);
+    return bench_sink == 0 ? 1 : 0;
+}
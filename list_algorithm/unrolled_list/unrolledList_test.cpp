@@ -0,0 +1,172 @@
+/*************************************************************************
+	> File Name: unrolledList_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时21分37秒
+ ************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+using std::cout;    using std::endl;
+#include "unrolledList.h"
+
+std::uint64_t state = 88172645463325252ull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// same: 与参照的std::list逐个比较
+template<typename List, typename Key>
+bool same(const List &list, const std::list<Key> &reference)
+{
+    std::vector<Key> keys;
+    list.for_each([&keys](const Key &key){ keys.push_back(key); });
+    return list.size() == reference.size() && std::vector<Key>(reference.begin(), reference.end()) == keys;
+}
+
+// randomTest: 随机的insertFront, insertBack, insert(在查找到的位置之后)与deleteList, 与std::list比较, 检查节点的结构
+template<typename Key, std::size_t NodeBytes>
+bool randomTest(int operations, int range)
+{
+    UnrolledList<Key, NodeBytes> list;
+    std::list<Key> reference;
+    bool correct = true;
+    for (int i = 0; i != operations && correct; ++i){
+        Key key = static_cast<Key>(xorshift() % range);
+        Key other = static_cast<Key>(xorshift() % range);
+        typename UnrolledList<Key, NodeBytes>::Position pos = list.search(other);
+        auto it = std::find(reference.begin(), reference.end(), other);
+        correct = correct && (pos ? it != reference.end() && *pos == other : it == reference.end());
+        switch (xorshift() % 4){
+        case 0:
+            list.insertFront(key);
+            reference.push_front(key);
+            break;
+        case 1:
+            list.insertBack(key);
+            reference.push_back(key);
+            break;
+        case 2:
+            if (pos){
+                list.insert(pos, key);
+                reference.insert(std::next(it), key);
+            }else
+                correct = correct && !list.insert(pos, key);
+            break;
+        default:
+            if (pos){
+                list.deleteList(pos);
+                reference.erase(it);
+                correct = correct && !pos;
+            }else
+                correct = correct && !list.deleteList(pos);
+        }
+        correct = correct && list.balanced();
+    }
+    correct = correct && same(list, reference);
+    // 删除所有的关键字
+    while (correct && !list.empty()){
+        typename UnrolledList<Key, NodeBytes>::Position pos = list.front();
+        auto it = reference.begin();
+        for (std::uint64_t steps = xorshift() % list.size(); steps != 0; --steps){
+            pos = list.next(pos);
+            ++it;
+        }
+        list.deleteList(pos);
+        reference.erase(it);
+        correct = list.balanced() && same(list, reference);
+    }
+    return correct && list.nodeCount() == 0;
+}
+
+// searchTest: 每个位置的关键字都能找到第一次出现的位置(检查向量化查找的每个下标与尾部)
+template<typename Key>
+bool searchTest()
+{
+    bool correct = true;
+    for (int n = 1; n <= 200 && correct; ++n){
+        UnrolledList<Key> list;
+        for (int i = 0; i != n; ++i)
+            list.insertBack(static_cast<Key>(i % 37));
+        for (int i = 0; i != n && correct; ++i){
+            typename UnrolledList<Key>::Position pos = list.search(static_cast<Key>(i % 37)), expected = list.front();
+            for (int j = 0; j != i % 37; ++j)
+                expected = list.next(expected);
+            correct = pos == expected;
+        }
+        correct = correct && !list.search(static_cast<Key>(37)) && !list.search(static_cast<Key>(-1));
+    }
+    return correct;
+}
+
+// orderedTest: insertOrdered保持有序, 相等的关键字按插入的次序排列
+bool orderedTest()
+{
+    UnrolledList<std::pair<int, int>> list;
+    std::list<std::pair<int, int>> reference;
+    UnrolledList<int> ints;
+    bool correct = true;
+    for (int i = 0; i != 5000; ++i){
+        int key = static_cast<int>(xorshift() % 300);
+        UnrolledList<int>::Position pos = ints.insertOrdered(key);
+        correct = correct && *pos == key;
+        std::pair<int, int> element(key, i);
+        auto it = reference.begin();
+        while (it != reference.end() && it->first <= key)
+            ++it;
+        reference.insert(it, element);
+        list.insertOrdered(element);
+    }
+    // pair按整个pair比较, 第二个分量递增, 所以也按插入的次序
+    std::vector<int> keys;
+    ints.for_each([&keys](int key){ keys.push_back(key); });
+    return correct && same(list, reference) && std::is_sorted(keys.begin(), keys.end()) && ints.balanced();
+}
+
+// copyTest: 复制, 移动与字符串关键字
+bool copyTest()
+{
+    UnrolledList<std::string, 64> words;
+    for (int i = 0; i != 50; ++i)
+        words.insertBack(std::to_string(i));
+    UnrolledList<std::string, 64> copy(words), moved(std::move(words));
+    UnrolledList<std::string, 64>::Position pos = copy.search("20");
+    copy.deleteList(pos);
+    words = copy;
+    return moved.size() == 50 && copy.size() == 49 && words.size() == 49 && !words.search("20") &&
+           moved.search("20") && *moved.search("49") == "49" && words.balanced() && moved.balanced();
+}
+
+int main()
+{
+    cout << "每个节点的关键字个数(int, 128字节): " << UnrolledList<int>::capacity << endl;
+    UnrolledList<int> list;
+    for (int i = 0; i != 10; ++i)
+        list.insertBack(i);
+    list.insertFront(-1);
+    list.insert(list.search(5), 55);
+    UnrolledList<int>::Position pos = list.search(3);
+    list.deleteList(pos);
+    cout << "插入, 查找与删除: ";
+    list.order_print();
+
+    cout << "随机操作(int, 128字节的节点): " << (randomTest<int, 128>(20000, 500) ? "正确" : "错误") << endl;
+    cout << "随机操作(int64, 64字节的节点): " << (randomTest<std::int64_t, 64>(20000, 500) ? "正确" : "错误") << endl;
+    cout << "随机操作(short, 32字节的节点): " << (randomTest<short, 32>(5000, 100) ? "正确" : "错误") << endl;
+    cout << "随机操作(double): " << (randomTest<double, 128>(5000, 200) ? "正确" : "错误") << endl;
+    cout << "查找(int, unsigned, int64, uint64, float): "
+         << (searchTest<int>() && searchTest<unsigned>() && searchTest<std::int64_t>() &&
+             searchTest<std::uint64_t>() && searchTest<float>() ? "正确" : "错误") << endl;
+    cout << "有序插入: " << (orderedTest() ? "正确" : "错误") << endl;
+    cout << "复制与移动: " << (copyTest() ? "正确" : "错误") << endl;
+    return 0;
+}
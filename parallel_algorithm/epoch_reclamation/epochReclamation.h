@@ -0,0 +1,224 @@
+/*************************************************************************
+	> File Name: epochReclamation.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时53分47秒
+ ************************************************************************/
+
+#ifndef _EPOCHRECLAMATION_H
+#define _EPOCHRECLAMATION_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+const std::size_t epoch_retire_batch = 64;      // 每退休这么多个对象尝试推进一次全局纪元
+
+// EpochDomain: 基于纪元的内存回收(epoch-based reclamation)
+/*
+ * 无锁的读者可能正在访问一个刚被写者从数据结构中摘下的结点, 写者不能立即释放它. 规则如下:
+ *      --读者在访问共享数据之前进入临界区(EpochDomain::Guard), 记录当时的全局纪元, 离开时清除记录;
+ *      --写者摘下对象以后调用retire, 对象放入当前线程对应当时全局纪元的待释放链表中;
+ *      --所有处于临界区中的线程记录的纪元都等于全局纪元e时, 全局纪元才能推进到e+1;
+ *      --全局纪元达到e+2时, 纪元e中退休的对象一定不再被任何读者访问(那时的读者都已经离开临界区), 可以释放.
+ * 读者进入和离开临界区只需要几次原子读写与一次内存屏障, 不加锁也不等待任何线程(wait-free);
+ * 一个长时间停留在临界区中的读者只会推迟释放, 不会阻塞任何线程.
+ *
+ * 每个线程第一次使用某个EpochDomain时领取一个线程记录, 线程退出时归还, 记录可以被之后的线程重复使用.
+ * 析构EpochDomain时不能有线程处于它的临界区中, 所有尚未释放的对象在析构时释放.
+ *
+ */
+class EpochDomain
+{
+    struct Record;
+    struct Registry;
+public:
+    typedef void (*Deleter)(void *);
+    //****************************构造函数*******************************
+    EpochDomain() : registry(std::make_shared<Registry>()) {  }
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain& operator=(const EpochDomain &) = delete;
+    ~EpochDomain()
+    {
+        for (Record *record = registry->head.load(); record != nullptr; record = record->next)
+            for (std::size_t i = 0; i != 3; ++i)
+                freeList(record->limbo[i]);
+    }
+    //****************************临界区*******************************
+    // Guard: 在对象存在期间当前线程处于临界区中, 可以嵌套
+    class Guard
+    {
+    public:
+        explicit Guard(EpochDomain &d) : record(d.localRecord())
+        {
+            if (record->nesting++ == 0){
+                record->local.store((d.registry->global.load() << 1) | 1);
+                // 先公开自己的纪元, 再读取共享数据
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        Guard(const Guard &) = delete;
+        Guard& operator=(const Guard &) = delete;
+        ~Guard()
+        {
+            if (--record->nesting == 0)
+                record->local.store(0, std::memory_order_release);
+        }
+    private:
+        Record *record;
+    };
+    //****************************成员函数*******************************
+    // retire: p已经从数据结构中摘下(之后进入临界区的读者不可能再访问到它), 没有读者访问它以后用deleter释放
+    void retire(void *p, Deleter deleter)
+    {
+        Record *record = localRecord();
+        // 保证摘下p的写操作先于读取全局纪元
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = registry->global.load();
+        std::size_t slot = epoch % 3;
+        // 这个链表中是纪元epoch-3退休的对象, 已经可以释放
+        if (record->limbo_epoch[slot] != epoch){
+            freeList(record->limbo[slot]);
+            record->limbo_epoch[slot] = epoch;
+        }
+        record->limbo[slot].push_back(std::make_pair(p, deleter));
+        if (++record->retired % epoch_retire_batch == 0)
+            collect(record);
+    }
+    template<typename T>
+    void retire(T *p)
+    {
+        retire(static_cast<void *>(p), &deleteObject<T>);
+    }
+
+    // collect: 尝试推进全局纪元, 并释放当前线程与已退出线程的记录中可以释放的对象
+    void collect()
+    {
+        collect(localRecord());
+        for (Record *record = registry->head.load(); record != nullptr; record = record->next){
+            bool expected = false;
+            if (record->owned.compare_exchange_strong(expected, true)){
+                collect(record);
+                record->owned.store(false);
+            }
+        }
+    }
+
+    // pending: 已退休但尚未释放的对象个数(只在没有其它线程使用时准确)
+    std::size_t pending() const
+    {
+        std::size_t count = 0;
+        for (Record *record = registry->head.load(); record != nullptr; record = record->next)
+            for (std::size_t i = 0; i != 3; ++i)
+                count += record->limbo[i].size();
+        return count;
+    }
+
+    std::uint64_t epoch() const { return registry->global.load(); }
+private:
+    //****************************数据结构*******************************
+    typedef std::vector<std::pair<void *, Deleter>> RetiredList;
+    // Record: 一个线程的记录, 写者只访问自己的记录, collect时扫描所有记录的local
+    struct Record
+    {
+        Record() : local(0), owned(true), nesting(0), retired(0), next(nullptr)
+        {
+            for (std::size_t i = 0; i != 3; ++i)
+                limbo_epoch[i] = 0;
+        }
+        std::atomic<std::uint64_t> local;   // 在临界区中时为(纪元 << 1) | 1, 否则为0
+        std::atomic<bool> owned;            // 是否有线程正在使用这个记录
+        char padding[64];                   // 其它线程频繁读取local, 与下面只有本线程访问的数据分开
+        std::size_t nesting;                // Guard的嵌套层数
+        std::size_t retired;
+        std::uint64_t limbo_epoch[3];       // limbo[i]中的对象退休时的纪元
+        RetiredList limbo[3];               // 按退休时的纪元模3分开的待释放链表
+        Record *next;
+    };
+    // Registry: 所有线程记录组成的链表, 只增加不删除. 线程在退出之前持有它, 所以它可能比EpochDomain存在得更久
+    struct Registry
+    {
+        Registry() : global(1), head(nullptr) {  }
+        ~Registry()
+        {
+            for (Record *record = head.load(); record != nullptr; ){
+                Record *next = record->next;
+                delete record;
+                record = next;
+            }
+        }
+        std::atomic<std::uint64_t> global;  // 全局纪元
+        std::atomic<Record *> head;
+    };
+    // ThreadRecords: 当前线程在各个EpochDomain中领取的记录, 线程退出时归还
+    struct ThreadRecords
+    {
+        ~ThreadRecords()
+        {
+            for (auto &entry : entries)
+                entry.second->owned.store(false);
+        }
+        std::vector<std::pair<std::shared_ptr<Registry>, Record *>> entries;
+    };
+    std::shared_ptr<Registry> registry;
+
+    template<typename T>
+    static void deleteObject(void *p) { delete static_cast<T *>(p); }
+
+    static void freeList(RetiredList &list)
+    {
+        for (auto &retired : list)
+            retired.second(retired.first);
+        list.clear();
+    }
+
+    // localRecord: 当前线程在本EpochDomain中的记录, 第一次调用时领取空闲的记录或者新建一个
+    Record* localRecord()
+    {
+        static thread_local ThreadRecords records;
+        for (auto &entry : records.entries)
+            if (entry.first == registry)
+                return entry.second;
+        // 去掉已经析构的EpochDomain的记录(只剩当前线程持有它们的Registry)
+        records.entries.erase(std::remove_if(records.entries.begin(), records.entries.end(),
+                              [](const std::pair<std::shared_ptr<Registry>, Record *> &entry){
+                                  return entry.first.use_count() == 1;
+                              }), records.entries.end());
+        Record *record = nullptr;
+        for (Record *r = registry->head.load(); r != nullptr && record == nullptr; r = r->next){
+            bool expected = false;
+            if (r->owned.compare_exchange_strong(expected, true))
+                record = r;
+        }
+        if (record == nullptr){
+            record = new Record;
+            record->next = registry->head.load();
+            while (!registry->head.compare_exchange_weak(record->next, record))
+                ;
+        }
+        records.entries.push_back(std::make_pair(registry, record));
+        return record;
+    }
+
+    // collect: 所有处于临界区中的线程都已看到当前纪元时推进全局纪元, 再释放record中足够旧的对象
+    void collect(Record *record)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = registry->global.load();
+        bool advance = true;
+        for (Record *r = registry->head.load(); r != nullptr && advance; r = r->next){
+            std::uint64_t local = r->local.load();
+            advance = (local & 1) == 0 || (local >> 1) == epoch;
+        }
+        if (advance && registry->global.compare_exchange_strong(epoch, epoch + 1))
+            ++epoch;
+        for (std::size_t i = 0; i != 3; ++i)
+            if (!record->limbo[i].empty() && record->limbo_epoch[i] + 2 <= epoch)
+                freeList(record->limbo[i]);
+    }
+};
+#endif
@@ -0,0 +1,88 @@
+/*************************************************************************
+	> File Name: epochReclamation_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时02分56秒
+ ************************************************************************/
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "epochReclamation.h"
+
+std::atomic<int> destroyed(0);
+struct Tracked
+{
+    explicit Tracked(int v) : value(v) {  }
+    ~Tracked() { ++destroyed; }
+    int value;
+};
+
+// guard_test: 有读者停留在临界区中时退休的对象不被释放, 读者离开以后可以释放
+void guard_test()
+{
+    EpochDomain domain;
+    std::atomic<bool> entered(false), leave(false);
+    std::thread reader([&]{
+        EpochDomain::Guard guard(domain);
+        entered = true;
+        while (!leave)
+            std::this_thread::yield();
+    });
+    while (!entered)
+        std::this_thread::yield();
+    destroyed = 0;
+    for (int i = 0; i != 1000; ++i)
+        domain.retire(new Tracked(i));
+    for (int i = 0; i != 10; ++i)
+        domain.collect();
+    bool kept = destroyed == 0 && domain.pending() == 1000;
+    leave = true;
+    reader.join();
+    for (int i = 0; i != 3; ++i)
+        domain.collect();
+    std::cout << "读者在临界区中时不释放: " << (kept ? "正确" : "错误")
+              << ", 读者离开以后释放: " << (destroyed == 1000 && domain.pending() == 0 ? "正确" : "错误") << std::endl;
+}
+
+// concurrent_test: 多个线程同时读写一个共享指针, 读者读到的对象都没有被释放
+void concurrent_test()
+{
+    destroyed = 0;
+    bool correct = true;
+    {
+        EpochDomain domain;
+        std::atomic<Tracked *> shared(new Tracked(0));
+        std::atomic<bool> stop(false), bad(false);
+        std::vector<std::thread> readers;
+        for (int r = 0; r != 3; ++r){
+            readers.emplace_back([&]{
+                while (!stop){
+                    EpochDomain::Guard guard(domain);
+                    Tracked *p = shared.load(std::memory_order_acquire);
+                    if (p->value < 0)
+                        bad = true;
+                }
+            });
+        }
+        for (int i = 1; i != 20000; ++i){
+            Tracked *old = shared.exchange(new Tracked(i));
+            domain.retire(old);
+        }
+        stop = true;
+        for (auto &reader : readers)
+            reader.join();
+        delete shared.load();
+        correct = !bad;
+    }
+    std::cout << "并发读写, 对象全部释放: " << (correct && destroyed == 20000 ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********纪元回收的临界区测试********\n";
+    guard_test();
+    std::cout << "********纪元回收的并发测试********\n";
+    concurrent_test();
+    return 0;
+}
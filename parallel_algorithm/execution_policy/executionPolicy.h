@@ -0,0 +1,112 @@
+/*************************************************************************
+	> File Name: executionPolicy.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时23分22秒
+ ************************************************************************/
+
+#ifndef _EXECUTIONPOLICY_H
+#define _EXECUTIONPOLICY_H
+#include <algorithm>
+#include <cstddef>
+#include "../thread_pool/threadPool.h"
+// 执行策略, 与C++17的std::execution::seq/par/par_unseq对应(本仓库基于C++11)
+/*
+ * 排序, 选择与归约算法的策略重载以ExecutionPolicy作为第一个参数, 例如:
+ *      quickSort(execution::par, v.begin(), v.end());
+ *      mergeSort(execution::par.withThreads(4).withGrain(1 << 16), v.begin(), v.end());
+ *      minimum(execution::seq, v.begin(), v.end());
+ * 策略中保存:
+ *      --kind: Sequenced(串行), Parallel(并行)或ParallelUnsequenced. 后者目前与Parallel相同: 各算法的串行内核
+ *        已经按能被编译器向量化的方式编写, 不再区分"允许交错执行"的情形;
+ *      --threads: 参与计算的线程个数(包括调用线程), 为0时取线程池的工作线程数加1. 对分段的算法它是段数,
+ *        对分治的算法(quickSort)只决定是否并行, 任务由线程池中所有空闲的线程窃取;
+ *      --grain: 不小于该长度的序列才并行, 为0时使用各算法自己的阈值(算法的说明中给出). 短序列直接调用
+ *        串行版本, 不访问线程池, 没有额外开销;
+ *      --pool: 执行任务的线程池, 为nullptr时使用进程中共享的sharedWorkStealingPool().
+ * 策略是很小的值对象, withThreads/withGrain/on返回修改后的副本, 可以链式调用.
+ * 任务在wait中也由调用线程执行, 所以即使线程池没有工作线程(单核的机器), threads大于1的策略也是正确的.
+ *
+ */
+
+// sharedWorkStealingPool: 所有策略重载默认共享的线程池, 第一次使用时创建, 工作线程数为硬件线程数减1
+inline WorkStealingPool& sharedWorkStealingPool()
+{
+    static WorkStealingPool pool(WorkStealingPool::defaultThreads() - 1);
+    return pool;
+}
+
+class ExecutionPolicy
+{
+public:
+    enum Kind { Sequenced, Parallel, ParallelUnsequenced };
+    //****************************构造函数*******************************
+    explicit ExecutionPolicy(Kind k, std::size_t threads = 0, std::size_t grain = 0, WorkStealingPool *pool = nullptr)
+        : policyKind(k), threadCount(threads), grainSize(grain), workers(pool) {  }
+    //****************************成员函数*******************************
+    ExecutionPolicy withThreads(std::size_t threads) const
+    {
+        return ExecutionPolicy(policyKind, threads, grainSize, workers);
+    }
+    ExecutionPolicy withGrain(std::size_t grain) const
+    {
+        return ExecutionPolicy(policyKind, threadCount, grain, workers);
+    }
+    ExecutionPolicy on(WorkStealingPool &pool) const
+    {
+        return ExecutionPolicy(policyKind, threadCount, grainSize, &pool);
+    }
+    Kind kind() const { return policyKind; }
+    bool parallel() const { return policyKind != Sequenced; }
+    bool unsequenced() const { return policyKind == ParallelUnsequenced; }
+    // threads: 参与计算的线程个数, 串行策略为1
+    std::size_t threads() const
+    {
+        if (!parallel())
+            return 1;
+        return threadCount != 0 ? threadCount : pool().size() + 1;
+    }
+    // grain: 并行的最小长度, 没有指定时为算法给出的defaultGrain
+    std::size_t grain(std::size_t defaultGrain) const { return grainSize != 0 ? grainSize : defaultGrain; }
+    // runParallel: 长度为n的序列是否并行处理
+    bool runParallel(std::size_t n, std::size_t defaultGrain) const
+    {
+        return threads() > 1 && n >= grain(defaultGrain);
+    }
+    WorkStealingPool& pool() const { return workers ? *workers : sharedWorkStealingPool(); }
+private:
+    Kind policyKind;
+    std::size_t threadCount;
+    std::size_t grainSize;
+    WorkStealingPool *workers;
+};
+
+// 与std::execution::seq/par/par_unseq同名的三个策略, 都使用共享的线程池
+namespace execution
+{
+    const ExecutionPolicy seq(ExecutionPolicy::Sequenced);
+    const ExecutionPolicy par(ExecutionPolicy::Parallel);
+    const ExecutionPolicy par_unseq(ExecutionPolicy::ParallelUnsequenced);
+}
+
+// parallelFor: 在策略的线程池中执行f(0), f(1), ..., f(tasks - 1), 返回时全部完成
+/*
+ * f(0)由调用线程执行, 其余的作为任务提交; 串行策略或tasks<=1时依次调用, 不访问线程池.
+ * f以引用保存在任务中, 各次调用会并发地访问它; 任务抛出的第一个异常在返回前重新抛出.
+ *
+ */
+template<typename Function>
+void parallelFor(const ExecutionPolicy &exec, std::size_t tasks, Function f)
+{
+    if (tasks <= 1 || !exec.parallel()){
+        for (std::size_t i = 0; i < tasks; ++i)
+            f(i);
+        return;
+    }
+    TaskGroup group(exec.pool());
+    for (std::size_t i = 1; i != tasks; ++i)
+        group.run([&f, i]{ f(i); });
+    f(0);
+    group.wait();
+}
+#endif
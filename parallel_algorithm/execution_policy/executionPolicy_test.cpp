@@ -0,0 +1,83 @@
+/*************************************************************************
+	> File Name: executionPolicy_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时26分05秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "executionPolicy.h"
+
+void Test1()
+{
+    bool right = !execution::seq.parallel() && execution::seq.threads() == 1
+                 && execution::par.parallel() && !execution::par.unsequenced()
+                 && execution::par_unseq.parallel() && execution::par_unseq.unsequenced()
+                 && execution::par.threads() == sharedWorkStealingPool().size() + 1
+                 && &execution::par.pool() == &sharedWorkStealingPool();
+    cout << "seq, par, par_unseq: " << (right ? "正确" : "错误") << endl;
+
+    ExecutionPolicy policy = execution::par.withThreads(4).withGrain(1000);
+    right = policy.threads() == 4 && policy.grain(1 << 20) == 1000 && execution::par.grain(1 << 20) == (1 << 20)
+            && policy.runParallel(1000, 1 << 20) && !policy.runParallel(999, 1 << 20)
+            && !execution::seq.withThreads(4).runParallel(1 << 30, 1) && execution::seq.withThreads(4).threads() == 1
+            && !execution::par.withThreads(1).runParallel(1 << 30, 1);
+    cout << "withThreads, withGrain与并行阈值: " << (right ? "正确" : "错误") << endl;
+
+    WorkStealingPool pool(2);
+    ExecutionPolicy own = execution::par.on(pool);
+    right = &own.pool() == &pool && own.threads() == 3 && own.withGrain(10).threads() == 3
+            && own.kind() == ExecutionPolicy::Parallel;
+    cout << "使用自己的线程池: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    // 串行策略在调用线程中依次执行
+    std::vector<std::size_t> order;
+    std::thread::id caller = std::this_thread::get_id();
+    bool inline_caller = true;
+    parallelFor(execution::seq.withThreads(4), 5, [&](std::size_t i){
+        order.push_back(i);
+        inline_caller = inline_caller && std::this_thread::get_id() == caller;
+    });
+    bool right = order == std::vector<std::size_t>{0, 1, 2, 3, 4} && inline_caller;
+    cout << "串行策略依次执行: " << (right ? "正确" : "错误") << endl;
+
+    WorkStealingPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto &h : hits)
+        h = 0;
+    parallelFor(execution::par.on(pool), hits.size(), [&](std::size_t i){ hits[i].fetch_add(1); });
+    parallelFor(execution::par.withThreads(8), hits.size(), [&](std::size_t i){ hits[i].fetch_add(1); });
+    right = true;
+    for (auto &h : hits)
+        right = right && h.load() == 2;
+    cout << "并行策略每个下标恰好执行一次: " << (right ? "正确" : "错误") << endl;
+
+    try{
+        parallelFor(execution::par.on(pool), 16, [](std::size_t i){
+            if (i == 7)
+                throw std::runtime_error("第7个任务抛出的异常");
+        });
+        cout << "没有捕获到异常(错误)" << endl;
+    }catch (const std::runtime_error &e){
+        cout << "异常重新抛出: " << e.what() << endl;
+    }
+}
+
+int main()
+{
+    cout << "****************执行策略的配置*************************\n";
+    Test1();
+
+    cout << "****************parallelFor****************************\n";
+    Test2();
+
+    return 0;
+}
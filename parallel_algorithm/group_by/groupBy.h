@@ -0,0 +1,620 @@
+/*************************************************************************
+	> File Name: groupBy.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时41分15秒
+ ************************************************************************/
+
+#ifndef _GROUPBY_H
+#define _GROUPBY_H
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../execution_policy/executionPolicy.h"
+#include "../../hash_table/swiss_hash_table/swiss_hash_table.h"
+#include "../../sort_algorithm/radix_sort/radixSort.h"
+#include "../../sort_algorithm/external_sort/externalSort.h"
+// groupBy / distinct: 大数组上的分组聚合与去重
+/*
+ * groupBy(exec, keys, keysEnd, values, agg, sink, options): 对每个不同的键, 把它的所有值用agg聚合为一个状态,
+ * 以sink(key, state)的形式流式地交给调用者; distinct(exec, begin, end, sink, options)对每个不同的键调用sink(key).
+ * 键必须是整数或float/double(与基数排序相同, 见RadixKeyTraits), 按位模式分组(浮点数的+0.0与-0.0是两组).
+ *
+ * 两种策略:
+ *      --散列(GroupByStrategy::hash): 按键的散列值的高位把(键, 值)基数划分为P个分区(P为2的幂), 使每个分区的
+ *        SwissHashTable不超过group_by_partition_bytes(二级缓存), 各分区在线程池中独立地聚合.
+ *        估计的组数很少时P == 1, 直接在输入上聚合, 不复制输入, 工作内存只与组数有关;
+ *      --排序(GroupByStrategy::sort): 按样本的分位点把键的值域划分为若干个区间(每个区间的(键, 值)约为
+ *        group_by_partition_bytes), 每个分区在缓存中用radixSortPairs排序以后扫描相同键的连续段.
+ *        结果按键的次序(RadixKeyTraits的次序)输出.
+ * 自动选择(GroupByStrategy::automatic): 均匀地取group_by_sample个样本, 用GEE估计量(Charikar等, 2000)
+ *      组数 ≈ sqrt(n / s) * f1 + (d - f1)     (s为样本数, d为样本中不同的键数, f1为只出现一次的键数)
+ * 估计组数(用于确定分区数与散列表的大小). 选择策略用样本中重复出现的键数r(生日问题: r ≈ s^2 / (2 * 组数)):
+ * 平均每组少于1 / group_by_sort_ratio个元素(散列聚合几乎不能减少数据)并且估计的散列表超过一个分区(二级缓存)时
+ * 选择排序: 散列这时一样要先划分一遍, 再随机地访问各个表, 顺序访问的基数排序更快; 否则选择散列.
+ * GEE在几乎没有重复时会低估组数, 因此判断不用它. 在4M个64位的(键, 值)上, 平均每组4个元素时散列快约1.5倍,
+ * 几乎每个元素一组时排序快约1.2倍.
+ *
+ * 流式输出: 分区完成以后由完成它的线程在锁内调用sink, 各分区按编号的次序输出, sink不会被并发调用.
+ * 排序策略的结果按键有序; 散列策略的次序由分区数决定(分区数与线程数有关), 同样的输入与线程数时次序相同.
+ *
+ * 内存不足: options.memoryBudget不为0且估计的工作内存超过它时, 把输入按预算分块, 每块在内存中预聚合为
+ * 按键有序的(键, 状态)记录写入临时文件, 再用外部排序的败者树多路归并(见externalSort.h), 合并相同键的状态
+ * (agg.merge)后按键的次序输出. 键与状态必须可以按字节复制, 否则抛出std::length_error.
+ *
+ * 聚合agg(见CountAggregate等)提供:
+ *      --state_type: 状态的类型;
+ *      --first(value): 一组的第一个值的状态; add(state, value): 加入一个值; merge(state, other): 合并两个状态(溢出时使用).
+ *
+ * 算法性能: 散列为O(N / P)(分区时每个元素多读写一次), 排序为O(dN / P)(d为键的字节数); 溢出时磁盘读写的趟数
+ * 为1 + ceil(log_k(R)), R为块数.
+ *
+ */
+const std::size_t group_by_sample = 4096;                           // 估计组数的样本数
+const double group_by_sort_ratio = 0.5;                             // 平均每组少于1 / 该比例个元素时考虑排序策略
+const std::size_t group_by_partition_bytes = std::size_t(1) << 18;  // 每个分区的散列表的大小
+const std::size_t group_by_max_partitions = 1024;
+const std::size_t group_by_parallel_threshold = std::size_t(1) << 16;   // 不小于该长度的输入才使用多线程
+
+enum class GroupByStrategy { automatic, hash, sort };
+
+// GroupByOptions: 策略, 内存预算与临时文件
+struct GroupByOptions
+{
+    GroupByOptions() : strategy(GroupByStrategy::automatic), memoryBudget(0), tempPrefix("groupBy") {  }
+    GroupByStrategy strategy;
+    std::size_t memoryBudget;       // 工作内存的字节数, 0表示不限制
+    std::string tempPrefix;         // 溢出时临时文件名的前缀
+};
+
+// GroupByInfo: 一次groupBy的执行情况
+struct GroupByInfo
+{
+    GroupByStrategy strategy;       // 实际使用的策略
+    std::size_t estimatedGroups;    // 由样本估计的组数
+    std::size_t groups;             // 输出的组数
+    std::size_t partitions;         // 分区数(溢出时为最后一块的分区数)
+    std::size_t runs;               // 溢出时写出的有序段数, 没有溢出时为0
+};
+
+//**************************聚合**********************************
+// CountAggregate: 每组的元素个数
+struct CountAggregate
+{
+    typedef std::uint64_t state_type;
+    template<typename Value>
+    state_type first(const Value &) const { return 1; }
+    template<typename Value>
+    void add(state_type &state, const Value &) const { ++state; }
+    void merge(state_type &state, const state_type &other) const { state += other; }
+};
+// SumAggregate: 每组的值之和(累加为State类型)
+template<typename State>
+struct SumAggregate
+{
+    typedef State state_type;
+    template<typename Value>
+    state_type first(const Value &value) const { return static_cast<State>(value); }
+    template<typename Value>
+    void add(state_type &state, const Value &value) const { state += static_cast<State>(value); }
+    void merge(state_type &state, const state_type &other) const { state += other; }
+};
+// MinAggregate, MaxAggregate: 每组最小(最大)的值
+template<typename T>
+struct MinAggregate
+{
+    typedef T state_type;
+    state_type first(const T &value) const { return value; }
+    void add(state_type &state, const T &value) const { if (value < state) state = value; }
+    void merge(state_type &state, const state_type &other) const { add(state, other); }
+};
+template<typename T>
+struct MaxAggregate
+{
+    typedef T state_type;
+    state_type first(const T &value) const { return value; }
+    void add(state_type &state, const T &value) const { if (state < value) state = value; }
+    void merge(state_type &state, const state_type &other) const { add(state, other); }
+};
+// DistinctAggregate: distinct使用的空状态
+struct DistinctAggregate
+{
+    typedef char state_type;
+    template<typename Value>
+    state_type first(const Value &) const { return 0; }
+    template<typename Value>
+    void add(state_type &, const Value &) const {  }
+    void merge(state_type &, const state_type &) const {  }
+};
+
+//**************************键的散列与比较**********************************
+template<typename Key>
+inline typename RadixKeyTraits<Key>::KeyType groupKeyBits(const Key &key) { return RadixKeyTraits<Key>::toKey(key); }
+template<typename Key>
+struct GroupKeyHash
+{
+    std::uint64_t operator()(const Key &key) const { return hashInteger(static_cast<std::uint64_t>(groupKeyBits(key))); }
+};
+template<typename Key>
+struct GroupKeyEqual
+{
+    bool operator()(const Key &a, const Key &b) const { return groupKeyBits(a) == groupKeyBits(b); }
+};
+
+// GroupRecord: 溢出时写入临时文件的记录
+template<typename Key, typename State>
+struct GroupRecord
+{
+    Key key;
+    State state;
+};
+template<typename Key, typename State>
+struct GroupRecordLess
+{
+    bool operator()(const GroupRecord<Key, State> &a, const GroupRecord<Key, State> &b) const
+    {
+        return groupKeyBits(a.key) < groupKeyBits(b.key);
+    }
+};
+
+// GroupBySample: 有序的样本(键的位模式)与估计的组数
+template<typename Bits>
+struct GroupBySample
+{
+    std::vector<Bits> keys;
+    std::size_t distinct;   // 样本中不同的键数
+    std::size_t groups;     // 估计的组数
+};
+template<typename KeyIterator>
+GroupBySample<typename RadixKeyTraits<typename std::iterator_traits<KeyIterator>::value_type>::KeyType>
+groupBySample(KeyIterator keys, std::size_t n)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type Key;
+    GroupBySample<typename RadixKeyTraits<Key>::KeyType> sample;
+    std::size_t s = std::min(n, group_by_sample);
+    sample.keys.reserve(s);
+    for (std::size_t i = 0; i != s; ++i)
+        sample.keys.push_back(groupKeyBits(keys[static_cast<std::size_t>(static_cast<unsigned long long>(i) * n / s)]));
+    std::sort(sample.keys.begin(), sample.keys.end());
+    std::size_t distinct = 0, singletons = 0;
+    for (std::size_t i = 0, j; i != s; i = j){
+        for (j = i + 1; j != s && sample.keys[j] == sample.keys[i]; ++j)
+            ;
+        ++distinct;
+        singletons += j - i == 1;
+    }
+    double estimate = std::sqrt(static_cast<double>(n) / static_cast<double>(std::max<std::size_t>(1, s))) * singletons
+                      + static_cast<double>(distinct - singletons);
+    sample.distinct = distinct;
+    sample.groups = std::max<std::size_t>(1, std::min(n, static_cast<std::size_t>(estimate)));
+    return sample;
+}
+
+// groupByPartitions: 散列策略的分区数(2的幂)
+inline std::size_t groupByPartitions(std::size_t groups, std::size_t entryBytes, std::size_t threads)
+{
+    std::size_t bytes = groups / 7 * 8 * entryBytes + entryBytes;  // 装载因子7/8
+    std::size_t wanted = std::max<std::size_t>(bytes / group_by_partition_bytes, threads > 1 ? threads * 4 : 1);
+    std::size_t partitions = 1;
+    while (partitions < wanted && partitions < group_by_max_partitions)
+        partitions *= 2;
+    return partitions;
+}
+
+// GroupBySplitters: 排序策略的分位点, 按隐式的完全二叉树存放(Sanders, Winkel, 2004的super scalar sample sort)
+/*
+ * tree[1, P)是P - 1个有序分位点的中序排列, 查找时从根走log2(P)层, 每层的比较结果直接算出下一个结点,
+ * 没有难以预测的分支(std::upper_bound在随机的键上每层都会预测失败). 返回不大于key的分位点个数.
+ *
+ */
+template<typename Bits>
+class GroupBySplitters
+{
+public:
+    // sorted为有序的样本, partitions为2的幂
+    GroupBySplitters(const std::vector<Bits> &sorted, std::size_t partitions) : tree(partitions), levels(0)
+    {
+        for (std::size_t p = partitions; p > 1; p /= 2)
+            ++levels;
+        std::size_t next = 1;
+        fill(sorted, 1, next);
+    }
+    std::size_t operator()(Bits key) const
+    {
+        std::size_t node = 1;
+        for (std::size_t l = 0; l != levels; ++l)
+            node = 2 * node + static_cast<std::size_t>(tree[node] <= key);
+        return node - tree.size();
+    }
+private:
+    void fill(const std::vector<Bits> &sorted, std::size_t node, std::size_t &next)
+    {
+        if (node >= tree.size())
+            return;
+        fill(sorted, 2 * node, next);
+        tree[node] = sorted[sorted.size() * next++ / tree.size()];
+        fill(sorted, 2 * node + 1, next);
+    }
+    std::vector<Bits> tree;
+    std::size_t levels;
+};
+
+// GroupByEmitter: 按分区编号的次序输出已经完成的分区
+template<typename Key, typename State, typename Sink>
+class GroupByEmitter
+{
+public:
+    GroupByEmitter(std::size_t partitions, Sink &s) : results(partitions), ready(partitions, 0), next(0), sink(s) {  }
+    std::vector<std::pair<Key, State>>& partition(std::size_t p) { return results[p]; }
+    // finish: 第p个分区完成, 输出从next开始所有已经完成的分区
+    void finish(std::size_t p)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ready[p] = 1;
+        for (; next != results.size() && ready[next]; ++next){
+            for (auto &group : results[next])
+                sink(group.first, group.second);
+            std::vector<std::pair<Key, State>>().swap(results[next]);
+        }
+    }
+private:
+    std::vector<std::vector<std::pair<Key, State>>> results;
+    std::vector<char> ready;
+    std::size_t next;
+    Sink &sink;
+    std::mutex lock;
+};
+
+// groupBySortedScan: 扫描按键排好序的keys[0, n)与values, 每个相同键的连续段输出一组
+template<typename Key, typename Value, typename Aggregate, typename Sink>
+void groupBySortedScan(const Key *keys, const Value *values, std::size_t n, const Aggregate &agg, Sink &sink)
+{
+    for (std::size_t i = 0; i != n; ){
+        typename Aggregate::state_type state = agg.first(values[i]);
+        std::size_t j = i + 1;
+        for (; j != n && groupKeyBits(keys[j]) == groupKeyBits(keys[i]); ++j)
+            agg.add(state, values[j]);
+        sink(keys[i], state);
+        i = j;
+    }
+}
+
+// groupByInMemory: 在内存中完成n个(键, 值)的分组聚合
+template<typename KeyIterator, typename ValueIterator, typename Aggregate, typename Sink>
+void groupByInMemory(const ExecutionPolicy &exec, KeyIterator keys, std::size_t n, ValueIterator values,
+                     const Aggregate &agg, GroupByStrategy strategy,
+                     const GroupBySample<typename RadixKeyTraits<typename std::iterator_traits<KeyIterator>::value_type>::KeyType> &sample,
+                     Sink &sink, GroupByInfo &info)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type Key;
+    typedef typename std::iterator_traits<ValueIterator>::value_type Value;
+    typedef typename Aggregate::state_type State;
+    typedef typename RadixKeyTraits<Key>::KeyType Bits;
+    typedef SwissHashTable<Key, State, GroupKeyHash<Key>, GroupKeyEqual<Key>> Table;
+    const bool parallel = exec.runParallel(n, group_by_parallel_threshold);
+    const ExecutionPolicy &run = parallel ? exec : execution::seq;
+    const std::size_t threads = parallel ? exec.threads() : 1;
+
+    // 分区: 散列策略按散列值的高位, 排序策略按样本的分位点
+    std::size_t partitions = 1, hashShift = 64;
+    if (strategy == GroupByStrategy::hash){
+        partitions = groupByPartitions(std::min(n, sample.groups), sizeof(Key) + sizeof(State) + 1, threads);
+        for (std::size_t p = partitions; p > 1; p /= 2)
+            --hashShift;
+    }else{
+        // 每个分区的(键, 值)在二级缓存中排序; 重复的分位点使一些分区为空, 不影响结果
+        std::size_t wanted = std::max<std::size_t>(n * (sizeof(Key) + sizeof(Value)) / group_by_partition_bytes,
+                                                   threads > 1 ? threads * 4 : 1);
+        wanted = std::min(std::min(wanted, group_by_max_partitions), sample.keys.size());
+        while (partitions < wanted)
+            partitions *= 2;
+    }
+    info.partitions = partitions;
+    const GroupBySplitters<Bits> splitters(sample.keys, strategy == GroupByStrategy::sort ? partitions : 1);
+    auto partitionOf = [&](const Key &key) -> std::size_t {
+        if (strategy == GroupByStrategy::hash)
+            return hashShift == 64 ? 0 : static_cast<std::size_t>(GroupKeyHash<Key>()(key) >> hashShift);
+        return splitters(groupKeyBits(key));
+    };
+
+    if (partitions == 1){
+        // 不分区: 散列表直接读输入, 排序需要可以修改的副本
+        if (strategy == GroupByStrategy::hash){
+            Table table(std::min(n, sample.groups));
+            for (std::size_t i = 0; i != n; ++i){
+                State *state = table.find(keys[i]);
+                if (state)
+                    agg.add(*state, values[i]);
+                else
+                    table.insert(keys[i], agg.first(values[i]));
+            }
+            table.forEach([&sink](const Key &key, const State &state){ sink(key, state); });
+        }else{
+            std::vector<Key> k(keys, keys + n);
+            std::vector<Value> v(values, values + n);
+            radixSortPairs(k.begin(), k.end(), v.begin());
+            groupBySortedScan(k.data(), v.data(), n, agg, sink);
+        }
+        return;
+    }
+
+    // 稳定的并行划分: 每段统计各分区的个数, 再把(键, 值)分配到分区的连续区间中
+    const std::size_t chunks = threads;
+    std::vector<std::uint16_t> part(n);
+    std::vector<std::size_t> offsets(chunks * partitions, 0);
+    parallelFor(run, chunks, [&](std::size_t c){
+        std::size_t *count = &offsets[c * partitions];
+        for (std::size_t i = n * c / chunks, to = n * (c + 1) / chunks; i != to; ++i){
+            part[i] = static_cast<std::uint16_t>(partitionOf(keys[i]));
+            ++count[part[i]];
+        }
+    });
+    std::vector<std::size_t> start(partitions + 1, 0);
+    for (std::size_t p = 0, sum = 0; p != partitions; ++p){
+        start[p] = sum;
+        for (std::size_t c = 0; c != chunks; ++c){
+            std::size_t count = offsets[c * partitions + p];
+            offsets[c * partitions + p] = sum;
+            sum += count;
+        }
+    }
+    start[partitions] = n;
+    std::vector<Key> partKeys(n);
+    std::vector<Value> partValues(n);
+    parallelFor(run, chunks, [&](std::size_t c){
+        std::size_t *next = &offsets[c * partitions];
+        for (std::size_t i = n * c / chunks, to = n * (c + 1) / chunks; i != to; ++i){
+            std::size_t d = next[part[i]]++;
+            partKeys[d] = keys[i];
+            partValues[d] = values[i];
+        }
+    });
+    std::vector<std::uint16_t>().swap(part);
+
+    // 各分区独立地聚合, 完成以后按编号的次序输出
+    GroupByEmitter<Key, State, Sink> emitter(partitions, sink);
+    const std::size_t perPartition = std::min(n, sample.groups) / partitions + 1;
+    parallelFor(run, partitions, [&](std::size_t p){
+        std::size_t from = start[p], size = start[p + 1] - start[p];
+        std::vector<std::pair<Key, State>> &result = emitter.partition(p);
+        auto collect = [&result](const Key &key, const State &state){ result.push_back(std::make_pair(key, state)); };
+        if (strategy == GroupByStrategy::hash){
+            Table table(std::min(size, perPartition + perPartition / 4));
+            for (std::size_t i = from; i != from + size; ++i){
+                State *state = table.find(partKeys[i]);
+                if (state)
+                    agg.add(*state, partValues[i]);
+                else
+                    table.insert(partKeys[i], agg.first(partValues[i]));
+            }
+            result.reserve(table.size());
+            table.forEach(collect);
+        }else{
+            radixSortPairs(partKeys.begin() + from, partKeys.begin() + from + size, partValues.begin() + from);
+            groupBySortedScan(partKeys.data() + from, partValues.data() + from, size, agg, collect);
+        }
+        emitter.finish(p);
+    });
+}
+
+// groupByWorkingBytes: 内存中聚合的工作内存的估计
+template<typename Key, typename Value, typename State>
+std::size_t groupByWorkingBytes(std::size_t n, std::size_t groups, GroupByStrategy strategy, std::size_t threads)
+{
+    std::size_t tables = (std::min(n, groups) + 1) * (sizeof(Key) + sizeof(State) + 1) * 2;
+    if (strategy == GroupByStrategy::sort)
+        return n * (sizeof(Key) + sizeof(Value)) * 2 + n * 2 + tables;
+    bool partitioned = groupByPartitions(std::min(n, groups), sizeof(Key) + sizeof(State) + 1, threads) > 1;
+    return (partitioned ? n * (sizeof(Key) + sizeof(Value) + 2) : 0) + tables;
+}
+
+// groupByMergeRuns: 多路归并按键有序的记录文件, 合并相同键的状态后按键的次序调用sink
+template<typename Key, typename State, typename Aggregate, typename Sink>
+void groupByMergeRuns(const std::vector<std::string> &runs, std::size_t block, const Aggregate &agg, Sink &sink)
+{
+    typedef GroupRecord<Key, State> Record;
+    std::vector<std::unique_ptr<RunReader<Record>>> readers;
+    std::vector<Record> heads(runs.size());
+    std::vector<char> exhausted(runs.size(), 0);
+    for (std::size_t i = 0; i != runs.size(); ++i){
+        readers.emplace_back(new RunReader<Record>(runs[i], block));
+        if (readers[i]->empty())
+            exhausted[i] = 1;
+        else
+            heads[i] = readers[i]->front();
+    }
+    LoserTree<Record, GroupRecordLess<Key, State>> tree(runs.size(), heads, exhausted);
+    bool open = false;
+    Record current;
+    while (true){
+        std::size_t i = tree.winner();
+        if (exhausted[i])
+            break;
+        if (open && groupKeyBits(current.key) == groupKeyBits(heads[i].key)){
+            agg.merge(current.state, heads[i].state);
+        }else{
+            if (open)
+                sink(current.key, current.state);
+            current = heads[i];
+            open = true;
+        }
+        readers[i]->pop();
+        if (readers[i]->empty())
+            exhausted[i] = 1;
+        else
+            heads[i] = readers[i]->front();
+        tree.replay(i);
+    }
+    if (open)
+        sink(current.key, current.state);
+}
+
+// groupBySpill: 分块预聚合, 写出有序段以后归并
+template<typename KeyIterator, typename ValueIterator, typename Aggregate, typename Sink>
+void groupBySpill(const ExecutionPolicy &exec, KeyIterator keys, std::size_t n, ValueIterator values, const Aggregate &agg,
+                  GroupByStrategy strategy, const GroupByOptions &options, Sink &sink, GroupByInfo &info, std::true_type)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type Key;
+    typedef typename std::iterator_traits<ValueIterator>::value_type Value;
+    typedef typename Aggregate::state_type State;
+    typedef GroupRecord<Key, State> Record;
+    const std::size_t recordBytes = (sizeof(Key) + sizeof(Value)) * 2 + 2 + (sizeof(Key) + sizeof(State) + 1) * 2;
+    const std::size_t chunk = std::max<std::size_t>(1, options.memoryBudget / recordBytes);
+    std::vector<std::string> runs, merged;     // merged: 多趟归并中这一趟已经写出的有序段
+    std::size_t nextRun = 0;
+    auto runName = [&]{ return options.tempPrefix + ".groupby" + std::to_string(nextRun++); };
+    auto removeRuns = [](const std::vector<std::string> &names){
+        for (auto &name : names)
+            std::remove(name.c_str());
+    };
+    const std::size_t budgetRecords = std::max<std::size_t>(1, options.memoryBudget / sizeof(Record));
+    try{
+        // 第一步: 每块在内存中预聚合, 按键排序以后写成一个有序段
+        std::vector<Key> groupKeys;
+        std::vector<State> groupStates;
+        for (std::size_t from = 0; from < n; from += chunk){
+            std::size_t size = std::min(chunk, n - from);
+            groupKeys.clear();
+            groupStates.clear();
+            auto collect = [&](const Key &key, const State &state){
+                groupKeys.push_back(key);
+                groupStates.push_back(state);
+            };
+            groupByInMemory(exec, keys + from, size, values + from, agg, strategy, groupBySample(keys + from, size), collect, info);
+            if (strategy == GroupByStrategy::hash)
+                radixSortPairs(groupKeys.begin(), groupKeys.end(), groupStates.begin());
+            runs.push_back(runName());
+            RunWriter<Record> writer(runs.back(), std::max<std::size_t>(1, std::min(budgetRecords / 4, groupKeys.size())));
+            for (std::size_t i = 0; i != groupKeys.size(); ++i)
+                writer.push(Record{groupKeys[i], groupStates[i]});
+            writer.close();
+        }
+        std::vector<Key>().swap(groupKeys);
+        std::vector<State>().swap(groupStates);
+        info.runs = runs.size();
+        // 第二步: 多路归并, 路数太多时分多趟, 与externalSort相同
+        std::size_t minBlock = std::max<std::size_t>(1, external_min_block_bytes / sizeof(Record));
+        std::size_t fanIn = budgetRecords / (2 * minBlock);
+        fanIn = fanIn > 3 ? fanIn - 1 : 2;
+        while (runs.size() > fanIn){
+            merged.clear();
+            for (std::size_t first = 0; first < runs.size(); first += fanIn){
+                std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + fanIn));
+                merged.push_back(runName());
+                std::size_t block = std::max<std::size_t>(1, budgetRecords / (2 * (group.size() + 1)));
+                RunWriter<Record> writer(merged.back(), block);
+                auto write = [&writer](const Key &key, const State &state){ writer.push(Record{key, state}); };
+                groupByMergeRuns<Key, State>(group, block, agg, write);
+                writer.close();
+                removeRuns(group);
+            }
+            runs.swap(merged);
+        }
+        merged.clear();
+        groupByMergeRuns<Key, State>(runs, std::max<std::size_t>(1, budgetRecords / (2 * runs.size())), agg, sink);
+        removeRuns(runs);
+    }catch (...){
+        removeRuns(runs);
+        removeRuns(merged);
+        throw;
+    }
+}
+template<typename KeyIterator, typename ValueIterator, typename Aggregate, typename Sink>
+void groupBySpill(const ExecutionPolicy &, KeyIterator, std::size_t, ValueIterator, const Aggregate &,
+                  GroupByStrategy, const GroupByOptions &, Sink &, GroupByInfo &, std::false_type)
+{
+    throw std::length_error("groupBy error: the memory budget is exceeded and the state cannot be spilled!");
+}
+
+// groupBy: 按执行策略对[keys, keysEnd)与values中同样个数的值分组聚合, 每组调用一次sink(key, state)
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为group_by_parallel_threshold;
+ * \parameter keys, keysEnd: 键序列(随机访问迭代器), 键为整数或float/double;
+ * \parameter values: 值序列的起始迭代器(随机访问迭代器), 第i个值属于第i个键;
+ * \parameter agg: 聚合(见CountAggregate);
+ * \parameter sink: 可调用对象sink(const Key &, const state_type &), 不会被并发调用;
+ * \parameter options: 策略, 内存预算与临时文件名的前缀;
+ * \return 执行情况.
+ *
+ */
+template<typename KeyIterator, typename ValueIterator, typename Aggregate, typename Sink>
+GroupByInfo groupBy(const ExecutionPolicy &exec, KeyIterator keys, KeyIterator keysEnd, ValueIterator values,
+                    const Aggregate &agg, Sink sink, const GroupByOptions &options = GroupByOptions())
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type Key;
+    typedef typename std::iterator_traits<ValueIterator>::value_type Value;
+    typedef typename Aggregate::state_type State;
+    GroupByInfo info = {GroupByStrategy::hash, 0, 0, 0, 0};
+    std::size_t n = static_cast<std::size_t>(std::distance(keys, keysEnd));
+    if (n == 0)
+        return info;
+    auto counted = [&info, &sink](const Key &key, const State &state){
+        ++info.groups;
+        sink(key, state);
+    };
+    auto sample = groupBySample(keys, n);
+    info.estimatedGroups = sample.groups;
+    std::size_t threads = exec.runParallel(n, group_by_parallel_threshold) ? exec.threads() : 1;
+    // 样本就是全部输入时不同的键数是准确的组数, 否则由重复出现的键数估计平均每组的元素个数
+    const double s = static_cast<double>(sample.keys.size()), repeats = s - static_cast<double>(sample.distinct);
+    bool smallGroups = sample.keys.size() == n ? sample.distinct > n * group_by_sort_ratio
+                                                : s * s > 2.0 * repeats * static_cast<double>(n) * group_by_sort_ratio;
+    bool manyGroups = smallGroups && groupByPartitions(sample.groups, sizeof(Key) + sizeof(State) + 1, 1) > 1;
+    info.strategy = options.strategy != GroupByStrategy::automatic ? options.strategy
+                  : manyGroups ? GroupByStrategy::sort : GroupByStrategy::hash;
+    if (options.memoryBudget != 0
+        && groupByWorkingBytes<Key, Value, State>(n, sample.groups, info.strategy, threads) > options.memoryBudget){
+        typedef std::integral_constant<bool, std::is_trivially_copyable<Key>::value
+                                             && std::is_trivially_copyable<State>::value> Spillable;
+        groupBySpill(exec, keys, n, values, agg, info.strategy, options, counted, info, Spillable());
+    }else{
+        groupByInMemory(exec, keys, n, values, agg, info.strategy, sample, counted, info);
+    }
+    return info;
+}
+
+// groupBy: 单线程的分组聚合, 结果保存在数组中(散列策略时次序不确定)
+template<typename Key, typename Value, typename Aggregate>
+std::vector<std::pair<Key, typename Aggregate::state_type>>
+groupBy(const std::vector<Key> &keys, const std::vector<Value> &values, const Aggregate &agg,
+        const GroupByOptions &options = GroupByOptions())
+{
+    if (keys.size() != values.size())
+        throw std::invalid_argument("groupBy error: keys and values have different lengths!");
+    std::vector<std::pair<Key, typename Aggregate::state_type>> result;
+    groupBy(execution::seq, keys.begin(), keys.end(), values.begin(), agg,
+            [&result](const Key &key, const typename Aggregate::state_type &state){ result.push_back(std::make_pair(key, state)); },
+            options);
+    return result;
+}
+
+// distinct: 按执行策略对[begin, end)中每个不同的键调用一次sink(key)
+template<typename Iterator, typename Sink>
+GroupByInfo distinct(const ExecutionPolicy &exec, Iterator begin, Iterator end, Sink sink,
+                     const GroupByOptions &options = GroupByOptions())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type Key;
+    return groupBy(exec, begin, end, begin, DistinctAggregate(),
+                   [&sink](const Key &key, const DistinctAggregate::state_type &){ sink(key); }, options);
+}
+
+// distinct: [begin, end)中不同的键(散列策略时次序不确定)
+template<typename Iterator>
+std::vector<typename std::iterator_traits<Iterator>::value_type> distinct(Iterator begin, Iterator end)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type Key;
+    std::vector<Key> result;
+    distinct(execution::seq, begin, end, [&result](const Key &key){ result.push_back(key); });
+    return result;
+}
+#endif
@@ -0,0 +1,271 @@
+/*************************************************************************
+	> File Name: groupBy_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时46分34秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "groupBy.h"
+
+// reference: 用std::map求每组的和
+template<typename Key, typename Value>
+std::map<Key, long long> reference(const vector<Key> &keys, const vector<Value> &values)
+{
+    std::map<Key, long long> result;
+    for (std::size_t i = 0; i != keys.size(); ++i)
+        result[keys[i]] += values[i];
+    return result;
+}
+
+// collectSums: 按执行策略求每组的和, 同时检查每个键只输出一次
+template<typename Key>
+bool sameAsReference(const ExecutionPolicy &exec, const vector<Key> &keys, const vector<int> &values,
+                     const GroupByOptions &options, GroupByInfo &info, vector<std::pair<Key, long long>> &output)
+{
+    output.clear();
+    info = groupBy(exec, keys.begin(), keys.end(), values.begin(), SumAggregate<long long>(),
+                   [&output](const Key &key, long long sum){ output.push_back(std::make_pair(key, sum)); }, options);
+    std::map<Key, long long> expected = reference(keys, values);
+    std::map<Key, long long> actual(output.begin(), output.end());
+    return actual.size() == output.size() && actual == expected && info.groups == expected.size();
+}
+
+template<typename Key>
+bool sortedByKey(const vector<std::pair<Key, long long>> &output)
+{
+    for (std::size_t i = 1; i < output.size(); ++i)
+        if (!(output[i - 1].first < output[i].first))
+            return false;
+    return true;
+}
+
+void Test1()
+{
+    std::mt19937_64 e(2026);
+    const std::size_t n = 300000;
+    vector<int> values(n);
+    for (auto &v : values)
+        v = static_cast<int>(e() % 1000) - 500;
+    // 组数很少: 自动选择散列
+    vector<int> few(n);
+    for (auto &k : few)
+        k = static_cast<int>(e() % 100) - 50;
+    GroupByInfo info;
+    vector<std::pair<int, long long>> output, parallelOutput;
+    bool right = sameAsReference(execution::seq, few, values, GroupByOptions(), info, output);
+    cout << "100组(估计" << info.estimatedGroups << "组): " << (right && info.strategy == GroupByStrategy::hash ? "正确" : "错误") << endl;
+
+    // 几乎每个元素一组: 自动选择排序, 结果按键有序
+    vector<std::int64_t> many(n);
+    for (auto &k : many)
+        k = static_cast<std::int64_t>(e() % 1000000000) - 500000000;
+    vector<std::pair<std::int64_t, long long>> wide, wideParallel;
+    right = sameAsReference(execution::seq, many, values, GroupByOptions(), info, wide);
+    cout << "几乎没有重复的键(估计" << info.estimatedGroups << "组): "
+         << (right && info.strategy == GroupByStrategy::sort && sortedByKey(wide) ? "正确" : "错误") << endl;
+
+    // 多线程与单线程的结果相同, 排序策略时次序也相同
+    bool same = true;
+    GroupByOptions options;
+    ExecutionPolicy par = execution::par.withThreads(4).withGrain(1);
+    const GroupByStrategy strategies[] = {GroupByStrategy::hash, GroupByStrategy::sort};
+    for (GroupByStrategy strategy : strategies){
+        options.strategy = strategy;
+        same = same && sameAsReference(execution::seq, few, values, options, info, output)
+                    && sameAsReference(par, few, values, options, info, parallelOutput) && info.partitions > 1;
+        same = same && sameAsReference(execution::seq, many, values, options, info, wide)
+                    && sameAsReference(par, many, values, options, info, wideParallel);
+        if (strategy == GroupByStrategy::sort)
+            same = same && output == parallelOutput && wide == wideParallel && sortedByKey(output) && sortedByKey(wideParallel);
+    }
+    cout << "多线程与单线程的输出相同: " << (same ? "正确" : "错误") << endl;
+
+    // 浮点数的键, 最小值与计数
+    vector<double> prices(n);
+    for (std::size_t i = 0; i != n; ++i)
+        prices[i] = static_cast<double>(static_cast<int>(e() % 2000) - 1000) / 8;
+    std::map<double, int> least;
+    std::map<double, std::uint64_t> counts;
+    for (std::size_t i = 0; i != n; ++i){
+        auto it = least.find(prices[i]);
+        if (it == least.end() || values[i] < it->second)
+            least[prices[i]] = values[i];
+        ++counts[prices[i]];
+    }
+    std::map<double, int> gotLeast;
+    std::map<double, std::uint64_t> gotCounts;
+    groupBy(par, prices.begin(), prices.end(), values.begin(), MinAggregate<int>(),
+            [&gotLeast](double key, int v){ gotLeast[key] = v; });
+    groupBy(par, prices.begin(), prices.end(), values.begin(), CountAggregate(),
+            [&gotCounts](double key, std::uint64_t c){ gotCounts[key] = c; });
+    cout << "浮点数的键(最小值与计数): " << (gotLeast == least && gotCounts == counts ? "正确" : "错误") << endl;
+
+    // distinct
+    vector<int> d = distinct(few.begin(), few.end());
+    std::map<int, long long> groups = reference(few, values);
+    bool distinctRight = d.size() == groups.size();
+    for (int k : d)
+        distinctRight = distinctRight && groups.count(k) == 1;
+    std::size_t wideCount = 0, sortedCount = 0;
+    int previous = 0;
+    bool ordered = true;
+    options.strategy = GroupByStrategy::sort;
+    distinct(par, many.begin(), many.end(), [&](std::int64_t){ ++wideCount; }, options);
+    distinct(par, few.begin(), few.end(), [&](int k){ ordered = ordered && (sortedCount++ == 0 || previous < k); previous = k; }, options);
+    ordered = ordered && sortedCount == groups.size() && wideCount == reference(many, values).size();
+    cout << "distinct: " << (distinctRight && ordered ? "正确" : "错误") << endl;
+
+    bool empty = groupBy(vector<int>(), vector<int>(), CountAggregate()).empty() && distinct(few.begin(), few.begin()).empty();
+    bool thrown = false;
+    try{
+        groupBy(few, vector<int>(3), CountAggregate());
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    cout << "空输入与长度不同的输入: " << (empty && thrown ? "正确" : "错误") << endl;
+}
+
+// ConcatAggregate: 状态为std::string, 不能溢出到文件
+struct ConcatAggregate
+{
+    typedef std::string state_type;
+    std::string first(int value) const { return std::to_string(value); }
+    void add(std::string &state, int value) const { state += "," + std::to_string(value); }
+    void merge(std::string &state, const std::string &other) const { state += "," + other; }
+};
+
+// FailingAggregate: 计数, 第limit次合并状态时抛出异常(模拟归并中途的失败)
+struct FailingAggregate
+{
+    typedef std::uint64_t state_type;
+    std::size_t *merges;
+    std::size_t limit;
+    std::uint64_t first(int) const { return 1; }
+    void add(std::uint64_t &state, int) const { ++state; }
+    void merge(std::uint64_t &state, const std::uint64_t &other) const
+    {
+        if (++*merges == limit)
+            throw std::runtime_error("FailingAggregate");
+        state += other;
+    }
+};
+
+bool fileExists(const std::string &name)
+{
+    std::FILE *file = std::fopen(name.c_str(), "rb");
+    if (file)
+        std::fclose(file);
+    return file != nullptr;
+}
+
+void Test2()
+{
+    // 内存预算不足时溢出到有序段, 归并以后按键有序输出
+    std::mt19937_64 e(7);
+    const std::size_t n = 200000;
+    vector<std::uint32_t> keys(n);
+    vector<int> values(n);
+    for (std::size_t i = 0; i != n; ++i){
+        keys[i] = static_cast<std::uint32_t>(e() % 50000);
+        values[i] = static_cast<int>(e() % 100);
+    }
+    bool right = true;
+    GroupByOptions options;
+    options.memoryBudget = 1 << 16;
+    options.tempPrefix = "groupBy_test";
+    const GroupByStrategy strategies[] = {GroupByStrategy::hash, GroupByStrategy::sort, GroupByStrategy::automatic};
+    GroupByInfo info;
+    vector<std::pair<std::uint32_t, long long>> output;
+    for (GroupByStrategy strategy : strategies){
+        options.strategy = strategy;
+        right = right && sameAsReference(execution::par.withThreads(4).withGrain(1), keys, values, options, info, output)
+                      && sortedByKey(output) && info.runs > 1;
+    }
+    cout << "溢出到有序段(" << info.runs << "个): " << (right && !fileExists("groupBy_test.groupby0") ? "正确" : "错误") << endl;
+
+    // 预算很小时需要多趟归并
+    options.memoryBudget = 1 << 12;
+    options.strategy = GroupByStrategy::automatic;
+    right = sameAsReference(execution::seq, keys, values, options, info, output) && sortedByKey(output);
+    cout << "多趟归并(" << info.runs << "个有序段): " << (right ? "正确" : "错误") << endl;
+
+    // 多趟归并的中途失败时删除所有的临时文件(包括这一趟已经写出的有序段)
+    std::size_t merges = 0;
+    bool failed = false;
+    try{
+        groupBy(execution::seq, keys.begin(), keys.end(), values.begin(), FailingAggregate{&merges, 200},
+                [](std::uint32_t, std::uint64_t){  }, options);
+    }catch (const std::runtime_error &){
+        failed = true;
+    }
+    bool removed = true;
+    for (std::size_t i = 0; i != 2 * info.runs; ++i)
+        removed = removed && !fileExists("groupBy_test.groupby" + std::to_string(i));
+    cout << "归并中途失败时删除临时文件: " << (failed && removed ? "正确" : "错误") << endl;
+
+    // 状态不能按字节复制时不能溢出
+    bool thrown = false;
+    try{
+        groupBy(execution::seq, keys.begin(), keys.end(), values.begin(), ConcatAggregate(),
+                [](std::uint32_t, const std::string &){  }, options);
+    }catch (const std::length_error &){
+        thrown = true;
+    }
+    options.memoryBudget = 0;
+    std::size_t total = 0;
+    groupBy(execution::seq, keys.begin(), keys.begin() + 1000, values.begin(), ConcatAggregate(),
+            [&total](std::uint32_t, const std::string &s){ total += std::count(s.begin(), s.end(), ',') + 1; }, options);
+    cout << "不能溢出的状态抛出异常, 不溢出时正常聚合: " << (thrown && total == 1000 ? "正确" : "错误") << endl;
+}
+
+void Test3()
+{
+    // 性能: 两种策略在不同的组数上
+    const std::size_t n = 4000000;
+    std::mt19937_64 e(1);
+    vector<std::uint64_t> values(n);
+    for (auto &v : values)
+        v = e() % 1000;
+    const std::size_t cardinalities[] = {1000, 1000000, 1000000000};
+    for (std::size_t groups : cardinalities){
+        vector<std::uint64_t> keys(n);
+        for (auto &k : keys)
+            k = e() % groups;
+        const GroupByStrategy strategies[] = {GroupByStrategy::hash, GroupByStrategy::sort, GroupByStrategy::automatic};
+        const char *names[] = {"散列", "排序", "自动"};
+        cout << "键的取值范围" << groups << ":";
+        for (int s = 0; s != 3; ++s){
+            GroupByOptions options;
+            options.strategy = strategies[s];
+            std::uint64_t checksum = 0;
+            auto begin = std::chrono::steady_clock::now();
+            GroupByInfo info = groupBy(execution::par, keys.begin(), keys.end(), values.begin(), SumAggregate<std::uint64_t>(),
+                                       [&checksum](std::uint64_t key, std::uint64_t sum){ checksum += key ^ sum; }, options);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            cout << " " << names[s] << (info.strategy == GroupByStrategy::hash ? "(散列)" : "(排序)") << seconds << "秒";
+        }
+        cout << endl;
+    }
+}
+
+int main()
+{
+    cout << "********内存中的分组聚合********\n";
+    Test1();
+    cout << "********溢出到外部排序********\n";
+    Test2();
+    cout << "********性能********\n";
+    Test3();
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*************************************************************************
+	> File Name: threadPool.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时12分40秒
+ ************************************************************************/
+
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../work_stealing_deque/chaseLevDeque.h"
+#include "../../queue_algorithm/mpmc_queue/mpmcQueue.h"
+// WorkStealingPool: 工作窃取线程池
+/*
+ * 每个工作线程拥有一个自己的任务双端队列(ChaseLevDeque, 无锁):
+ *      --工作线程自己产生的任务压入自己队列的底部, 并且从底部取出(后进先出,局部性好), 没有竞争时不做CAS;
+ *      --空闲的工作线程从其它线程队列的顶部窃取任务(先进先出,窃取到的通常是较大的子任务);
+ *      --非工作线程提交的任务放入一个共享的有界注入队列(MpmcQueue), 由工作线程取出; 注入队列满时提交的线程
+ *        先帮忙执行任务再重试, 所以不会丢失任务.
+ * 有任务的时候不加锁, 只有没有任务可取, 工作线程准备睡眠时才使用sleep_mutex.
+ *
+ * 线程池本身不保证任务的先后次序, 需要等待一组任务时使用TaskGroup.
+ *
+ */
+class WorkStealingPool
+{
+public:
+    typedef std::function<void()> TaskType;
+    //****************************构造函数*******************************
+    // threads: 工作线程的个数(为0时不创建工作线程, 所有任务由调用wait的线程完成)
+    explicit WorkStealingPool(std::size_t threads = defaultThreads())
+        : deques(threads), injected(inject_capacity), pending(0), stopping(false)
+    {
+        for (std::size_t i = 0; i != threads; ++i)
+            deques[i].reset(new WorkDeque);
+        for (std::size_t i = 0; i != threads; ++i)
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool& operator= (const WorkStealingPool &) = delete;
+    // 析构函数: 等待所有工作线程退出(尚未执行的任务会被执行完)
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        sleep_cv.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+        // 没有工作线程时, 没有被等待的任务留在注入队列中
+        TaskType *task;
+        while (injected.try_pop(task))
+            delete task;
+    }
+    //****************************成员函数*******************************
+    // size: 工作线程的个数
+    std::size_t size() const { return workers.size(); }
+
+    // defaultThreads: 默认的工作线程个数(硬件线程数, 无法获取时为1)
+    static std::size_t defaultThreads()
+    {
+        std::size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    // submit: 提交一个任务
+    /*
+     * \parameter task: 待执行的任务;
+     * \return void.
+     *
+     * 若当前线程是本线程池的工作线程, 任务压入它自己的队列底部; 否则放入注入队列.
+     *
+     */
+    void submit(TaskType task)
+    {
+        TaskType *node = new TaskType(std::move(task));
+        pending.fetch_add(1);
+        if (current().pool == this)
+            deques[current().index]->push(node);
+        else{
+            while (!injected.try_push(node)){
+                // 注入队列满: 帮忙执行一个任务, 腾出位置
+                if (!tryRunOne())
+                    std::this_thread::yield();
+            }
+        }
+        {
+            // 加锁再通知, 避免工作线程在检查pending和进入睡眠之间漏掉通知
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        sleep_cv.notify_one();
+    }
+
+    // tryRunOne: 尝试执行一个任务(先取自己的队列, 再取注入队列, 最后窃取其它队列)
+    /*
+     * \return 是否执行了一个任务.
+     *
+     * 等待任务完成的线程调用它来"帮忙", 这样等待中的线程不会闲置, 也不会因为嵌套等待而死锁.
+     *
+     */
+    bool tryRunOne()
+    {
+        TaskType *task;
+        std::size_t self = (current().pool == this) ? current().index : deques.size();
+        if (!popTask(self, task))
+            return false;
+        std::unique_ptr<TaskType> owner(task);
+        (*task)();
+        return true;
+    }
+private:
+    //****************************数据结构*******************************
+    static const std::size_t inject_capacity = 4096;    // 注入队列的容量
+    typedef ChaseLevDeque<TaskType *> WorkDeque;
+    struct WorkerInfo
+    {
+        WorkStealingPool *pool;
+        std::size_t index;
+    };
+
+    std::vector<std::unique_ptr<WorkDeque>> deques;     // 每个工作线程一个任务队列
+    MpmcQueue<TaskType *> injected;                     // 非工作线程提交的任务
+    std::vector<std::thread> workers;                   // 工作线程
+    std::atomic<std::size_t> pending;                   // 已经提交, 尚未取出的任务个数
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    bool stopping;
+
+    // current: 当前线程所属的线程池及其编号
+    static WorkerInfo& current()
+    {
+        static thread_local WorkerInfo info = {nullptr, 0};
+        return info;
+    }
+
+    // popTask: 取出一个任务, self为当前线程自己的队列编号(非工作线程为deques.size())
+    bool popTask(std::size_t self, TaskType *&task)
+    {
+        if (pending.load() == 0)
+            return false;
+        std::size_t n = deques.size();
+        // 自己的队列: 从底部取; 然后是注入队列
+        if ((self < n && deques[self]->pop(task)) || injected.try_pop(task)){
+            pending.fetch_sub(1);
+            return true;
+        }
+        // 窃取: 从其它队列的顶部取
+        std::size_t start = (self < n) ? self + 1 : 0;
+        for (std::size_t k = 0; k != n; ++k){
+            std::size_t victim = (start + k) % n;
+            if (victim != self && deques[victim]->steal(task)){
+                pending.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // workerLoop: 工作线程的主循环
+    void workerLoop(std::size_t index)
+    {
+        current().pool = this;
+        current().index = index;
+        while (true){
+            if (tryRunOne())
+                continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            if (stopping && pending.load() == 0)
+                return;
+            // 任务已经提交但还没有写入队列时pending不为0, 这时短暂等待以后重新扫描
+            sleep_cv.wait_for(lock, std::chrono::milliseconds(1),
+                              [this]{ return stopping || pending.load() != 0; });
+        }
+    }
+};
+// TaskGroup: 一组可以共同等待的任务(fork-join)
+/*
+ * run(f)提交一个任务, wait()等待所有已提交的任务结束.
+ * wait()中当前线程会不断地执行线程池中的任务, 因此可以在任务内部嵌套使用TaskGroup.
+ * 任务抛出的第一个异常会在wait()中重新抛出.
+ *
+ */
+class TaskGroup
+{
+public:
+    //****************************构造函数*******************************
+    explicit TaskGroup(WorkStealingPool &p): pool(p), state(std::make_shared<State>()) {  }
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup& operator= (const TaskGroup &) = delete;
+    ~TaskGroup()
+    {
+        // 保证任务不会在TaskGroup析构以后访问调用者的栈
+        waitNoThrow();
+    }
+    //****************************成员函数*******************************
+    template<typename Function>
+    void run(Function f)
+    {
+        std::shared_ptr<State> s = state;
+        s->count.fetch_add(1);
+        pool.submit([s, f]() mutable {
+            try{
+                f();
+            }catch (...){
+                std::lock_guard<std::mutex> lock(s->mutex);
+                if (!s->error)
+                    s->error = std::current_exception();
+            }
+            s->count.fetch_sub(1);
+        });
+    }
+
+    void wait()
+    {
+        waitNoThrow();
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            std::swap(error, state->error);
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+private:
+    struct State
+    {
+        State(): count(0) {  }
+        std::atomic<std::size_t> count;     // 尚未完成的任务个数
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+    WorkStealingPool &pool;
+    std::shared_ptr<State> state;
+
+    void waitNoThrow()
+    {
+        while (state->count.load() != 0){
+            if (!pool.tryRunOne())
+                std::this_thread::yield();
+        }
+    }
+};
+#endif
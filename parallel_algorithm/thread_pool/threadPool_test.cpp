@@ -0,0 +1,98 @@
+/*************************************************************************
+	> File Name: threadPool_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时03分18秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "threadPool.h"
+
+// 递归求斐波那契数, 每一层都fork出子任务
+long fib(WorkStealingPool &pool, int n)
+{
+    if (n < 2)
+        return n;
+    long left = 0;
+    TaskGroup group(pool);
+    group.run([&]{ left = fib(pool, n - 1); });
+    long right = fib(pool, n - 2);
+    group.wait();
+    return left + right;
+}
+
+void Test1()
+{
+    WorkStealingPool pool(4);
+    std::atomic<int> counter(0);
+    TaskGroup group(pool);
+    for (int i = 0; i != 1000; ++i)
+        group.run([&counter]{ counter.fetch_add(1); });
+    group.wait();
+    cout << "工作线程数: " << pool.size() << endl;
+    cout << "执行任务数(应为1000): " << counter.load() << endl;
+}
+
+void Test2()
+{
+    WorkStealingPool pool(4);
+    cout << "fib(20)(应为6765): " << fib(pool, 20) << endl;
+    WorkStealingPool empty_pool(0);
+    cout << "没有工作线程时 fib(15)(应为610): " << fib(empty_pool, 15) << endl;
+}
+
+void Test3()
+{
+    WorkStealingPool pool(2);
+    TaskGroup group(pool);
+    group.run([]{ throw std::runtime_error("任务中抛出的异常"); });
+    try{
+        group.wait();
+        cout << "没有捕获到异常(错误)" << endl;
+    }catch (const std::runtime_error &e){
+        cout << "wait()重新抛出: " << e.what() << endl;
+    }
+}
+
+// 多个非工作线程同时提交远多于注入队列容量的任务, 其中一些任务再提交子任务
+void Test4()
+{
+    WorkStealingPool pool(2);
+    std::atomic<int> counter(0);
+    {
+        TaskGroup group(pool);
+        std::vector<std::thread> submitters;
+        for (int t = 0; t != 3; ++t)
+            submitters.emplace_back([&]{
+                for (int i = 0; i != 10000; ++i)
+                    group.run([&, i]{
+                        counter.fetch_add(1);
+                        if (i % 100 == 0)
+                            group.run([&counter]{ counter.fetch_add(1); });
+                    });
+            });
+        for (auto &submitter : submitters)
+            submitter.join();
+        group.wait();
+    }
+    cout << "执行任务数(应为30300): " << counter.load() << endl;
+}
+
+int main()
+{
+    cout << "****************大量独立任务测试***********************\n";
+    Test1();
+    cout << "****************嵌套fork-join测试**********************\n";
+    Test2();
+    cout << "****************异常传递测试***************************\n";
+    Test3();
+    cout << "****************外部线程大量提交测试*******************\n";
+    Test4();
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*************************************************************************
+	> File Name: chaseLevDeque.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时04分17秒
+ ************************************************************************/
+
+#ifndef _CHASELEVDEQUE_H
+#define _CHASELEVDEQUE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+// ChaseLevDeque: 工作窃取双端队列(Chase & Lev 2005, 内存次序按Lê, Pop, Cohen & Zappa Nardelli 2013)
+/*
+ * 一个拥有者线程在底部(bottom)push与pop, 后进先出; 任意多个窃取者线程在顶部(top)steal, 先进先出.
+ *      --push: 只由拥有者调用, 写入a[bottom]并增加bottom, 不需要CAS. 数组满时复制到两倍大的新数组;
+ *      --pop: 只由拥有者调用, 先减小bottom, 再读top. 只剩一个元素时与窃取者用CAS竞争top;
+ *      --steal: 读top与bottom, 非空时读出a[top]并用CAS把top加1, CAS失败说明另一个窃取者或拥有者取走了它.
+ * top与bottom是一直增加的有符号计数, 下标为i & (size - 1). 扩容以后旧数组可能还在被窃取者读取,
+ * 所以旧数组保留到析构时才释放(总大小不超过当前数组的大小).
+ *
+ * T必须是可平凡复制的类型(通常是指向任务的指针): 数组的元素是std::atomic<T>, 窃取者可能读到一个随后被
+ * 拥有者覆盖的元素, 那时它的CAS一定失败, 读到的值被丢弃.
+ * 拥有者与窃取者之间不加锁, 拥有者的操作没有竞争时不做CAS, 窃取者之间是lock-free的.
+ *
+ */
+template<typename T>
+class ChaseLevDeque
+{
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque requires a trivially copyable element type");
+public:
+    //****************************构造函数*******************************
+    // capacity: 初始容量, 向上取为2的幂
+    explicit ChaseLevDeque(std::size_t capacity = 64) : top(0), bottom(0)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        arrays.emplace_back(new Array(size));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+    ChaseLevDeque(const ChaseLevDeque &) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque &) = delete;
+    //****************************成员函数*******************************
+    // size: 元素个数的近似值
+    std::size_t size() const
+    {
+        std::int64_t b = bottom.load(std::memory_order_relaxed), t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // push: 把element放在底部(只由拥有者调用)
+    void push(T element)
+    {
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        Array *a = array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(a->mask))
+            a = grow(a, t, b);
+        a->put(b, element);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    // pop: 从底部取出一个元素(只由拥有者调用), 空时返回false
+    bool pop(T &element)
+    {
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array *a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b){
+            // 空
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        element = a->get(b);
+        if (t == b){
+            // 最后一个元素: 与窃取者竞争
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    // steal: 从顶部取出一个元素(任意线程调用), 空或与其它线程竞争失败时返回false
+    bool steal(T &element)
+    {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return false;
+        Array *a = array.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+        element = value;
+        return true;
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(std::size_t size) : mask(size - 1), items(new std::atomic<T>[size]) {  }
+        T get(std::int64_t i) const { return items[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T value) { items[i & mask].store(value, std::memory_order_relaxed); }
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+    // grow: 把[t, b)复制到两倍大的新数组(只由拥有者调用)
+    Array* grow(Array *old, std::int64_t t, std::int64_t b)
+    {
+        arrays.emplace_back(new Array(2 * (old->mask + 1)));
+        Array *a = arrays.back().get();
+        for (std::int64_t i = t; i != b; ++i)
+            a->put(i, old->get(i));
+        array.store(a, std::memory_order_release);
+        return a;
+    }
+
+    //****************************数据结构*******************************
+    std::atomic<std::int64_t> top;          // 窃取者之间竞争
+    char padding[64];                       // top与拥有者频繁写的bottom放在不同的缓存行
+    std::atomic<std::int64_t> bottom;       // 只由拥有者写
+    std::atomic<Array *> array;             // 当前的数组
+    std::vector<std::unique_ptr<Array>> arrays;     // 当前与以前的数组(只由拥有者修改)
+};
+#endif
@@ -0,0 +1,86 @@
+/*************************************************************************
+	> File Name: chaseLevDeque_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时09分43秒
+ ************************************************************************/
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "chaseLevDeque.h"
+using std::cout;
+using std::endl;
+
+// ownerTest: 只有拥有者时后进先出, 扩容以后元素不变
+void ownerTest()
+{
+    bool correct = true;
+    ChaseLevDeque<int> deque(4);
+    int value = 0;
+    correct = correct && deque.empty() && !deque.pop(value) && !deque.steal(value);
+    for (int i = 0; i != 1000; ++i)
+        deque.push(i);
+    correct = correct && deque.size() == 1000 && deque.steal(value) && value == 0;
+    for (int i = 999; i != 0; --i)
+        correct = correct && deque.pop(value) && value == i;
+    correct = correct && !deque.pop(value) && deque.empty();
+    // 交替push与pop, 计数增加到超过初始容量很多倍
+    for (int round = 0; round != 100; ++round){
+        deque.push(round);
+        deque.push(round + 1000);
+        correct = correct && deque.steal(value) && value == round && deque.pop(value) && value == round + 1000;
+    }
+    cout << "拥有者的push与pop, 扩容: " << (correct ? "正确" : "错误") << endl;
+}
+
+// stealTest: 拥有者不断push与pop, 3个窃取者同时steal, 每个元素恰好被取出一次
+void stealTest()
+{
+    const int items = 300000, thieves = 3;
+    ChaseLevDeque<int> deque(16);
+    std::vector<std::atomic<int>> seen(items);
+    for (auto &s : seen)
+        s.store(0);
+    std::atomic<int> taken(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t != thieves; ++t)
+        threads.emplace_back([&]{
+            int value;
+            while (taken.load() != items){
+                if (deque.steal(value)){
+                    ++seen[value];
+                    ++taken;
+                }else
+                    std::this_thread::yield();
+            }
+        });
+    int value;
+    for (int i = 0; i != items; ++i){
+        deque.push(i);
+        // 每压入3个元素自己取出1个
+        if (i % 3 == 2 && deque.pop(value)){
+            ++seen[value];
+            ++taken;
+        }
+    }
+    while (taken.load() != items)
+        if (deque.pop(value)){
+            ++seen[value];
+            ++taken;
+        }
+    for (auto &thread : threads)
+        thread.join();
+    bool correct = deque.empty();
+    for (auto &s : seen)
+        correct = correct && s.load() == 1;
+    cout << "拥有者与窃取者同时取出: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************ChaseLevDeque的测试********************\n";
+    ownerTest();
+    stealTest();
+    return 0;
+}
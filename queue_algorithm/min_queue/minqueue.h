@@ -8,9 +8,11 @@
 #ifndef _MINQUEUE_H
 #define _MINQUEUE_H
 
+#include <cstddef>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <iterator>
 #include <utility>
 #include <stdexcept>
 //MinQueue: 最小优先队列  算法导论6.5
@@ -27,10 +29,12 @@
  *        关键字.
  *
  */
-template<typename T, typename TkeyType>
+template<typename T, typename TkeyType, typename Alloc = std::allocator<T>>
 class MinQueue
 {
 public:
+    // 存放元素指针的数组的分配器, Alloc可以是ResourceAllocator<T>(tree_algorithm/NodeArena/MemoryResource.h)
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::shared_ptr<T>> AllocatorType;
     // 一个可调用对象类型,该类型的对象可以用于比较两个std::shared_ptr<T>的小于比较
     typedef std::function<bool (std::shared_ptr<T>, std::shared_ptr<T>)> CompareType;
     // 一个可调用对象,该类型的对象可用于获取std::shared_ptr<T>的关键字,并修改关键字(返回的是关键字的引用)
@@ -42,7 +46,8 @@ public:
      * 可以获取T的key,也可以修改T的key.
      *
      */
-    MinQueue(CompareType compare, GetKeyType getKey): size(0), compare(compare), getKey(getKey) {}
+    MinQueue(CompareType compare, GetKeyType getKey, const Alloc &alloc = Alloc())
+        : data(AllocatorType(alloc)), size(0), compare(compare), getKey(getKey) {}
     // 显式构造函数
     /*
      * \parameter reverse_size: 指定队列的初始容量;
@@ -51,7 +56,8 @@ public:
      * 可以获取T的key,也可以修改T的key.
      *
      */
-    MinQueue(std::size_t reverse_size, CompareType compare, GetKeyType getKey): size(0), compare(compare), getKey(getKey)
+    MinQueue(std::size_t reverse_size, CompareType compare, GetKeyType getKey, const Alloc &alloc = Alloc())
+        : data(AllocatorType(alloc)), size(0), compare(compare), getKey(getKey)
     {
         data.resize(reverse_size);
     }
@@ -62,6 +68,7 @@ public:
      *  --时间复杂度 O(1).
      *  --但是生成最小堆需要O(NlonN),从而算法复杂度为O(NlogN).
      */
+    AllocatorType get_allocator() const { return data.get_allocator(); }
     std::shared_ptr<T> min()
     {
         if (!size)
@@ -167,7 +174,7 @@ public:
     
 private:
     // 数据结构
-    std::vector<std::shared_ptr<T>> data;   // 最小优先级队列数据
+    std::vector<std::shared_ptr<T>, AllocatorType> data;   // 最小优先级队列数据
     std::size_t size;   // 堆大小
     CompareType compare;    // 一个可调用对象,可用于两个std::shared_ptr<T>对象的小于比较
     GetKeyType getKey;      // 一个可调用对象,可用于获取std::shared_ptr<T>的关键字,并修改关键字(返回的是关键字的引用)
@@ -302,4 +309,205 @@ private:
         }
     }
 };
+// MinQueueIdentity: 元素本身就是关键字
+template<typename T>
+struct MinQueueIdentity
+{
+    T& operator()(T &element) const { return element; }
+    const T& operator()(const T &element) const { return element; }
+};
+// IndexedMinQueue: 按值存放元素, 用句柄支持decrease_key与erase的最小优先队列
+/*
+ * MinQueue存放std::shared_ptr<T>, 比较与取关键字都通过std::function, 每一步都用data.at()检查下标;
+ * decreate_key需要元素当前在数组中的下标, 而下标在每次交换时都会改变, 调用者没有办法知道.
+ *
+ * IndexedMinQueue:
+ *      --比较函数Compare与取关键字的KeyOf是模板参数(可以被内联), KeyOf(T&)返回关键字的引用(TkeyType&);
+ *      --元素按堆的次序连续地存放在std::vector<T>中, 不为每个元素单独分配内存;
+ *      --push返回一个句柄(Handle), 在元素出队以前一直有效: 两个辅助数组heapHandle[i](堆中第i个元素的句柄)与
+ *        position[h](句柄h的元素在堆中的下标)在每次移动元素时一起更新, 所以decrease_key(h, key)与erase(h)是O(logn);
+ *        出队的句柄以后会被新的元素重新使用(contains(h)先返回false, 重新使用以后又返回true);
+ *      --sift用"空穴"的方式移动: 先取出要移动的元素, 其它元素只移动一次, 最后放入空穴, 而不是逐层交换;
+ *      --由区间构造时用Floyd的方法建堆, O(n), 第i个元素的句柄为i;
+ *      --元素与三个辅助数组都从Alloc分配(例如ResourceAllocator<T>, 见tree_algorithm/NodeArena/MemoryResource.h).
+ *
+ * 算法性能: push, pop, decrease_key, erase为O(logn), top为O(1), 建堆为O(n).
+ *
+ */
+template<typename T, typename TkeyType = T, typename KeyOf = MinQueueIdentity<T>, typename Compare = std::less<TkeyType>,
+         typename Alloc = std::allocator<T>>
+class IndexedMinQueue
+{
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> ElementAlloc;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::size_t> IndexAlloc;
+public:
+    typedef std::size_t Handle;     // 元素的句柄
+    static const Handle npos = static_cast<Handle>(-1);
+    //****************************构造函数*******************************
+    explicit IndexedMinQueue(KeyOf k = KeyOf(), Compare c = Compare(), const Alloc &alloc = Alloc())
+        : data(ElementAlloc(alloc)), heapHandle(IndexAlloc(alloc)), position(IndexAlloc(alloc)),
+          freeHandles(IndexAlloc(alloc)), keyOf(k), compare(c) {  }
+    // 由[first, last)建堆, 第i个元素的句柄为i
+    template<typename Iterator>
+    IndexedMinQueue(Iterator first, Iterator last, KeyOf k = KeyOf(), Compare c = Compare(), const Alloc &alloc = Alloc())
+        : data(first, last, ElementAlloc(alloc)), heapHandle(IndexAlloc(alloc)), position(IndexAlloc(alloc)),
+          freeHandles(IndexAlloc(alloc)), keyOf(k), compare(c)
+    {
+        heapHandle.resize(data.size());
+        position.resize(data.size());
+        for (std::size_t i = 0; i != data.size(); ++i)
+            heapHandle[i] = position[i] = i;
+        for (std::size_t i = data.size() / 2; i-- != 0;)
+            siftDown(i);
+    }
+    //****************************成员函数*******************************
+    std::size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    // get_allocator: 元素与辅助数组共用的分配器
+    Alloc get_allocator() const { return Alloc(data.get_allocator()); }
+    void reserve(std::size_t n)
+    {
+        data.reserve(n);
+        heapHandle.reserve(n);
+        position.reserve(n);
+    }
+    void clear()
+    {
+        data.clear();
+        heapHandle.clear();
+        position.clear();
+        freeHandles.clear();
+    }
+    // top, top_handle: 最小的元素与它的句柄, 调用者保证非空
+    const T& top() const { return data[0]; }
+    Handle top_handle() const { return heapHandle[0]; }
+    // contains: 句柄是否指向队列中的元素; get: 句柄对应的元素
+    bool contains(Handle h) const { return h < position.size() && position[h] != npos; }
+    const T& get(Handle h) const { return data[checked(h)]; }
+
+    // push: 加入一个元素, 返回它的句柄
+    Handle push(const T &element) { return pushImpl(T(element)); }
+    Handle push(T &&element) { return pushImpl(std::move(element)); }
+    // pop: 删除最小的元素, 调用者保证非空
+    void pop() { removeAt(0); }
+    // extract_min: 删除并返回最小的元素, 调用者保证非空
+    T extract_min()
+    {
+        T result = std::move(data[0]);
+        removeAt(0);
+        return result;
+    }
+    // decrease_key: 把句柄h的元素的关键字减小为key; key大于原来的关键字或h无效时抛出std::invalid_argument
+    void decrease_key(Handle h, const TkeyType &key)
+    {
+        std::size_t i = checked(h);
+        if (compare(keyOf(data[i]), key))
+            throw std::invalid_argument("decrease_key error: new key is greater than the current key!");
+        keyOf(data[i]) = key;
+        siftUp(i);
+    }
+    // update: 把句柄h的元素的关键字改为key(可以增大), 向上或向下调整
+    void update(Handle h, const TkeyType &key)
+    {
+        std::size_t i = checked(h);
+        bool smaller = compare(key, keyOf(data[i]));
+        keyOf(data[i]) = key;
+        if (smaller)
+            siftUp(i);
+        else
+            siftDown(i);
+    }
+    // erase: 删除句柄h的元素; h无效时抛出std::invalid_argument
+    void erase(Handle h) { removeAt(checked(h)); }
+
+private:
+    std::vector<T, ElementAlloc> data;              // 按堆的次序存放的元素
+    std::vector<Handle, IndexAlloc> heapHandle;     // heapHandle[i]: data[i]的句柄
+    std::vector<std::size_t, IndexAlloc> position;  // position[h]: 句柄h的元素在data中的下标, 不在队列中时为npos
+    std::vector<Handle, IndexAlloc> freeHandles;    // 可以重新使用的句柄
+    KeyOf keyOf;
+    Compare compare;
+
+    std::size_t checked(Handle h) const
+    {
+        if (!contains(h))
+            throw std::invalid_argument("IndexedMinQueue error: the handle is not in the queue!");
+        return position[h];
+    }
+    bool less(T &a, T &b) { return compare(keyOf(a), keyOf(b)); }
+    Handle pushImpl(T &&element)
+    {
+        Handle h;
+        if (!freeHandles.empty()){
+            h = freeHandles.back();
+            freeHandles.pop_back();
+        }else{
+            h = position.size();
+            position.push_back(npos);
+        }
+        data.push_back(std::move(element));
+        heapHandle.push_back(h);
+        position[h] = data.size() - 1;
+        siftUp(data.size() - 1);
+        return h;
+    }
+    // removeAt: 删除堆中下标为i的元素, 用最后一个元素填补并调整
+    void removeAt(std::size_t i)
+    {
+        Handle h = heapHandle[i];
+        position[h] = npos;
+        freeHandles.push_back(h);
+        std::size_t last = data.size() - 1;
+        if (i != last){
+            data[i] = std::move(data[last]);
+            heapHandle[i] = heapHandle[last];
+            position[heapHandle[i]] = i;
+        }
+        data.pop_back();
+        heapHandle.pop_back();
+        if (i != last){
+            if (i != 0 && less(data[i], data[(i - 1) / 2]))
+                siftUp(i);
+            else
+                siftDown(i);
+        }
+    }
+    // place: 把element放到下标i, 同时更新句柄的位置
+    void place(std::size_t i, T &&element, Handle h)
+    {
+        data[i] = std::move(element);
+        heapHandle[i] = h;
+        position[h] = i;
+    }
+    void siftUp(std::size_t i)
+    {
+        T element = std::move(data[i]);
+        Handle h = heapHandle[i];
+        while (i != 0){
+            std::size_t parent = (i - 1) / 2;
+            if (!less(element, data[parent]))
+                break;
+            place(i, std::move(data[parent]), heapHandle[parent]);
+            i = parent;
+        }
+        place(i, std::move(element), h);
+    }
+    void siftDown(std::size_t i)
+    {
+        std::size_t n = data.size();
+        T element = std::move(data[i]);
+        Handle h = heapHandle[i];
+        for (std::size_t child = 2 * i + 1; child < n; child = 2 * i + 1){
+            if (child + 1 < n && less(data[child + 1], data[child]))
+                ++child;
+            if (!less(data[child], element))
+                break;
+            place(i, std::move(data[child]), heapHandle[child]);
+            i = child;
+        }
+        place(i, std::move(element), h);
+    }
+};
+template<typename T, typename TkeyType, typename KeyOf, typename Compare, typename Alloc>
+const typename IndexedMinQueue<T, TkeyType, KeyOf, Compare, Alloc>::Handle IndexedMinQueue<T, TkeyType, KeyOf, Compare, Alloc>::npos;
 #endif
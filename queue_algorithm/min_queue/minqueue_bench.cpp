@@ -0,0 +1,86 @@
+/*************************************************************************
+	> File Name: minqueue_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时05分41秒
+ ************************************************************************/
+// MinQueue(shared_ptr与std::function)与IndexedMinQueue(按值存放, 模板参数)的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [元素个数(默认1000000)]
+ *      依次插入n个随机的关键字, 再全部取出; IndexedMinQueue预先reserve(n), 还测量由区间建堆与n次随机的decrease_key.
+ *
+ * 输出的每一行: queue,n,operation,ns_per_op
+ *      --operation为push, pop, heapify或decrease_key.
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "minqueue.h"
+
+typedef std::chrono::steady_clock Clock;
+std::int64_t bench_sink = 0;    // 取出的关键字之和, 使编译器不能省略
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+void report(const char *queue, std::size_t n, const char *operation, double ns)
+{
+    std::cout << queue << ',' << n << ',' << operation << ',' << ns << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<int> keys(n);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (auto &key : keys){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<int>(state >> 34);
+    }
+    std::cout << "queue,n,operation,ns_per_op\n";
+    {
+        MinQueue<int, int> queue([](std::shared_ptr<int> a, std::shared_ptr<int> b){ return *a < *b; },
+                                 [](std::shared_ptr<int> p) -> int& { return *p; });
+        auto begin = Clock::now();
+        for (int key : keys)
+            queue.insert(std::make_shared<int>(key));
+        report("MinQueue", n, "push", nanosecondsSince(begin, n));
+        begin = Clock::now();
+        for (std::size_t i = 0; i != n; ++i)
+            bench_sink += *queue.extract_min();
+        report("MinQueue", n, "pop", nanosecondsSince(begin, n));
+    }
+    {
+        IndexedMinQueue<int> queue;
+        queue.reserve(n);
+        auto begin = Clock::now();
+        for (int key : keys)
+            queue.push(key);
+        report("IndexedMinQueue", n, "push", nanosecondsSince(begin, n));
+        begin = Clock::now();
+        for (std::size_t i = 0; i != n; ++i){
+            // 关键字减小到原来的一半: 元素向上移动, 句柄不变
+            std::size_t h = static_cast<std::size_t>(keys[i]) % n;
+            queue.decrease_key(h, queue.get(h) / 2);
+        }
+        report("IndexedMinQueue", n, "decrease_key", nanosecondsSince(begin, n));
+        begin = Clock::now();
+        for (std::size_t i = 0; i != n; ++i)
+            bench_sink += queue.extract_min();
+        report("IndexedMinQueue", n, "pop", nanosecondsSince(begin, n));
+    }
+    {
+        auto begin = Clock::now();
+        IndexedMinQueue<int> queue(keys.begin(), keys.end());
+        report("IndexedMinQueue", n, "heapify", nanosecondsSince(begin, n));
+        bench_sink += queue.top();
+    }
+    return bench_sink == 42 ? 1 : 0;
+}
@@ -7,7 +7,13 @@
 
 #include <iostream>
 using std::cout;    using std::endl;
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
 #include "minqueue.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 // 当最小优先队列存放的是int*数据时,相应的比较函数对象
 typedef std::function<bool (std::shared_ptr<int>, std::shared_ptr<int>)> IntCompareType;
 // 当最小优先级队列存放的是int*数据时,获取key的函数对象
@@ -160,12 +166,125 @@ void extract_minTest()
     }   
 }
 
+// Task: 调度器中的任务, 按deadline排序
+struct Task
+{
+    int deadline;
+    std::string name;
+};
+struct TaskDeadline
+{
+    int& operator()(Task &task) const { return task.deadline; }
+};
+typedef IndexedMinQueue<Task, int, TaskDeadline> TaskQueue;
+
+// indexedTest: 随机的push, pop, decrease_key, update与erase, 与std::multimap的结果相同; 句柄在交换以后仍然有效
+void indexedTest()
+{
+    cout << "*************IndexedMinQueue的测试********************\n";
+    TaskQueue queue;
+    std::multimap<int, TaskQueue::Handle> reference;
+    std::map<TaskQueue::Handle, int> live;     // 句柄 -> 当前的deadline
+    bool correct = true;
+    std::srand(29);
+    for (int i = 0; i != 20000; ++i){
+        int op = std::rand() % 6;
+        if (live.empty() || op < 2){
+            int deadline = std::rand() % 100000;
+            auto h = queue.push(Task{deadline, "task" + std::to_string(i)});
+            correct = correct && !live.count(h);
+            live[h] = deadline;
+            reference.insert(std::make_pair(deadline, h));
+            continue;
+        }
+        auto it = live.begin();
+        std::advance(it, std::rand() % live.size());
+        TaskQueue::Handle h = it->first;
+        auto ref = reference.equal_range(it->second);
+        while (ref.first->second != h)
+            ++ref.first;
+        if (op == 2 || op == 3){
+            int key = it->second - std::rand() % 1000;
+            if (op == 2)
+                queue.decrease_key(h, key);
+            else
+                queue.update(h, key = it->second + std::rand() % 1000 - 500);
+            reference.erase(ref.first);
+            reference.insert(std::make_pair(key, h));
+            it->second = key;
+            correct = correct && queue.get(h).deadline == key;
+        }else if (op == 4){
+            queue.erase(h);
+            reference.erase(ref.first);
+            live.erase(it);
+            correct = correct && !queue.contains(h);
+        }else{
+            correct = correct && queue.top().deadline == reference.begin()->first;
+            TaskQueue::Handle top = queue.top_handle();
+            correct = correct && live[top] == queue.top().deadline;
+            Task task = queue.extract_min();
+            auto first = reference.equal_range(task.deadline).first;
+            while (first->second != top)
+                ++first;
+            reference.erase(first);
+            live.erase(top);
+        }
+        correct = correct && queue.size() == reference.size();
+    }
+    while (!queue.empty()){
+        correct = correct && queue.top().deadline == reference.begin()->first;
+        queue.pop();
+        reference.erase(reference.begin());
+    }
+    // 由区间建堆, 第i个元素的句柄为i
+    std::vector<int> values;
+    for (int i = 0; i != 1000; ++i)
+        values.push_back(std::rand() % 500);
+    IndexedMinQueue<int> heap(values.begin(), values.end());
+    correct = correct && heap.get(17) == values[17];
+    heap.decrease_key(17, -1);
+    correct = correct && heap.top() == -1 && heap.top_handle() == 17;
+    try{
+        heap.decrease_key(3, 1000);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    std::vector<int> sorted(values);
+    sorted[17] = -1;
+    std::sort(sorted.begin(), sorted.end());
+    for (int value : sorted)
+        correct = correct && heap.extract_min() == value;
+    cout << "句柄, decrease_key, erase与建堆: " << (correct ? "正确" : "错误") << endl;
+}
+
+// resourceTest: MinQueue与IndexedMinQueue的数组都从MonotonicBufferResource分配
+void resourceTest()
+{
+    cout << "*************MemoryResource的测试********************\n";
+    MonotonicBufferResource arena;
+    MinQueue<int, int, ResourceAllocator<int>> minQueue(10, intCompare, intGetType, &arena);
+    for (int i = 10; i >= 1; --i)
+        minQueue.insert(std::allocate_shared<int>(minQueue.get_allocator(), i));
+    bool correct = minQueue.get_allocator().resource() == &arena;
+    for (int i = 1; i <= 10; ++i)
+        correct = *minQueue.extract_min() == i && correct;
+    std::size_t used = arena.bytesAllocated();
+    IndexedMinQueue<int, int, MinQueueIdentity<int>, std::less<int>, ResourceAllocator<int>>
+        heap(MinQueueIdentity<int>(), std::less<int>(), &arena);
+    for (int i = 0; i != 1000; ++i)
+        heap.push(999 - i);
+    heap.decrease_key(0, -1);
+    correct = correct && heap.extract_min() == -1 && heap.extract_min() == 0 && heap.get_allocator().resource() == &arena;
+    cout << "从MemoryResource分配: " << (correct && arena.bytesAllocated() > used + 1000 * sizeof(int) ? "正确" : "错误") << endl;
+}
+
 int main()
 { 
     cout << "*******************************int型整数的测试***********************************" << endl;
     insertTest();
     minTest();
     extract_minTest();
+    indexedTest();
+    resourceTest();
 
     return 0;
 }
@@ -0,0 +1,141 @@
+/*************************************************************************
+	> File Name: mpmcQueue.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时07分00秒
+ ************************************************************************/
+
+#ifndef _MPMCQUEUE_H
+#define _MPMCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+const std::size_t mpmc_cache_line = 64;    // 缓存行的字节数
+// MpmcQueue: 多生产者多消费者的有界无锁队列(Dmitry Vyukov的有界MPMC队列)
+/*
+ * 容量向上取为2的幂(至少为2), 每个槽除了元素以外还有一个序号sequence, 初始时第i个槽的序号为i.
+ * enqueuePos与dequeuePos是一直增加的计数:
+ *      --入队: 读出pos = enqueuePos, 槽为slots[pos & mask]. 若槽的序号等于pos, 说明槽是空的并且轮到这一圈,
+ *        用CAS把enqueuePos加1占住这个槽, 构造元素以后把序号写为pos + 1(release), 交给消费者;
+ *        序号小于pos说明槽中还有上一圈的元素没有取走, 队列是满的; 序号大于pos说明pos已经被其它生产者占用, 重新读取;
+ *      --出队: 读出pos = dequeuePos, 若槽的序号等于pos + 1, 说明元素已经写好, 用CAS把dequeuePos加1占住这个槽,
+ *        移出并析构元素以后把序号写为pos + capacity, 留给下一圈的生产者; 序号小于pos + 1说明队列是空的.
+ * 生产者之间(消费者之间)只在同一个计数上CAS, 生产者与消费者之间只通过每个槽的序号同步, 不共享计数.
+ * 两个计数分别放在不同的缓存行, 与槽数组也分开.
+ *
+ * 满或空时try_push/try_pop返回false, 由调用者决定等待, 重试还是丢弃. 一个线程在占住槽以后, 发布以前被挂起时,
+ * 其它线程在这个槽上会看到满或空(不会阻塞, 但这一圈后面的槽暂时不能使用), 所以它严格来说不是lock-free的.
+ *
+ * 算法性能: 每个操作一次CAS(没有竞争时), 不分配内存.
+ *
+ */
+template<typename T>
+class MpmcQueue
+{
+public:
+    //****************************构造函数*******************************
+    // capacity向上取为2的幂; capacity为0或过大时抛出std::invalid_argument
+    explicit MpmcQueue(std::size_t capacity) : mask(roundUp(capacity) - 1), slots(new Slot[mask + 1])
+    {
+        for (std::size_t i = 0; i <= mask; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue& operator=(const MpmcQueue &) = delete;
+    ~MpmcQueue()
+    {
+        std::size_t e = enqueuePos.load(std::memory_order_relaxed);
+        for (std::size_t pos = dequeuePos.load(std::memory_order_relaxed); pos != e; ++pos)
+            reinterpret_cast<T *>(&slots[pos & mask].storage)->~T();
+        delete[] slots;
+    }
+    //****************************成员函数*******************************
+    std::size_t capacity() const { return mask + 1; }
+    // size: 元素个数的近似值(包括正在写入与正在取出的元素)
+    std::size_t size() const
+    {
+        std::size_t d = dequeuePos.load(std::memory_order_relaxed);
+        std::size_t e = enqueuePos.load(std::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // try_push, try_emplace: 入队一个元素, 队列满时返回false
+    bool try_push(const T &element) { return try_emplace(element); }
+    bool try_push(T &&element) { return try_emplace(std::move(element)); }
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;){
+            slot = &slots[pos & mask];
+            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0){
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }else if (diff < 0)
+                return false;
+            else
+                pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+        ::new (static_cast<void *>(&slot->storage)) T(std::forward<Args>(args)...);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    // try_pop: 出队一个元素并移动到element, 队列空时返回false
+    bool try_pop(T &element)
+    {
+        std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;){
+            slot = &slots[pos & mask];
+            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0){
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }else if (diff < 0)
+                return false;
+            else
+                pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+        T *p = reinterpret_cast<T *>(&slot->storage);
+        element = std::move(*p);
+        p->~T();
+        slot->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        if (capacity == 0 || capacity > (std::size_t(-1) >> 2) / sizeof(Slot))
+            throw std::invalid_argument("MpmcQueue error: invalid capacity!");
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        return size;
+    }
+
+    //****************************数据结构*******************************
+    const std::size_t mask;
+    Slot *const slots;
+    char padding0[mpmc_cache_line];
+    std::atomic<std::size_t> enqueuePos;   // 下一个入队的位置, 生产者之间竞争
+    char padding1[mpmc_cache_line];
+    std::atomic<std::size_t> dequeuePos;   // 下一个出队的位置, 消费者之间竞争
+    char padding2[mpmc_cache_line];
+};
+#endif
@@ -0,0 +1,114 @@
+/*************************************************************************
+	> File Name: mpmcQueue_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时13分26秒
+ ************************************************************************/
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mpmcQueue.h"
+using std::cout;
+using std::endl;
+
+std::atomic<int> alive(0);
+// Tracked: 记录存活的对象个数, 检查槽中的元素既没有泄漏也没有重复析构
+struct Tracked
+{
+    Tracked(int v = 0) : value(v), name(std::to_string(v)) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value), name(other.name) { ++alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; name = other.name; return *this; }
+    ~Tracked() { --alive; }
+    int value;
+    std::string name;
+};
+
+// singleThreadTest: 先进先出, 满与空, 多圈环绕
+void singleThreadTest()
+{
+    bool correct = true;
+    {
+        MpmcQueue<Tracked> queue(3);
+        correct = correct && queue.capacity() == 4 && queue.empty();
+        int next = 0, pushed = 0;
+        for (int round = 0; round != 50; ++round){
+            while (queue.try_push(Tracked(pushed)))
+                ++pushed;
+            correct = correct && queue.size() == 4;
+            Tracked t;
+            for (int i = 0; i != 3; ++i){
+                correct = correct && queue.try_pop(t) && t.value == next && t.name == std::to_string(next);
+                ++next;
+            }
+        }
+        Tracked t;
+        while (queue.try_pop(t))
+            correct = correct && t.value == next++;
+        correct = correct && next == pushed && !queue.try_pop(t);
+        // 析构时还在队列中的元素
+        queue.try_emplace(7);
+        queue.try_emplace(8);
+    }
+    try{
+        MpmcQueue<int> bad(0);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    cout << "先进先出, 满与空: " << (correct && alive == 0 ? "正确" : "错误") << endl;
+}
+
+// concurrentTest: 4个生产者与4个消费者, 每个元素恰好被取出一次, 同一个生产者的元素按入队的次序取出
+void concurrentTest()
+{
+    const int producers = 4, consumers = 4, per_producer = 200000;
+    MpmcQueue<std::uint64_t> queue(256);
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    for (auto &s : seen)
+        s.store(0);
+    std::atomic<int> taken(0);
+    std::atomic<bool> ordered(true);
+    std::vector<std::thread> threads;
+    for (int p = 0; p != producers; ++p)
+        threads.emplace_back([&, p]{
+            for (int i = 0; i != per_producer; ){
+                if (queue.try_push(static_cast<std::uint64_t>(p) << 32 | i))
+                    ++i;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    for (int c = 0; c != consumers; ++c)
+        threads.emplace_back([&]{
+            std::vector<int> last(producers, -1);
+            std::uint64_t value;
+            while (taken.load() != producers * per_producer){
+                if (!queue.try_pop(value)){
+                    std::this_thread::yield();
+                    continue;
+                }
+                int p = static_cast<int>(value >> 32), i = static_cast<int>(value & 0xffffffff);
+                if (i <= last[p])
+                    ordered = false;
+                last[p] = i;
+                ++seen[p * per_producer + i];
+                ++taken;
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+    bool correct = ordered && queue.empty();
+    for (auto &s : seen)
+        correct = correct && s.load() == 1;
+    cout << "多个生产者与多个消费者: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************MpmcQueue的测试********************\n";
+    singleThreadTest();
+    concurrentTest();
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*************************************************************************
+	> File Name: multiQueue.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时10分05秒
+ ************************************************************************/
+
+#ifndef _MULTIQUEUE_H
+#define _MULTIQUEUE_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "../min_queue/minqueue.h"
+// MultiQueue: 松弛的并发优先队列(Rihani, Sanders & Dementiev 2015)
+/*
+ * 一个互斥锁保护的优先队列, 所有线程都在同一把锁上排队, 线程数增加时吞吐量不再增加.
+ * MultiQueue把元素分散在c * p个IndexedMinQueue(p为线程数)中, 每个堆有自己的自旋锁, 只用try-lock获取:
+ *      --push: 随机选一个堆, 获取锁失败就换一个, 成功以后把元素加入这个堆;
+ *      --try_pop: 随机选两个堆, 在两个都拿到锁时取出堆顶较小的那个(只拿到一个锁时取这一个), 拿不到锁就重新选.
+ *        连续多次选到空的堆时逐个检查所有的堆, 都为空才返回false.
+ * 线程几乎不会在同一个堆上等待, 也没有全局的计数或锁; 每个堆与它的锁在单独的缓存行中.
+ *
+ * 松弛: try_pop取出的不一定是全局最小的元素. 取出的元素的秩误差(队列中比它小的元素个数)的期望是O(c * p),
+ * 与元素个数无关; 以很高的概率不超过O(c * p * log(c * p))(Alistarh等2017对"两个中选一个"的过程的证明,
+ * 假设选择是均匀随机的, 并发时的实验结果相同). 只有一个堆时(c * p = 1)就是精确的优先队列.
+ * 适合允许优先级近似的调度: 并行的最佳优先搜索, 并行的Dijkstra(Δ-stepping式的重复松弛), 任务调度.
+ * 相等或更小的元素可能晚于较大的元素出队; 不提供decrease_key, 需要更新时加入新的元素并忽略过时的元素.
+ *
+ * 所有成员函数都可以由任意多个线程同时调用(构造与析构除外).
+ *
+ */
+template<typename T, typename TkeyType = T, typename KeyOf = MinQueueIdentity<T>, typename Compare = std::less<TkeyType>>
+class MultiQueue
+{
+public:
+    typedef IndexedMinQueue<T, TkeyType, KeyOf, Compare> Heap;
+    //****************************构造函数*******************************
+    // threads: 预计同时使用的线程数p, factor: 每个线程的堆数c; 一共max(1, c * p)个堆
+    explicit MultiQueue(std::size_t threads = defaultThreads(), std::size_t factor = 2,
+                        KeyOf k = KeyOf(), Compare c = Compare())
+        : count(std::max<std::size_t>(1, threads * factor)), shards(new Shard[count]), compare(c), keyOf(k)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            shards[i].heap = Heap(k, c);
+    }
+    MultiQueue(const MultiQueue &) = delete;
+    MultiQueue& operator=(const MultiQueue &) = delete;
+    //****************************成员函数*******************************
+    static std::size_t defaultThreads()
+    {
+        std::size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+    // heaps: 内部的堆的个数
+    std::size_t heaps() const { return count; }
+    // size: 元素个数(其它线程同时修改时是近似值)
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i != count; ++i)
+            total += shards[i].size.load(std::memory_order_relaxed);
+        return total;
+    }
+    bool empty() const { return size() == 0; }
+
+    // push: 加入一个元素
+    void push(const T &element) { pushImpl(T(element)); }
+    void push(T &&element) { pushImpl(std::move(element)); }
+    // try_pop: 取出一个近似最小的元素(见上面的秩误差)并移动到element, 队列为空时返回false
+    bool try_pop(T &element)
+    {
+        std::size_t misses = 0;
+        while (misses < 2 * count){
+            if (count == 1){
+                Shard &only = shards[0];
+                only.lock();
+                bool found = popFrom(only, element);
+                only.unlock();
+                return found;
+            }
+            std::size_t i = random() % count, j = random() % (count - 1);
+            if (j >= i)
+                ++j;
+            Shard *a = &shards[i], *b = &shards[j];
+            if (a->size.load(std::memory_order_relaxed) == 0)
+                std::swap(a, b);
+            if (a->size.load(std::memory_order_relaxed) == 0){
+                ++misses;
+                continue;
+            }
+            if (!a->try_lock()){
+                // 持有锁的线程可能没有在运行(线程数多于核数), 让出处理器
+                std::this_thread::yield();
+                continue;
+            }
+            if (b->size.load(std::memory_order_relaxed) != 0 && b->try_lock()){
+                // 两个锁都拿到了: 取堆顶较小的一个, 另一个先释放
+                if (b->heap.empty() || (!a->heap.empty() && !less(b->heap.top(), a->heap.top())))
+                    b->unlock();
+                else{
+                    a->unlock();
+                    a = b;
+                }
+            }
+            bool found = popFrom(*a, element);
+            a->unlock();
+            if (found)
+                return true;
+            ++misses;
+        }
+        // 随机选择多次都是空的堆: 逐个检查
+        for (std::size_t i = 0; i != count; ++i){
+            Shard &shard = shards[i];
+            if (shard.size.load(std::memory_order_relaxed) == 0)
+                continue;
+            shard.lock();
+            bool found = popFrom(shard, element);
+            shard.unlock();
+            if (found)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    // Shard: 一个堆与它的锁, 独占缓存行
+    struct Shard
+    {
+        Shard() : locked(false), size(0) {  }
+        bool try_lock() { return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire); }
+        void lock()
+        {
+            while (!try_lock())
+                std::this_thread::yield();
+        }
+        void unlock() { locked.store(false, std::memory_order_release); }
+
+        char padding[64];
+        std::atomic<bool> locked;
+        std::atomic<std::size_t> size;      // 堆中的元素个数, 不加锁读取
+        Heap heap;
+    };
+
+    const std::size_t count;
+    std::unique_ptr<Shard[]> shards;
+    Compare compare;
+    KeyOf keyOf;
+
+    // less: 比较两个堆顶; KeyOf只要求接受T&, 堆顶是const T&
+    bool less(const T &a, const T &b)
+    {
+        return compare(keyOf(const_cast<T &>(a)), keyOf(const_cast<T &>(b)));
+    }
+    // random: 每个线程自己的xorshift随机数
+    static std::uint64_t random()
+    {
+        static thread_local std::uint64_t state =
+            0x9E3779B97F4A7C15ull ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    void pushImpl(T &&element)
+    {
+        for (;;){
+            Shard &shard = shards[random() % count];
+            if (!shard.try_lock()){
+                std::this_thread::yield();
+                continue;
+            }
+            shard.heap.push(std::move(element));
+            shard.size.fetch_add(1, std::memory_order_relaxed);
+            shard.unlock();
+            return;
+        }
+    }
+    // popFrom: 从已经加锁的堆中取出堆顶
+    bool popFrom(Shard &shard, T &element)
+    {
+        if (shard.heap.empty())
+            return false;
+        element = shard.heap.extract_min();
+        shard.size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+};
+#endif
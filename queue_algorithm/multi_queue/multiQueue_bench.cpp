@@ -0,0 +1,102 @@
+/*************************************************************************
+	> File Name: multiQueue_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时12分48秒
+ ************************************************************************/
+// MultiQueue与互斥锁保护的IndexedMinQueue在1到64个线程时的吞吐量, 以CSV格式输出
+/*
+ * 用法: ./Bench [最大线程数(默认64)] [总操作次数(默认4000000)] [初始元素个数(默认1000000)]
+ *      先加入初始元素, 然后每个线程交替地try_pop一个元素并push一个更大的关键字(最佳优先搜索的展开),
+ *      总操作次数平均分给各个线程. 线程数为1, 2, 4, ..., 最大线程数.
+ * 吞吐量只有在线程数不超过核数时才能随线程数增加; 核数之外的线程只是轮流运行, 这时测量的是锁在线程被换出时的表现
+ * (互斥锁的持有者被换出时所有线程都要等待, MultiQueue的其它线程换一个堆继续).
+ *
+ * 输出的每一行: queue,threads,heaps,operations,mops
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "multiQueue.h"
+
+typedef std::chrono::steady_clock Clock;
+std::atomic<std::uint64_t> bench_sink(0);   // 取出的关键字之和, 使编译器不能省略
+
+std::uint64_t xorshift(std::uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// LockedQueue: 一把互斥锁保护的精确优先队列
+struct LockedQueue
+{
+    explicit LockedQueue(std::size_t) {  }
+    std::size_t heaps() const { return 1; }
+    void push(std::uint64_t key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push(key);
+    }
+    bool try_pop(std::uint64_t &key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (queue.empty())
+            return false;
+        key = queue.extract_min();
+        return true;
+    }
+    std::mutex lock;
+    IndexedMinQueue<std::uint64_t> queue;
+};
+struct RelaxedQueue : MultiQueue<std::uint64_t>
+{
+    explicit RelaxedQueue(std::size_t threads) : MultiQueue<std::uint64_t>(threads) {  }
+};
+
+template<typename Queue>
+void run(const char *name, std::size_t threads, std::size_t operations, std::size_t initial)
+{
+    Queue queue(threads);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (std::size_t i = 0; i != initial; ++i)
+        queue.push(xorshift(state) >> 24);
+    std::size_t per_thread = operations / threads / 2;
+    std::vector<std::thread> workers;
+    auto begin = Clock::now();
+    for (std::size_t t = 0; t != threads; ++t)
+        workers.emplace_back([&, t]{
+            std::uint64_t local = 0x9E3779B97F4A7C15ull * (t + 1), key = 0, sum = 0;
+            for (std::size_t i = 0; i != per_thread; ++i){
+                if (queue.try_pop(key))
+                    sum += key;
+                queue.push(key + (xorshift(local) >> 48));
+            }
+            bench_sink += sum;
+        });
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    std::cout << name << ',' << threads << ',' << queue.heaps() << ',' << per_thread * threads * 2 << ','
+              << per_thread * threads * 2 / seconds / 1e6 << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t maxThreads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+    std::size_t initial = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+    std::cout << "queue,threads,heaps,operations,mops\n";
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2){
+        run<LockedQueue>("mutex_IndexedMinQueue", threads, operations, initial);
+        run<RelaxedQueue>("MultiQueue", threads, operations, initial);
+    }
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+/*************************************************************************
+	> File Name: multiQueue_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时15分31秒
+ ************************************************************************/
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "multiQueue.h"
+using std::cout;
+using std::endl;
+
+struct Task
+{
+    int priority;
+    std::string name;
+};
+struct TaskPriority
+{
+    int& operator()(Task &task) const { return task.priority; }
+};
+
+// Fenwick: 统计队列中小于某个关键字的元素个数(关键字为0..n-1)
+struct Fenwick
+{
+    explicit Fenwick(std::size_t n) : tree(n + 1, 0) {  }
+    void add(std::size_t i, int delta) { for (++i; i < tree.size(); i += i & (0 - i)) tree[i] += delta; }
+    long prefix(std::size_t i) const { long s = 0; for (; i != 0; i -= i & (0 - i)) s += tree[i]; return s; }
+    std::vector<long> tree;
+};
+
+// rankTest: 单线程时每个元素恰好取出一次, 一个堆时是精确的优先队列, 多个堆时平均秩误差与堆数同阶
+void rankTest()
+{
+    bool correct = true;
+    const int n = 100000;
+    {
+        MultiQueue<int> exact(1, 1);
+        for (int i = n; i != 0; --i)
+            exact.push(i % 1000);
+        int last = -1, value;
+        while (exact.try_pop(value)){
+            correct = correct && value >= last;
+            last = value;
+        }
+        correct = correct && exact.empty();
+    }
+    MultiQueue<Task, int, TaskPriority> queue(8, 2);
+    Fenwick present(n);
+    std::vector<int> keys(n);
+    for (int i = 0; i != n; ++i)
+        keys[i] = i;
+    std::srand(41);
+    for (int i = n - 1; i > 0; --i)
+        std::swap(keys[i], keys[std::rand() % (i + 1)]);
+    for (int key : keys){
+        queue.push(Task{key, std::to_string(key)});
+        present.add(key, 1);
+    }
+    correct = correct && queue.heaps() == 16 && queue.size() == static_cast<std::size_t>(n);
+    double rankSum = 0;
+    long maxRank = 0;
+    std::vector<int> seen(n, 0);
+    Task task;
+    while (queue.try_pop(task)){
+        long rank = present.prefix(task.priority);
+        rankSum += rank;
+        maxRank = std::max(maxRank, rank);
+        present.add(task.priority, -1);
+        correct = correct && task.name == std::to_string(task.priority) && ++seen[task.priority] == 1;
+    }
+    for (int s : seen)
+        correct = correct && s == 1;
+    double meanRank = rankSum / n;
+    cout << "16个堆的平均秩误差: " << meanRank << ", 最大秩误差: " << maxRank << endl;
+    correct = correct && meanRank < 4 * 16 && maxRank < 40 * 16;
+    cout << "单线程的取出次序与秩误差: " << (correct ? "正确" : "错误") << endl;
+}
+
+// concurrentTest: 4个线程同时push与try_pop, 每个元素恰好被取出一次
+void concurrentTest()
+{
+    const int threads = 4, per_thread = 50000;
+    MultiQueue<std::uint64_t> queue(threads);
+    std::vector<std::atomic<int>> seen(threads * per_thread);
+    for (auto &s : seen)
+        s.store(0);
+    std::atomic<int> taken(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t != threads; ++t)
+        workers.emplace_back([&, t]{
+            std::uint64_t value;
+            for (int i = 0; i != per_thread; ++i){
+                queue.push(static_cast<std::uint64_t>(t) * per_thread + i);
+                if (i % 2 == 1 && queue.try_pop(value)){
+                    ++seen[value];
+                    ++taken;
+                }
+            }
+            while (taken.load() != threads * per_thread)
+                if (queue.try_pop(value)){
+                    ++seen[value];
+                    ++taken;
+                }else
+                    std::this_thread::yield();
+        });
+    for (auto &worker : workers)
+        worker.join();
+    bool correct = queue.empty();
+    for (auto &s : seen)
+        correct = correct && s.load() == 1;
+    cout << "多线程同时加入与取出: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************MultiQueue的测试********************\n";
+    rankTest();
+    concurrentTest();
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*************************************************************************
+	> File Name: pairingHeap.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时56分55秒
+ ************************************************************************/
+
+#ifndef _PAIRINGHEAP_H
+#define _PAIRINGHEAP_H
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../min_queue/minqueue.h"
+// PairingHeap: 配对堆(最小堆)
+/*
+ * 配对堆是一棵多叉树, 每个节点的关键字不大于它的孩子. 节点用"左孩子, 右兄弟"表示, 另有prev指向左侧的兄弟
+ * (最左的孩子指向父节点), 这样任何节点都可以在O(1)时间内从树中剪下.
+ *      --push: 新节点与根比较一次, 较大的一个成为另一个的最左孩子, O(1);
+ *      --decrease_key: 减小关键字, 把以该节点为根的子树剪下再与根合并, O(1)(均摊o(logn));
+ *      --pop: 删除根, 把它的孩子从左到右两两合并, 再从右到左依次合并成一棵树, 均摊O(logn);
+ *      --erase: 剪下该节点, 把它的孩子两两合并以后再与根合并.
+ * 与IndexedMinQueue的接口相同(push返回句柄, top/top_handle/pop/extract_min/decrease_key/update/erase/contains/get),
+ * 模板参数的含义也相同: KeyOf(T&)返回关键字的引用, Compare比较关键字.
+ *
+ * 节点放在一个std::vector(节点池)中, 链接是下标而不是指针, 句柄就是节点的下标; 删除的节点放入空闲链表,
+ * 之后被新的元素重新使用. 不为每个元素单独分配内存, 节点池扩容时句柄仍然有效.
+ *
+ * 算法性能: push, top, decrease_key为O(1)(decrease_key的均摊上界为O(2^{2sqrt(loglogn)})), pop与erase均摊O(logn).
+ *
+ */
+template<typename T, typename TkeyType = T, typename KeyOf = MinQueueIdentity<T>, typename Compare = std::less<TkeyType>>
+class PairingHeap
+{
+public:
+    typedef std::size_t Handle;     // 元素的句柄(节点池中的下标)
+    static const Handle npos = static_cast<Handle>(-1);
+    //****************************构造函数*******************************
+    explicit PairingHeap(KeyOf k = KeyOf(), Compare c = Compare())
+        : root(npos), freeList(npos), count(0), keyOf(k), compare(c) {  }
+    //****************************成员函数*******************************
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void reserve(std::size_t n) { pool.reserve(n); }
+    void clear()
+    {
+        pool.clear();
+        root = freeList = npos;
+        count = 0;
+    }
+    // top, top_handle: 最小的元素与它的句柄, 调用者保证非空
+    const T& top() const { return pool[root].value; }
+    Handle top_handle() const { return root; }
+    bool contains(Handle h) const { return h < pool.size() && pool[h].live; }
+    const T& get(Handle h) const { return pool[checked(h)].value; }
+
+    // push: 加入一个元素, 返回它的句柄
+    Handle push(const T &element) { return pushImpl(T(element)); }
+    Handle push(T &&element) { return pushImpl(std::move(element)); }
+    // pop: 删除最小的元素, 调用者保证非空
+    void pop()
+    {
+        Handle old = root;
+        root = mergePairs(pool[old].child);
+        release(old);
+    }
+    // extract_min: 删除并返回最小的元素, 调用者保证非空
+    T extract_min()
+    {
+        T result = std::move(pool[root].value);
+        pop();
+        return result;
+    }
+    // decrease_key: 把句柄h的元素的关键字减小为key; key大于原来的关键字或h无效时抛出std::invalid_argument
+    void decrease_key(Handle h, const TkeyType &key)
+    {
+        checked(h);
+        if (compare(keyOf(pool[h].value), key))
+            throw std::invalid_argument("decrease_key error: new key is greater than the current key!");
+        keyOf(pool[h].value) = key;
+        if (h != root){
+            cut(h);
+            root = meld(root, h);
+        }
+    }
+    // update: 把句柄h的元素的关键字改为key(可以增大): 增大时先删除再重新加入(句柄不变)
+    void update(Handle h, const TkeyType &key)
+    {
+        checked(h);
+        if (!compare(keyOf(pool[h].value), key)){
+            decrease_key(h, key);
+            return;
+        }
+        detach(h);
+        keyOf(pool[h].value) = key;
+        root = meld(root, h);
+    }
+    // erase: 删除句柄h的元素; h无效时抛出std::invalid_argument
+    void erase(Handle h)
+    {
+        checked(h);
+        detach(h);
+        release(h);
+    }
+
+private:
+    struct Node
+    {
+        explicit Node(T &&v) : value(std::move(v)), child(npos), sibling(npos), prev(npos), live(true) {  }
+        T value;
+        Handle child;       // 最左的孩子
+        Handle sibling;     // 右侧的兄弟(空闲链表中为下一个空闲节点)
+        Handle prev;        // 左侧的兄弟, 最左的孩子指向父节点, 根为npos
+        bool live;          // 是否在堆中
+    };
+    std::vector<Node> pool;     // 节点池
+    Handle root;                // 根节点
+    Handle freeList;            // 空闲链表
+    std::size_t count;          // 元素个数
+    KeyOf keyOf;
+    Compare compare;
+
+    Handle checked(Handle h) const
+    {
+        if (!contains(h))
+            throw std::invalid_argument("PairingHeap error: the handle is not in the heap!");
+        return h;
+    }
+    bool less(Handle a, Handle b) { return compare(keyOf(pool[a].value), keyOf(pool[b].value)); }
+    Handle pushImpl(T &&element)
+    {
+        Handle h;
+        if (freeList != npos){
+            h = freeList;
+            freeList = pool[h].sibling;
+            pool[h] = Node(std::move(element));
+        }else{
+            h = pool.size();
+            pool.push_back(Node(std::move(element)));
+        }
+        ++count;
+        root = root == npos ? h : meld(root, h);
+        return h;
+    }
+    void release(Handle h)
+    {
+        pool[h].live = false;
+        pool[h].child = pool[h].prev = npos;
+        pool[h].sibling = freeList;
+        freeList = h;
+        --count;
+    }
+    // meld: 合并两棵树(a与b都是根, 没有兄弟), 返回新的根
+    Handle meld(Handle a, Handle b)
+    {
+        if (a == npos) return b;
+        if (b == npos) return a;
+        if (less(b, a))
+            std::swap(a, b);
+        // b成为a最左的孩子
+        Node &parent = pool[a], &node = pool[b];
+        node.sibling = parent.child;
+        node.prev = a;
+        if (parent.child != npos)
+            pool[parent.child].prev = b;
+        parent.child = b;
+        return a;
+    }
+    // cut: 把以h为根的子树从所在的兄弟链表中剪下(h不是根)
+    void cut(Handle h)
+    {
+        Node &node = pool[h];
+        Node &left = pool[node.prev];
+        if (left.child == h)
+            left.child = node.sibling;      // h是最左的孩子, prev为父节点
+        else
+            left.sibling = node.sibling;
+        if (node.sibling != npos)
+            pool[node.sibling].prev = node.prev;
+        node.sibling = node.prev = npos;
+    }
+    // detach: 从堆中取出节点h(不释放), 它的孩子合并以后留在堆中
+    void detach(Handle h)
+    {
+        Handle children = pool[h].child;
+        pool[h].child = npos;
+        if (h == root){
+            root = mergePairs(children);
+            return;
+        }
+        cut(h);
+        root = meld(root, mergePairs(children));
+    }
+    // mergePairs: 两趟合并first开始的兄弟链表, 返回合并后的根
+    /*
+     * 第一趟从左到右两两合并, 结果通过sibling逆序串起来; 第二趟从右到左依次合并. 不递归.
+    */
+    Handle mergePairs(Handle first)
+    {
+        if (first == npos)
+            return npos;
+        Handle paired = npos;   // 第一趟的结果, 最后一对在最前面
+        while (first != npos){
+            Handle a = first, b = pool[a].sibling;
+            if (b == npos){
+                pool[a].prev = npos;
+                pool[a].sibling = paired;
+                paired = a;
+                break;
+            }
+            first = pool[b].sibling;
+            pool[a].sibling = pool[a].prev = pool[b].sibling = pool[b].prev = npos;
+            Handle m = meld(a, b);
+            pool[m].sibling = paired;
+            paired = m;
+        }
+        Handle result = paired;
+        paired = pool[result].sibling;
+        pool[result].sibling = npos;
+        while (paired != npos){
+            Handle next = pool[paired].sibling;
+            pool[paired].sibling = npos;
+            result = meld(result, paired);
+            paired = next;
+        }
+        pool[result].prev = npos;
+        return result;
+    }
+};
+template<typename T, typename TkeyType, typename KeyOf, typename Compare>
+const typename PairingHeap<T, TkeyType, KeyOf, Compare>::Handle PairingHeap<T, TkeyType, KeyOf, Compare>::npos;
+#endif
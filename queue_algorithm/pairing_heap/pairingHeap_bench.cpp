@@ -0,0 +1,201 @@
+/*************************************************************************
+	> File Name: pairingHeap_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时02分21秒
+ ************************************************************************/
+// 在道路网大小的图上运行Dijkstra算法, 对比IndexedMinQueue(二叉堆), PairingHeap与RadixHeap, 以CSV格式输出
+/*
+ * 用法: ./Bench [网格的边长(默认1000) | DIMACS的.gr文件]
+ *      --边长s: 生成s * s个顶点的网格, 每个顶点与上下左右的顶点双向相连, 边权为[1, 1000]的随机整数(行驶时间),
+ *        另有s * s / 64条随机的长边(快速路), 边权为两端的曼哈顿距离的一半. s = 1000时约有1百万个顶点与4百万条边,
+ *        与一个州的道路网(第9届DIMACS最短路径挑战赛的数据)的规模相同;
+ *      --.gr文件: 读入DIMACS格式的道路网("p sp n m"与"a u v w"行, 顶点从1开始编号), 例如USA-road-t.NY.gr.
+ * 每种队列都从同一组随机的起点运行Dijkstra算法, 每个顶点最多有一个句柄, 更短的路径通过decrease_key更新;
+ * 三种队列得到的距离之和必须相同.
+ *
+ * 输出的每一行: queue,vertices,edges,sources,pushes,decrease_keys,ms_per_run,distance_sum
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "pairingHeap.h"
+#include "../radix_heap/radixHeap.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 距离之和, 使编译器不能省略
+
+// Graph: 压缩的邻接表, 顶点u的边为edges[offset[u]]..edges[offset[u + 1] - 1]
+struct Graph
+{
+    struct Edge
+    {
+        std::uint32_t to;
+        std::uint32_t weight;
+    };
+    std::vector<std::uint32_t> offset;
+    std::vector<Edge> edges;
+    std::size_t vertices() const { return offset.size() - 1; }
+};
+// buildGraph: 由(起点, 终点, 边权)的列表建立压缩的邻接表
+Graph buildGraph(std::size_t n, const std::vector<std::uint32_t> &from, const std::vector<Graph::Edge> &arcs)
+{
+    Graph graph;
+    graph.offset.assign(n + 1, 0);
+    for (std::uint32_t u : from)
+        ++graph.offset[u + 1];
+    for (std::size_t i = 0; i != n; ++i)
+        graph.offset[i + 1] += graph.offset[i];
+    graph.edges.resize(arcs.size());
+    std::vector<std::uint32_t> next(graph.offset.begin(), graph.offset.end() - 1);
+    for (std::size_t i = 0; i != arcs.size(); ++i)
+        graph.edges[next[from[i]]++] = arcs[i];
+    return graph;
+}
+
+std::uint64_t state = 0x2545F4914F6CDD1Dull;
+std::uint64_t xorshift()
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+Graph gridGraph(std::uint32_t side)
+{
+    std::size_t n = static_cast<std::size_t>(side) * side;
+    std::vector<std::uint32_t> from;
+    std::vector<Graph::Edge> arcs;
+    auto addRoad = [&](std::uint32_t u, std::uint32_t v, std::uint32_t w){
+        from.push_back(u);
+        arcs.push_back(Graph::Edge{v, w});
+        from.push_back(v);
+        arcs.push_back(Graph::Edge{u, w});
+    };
+    for (std::uint32_t r = 0; r != side; ++r)
+        for (std::uint32_t c = 0; c != side; ++c){
+            std::uint32_t u = r * side + c;
+            if (c + 1 != side) addRoad(u, u + 1, 1 + xorshift() % 1000);
+            if (r + 1 != side) addRoad(u, u + side, 1 + xorshift() % 1000);
+        }
+    for (std::size_t i = 0; i != n / 64; ++i){
+        std::uint32_t u = xorshift() % n, v = xorshift() % n;
+        std::int64_t dr = static_cast<std::int64_t>(u / side) - v / side, dc = static_cast<std::int64_t>(u % side) - v % side;
+        addRoad(u, v, static_cast<std::uint32_t>(1 + (std::llabs(dr) + std::llabs(dc)) * 250));
+    }
+    return buildGraph(n, from, arcs);
+}
+Graph dimacsGraph(const std::string &path)
+{
+    std::ifstream in(path.c_str());
+    if (!in){
+        std::cerr << "cannot open " << path << '\n';
+        std::exit(1);
+    }
+    std::size_t n = 0;
+    std::vector<std::uint32_t> from;
+    std::vector<Graph::Edge> arcs;
+    std::string line;
+    while (std::getline(in, line)){
+        std::istringstream fields(line);
+        char kind = 0;
+        fields >> kind;
+        if (kind == 'p'){
+            std::string sp;
+            std::size_t m = 0;
+            fields >> sp >> n >> m;
+            from.reserve(m);
+            arcs.reserve(m);
+        }else if (kind == 'a'){
+            std::uint32_t u = 0, v = 0, w = 0;
+            fields >> u >> v >> w;
+            from.push_back(u - 1);
+            arcs.push_back(Graph::Edge{v - 1, w});
+        }
+    }
+    return buildGraph(n, from, arcs);
+}
+
+// Label: 队列中的元素, 关键字为到起点的距离
+struct Label
+{
+    std::uint64_t distance;
+    std::uint32_t vertex;
+};
+struct LabelDistance
+{
+    std::uint64_t& operator()(Label &label) const { return label.distance; }
+    const std::uint64_t& operator()(const Label &label) const { return label.distance; }
+};
+struct RunStats
+{
+    std::uint64_t pushes = 0;
+    std::uint64_t decreaseKeys = 0;
+    std::uint64_t distanceSum = 0;
+};
+// dijkstra: 从source出发的最短路径, handle[v]为顶点v在队列中的句柄(已经出队或未到达时为npos)
+template<typename Queue>
+void dijkstra(const Graph &graph, std::uint32_t source, Queue &queue, RunStats &stats)
+{
+    const std::uint64_t unreached = ~std::uint64_t(0);
+    std::vector<std::uint64_t> distance(graph.vertices(), unreached);
+    std::vector<typename Queue::Handle> handle(graph.vertices(), Queue::npos);
+    queue.clear();
+    distance[source] = 0;
+    handle[source] = queue.push(Label{0, source});
+    ++stats.pushes;
+    while (!queue.empty()){
+        Label label = queue.extract_min();
+        handle[label.vertex] = Queue::npos;
+        stats.distanceSum += label.distance;
+        for (std::uint32_t e = graph.offset[label.vertex]; e != graph.offset[label.vertex + 1]; ++e){
+            const Graph::Edge &edge = graph.edges[e];
+            std::uint64_t d = label.distance + edge.weight;
+            if (d >= distance[edge.to])
+                continue;
+            if (distance[edge.to] == unreached){
+                handle[edge.to] = queue.push(Label{d, edge.to});
+                ++stats.pushes;
+            }else{
+                queue.decrease_key(handle[edge.to], d);
+                ++stats.decreaseKeys;
+            }
+            distance[edge.to] = d;
+        }
+    }
+}
+template<typename Queue>
+void run(const char *name, const Graph &graph, const std::vector<std::uint32_t> &sources)
+{
+    Queue queue;
+    queue.reserve(graph.vertices());
+    RunStats stats;
+    auto begin = Clock::now();
+    for (std::uint32_t source : sources)
+        dijkstra(graph, source, queue, stats);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count() / sources.size();
+    bench_sink += stats.distanceSum;
+    std::cout << name << ',' << graph.vertices() << ',' << graph.edges.size() << ',' << sources.size() << ','
+              << stats.pushes << ',' << stats.decreaseKeys << ',' << ms << ',' << stats.distanceSum << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::string argument = argc > 1 ? argv[1] : "1000";
+    Graph graph = argument.find(".gr") != std::string::npos ? dimacsGraph(argument)
+                : gridGraph(static_cast<std::uint32_t>(std::strtoul(argument.c_str(), nullptr, 10)));
+    std::vector<std::uint32_t> sources;
+    for (int i = 0; i != 3; ++i)
+        sources.push_back(static_cast<std::uint32_t>(xorshift() % graph.vertices()));
+    std::cout << "queue,vertices,edges,sources,pushes,decrease_keys,ms_per_run,distance_sum\n";
+    run<IndexedMinQueue<Label, std::uint64_t, LabelDistance>>("IndexedMinQueue", graph, sources);
+    run<PairingHeap<Label, std::uint64_t, LabelDistance>>("PairingHeap", graph, sources);
+    run<RadixHeap<Label, std::uint64_t, LabelDistance>>("RadixHeap", graph, sources);
+    return bench_sink == 0 ? 1 : 0;
+}
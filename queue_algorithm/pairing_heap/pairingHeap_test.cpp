@@ -0,0 +1,127 @@
+/*************************************************************************
+	> File Name: pairingHeap_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时06分04秒
+ ************************************************************************/
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include "pairingHeap.h"
+using std::cout;
+using std::endl;
+
+struct Task
+{
+    int deadline;
+    std::string name;
+};
+struct TaskDeadline
+{
+    int& operator()(Task &task) const { return task.deadline; }
+    const int& operator()(const Task &task) const { return task.deadline; }
+};
+typedef PairingHeap<Task, int, TaskDeadline> TaskHeap;
+
+// randomTest: 随机的push, pop, decrease_key, update与erase, 最小的关键字与std::map记录的相同
+void randomTest()
+{
+    TaskHeap heap;
+    std::map<TaskHeap::Handle, int> live;     // 句柄 -> 当前的deadline
+    std::multiset<int> keys;
+    bool correct = true;
+    std::srand(31);
+    for (int i = 0; i != 30000; ++i){
+        int op = std::rand() % 6;
+        if (live.empty() || op < 2){
+            int deadline = std::rand() % 100000;
+            auto h = heap.push(Task{deadline, "task" + std::to_string(i)});
+            correct = correct && !live.count(h) && heap.get(h).name == "task" + std::to_string(i);
+            live[h] = deadline;
+            keys.insert(deadline);
+        }else{
+            auto it = live.begin();
+            std::advance(it, std::rand() % live.size());
+            TaskHeap::Handle h = it->first;
+            if (op == 2 || op == 3){
+                int key = op == 2 ? it->second - std::rand() % 1000 : it->second + std::rand() % 1000 - 500;
+                if (op == 2)
+                    heap.decrease_key(h, key);
+                else
+                    heap.update(h, key);
+                keys.erase(keys.find(it->second));
+                keys.insert(key);
+                it->second = key;
+                correct = correct && heap.get(h).deadline == key;
+            }else if (op == 4){
+                heap.erase(h);
+                keys.erase(keys.find(it->second));
+                live.erase(it);
+                correct = correct && !heap.contains(h);
+            }else{
+                TaskHeap::Handle top = heap.top_handle();
+                correct = correct && heap.top().deadline == *keys.begin() && live[top] == *keys.begin();
+                Task task = heap.extract_min();
+                correct = correct && task.deadline == *keys.begin() && !heap.contains(top);
+                keys.erase(keys.begin());
+                live.erase(top);
+            }
+        }
+        correct = correct && heap.size() == keys.size();
+    }
+    while (!heap.empty()){
+        correct = correct && heap.top().deadline == *keys.begin();
+        heap.pop();
+        keys.erase(keys.begin());
+    }
+    cout << "句柄, decrease_key, update, erase与pop: " << (correct ? "正确" : "错误") << endl;
+}
+
+// orderTest: 升序, 降序插入以后按顺序取出; 错误的参数抛出std::invalid_argument
+void orderTest()
+{
+    bool correct = true;
+    PairingHeap<int> heap;
+    for (int i = 0; i != 5000; ++i)
+        heap.push(i % 2 ? i : 10000 - i);
+    std::multiset<int> expected;
+    for (int i = 0; i != 5000; ++i)
+        expected.insert(i % 2 ? i : 10000 - i);
+    for (int value : expected)
+        correct = correct && heap.extract_min() == value;
+    correct = correct && heap.empty();
+    auto h = heap.push(5);
+    try{
+        heap.decrease_key(h, 6);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    heap.pop();
+    try{
+        heap.erase(h);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    // 降低为最小的关键字以后成为根
+    for (int i = 0; i != 100; ++i)
+        heap.push(100 + i);
+    heap.decrease_key(42, -7);
+    correct = correct && heap.top() == -7 && heap.top_handle() == 42 && heap.size() == 100;
+    heap.clear();
+    correct = correct && heap.empty() && !heap.contains(0);
+    PairingHeap<int, int, MinQueueIdentity<int>, std::greater<int>> maxHeap;
+    for (int i = 0; i != 100; ++i)
+        maxHeap.push(i);
+    correct = correct && maxHeap.top() == 99;
+    cout << "顺序, 比较函数与错误的参数: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************PairingHeap的测试********************\n";
+    randomTest();
+    orderTest();
+    return 0;
+}
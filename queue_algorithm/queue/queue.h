@@ -16,15 +16,22 @@
  * 队列需要支持的操作:
  *      --enQueue(S,x): 向队列中插入一个新元素x;
  *      --deQueue(S): 队列中弹出一个元素;
+ *
+ * Alloc: 存放元素指针的数组的分配器(rebind为std::shared_ptr<T>的分配器, 默认的std::allocator与原来相同);
+ * 例如ResourceAllocator<T>(tree_algorithm/NodeArena/MemoryResource.h)使数组来自MonotonicBufferResource.
+ * 元素由调用者创建, 可以用std::allocate_shared<T>(queue.get_allocator(), ...)从同一个来源分配.
 */
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class Queue
 {
 public:
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::shared_ptr<T>> AllocatorType;
     //****************************构造函数*******************************
-    Queue(std::size_t numbers): head(0), tail(0) {data.resize(numbers);}
+    Queue(std::size_t numbers, const Alloc &alloc = Alloc()): data(AllocatorType(alloc)), head(0), tail(0)
+    {data.resize(numbers);}
     Queue(): head(0), tail(0) {data.resize(20);}
     ~Queue() = default;
+    AllocatorType get_allocator() const { return data.get_allocator(); }
     //****************************成员函数*******************************
     // enQueue: 向队列中插入一个元素
     /*
@@ -36,7 +43,7 @@ public:
     {
         // 检查上溢
         if (head % data.size() == (tail + 1) % data.size()){
-            std::cerr << "队列已满,禁止插入新元素" << endl;
+            std::cerr << "队列已满,禁止插入新元素" << std::endl;
             return;
         }
         data[tail] = num;
@@ -53,7 +60,7 @@ public:
     {
         // 检查下溢
         if (head % data.size() == tail % data.size()){
-            std::cerr << "队列为空,禁止出队" << endl;
+            std::cerr << "队列为空,禁止出队" << std::endl;
             return std::shared_ptr<T>();
         }
         std::shared_ptr<T> temp = data[head];
@@ -75,7 +82,7 @@ public:
     }
 private:
     //****************************数据结构*******************************
-    std::vector<std::shared_ptr<T>> data;       // 队列的数据
+    std::vector<std::shared_ptr<T>, AllocatorType> data;       // 队列的数据
     std::size_t head;        // 队头
     std::size_t tail;        // 队尾
 };
@@ -8,6 +8,7 @@
 #include <iostream>
 using std::cout;    using std::endl;
 #include "queue.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 
 typedef Queue<int> IntQueue;
 typedef Queue<double> DoubleQueue;
@@ -43,10 +44,29 @@ void doubleTest()
             cout << *val_ptr << " ";
     }
 }
+// resourceTest: 循环数组与元素都从调用者提供的缓冲区分配
+void resourceTest()
+{
+    alignas(std::max_align_t) static char buffer[4096];
+    MonotonicBufferResource arena(buffer, sizeof(buffer));
+    Queue<int, ResourceAllocator<int>> queue(20, &arena);
+    bool correct = true;
+    for (int round = 0; round != 3; ++round){
+        for (int i = 0; i != 10; ++i)
+            queue.enQueue(std::allocate_shared<int>(queue.get_allocator(), i));
+        for (int i = 0; i != 10; ++i){
+            auto val_ptr = queue.deQueue();
+            correct = correct && val_ptr && *val_ptr == i;
+        }
+    }
+    cout << "\n从MemoryResource分配: " << (correct && arena.chunkCount() == 0 ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     intTest();
     doubleTest();
+    resourceTest();
 
     return 0;
 }
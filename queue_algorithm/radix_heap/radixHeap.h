@@ -0,0 +1,234 @@
+/*************************************************************************
+	> File Name: radixHeap.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时59分38秒
+ ************************************************************************/
+
+#ifndef _RADIXHEAP_H
+#define _RADIXHEAP_H
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../min_queue/minqueue.h"
+// RadixHeap: 单调的基数堆(关键字为无符号整数的最小堆)
+/*
+ * 单调: 每次加入的关键字(包括decrease_key以后的关键字)都不小于最近一次取出(或top()看到)的最小关键字last.
+ * Dijkstra算法满足这个条件: 新的距离是已经取出的距离加上一条非负的边.
+ *
+ * 元素按关键字与last的最高的不同位分到65个桶中: key == last在0号桶, 否则在1 + floor(lg(key ^ last))号桶.
+ * 第i号桶(i >= 1)中的关键字都在[last + 2^{i-1}, last + 2^i)附近, 桶号越小关键字越小.
+ *      --push, decrease_key: 计算桶号(一次__builtin_clzll)并放到桶的末尾, O(1);
+ *      --top: 0号桶中的任意一个元素(都等于last), 0号桶为空时先像pop一样重新分桶;
+ *      --pop: 0号桶为空时找到第一个非空的桶, 以其中最小的关键字为新的last, 把这个桶的元素重新分到更小的桶中,
+ *        然后取出0号桶的一个元素. 每个元素的桶号只会减小, 所以均摊O(lg C)(C为关键字的范围), 与n无关.
+ * 桶中只存放{关键字, 句柄}(16字节), 重新分桶时顺序地读写这些小的记录, 不访问元素本身, 所有桶的总大小为元素个数;
+ * 元素按句柄存放在values中, 另有position[h]记录句柄h在哪个桶的哪个位置.
+ *
+ * 与IndexedMinQueue, PairingHeap的接口相同(push返回句柄, top/top_handle/pop/extract_min/decrease_key/update/erase
+ * /contains/get), TkeyType必须是无符号整数类型. 违反单调性(关键字小于last)时抛出std::invalid_argument.
+ * 删除的句柄以后会被新的元素重新使用; 相等的关键字之间的次序不确定.
+ *
+ */
+template<typename T, typename TkeyType = T, typename KeyOf = MinQueueIdentity<T>>
+class RadixHeap
+{
+    static_assert(std::is_integral<TkeyType>::value && std::is_unsigned<TkeyType>::value,
+                  "RadixHeap requires an unsigned integer key type");
+    static_assert(std::numeric_limits<TkeyType>::digits <= 64, "RadixHeap supports keys of at most 64 bits");
+public:
+    typedef std::size_t Handle;     // 元素的句柄(values中的下标)
+    static const Handle npos = static_cast<Handle>(-1);
+    static const std::size_t buckets = std::numeric_limits<TkeyType>::digits + 1;
+    //****************************构造函数*******************************
+    explicit RadixHeap(KeyOf k = KeyOf()) : last(0), count(0), keyOf(k) {  }
+    //****************************成员函数*******************************
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void reserve(std::size_t n)
+    {
+        values.reserve(n);
+        position.reserve(n);
+    }
+    void clear()
+    {
+        for (auto &bucket : bucket_)
+            bucket.clear();
+        values.clear();
+        position.clear();
+        freeHandles.clear();
+        last = 0;
+        count = 0;
+    }
+    // last_key: 最近一次取出(或top()看到)的最小关键字, 之后加入的关键字都不能小于它
+    TkeyType last_key() const { return last; }
+    // top, top_handle: 最小的元素与它的句柄, 调用者保证非空
+    const T& top() const { return values[top_handle()]; }
+    Handle top_handle() const
+    {
+        pull();
+        return bucket_[0].back().handle;
+    }
+    bool contains(Handle h) const { return h < position.size() && position[h].bucket != npos; }
+    const T& get(Handle h) const { return values[checked(h)]; }
+
+    // push: 加入一个元素, 返回它的句柄; 关键字小于last_key()时抛出std::invalid_argument
+    Handle push(const T &element) { return pushImpl(T(element)); }
+    Handle push(T &&element) { return pushImpl(std::move(element)); }
+    // pop: 删除最小的元素, 调用者保证非空
+    void pop()
+    {
+        Handle h = top_handle();
+        bucket_[0].pop_back();
+        release(h);
+    }
+    // extract_min: 删除并返回最小的元素, 调用者保证非空
+    T extract_min()
+    {
+        T result = std::move(values[top_handle()]);
+        pop();
+        return result;
+    }
+    // decrease_key: 把句柄h的元素的关键字减小为key; key大于原来的关键字, 小于last_key()或h无效时抛出std::invalid_argument
+    void decrease_key(Handle h, TkeyType key)
+    {
+        checked(h);
+        if (keyOf(values[h]) < key)
+            throw std::invalid_argument("decrease_key error: new key is greater than the current key!");
+        move(h, key);
+    }
+    // update: 把句柄h的元素的关键字改为key(可以增大, 但不能小于last_key())
+    void update(Handle h, TkeyType key)
+    {
+        checked(h);
+        move(h, key);
+    }
+    // erase: 删除句柄h的元素; h无效时抛出std::invalid_argument
+    void erase(Handle h)
+    {
+        checked(h);
+        removeEntry(h);
+        release(h);
+    }
+
+private:
+    struct Entry
+    {
+        TkeyType key;
+        Handle handle;
+    };
+    struct Position
+    {
+        std::size_t bucket;     // 所在的桶, 不在堆中时为npos
+        std::size_t index;      // 在桶中的下标
+    };
+    // top()是const成员函数, 但可能需要重新分桶: 桶, 位置与last都是mutable
+    mutable std::vector<Entry> bucket_[buckets];
+    std::vector<T> values;                      // values[h]: 句柄h的元素
+    mutable std::vector<Position> position;     // position[h]: 句柄h的元素所在的位置
+    std::vector<Handle> freeHandles;            // 可以重新使用的句柄
+    mutable TkeyType last;                      // 最近一次取出(或top()看到)的最小关键字
+    std::size_t count;
+    KeyOf keyOf;
+
+    Handle checked(Handle h) const
+    {
+        if (!contains(h))
+            throw std::invalid_argument("RadixHeap error: the handle is not in the heap!");
+        return h;
+    }
+    void monotone(TkeyType key) const
+    {
+        if (key < last)
+            throw std::invalid_argument("RadixHeap error: the key is less than the last extracted key!");
+    }
+    // bucketOf: key所在的桶号
+    std::size_t bucketOf(TkeyType key) const
+    {
+        unsigned long long diff = static_cast<unsigned long long>(key ^ last);
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+    void place(Handle h, TkeyType key) const
+    {
+        std::size_t b = bucketOf(key);
+        position[h].bucket = b;
+        position[h].index = bucket_[b].size();
+        Entry entry = {key, h};
+        bucket_[b].push_back(entry);
+    }
+    // removeEntry: 把句柄h的记录从桶中删除(与桶的最后一个记录交换)
+    void removeEntry(Handle h)
+    {
+        std::vector<Entry> &bucket = bucket_[position[h].bucket];
+        std::size_t i = position[h].index;
+        bucket[i] = bucket.back();
+        position[bucket[i].handle].index = i;
+        bucket.pop_back();
+    }
+    void release(Handle h)
+    {
+        position[h].bucket = npos;
+        freeHandles.push_back(h);
+        --count;
+    }
+    Handle pushImpl(T &&element)
+    {
+        TkeyType key = keyOf(element);
+        monotone(key);
+        Handle h;
+        if (!freeHandles.empty()){
+            h = freeHandles.back();
+            freeHandles.pop_back();
+            values[h] = std::move(element);
+        }else{
+            h = values.size();
+            values.push_back(std::move(element));
+            position.push_back(Position());
+        }
+        ++count;
+        place(h, key);
+        return h;
+    }
+    // move: 把句柄h的关键字改为key并放到新的桶中
+    void move(Handle h, TkeyType key)
+    {
+        monotone(key);
+        removeEntry(h);
+        keyOf(values[h]) = key;
+        place(h, key);
+    }
+    // pull: 0号桶为空时, 以第一个非空的桶中最小的关键字为新的last并重新分桶, 使0号桶非空(调用者保证堆不空)
+    /*
+     * 只在取最小的元素时调用: 若在push或erase以后立即重新分桶, last会提前增大到当前的最小关键字,
+     * 之后加入介于已经取出的关键字与当前的最小关键字之间的关键字就违反了单调性.
+    */
+    void pull() const
+    {
+        if (!bucket_[0].empty())
+            return;
+        std::size_t b = 1;
+        while (bucket_[b].empty())
+            ++b;
+        std::vector<Entry> moving;
+        moving.swap(bucket_[b]);
+        TkeyType smallest = moving[0].key;
+        for (const Entry &entry : moving)
+            if (entry.key < smallest)
+                smallest = entry.key;
+        last = smallest;
+        for (const Entry &entry : moving)
+            place(entry.handle, entry.key);
+        // 把原来的存储还给第b号桶, 以后不再为它分配内存
+        moving.clear();
+        moving.swap(bucket_[b]);
+    }
+};
+template<typename T, typename TkeyType, typename KeyOf>
+const typename RadixHeap<T, TkeyType, KeyOf>::Handle RadixHeap<T, TkeyType, KeyOf>::npos;
+template<typename T, typename TkeyType, typename KeyOf>
+const std::size_t RadixHeap<T, TkeyType, KeyOf>::buckets;
+#endif
@@ -0,0 +1,135 @@
+/*************************************************************************
+	> File Name: radixHeap_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时08分47秒
+ ************************************************************************/
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include "radixHeap.h"
+using std::cout;
+using std::endl;
+
+struct Vertex
+{
+    std::uint64_t distance;
+    int id;
+};
+struct VertexDistance
+{
+    std::uint64_t& operator()(Vertex &v) const { return v.distance; }
+    const std::uint64_t& operator()(const Vertex &v) const { return v.distance; }
+};
+typedef RadixHeap<Vertex, std::uint64_t, VertexDistance> VertexHeap;
+
+// randomTest: 单调的随机操作(新的关键字不小于last_key()), 最小的关键字与std::multiset记录的相同
+void randomTest()
+{
+    VertexHeap heap;
+    std::map<VertexHeap::Handle, std::uint64_t> live;   // 句柄 -> 当前的关键字
+    std::multiset<std::uint64_t> keys;
+    bool correct = true;
+    std::srand(37);
+    for (int i = 0; i != 30000; ++i){
+        int op = std::rand() % 6;
+        // 关键字的范围既有很小的差, 也有跨越很多位的差
+        std::uint64_t delta = i % 7 == 0 ? static_cast<std::uint64_t>(std::rand()) << 20 : std::rand() % 64;
+        if (live.empty() || op < 2){
+            std::uint64_t key = heap.last_key() + delta;
+            auto h = heap.push(Vertex{key, i});
+            correct = correct && !live.count(h) && heap.get(h).id == i;
+            live[h] = key;
+            keys.insert(key);
+        }else{
+            auto it = live.begin();
+            std::advance(it, std::rand() % live.size());
+            VertexHeap::Handle h = it->first;
+            if (op == 2 || op == 3){
+                std::uint64_t key = op == 2 ? heap.last_key() + (it->second - heap.last_key()) / 2 : it->second + delta;
+                if (op == 2)
+                    heap.decrease_key(h, key);
+                else
+                    heap.update(h, key);
+                keys.erase(keys.find(it->second));
+                keys.insert(key);
+                it->second = key;
+                correct = correct && heap.get(h).distance == key;
+            }else if (op == 4){
+                heap.erase(h);
+                keys.erase(keys.find(it->second));
+                live.erase(it);
+                correct = correct && !heap.contains(h);
+            }else{
+                VertexHeap::Handle top = heap.top_handle();
+                correct = correct && heap.top().distance == *keys.begin() && live[top] == *keys.begin();
+                Vertex v = heap.extract_min();
+                correct = correct && v.distance == *keys.begin() && heap.last_key() <= v.distance;
+                keys.erase(keys.begin());
+                live.erase(top);
+            }
+        }
+        correct = correct && heap.size() == keys.size() && (heap.empty() || heap.top().distance == *keys.begin());
+    }
+    while (!heap.empty()){
+        correct = correct && heap.top().distance == *keys.begin();
+        heap.pop();
+        keys.erase(keys.begin());
+    }
+    cout << "单调的push, decrease_key, update, erase与pop: " << (correct ? "正确" : "错误") << endl;
+}
+
+// boundaryTest: 最大的关键字, 较小的关键字类型, 违反单调性与无效的句柄
+void boundaryTest()
+{
+    bool correct = true;
+    RadixHeap<std::uint64_t> wide;
+    std::uint64_t big = ~std::uint64_t(0);
+    wide.push(big);
+    wide.push(0);
+    wide.push(big - 1);
+    correct = correct && wide.extract_min() == 0 && wide.extract_min() == big - 1 && wide.extract_min() == big;
+    try{
+        wide.push(5);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    wide.clear();
+    correct = correct && wide.empty() && wide.last_key() == 0;
+
+    RadixHeap<unsigned char> narrow;
+    for (int i = 255; i >= 0; --i)
+        narrow.push(static_cast<unsigned char>(i));
+    for (int i = 0; i != 256; ++i)
+        correct = correct && narrow.extract_min() == i;
+
+    RadixHeap<unsigned> heap;
+    auto a = heap.push(10), b = heap.push(20);
+    heap.pop();
+    try{
+        heap.decrease_key(b, 5);    // 小于last_key()
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    try{
+        heap.decrease_key(b, 30);   // 大于原来的关键字
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    try{
+        heap.erase(a);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    correct = correct && heap.top() == 20 && heap.last_key() == 20 && heap.push(25) == a && heap.extract_min() == 20 && heap.top() == 25;
+    cout << "边界的关键字与错误的参数: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************RadixHeap的测试********************\n";
+    randomTest();
+    boundaryTest();
+    return 0;
+}
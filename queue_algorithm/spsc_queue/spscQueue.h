@@ -0,0 +1,189 @@
+/*************************************************************************
+	> File Name: spscQueue.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时04分04秒
+ ************************************************************************/
+
+#ifndef _SPSCQUEUE_H
+#define _SPSCQUEUE_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+const std::size_t spsc_cache_line = 64;    // 缓存行的字节数
+// SpscQueue: 单生产者单消费者的无锁环形队列(由queue.h中的Queue演变而来)
+/*
+ * Queue在每次入队与出队时都对data.size()取模, 存放的是shared_ptr<T>, 不是线程安全的, 满时只打印一条信息并丢弃元素.
+ * SpscQueue只允许一个线程入队(生产者)与一个线程出队(消费者), 两个线程之间不加锁:
+ *      --容量向上取为2的幂, head与tail是一直增加的计数, 下标为head & mask, 不做除法; tail - head就是元素个数,
+ *        所以所有的槽都可以使用, 不需要空出一个槽来区分满与空;
+ *      --tail只由生产者写, head只由消费者写. 生产者写入元素以后用release写tail, 消费者用acquire读tail以后才读元素;
+ *        反方向同理, 所以元素的构造与析构不会与另一个线程的访问重叠;
+ *      --每一方都缓存对方的计数(cachedHead, cachedTail): 只有按缓存的值看起来满(或空)时才重新读取对方的计数,
+ *        连续操作时几乎不读写对方的缓存行;
+ *      --head与生产者不访问的数据, tail与消费者不访问的数据分别放在不同的缓存行(中间有填充), 避免伪共享;
+ *      --元素按值放在连续的未初始化的槽中, 入队时构造, 出队时移出并析构;
+ *      --push_n/pop_n一次移动一段连续的元素(环绕时分成两段), 每批只写一次对方读取的计数.
+ * 满或空时try_push/try_pop返回false(push_n/pop_n返回实际移动的个数), 由调用者决定等待, 重试还是丢弃.
+ *
+ * 算法性能: 每个操作O(1), 不分配内存, 不加锁, 不使用CAS.
+ *
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+    //****************************构造函数*******************************
+    // capacity向上取为2的幂; capacity为0或过大时抛出std::invalid_argument
+    explicit SpscQueue(std::size_t capacity) : mask(roundUp(capacity) - 1), slots(allocate(mask + 1)),
+        head(0), cachedTail(0), tail(0), cachedHead(0) {  }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue& operator=(const SpscQueue &) = delete;
+    ~SpscQueue()
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        for (std::size_t h = head.load(std::memory_order_relaxed); h != t; ++h)
+            slot(h)->~T();
+        ::operator delete(slots);
+    }
+    //****************************成员函数*******************************
+    std::size_t capacity() const { return mask + 1; }
+    // size, empty: 另一方同时在操作时只是近似值
+    std::size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+    //*************************生产者调用*********************************
+    // try_push, try_emplace: 入队一个元素, 队列满时返回false(element不变)
+    bool try_push(const T &element) { return try_emplace(element); }
+    bool try_push(T &&element) { return try_emplace(std::move(element)); }
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == capacity()){
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == capacity())
+                return false;
+        }
+        ::new (static_cast<void *>(slot(t))) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    // push_n: 复制first开始的至多n个元素, 返回入队的个数
+    std::size_t push_n(const T *first, std::size_t n)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (capacity() - (t - cachedHead) < n)
+            cachedHead = head.load(std::memory_order_acquire);
+        std::size_t count = std::min(n, capacity() - (t - cachedHead));
+        // 从t & mask到数组末尾是第一段, 其余的从下标0开始
+        std::size_t start = t & mask, first_span = std::min(count, capacity() - start);
+        copySpan(first, slots + start, first_span);
+        copySpan(first + first_span, slots, count - first_span);
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    //*************************消费者调用*********************************
+    // try_pop: 出队一个元素并移动到element, 队列空时返回false
+    bool try_pop(T &element)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail){
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail)
+                return false;
+        }
+        T *p = slot(h);
+        element = std::move(*p);
+        p->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    // front: 队头的元素, 队列空时返回nullptr; 元素在下一次try_pop/pop_n以前有效
+    T* front()
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail){
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail)
+                return nullptr;
+        }
+        return slot(h);
+    }
+    // pop_n: 出队至多n个元素并移动到out开始的数组, 返回出队的个数
+    std::size_t pop_n(T *out, std::size_t n)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (cachedTail - h < n)
+            cachedTail = tail.load(std::memory_order_acquire);
+        std::size_t count = std::min(n, cachedTail - h);
+        std::size_t start = h & mask, first_span = std::min(count, capacity() - start);
+        moveSpan(slots + start, out, first_span);
+        moveSpan(slots, out + first_span, count - first_span);
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        if (capacity == 0 || capacity > (std::size_t(-1) >> 1) / sizeof(Slot))
+            throw std::invalid_argument("SpscQueue error: invalid capacity!");
+        std::size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        return size;
+    }
+    static Slot* allocate(std::size_t n) { return static_cast<Slot *>(::operator new(n * sizeof(Slot))); }
+    T* slot(std::size_t index) const { return reinterpret_cast<T *>(slots + (index & mask)); }
+    // copySpan, moveSpan: 连续的一段; 可平凡复制的类型直接复制字节
+    static void copySpan(const T *from, Slot *to, std::size_t n)
+    {
+        if (std::is_trivially_copyable<T>::value){
+            if (n != 0)
+                std::memcpy(static_cast<void *>(to), from, n * sizeof(T));
+            return;
+        }
+        for (std::size_t i = 0; i != n; ++i)
+            ::new (static_cast<void *>(to + i)) T(from[i]);
+    }
+    static void moveSpan(Slot *from, T *to, std::size_t n)
+    {
+        if (std::is_trivially_copyable<T>::value){
+            if (n != 0)
+                std::memcpy(static_cast<void *>(to), from, n * sizeof(T));
+            return;
+        }
+        for (std::size_t i = 0; i != n; ++i){
+            T *p = reinterpret_cast<T *>(from + i);
+            to[i] = std::move(*p);
+            p->~T();
+        }
+    }
+
+    //****************************数据结构*******************************
+    // 两方都只读的数据
+    const std::size_t mask;
+    Slot *const slots;
+    char padding0[spsc_cache_line];
+    // 消费者的缓存行: head由消费者写, 生产者在看起来满时读
+    std::atomic<std::size_t> head;
+    std::size_t cachedTail;             // 消费者最近读到的tail
+    char padding1[spsc_cache_line];
+    // 生产者的缓存行
+    std::atomic<std::size_t> tail;
+    std::size_t cachedHead;             // 生产者最近读到的head
+    char padding2[spsc_cache_line];
+};
+#endif
@@ -0,0 +1,143 @@
+/*************************************************************************
+	> File Name: spscQueue_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时06分47秒
+ ************************************************************************/
+// SpscQueue的吞吐量(单个与批量操作), 与加锁的std::deque对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [元素个数(默认50000000)] [容量(默认4096)]
+ *      --single, batch: 一个生产者线程与一个消费者线程, 用try_push/try_pop或每批64个的push_n/pop_n传递n个整数;
+ *      --same_thread_batch: 一个线程交替地push_n与pop_n, 只测量队列本身的代价(没有线程间的缓存行传递);
+ *      --mutex_deque: 一个生产者与一个消费者通过std::mutex保护的std::deque传递n个整数, 作为对比.
+ * 两个线程的吞吐量取决于能否同时运行在两个核上; 只有一个核时线程在满与空时让出(yield), 结果主要是调度的代价.
+ *
+ * 输出的每一行: queue,mode,items,capacity,mops
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "spscQueue.h"
+
+typedef std::chrono::steady_clock Clock;
+std::uint64_t bench_sink = 0;   // 出队的元素之和, 使编译器不能省略
+const std::size_t batch = 64;
+
+void report(const char *queue, const char *mode, std::uint64_t items, std::size_t capacity, Clock::time_point begin)
+{
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    std::cout << queue << ',' << mode << ',' << items << ',' << capacity << ',' << items / seconds / 1e6 << '\n';
+}
+
+void single(std::uint64_t items, std::size_t capacity)
+{
+    SpscQueue<std::uint64_t> queue(capacity);
+    auto begin = Clock::now();
+    std::thread producer([&]{
+        for (std::uint64_t i = 0; i != items; )
+            if (queue.try_push(i))
+                ++i;
+            else
+                std::this_thread::yield();
+    });
+    std::uint64_t value = 0, sum = 0;
+    for (std::uint64_t i = 0; i != items; )
+        if (queue.try_pop(value)){
+            sum += value;
+            ++i;
+        }else
+            std::this_thread::yield();
+    producer.join();
+    report("SpscQueue", "single", items, queue.capacity(), begin);
+    bench_sink += sum;
+}
+void batched(std::uint64_t items, std::size_t capacity)
+{
+    SpscQueue<std::uint64_t> queue(capacity);
+    auto begin = Clock::now();
+    std::thread producer([&]{
+        std::uint64_t values[batch];
+        for (std::uint64_t i = 0; i != items; ){
+            std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(batch, items - i));
+            for (std::size_t j = 0; j != n; ++j)
+                values[j] = i + j;
+            std::size_t done = queue.push_n(values, n);
+            // 只入队了一部分: 剩下的在下一轮重新生成
+            i += done;
+            if (done == 0)
+                std::this_thread::yield();
+        }
+    });
+    std::uint64_t values[batch], sum = 0;
+    for (std::uint64_t i = 0; i != items; ){
+        std::size_t n = queue.pop_n(values, batch);
+        for (std::size_t j = 0; j != n; ++j)
+            sum += values[j];
+        i += n;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    report("SpscQueue", "batch", items, queue.capacity(), begin);
+    bench_sink += sum;
+}
+void sameThread(std::uint64_t items, std::size_t capacity)
+{
+    SpscQueue<std::uint64_t> queue(capacity);
+    std::uint64_t values[batch], sum = 0;
+    auto begin = Clock::now();
+    for (std::uint64_t i = 0; i < items; i += batch){
+        for (std::size_t j = 0; j != batch; ++j)
+            values[j] = i + j;
+        queue.push_n(values, batch);
+        std::size_t n = queue.pop_n(values, batch);
+        for (std::size_t j = 0; j != n; ++j)
+            sum += values[j];
+    }
+    report("SpscQueue", "same_thread_batch", items, queue.capacity(), begin);
+    bench_sink += sum;
+}
+void mutexDeque(std::uint64_t items)
+{
+    std::deque<std::uint64_t> queue;
+    std::mutex lock;
+    auto begin = Clock::now();
+    std::thread producer([&]{
+        for (std::uint64_t i = 0; i != items; ++i){
+            std::lock_guard<std::mutex> guard(lock);
+            queue.push_back(i);
+        }
+    });
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i != items; ){
+        std::unique_lock<std::mutex> guard(lock);
+        if (queue.empty()){
+            guard.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        sum += queue.front();
+        queue.pop_front();
+        ++i;
+    }
+    producer.join();
+    report("mutex_deque", "single", items, 0, begin);
+    bench_sink += sum;
+}
+
+int main(int argc, char *argv[])
+{
+    std::uint64_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+    std::size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+    std::cout << "queue,mode,items,capacity,mops\n";
+    single(items, capacity);
+    batched(items, capacity);
+    sameThread(items, capacity);
+    mutexDeque(items / 10);
+    return bench_sink == 0 ? 1 : 0;
+}
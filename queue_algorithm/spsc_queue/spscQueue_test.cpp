@@ -0,0 +1,127 @@
+/*************************************************************************
+	> File Name: spscQueue_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时09分30秒
+ ************************************************************************/
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "spscQueue.h"
+using std::cout;
+using std::endl;
+
+int alive = 0;
+// Tracked: 记录存活的对象个数, 检查槽中的元素既没有泄漏也没有重复析构
+struct Tracked
+{
+    Tracked(int v = 0) : value(v), name(std::to_string(v)) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value), name(other.name) { ++alive; }
+    Tracked(Tracked &&other) : value(other.value), name(std::move(other.name)) { ++alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; name = other.name; return *this; }
+    Tracked& operator=(Tracked &&other) { value = other.value; name = std::move(other.name); return *this; }
+    ~Tracked() { --alive; }
+    int value;
+    std::string name;
+};
+
+// singleThreadTest: 先进先出, 满与空, 环绕与批量操作
+void singleThreadTest()
+{
+    bool correct = true;
+    {
+        SpscQueue<Tracked> queue(5);
+        correct = correct && queue.capacity() == 8 && queue.empty() && queue.front() == nullptr;
+        for (int i = 0; i != 8; ++i)
+            correct = correct && queue.try_push(Tracked(i));
+        correct = correct && !queue.try_push(Tracked(8)) && queue.size() == 8 && queue.front()->value == 0;
+        // 反复出队与入队, 下标多次环绕
+        int next = 0, pushed = 8;
+        for (int round = 0; round != 100; ++round){
+            Tracked t;
+            for (int i = 0; i != 3; ++i){
+                correct = correct && queue.try_pop(t) && t.value == next && t.name == std::to_string(next);
+                ++next;
+            }
+            for (int i = 0; i != 3; ++i)
+                correct = correct && queue.try_emplace(pushed++);
+        }
+        // 批量: 跨过数组末尾的两段
+        std::vector<Tracked> out(8);
+        correct = correct && queue.pop_n(out.data(), 5) == 5;
+        for (int i = 0; i != 5; ++i)
+            correct = correct && out[i].value == next++;
+        std::vector<Tracked> in;
+        for (int i = 0; i != 7; ++i)
+            in.push_back(Tracked(pushed + i));
+        correct = correct && queue.push_n(in.data(), in.size()) == 5 && queue.size() == 8;
+        pushed += 5;
+        correct = correct && queue.pop_n(out.data(), 100) == 8 && queue.pop_n(out.data(), 1) == 0;
+        for (int i = 0; i != 8; ++i)
+            correct = correct && out[i].value == next++;
+        correct = correct && next == pushed && queue.empty();
+        // 析构时还在队列中的元素
+        for (int i = 0; i != 6; ++i)
+            queue.try_push(Tracked(i));
+    }
+    try{
+        SpscQueue<int> bad(0);
+        correct = false;
+    }catch (const std::invalid_argument &){  }
+    cout << "先进先出, 满与空, 批量操作: " << (correct && alive == 0 ? "正确" : "错误") << endl;
+}
+
+// twoThreadTest: 一个线程入队, 另一个线程出队, 出队的次序与入队相同; 单个与批量的操作混合
+void twoThreadTest()
+{
+    const std::uint64_t items = 2000000;
+    SpscQueue<std::uint64_t> queue(1024);
+    std::thread producer([&]{
+        std::uint64_t next = 0;
+        std::uint64_t batch[37];
+        while (next != items){
+            if (next % 3 == 0){
+                std::size_t n = 0;
+                while (n != 37 && next + n != items){
+                    batch[n] = next + n;
+                    ++n;
+                }
+                std::size_t done = queue.push_n(batch, n);
+                next += done;
+                if (done == 0)
+                    std::this_thread::yield();
+            }else if (queue.try_push(next))
+                ++next;
+            else
+                std::this_thread::yield();
+        }
+    });
+    bool correct = true;
+    std::uint64_t expected = 0;
+    std::uint64_t batch[53];
+    while (expected != items){
+        std::size_t n = 0;
+        if (expected % 2 == 0)
+            n = queue.pop_n(batch, 53);
+        else if (queue.try_pop(batch[0]))
+            n = 1;
+        for (std::size_t i = 0; i != n; ++i)
+            correct = correct && batch[i] == expected++;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    correct = correct && queue.empty();
+    cout << "两个线程之间传递" << items << "个元素: " << (correct ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************SpscQueue的测试********************\n";
+    singleThreadTest();
+    twoThreadTest();
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*************************************************************************
+	> File Name: topK.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 18时36分52秒
+ ************************************************************************/
+
+#ifndef _TOPK_H
+#define _TOPK_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../../sort_algorithm/heap_sort/heapSort.h"
+// TopK: 在数据流中保留最大的K个元素  算法导论6.5
+/*
+ * 用一个容量为K的最小堆(按值存放在std::array中, 不分配内存)保存目前最大的K个元素, 堆顶是其中最小的一个:
+ *      --堆未满时直接插入;
+ *      --堆满以后新元素只和堆顶比较一次, 不大于堆顶时直接丢弃(数据流很长时绝大多数元素都是这种情况),
+ *        否则替换堆顶并下沉.
+ * 多个线程各自使用一个TopK, 最后用merge合并.
+ *
+ * "最大"由compare决定: compare为std::less<T>时保留最大的K个, 为std::greater<T>时保留最小的K个.
+ *
+ * 算法性能: 每个元素最坏O(logK), 丢弃时O(1); 空间为O(K).
+ *
+ */
+template<typename T, std::size_t K, typename CompareType = std::less<T>>
+class TopK
+{
+public:
+    static_assert(K > 0, "K must be positive!");
+    //****************************构造函数*******************************
+    explicit TopK(CompareType c = CompareType()): count(0), compare(c) {  }
+    //****************************成员函数*******************************
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == K; }
+    void clear() { count = 0; }
+
+    // threshold: 目前保留的元素中最小的一个(新元素必须大于它才会被保留), 调用者保证非空
+    const T& threshold() const { return heap[0]; }
+
+    // push: 加入一个候选元素
+    /*
+     * \parameter value: 候选元素;
+     * \return 是否被保留.
+     *
+     */
+    bool push(const T &value)
+    {
+        if (count < K){
+            siftUp(count++, value);
+            return true;
+        }
+        if (!compare(heap[0], value))
+            return false;
+        siftDown(0, value);
+        return true;
+    }
+
+    // push: 批量加入[begin, end)中的候选元素
+    template<typename Iterator>
+    void push(Iterator begin, Iterator end)
+    {
+        for (; begin != end && count < K; ++begin)
+            siftUp(count++, *begin);
+        for (; begin != end; ++begin){
+            if (compare(heap[0], *begin))
+                siftDown(0, *begin);
+        }
+    }
+
+    // merge: 合并另一个TopK保留的元素
+    void merge(const TopK &other)
+    {
+        push(other.heap.begin(), other.heap.begin() + other.count);
+    }
+
+    // result: 按从大到小的次序返回保留的元素
+    std::vector<T> result() const
+    {
+        std::vector<T> values(heap.begin(), heap.begin() + count);
+        DaryHeapSort<typename std::vector<T>::iterator, ReverseCompare> sorter;
+        sorter(values.begin(), values.end(), ReverseCompare{compare});
+        return values;
+    }
+private:
+    struct ReverseCompare
+    {
+        CompareType compare;
+        bool operator() (const T &a, const T &b) { return compare(b, a); }
+    };
+    //****************************数据结构*******************************
+    std::array<T, K> heap;      // 最小堆, heap[0]是保留的元素中最小的一个
+    std::size_t count;
+    CompareType compare;
+
+    // siftUp: 在位置hole放入value并上浮
+    void siftUp(std::size_t hole, const T &value)
+    {
+        while (hole > 0){
+            std::size_t parent = (hole - 1) / 2;
+            if (!compare(value, heap[parent]))
+                break;
+            heap[hole] = std::move(heap[parent]);
+            hole = parent;
+        }
+        heap[hole] = value;
+    }
+
+    // siftDown: 在位置hole放入value并下沉
+    void siftDown(std::size_t hole, const T &value)
+    {
+        while (2 * hole + 1 < count){
+            std::size_t child = 2 * hole + 1;
+            if (child + 1 < count && compare(heap[child + 1], heap[child]))
+                ++child;
+            if (!compare(heap[child], value))
+                break;
+            heap[hole] = std::move(heap[child]);
+            hole = child;
+        }
+        heap[hole] = value;
+    }
+};
+#endif
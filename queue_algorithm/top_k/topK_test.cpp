@@ -0,0 +1,92 @@
+/*************************************************************************
+	> File Name: topK_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 19时02分18秒
+ ************************************************************************/
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+using std::sort;
+#include <functional>
+#include <random>
+#include "topK.h"
+
+// 数组输出函数
+template<typename Iterator>
+void print(const Iterator begin, const Iterator end)
+{
+    for (auto current = begin; current != end; ++current)
+        cout << *current << " ";
+    cout << endl;
+}
+
+void pushTest()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-1000000, 1000000);
+    vector<int> data(1000000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end(), std::greater<int>());
+
+    TopK<int, 100> top;
+    for (auto x : data)
+        top.push(x);
+    vector<int> result = top.result();
+    cout << "逐个加入, 最大的100个元素: "
+         << (std::equal(result.begin(), result.end(), compareData.begin()) ? "正确" : "错误") << endl;
+
+    TopK<int, 100> batch;
+    batch.push(data.begin(), data.end());
+    cout << "批量加入: " << (batch.result() == result ? "正确" : "错误") << endl;
+
+    TopK<int, 5, std::greater<int>> smallest;
+    smallest.push(data.begin(), data.end());
+    vector<int> least = smallest.result();
+    cout << "最小的5个元素: ";
+    print(least.begin(), least.end());
+    cout << "函数库sort结果: ";
+    print(compareData.rbegin(), compareData.rbegin() + 5);
+}
+
+void mergeTest()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100000);
+    vector<int> data(400000);
+    for (auto &x : data)
+        x = u(e);
+    // 模拟4个线程各自统计一段, 再合并
+    TopK<int, 10> parts[4];
+    for (std::size_t i = 0; i != data.size(); ++i)
+        parts[i % 4].push(data[i]);
+    TopK<int, 10> total;
+    for (auto &part : parts)
+        total.merge(part);
+    sort(data.begin(), data.end(), std::greater<int>());
+    vector<int> result = total.result();
+    cout << "合并4个TopK: " << (std::equal(result.begin(), result.end(), data.begin()) ? "正确" : "错误") << endl;
+
+    TopK<int, 10> few;
+    few.push(3);
+    few.push(1);
+    few.push(2);
+    vector<int> three = few.result();
+    cout << "元素个数不足K个: ";
+    print(three.begin(), three.end());
+}
+
+int main()
+{
+    cout << "****************TopK加入测试***************************\n";
+    pushTest();
+
+    cout << "****************TopK合并测试***************************\n";
+    mergeTest();
+
+    return 0;
+}
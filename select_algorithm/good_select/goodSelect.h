@@ -11,34 +11,10 @@
 #include <cassert>
 #include <vector>
 #include <utility>
-// insertSort: 插入排序  算法导论2.1
-/*
- * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
- * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
- * \parameter compare: 一个可调用对象,可用于比较两个对象的小于比较,默认为std::less<T>;
- * \return void.
- *
- * 算法性能: O(N^2), 原址排序.
- * 算法基本思想: 插入排序是对少量元素的排序,它是一个有效的算法.假设数组A[1,...,n]排序:
- *               设当前排序元素是A[i],则A[1,...,i-1]是排序好的,A[i]在A[1,...,i-1]中找
- *               到它的位置,然后插入其中.
- *
- */
-template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
-void insertSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
-{
-    auto size = std::distance(begin, end);
-    assert(size > 0);
-    for (auto current = begin; current != end; ++current){
-        auto smallNext = current;       // 指向比*current小的元素中,最大的那一个
-        auto key = *current;
-        while (smallNext != begin && compare(key, *(smallNext - 1))){
-            *smallNext = *(smallNext - 1);  // 后移
-            --smallNext;
-        }
-        *smallNext = key;
-    }
-}
+#include "../../sort_algorithm/quick_sort/partitionPolicy.h"
+#include "../../sort_algorithm/sorting_network/sortingNetwork.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+#include "medianOfMedians.h"
 // partition: 快速排序算法中的划分算法  算法导论7.1 随机化版本在7.3
 /*
  * \parameter begin: 待划分序列的起始迭代器(也可以是指向数组中某元素的指针);
@@ -64,13 +40,13 @@ Iterator partition(const Iterator begin, const Iterator end,
 {
     assert(std::distance(begin, partitioned_iter) >= 0 && std::distance(partitioned_iter, end) > 0 
            && std::distance(begin, end) > 0);
-    std::swap(*partitioned_iter, *(end - 1));   // 把待定主元交换到序列最后一个元素
+    std::iter_swap(partitioned_iter, end - 1);   // 把待定主元交换到序列最后一个元素
     auto i = begin;
     for (auto current = begin; current != (end - 1); ++current){
         if (compare(*current, *(end - 1)))
-            std::swap(*i++, *current);
+            std::iter_swap(i++, current);
     }
-    std::swap(*i, *(end - 1));
+    std::iter_swap(i, end - 1);
 
     return i;
 }
@@ -80,11 +56,12 @@ Iterator partition(const Iterator begin, const Iterator end,
  * \parameter end: 待选择序列的终止迭代器(也可以是指向数组中某元素的指针);
  * \parameter rank: 指定选取的顺序数,0为最小,1为次小,...依次类推;
  * \parameter compare: 一个可调用对象,可以用于对两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为LomutoPartition;
  * \return 第rank小的元素.
  *
  * 算法基本思想: 
  *      --1.将输入数组的n个元素划分为n/5组,每组5个元素,且最多只有一组由剩下的n%5个元素组成;
- *      --2.寻找这n/5组中每一组的中位数: 首先对每组元素进行插入排序,然后确定每组有序元素的中位数;
+ *      --2.寻找这n/5组中每一组的中位数: 首先对每组元素进行排序(smallSort),然后确定每组有序元素的中位数;
  *      --3.对第2步中找出的这n/5个中位数,递归调用goodSelsct以找出其中位数x(如果有偶数个中位数,为了方便,约定x是较小的中位数);
  *      --4.利用修改过的partition版本,按中位数的中位数x对输入数组进行划分.让k比划分的低区中的元素数目多1,
  *          因此x是第k小的元素,并且有n-k个元素在划分的高区;
@@ -93,10 +70,12 @@ Iterator partition(const Iterator begin, const Iterator end,
  * 算法性能: 最坏情况下运行时间为O(N), 非原地操作.
  *
  */
-template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = LomutoPartition>
 typename std::iterator_traits<Iterator>::value_type
 goodSelect(const Iterator begin, const Iterator end, 
-           typename std::iterator_traits<Iterator>::difference_type rank, CompareType compare = CompareType())
+           typename std::iterator_traits<Iterator>::difference_type rank, CompareType compare = CompareType(),
+           PartitionPolicy policy = PartitionPolicy())
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;
     auto size = std::distance(begin, end);
@@ -113,25 +92,76 @@ goodSelect(const Iterator begin, const Iterator end,
         auto to = from + 5;
         if (to > end)
             to = end;
-        insertSort(from, to, compare);
+        smallSort(from, to, compare);     // 算术类型用排序网络, 其余用插入排序
         middle_nums.push_back(*(from+(to-from-1)/2));
         iter += 5;
     }
     // 取出这些中值的中值
-    T mid_of_middles = goodSelect(middle_nums.begin(), middle_nums.end(), middle_nums.size()/2, compare); // 所有中值的中值
+    T mid_of_middles = goodSelect(middle_nums.begin(), middle_nums.end(), middle_nums.size()/2, compare, policy); // 所有中值的中值
     iter = begin;
     while (std::distance(iter, end) > 0 && *iter != mid_of_middles)     // 得到中值的中值在原序列中的位置
         iter++;
     // 划分
-    auto mid_of_middles_iter = partition(begin, end, iter, compare);    // 以中值的中值作为一个划分值
+    auto equal_range = policy(begin, end, iter, compare);    // 以中值的中值作为一个划分值
     // 判别
-    auto mid_of_middles_rank = std::distance(begin, mid_of_middles_iter);   // 中值的中值在划分之后的排序
-    if (mid_of_middles_rank == rank)    // 找到了该排位的数
-        return *mid_of_middles_iter;
-    else if (mid_of_middles_rank < rank) // 已知某排位的数位较低,则指定排位数的元素在它的右侧
-        // mid_of_middles_iter + 1,则找右侧的第rank-mid_of_middles_rank-1位
-        return goodSelect(mid_of_middles_iter + 1, end, rank - mid_of_middles_rank - 1, compare);
+    auto equal_first = std::distance(begin, equal_range.first);     // 等于中值的中值的元素在划分之后的排序
+    auto equal_last = std::distance(begin, equal_range.second);
+    if (equal_first <= rank && rank < equal_last)   // 找到了该排位的数
+        return *equal_range.first;
+    else if (equal_last <= rank) // 已知某排位的数位较低,则指定排位数的元素在它的右侧
+        // 右侧序列从equal_range.second开始,则找右侧的第rank-equal_last位
+        return goodSelect(equal_range.second, end, rank - equal_last, compare, policy);
     else
-        return goodSelect(begin, mid_of_middles_iter, rank, compare);    
+        return goodSelect(begin, equal_range.first, rank, compare, policy);
+}
+
+// goodSelect: 按执行策略的最坏情况线性时间选择算法
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_select_threshold;
+ * \parameter begin: 待选择序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待选择序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter rank: 指定选取的顺序数,0为最小,1为次小,...依次类推;
+ * \parameter compare: 一个可调用对象,可以用于对两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 区间变短以后串行的goodSelect使用的划分策略, 默认为LomutoPartition;
+ * \return 第rank小的元素.
+ *
+ * 串行策略或序列长度小于exec.grain(parallel_select_threshold)时调用goodSelect. 否则由parallelSelectLoop
+ * 并行划分, 每一轮的主元为中值的中值: 各段并行地用排序网络排好自己的5个元素一组并取出中位数,
+ * 再按同一个策略递归选出这些中位数的中位数. 最坏情况下运行时间为O(N), 额外空间为O(N).
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = LomutoPartition>
+typename std::iterator_traits<Iterator>::value_type
+goodSelect(const ExecutionPolicy &exec, const Iterator begin, const Iterator end,
+           typename std::iterator_traits<Iterator>::difference_type rank, CompareType compare = CompareType(),
+           PartitionPolicy policy = PartitionPolicy())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef typename std::iterator_traits<Iterator>::difference_type Difference;
+    assert(0 <= rank && rank < std::distance(begin, end));
+    auto medianOfMedians = [&](Iterator first, Iterator last) -> T {
+        const std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+        const std::size_t groups = (size + 4) / 5;
+        const std::size_t chunks = exec.threads();
+        const std::size_t per_chunk = (groups + chunks - 1) / chunks;
+        std::vector<T> medians(groups);
+        parallelFor(exec, chunks, [&](std::size_t c){
+            for (std::size_t g = c * per_chunk; g < std::min(groups, (c + 1) * per_chunk); ++g){
+                Iterator group = first + g * 5;
+                std::size_t count = std::min<std::size_t>(5, size - g * 5);
+                if (count == 5)
+                    sortFive(group, compare);
+                else
+                    smallSort(group, group + count, compare);
+                medians[g] = *(group + (count - 1) / 2);
+            }
+        });
+        return goodSelect(exec, medians.begin(), medians.end(), groups / 2, compare, policy);
+    };
+    auto finish = [&](Iterator first, Iterator last, std::size_t r) -> T {
+        return goodSelect(first, last, static_cast<Difference>(r), compare, policy);
+    };
+    return parallelSelectLoop(exec, begin, end, static_cast<std::size_t>(rank), compare, medianOfMedians, finish);
 }
 #endif
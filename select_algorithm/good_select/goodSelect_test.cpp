@@ -10,6 +10,8 @@ using std::cout;    using std::endl;
 using std::vector;
 #include <iterator>
 using std::begin;   using std::end;
+#include <algorithm>
+#include <random>
 #include "goodSelect.h"
 
 bool compare(int num1, int num2)
@@ -140,6 +142,115 @@ void Test4()
     cout << "的最大值为: " << min << endl;
 }
 
+// 不同划分策略下的选择结果与std::nth_element比较
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100000);
+    std::uniform_int_distribution<int> few(0, 3);
+    vector<int> random(5000), duplicates(5000);
+    for (std::size_t i = 0; i != random.size(); ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+    }
+    vector<vector<int>> inputs{random, duplicates};
+    const char *names[] = {"随机序列", "大量重复元素"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        bool lomuto = true, block = true, threeWay = true;
+        for (std::size_t rank = 0; rank < inputs[k].size(); rank += 499){
+            vector<int> expected(inputs[k]);
+            std::nth_element(expected.begin(), expected.begin() + rank, expected.end());
+            vector<int> data1(inputs[k]), data2(inputs[k]), data3(inputs[k]);
+            lomuto = lomuto && goodSelect(data1.begin(), data1.end(), rank, std::less<int>(), LomutoPartition()) == expected[rank];
+            block = block && goodSelect(data2.begin(), data2.end(), rank, std::less<int>(), BlockPartition()) == expected[rank];
+            threeWay = threeWay && goodSelect(data3.begin(), data3.end(), rank, std::less<int>(), ThreeWayPartition()) == expected[rank];
+        }
+        cout << names[k] << ": LomutoPartition " << (lomuto ? "正确" : "错误")
+             << ", BlockPartition " << (block ? "正确" : "错误")
+             << ", ThreeWayPartition " << (threeWay ? "正确" : "错误") << endl;
+    }
+}
+
+// 用0-1原理检验5元素排序网络: 对所有32个0-1序列都能排好即可排好任意序列
+bool checkSortFive()
+{
+    std::less<int> less;
+    for (int mask = 0; mask != 32; ++mask){
+        int bits[5];
+        for (int i = 0; i != 5; ++i)
+            bits[i] = (mask >> i) & 1;
+        sortFive(bits, less);
+        if (!std::is_sorted(bits, bits + 5))
+            return false;
+    }
+    return true;
+}
+
+void Test6()
+{
+    cout << "5元素排序网络: " << (checkSortFive() ? "正确" : "错误") << endl;
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100000);
+    std::uniform_int_distribution<int> few(0, 3);
+    const std::size_t size = 20000;
+    vector<int> random(size), duplicates(size), sorted(size);
+    for (std::size_t i = 0; i != size; ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+        sorted[i] = static_cast<int>(i);
+    }
+    vector<vector<int>> inputs{random, duplicates, sorted};
+    const char *names[] = {"随机序列", "大量重复元素", "有序序列"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        bool right = true;
+        vector<int> expected(inputs[k]);
+        std::sort(expected.begin(), expected.end());
+        for (std::size_t rank = 0; rank < size; rank += 1999){
+            vector<int> data1(inputs[k]), data2(inputs[k]);
+            int value = goodSelectInPlace(data1.begin(), data1.end(), rank);
+            right = right && value == expected[rank] && data1[rank] == value
+                    && std::all_of(data1.begin(), data1.begin() + rank, [value](int x){ return x <= value; })
+                    && std::all_of(data1.begin() + rank, data1.end(), [value](int x){ return x >= value; });
+            right = right && goodSelectInPlace(data2.begin(), data2.end(), rank, std::greater<int>(), ThreeWayPartition())
+                             == expected[size - 1 - rank];
+        }
+        cout << names[k] << ": " << (right ? "正确" : "错误") << endl;
+    }
+}
+
+void Test7()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000000), few(0, 15);
+    const std::size_t size = 100000;
+    vector<int> random(size), fewUnique(size);
+    for (std::size_t i = 0; i != size; ++i){
+        random[i] = u(e);
+        fewUnique[i] = few(e);
+    }
+    vector<vector<int>> inputs{random, fewUnique};
+    const char *names[] = {"随机序列", "只有16个不同的值"};
+    const ExecutionPolicy policies[] = {execution::seq, execution::par.withThreads(4).withGrain(1000),
+                                        execution::par_unseq.withThreads(3).withGrain(5000)};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        vector<int> expected(inputs[k]);
+        sort(expected.begin(), expected.end());
+        bool right = true;
+        for (const ExecutionPolicy &policy : policies){
+            for (std::size_t rank : {std::size_t(0), size / 3, size / 2, size - 1}){
+                vector<int> data1(inputs[k]), data2(inputs[k]);
+                // LomutoPartition在重复元素很多时退化, 串行的部分统一使用ThreeWayPartition
+                right = right && goodSelect(policy, data1.begin(), data1.end(), rank, std::less<int>(), ThreeWayPartition())
+                                 == expected[rank];
+                right = right && goodSelect(policy, data2.begin(), data2.end(), rank, std::greater<int>(), ThreeWayPartition())
+                                 == expected[size - 1 - rank];
+                sort(data1.begin(), data1.end());
+                right = right && data1 == expected;     // 选择只重排序列中的元素
+            }
+        }
+        cout << names[k] << "(seq, par, par_unseq): " << (right ? "正确" : "错误") << endl;
+    }
+}
 
 int main()
 {
@@ -151,6 +262,12 @@ int main()
     Test3();
     cout << "*************C整型数组求最大值*************" << endl;
     Test4();
-    
+    cout << "*************不同划分策略的选择测试***********" << endl;
+    Test5();
+    cout << "*************原址的中位数的中位数选择*********" << endl;
+    Test6();
+    cout << "*************执行策略测试*******************" << endl;
+    Test7();
+
     return 0;
 }
@@ -0,0 +1,216 @@
+/*************************************************************************
+	> File Name: medianOfMedians.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 13时02分41秒
+ ************************************************************************/
+
+#ifndef _MEDIANOFMEDIANS_H
+#define _MEDIANOFMEDIANS_H
+
+// medianOfMedians.h: 原址的中值的中值选择(goodSelectInPlace)与按执行策略的三路划分选择(parallelSelectLoop)
+/*
+ * 从goodSelect.h中分出, 不定义partition, introSelect等只需要兜底的选择算法时包含这个头文件,
+ * 不会与quickSort.h中同名的partition重定义.
+ *
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../../sort_algorithm/quick_sort/partitionPolicy.h"
+#include "../../sort_algorithm/sorting_network/sortingNetwork.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+
+// compareExchange: 若*b < *a则交换, 排序网络的基本操作
+template<typename Iterator, typename CompareType>
+inline void compareExchange(Iterator a, Iterator b, CompareType &compare)
+{
+    if (compare(*b, *a))
+        std::iter_swap(a, b);
+}
+
+// sortFive: 用9次比较交换的排序网络对first开始的5个元素排序
+/*
+ * 网络的比较次序固定, 与数据无关: (0,3)(1,4) (0,2)(1,3) (0,1)(2,4) (1,2)(3,4) (2,3).
+ *
+ */
+template<typename Iterator, typename CompareType>
+void sortFive(Iterator first, CompareType &compare)
+{
+    compareExchange(first + 0, first + 3, compare);
+    compareExchange(first + 1, first + 4, compare);
+    compareExchange(first + 0, first + 2, compare);
+    compareExchange(first + 1, first + 3, compare);
+    compareExchange(first + 0, first + 1, compare);
+    compareExchange(first + 2, first + 4, compare);
+    compareExchange(first + 1, first + 2, compare);
+    compareExchange(first + 3, first + 4, compare);
+    compareExchange(first + 2, first + 3, compare);
+}
+
+const std::ptrdiff_t good_select_small = 16;    // 不超过该长度的区间直接排序
+
+// goodSelectLoop: goodSelectInPlace的主循环, 结束时*(begin + rank)为第rank小的元素
+template<typename Iterator, typename CompareType, typename PartitionPolicy>
+void goodSelectLoop(Iterator begin, Iterator end, std::ptrdiff_t rank, CompareType &compare, PartitionPolicy &policy)
+{
+    while (std::distance(begin, end) > good_select_small){
+        std::ptrdiff_t size = std::distance(begin, end);
+        // 每组5个元素用排序网络排序, 中位数依次交换到序列的最前面
+        std::ptrdiff_t groups = 0;
+        for (std::ptrdiff_t from = 0; from < size; from += 5, ++groups){
+            Iterator group = begin + from;
+            std::ptrdiff_t count = std::min<std::ptrdiff_t>(5, size - from);
+            if (count == 5)
+                sortFive(group, compare);
+            else
+                insertSort(group, group + count, compare);
+            std::iter_swap(begin + groups, group + (count - 1) / 2);
+        }
+        // 在中位数组成的前缀中递归选出中位数的中位数, 它的位置就是主元的位置
+        Iterator pivot = begin + (groups - 1) / 2;
+        goodSelectLoop(begin, begin + groups, (groups - 1) / 2, compare, policy);
+        auto equal_range = policy(begin, end, pivot, compare);
+        std::ptrdiff_t equal_first = std::distance(begin, equal_range.first);
+        std::ptrdiff_t equal_last = std::distance(begin, equal_range.second);
+        if (equal_first <= rank && rank < equal_last)
+            return;
+        if (rank < equal_first){
+            end = equal_range.first;
+        }else{
+            begin = equal_range.second;
+            rank -= equal_last;
+        }
+    }
+    smallSort(begin, end, compare);
+}
+
+// goodSelectInPlace: 原址, 不分配内存的最坏情况线性时间选择算法  算法导论9.3
+/*
+ * \parameter begin: 待选择序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待选择序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter rank: 指定选取的顺序数,0为最小,1为次小,...依次类推;
+ * \parameter compare: 一个可调用对象,可以用于对两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为BlockPartition(与主元相等的元素均匀地分到两侧,
+ *                    大量重复元素时也能保证线性时间; LomutoPartition在这种输入上会退化);
+ * \return 第rank小的元素.
+ *
+ * 与goodSelect的算法相同, 区别在于:
+ *      --每组5个元素用固定的排序网络排序(9次比较);
+ *      --各组的中位数交换到序列的前n/5个位置, 直接在这个前缀上递归选择中位数的中位数, 不再放入新的std::vector;
+ *      --中位数的中位数的位置在递归返回时就已知(前缀的中间位置), 不需要再扫描序列查找它, 也不需要operator!=;
+ *      --在主元的一侧继续选择时用循环代替递归.
+ * 返回时序列满足std::nth_element的性质.
+ *
+ * 算法性能: 最坏情况下运行时间为O(N), 原址操作, 不分配内存.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = BlockPartition>
+typename std::iterator_traits<Iterator>::value_type
+goodSelectInPlace(const Iterator begin, const Iterator end,
+                  typename std::iterator_traits<Iterator>::difference_type rank, CompareType compare = CompareType(),
+                  PartitionPolicy policy = PartitionPolicy())
+{
+    assert(0 <= rank && rank < std::distance(begin, end));
+    goodSelectLoop(begin, end, rank, compare, policy);
+    return *(begin + rank);
+}
+
+const std::size_t parallel_select_threshold = std::size_t(1) << 18;    // 不小于该长度的区间并行划分
+
+// parallelSelectLoop: 按执行策略的三路划分选择, randomiezdSelect与goodSelect的策略版本共用
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_select_threshold;
+ * \parameter first, last: 待选择的区间;
+ * \parameter rank: 选取的顺序数, 0为最小;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于, 多个任务会同时调用它;
+ * \parameter pivot: pivot(first, last)返回本轮划分的主元(一个值);
+ * \parameter finish: finish(first, last, rank)在不再并行的区间上用串行算法完成选择;
+ * \return 第rank小的元素.
+ *
+ * 区间不短于exec.grain(parallel_select_threshold)时, 每一轮:
+ *      --区间均分为exec.threads()段, 各段并行地统计小于, 等于主元的元素个数;
+ *      --前缀和得到每一段的三类元素在辅助数组中的写入位置(小于主元的在前, 等于的居中, 大于的在后),
+ *        各段并行地把元素移动过去, 再并行地移回原区间;
+ *      --rank落在与主元相等的部分时直接返回, 否则只在rank所在的一侧继续.
+ * 与主元相等的元素单独成为一部分, 所以重复元素很多时区间也会迅速缩短. 额外空间为O(N).
+ *
+ */
+template<typename Iterator, typename CompareType, typename Pivot, typename Finish>
+typename std::iterator_traits<Iterator>::value_type
+parallelSelectLoop(const ExecutionPolicy &exec, Iterator first, Iterator last, std::size_t rank,
+                   CompareType &compare, Pivot pivot, Finish finish)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    std::vector<T> buffer;
+    while (exec.runParallel(static_cast<std::size_t>(std::distance(first, last)), parallel_select_threshold)){
+        const std::size_t size = static_cast<std::size_t>(std::distance(first, last));
+        const std::size_t chunks = exec.threads();
+        const std::size_t chunk_size = (size + chunks - 1) / chunks;
+        const T x = pivot(first, last);
+        std::vector<std::size_t> less(chunks), equal(chunks);
+        parallelFor(exec, chunks, [&](std::size_t c){
+            std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+            std::size_t l = 0, e = 0;
+            for (Iterator current = first + from; current != first + to; ++current){
+                if (compare(*current, x))
+                    ++l;
+                else if (!compare(x, *current))
+                    ++e;
+            }
+            less[c] = l;
+            equal[c] = e;
+        });
+        std::size_t smaller = 0, not_greater = 0;
+        for (std::size_t c = 0; c != chunks; ++c){
+            smaller += less[c];
+            not_greater += equal[c];
+        }
+        not_greater += smaller;
+        // 每一段三类元素的写入位置
+        std::vector<std::size_t> less_at(chunks), equal_at(chunks), greater_at(chunks);
+        std::size_t l = 0, e = smaller, g = not_greater;
+        for (std::size_t c = 0; c != chunks; ++c){
+            std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+            less_at[c] = l;
+            equal_at[c] = e;
+            greater_at[c] = g;
+            l += less[c];
+            e += equal[c];
+            g += (to - from) - less[c] - equal[c];
+        }
+        if (buffer.size() < size)
+            buffer.resize(size);
+        parallelFor(exec, chunks, [&](std::size_t c){
+            std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+            std::size_t li = less_at[c], ei = equal_at[c], gi = greater_at[c];
+            for (Iterator current = first + from; current != first + to; ++current){
+                if (compare(*current, x))
+                    buffer[li++] = std::move(*current);
+                else if (!compare(x, *current))
+                    buffer[ei++] = std::move(*current);
+                else
+                    buffer[gi++] = std::move(*current);
+            }
+        });
+        parallelFor(exec, chunks, [&](std::size_t c){
+            std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+            std::move(buffer.begin() + from, buffer.begin() + to, first + from);
+        });
+        if (smaller <= rank && rank < not_greater)
+            return *(first + smaller);
+        if (rank < smaller){
+            last = first + smaller;
+        }else{
+            first = first + not_greater;
+            rank -= not_greater;
+        }
+    }
+    return finish(first, last, rank);
+}
+#endif
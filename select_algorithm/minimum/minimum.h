@@ -1,23 +1,299 @@
 /*************************************************************************
 	> File Name: minimum.h
-	> Author: ZhirunZheng 
-	> Mail: jiangxizhengzhirun@163.com 
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
 	> Created Time: 2018年11月11日 星期日 10时59分55秒
  ************************************************************************/
 
 #ifndef _MINIMUM_H
 #define _MINIMUM_H
 #include <functional>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "../../sort_algorithm/sorting_network/sortingNetwork.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+
+const std::size_t minmax_lanes = 32;                                  // 向量化路径中独立累加器的个数
+const std::size_t minmax_parallel_threshold = std::size_t(1) << 20;    // 不小于该长度的序列才使用多线程
+
+// UseSimdMinMax: 编译时决定是否使用向量化路径
+/*
+ * 元素必须是算术类型, 比较函数必须是std::less<T>或std::greater<T>, 迭代器必须连续存放元素.
+ * 向量化路径假设浮点数中没有NaN; 有NaN时结果不确定, 但argmin/argmax/argMinMax的查找不会越过end
+ * (找不到等于最值的元素时改用标量路径).
+ *
+ */
+template<typename Iterator, typename CompareType>
+struct UseSimdMinMax
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    static const bool reversed = std::is_same<CompareType, std::greater<T>>::value;
+    static const bool value = std::is_arithmetic<T>::value && IsContiguousIterator<Iterator>::value
+                              && (std::is_same<CompareType, std::less<T>>::value || reversed);
+};
+
+// simdMinMax: 连续数组中按operator<的最小值和最大值(size > 0)
+/*
+ * minmax_lanes个互相独立的累加器同时更新, 比较用无分支的选择实现, 编译器可以把内层循环向量化,
+ * 而且多个累加器掩盖了min/max指令的延迟.
+ *
+ */
+template<typename T>
+std::pair<T, T> simdMinMax(const T *data, std::size_t size)
+{
+    T low = data[0], high = data[0];
+    std::size_t i = 0;
+    if (size >= 2 * minmax_lanes){
+        T lows[minmax_lanes], highs[minmax_lanes];
+        for (std::size_t j = 0; j != minmax_lanes; ++j)
+            lows[j] = highs[j] = data[j];
+        for (i = minmax_lanes; i + minmax_lanes <= size; i += minmax_lanes){
+            for (std::size_t j = 0; j != minmax_lanes; ++j){
+                T x = data[i + j];
+                lows[j] = x < lows[j] ? x : lows[j];
+                highs[j] = highs[j] < x ? x : highs[j];
+            }
+        }
+        for (std::size_t j = 0; j != minmax_lanes; ++j){
+            low = lows[j] < low ? lows[j] : low;
+            high = high < highs[j] ? highs[j] : high;
+        }
+    }
+    for (; i != size; ++i){
+        low = data[i] < low ? data[i] : low;
+        high = high < data[i] ? data[i] : high;
+    }
+    return std::make_pair(low, high);
+}
+
+#if defined(__AVX2__)
+// 4组256位累加器, 每次处理4个向量
+inline std::pair<std::int32_t, std::int32_t> simdMinMax(const std::int32_t *data, std::size_t size)
+{
+    if (size < 32)
+        return simdMinMax<std::int32_t>(data, size);
+    __m256i low[4], high[4];
+    for (int j = 0; j != 4; ++j)
+        low[j] = high[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 8 * j));
+    std::size_t i = 32;
+    for (; i + 32 <= size; i += 32){
+        for (int j = 0; j != 4; ++j){
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 8 * j));
+            low[j] = _mm256_min_epi32(low[j], x);
+            high[j] = _mm256_max_epi32(high[j], x);
+        }
+    }
+    low[0] = _mm256_min_epi32(_mm256_min_epi32(low[0], low[1]), _mm256_min_epi32(low[2], low[3]));
+    high[0] = _mm256_max_epi32(_mm256_max_epi32(high[0], high[1]), _mm256_max_epi32(high[2], high[3]));
+    std::int32_t lows[8], highs[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lows), low[0]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(highs), high[0]);
+    std::pair<std::int32_t, std::int32_t> result = simdMinMax<std::int32_t>(lows, 8);
+    result.second = simdMinMax<std::int32_t>(highs, 8).second;
+    if (i != size){
+        std::pair<std::int32_t, std::int32_t> tail = simdMinMax<std::int32_t>(data + i, size - i);
+        result.first = tail.first < result.first ? tail.first : result.first;
+        result.second = result.second < tail.second ? tail.second : result.second;
+    }
+    return result;
+}
+inline std::pair<float, float> simdMinMax(const float *data, std::size_t size)
+{
+    if (size < 32)
+        return simdMinMax<float>(data, size);
+    __m256 low[4], high[4];
+    for (int j = 0; j != 4; ++j)
+        low[j] = high[j] = _mm256_loadu_ps(data + 8 * j);
+    std::size_t i = 32;
+    for (; i + 32 <= size; i += 32){
+        for (int j = 0; j != 4; ++j){
+            __m256 x = _mm256_loadu_ps(data + i + 8 * j);
+            low[j] = _mm256_min_ps(low[j], x);
+            high[j] = _mm256_max_ps(high[j], x);
+        }
+    }
+    low[0] = _mm256_min_ps(_mm256_min_ps(low[0], low[1]), _mm256_min_ps(low[2], low[3]));
+    high[0] = _mm256_max_ps(_mm256_max_ps(high[0], high[1]), _mm256_max_ps(high[2], high[3]));
+    float lows[8], highs[8];
+    _mm256_storeu_ps(lows, low[0]);
+    _mm256_storeu_ps(highs, high[0]);
+    std::pair<float, float> result = simdMinMax<float>(lows, 8);
+    result.second = simdMinMax<float>(highs, 8).second;
+    if (i != size){
+        std::pair<float, float> tail = simdMinMax<float>(data + i, size - i);
+        result.first = tail.first < result.first ? tail.first : result.first;
+        result.second = result.second < tail.second ? tail.second : result.second;
+    }
+    return result;
+}
+inline std::pair<double, double> simdMinMax(const double *data, std::size_t size)
+{
+    if (size < 16)
+        return simdMinMax<double>(data, size);
+    __m256d low[4], high[4];
+    for (int j = 0; j != 4; ++j)
+        low[j] = high[j] = _mm256_loadu_pd(data + 4 * j);
+    std::size_t i = 16;
+    for (; i + 16 <= size; i += 16){
+        for (int j = 0; j != 4; ++j){
+            __m256d x = _mm256_loadu_pd(data + i + 4 * j);
+            low[j] = _mm256_min_pd(low[j], x);
+            high[j] = _mm256_max_pd(high[j], x);
+        }
+    }
+    low[0] = _mm256_min_pd(_mm256_min_pd(low[0], low[1]), _mm256_min_pd(low[2], low[3]));
+    high[0] = _mm256_max_pd(_mm256_max_pd(high[0], high[1]), _mm256_max_pd(high[2], high[3]));
+    double lows[4], highs[4];
+    _mm256_storeu_pd(lows, low[0]);
+    _mm256_storeu_pd(highs, high[0]);
+    std::pair<double, double> result = simdMinMax<double>(lows, 4);
+    result.second = simdMinMax<double>(highs, 4).second;
+    if (i != size){
+        std::pair<double, double> tail = simdMinMax<double>(data + i, size - i);
+        result.first = tail.first < result.first ? tail.first : result.first;
+        result.second = result.second < tail.second ? tail.second : result.second;
+    }
+    return result;
+}
+#endif
+
+// scalarArgMinMax: 算法导论9.1中成对处理元素的同时求最小值和最大值, 每两个元素只需3次比较
+/*
+ * 一对元素先互相比较, 较小的与当前最小值比较, 较大的与当前最大值比较.
+ * 与std::minmax_element相同, 最小值取第一个, 最大值取最后一个.
+ *
+ */
+template<typename Iterator, typename CompareType>
+std::pair<Iterator, Iterator> scalarArgMinMax(const Iterator begin, const Iterator end, CompareType &compare)
+{
+    Iterator low = begin, high = begin;
+    Iterator current = begin;
+    ++current;
+    if (std::distance(current, end) % 2 != 0){
+        // 剩余的元素个数为奇数时先单独处理一个
+        if (compare(*current, *low))
+            low = current;
+        else
+            high = current;
+        ++current;
+    }
+    while (current != end){
+        Iterator first = current++;
+        Iterator second = current++;
+        Iterator small = first, large = second;
+        if (compare(*second, *first)){
+            small = second;
+            large = first;
+        }
+        if (compare(*small, *low))
+            low = small;
+        if (!compare(*large, *high))
+            high = large;
+    }
+    return std::make_pair(low, high);
+}
+
+// MinMaxKernel: minimum, minMax, argmin, argmax, argMinMax的实现, Simd为true时使用向量化路径
+template<typename Iterator, typename CompareType, bool Simd = UseSimdMinMax<Iterator, CompareType>::value>
+struct MinMaxKernel
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    // 只记录迭代器, 不在每次找到更小的元素时拷贝T
+    static Iterator argmin(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        Iterator min = begin;
+        for (auto current = begin; current != end; ++current){
+            if (compare(*current, *min))
+                min = current;
+        }
+        return min;
+    }
+    static Iterator argmax(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        Iterator max = begin;
+        for (auto current = begin; current != end; ++current){
+            if (compare(*max, *current))
+                max = current;
+        }
+        return max;
+    }
+    static std::pair<Iterator, Iterator> argMinMax(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        return scalarArgMinMax(begin, end, compare);
+    }
+    static std::pair<T, T> minMax(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        auto result = scalarArgMinMax(begin, end, compare);
+        return std::make_pair(*result.first, *result.second);
+    }
+};
+
+// 向量化路径: 先求出最值, 需要迭代器时再查找等于最值的元素, 两趟遍历都可以向量化
+template<typename Iterator, typename CompareType>
+struct MinMaxKernel<Iterator, CompareType, true>
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef MinMaxKernel<Iterator, CompareType, false> Scalar;
+
+    // 查找以end为界: 有NaN时可能没有等于最值的元素
+    static Iterator argmin(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        T value = minMax(begin, end, compare).first;
+        Iterator min = begin;
+        while (min != end && *min != value)
+            ++min;
+        return min != end ? min : Scalar::argmin(begin, end, compare);
+    }
+    static Iterator argmax(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        T value = minMax(begin, end, compare).second;
+        Iterator max = begin;
+        while (max != end && *max != value)
+            ++max;
+        return max != end ? max : Scalar::argmax(begin, end, compare);
+    }
+    static std::pair<Iterator, Iterator> argMinMax(const Iterator begin, const Iterator end, CompareType &compare)
+    {
+        std::pair<T, T> values = minMax(begin, end, compare);
+        Iterator low = begin, high = end;
+        while (low != end && *low != values.first)
+            ++low;
+        while (high != begin && *(high - 1) != values.second)
+            --high;
+        if (low == end || high == begin)
+            return Scalar::argMinMax(begin, end, compare);
+        return std::make_pair(low, high - 1);
+    }
+    static std::pair<T, T> minMax(const Iterator begin, const Iterator end, CompareType &)
+    {
+        std::pair<T, T> result = simdMinMax(&*begin, static_cast<std::size_t>(std::distance(begin, end)));
+        if (UseSimdMinMax<Iterator, CompareType>::reversed)
+            std::swap(result.first, result.second);
+        return result;
+    }
+};
+
 // minimum: 从一个集合中选择选择最小元素和最大元素的问题  算法导论9.1
 /*
  * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
  * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
  * \parameter compare: 一个可调用对象,可用于比较两个对象的小于,默认为std::less<T>;
  * \return 这个序列中的最值(typename std::iterator_traits<Iterator>::value_type).
- * 
+ *
  * 算法性能: 时间复杂度为: O(N).
  * 算法基本思想: 依次遍历集合中的每个元素,并记录下当前的最小元素.
+ *      --算术类型且比较函数为std::less/std::greater时使用向量化路径(见UseSimdMinMax);
+ *      --其余情况只记录最小元素的迭代器, 最后拷贝一次.
  *
  */
 template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
@@ -25,13 +301,137 @@ typename std::iterator_traits<Iterator>::value_type
 minimum(const Iterator begin, const Iterator end, CompareType compare = CompareType())
 {
     assert(begin != end);   // 保证输入的序列不是空序列
+    if (UseSimdMinMax<Iterator, CompareType>::value)
+        return MinMaxKernel<Iterator, CompareType>::minMax(begin, end, compare).first;
+    return *MinMaxKernel<Iterator, CompareType>::argmin(begin, end, compare);
+}
+
+// minMax: 同时求出最小值和最大值
+/*
+ * \parameter begin: 序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \return (最小值, 最大值).
+ *
+ * 算法性能: 向量化路径每个元素一次min和一次max指令; 其余情况为3N/2次比较, 而调用两次minimum需要2N次.
+ * 不叫minmax是为了避免与std::minmax在参数相关查找时产生二义性.
+ *
+ */
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+std::pair<typename std::iterator_traits<Iterator>::value_type, typename std::iterator_traits<Iterator>::value_type>
+minMax(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    assert(begin != end);
+    return MinMaxKernel<Iterator, CompareType>::minMax(begin, end, compare);
+}
+
+// argMinMax: 同时求出指向最小元素(第一个)和最大元素(最后一个)的迭代器(与std::minmax_element相同)
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+std::pair<Iterator, Iterator> argMinMax(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    assert(begin != end);
+    return MinMaxKernel<Iterator, CompareType>::argMinMax(begin, end, compare);
+}
+
+// argmin: 指向第一个最小元素的迭代器(与std::min_element相同)
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+Iterator argmin(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    assert(begin != end);
+    return MinMaxKernel<Iterator, CompareType>::argmin(begin, end, compare);
+}
+
+// argmax: 指向第一个最大元素的迭代器(与std::max_element相同)
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+Iterator argmax(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    assert(begin != end);
+    return MinMaxKernel<Iterator, CompareType>::argmax(begin, end, compare);
+}
+
+// minimum: 按执行策略求最小值
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为minmax_parallel_threshold;
+ * \parameter begin: 序列的起始迭代器(随机访问迭代器);
+ * \parameter end: 序列的终止迭代器;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \return 这个序列中的最小值.
+ *
+ * 串行策略或序列长度小于exec.grain(minmax_parallel_threshold)时调用minimum; 否则序列分为exec.threads()段,
+ * 每段用minimum求出局部最小值(各自走向量化路径), 最后按段的次序合并, 与minimum一样取第一个最小元素.
+ *
+ */
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+typename std::iterator_traits<Iterator>::value_type
+minimum(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    assert(begin != end);
+    std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    if (!exec.runParallel(size, minmax_parallel_threshold))
+        return minimum(begin, end, compare);
+    std::size_t chunk_size = (size + exec.threads() - 1) / exec.threads();
+    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    std::vector<T> results(chunks);
+    parallelFor(exec, chunks, [&](std::size_t c){
+        std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+        results[c] = minimum(begin + from, begin + to, compare);
+    });
+    T result = results[0];
+    for (std::size_t c = 1; c != chunks; ++c){
+        if (compare(results[c], result))
+            result = results[c];
+    }
+    return result;
+}
+
+// minMax: 按执行策略同时求出最小值和最大值
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为minmax_parallel_threshold;
+ * \parameter begin: 序列的起始迭代器(随机访问迭代器);
+ * \parameter end: 序列的终止迭代器;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \return (最小值, 最大值).
+ *
+ * 序列分为exec.threads()段, 每段用minMax求出局部最值, 最后合并. 与minMax一样, 最小值取第一个, 最大值取最后一个.
+ *
+ */
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+std::pair<typename std::iterator_traits<Iterator>::value_type, typename std::iterator_traits<Iterator>::value_type>
+minMax(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
     typedef typename std::iterator_traits<Iterator>::value_type T;
-    T min = *begin;
-    for (auto current = begin; current != end; ++current){
-        if (compare(*current, min))
-            min = *current;
+    assert(begin != end);
+    std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    if (!exec.runParallel(size, minmax_parallel_threshold))
+        return minMax(begin, end, compare);
+    std::size_t chunk_size = (size + exec.threads() - 1) / exec.threads();
+    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    std::vector<std::pair<T, T>> results(chunks);
+    parallelFor(exec, chunks, [&](std::size_t c){
+        std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+        results[c] = minMax(begin + from, begin + to, compare);
+    });
+    std::pair<T, T> result = results[0];
+    for (std::size_t c = 1; c != chunks; ++c){
+        if (compare(results[c].first, result.first))
+            result.first = results[c].first;
+        if (!compare(results[c].second, result.second))
+            result.second = results[c].second;
     }
+    return result;
+}
 
-    return min;
+// parallelMinMax: 多线程同时求出最小值和最大值, 等价于minMax(execution::par.withThreads(threads), ...)
+/*
+ * \parameter threads: 参与计算的线程个数(包括调用线程), 任务在共享的线程池中执行, 序列较短时不使用多线程.
+ *
+ */
+template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
+std::pair<typename std::iterator_traits<Iterator>::value_type, typename std::iterator_traits<Iterator>::value_type>
+parallelMinMax(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+               std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    return minMax(execution::par.withThreads(threads), begin, end, compare);
 }
 #endif
@@ -12,6 +12,12 @@ using std::vector;
 #include "minimum.h"
 #include <iterator>
 using std::begin;   using std::end;
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <list>
+#include <random>
+#include <string>
 
 bool compare(int num1, int num2)
 {
@@ -139,6 +145,101 @@ void Test4()
     cout << "的最大值为: " << min << endl;
 }
 
+// checkMinMax: 与std::minmax_element, std::min_element, std::max_element的结果比较
+template<typename Iterator, typename CompareType>
+bool checkMinMax(const Iterator first, const Iterator last, CompareType compare)
+{
+    auto expected = std::minmax_element(first, last, compare);
+    auto values = minMax(first, last, compare);
+    auto iterators = argMinMax(first, last, compare);
+    return values.first == *expected.first && values.second == *expected.second
+           && iterators == expected && minimum(first, last, compare) == *expected.first
+           && argmin(first, last, compare) == std::min_element(first, last, compare)
+           && argmax(first, last, compare) == std::max_element(first, last, compare);
+}
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-1000000, 1000000);
+    std::uniform_real_distribution<double> r(-1.0, 1.0);
+    bool right = true;
+    // 各种长度, 覆盖向量化路径的尾部处理
+    for (std::size_t size : {1, 2, 3, 31, 32, 33, 64, 65, 1000, 4099}){
+        vector<int> ints(size);
+        vector<double> doubles(size);
+        vector<long long> longs(size);
+        vector<unsigned char> bytes(size);
+        for (std::size_t i = 0; i != size; ++i){
+            ints[i] = u(e) % 100;      // 有重复的最值
+            doubles[i] = r(e);
+            longs[i] = static_cast<long long>(u(e)) * (1LL << 20);
+            bytes[i] = static_cast<unsigned char>(u(e));
+        }
+        std::list<int> list(ints.begin(), ints.end());
+        vector<std::string> strings;
+        for (auto x : ints)
+            strings.push_back(std::to_string(x));
+        right = right && checkMinMax(ints.begin(), ints.end(), std::less<int>())
+                      && checkMinMax(ints.begin(), ints.end(), std::greater<int>())
+                      && checkMinMax(doubles.data(), doubles.data() + size, std::less<double>())
+                      && checkMinMax(longs.begin(), longs.end(), std::greater<long long>())
+                      && checkMinMax(bytes.begin(), bytes.end(), std::less<unsigned char>())
+                      && checkMinMax(list.begin(), list.end(), std::less<int>())
+                      && checkMinMax(strings.begin(), strings.end(), std::less<std::string>())
+                      && checkMinMax(ints.begin(), ints.end(), compare);
+    }
+    cout << "minMax, argMinMax, argmin, argmax与std::minmax_element比较: " << (right ? "正确" : "错误") << endl;
+
+    // 有NaN时结果不确定, 但迭代器都在[begin, end)中(向量化路径的查找不会越界)
+    vector<double> nans(100, std::numeric_limits<double>::quiet_NaN());
+    bool bounded = true;
+    for (std::size_t k = 0; k <= nans.size(); k += 33){
+        if (k != 0)
+            nans[k - 1] = static_cast<double>(k);    // 一部分不是NaN
+        auto low = argmin(nans.begin(), nans.end()), high = argmax(nans.begin(), nans.end());
+        auto both = argMinMax(nans.begin(), nans.end());
+        bounded = bounded && low != nans.end() && high != nans.end()
+                          && both.first != nans.end() && both.second != nans.end();
+    }
+    cout << "有NaN时argmin, argmax, argMinMax不越界: " << (bounded ? "正确" : "错误") << endl;
+
+    vector<int> big(5000000);
+    for (auto &x : big)
+        x = u(e);
+    auto expected = std::minmax_element(big.begin(), big.end());
+    auto result = parallelMinMax(big.begin(), big.end(), std::less<int>(), 4);
+    auto reversed = parallelMinMax(big.begin(), big.end(), std::greater<int>(), 4);
+    right = result.first == *expected.first && result.second == *expected.second
+            && reversed.first == *expected.second && reversed.second == *expected.first;
+    cout << "5000000个元素的多线程minMax: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    // 键有大量重复, 按键比较, 检查取到的是第一个最小元素
+    vector<std::pair<int, std::size_t>> data(300000);
+    for (std::size_t i = 0; i != data.size(); ++i)
+        data[i] = std::make_pair(u(e), i);
+    auto byKey = [](const std::pair<int, std::size_t> &a, const std::pair<int, std::size_t> &b){ return a.first < b.first; };
+    auto expected = *std::min_element(data.begin(), data.end(), byKey);
+    vector<int> ints(3000000);
+    for (auto &x : ints)
+        x = u(e) - 500;
+    auto expectedInts = std::minmax_element(ints.begin(), ints.end());
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(7).withGrain(1000)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(7线程, 粒度1000)"};
+    for (int p = 0; p != 4; ++p){
+        auto first = minimum(policies[p], data.begin(), data.end(), byKey);
+        auto range = minMax(policies[p], ints.begin(), ints.end());
+        bool right = first == expected && minimum(policies[p], ints.begin(), ints.end()) == *expectedInts.first
+                     && range.first == *expectedInts.first && range.second == *expectedInts.second;
+        cout << names[p] << " minimum与minMax: " << (right ? "正确" : "错误") << endl;
+    }
+}
 
 int main()
 {
@@ -150,7 +251,11 @@ int main()
     Test3();
     cout << "*************C整型数组求最大值*************" << endl;
     Test4();
-        
+    cout << "**********同时求最小值和最大值**********" << endl;
+    Test5();
+    cout << "**************执行策略测试**************" << endl;
+    Test6();
+
     return 0;
 }
 
@@ -0,0 +1,105 @@
+/*************************************************************************
+	> File Name: multiSelect.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 21时16分09秒
+ ************************************************************************/
+
+#ifndef _MULTISELECT_H
+#define _MULTISELECT_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "../randomized_select/randomizedSelect.h"
+
+// multiSelectRange: 在[begin, end)中选出有序的排位ranks[first, last)(排位相对于整个序列, 区间从offset开始)
+template<typename Iterator, typename CompareType, typename PartitionPolicy>
+void multiSelectRange(Iterator begin, Iterator end, std::size_t offset,
+                      const std::size_t *first, const std::size_t *last,
+                      CompareType &compare, PartitionPolicy &policy)
+{
+    while (first != last){
+        // 先选出中间的排位, 它把序列分为两段, 其余的排位分别只在一侧
+        const std::size_t *middle = first + (last - first) / 2;
+        std::ptrdiff_t rank = static_cast<std::ptrdiff_t>(*middle - offset);
+        introSelectLoop(begin, end, rank, compare, policy);
+        multiSelectRange(begin, begin + rank, offset, first, middle, compare, policy);
+        // 右侧用循环处理
+        begin = begin + rank + 1;
+        offset = *middle + 1;
+        first = middle + 1;
+    }
+}
+
+// multiSelect: 一次选出多个排位的元素(例如多个分位数)
+/*
+ * \parameter begin: 待选取序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待选取序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter ranks_begin: 排位序列的起始迭代器(0表示最小, 1表示次小, 依次类推; 可以无序, 可以重复);
+ * \parameter ranks_end: 排位序列的终止迭代器;
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ * \parameter keep_partitioned: 为true时在原序列上操作, 返回后序列按所有排位划分好
+ *            (每个排位上是对应的元素, 相邻两个排位之间的元素介于两者之间); 为false时在副本上操作, 原序列不变;
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为BlockPartition;
+ * \return 与排位一一对应的元素.
+ *
+ * 算法基本思想: 把排位排序去重, 用introSelect选出中间的一个排位, 它左侧的排位只需在左段中选择,
+ * 右侧的排位只需在右段中选择, 依次递归. 没有排位的一段不再处理.
+ *
+ * 算法性能: 选择k个排位的期望时间为O(Nlogk), 而逐个调用选择算法为O(kN); 最坏情况为O(Nlogk)(introSelect最坏为线性).
+ *
+ */
+template<typename Iterator, typename RankIterator,
+         typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = BlockPartition>
+std::vector<typename std::iterator_traits<Iterator>::value_type>
+multiSelect(const Iterator begin, const Iterator end, const RankIterator ranks_begin, const RankIterator ranks_end,
+            CompareType compare = CompareType(), bool keep_partitioned = true, PartitionPolicy policy = PartitionPolicy())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    std::vector<std::size_t> ranks(ranks_begin, ranks_end);
+    std::vector<T> result;
+    if (ranks.empty())
+        return result;
+    std::vector<std::size_t> sorted(ranks);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    assert(sorted.back() < static_cast<std::size_t>(std::distance(begin, end)));
+    result.reserve(ranks.size());
+    if (keep_partitioned){
+        multiSelectRange(begin, end, 0, sorted.data(), sorted.data() + sorted.size(), compare, policy);
+        for (auto rank : ranks)
+            result.push_back(*(begin + rank));
+    }else{
+        std::vector<T> copy(begin, end);
+        multiSelectRange(copy.begin(), copy.end(), 0, sorted.data(), sorted.data() + sorted.size(), compare, policy);
+        for (auto rank : ranks)
+            result.push_back(copy[rank]);
+    }
+    return result;
+}
+
+// quantileRanks: 把分位数(0到1之间, 例如0.5, 0.99)换算为长度为size的序列中的排位(最近排位法)
+/*
+ * 最近排位法: 分位数q是不小于q * size个元素中的最小者, 从0开始的排位为ceil(q * size) - 1(q为0时为0).
+ * 长度为偶数时中位数(q = 0.5)是较小的一个, 例如{1, 2, 3, 4}的中位数为2.
+ *
+ */
+template<typename QuantileIterator>
+std::vector<std::size_t> quantileRanks(std::size_t size, QuantileIterator first, QuantileIterator last)
+{
+    assert(size > 0);
+    std::vector<std::size_t> ranks;
+    for (; first != last; ++first){
+        double q = std::min(1.0, std::max(0.0, static_cast<double>(*first)));
+        std::size_t rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(size)));
+        ranks.push_back(rank == 0 ? 0 : std::min(rank, size) - 1);
+    }
+    return ranks;
+}
+#endif
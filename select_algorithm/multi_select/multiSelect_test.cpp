@@ -0,0 +1,89 @@
+/*************************************************************************
+	> File Name: multiSelect_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 21时40分52秒
+ ************************************************************************/
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+using std::sort;
+#include <functional>
+#include <random>
+#include "multiSelect.h"
+
+template<typename Iterator>
+void print(const Iterator begin, const Iterator end)
+{
+    for (auto current = begin; current != end; ++current)
+        cout << *current << " ";
+    cout << endl;
+}
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::exponential_distribution<double> latency(0.01);     // 模拟请求延迟
+    vector<double> data(200000);
+    for (auto &x : data)
+        x = latency(e);
+    vector<double> sorted(data);
+    sort(sorted.begin(), sorted.end());
+
+    double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    vector<std::size_t> ranks = quantileRanks(data.size(), std::begin(quantiles), std::end(quantiles));
+    vector<double> copy(data);
+    vector<double> result = multiSelect(copy.begin(), copy.end(), ranks.begin(), ranks.end(), std::less<double>(), false);
+    bool right = copy == data;      // 不保留划分时原序列不变
+    for (std::size_t i = 0; i != ranks.size(); ++i)
+        right = right && result[i] == sorted[ranks[i]];
+    cout << "p50/p90/p99/p99.9: ";
+    print(result.begin(), result.end());
+    cout << "与sort的结果比较: " << (right ? "正确" : "错误") << endl;
+
+    // 最近排位法: 长度为偶数时中位数是较小的一个
+    double bounds[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+    vector<std::size_t> even = quantileRanks(4, std::begin(bounds), std::end(bounds));
+    vector<std::size_t> odd = quantileRanks(5, std::begin(bounds), std::end(bounds));
+    bool nearest = even == vector<std::size_t>{0, 0, 1, 2, 3} && odd == vector<std::size_t>{0, 1, 2, 3, 4};
+    cout << "最近排位法(长度为4与5): " << (nearest ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 50);
+    vector<int> data(100000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> sorted(data);
+    sort(sorted.begin(), sorted.end(), std::greater<int>());
+    // 无序且有重复的排位
+    vector<std::size_t> ranks{99999, 0, 500, 500, 73000, 1, 42};
+    vector<int> result = multiSelect(data.begin(), data.end(), ranks.begin(), ranks.end(), std::greater<int>());
+    bool right = true;
+    for (std::size_t i = 0; i != ranks.size(); ++i)
+        right = right && result[i] == sorted[ranks[i]];
+    // 序列按所有排位划分好
+    vector<std::size_t> order(ranks);
+    sort(order.begin(), order.end());
+    for (std::size_t i = 0; i != data.size(); ++i){
+        auto next = std::upper_bound(order.begin(), order.end(), i);
+        if (next != order.end())
+            right = right && data[i] >= data[*next];
+        if (next != order.begin())
+            right = right && data[i] <= data[*(next - 1)];
+    }
+    cout << "无序重复的排位, 降序, 保留划分: " << (right ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*************一次选出多个分位数**************" << endl;
+    Test1();
+    cout << "*************多个排位与划分测试**************" << endl;
+    Test2();
+    return 0;
+}
@@ -0,0 +1,377 @@
+/*************************************************************************
+	> File Name: quantileSketch.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 22时05分31秒
+ ************************************************************************/
+
+#ifndef _QUANTILESKETCH_H
+#define _QUANTILESKETCH_H
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "../../sort_algorithm/quick_sort/quickSort.h"
+#include "../../sort_algorithm/merge_sort/mergeSort.h"
+
+const std::uint32_t kll_default_k = 200;        // 默认精度参数, 单个分位数的排位误差约为1.65%(99%置信度)
+const std::uint32_t kll_min_width = 8;          // 每一层压缩器的最小容量
+const std::uint32_t kll_max_levels = 61;        // 权重2^h必须能用uint64_t表示
+const std::uint32_t kll_magic = 0x534c4c4b;     // 序列化格式的标识"KLLS"
+const std::uint32_t kll_version = 1;
+
+// QuantileSketch: 可合并的流式分位数估计(KLL sketch, Karnin, Lang & Liberty 2016)
+/*
+ * 算法基本思想: 第h层压缩器中的每个元素代表原始数据中的2^h个元素:
+ *      --新元素加入第0层(无序缓冲区);
+ *      --保存的元素总数达到所有层容量之和时, 找到最低的一个已满的层, 把它排序后随机取奇数位或偶数位
+ *        的元素放入上一层(权重翻倍), 其余丢弃; 长度为奇数时最后一个元素留在本层;
+ *      --第h层的容量为k*(2/3)^(H-1-h)(H为层数), 越低的层容量越小, 总容量不超过约3k+8H个元素;
+ *      --第0层用introSort排序, 上一层始终有序, 被提升的元素用merge并入, 查询时用mergeSortPairs
+ *        按元素排序它们的权重.
+ *
+ * 算法性能: add均摊为O(logk), quantile与rank为O(klogk), merge为O(k);
+ *          单个分位数的排位误差约为1.65/k(99%置信度), 与数据量无关.
+ *
+ * 两个sketch的精度参数k相同时可以合并, 合并的结果与把两组数据加入同一个sketch的精度相同.
+ * serialize/deserialize要求T可以按字节复制(trivially copyable), 格式使用本机字节序.
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+class QuantileSketch
+{
+public:
+    //****************************构造函数*******************************
+    // k: 精度参数(不小于kll_min_width); seed: 压缩时随机取奇偶位使用的种子
+    explicit QuantileSketch(std::uint32_t k = kll_default_k, CompareType c = CompareType(), std::uint32_t seed = 2018)
+        : levels(1), accuracy(k), count(0), compare(c), engine(seed)
+    {
+        if (k < kll_min_width)
+            throw std::invalid_argument("QuantileSketch error: 精度参数k太小");
+        max_retained = computeMaxRetained();
+    }
+    //****************************成员函数*******************************
+    std::uint64_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::uint32_t k() const { return accuracy; }
+    // retained: 当前保存的元素个数(内存占用)
+    std::size_t retained() const
+    {
+        std::size_t total = 0;
+        for (const auto &level : levels)
+            total += level.size();
+        return total;
+    }
+    const T& min() const { assert(count > 0); return min_value; }
+    const T& max() const { assert(count > 0); return max_value; }
+
+    // add: 加入一个元素
+    void add(const T &x)
+    {
+        updateMinMax(x);
+        levels[0].push_back(x);
+        ++count;
+        if (retained() >= max_retained)
+            compress();
+    }
+
+    // add: 批量加入[begin, end)中的元素, 每次把第0层填满后再压缩
+    template<typename Iterator>
+    void add(Iterator begin, const Iterator end)
+    {
+        while (begin != end){
+            std::size_t room = max_retained - retained();
+            for (; room != 0 && begin != end; --room, ++begin){
+                updateMinMax(*begin);
+                levels[0].push_back(*begin);
+                ++count;
+            }
+            if (room == 0)
+                compress();     // compress之后retained() < max_retained, 下一轮至少还能加入一个元素
+        }
+    }
+
+    // merge: 把另一个sketch合并进来(两者的k必须相同)
+    void merge(const QuantileSketch &other)
+    {
+        if (other.accuracy != accuracy)
+            throw std::invalid_argument("QuantileSketch::merge error: 两个sketch的精度参数k不同");
+        if (other.count == 0)
+            return;
+        if (&other == this){
+            QuantileSketch copy(other);
+            merge(copy);
+            return;
+        }
+        // 合并到空的sketch时直接复制最值(updateMinMax在count == 0时会用第二个值覆盖第一个)
+        if (count == 0){
+            min_value = other.min_value;
+            max_value = other.max_value;
+        }else{
+            updateMinMax(other.min_value);
+            updateMinMax(other.max_value);
+        }
+        count += other.count;
+        while (levels.size() < other.levels.size())
+            levels.emplace_back();
+        for (std::size_t h = 0; h != other.levels.size(); ++h){
+            auto &level = levels[h];
+            std::size_t middle = level.size();
+            level.insert(level.end(), other.levels[h].begin(), other.levels[h].end());
+            if (h > 0)
+                ::merge(level.begin(), level.end(), level.begin() + middle, compare);
+        }
+        max_retained = computeMaxRetained();
+        if (retained() >= max_retained)
+            compress();
+    }
+
+    // quantile: 估计分位数q(0到1之间)对应的元素, 与quantileRanks一样使用最近排位法
+    T quantile(double q) const
+    {
+        assert(count > 0);
+        std::vector<T> items;
+        std::vector<std::uint64_t> weights;
+        sortedView(items, weights);
+        return quantileOf(q, items, weights);
+    }
+
+    // quantiles: 一次估计多个分位数, 只需要排序一次
+    template<typename QuantileIterator>
+    std::vector<T> quantiles(QuantileIterator first, const QuantileIterator last) const
+    {
+        assert(count > 0);
+        std::vector<T> items;
+        std::vector<std::uint64_t> weights;
+        sortedView(items, weights);
+        std::vector<T> result;
+        for (; first != last; ++first)
+            result.push_back(quantileOf(static_cast<double>(*first), items, weights));
+        return result;
+    }
+
+    // rank: 估计小于x的元素个数, rank(x) / size()为x的归一化排位
+    std::uint64_t rank(const T &x) const
+    {
+        std::uint64_t total = 0;
+        for (std::size_t h = 0; h != levels.size(); ++h){
+            std::uint64_t less = 0;
+            if (h == 0){
+                for (const auto &item : levels[0])
+                    less += compare(item, x);
+            }else{
+                // 上面的层是有序的
+                less = std::distance(levels[h].begin(),
+                                     std::lower_bound(levels[h].begin(), levels[h].end(), x, compare));
+            }
+            total += less << h;
+        }
+        return total;
+    }
+
+    // serialize: 序列化为字节数组
+    /*
+     * 格式: magic, version, k, sizeof(T), 层数(均为uint32_t), 元素个数(uint64_t), 最小值与最大值(元素个数不为0时),
+     *       然后是每一层的元素个数(uint32_t)与元素.
+     *
+     */
+    std::vector<unsigned char> serialize() const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "QuantileSketch::serialize: T必须可以按字节复制");
+        std::vector<unsigned char> out;
+        out.reserve(32 + 2 * sizeof(T) + 4 * levels.size() + sizeof(T) * retained());
+        writeValue(out, kll_magic);
+        writeValue(out, kll_version);
+        writeValue(out, accuracy);
+        writeValue(out, static_cast<std::uint32_t>(sizeof(T)));
+        writeValue(out, static_cast<std::uint32_t>(levels.size()));
+        writeValue(out, count);
+        if (count != 0){
+            writeValue(out, min_value);
+            writeValue(out, max_value);
+        }
+        for (const auto &level : levels){
+            writeValue(out, static_cast<std::uint32_t>(level.size()));
+            if (!level.empty()){
+                const unsigned char *p = reinterpret_cast<const unsigned char *>(level.data());
+                out.insert(out.end(), p, p + sizeof(T) * level.size());
+            }
+        }
+        return out;
+    }
+
+    // deserialize: 从serialize得到的字节数组恢复sketch, 数据不完整或不一致时抛出std::invalid_argument
+    static QuantileSketch deserialize(const unsigned char *data, std::size_t length, CompareType c = CompareType())
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "QuantileSketch::deserialize: T必须可以按字节复制");
+        const unsigned char *end = data + length;
+        std::uint32_t magic, version, k, width, height;
+        readValue(data, end, magic);
+        readValue(data, end, version);
+        if (magic != kll_magic || version != kll_version)
+            throw std::invalid_argument("QuantileSketch::deserialize error: 不是QuantileSketch的数据");
+        readValue(data, end, k);
+        readValue(data, end, width);
+        readValue(data, end, height);
+        if (width != sizeof(T) || k < kll_min_width || height == 0 || height > kll_max_levels)
+            throw std::invalid_argument("QuantileSketch::deserialize error: 参数不一致");
+        QuantileSketch sketch(k, c);
+        sketch.levels.resize(height);
+        readValue(data, end, sketch.count);
+        if (sketch.count != 0){
+            readValue(data, end, sketch.min_value);
+            readValue(data, end, sketch.max_value);
+        }
+        std::uint64_t total = 0;
+        for (std::uint32_t h = 0; h != height; ++h){
+            std::uint32_t size;
+            readValue(data, end, size);
+            if (static_cast<std::size_t>(end - data) / sizeof(T) < size)
+                throw std::invalid_argument("QuantileSketch::deserialize error: 数据不完整");
+            auto &level = sketch.levels[h];
+            level.resize(size);
+            if (size != 0)
+                std::memcpy(level.data(), data, sizeof(T) * size);
+            data += sizeof(T) * size;
+            if (h > 0 && !std::is_sorted(level.begin(), level.end(), sketch.compare))
+                throw std::invalid_argument("QuantileSketch::deserialize error: 压缩器中的元素无序");
+            total += static_cast<std::uint64_t>(size) << h;
+        }
+        if (data != end || total != sketch.count)
+            throw std::invalid_argument("QuantileSketch::deserialize error: 权重之和与元素个数不一致");
+        sketch.max_retained = sketch.computeMaxRetained();
+        if (sketch.retained() >= sketch.max_retained)
+            sketch.compress();
+        return sketch;
+    }
+
+    void clear()
+    {
+        levels.assign(1, std::vector<T>());
+        count = 0;
+        max_retained = computeMaxRetained();
+    }
+private:
+    //****************************数据结构*******************************
+    std::vector<std::vector<T>> levels;     // 第h层的元素权重为2^h, 第0层无序, 其余层有序
+    std::uint32_t accuracy;                 // 精度参数k
+    std::uint64_t count;                    // 加入的元素个数
+    std::size_t max_retained;               // 所有层容量之和, 达到它时压缩
+    T min_value = T();
+    T max_value = T();
+    CompareType compare;
+    std::minstd_rand engine;
+
+    // capacity: 第h层的容量k*(2/3)^(H-1-h), 不小于kll_min_width
+    std::size_t capacity(std::size_t h) const
+    {
+        double depth = static_cast<double>(levels.size() - 1 - h);
+        std::size_t c = static_cast<std::size_t>(std::ceil(accuracy * std::pow(2.0 / 3.0, depth)));
+        return c < kll_min_width ? kll_min_width : c;
+    }
+
+    std::size_t computeMaxRetained() const
+    {
+        std::size_t total = 0;
+        for (std::size_t h = 0; h != levels.size(); ++h)
+            total += capacity(h);
+        return total;
+    }
+
+    void updateMinMax(const T &x)
+    {
+        if (count == 0 || compare(x, min_value))
+            min_value = x;
+        if (count == 0 || compare(max_value, x))
+            max_value = x;
+    }
+
+    // compress: 依次压缩最低的已满的层, 直到保存的元素个数低于总容量
+    void compress()
+    {
+        while (retained() >= max_retained){
+            for (std::size_t h = 0; h != levels.size(); ++h){
+                if (levels[h].size() >= capacity(h)){
+                    compact(h);
+                    break;
+                }
+            }
+        }
+    }
+
+    // compact: 把第h层中一半的元素提升到第h+1层
+    void compact(std::size_t h)
+    {
+        if (h + 1 == levels.size()){
+            if (levels.size() == kll_max_levels)
+                throw std::length_error("QuantileSketch error: 层数超过了权重的表示范围");
+            levels.emplace_back();
+            max_retained = computeMaxRetained();
+        }
+        auto &level = levels[h];
+        auto &upper = levels[h + 1];
+        if (h == 0)
+            introSort(level.begin(), level.end(), compare);
+        std::size_t pairs = level.size() & ~static_cast<std::size_t>(1);
+        std::size_t middle = upper.size();
+        for (std::size_t i = (engine() & 1); i < pairs; i += 2)
+            upper.push_back(level[i]);
+        ::merge(upper.begin(), upper.end(), upper.begin() + middle, compare);
+        level.erase(level.begin(), level.begin() + pairs);
+    }
+
+    // sortedView: 所有保存的元素及其权重, 按元素排好序
+    void sortedView(std::vector<T> &items, std::vector<std::uint64_t> &weights) const
+    {
+        std::size_t total = retained();
+        items.reserve(total);
+        weights.reserve(total);
+        for (std::size_t h = 0; h != levels.size(); ++h){
+            items.insert(items.end(), levels[h].begin(), levels[h].end());
+            weights.insert(weights.end(), levels[h].size(), static_cast<std::uint64_t>(1) << h);
+        }
+        mergeSortPairs(items.begin(), items.end(), weights.begin(), compare);
+    }
+
+    // quantileOf: 在排好序的带权元素中找到(从0开始的)排位ceil(q * size()) - 1的元素, 与quantileRanks相同
+    T quantileOf(double q, const std::vector<T> &items, const std::vector<std::uint64_t> &weights) const
+    {
+        if (!(q > 0.0))
+            return min_value;
+        if (q >= 1.0)
+            return max_value;
+        std::uint64_t target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))) - 1;
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i != items.size(); ++i){
+            cumulative += weights[i];
+            if (cumulative > target)
+                return items[i];
+        }
+        return max_value;
+    }
+
+    template<typename U>
+    static void writeValue(std::vector<unsigned char> &out, const U &value)
+    {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(&value);
+        out.insert(out.end(), p, p + sizeof(U));
+    }
+
+    template<typename U>
+    static void readValue(const unsigned char *&data, const unsigned char *end, U &value)
+    {
+        if (static_cast<std::size_t>(end - data) < sizeof(U))
+            throw std::invalid_argument("QuantileSketch::deserialize error: 数据不完整");
+        std::memcpy(&value, data, sizeof(U));
+        data += sizeof(U);
+    }
+};
+#endif
@@ -0,0 +1,163 @@
+/*************************************************************************
+	> File Name: quantileSketch_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 22时38分14秒
+ ************************************************************************/
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+using std::sort;
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include "quantileSketch.h"
+
+// rankError: 估计值x在排好序的精确数据中的归一化排位与q的偏差
+template<typename T, typename CompareType = std::less<T>>
+double rankError(const vector<T> &sorted, const T &x, double q, CompareType compare = CompareType())
+{
+    double low = std::lower_bound(sorted.begin(), sorted.end(), x, compare) - sorted.begin();
+    double high = std::upper_bound(sorted.begin(), sorted.end(), x, compare) - sorted.begin();
+    double target = q * sorted.size();
+    if (target >= low && target <= high)
+        return 0.0;
+    return std::min(std::fabs(low - target), std::fabs(high - target)) / sorted.size();
+}
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::exponential_distribution<double> latency(0.01);     // 模拟请求延迟
+    vector<double> data(1000000);
+    for (auto &x : data)
+        x = latency(e);
+    QuantileSketch<double> sketch;
+    for (auto x : data)
+        sketch.add(x);
+    vector<double> sorted(data);
+    sort(sorted.begin(), sorted.end());
+
+    double qs[] = {0.0, 0.1, 0.5, 0.9, 0.99, 1.0};
+    vector<double> result = sketch.quantiles(std::begin(qs), std::end(qs));
+    bool right = sketch.size() == data.size() && result.front() == sorted.front() && result.back() == sorted.back();
+    double worst = 0.0;
+    for (std::size_t i = 0; i != result.size(); ++i){
+        cout << "q = " << qs[i] << ": " << result[i] << " (精确值 "
+             << sorted[std::min(sorted.size(), std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(qs[i] * sorted.size())))) - 1]
+             << ")" << endl;
+        worst = std::max(worst, rankError(sorted, result[i], qs[i]));
+    }
+    cout << "保存的元素个数: " << sketch.retained() << ", 最大排位误差: " << worst << endl;
+    right = right && worst < 0.02 && sketch.retained() < 4 * sketch.k();
+    cout << "1000000个元素的分位数估计: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    // 8个节点各自统计, 序列化后传到一起合并
+    std::default_random_engine e(2018);
+    std::normal_distribution<double> normal(100.0, 15.0);
+    vector<double> all;
+    QuantileSketch<double> merged;
+    for (int node = 0; node != 8; ++node){
+        vector<double> data(125000);
+        for (auto &x : data)
+            x = normal(e) + node;
+        all.insert(all.end(), data.begin(), data.end());
+        QuantileSketch<double> local(kll_default_k, std::less<double>(), node);
+        local.add(data.begin(), data.end());
+        vector<unsigned char> bytes = local.serialize();
+        QuantileSketch<double> received = QuantileSketch<double>::deserialize(bytes.data(), bytes.size());
+        bool same = received.size() == local.size() && received.quantile(0.5) == local.quantile(0.5)
+                    && received.rank(100.0) == local.rank(100.0);
+        if (!same)
+            cout << "序列化往返: 错误" << endl;
+        merged.merge(received);
+    }
+    sort(all.begin(), all.end());
+    double worst = 0.0;
+    for (double q = 0.05; q < 1.0; q += 0.05)
+        worst = std::max(worst, rankError(all, merged.quantile(q), q));
+    double rank_worst = 0.0;
+    for (double x = 60.0; x <= 150.0; x += 10.0){
+        double exact = std::lower_bound(all.begin(), all.end(), x) - all.begin();
+        rank_worst = std::max(rank_worst, std::fabs(merged.rank(x) - exact) / all.size());
+    }
+    cout << "合并后保存的元素个数: " << merged.retained() << ", 分位数最大排位误差: " << worst
+         << ", rank最大误差: " << rank_worst << endl;
+    bool right = merged.size() == all.size() && merged.min() == all.front() && merged.max() == all.back()
+                 && worst < 0.02 && rank_worst < 0.02 && merged.retained() < 4 * merged.k();
+    cout << "8个节点的sketch序列化后合并: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test3()
+{
+    // 大量重复元素, 降序比较
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 9);
+    vector<int> data(300000);
+    for (auto &x : data)
+        x = u(e);
+    QuantileSketch<int, std::greater<int>> sketch(64);
+    sketch.add(data.begin(), data.end());
+    sort(data.begin(), data.end(), std::greater<int>());
+    double worst = 0.0;
+    for (double q = 0.0; q <= 1.0; q += 0.1)
+        worst = std::max(worst, rankError(data, sketch.quantile(q), q, std::greater<int>()));
+    bool right = worst < 0.05 && sketch.min() == 9 && sketch.max() == 0;
+
+    // 损坏的数据
+    vector<unsigned char> bytes = sketch.serialize();
+    int errors = 0;
+    try{
+        QuantileSketch<int, std::greater<int>>::deserialize(bytes.data(), bytes.size() - 1);
+    }catch (const std::invalid_argument &){
+        ++errors;
+    }
+    bytes[0] ^= 0xff;
+    try{
+        QuantileSketch<int, std::greater<int>>::deserialize(bytes.data(), bytes.size());
+    }catch (const std::invalid_argument &){
+        ++errors;
+    }
+    try{
+        QuantileSketch<int, std::greater<int>> other(200);
+        sketch.merge(other);
+    }catch (const std::invalid_argument &){
+        ++errors;
+    }
+    right = right && errors == 3;
+    cout << "重复元素, 降序比较与错误检查: " << (right ? "正确" : "错误") << endl;
+
+    // 合并到空的sketch: 最值来自另一个sketch
+    QuantileSketch<int> empty, filled;
+    for (int x = 0; x != 1000; ++x)
+        filled.add(x);
+    empty.merge(filled);
+    bool copied = empty.size() == 1000 && empty.min() == 0 && empty.max() == 999
+                  && empty.quantile(0.0) == 0 && empty.quantile(1.0) == 999;
+    cout << "合并到空的sketch: " << (copied ? "正确" : "错误") << endl;
+
+    // 元素较少时sketch是精确的, 分位数与quantileRanks一样使用最近排位法(长度为偶数时中位数是较小的一个)
+    QuantileSketch<int> small;
+    for (int x = 1; x <= 4; ++x)
+        small.add(x);
+    bool nearest = small.quantile(0.25) == 1 && small.quantile(0.5) == 2 && small.quantile(0.75) == 3
+                   && small.quantile(0.76) == 4;
+    cout << "最近排位法(长度为4): " << (nearest ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "******************流式分位数估计******************" << endl;
+    Test1();
+    cout << "******************可合并与序列化******************" << endl;
+    Test2();
+    cout << "*****************重复元素与错误检查***************" << endl;
+    Test3();
+    return 0;
+}
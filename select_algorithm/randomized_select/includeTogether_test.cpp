@@ -0,0 +1,54 @@
+/*************************************************************************
+	> File Name: includeTogether_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 13时10分26秒
+ ************************************************************************/
+// 同时包含快速排序与各个选择算法的头文件, 检查它们之间没有重名的函数(例如partition)
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+#include <random>
+#include "../../sort_algorithm/quick_sort/quickSort.h"
+#include "randomizedSelect.h"
+#include "../multi_select/multiSelect.h"
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 999);
+    vector<int> data(10000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> sorted(data);
+    quickSort(sorted.begin(), sorted.end());
+    vector<int> expected(data);
+    std::sort(expected.begin(), expected.end());
+    bool right = sorted == expected;
+
+    vector<int> v(data);
+    right = right && randomiezdSelect(v.begin(), v.end(), 5000) == expected[5000];
+    v = data;
+    right = right && introSelect(v.begin(), v.end(), 123) == expected[123];
+    v = data;
+    right = right && goodSelectInPlace(v.begin(), v.end(), 9999) == expected[9999];
+    v = data;
+    std::size_t ranks[] = {0, 2500, 5000, 9999};
+    vector<int> selected = multiSelect(v.begin(), v.end(), std::begin(ranks), std::end(ranks));
+    for (std::size_t i = 0; i != 4; ++i)
+        right = right && selected[i] == expected[ranks[i]];
+    // quickSort.h的partition
+    v = data;
+    auto p = ::partition(v.begin(), v.end(), v.end() - 1);
+    right = right && std::all_of(v.begin(), p, [&p](int x){ return x < *p; })
+                  && std::all_of(p, v.end(), [&p](int x){ return !(x < *p); });
+    cout << "quickSort.h, randomizedSelect.h与multiSelect.h同时包含: " << (right ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    Test1();
+    return 0;
+}
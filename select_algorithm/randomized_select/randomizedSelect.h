@@ -9,9 +9,33 @@
 #define _RANDOMIZEDSELECT_H
 
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <thread>
 #include <utility>
 #include <random>
+#include "../../sort_algorithm/quick_sort/partitionPolicy.h"
+#include "../good_select/medianOfMedians.h"
+// selectEngine: 选择算法使用的随机数引擎
+/*
+ * 每个线程一个, 第一次使用时用std::random_device与线程编号播种, 因此每次运行, 每个线程的主元序列都不同,
+ * 无法事先构造出使随机选择退化为O(N^2)的输入.
+ *
+ */
+inline std::minstd_rand& selectEngine()
+{
+    static thread_local std::minstd_rand engine(static_cast<std::minstd_rand::result_type>(
+        std::random_device()() ^ std::hash<std::thread::id>()(std::this_thread::get_id())));
+    return engine;
+}
+
+// randomIndex: [0, size)中的一个随机下标
+inline std::size_t randomIndex(std::size_t size)
+{
+    return std::uniform_int_distribution<std::size_t>(0, size - 1)(selectEngine());
+}
 // randomizedPartition: 快速排序算法中的划分算法  算法导论7.1
 /*
  * \parameter begin: 待选取序列的起始迭代器(也可以是指向数组中某元素的指针);
@@ -39,12 +63,12 @@ Iterator randomizedPartition(const Iterator begin, const Iterator end,
     
     auto x = *partitioned_iter;     
     auto i = begin;
-    std::swap(*partitioned_iter, *(end - 1));   // 元素交换
+    std::iter_swap(partitioned_iter, end - 1);   // 元素交换
     for(auto current = begin; current != end; ++current){
         if (compare(*current, x))
-            std::swap(*i++, *current);
+            std::iter_swap(i++, current);
     }
-    std::swap(*i, *(end - 1));
+    std::iter_swap(i, end - 1);
 
     return i;
 }
@@ -54,6 +78,7 @@ Iterator randomizedPartition(const Iterator begin, const Iterator end,
  * \parameter end: 待选取序列的终止迭代器(也可以是指向数组中某元素的指针);
  * \parameter minIndex: 选取排序第几的元素(0表示最小(或最大),1表示次小(次大),依次类推);
  * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为LomutoPartition;
  * \return 排序minIndex的元素.
  *
  * 算法基本思想: 假设对数组A[p,...,r]选择, 选择第k小的元素:
@@ -62,35 +87,172 @@ Iterator randomizedPartition(const Iterator begin, const Iterator end,
  *          --判定: 
  *              --若m==k, 则找到了这个元素, 返回A[q];
  *              --若m<k, 则说明指定的元素在A[q+1,...,r]中,且位于这个新数组的k-m-1小,
- *                此时递归调用randomiezd_select(q+1, end, k-m-1);
+ *                此时在A[q+1,...,r]中继续选择第k-m-1小的元素;
  *              --若m>k, 则说明指定的元素在A[p,...,q-1]中,且位于这个新数组的的k小,
- *                此时递归调用randomiezdSelect(begin, q, k);
+ *                此时在A[p,...,q-1]中继续选择第k小的元素.
+ *          --用循环代替尾递归; 随机数引擎见selectEngine.
  * 时间复杂度: 最坏的情况为 O(N^2), 期望时间复杂度为 O(N);
  *
  * 算法特性: 原地操作.
  *
  */
-template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = LomutoPartition>
 typename std::iterator_traits<Iterator>::value_type
 randomiezdSelect(const Iterator begin, const Iterator end, 
-                 std::size_t minIndex, CompareType compare = CompareType())
+                 std::size_t minIndex, CompareType compare = CompareType(),
+                 PartitionPolicy policy = PartitionPolicy())
 {
     auto size = std::distance(begin, end);
     assert(size >= 0);  // 序列不能是一个空序列
     assert(size >= minIndex);   
-    // 基准情形
-    if (size <= 1)
-        return *begin;
-    std::default_random_engine e;
-    std::uniform_int_distribution<unsigned> u(0,size);
-    auto partitioned_iter = randomizedPartition(begin, end, begin + u(e), compare);
-    auto smallerNumbers = std::distance(begin, partitioned_iter);
-    if (minIndex == smallerNumbers)
-        return *partitioned_iter;
-    if (minIndex < smallerNumbers)
-        return randomiezdSelect(begin, partitioned_iter, minIndex, compare);
-    else if (minIndex > smallerNumbers)
-        return randomiezdSelect(partitioned_iter + 1, end, minIndex - smallerNumbers - 1);      
+    Iterator first = begin, last = end;
+    while (std::distance(first, last) > 1){
+        auto equal_range = policy(first, last, first + randomIndex(std::distance(first, last)), compare);
+        std::size_t smallerNumbers = std::distance(first, equal_range.first);     // 小于主元的元素个数
+        std::size_t notGreaterNumbers = std::distance(first, equal_range.second); // 不大于主元的元素个数
+        if (smallerNumbers <= minIndex && minIndex < notGreaterNumbers)
+            return *equal_range.first;
+        if (minIndex < smallerNumbers){
+            last = equal_range.first;
+        }else{
+            first = equal_range.second;
+            minIndex -= notGreaterNumbers;
+        }
+    }
+    return *first;
+}
 
+// randomiezdSelect: 按执行策略的随机选择算法
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_select_threshold;
+ * \parameter begin: 待选取序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待选取序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter minIndex: 选取排序第几的元素(0表示最小(或最大),1表示次小(次大),依次类推);
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 区间变短以后串行的randomiezdSelect使用的划分策略, 默认为LomutoPartition;
+ * \return 排序minIndex的元素.
+ *
+ * 串行策略或序列长度小于exec.grain(parallel_select_threshold)时调用randomiezdSelect. 否则由parallelSelectLoop
+ * (见medianOfMedians.h)以随机选取的元素为主元并行地三路划分, 区间变短以后再串行选择. 期望时间为O(N / P + P),
+ * 额外空间为O(N).
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = LomutoPartition>
+typename std::iterator_traits<Iterator>::value_type
+randomiezdSelect(const ExecutionPolicy &exec, const Iterator begin, const Iterator end,
+                 std::size_t minIndex, CompareType compare = CompareType(),
+                 PartitionPolicy policy = PartitionPolicy())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    assert(static_cast<std::ptrdiff_t>(minIndex) < std::distance(begin, end));
+    auto randomPivot = [](Iterator first, Iterator last) -> T {
+        return *(first + randomIndex(std::distance(first, last)));
+    };
+    auto finish = [&](Iterator first, Iterator last, std::size_t rank) -> T {
+        return randomiezdSelect(first, last, rank, compare, policy);
+    };
+    return parallelSelectLoop(exec, begin, end, minIndex, compare, randomPivot, finish);
+}
+
+const std::ptrdiff_t floyd_rivest_threshold = 600;     // 不小于该长度的区间用Floyd-Rivest采样选取主元
+const std::ptrdiff_t select_small_threshold = 16;      // 不超过该长度的区间直接排序
+const std::size_t introselect_bad_splits = 4;          // 允许的不平衡划分次数, 超过后改用goodSelect
+
+// medianOfThreeRandom: 随机取三个元素, 返回其中位数的位置
+template<typename Iterator, typename CompareType>
+Iterator medianOfThreeRandom(const Iterator begin, const Iterator end, CompareType &compare)
+{
+    std::size_t size = std::distance(begin, end);
+    Iterator a = begin + randomIndex(size), b = begin + randomIndex(size), c = begin + randomIndex(size);
+    if (compare(*a, *b)){
+        if (compare(*b, *c))
+            return b;
+        return compare(*a, *c) ? c : a;
+    }
+    if (compare(*a, *c))
+        return a;
+    return compare(*b, *c) ? c : b;
+}
+
+// introSelectLoop: introSelect的主循环, 结束时*(begin + rank)为第rank小的元素
+template<typename Iterator, typename CompareType, typename PartitionPolicy>
+void introSelectLoop(Iterator begin, Iterator end, std::ptrdiff_t rank, CompareType &compare, PartitionPolicy &policy)
+{
+    std::size_t bad_splits = 0;
+    while (std::distance(begin, end) > select_small_threshold){
+        std::ptrdiff_t size = std::distance(begin, end);
+        if (bad_splits > introselect_bad_splits){
+            // 主元选取持续失败, 改用最坏情况为线性时间且不分配内存的goodSelectLoop
+            goodSelectLoop(begin, end, rank, compare, policy);
+            return;
+        }
+        Iterator pivot;
+        if (size >= floyd_rivest_threshold){
+            // Floyd-Rivest: 先在包含第rank小元素的一小段样本区间中递归选择, 使*(begin + rank)接近最终结果
+            double n = static_cast<double>(size);
+            double i = static_cast<double>(rank + 1);
+            double z = std::log(n);
+            double s = 0.5 * std::exp(2 * z / 3);
+            double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1 : 1);
+            std::ptrdiff_t left = std::max<std::ptrdiff_t>(0, static_cast<std::ptrdiff_t>(rank - i * s / n + sd));
+            std::ptrdiff_t right = std::min<std::ptrdiff_t>(size, static_cast<std::ptrdiff_t>(rank + (n - i) * s / n + sd) + 1);
+            if (left <= rank && rank < right)
+                introSelectLoop(begin + left, begin + right, rank - left, compare, policy);
+            pivot = begin + rank;
+        }else{
+            pivot = medianOfThreeRandom(begin, end, compare);
+        }
+        auto equal_range = policy(begin, end, pivot, compare);
+        std::ptrdiff_t smaller = std::distance(begin, equal_range.first);
+        std::ptrdiff_t not_greater = std::distance(begin, equal_range.second);
+        if (smaller <= rank && rank < not_greater)
+            return;
+        std::ptrdiff_t remaining;
+        if (rank < smaller){
+            end = equal_range.first;
+            remaining = smaller;
+        }else{
+            begin = equal_range.second;
+            rank -= not_greater;
+            remaining = size - not_greater;
+        }
+        if (remaining > size / 4 * 3)
+            ++bad_splits;
+    }
+    smallSort(begin, end, compare);
+}
+
+// introSelect: 内省选择算法(Floyd-Rivest采样 + 无分支划分 + goodSelect兜底)
+/*
+ * \parameter begin: 待选取序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待选取序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter rank: 选取排序第几的元素(0表示最小,1表示次小,依次类推);
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为无分支的BlockPartition;
+ * \return 排序rank的元素.
+ *
+ * 算法基本思想: 与randomiezdSelect相同, 划分后只在包含第rank小元素的一侧继续, 用循环实现:
+ *      --较长的区间(不小于floyd_rivest_threshold)用Floyd-Rivest方法选取主元: 从区间中取出大约N^(2/3)个
+ *        元素组成的一段样本(位置由rank在区间中的相对位置决定), 在样本中递归选择, 得到的主元几乎正好是
+ *        第rank小的元素, 划分后剩下的区间很短;
+ *      --较短的区间用随机三数取中选取主元; 不超过select_small_threshold的区间直接排序;
+ *      --不平衡的划分(剩下的区间超过3/4)超过introselect_bad_splits次时改用goodSelect, 最坏情况为O(N).
+ * 返回时序列满足std::nth_element的性质: *(begin + rank)为第rank小的元素, 它前面的元素都不大于它,
+ * 后面的元素都不小于它.
+ *
+ * 算法性能: 期望比较次数约为N + min(rank, N - rank) + o(N), 最坏情况为O(N), 原址操作.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = BlockPartition>
+typename std::iterator_traits<Iterator>::value_type
+introSelect(const Iterator begin, const Iterator end, std::size_t rank, CompareType compare = CompareType(),
+            PartitionPolicy policy = PartitionPolicy())
+{
+    assert(static_cast<std::ptrdiff_t>(rank) < std::distance(begin, end));
+    introSelectLoop(begin, end, static_cast<std::ptrdiff_t>(rank), compare, policy);
+    return *(begin + rank);
 }
 #endif
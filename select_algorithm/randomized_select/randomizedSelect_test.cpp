@@ -10,6 +10,8 @@ using std::cout;    using std::endl;
 using std::vector;
 #include <iterator>
 using std::begin;   using std::end;
+#include <algorithm>
+#include <random>
 #include "randomizedSelect.h"
 
 bool compare(int num1, int num2)
@@ -141,6 +143,102 @@ void Test4()
     cout << "的最大值为: " << min << endl;
 }
 
+// 不同划分策略下的选择结果与std::nth_element比较
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100000);
+    std::uniform_int_distribution<int> few(0, 3);
+    vector<int> random(5000), duplicates(5000);
+    for (std::size_t i = 0; i != random.size(); ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+    }
+    vector<vector<int>> inputs{random, duplicates};
+    const char *names[] = {"随机序列", "大量重复元素"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        bool lomuto = true, block = true, threeWay = true;
+        for (std::size_t rank = 0; rank < inputs[k].size(); rank += 499){
+            vector<int> expected(inputs[k]);
+            std::nth_element(expected.begin(), expected.begin() + rank, expected.end());
+            vector<int> data1(inputs[k]), data2(inputs[k]), data3(inputs[k]);
+            lomuto = lomuto && randomiezdSelect(data1.begin(), data1.end(), rank, std::less<int>(), LomutoPartition()) == expected[rank];
+            block = block && randomiezdSelect(data2.begin(), data2.end(), rank, std::less<int>(), BlockPartition()) == expected[rank];
+            threeWay = threeWay && randomiezdSelect(data3.begin(), data3.end(), rank, std::less<int>(), ThreeWayPartition()) == expected[rank];
+        }
+        cout << names[k] << ": LomutoPartition " << (lomuto ? "正确" : "错误")
+             << ", BlockPartition " << (block ? "正确" : "错误")
+             << ", ThreeWayPartition " << (threeWay ? "正确" : "错误") << endl;
+    }
+}
+
+// 中间大外面小的"管风琴"序列与有序序列: 固定主元的选择算法在这类输入上容易退化
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000000);
+    std::uniform_int_distribution<int> few(0, 3);
+    const std::size_t size = 100000;
+    vector<int> random(size), duplicates(size), sorted(size), organ(size);
+    for (std::size_t i = 0; i != size; ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+        sorted[i] = static_cast<int>(i);
+        organ[i] = static_cast<int>(i < size / 2 ? i : size - i);
+    }
+    vector<vector<int>> inputs{random, duplicates, sorted, organ};
+    const char *names[] = {"随机序列", "大量重复元素", "有序序列", "管风琴序列"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        bool right = true;
+        for (std::size_t rank : {std::size_t(0), size / 100, size / 2, size * 99 / 100, size - 1}){
+            vector<int> expected(inputs[k]);
+            std::nth_element(expected.begin(), expected.begin() + rank, expected.end());
+            vector<int> data(inputs[k]);
+            int value = introSelect(data.begin(), data.end(), rank);
+            right = right && value == expected[rank] && data[rank] == value
+                    && std::all_of(data.begin(), data.begin() + rank, [value](int x){ return x <= value; })
+                    && std::all_of(data.begin() + rank, data.end(), [value](int x){ return x >= value; });
+            vector<int> data2(inputs[k]);
+            right = right && randomiezdSelect(data2.begin(), data2.end(), rank, std::less<int>(), ThreeWayPartition()) == expected[rank];
+        }
+        cout << names[k] << ": " << (right ? "正确" : "错误") << endl;
+    }
+    vector<int> data(random);
+    cout << "降序第10个元素: " << introSelect(data.begin(), data.end(), 9, compare) << " ";
+    std::sort(random.begin(), random.end(), compare);
+    cout << "sort结果: " << random[9] << endl;
+}
+
+void Test7()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000000), few(0, 3);
+    const std::size_t size = 200000;
+    vector<int> random(size), duplicates(size);
+    for (std::size_t i = 0; i != size; ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+    }
+    vector<vector<int>> inputs{random, duplicates};
+    const char *names[] = {"随机序列", "大量重复元素"};
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4).withGrain(1000),
+                                        execution::par_unseq.withThreads(2).withGrain(10000)};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        vector<int> expected(inputs[k]);
+        std::sort(expected.begin(), expected.end());
+        bool right = true;
+        for (const ExecutionPolicy &policy : policies){
+            for (std::size_t rank : {std::size_t(0), size / 100, size / 2, size - 1}){
+                vector<int> data(inputs[k]);
+                right = right && randomiezdSelect(policy, data.begin(), data.end(), rank, std::less<int>(), ThreeWayPartition())
+                                 == expected[rank];
+                std::sort(data.begin(), data.end());
+                right = right && data == expected;
+            }
+        }
+        cout << names[k] << "(seq, par, par_unseq): " << (right ? "正确" : "错误") << endl;
+    }
+}
 
 int main()
 {
@@ -152,6 +250,12 @@ int main()
     Test3();
     cout << "*************C整型数组求最大值*************" << endl;
     Test4();
+    cout << "*************不同划分策略的选择测试***********" << endl;
+    Test5();
+    cout << "*************内省选择(introSelect)测试**************" << endl;
+    Test6();
+    cout << "*************执行策略测试*******************" << endl;
+    Test7();
     
     return 0;
 }
@@ -10,7 +10,14 @@
 #include <cassert>
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
 #include "../quick_sort/quickSort.h"
+#include "../../select_algorithm/minimum/minimum.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 const std::size_t real_bucket_num = 10;     // 桶排序时划分10个小区间
 // bucketSort: 桶排序 算法导论8.4
 /*
@@ -18,6 +25,7 @@ const std::size_t real_bucket_num = 10;     // 桶排序时划分10个小区间
  * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
  * \parameter min_value: 待排序序列元素的下界(不一定是最紧下界);
  * \parameter max_value: 待排序序列元素的上届(不一定是最紧上界);
+ * \parameter arena: 桶的来源(见MemoryResource.h), 默认为nullptr(operator new);
  * \return void.
  *
  * 算法基本思想: 桶排序将[0, 1]区间划分为n个相同大小的子区间, 或称为桶.
@@ -30,23 +38,215 @@ const std::size_t real_bucket_num = 10;     // 桶排序时划分10个小区间
 template<typename Iterator>
 void bucketSort(const Iterator begin, const Iterator end, 
                 const typename std::iterator_traits<Iterator>::value_type &min_value,
-                const typename std::iterator_traits<Iterator>::value_type &max_value)
+                const typename std::iterator_traits<Iterator>::value_type &max_value, MemoryResource *arena = nullptr)
 {
     assert(min_value < max_value);  // 确保最小值要小于最大值
     // 迭代器指向对象值的类型
     typedef typename std::iterator_traits<Iterator>::value_type T;
-    std::vector<T> buckets[real_bucket_num];
+    ResourceAllocator<T> alloc(arena);
+    ResourceVector<ResourceVector<T>> buckets(real_bucket_num, ResourceVector<T>(alloc), alloc);
     for (auto current = begin; current != end; ++current){
-        // 归一化处理
-        int index = (*current - min_value) * real_bucket_num / (max_value - min_value);
-        buckets[index].push_back(*current);     // 把元素放到桶中
+        // 归一化处理(等于max_value的元素放入最后一个桶)
+        std::size_t index = (*current - min_value) * real_bucket_num / (max_value - min_value);
+        buckets[index < real_bucket_num ? index : real_bucket_num - 1].push_back(*current);     // 把元素放到桶中
     }
     // 对每一个区间进行排序
     std::size_t inserted_total = 0;
-    for (int i = 0; i != real_bucket_num; ++i){
+    for (std::size_t i = 0; i != real_bucket_num; ++i){
         quickSort(buckets[i].begin(), buckets[i].end());
         std::copy(buckets[i].begin(), buckets[i].end(), begin + inserted_total);   // 非原址排序
         inserted_total += buckets[i].size();
     }
 }
+
+// bucketSort: 桶排序, 上下界由minMax一次遍历求出
+template<typename Iterator>
+void bucketSort(const Iterator begin, const Iterator end, MemoryResource *arena = nullptr)
+{
+    if (std::distance(begin, end) <= 1)
+        return;
+    auto range = minMax(begin, end);
+    if (range.first < range.second)     // 全部元素相等时已经有序
+        bucketSort(begin, end, range.first, range.second, arena);
+}
+
+const std::ptrdiff_t sample_sort_threshold = 1 << 12;   // 小于该长度的序列直接用introSort
+const std::size_t sample_bucket_bytes = 1 << 18;        // 期望的桶大小(字节), 约为L2缓存的大小
+const std::size_t sample_max_buckets = 256;             // 桶的最大个数, 桶编号可以用一个字节保存
+
+// buildSplitterTree: 把有序的splitters按照中序遍历的次序放入完全二叉树tree[1,...,k-1]
+template<typename T>
+void buildSplitterTree(const std::vector<T> &splitters, std::vector<T> &tree, std::size_t node, std::size_t &next)
+{
+    if (node >= tree.size())
+        return;
+    buildSplitterTree(splitters, tree, 2 * node, next);
+    tree[node] = splitters[next++];
+    buildSplitterTree(splitters, tree, 2 * node + 1, next);
+}
+
+// classifyBucket: 在划分元素树中无分支地查找x所在的桶
+/*
+ * 每一层只根据一次比较的结果(0或1)计算下一个结点的编号, 没有分支预测失败.
+ * 返回的桶编号b满足: splitter[b-1] < x <= splitter[b].
+ *
+ */
+template<typename T, typename CompareType>
+inline std::size_t classifyBucket(const std::vector<T> &tree, std::size_t log_buckets, const T &x, CompareType &compare)
+{
+    std::size_t node = 1;
+    for (std::size_t level = 0; level != log_buckets; ++level)
+        node = 2 * node + static_cast<std::size_t>(compare(tree[node], x));
+    return node - tree.size();
+}
+
+// sampleSort: 采样排序(分布无关的桶排序)
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为sample_sort_threshold;
+ * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+ * \parameter buffer: 辅助空间, 长度不足时会被扩大, 重复使用可以避免每次分配;
+ * \return void.
+ *
+ * 算法基本思想: bucketSort假设输入服从均匀分布, 分布倾斜时几乎所有元素都落入同一个桶.
+ * 采样排序用样本来确定桶的边界:
+ *      --桶的个数k(2的幂)使得每个桶大约是sample_bucket_bytes字节, 正好能放进缓存;
+ *      --随机抽取k * a个样本(a约为0.2logN, 过采样), 排序后等间隔地取k-1个划分元素(splitter);
+ *      --划分元素存放在一棵完全二叉树中, 每个元素用logk次无分支的比较确定所在的桶;
+ *      --先统计每个桶的元素个数, 再把元素一次性移动到一整块连续的辅助空间中对应的位置, 不需要每个桶一个vector;
+ *      --各个桶互相独立, 并行地用introSort排序并移回原序列.
+ * 短于sample_sort_threshold的序列直接用introSort排序. 串行策略或序列短于exec.grain(sample_sort_threshold)时
+ * 上面的各步都在调用线程中依次完成(见parallelFor), 不访问线程池.
+ * 重复的划分元素会被去掉, 大量相等的元素最多使某一个桶变大, 仍由introSort保证O(NlogN).
+ *
+ * 算法性能: 期望时间复杂度为O(NlogN), 与输入的分布无关; 额外空间为O(N). 不稳定排序.
+ *
+ */
+template<typename Iterator, typename CompareType>
+void sampleSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare,
+                std::vector<typename std::iterator_traits<Iterator>::value_type> &buffer)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    std::ptrdiff_t distance = std::distance(begin, end);
+    if (distance < sample_sort_threshold){
+        introSort(begin, end, compare);
+        return;
+    }
+    const std::size_t size = static_cast<std::size_t>(distance);
+    // 桶的个数: 2的幂, 每个桶大约sample_bucket_bytes字节
+    std::size_t bucket_elements = std::max<std::size_t>(1, sample_bucket_bytes / sizeof(T));
+    std::size_t log_buckets = 1;
+    while ((std::size_t(1) << log_buckets) < sample_max_buckets
+           && (std::size_t(1) << log_buckets) * bucket_elements < size)
+        ++log_buckets;
+    std::size_t oversampling = 1;
+    for (std::size_t n = size; n > 1; n >>= 1)
+        ++oversampling;
+    oversampling = std::max<std::size_t>(1, oversampling / 5);
+    // 过采样并选出划分元素
+    std::minstd_rand engine(static_cast<std::minstd_rand::result_type>(size));
+    std::uniform_int_distribution<std::size_t> u(0, size - 1);
+    std::vector<T> samples;
+    samples.reserve((std::size_t(1) << log_buckets) * oversampling);
+    for (std::size_t i = 0; i != (std::size_t(1) << log_buckets) * oversampling; ++i)
+        samples.push_back(*(begin + u(engine)));
+    introSort(samples.begin(), samples.end(), compare);
+    std::vector<T> splitters;
+    for (std::size_t i = 1; i != (std::size_t(1) << log_buckets); ++i){
+        const T &candidate = samples[i * oversampling - 1];
+        if (splitters.empty() || compare(splitters.back(), candidate))
+            splitters.push_back(candidate);
+    }
+    // 去掉重复的划分元素后减少桶的个数, 不足的位置用最后一个划分元素补齐(对应的桶为空)
+    log_buckets = 1;
+    while ((std::size_t(1) << log_buckets) < splitters.size() + 1)
+        ++log_buckets;
+    const std::size_t buckets = std::size_t(1) << log_buckets;
+    splitters.resize(buckets - 1, splitters.back());
+    std::vector<T> tree(buckets);
+    std::size_t next = 0;
+    buildSplitterTree(splitters, tree, 1, next);
+
+    if (buffer.size() < size)
+        buffer.resize(size);
+    const std::size_t threads = exec.runParallel(size, sample_sort_threshold) ? exec.threads() : 1;
+    const std::size_t chunks = std::min(threads, size / static_cast<std::size_t>(sample_sort_threshold) + 1);
+    const std::size_t chunk_size = (size + chunks - 1) / chunks;
+    std::vector<unsigned char> oracle(size);            // 每个元素所在的桶
+    std::vector<std::size_t> counts(chunks * buckets, 0);
+    const ExecutionPolicy &run = threads > 1 ? exec : execution::seq;
+    // 第一遍: 分类并统计每一段中每个桶的元素个数
+    parallelFor(run, chunks, [&](std::size_t c){
+        std::size_t *local = &counts[c * buckets];
+        std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+        for (std::size_t i = from; i != to; ++i){
+            std::size_t b = classifyBucket(tree, log_buckets, *(begin + i), compare);
+            oracle[i] = static_cast<unsigned char>(b);
+            ++local[b];
+        }
+    });
+    // 前缀和: 按"桶优先,段次之"的次序, 得到每一段在每个桶中的写入位置
+    std::vector<std::size_t> bucket_begin(buckets + 1, 0);
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b != buckets; ++b){
+        bucket_begin[b] = sum;
+        for (std::size_t c = 0; c != chunks; ++c){
+            std::size_t count = counts[c * buckets + b];
+            counts[c * buckets + b] = sum;
+            sum += count;
+        }
+    }
+    bucket_begin[buckets] = sum;
+    // 第二遍: 把元素移动到连续的辅助空间中
+    parallelFor(run, chunks, [&](std::size_t c){
+        std::size_t *local = &counts[c * buckets];
+        std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+        for (std::size_t i = from; i != to; ++i)
+            buffer[local[oracle[i]]++] = std::move(*(begin + i));
+    });
+    // 各个桶并行排序后移回原序列
+    parallelFor(run, buckets, [&](std::size_t b){
+        if (bucket_begin[b] == bucket_begin[b + 1])
+            return;
+        auto first = buffer.begin() + bucket_begin[b], last = buffer.begin() + bucket_begin[b + 1];
+        introSort(first, last, compare);
+        std::move(first, last, begin + bucket_begin[b]);
+    });
+}
+
+// sampleSort: threads为参与排序的线程个数(包括调用线程), 等价于execution::par.withThreads(threads)
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void sampleSort(const Iterator begin, const Iterator end, CompareType compare, std::size_t threads,
+                std::vector<typename std::iterator_traits<Iterator>::value_type> &buffer)
+{
+    sampleSort(threads <= 1 ? execution::seq : execution::par.withThreads(threads), begin, end, compare, buffer);
+}
+
+// sampleSort: 采样排序, 每次调用使用新分配的辅助空间
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void sampleSort(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+                std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    sampleSort(begin, end, compare, threads, buffer);
+}
+
+// bucketSort: 按执行策略的桶排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h);
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+ * \return void.
+ *
+ * 由sampleSort完成: 桶的边界由样本确定, 不要求输入服从均匀分布, 也不限于算术类型; 辅助空间在函数内分配.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void bucketSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    sampleSort(exec, begin, end, compare, buffer);
+}
 #endif
@@ -12,6 +12,8 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <cmath>
+#include <random>
 #include "bucketSort.h"
 
 // 数组输出函数
@@ -144,6 +146,82 @@ void Test2()
 
 }
 
+void Test3()
+{
+    std::default_random_engine e(2018);
+    std::exponential_distribution<double> skewed(50.0);     // 几乎所有的元素都集中在0附近
+    std::uniform_int_distribution<int> few(0, 3);            // 大量重复元素
+    vector<double> data1(200000);
+    for (auto &x : data1)
+        x = skewed(e);
+    vector<int> data2(200000);
+    for (auto &x : data2)
+        x = few(e);
+    vector<double> compareData1(data1);
+    vector<int> compareData2(data2);
+    vector<double> buffer;      // 重复使用的辅助空间
+
+    sampleSort(data1.begin(), data1.end(), std::less<double>(), 4, buffer);
+    sort(compareData1.begin(), compareData1.end());
+    cout << "倾斜分布的数据(4个线程): " << (data1 == compareData1 ? "正确" : "错误") << endl;
+
+    sampleSort(data2.begin(), data2.end(), std::greater<int>(), 1);
+    sort(compareData2.begin(), compareData2.end(), std::greater<int>());
+    cout << "大量重复元素降序排列(单线程): " << (data2 == compareData2 ? "正确" : "错误") << endl;
+
+    vector<double> data3(data1.rbegin(), data1.rend());
+    sampleSort(data3.begin(), data3.end(), std::less<double>(), 4, buffer);
+    cout << "重复使用辅助空间: " << (data3 == compareData1 ? "正确" : "错误") << endl;
+}
+
+void Test4()
+{
+    // 不给出上下界, 由minMax求出(最大值所在的元素放入最后一个桶)
+    std::default_random_engine e(2018);
+    std::uniform_real_distribution<double> u(-5.0, 5.0);
+    vector<double> data(10000);
+    for (auto &x : data)
+        x = u(e);
+    vector<double> compareData(data);
+    bucketSort(data.begin(), data.end());
+    sort(compareData.begin(), compareData.end());
+    cout << "自动求上下界: " << (data == compareData ? "正确" : "错误") << endl;
+}
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    vector<double> data(10000);
+    for (auto &x : data)
+        x = u(e);
+    vector<double> compareData(data);
+    MonotonicBufferResource arena;
+    bucketSort(data.begin(), data.end(), &arena);
+    sort(compareData.begin(), compareData.end());
+    bool right = data == compareData && arena.bytesAllocated() >= data.size() * sizeof(double);
+    cout << "桶从MemoryResource分配: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::exponential_distribution<double> skewed(1.0);     // 倾斜的分布
+    vector<double> data(200000);
+    for (auto &x : data)
+        x = skewed(e);
+    vector<double> compareData(data);
+    sort(compareData.begin(), compareData.end(), std::greater<double>());
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(3).withGrain(100)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(3线程, 粒度100)"};
+    for (int p = 0; p != 4; ++p){
+        vector<double> sorted(data);
+        bucketSort(policies[p], sorted.begin(), sorted.end(), std::greater<double>());
+        cout << names[p] << " 指数分布降序: " << (sorted == compareData ? "正确" : "错误") << endl;
+    }
+}
+
 int main()
 {
     
@@ -153,5 +231,17 @@ int main()
     cout << "****************对vector数组升序排列测试***************\n";
     Test2();
 
+    cout << "****************采样排序测试***************************\n";
+    Test3();
+
+    cout << "****************自动求上下界的桶排序*******************\n";
+    Test4();
+
+    cout << "****************从MemoryResource分配桶*****************\n";
+    Test5();
+
+    cout << "****************执行策略测试***************************\n";
+    Test6();
+
     return 0;
 }
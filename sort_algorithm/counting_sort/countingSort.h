@@ -9,11 +9,20 @@
 #define _COUNTINGSORT_H
 #include <functional>
 #include <vector>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+#include "../../select_algorithm/minimum/minimum.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
 // countingSort: 计数排序 算法导论8.2
 /*
  * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
  * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
- * \parameter maxVal: 待排序序列中的最大值.
+ * \parameter maxVal: 待排序序列中的最大值;
+ * \parameter arena: 计数数组与暂存数组的来源(见MemoryResource.h), 默认为nullptr(operator new).
  * \return void.
  *
  * 算法性能:时间复杂度 O(N). 空间复杂度O(N);算法只能够适应于整数排序.
@@ -30,7 +39,7 @@
  */
 template<typename Iterator>
 void countingSort(const Iterator begin, const Iterator end, 
-                  const typename std::iterator_traits<Iterator>::value_type &maxVal)
+                  const typename std::iterator_traits<Iterator>::value_type &maxVal, MemoryResource *arena = nullptr)
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;      // 迭代器指向对象值的类型
     // 在编译的时候断言T的类型是不是整型,计数排序算法只支持整数类型的排序算法
@@ -38,7 +47,7 @@ void countingSort(const Iterator begin, const Iterator end,
     auto size = std::distance(begin, end);
     if (size <= 1)
         return;
-    std::vector<T> cuntingArray(maxVal+1,0);
+    ResourceVector<T> cuntingArray(maxVal+1, 0, ResourceAllocator<T>(arena));
     // 计数过程(cuntingArray[i]保存的就是等于i元素的个数)
     for (auto current = begin; current != end; ++current)
         cuntingArray[*current] += 1;
@@ -46,11 +55,198 @@ void countingSort(const Iterator begin, const Iterator end,
     for (decltype(cuntingArray.size()) i = 1; i != cuntingArray.size(); ++i)
         cuntingArray[i] += cuntingArray[i-1];
     // 把每个元素A[j]放到它输出数组B的正确位置上.
-    std::vector<T> temSortArray(size,0);
+    ResourceVector<T> temSortArray(size, 0, ResourceAllocator<T>(arena));
     for (auto current = begin; current != end; ++current){
         temSortArray[cuntingArray[*current] - 1] = *current;
         cuntingArray[*current] -= 1;
     }
     std::copy(temSortArray.begin(), temSortArray.end(), begin);
 }
+
+// countingSort: 计数排序, 最大值由minMax一次遍历求出
+/*
+ * 序列中有负数时抛出std::invalid_argument(负数键请使用countingSortByKey).
+ *
+ */
+template<typename Iterator>
+void countingSort(const Iterator begin, const Iterator end, MemoryResource *arena = nullptr)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    if (std::distance(begin, end) <= 1)
+        return;
+    auto range = minMax(begin, end);
+    if (range.first < T())
+        throw std::invalid_argument("countingSort error: 序列中有负数, 请使用countingSortByKey");
+    countingSort(begin, end, range.second, arena);
+}
+
+const std::size_t counting_sort_max_range = std::size_t(1) << 28;     // 键的取值范围上限(计数数组的长度)
+const std::size_t counting_parallel_threshold = std::size_t(1) << 20;  // 不小于该长度的序列并行统计
+
+// keyRange: 一次遍历求出所有元素键的最小值和最大值
+/*
+ * 最小值和最大值分别用无分支的min/max更新, 两者互不依赖, 编译器可以把循环向量化.
+ *
+ */
+template<typename Iterator, typename KeyFunction>
+auto keyRange(const Iterator begin, const Iterator end, KeyFunction &key)
+    -> std::pair<typename std::decay<decltype(key(*begin))>::type, typename std::decay<decltype(key(*begin))>::type>
+{
+    typedef typename std::decay<decltype(key(*begin))>::type KeyType;
+    KeyType low = key(*begin), high = low;
+    for (auto current = begin; current != end; ++current){
+        KeyType k = key(*current);
+        low = k < low ? k : low;
+        high = high < k ? k : high;
+    }
+    return std::make_pair(low, high);
+}
+
+// countingSortByKey: 按整数键对记录进行计数排序  算法导论8.2
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter key: 一个可调用对象, key(x)返回记录x的整数键(例如分片号,优先级);
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为counting_parallel_threshold;
+ * \parameter output: 排序结果, 长度不足时会被扩大, 重复使用可以避免每次分配;
+ * \return void.
+ *
+ * 与countingSort相比:
+ *      --不需要调用者给出最大值, 一次遍历求出键的最小值min和最大值max;
+ *      --计数数组只有max-min+1个元素, 下标为key-min, 所以负数键, 以及取值集中在较大数值附近的键都可以排序;
+ *      --计数器为uint32_t(序列长度不能超过2^32-1), 计数数组更小, 更容易放进缓存;
+ *      --排序的对象是整个记录, 记录被稳定地移动(std::move)到output中.
+ * 并行策略下序列不短于exec.grain(counting_parallel_threshold)时, 序列被均分为exec.threads()段,
+ * 每个任务统计自己那一段的局部直方图, 再按"键优先,段次之"的次序求前缀和,
+ * 每个任务把自己那一段移动到预先计算好的位置上, 依然是稳定的.
+ *
+ * 算法性能: 时间复杂度为O(N + K), K = max - min + 1; 额外空间为O(PK). 稳定排序.
+ *
+ */
+template<typename Iterator, typename KeyFunction>
+void countingSortByKey(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, KeyFunction key,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &output)
+{
+    typedef typename std::decay<decltype(key(*begin))>::type KeyType;
+    static_assert(std::is_integral<KeyType>::value, "key must be integer!");
+    typedef typename std::make_unsigned<KeyType>::type UnsignedKey;
+    auto distance = std::distance(begin, end);
+    if (distance <= 0)
+        return;
+    std::size_t size = static_cast<std::size_t>(distance);
+    if (size > UINT32_MAX)
+        throw std::invalid_argument("countingSortByKey error: 序列长度超过了uint32_t计数器的范围");
+    auto range = keyRange(begin, end, key);
+    UnsignedKey low = static_cast<UnsignedKey>(range.first);
+    std::uint64_t span = static_cast<UnsignedKey>(static_cast<UnsignedKey>(range.second) - low);
+    if (span >= counting_sort_max_range)
+        throw std::invalid_argument("countingSortByKey error: 键的取值范围过大, 请使用radixSort");
+    std::size_t buckets = static_cast<std::size_t>(span) + 1;
+    if (output.size() < size)
+        output.resize(size);
+    auto bucketOf = [&key, low](const typename std::iterator_traits<Iterator>::value_type &x) -> std::size_t {
+        return static_cast<UnsignedKey>(static_cast<UnsignedKey>(key(x)) - low);
+    };
+    if (!exec.runParallel(size, counting_parallel_threshold)){
+        std::vector<std::uint32_t> counts(buckets, 0);
+        for (auto current = begin; current != end; ++current)
+            ++counts[bucketOf(*current)];
+        std::uint32_t sum = 0;
+        for (auto &count : counts){
+            std::uint32_t c = count;
+            count = sum;
+            sum += c;
+        }
+        for (auto current = begin; current != end; ++current)
+            output[counts[bucketOf(*current)]++] = std::move(*current);
+        return;
+    }
+    const std::size_t threads = exec.threads();
+    const std::size_t chunk_size = (size + threads - 1) / threads;
+    std::vector<std::uint32_t> counts(threads * buckets, 0);
+    WorkStealingPool &pool = exec.pool();
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != threads; ++c){
+            group.run([=, &counts, &bucketOf]{
+                std::uint32_t *local = &counts[c * buckets];
+                std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+                for (auto current = begin + from; current != begin + to; ++current)
+                    ++local[bucketOf(*current)];
+            });
+        }
+        group.wait();
+    }
+    std::uint32_t sum = 0;
+    for (std::size_t b = 0; b != buckets; ++b){
+        for (std::size_t c = 0; c != threads; ++c){
+            std::uint32_t count = counts[c * buckets + b];
+            counts[c * buckets + b] = sum;
+            sum += count;
+        }
+    }
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != threads; ++c){
+            group.run([=, &counts, &bucketOf, &output]{
+                std::uint32_t *local = &counts[c * buckets];
+                std::size_t from = std::min(size, c * chunk_size), to = std::min(size, from + chunk_size);
+                for (auto current = begin + from; current != begin + to; ++current)
+                    output[local[bucketOf(*current)]++] = std::move(*current);
+            });
+        }
+        group.wait();
+    }
+}
+
+// countingSortByKey: 按执行策略, 按整数键原址地对记录排序(结果移回原序列)
+template<typename Iterator, typename KeyFunction>
+void countingSortByKey(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, KeyFunction key)
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> output;
+    countingSortByKey(exec, begin, end, key, output);
+    std::move(output.begin(), output.begin() + std::distance(begin, end), begin);
+}
+
+// countingSortByKey: threads为参与统计的线程个数(包括调用线程), 等价于execution::par.withThreads(threads)
+template<typename Iterator, typename KeyFunction>
+void countingSortByKey(const Iterator begin, const Iterator end, KeyFunction key,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &output,
+                       std::size_t threads = 1)
+{
+    countingSortByKey(execution::par.withThreads(threads), begin, end, key, output);
+}
+
+// countingSortByKey: 按整数键原址地对记录排序(结果移回原序列)
+template<typename Iterator, typename KeyFunction>
+void countingSortByKey(const Iterator begin, const Iterator end, KeyFunction key, std::size_t threads = 1)
+{
+    countingSortByKey(execution::par.withThreads(threads), begin, end, key);
+}
+
+// CountingKeyIdentity: 以元素本身为键
+struct CountingKeyIdentity
+{
+    template<typename T>
+    T operator() (const T &x) const { return x; }
+};
+
+// countingSort: 按执行策略的计数排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为counting_parallel_threshold;
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \return void.
+ *
+ * 以元素本身为键调用countingSortByKey: 不需要给出最大值, 负数也可以排序; 取值范围达到counting_sort_max_range时
+ * 抛出std::invalid_argument.
+ *
+ */
+template<typename Iterator>
+void countingSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    static_assert(std::is_integral<T>::value, "sequence to be sorted must be integer!");
+    countingSortByKey(exec, begin, end, CountingKeyIdentity());
+}
 #endif
@@ -15,6 +15,8 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <random>
+#include <string>
 #include "countingSort.h"
 
 // 数组输出函数
@@ -138,6 +140,103 @@ void Test3()
     print(compareData4.begin(), compareData4.end()); 
 }
 
+// 按分片号(可以为负数)排序的记录
+struct Event
+{
+    int shard;
+    std::size_t order;      // 原来的次序, 用于检查稳定性
+    std::string payload;
+};
+
+bool stableByShard(const vector<Event> &events)
+{
+    for (std::size_t i = 1; i < events.size(); ++i){
+        if (events[i].shard < events[i - 1].shard)
+            return false;
+        if (events[i].shard == events[i - 1].shard && events[i].order < events[i - 1].order)
+            return false;
+    }
+    return true;
+}
+
+void Test4()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-20, 20);
+    auto shardOf = [](const Event &event) { return event.shard; };
+    vector<Event> output;       // 重复使用的输出序列
+    bool stable = true;
+    for (std::size_t size : {1, 10, 1000}){
+        vector<Event> events;
+        for (std::size_t i = 0; i != size; ++i)
+            events.push_back(Event{u(e), i, "event" + std::to_string(i)});
+        countingSortByKey(events.begin(), events.end(), shardOf, output);
+        stable = stable && stableByShard(vector<Event>(output.begin(), output.begin() + size));
+    }
+    cout << "按负数分片号排序的稳定性: " << (stable ? "正确" : "错误") << endl;
+
+    // 取值集中在较大数值附近的键, 多线程统计
+    std::uniform_int_distribution<long long> big(1000000000000LL, 1000000001000LL);
+    vector<long long> keys(2000000);
+    for (auto &k : keys)
+        k = big(e);
+    vector<long long> compareKeys(keys);
+    countingSortByKey(keys.begin(), keys.end(), [](long long k) { return k; }, 4);
+    sort(compareKeys.begin(), compareKeys.end());
+    cout << "较大数值附近的键(4个线程): " << (keys == compareKeys ? "正确" : "错误") << endl;
+
+    // 不给出最大值
+    vector<int> data(10000);
+    for (auto &x : data)
+        x = u(e) + 20;
+    vector<int> compareData(data);
+    countingSort(data.begin(), data.end());
+    sort(compareData.begin(), compareData.end());
+    bool thrown = false;
+    try{
+        vector<int> negative{3, -1, 2};
+        countingSort(negative.begin(), negative.end());
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    cout << "自动求最大值(负数时抛出异常): " << (data == compareData && thrown ? "正确" : "错误") << endl;
+}
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 255);
+    vector<int> data(10000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    // 计数数组与暂存数组放在调用者提供的缓冲区中, 不调用operator new
+    alignas(std::max_align_t) static char buffer[64 * 1024];
+    MonotonicBufferResource arena(buffer, sizeof(buffer));
+    countingSort(data.begin(), data.end(), &arena);
+    sort(compareData.begin(), compareData.end());
+    bool right = data == compareData && arena.chunkCount() == 0 && arena.bytesAllocated() >= data.size() * sizeof(int);
+    cout << "从MemoryResource分配计数数组: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-1000, 1000);
+    vector<int> data(100000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end());
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4).withGrain(1000)};
+    const char *names[] = {"seq", "par", "par(4线程, 粒度1000)"};
+    for (int p = 0; p != 3; ++p){
+        vector<int> sorted(data);
+        countingSort(policies[p], sorted.begin(), sorted.end());
+        cout << names[p] << " 含负数: " << (sorted == compareData ? "正确" : "错误") << endl;
+    }
+}
+
 int main()
 {
     cout << "******************对C数组升序排列测试******************\n";
@@ -148,5 +247,14 @@ int main()
     cout << "******************对vector数组升序排列测试*************\n";
     Test3();
 
+    cout << "***************按键投影的计数排序测试******************\n";
+    Test4();
+
+    cout << "***************从MemoryResource分配的计数排序**********\n";
+    Test5();
+
+    cout << "***************执行策略测试****************************\n";
+    Test6();
+
     return 0;
 }
@@ -0,0 +1,356 @@
+/*************************************************************************
+	> File Name: externalSort.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 17时10分26秒
+ ************************************************************************/
+
+#ifndef _EXTERNALSORT_H
+#define _EXTERNALSORT_H
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../quick_sort/quickSort.h"
+
+const std::size_t external_min_block_bytes = 1 << 16;   // 归并时每个读写缓冲区的最小字节数
+
+// LoserTree: 败者树, 用于k路归并  算法导论6.5练习6.5-9
+/*
+ * 内部结点保存在该结点比赛中失败的叶子编号, tree[0]保存最终的胜者.
+ * 某一路的当前元素被取走后只需要沿着它到根的路径重新比赛一次, 每次logk次比较,
+ * 比二叉堆的"下沉"(每层两次比较)更少.
+ * 已经取完的路视为无穷大; 相等时编号小的一路获胜.
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+class LoserTree
+{
+public:
+    //****************************构造函数*******************************
+    // k: 归并的路数; heads: 每一路的当前元素(由调用者维护); exhausted: 每一路是否已经取完
+    LoserTree(std::size_t k, const std::vector<T> &h, const std::vector<char> &e, CompareType c = CompareType())
+        : heads(h), exhausted(e), compare(c), tree(k == 0 ? 1 : k, 0)
+    {
+        std::size_t n = tree.size();
+        std::vector<std::size_t> winner(2 * n, 0);
+        for (std::size_t i = 0; i != n; ++i)
+            winner[n + i] = i;
+        for (std::size_t node = n - 1; node >= 1; --node){
+            std::size_t a = winner[2 * node], b = winner[2 * node + 1];
+            if (beats(a, b)){
+                winner[node] = a;
+                tree[node] = b;
+            }else{
+                winner[node] = b;
+                tree[node] = a;
+            }
+        }
+        tree[0] = (n == 1) ? 0 : winner[1];
+    }
+    //****************************成员函数*******************************
+    // winner: 当前最小元素所在的路
+    std::size_t winner() const { return tree[0]; }
+
+    // replay: 第i路的当前元素改变(或取完)以后重新比赛
+    void replay(std::size_t i)
+    {
+        std::size_t n = tree.size();
+        std::size_t win = i;
+        for (std::size_t node = (n + i) / 2; node >= 1; node /= 2){
+            if (beats(tree[node], win))
+                std::swap(tree[node], win);
+        }
+        tree[0] = win;
+    }
+private:
+    const std::vector<T> &heads;
+    const std::vector<char> &exhausted;
+    CompareType compare;
+    std::vector<std::size_t> tree;
+
+    // beats: 第a路是否胜过第b路
+    bool beats(std::size_t a, std::size_t b)
+    {
+        if (exhausted[a])
+            return false;
+        if (exhausted[b])
+            return true;
+        if (compare(heads[a], heads[b]))
+            return true;
+        return !compare(heads[b], heads[a]) && a < b;
+    }
+};
+
+// RunReader: 顺序读取一个二进制有序段, 双缓冲并异步预读
+/*
+ * 调用者消费当前缓冲区时, 另一个缓冲区由后台任务读取下一块, 读盘与归并重叠.
+ *
+ */
+template<typename T>
+class RunReader
+{
+public:
+    RunReader(const std::string &filename, std::size_t block)
+        : file(std::fopen(filename.c_str(), "rb")), current(block), back(block), position(0), length(0), name(filename)
+    {
+        if (!file)
+            throw std::runtime_error("externalSort error: 无法打开有序段 " + filename);
+        try{
+            prefetch();
+            fill();
+        }catch (...){
+            if (pending.valid())
+                pending.wait();
+            std::fclose(file);
+            throw;
+        }
+    }
+    RunReader(const RunReader &) = delete;
+    RunReader& operator= (const RunReader &) = delete;
+    ~RunReader()
+    {
+        if (pending.valid())
+            pending.wait();
+        std::fclose(file);
+    }
+    // empty: 是否已经读完
+    bool empty() const { return position == length; }
+    // front: 当前元素
+    const T& front() const { return current[position]; }
+    // pop: 取走当前元素
+    void pop()
+    {
+        if (++position == length)
+            fill();
+    }
+private:
+    std::FILE *file;
+    std::vector<T> current, back;
+    std::size_t position, length;
+    std::string name;
+    std::future<std::size_t> pending;       // 正在预读的一块(字节数)
+
+    void prefetch()
+    {
+        T *data = back.data();
+        std::FILE *f = file;
+        std::size_t bytes = back.size() * sizeof(T);
+        pending = std::async(std::launch::async, [f, data, bytes]{ return std::fread(data, 1, bytes, f); });
+    }
+    // fill: 换上预读好的缓冲区, 并开始预读下一块; 读文件失败或者文件末尾有不完整的记录时抛出异常
+    void fill()
+    {
+        position = 0;
+        length = 0;
+        std::size_t bytes = pending.valid() ? pending.get() : 0;
+        if (bytes != back.size() * sizeof(T) && std::ferror(file))
+            throw std::runtime_error("externalSort error: 读文件失败 " + name);
+        if (bytes % sizeof(T) != 0)
+            throw std::runtime_error("externalSort error: 文件末尾有不完整的记录 " + name);
+        length = bytes / sizeof(T);
+        if (length == 0)
+            return;
+        current.swap(back);
+        if (length == current.size())
+            prefetch();
+    }
+};
+
+// RunWriter: 顺序写出二进制文件, 双缓冲并异步写盘
+template<typename T>
+class RunWriter
+{
+public:
+    RunWriter(const std::string &filename, std::size_t block)
+        : file(std::fopen(filename.c_str(), "wb")), current(), back(), name(filename)
+    {
+        if (!file)
+            throw std::runtime_error("externalSort error: 无法创建文件 " + filename);
+        current.reserve(block);
+        back.reserve(block);
+    }
+    RunWriter(const RunWriter &) = delete;
+    RunWriter& operator= (const RunWriter &) = delete;
+    ~RunWriter()
+    {
+        if (pending.valid())
+            pending.wait();
+        if (file)
+            std::fclose(file);
+    }
+    void push(const T &value)
+    {
+        current.push_back(value);
+        if (current.size() == current.capacity())
+            flush();
+    }
+    // close: 写出剩余数据并关闭文件, 写盘失败时抛出异常
+    void close()
+    {
+        flush();
+        wait();
+        bool failed = std::fclose(file) != 0;
+        file = nullptr;
+        if (failed)
+            throw std::runtime_error("externalSort error: 写文件失败 " + name);
+    }
+private:
+    std::FILE *file;
+    std::vector<T> current, back;
+    std::string name;
+    std::future<bool> pending;      // 正在写盘的一块
+
+    void wait()
+    {
+        if (pending.valid() && !pending.get())
+            throw std::runtime_error("externalSort error: 写文件失败 " + name);
+    }
+    void flush()
+    {
+        if (current.empty())
+            return;
+        wait();
+        back.swap(current);
+        current.clear();
+        std::FILE *f = file;
+        const T *data = back.data();
+        std::size_t count = back.size();
+        pending = std::async(std::launch::async, [f, data, count]{ return std::fwrite(data, sizeof(T), count, f) == count; });
+    }
+};
+
+// mergeRuns: 用败者树把若干个有序段归并为一个文件
+template<typename T, typename CompareType>
+void mergeRuns(const std::vector<std::string> &runs, const std::string &output, std::size_t block, CompareType compare)
+{
+    std::vector<std::unique_ptr<RunReader<T>>> readers;
+    std::vector<T> heads(runs.size());
+    std::vector<char> exhausted(runs.size(), 0);
+    for (std::size_t i = 0; i != runs.size(); ++i){
+        readers.emplace_back(new RunReader<T>(runs[i], block));
+        if (readers[i]->empty())
+            exhausted[i] = 1;
+        else
+            heads[i] = readers[i]->front();
+    }
+    RunWriter<T> writer(output, block);
+    LoserTree<T, CompareType> tree(runs.size(), heads, exhausted, compare);
+    while (true){
+        std::size_t i = tree.winner();
+        if (exhausted[i])
+            break;
+        writer.push(heads[i]);
+        readers[i]->pop();
+        if (readers[i]->empty())
+            exhausted[i] = 1;
+        else
+            heads[i] = readers[i]->front();
+        tree.replay(i);
+    }
+    writer.close();
+}
+
+// externalSort: 外部排序(多路归并排序), 用于比内存大得多的二进制数据文件
+/*
+ * \parameter input: 输入文件, 由连续存放的T类型记录组成(二进制格式);
+ * \parameter output: 输出文件, 格式与输入相同;
+ * \parameter memory_budget: 可以使用的内存字节数;
+ * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+ * \parameter threads: 内存内排序使用的线程个数(包括调用线程);
+ * \parameter temp_prefix: 临时有序段文件名的前缀, 默认为output;
+ * \return void.
+ *
+ * 算法基本思想:
+ *      --生成有序段: 每次从输入文件读取memory_budget字节的一块, 用parallelQuickSort在内存中排序,
+ *        作为一个有序段写入临时文件;
+ *      --多路归并: 每一路有两个读缓冲区(一个被消费, 另一个在后台预读), 输出也有两个写缓冲区,
+ *        用败者树选出最小元素. 缓冲区总大小不超过memory_budget, 路数太多而缓冲区小于
+ *        external_min_block_bytes时分多趟归并.
+ * T必须可以按字节复制(trivially copyable). 文件读写失败或者文件的长度不是sizeof(T)的整数倍时抛出std::runtime_error,
+ * 并删除已经写出的临时有序段.
+ *
+ * 算法性能: 时间复杂度为O(NlogN), 磁盘读写的趟数为1 + ceil(log_k(R)), R为有序段的个数, k为每趟的路数.
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+void externalSort(const std::string &input, const std::string &output, std::size_t memory_budget,
+                  CompareType compare = CompareType(), std::size_t threads = WorkStealingPool::defaultThreads(),
+                  const std::string &temp_prefix = std::string())
+{
+    static_assert(std::is_trivially_copyable<T>::value, "externalSort only supports trivially copyable records!");
+    const std::string prefix = temp_prefix.empty() ? output : temp_prefix;
+    const std::size_t chunk = std::max<std::size_t>(1, memory_budget / sizeof(T));
+    std::vector<std::string> runs, merged;     // merged: 多趟归并中这一趟已经写出的有序段
+    std::size_t next_run = 0;
+    auto runName = [&prefix, &next_run]{ return prefix + ".run" + std::to_string(next_run++); };
+    auto removeRuns = [](const std::vector<std::string> &names){
+        for (auto &name : names)
+            std::remove(name.c_str());
+    };
+    try{
+        // 第一步: 生成有序段
+        {
+            std::unique_ptr<std::FILE, int (*)(std::FILE *)> in(std::fopen(input.c_str(), "rb"), &std::fclose);
+            if (!in)
+                throw std::runtime_error("externalSort error: 无法打开输入文件 " + input);
+            std::vector<T> data(chunk);
+            while (true){
+                std::size_t bytes = std::fread(data.data(), 1, chunk * sizeof(T), in.get());
+                if (bytes != chunk * sizeof(T) && std::ferror(in.get()))
+                    throw std::runtime_error("externalSort error: 读文件失败 " + input);
+                if (bytes % sizeof(T) != 0)
+                    throw std::runtime_error("externalSort error: 输入文件末尾有不完整的记录 " + input);
+                std::size_t count = bytes / sizeof(T);
+                if (count == 0)
+                    break;
+                parallelQuickSort(data.begin(), data.begin() + count, compare, threads);
+                runs.push_back(runName());
+                std::unique_ptr<std::FILE, int (*)(std::FILE *)> out(std::fopen(runs.back().c_str(), "wb"), &std::fclose);
+                if (!out || std::fwrite(data.data(), sizeof(T), count, out.get()) != count
+                    || std::fclose(out.release()) != 0)
+                    throw std::runtime_error("externalSort error: 写有序段失败 " + runs.back());
+                if (count < chunk)
+                    break;
+            }
+        }
+        if (runs.empty()){
+            std::unique_ptr<std::FILE, int (*)(std::FILE *)> out(std::fopen(output.c_str(), "wb"), &std::fclose);
+            if (!out)
+                throw std::runtime_error("externalSort error: 无法创建文件 " + output);
+            return;
+        }
+        // 第二步: 多路归并, 每一路2个读缓冲区, 输出2个写缓冲区
+        std::size_t min_block = std::max<std::size_t>(1, external_min_block_bytes / sizeof(T));
+        std::size_t fan_in = chunk / (2 * min_block);
+        fan_in = fan_in > 3 ? fan_in - 1 : 2;
+        while (runs.size() > fan_in){
+            merged.clear();
+            for (std::size_t first = 0; first < runs.size(); first += fan_in){
+                std::vector<std::string> group(runs.begin() + first,
+                                               runs.begin() + std::min(runs.size(), first + fan_in));
+                merged.push_back(runName());
+                std::size_t block = std::max<std::size_t>(1, chunk / (2 * (group.size() + 1)));
+                mergeRuns<T>(group, merged.back(), block, compare);
+                removeRuns(group);
+            }
+            runs.swap(merged);
+        }
+        merged.clear();
+        std::size_t block = std::max<std::size_t>(1, chunk / (2 * (runs.size() + 1)));
+        mergeRuns<T>(runs, output, block, compare);
+        removeRuns(runs);
+    }catch (...){
+        removeRuns(runs);
+        removeRuns(merged);
+        throw;
+    }
+}
+#endif
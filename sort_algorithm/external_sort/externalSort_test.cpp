@@ -0,0 +1,109 @@
+/*************************************************************************
+	> File Name: externalSort_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 17时48分03秒
+ ************************************************************************/
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+using std::sort;
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include "externalSort.h"
+
+// 把数组以二进制格式写入文件
+template<typename T>
+void writeFile(const std::string &filename, const vector<T> &data)
+{
+    std::FILE *out = std::fopen(filename.c_str(), "wb");
+    if (!data.empty())
+        std::fwrite(data.data(), sizeof(T), data.size(), out);
+    std::fclose(out);
+}
+
+// 从二进制文件读出全部记录
+template<typename T>
+vector<T> readFile(const std::string &filename)
+{
+    vector<T> data;
+    std::FILE *in = std::fopen(filename.c_str(), "rb");
+    T value;
+    while (std::fread(&value, sizeof(T), 1, in) == 1)
+        data.push_back(value);
+    std::fclose(in);
+    return data;
+}
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<std::int64_t> u(-1000000, 1000000);
+    vector<std::int64_t> data(1 << 20);
+    for (auto &x : data)
+        x = u(e);
+    writeFile("externalInput", data);
+    sort(data.begin(), data.end());
+
+    // 8MB内存, 只有一个有序段
+    externalSort<std::int64_t>("externalInput", "externalOutput", 8 << 20);
+    cout << "一个有序段: " << (readFile<std::int64_t>("externalOutput") == data ? "正确" : "错误") << endl;
+
+    // 1MB内存, 8个有序段, 每趟最多7路(每路2个64KB的读缓冲区, 输出占一路), 两趟归并
+    externalSort<std::int64_t>("externalInput", "externalOutput", 1 << 20, std::less<std::int64_t>(), 2);
+    cout << "两趟归并: " << (readFile<std::int64_t>("externalOutput") == data ? "正确" : "错误") << endl;
+
+    // 256KB内存, 32个有序段, 每趟只能归并较少的路, 需要多趟归并
+    externalSort<std::int64_t>("externalInput", "externalOutput", 1 << 18);
+    cout << "多趟归并: " << (readFile<std::int64_t>("externalOutput") == data ? "正确" : "错误") << endl;
+
+    externalSort<std::int64_t>("externalInput", "externalOutput", 1 << 18, std::greater<std::int64_t>());
+    std::reverse(data.begin(), data.end());
+    cout << "降序排列: " << (readFile<std::int64_t>("externalOutput") == data ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    writeFile("externalInput", vector<int>());
+    externalSort<int>("externalInput", "externalOutput", 1 << 20);
+    cout << "空文件: " << (readFile<int>("externalOutput").empty() ? "正确" : "错误") << endl;
+
+    bool thrown = false;
+    try{
+        externalSort<int>("externalMissing", "externalOutput", 1 << 20);
+    }catch (const std::runtime_error &error){
+        thrown = true;
+    }
+    cout << "输入文件不存在时抛出异常: " << (thrown ? "正确" : "错误") << endl;
+
+    // 末尾有不完整的记录(5个字节不是int的整数倍), 抛出异常并删除临时文件
+    writeFile("externalInput", vector<char>(5, 'x'));
+    thrown = false;
+    try{
+        externalSort<int>("externalInput", "externalOutput", 1 << 20, std::less<int>(), 1, "externalTemp");
+    }catch (const std::runtime_error &error){
+        thrown = true;
+    }
+    std::FILE *run = std::fopen("externalTemp.run0", "rb");
+    cout << "不完整的记录抛出异常: " << (thrown && !run ? "正确" : "错误") << endl;
+    if (run)
+        std::fclose(run);
+    std::remove("externalInput");
+    std::remove("externalOutput");
+}
+
+int main()
+{
+    cout << "****************外部排序测试***************************\n";
+    Test1();
+
+    cout << "****************边界情况测试***************************\n";
+    Test2();
+
+    return 0;
+}
@@ -8,9 +8,15 @@
 #ifndef _HEAPSORT_H
 #define _HEAPSORT_H
 
+#include <algorithm>
 #include <iostream>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
+#include "../merge_sort/mergeSort.h"
 // HeapSort: 用于堆排序的堆, 算法导论 6.1~6.4
 /* 
  * 堆排序的算法思想: 假设对数组A[p,...,r]排序
@@ -54,11 +60,55 @@ public:
         size = std::distance(begin, end);
         buildMaxHeap(compare);  // 建立最大堆
         while (size > 0){
-            std::swap(*from, *(from + size - 1));
+            std::iter_swap(from, from + size - 1);
             --size;
             heapify(0, compare);
         }
     }
+    // operator() 按执行策略排序
+    /*
+     * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_merge_threshold;
+     * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+     * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+     * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+     * \return void.
+     *
+     * 串行策略或序列长度小于exec.grain(parallel_merge_threshold)时与上面的版本相同, 原址排序.
+     * 堆排序每次取出堆顶都依赖上一次的结果, 无法拆开并行, 所以并行版本把序列均分为exec.threads()段,
+     * 每个任务用自己的HeapSort对象原址排好一段, 再由parallelMergeRuns(见mergeSort.h)逐层并行归并:
+     * 时间为O(NlogN / P + logP * logN), 需要O(N)的辅助空间.
+     *
+     */
+    void operator() (const ExecutionPolicy &exec, const Iterator begin, const Iterator end,
+                     CompareType compare = CompareType())
+    {
+        typedef typename std::iterator_traits<Iterator>::value_type T;
+        std::size_t n = std::distance(begin, end);
+        if (!exec.runParallel(n, parallel_merge_threshold)){
+            (*this)(begin, end, compare);
+            return;
+        }
+        const std::size_t threads = exec.threads();
+        WorkStealingPool &pool = exec.pool();
+        std::vector<std::size_t> bounds;
+        for (std::size_t c = 0; c <= threads; ++c)
+            bounds.push_back(n * c / threads);
+        {
+            TaskGroup group(pool);
+            for (std::size_t c = 0; c != threads; ++c){
+                std::size_t low = bounds[c], high = bounds[c + 1];
+                group.run([=]{
+                    HeapSort sorter;
+                    sorter(begin + low, begin + high, compare);
+                });
+            }
+            group.wait();
+        }
+        std::vector<T> buffer(n);
+        parallelMergeRuns(pool, begin, buffer.data(), bounds, threads, compare);
+        from = begin;
+        size = 0;
+    }
 
 private:   
     // 数据结构
@@ -177,7 +227,7 @@ private:
 
         // 如果最大节点位置不是本身
         if (maxIndex != elementIndex){
-            std::swap(*(from + elementIndex), *(from + maxIndex));
+            std::iter_swap(from + elementIndex, from + maxIndex);
             heapify(maxIndex, compare);     // 递归调用
         }
     }
@@ -203,4 +253,175 @@ private:
         }
     }
 };
+
+// DaryHeapSort: 基于d叉堆的堆排序(缓存友好)
+/*
+ * 与HeapSort相比:
+ *      --每个节点有Arity(默认4)个孩子, 节点i的孩子为Arity*i+1,...,Arity*i+Arity, 同一节点的孩子相邻存放,
+ *        通常在同一条缓存行中; 树高为log_Arity(N), 访问的缓存行更少;
+ *      --下沉操作是迭代的, 被下沉的元素只移动一次(先把孩子依次上移, 最后放入空位), 不再逐层交换;
+ *      --取出堆顶时采用Floyd的方法: 空位先沿着较大的孩子一直下沉到叶节点(每层只需在孩子之间比较),
+ *        再把原来的末尾元素从该叶节点向上冒泡. 末尾元素通常很小, 冒泡很少超过一两层,
+ *        比每层都和被下沉元素比较少了大约一半的比较;
+ *      --下沉过程中预取孙子节点所在的缓存行.
+ *
+ * 算法性能: O(NlogN), 原址排序, 不稳定.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         std::size_t Arity = 4>
+class DaryHeapSort
+{
+public:
+    static_assert(Arity >= 2, "heap arity must be at least 2!");
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+
+    DaryHeapSort(): from(), size(0) {  }
+    ~DaryHeapSort() = default;
+    // operator() 堆排序算法启动.
+    /*
+     * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+     * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+     * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+     * \return void.
+     *
+     */
+    void operator() (const Iterator begin, const Iterator end, CompareType compare = CompareType())
+    {
+        from = begin;
+        size = std::distance(begin, end);
+        buildHeap(compare);
+        sortHeap(compare);
+    }
+
+    // partialSort: 部分排序, 使[begin, middle)为整个序列中最小的middle-begin个元素并且有序
+    /*
+     * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+     * \parameter middle: 只需要排好[begin, middle)这一段;
+     * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+     * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+     * \return void.
+     *
+     * 算法基本思想: 在[begin, middle)上建立最大堆, 堆顶是目前选出的元素中最大的一个;
+     * [middle, end)中的元素只需和堆顶比较一次, 小于堆顶时与堆顶交换并下沉; 最后对堆排序.
+     * [middle, end)中剩余元素的次序不确定.
+     *
+     * 算法性能: O(NlogM), M = middle - begin, 原址操作, 不稳定.
+     *
+     */
+    void partialSort(const Iterator begin, const Iterator middle, const Iterator end, CompareType compare = CompareType())
+    {
+        from = begin;
+        size = std::distance(begin, middle);
+        if (size == 0)
+            return;
+        buildHeap(compare);
+        for (auto current = middle; current != end; ++current){
+            if (compare(*current, *from)){
+                std::iter_swap(current, from);
+                siftDown(0, compare);
+            }
+        }
+        sortHeap(compare);
+    }
+
+private:
+    // 数据结构
+    Iterator from;      // 堆根节点的位置
+    std::size_t size;   // 堆大小
+
+    // buildHeap: 从最后一个非叶节点开始依次下沉, 建立最大堆
+    void buildHeap(CompareType &compare)
+    {
+        if (size <= 1)
+            return;
+        for (std::size_t index = (size - 2) / Arity + 1; index-- > 0; )
+            siftDown(index, compare);
+    }
+
+    // sortHeap: 依次把堆顶移到末尾, 完成排序
+    void sortHeap(CompareType &compare)
+    {
+        while (size > 1){
+            --size;
+            T value = std::move(*(from + size));
+            *(from + size) = std::move(*from);
+            siftToBottomThenUp(std::move(value), compare);
+        }
+    }
+
+    // prefetchChildren: 预取节点index的第一个孩子所在的缓存行
+    void prefetchChildren(std::size_t index) const
+    {
+#if defined(__GNUC__)
+        std::size_t child = Arity * index + 1;
+        if (child < size)
+            __builtin_prefetch(std::addressof(*(from + child)));
+#endif
+    }
+
+    // maxChild: 节点index的孩子中最大的一个(调用者保证至少有一个孩子)
+    std::size_t maxChild(std::size_t index, CompareType &compare) const
+    {
+        std::size_t first = Arity * index + 1;
+        std::size_t last = first + Arity < size ? first + Arity : size;
+        std::size_t largest = first;
+        for (std::size_t child = first + 1; child < last; ++child){
+            if (compare(*(from + largest), *(from + child)))
+                largest = child;
+        }
+        return largest;
+    }
+
+    // siftDown: 迭代地下沉节点index, 维护最大堆的性质(用于建堆)
+    void siftDown(std::size_t hole, CompareType &compare)
+    {
+        T value = std::move(*(from + hole));
+        while (Arity * hole + 1 < size){
+            std::size_t child = maxChild(hole, compare);
+            prefetchChildren(child);
+            if (!compare(value, *(from + child)))
+                break;
+            *(from + hole) = std::move(*(from + child));
+            hole = child;
+        }
+        *(from + hole) = std::move(value);
+    }
+
+    // siftToBottomThenUp: 根节点为空位, 先沿较大的孩子下沉到叶节点, 再把value从该叶节点向上冒泡
+    void siftToBottomThenUp(T value, CompareType &compare)
+    {
+        std::size_t hole = 0;
+        while (Arity * hole + 1 < size){
+            std::size_t child = maxChild(hole, compare);
+            prefetchChildren(child);
+            *(from + hole) = std::move(*(from + child));
+            hole = child;
+        }
+        while (hole > 0){
+            std::size_t parent = (hole - 1) / Arity;
+            if (!compare(*(from + parent), value))
+                break;
+            *(from + hole) = std::move(*(from + parent));
+            hole = parent;
+        }
+        *(from + hole) = std::move(value);
+    }
+};
+
+// partialSort: 部分排序(基于4叉堆)
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter middle: [begin, middle)存放最小的middle-begin个元素, 并且有序;
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+ * \return void.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void partialSort(const Iterator begin, const Iterator middle, const Iterator end, CompareType compare = CompareType())
+{
+    DaryHeapSort<Iterator, CompareType> sorter;
+    sorter.partialSort(begin, middle, end, compare);
+}
 #endif
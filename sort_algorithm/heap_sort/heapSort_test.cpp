@@ -13,6 +13,7 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <random>
 #include "heapSort.h"
 
 // 数组输出函数
@@ -232,6 +233,87 @@ void Test4()
     print(compareData4.begin(), compareData4.end());
 }
 
+// 统计比较次数的小于比较
+struct CountingLess
+{
+    std::size_t *count;
+    bool operator() (int a, int b) const { ++*count; return a < b; }
+};
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100000, 100000);
+    vector<int> data(100000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end());
+
+    vector<int> data1(data), data2(data), data3(data), data4(data);
+    std::size_t binary_count = 0, dary_count = 0;
+    HeapSort<vector<int>::iterator, CountingLess> binary;
+    binary(data1.begin(), data1.end(), CountingLess{&binary_count});
+    DaryHeapSort<vector<int>::iterator, CountingLess> quaternary;
+    quaternary(data2.begin(), data2.end(), CountingLess{&dary_count});
+    DaryHeapSort<vector<int>::iterator, std::less<int>, 8> octonary;
+    octonary(data3.begin(), data3.end());
+    DaryHeapSort<vector<int>::iterator, std::less<int>, 2> twoWay;
+    twoWay(data4.begin(), data4.end());
+    cout << "二叉堆排序: " << (data1 == compareData ? "正确" : "错误") << ", 比较次数: " << binary_count << endl;
+    cout << "4叉堆排序: " << (data2 == compareData ? "正确" : "错误") << ", 比较次数: " << dary_count << endl;
+    cout << "8叉堆排序: " << (data3 == compareData ? "正确" : "错误") << endl;
+    cout << "2叉堆(Floyd)排序: " << (data4 == compareData ? "正确" : "错误") << endl;
+
+    int data5[10] = {1,1,1,1,1,5,5,5,5,5};
+    int compareData5[10] = {5,5,5,5,5,1,1,1,1,1};
+    DaryHeapSort<int *, decltype(compareInt) *> sorter;
+    sorter(begin(data5), end(data5), compareInt);
+    cout << "有重复数字降序排列: " << (std::equal(begin(data5), end(data5), begin(compareData5)) ? "正确" : "错误") << endl;
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    vector<int> data(10000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end());
+    bool right = true;
+    for (std::size_t m : {0, 1, 10, 100, 10000}){
+        vector<int> partial(data);
+        partialSort(partial.begin(), partial.begin() + m, partial.end());
+        right = right && std::equal(partial.begin(), partial.begin() + m, compareData.begin());
+    }
+    cout << "前M个最小元素有序: " << (right ? "正确" : "错误") << endl;
+
+    vector<int> descending(data);
+    partialSort(descending.begin(), descending.begin() + 10, descending.end(), std::greater<int>());
+    cout << "前10个最大元素: ";
+    print(descending.begin(), descending.begin() + 10);
+}
+
+void Test7()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    vector<int> data(100000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end(), compareInt);
+    vector<int> data1(data), data2(data), data3(data);
+    HeapSort<vector<int>::iterator, decltype(compareInt) *> sorter;
+    sorter(execution::seq, data1.begin(), data1.end(), compareInt);
+    sorter(execution::par.withThreads(4), data2.begin(), data2.end(), compareInt);
+    sorter(execution::par_unseq.withThreads(3).withGrain(1000), data3.begin(), data3.end(), compareInt);
+    cout << "串行策略: " << (data1 == compareData ? "正确" : "错误") << endl;
+    cout << "并行策略(4线程): " << (data2 == compareData ? "正确" : "错误") << endl;
+    cout << "par_unseq(3线程, 粒度1000): " << (data3 == compareData ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     cout << "****************对C数组升序排列测试********************\n";
@@ -245,6 +327,15 @@ int main()
         
     cout << "****************对vector数组降序排列测试***************\n";
     Test4();
-    
+
+    cout << "****************d叉堆排序测试**************************\n";
+    Test5();
+
+    cout << "****************部分排序测试***************************\n";
+    Test6();
+
+    cout << "****************执行策略测试***************************\n";
+    Test7();
+
     return 0;
 }
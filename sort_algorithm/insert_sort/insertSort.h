@@ -19,6 +19,8 @@
  * 设当前排序的元素是A[i],则A[1,...i-1]是排序好的,A[i]在A[1,...,i-1]中找到它的位置,然后插入其中.
 */
 #include <functional>
+#include <iterator>
+#include <utility>
 template<typename Iterator, typename CompareType=std::less<typename std::iterator_traits<Iterator>::value_type>>
 void insertSort(const Iterator begin, const Iterator end, CompareType compare=CompareType())
 {
@@ -29,12 +31,12 @@ void insertSort(const Iterator begin, const Iterator end, CompareType compare=Co
     auto current = begin;
     while (++current != end){
         auto smallNext = current;       // 指向比*current小的元素中 最大的那一个a
-        auto key = *current;
+        auto key = std::move(*current);
         while (smallNext != begin && compare(key, *(smallNext-1))){
-            *smallNext = *(smallNext - 1);     // 后移
+            *smallNext = std::move(*(smallNext - 1));     // 后移
             --smallNext;
         }
-        *smallNext = key;
+        *smallNext = std::move(key);
     }
 }
 #endif
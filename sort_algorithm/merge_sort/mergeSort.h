@@ -9,14 +9,20 @@
 #define _MERGESORT_H
 
 #include <functional>
+#include <iterator>
+#include <utility>
 #include <vector>
 #include <algorithm>
+#include "../insert_sort/insertSort.h"
+#include "../../tree_algorithm/NodeArena/MemoryResource.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
 // merge   算法导论 2.3.1
 /*!
  *\parameter begin: begin...middle之间为已排好序列;
  *\parameter end: middle...end之间为已排好序列;
  *\parameter middle: begin...middle; middle...end都为已排好序列;
  *\parameter compare: 一个可调用对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ *\parameter arena: 暂存结果的数组的来源(见MemoryResource.h), 默认为nullptr(operator new);
  *\retrun void;
  * 
  * 算法性能: O(N);
@@ -26,11 +32,12 @@
  * 非原址排序,归并需要额外的空间 O(N). 
 */
 template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
-void merge(const Iterator begin, const Iterator end, const Iterator middle, CompareType compare = CompareType())
+void merge(const Iterator begin, const Iterator end, const Iterator middle, CompareType compare = CompareType(),
+           MemoryResource *arena = nullptr)
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;      // 迭代器指向对象的类型
     if (std::distance(begin, middle) <= 0 || std::distance(middle, end) <= 0)   return;
-    std::vector<T> result(begin, end);      // 暂存结果
+    ResourceVector<T> result(begin, end, ResourceAllocator<T>(arena));      // 暂存结果
     auto current = result.begin();
     auto left_current = begin;      // 左侧序列的当前比较位置
     auto right_current = middle;    // 右侧序列的当前比较位置
@@ -55,6 +62,8 @@ void merge(const Iterator begin, const Iterator end, const Iterator middle, Comp
  * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组某元素的指针)
  * \parameter end: 待排序序列的终止迭代器(也可以是指向数组某元素的指针)
  * \parameter compare: 一个可调用对象, 可用于比较两个对象小于, 默认std::less<T>
+ * \parameter arena: 每次merge的暂存数组的来源, 默认为nullptr(operator new). 单调的缓冲区(MonotonicBufferResource)
+ *   不回收内存, 累计为O(NlogN)个元素, 这时bottomUpMergeSort只需要一块(N+1)/2的辅助空间;
  * \return void
  *
  * 算法性能: O(NlogN);
@@ -66,14 +75,438 @@ void merge(const Iterator begin, const Iterator end, const Iterator middle, Comp
  * 整个算法需要额外的空间 O(N);
 */
 template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
-void mergeSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+void mergeSort(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+               MemoryResource *arena = nullptr)
 {
     auto size = std::distance(begin, end);
     if (size > 1){
         Iterator middle = begin + size / 2;
-        mergeSort(begin, middle, compare);
-        mergeSort(middle, end, compare);
-        merge(begin, end, middle, compare);
+        mergeSort(begin, middle, compare, arena);
+        mergeSort(middle, end, compare, arena);
+        merge(begin, end, middle, compare, arena);
     }
 }
+
+const std::ptrdiff_t merge_sort_run = 32;      // 自底向上归并前用插入排序排好的初始段的长度
+
+// mergeWithBuffer: 借助辅助空间的稳定归并
+/*
+ * \parameter begin: begin...middle之间为已排好序列;
+ * \parameter middle: middle...end之间为已排好序列;
+ * \parameter end: 序列的终止迭代器;
+ * \parameter buffer: 辅助空间, 能存放两段中较短一段的元素即可;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于;
+ * \return void.
+ *
+ * 算法基本思想:
+ *      --若A[middle-1] <= A[middle], 两段已经有序, 直接返回;
+ *      --左段较短时, 把左段移到buffer, 从前往后归并; 右段较短时, 把右段移到buffer, 从后往前归并;
+ *      --两段元素相等时总是先取左段的元素, 保证稳定性;
+ *      --元素只被移动(std::move), 不被拷贝.
+ * 算法性能: O(N), 额外空间为min(左段长度, 右段长度).
+ *
+ */
+template<typename Iterator, typename CompareType>
+void mergeWithBuffer(const Iterator begin, const Iterator middle, const Iterator end,
+                     typename std::iterator_traits<Iterator>::value_type *buffer, CompareType compare)
+{
+    if (begin == middle || middle == end || !compare(*middle, *(middle - 1)))
+        return;
+    auto left_size = std::distance(begin, middle);
+    auto right_size = std::distance(middle, end);
+    if (left_size <= right_size){
+        auto buffer_end = std::move(begin, middle, buffer);
+        auto left = buffer;
+        auto right = middle;
+        auto out = begin;
+        while (left != buffer_end && right != end){
+            if (compare(*right, *left))
+                *out++ = std::move(*right++);
+            else
+                *out++ = std::move(*left++);
+        }
+        std::move(left, buffer_end, out);   // 右段剩余的元素已经在正确的位置上
+    }else{
+        auto buffer_end = std::move(middle, end, buffer);
+        auto left = middle;         // 左段中下一个待归并元素的后一个位置
+        auto right = buffer_end;    // buffer中下一个待归并元素的后一个位置
+        auto out = end;
+        while (left != begin && right != buffer){
+            if (compare(*(right - 1), *(left - 1)))
+                *--out = std::move(*--left);
+            else
+                *--out = std::move(*--right);
+        }
+        std::move_backward(buffer, right, out);  // 左段剩余的元素已经在正确的位置上
+    }
+}
+
+// bottomUpMergeSort: 自底向上, 不分配内存的归并排序
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组某元素的指针);
+ * \parameter compare: 一个可调用对象, 可用于比较两个对象小于;
+ * \parameter buffer: 调用者提供的辅助空间, 至少能存放(N+1)/2个元素, 重复使用它可以避免每次排序都分配内存;
+ * \return void.
+ *
+ * 算法思想: 
+ *      --先用插入排序把序列按merge_sort_run个元素一段排好;
+ *      --然后段长依次加倍, 用mergeWithBuffer两两归并相邻的段, 不需要递归;
+ *      --整个排序只使用一块(N+1)/2大小的辅助空间, 归并时不再为每一次merge分配std::vector.
+ * 算法性能: O(NlogN), 稳定排序, 额外空间为O(N/2).
+ *
+ */
+template<typename Iterator, typename CompareType>
+void bottomUpMergeSort(const Iterator begin, const Iterator end, CompareType compare,
+                       typename std::iterator_traits<Iterator>::value_type *buffer)
+{
+    auto size = std::distance(begin, end);
+    if (size <= 1)
+        return;
+    for (auto from = begin; from != end; ){
+        auto to = std::distance(from, end) > merge_sort_run ? from + merge_sort_run : end;
+        insertSort(from, to, compare);
+        from = to;
+    }
+    for (auto width = merge_sort_run; width < size; width *= 2){
+        for (decltype(size) low = 0; low < size - width; low += 2 * width){
+            auto high = std::min(low + 2 * width, size);
+            mergeWithBuffer(begin + low, begin + low + width, begin + high, buffer, compare);
+        }
+    }
+}
+
+// bottomUpMergeSort: 同上, 辅助空间由std::vector提供, 长度不足(N+1)/2时会被扩大
+template<typename Iterator, typename CompareType>
+void bottomUpMergeSort(const Iterator begin, const Iterator end, CompareType compare,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &buffer)
+{
+    auto size = std::distance(begin, end);
+    if (size <= 1)
+        return;
+    if (buffer.size() < static_cast<std::size_t>((size + 1) / 2))
+        buffer.resize((size + 1) / 2);
+    bottomUpMergeSort(begin, end, compare, buffer.data());
+}
+
+// bottomUpMergeSort: 自底向上的归并排序, 辅助空间在函数内一次性分配
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void bottomUpMergeSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    bottomUpMergeSort(begin, end, compare, buffer);
+}
+
+// mergePairsInto: 把keys[low,mid)与keys[mid,high)归并到key_dst, 下标随键一起移动(稳定)
+template<typename KeySrc, typename IndexSrc, typename KeyDst, typename IndexDst, typename CompareType>
+void mergePairsInto(KeySrc keys, IndexSrc indices, std::size_t low, std::size_t mid, std::size_t high,
+                    KeyDst key_dst, IndexDst index_dst, CompareType &compare)
+{
+    std::size_t left = low, right = mid, out = low;
+    while (left != mid && right != high){
+        std::size_t from = compare(keys[right], keys[left]) ? right++ : left++;
+        key_dst[out] = std::move(keys[from]);
+        index_dst[out++] = indices[from];
+    }
+    for (; left != mid; ++left, ++out){
+        key_dst[out] = std::move(keys[left]);
+        index_dst[out] = indices[left];
+    }
+    for (; right != high; ++right, ++out){
+        key_dst[out] = std::move(keys[right]);
+        index_dst[out] = indices[right];
+    }
+}
+
+// mergePermutation: 对键排序(稳定), 同时得到排序后第i个键原来的下标
+/*
+ * 键和下标存放在两个平行的数组中, 自底向上归并时在原序列与辅助空间之间交替, 每一趟都只移动键和下标.
+ *
+ */
+template<typename KeyIterator, typename IndexType, typename CompareType>
+void mergePermutation(const KeyIterator keys_begin, const KeyIterator keys_end,
+                      std::vector<IndexType> &permutation, CompareType compare)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    std::size_t size = std::distance(keys_begin, keys_end);
+    permutation.resize(size);
+    for (std::size_t i = 0; i != size; ++i)
+        permutation[i] = static_cast<IndexType>(i);
+    // 初始段: 键和下标一起插入排序
+    for (std::size_t from = 0; from < size; from += merge_sort_run){
+        std::size_t to = std::min(size, from + static_cast<std::size_t>(merge_sort_run));
+        for (std::size_t i = from + 1; i < to; ++i){
+            K key = std::move(keys_begin[i]);
+            IndexType index = permutation[i];
+            std::size_t j = i;
+            for (; j > from && compare(key, keys_begin[j - 1]); --j){
+                keys_begin[j] = std::move(keys_begin[j - 1]);
+                permutation[j] = permutation[j - 1];
+            }
+            keys_begin[j] = std::move(key);
+            permutation[j] = index;
+        }
+    }
+    if (size <= static_cast<std::size_t>(merge_sort_run))
+        return;
+    std::vector<K> key_buffer(size);
+    std::vector<IndexType> index_buffer(size);
+    bool in_buffer = false;
+    for (std::size_t width = merge_sort_run; width < size; width *= 2){
+        for (std::size_t low = 0; low < size; low += 2 * width){
+            std::size_t mid = std::min(size, low + width), high = std::min(size, low + 2 * width);
+            if (in_buffer)
+                mergePairsInto(key_buffer.begin(), index_buffer.begin(), low, mid, high,
+                               keys_begin, permutation.begin(), compare);
+            else
+                mergePairsInto(keys_begin, permutation.begin(), low, mid, high,
+                               key_buffer.begin(), index_buffer.begin(), compare);
+        }
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer){
+        std::move(key_buffer.begin(), key_buffer.end(), keys_begin);
+        permutation.swap(index_buffer);
+    }
+}
+
+// mergeSortPairs: 键值对的稳定归并排序(键和值存放在两个平行的数组中)
+/*
+ * \parameter keys_begin: 键序列的起始迭代器;
+ * \parameter keys_end: 键序列的终止迭代器;
+ * \parameter values_begin: 值序列的起始迭代器, 第i个值属于第i个键;
+ * \parameter compare: 一个可调用对象, 可用于比较两个键的小于, 默认std::less<K>;
+ * \return void.
+ *
+ * 归并的每一趟只移动键和下标, 值只在最后按下标移动一次, 不需要把键和值打包为std::pair.
+ *
+ * 算法性能: O(NlogN), 稳定排序, 额外空间为O(N).
+ *
+ */
+template<typename KeyIterator, typename ValueIterator,
+         typename CompareType = std::less<typename std::iterator_traits<KeyIterator>::value_type>>
+void mergeSortPairs(const KeyIterator keys_begin, const KeyIterator keys_end, const ValueIterator values_begin,
+                    CompareType compare = CompareType())
+{
+    typedef typename std::iterator_traits<ValueIterator>::value_type V;
+    std::vector<std::size_t> permutation;
+    mergePermutation(keys_begin, keys_end, permutation, compare);
+    std::vector<V> gathered;
+    gathered.reserve(permutation.size());
+    for (auto index : permutation)
+        gathered.push_back(std::move(values_begin[index]));
+    std::move(gathered.begin(), gathered.end(), values_begin);
+}
+
+// argsort: 返回使序列有序的下标序列(序列本身不变)
+/*
+ * \parameter begin: 序列的起始迭代器;
+ * \parameter end: 序列的终止迭代器;
+ * \parameter compare: 一个可调用对象, 可用于比较两个对象的小于, 默认std::less<T>;
+ * \return 下标序列p, 使得*(begin + p[0]) <= *(begin + p[1]) <= ..., 相等元素的下标保持升序.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+std::vector<std::size_t> argsort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> keys(begin, end);
+    std::vector<std::size_t> permutation;
+    mergePermutation(keys.begin(), keys.end(), permutation, compare);
+    return permutation;
+}
+
+const std::size_t parallel_merge_threshold = 1 << 15;  // 小于该长度的序列不并行排序
+
+// mergePathCorank: 归并路径(merge path)上的划分点
+/*
+ * \parameter a, a_size: 已排好序的左段;
+ * \parameter b, b_size: 已排好序的右段;
+ * \parameter diagonal: 归并结果中的位置d;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于;
+ * \return 稳定归并结果的前d个元素中来自左段的元素个数i(其余d-i个来自右段).
+ *
+ * 随着i增大, A[i]增大而B[d-i-1]减小, 所以"A[i]排在B[d-i-1]之前"关于i单调, 可以二分查找: O(log(d)).
+ *
+ */
+template<typename Iterator, typename CompareType>
+std::size_t mergePathCorank(Iterator a, std::size_t a_size, Iterator b, std::size_t b_size,
+                            std::size_t diagonal, CompareType compare)
+{
+    std::size_t low = diagonal > b_size ? diagonal - b_size : 0;
+    std::size_t high = diagonal < a_size ? diagonal : a_size;
+    while (low < high){
+        std::size_t i = low + (high - low) / 2;
+        std::size_t j = diagonal - i;
+        if (!compare(b[j - 1], a[i]))   // 相等时左段的元素在前
+            low = i + 1;
+        else
+            high = i;
+    }
+    return low;
+}
+
+// moveMerge: 把两段已排好序的序列稳定地归并到另一个序列中(只移动, 不拷贝)
+template<typename SrcIterator, typename DstIterator, typename CompareType>
+void moveMerge(SrcIterator a, SrcIterator a_end, SrcIterator b, SrcIterator b_end,
+               DstIterator out, CompareType compare)
+{
+    while (a != a_end && b != b_end){
+        if (compare(*b, *a))
+            *out++ = std::move(*b++);
+        else
+            *out++ = std::move(*a++);
+    }
+    out = std::move(a, a_end, out);
+    std::move(b, b_end, out);
+}
+
+// parallelMergeLevel: 并行归并排序的一层
+/*
+ * src中按bounds划分的相邻两段两两归并到dst的相同位置, 最后落单的一段直接移动过去.
+ * 每次归并按输出长度被等分成若干片, 每一片的起点由mergePathCorank确定, 各片可以独立地并行归并,
+ * 这样即使最后一层只有一次归并, 也能用上所有线程.
+ *
+ */
+template<typename SrcIterator, typename DstIterator, typename CompareType>
+void parallelMergeLevel(WorkStealingPool &pool, SrcIterator src, DstIterator dst,
+                        const std::vector<std::size_t> &bounds, std::size_t total,
+                        std::size_t threads, CompareType compare)
+{
+    TaskGroup group(pool);
+    std::size_t runs = bounds.size() - 1;
+    for (std::size_t r = 0; r < runs; r += 2){
+        std::size_t from = bounds[r];
+        std::size_t middle = bounds[r + 1];     // 落单的一段: middle == to, 右段为空
+        std::size_t to = (r + 1 < runs) ? bounds[r + 2] : bounds[r + 1];
+        std::size_t length = to - from;
+        std::size_t pieces = (length * threads + total - 1) / total;
+        if (pieces == 0)
+            pieces = 1;
+        for (std::size_t k = 0; k != pieces; ++k){
+            group.run([=]{
+                SrcIterator a = src + from;
+                SrcIterator b = src + middle;
+                std::size_t a_size = middle - from, b_size = to - middle;
+                std::size_t d0 = length * k / pieces, d1 = length * (k + 1) / pieces;
+                std::size_t i0 = mergePathCorank(a, a_size, b, b_size, d0, compare);
+                std::size_t i1 = mergePathCorank(a, a_size, b, b_size, d1, compare);
+                moveMerge(a + i0, a + i1, b + (d0 - i0), b + (d1 - i1), dst + (from + d0), compare);
+            });
+        }
+    }
+    group.wait();
+}
+
+// parallelMergeRuns: 把序列中按bounds划分的各个已排好序的段逐层两两归并, 结果留在原序列中
+/*
+ * 每一层的归并都由parallelMergeLevel按归并路径等分给threads个任务; 序列与scratch(长度不小于bounds.back())
+ * 交替作为每一层的输入和输出, 最后结果若在scratch中再并行移回原序列.
+ *
+ */
+template<typename Iterator, typename CompareType>
+void parallelMergeRuns(WorkStealingPool &pool, const Iterator begin,
+                       typename std::iterator_traits<Iterator>::value_type *scratch,
+                       std::vector<std::size_t> bounds, std::size_t threads, CompareType compare)
+{
+    const std::size_t size = bounds.back();
+    bool in_buffer = false;
+    while (bounds.size() > 2){
+        if (in_buffer)
+            parallelMergeLevel(pool, scratch, begin, bounds, size, threads, compare);
+        else
+            parallelMergeLevel(pool, begin, scratch, bounds, size, threads, compare);
+        in_buffer = !in_buffer;
+        std::vector<std::size_t> next;
+        for (std::size_t r = 0; r < bounds.size() - 1; r += 2)
+            next.push_back(bounds[r]);
+        next.push_back(size);
+        bounds.swap(next);
+    }
+    if (in_buffer){
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != threads; ++c){
+            std::size_t from = size * c / threads, to = size * (c + 1) / threads;
+            group.run([=]{ std::move(scratch + from, scratch + to, begin + from); });
+        }
+        group.wait();
+    }
+}
+
+// mergeSort: 按执行策略排序, 基于归并路径划分的多线程稳定归并排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_merge_threshold;
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组某元素的指针);
+ * \parameter compare: 一个可调用对象, 可用于比较两个对象小于;
+ * \parameter buffer: 调用者提供的辅助空间, 长度不足时会被扩大;
+ * \return void.
+ *
+ * 算法思想:
+ *      --串行策略或序列长度小于exec.grain(parallel_merge_threshold)时调用bottomUpMergeSort;
+ *      --否则把序列均分为exec.threads()段, 每个任务用bottomUpMergeSort排好一段;
+ *      --然后由parallelMergeRuns逐层两两归并, 每一层的归并都按归并路径等分给所有任务.
+ * 算法性能: O(NlogN / P + logP * logN), 稳定排序, 额外空间为O(N).
+ *
+ */
+template<typename Iterator, typename CompareType>
+void mergeSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare,
+               std::vector<typename std::iterator_traits<Iterator>::value_type> &buffer)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    auto distance = std::distance(begin, end);
+    if (distance <= 1)
+        return;
+    std::size_t size = static_cast<std::size_t>(distance);
+    if (!exec.runParallel(size, parallel_merge_threshold)){
+        bottomUpMergeSort(begin, end, compare, buffer);
+        return;
+    }
+    if (buffer.size() < size)
+        buffer.resize(size);
+    T *scratch = buffer.data();
+    const std::size_t threads = exec.threads();
+    WorkStealingPool &pool = exec.pool();
+    std::vector<std::size_t> bounds;
+    for (std::size_t c = 0; c <= threads; ++c)
+        bounds.push_back(size * c / threads);
+    {
+        // 每一段使用buffer中与自己对应的部分作为辅助空间, 互不重叠
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != threads; ++c){
+            std::size_t from = bounds[c], to = bounds[c + 1];
+            group.run([=]{ bottomUpMergeSort(begin + from, begin + to, compare, scratch + from); });
+        }
+        group.wait();
+    }
+    parallelMergeRuns(pool, begin, scratch, bounds, threads, compare);
+}
+
+// mergeSort: 按执行策略排序, 辅助空间在函数内一次性分配
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void mergeSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+    mergeSort(exec, begin, end, compare, buffer);
+}
+
+// parallelMergeSort: 多线程稳定归并排序, 等价于mergeSort(execution::par.withThreads(threads), ...)
+/*
+ * \parameter threads: 参与排序的线程个数(包括调用线程), 任务在共享的线程池中执行;
+ * \parameter buffer: 调用者提供的辅助空间, 长度不足N时会被扩大.
+ *
+ */
+template<typename Iterator, typename CompareType>
+void parallelMergeSort(const Iterator begin, const Iterator end, CompareType compare, std::size_t threads,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &buffer)
+{
+    mergeSort(execution::par.withThreads(threads), begin, end, compare, buffer);
+}
+
+// parallelMergeSort: 多线程稳定归并排序, 辅助空间在函数内一次性分配
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void parallelMergeSort(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+                       std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    mergeSort(execution::par.withThreads(threads), begin, end, compare);
+}
 #endif
@@ -12,7 +12,10 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <random>
+#include <string>
 #include "mergeSort.h"
+#include "timSort.h"
 
 // 数组输出函数
 template<typename Iterator>
@@ -227,6 +230,176 @@ void Test4()
     print(compareData4.begin(), compareData4.end());
 }
 
+// 稳定性测试用的记录: 按key排序, order记录原来的次序
+struct Record
+{
+    int key;
+    int order;
+};
+
+bool compareRecord(const Record &r1, const Record &r2)
+{
+    return r1.key < r2.key;
+}
+
+bool stableSorted(const vector<Record> &records)
+{
+    for (std::size_t i = 1; i < records.size(); ++i){
+        if (records[i].key < records[i - 1].key)
+            return false;
+        if (records[i].key == records[i - 1].key && records[i].order < records[i - 1].order)
+            return false;
+    }
+    return true;
+}
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100);
+    vector<Record> buffer;      // 多次排序重复使用
+    bool stable = true;
+    for (std::size_t size : {0, 1, 31, 33, 1000, 100001}){
+        vector<Record> records(size);
+        for (std::size_t i = 0; i != size; ++i)
+            records[i] = Record{u(e), static_cast<int>(i)};
+        bottomUpMergeSort(records.begin(), records.end(), compareRecord, buffer);
+        stable = stable && stableSorted(records);
+    }
+    cout << "自底向上归并排序的稳定性: " << (stable ? "正确" : "错误") << endl;
+
+    vector<std::string> words{"merge", "sort", "bottom", "up", "buffer", "stable", "move", "insert"};
+    bottomUpMergeSort(words.begin(), words.end());
+    print(words.begin(), words.end());
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    bool stable = true;
+    vector<Record> buffer;
+    for (std::size_t threads : {2, 3, 4, 7}){
+        vector<Record> records(200000);
+        for (std::size_t i = 0; i != records.size(); ++i)
+            records[i] = Record{u(e), static_cast<int>(i)};
+        parallelMergeSort(records.begin(), records.end(), compareRecord, threads, buffer);
+        stable = stable && stableSorted(records);
+    }
+    cout << "多线程归并排序的稳定性: " << (stable ? "正确" : "错误") << endl;
+}
+
+// 记录比较次数的比较函数
+struct CountingLess
+{
+    std::size_t *count;
+    bool operator() (int num1, int num2) { ++*count; return num1 < num2; }
+};
+
+void Test7()
+{
+    const std::size_t N = 1000000;
+    vector<int> ascending(N), descending(N), nearly(N);
+    for (std::size_t i = 0; i != N; ++i){
+        ascending[i] = static_cast<int>(i);
+        descending[i] = static_cast<int>(N - i);
+        nearly[i] = static_cast<int>(i);
+    }
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<std::size_t> position(0, N - 1);
+    for (int k = 0; k != 100; ++k)      // 在有序序列中打乱少量元素
+        std::swap(nearly[position(e)], nearly[position(e)]);
+    vector<vector<int>> inputs{ascending, descending, nearly};
+    const char *names[] = {"升序序列", "降序序列", "近似有序序列"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        vector<int> data(inputs[k]), compareData(inputs[k]);
+        std::size_t comparisons = 0;
+        timSort(data.begin(), data.end(), CountingLess{&comparisons});
+        sort(compareData.begin(), compareData.end());
+        cout << names[k] << "(N=" << N << "): " << (data == compareData ? "正确" : "错误")
+             << ", 比较次数 " << comparisons << endl;
+    }
+
+    std::uniform_int_distribution<int> u(0, 100);
+    bool stable = true;
+    TimSort<vector<Record>::iterator, bool (*)(const Record &, const Record &)> sorter;
+    for (std::size_t size : {0, 1, 31, 64, 1000, 100001}){
+        vector<Record> records(size);
+        for (std::size_t i = 0; i != size; ++i)
+            records[i] = Record{u(e), static_cast<int>(i)};
+        sorter(records.begin(), records.end(), compareRecord);
+        stable = stable && stableSorted(records);
+        // 由若干个升序段和降序段拼成的序列
+        for (std::size_t i = 0; i != size; ++i)
+            records[i] = Record{static_cast<int>((i / 500) % 2 ? 1000 - i % 500 : i % 500), static_cast<int>(i)};
+        sorter(records.begin(), records.end(), compareRecord);
+        stable = stable && stableSorted(records);
+    }
+    cout << "timSort的稳定性: " << (stable ? "正确" : "错误") << endl;
+}
+
+void Test8()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100);
+    // 列式数据: 键列与行号列
+    bool right = true;
+    for (std::size_t size : {0, 1, 31, 33, 1000, 100001}){
+        vector<int> keys(size);
+        for (auto &key : keys)
+            key = u(e);
+        vector<std::string> rows(size);
+        for (std::size_t i = 0; i != size; ++i)
+            rows[i] = std::to_string(i);
+        vector<Record> records(size);
+        for (std::size_t i = 0; i != size; ++i)
+            records[i] = Record{keys[i], static_cast<int>(i)};
+        bottomUpMergeSort(records.begin(), records.end(), compareRecord);
+
+        vector<std::size_t> permutation = argsort(keys.begin(), keys.end(), std::greater<int>());
+        for (std::size_t i = 1; i < size; ++i)
+            right = right && (keys[permutation[i - 1]] > keys[permutation[i]]
+                              || (keys[permutation[i - 1]] == keys[permutation[i]] && permutation[i - 1] < permutation[i]));
+        mergeSortPairs(keys.begin(), keys.end(), rows.begin());
+        for (std::size_t i = 0; i != size; ++i)
+            right = right && keys[i] == records[i].key && rows[i] == std::to_string(records[i].order);
+    }
+    cout << "argsort与mergeSortPairs(稳定): " << (right ? "正确" : "错误") << endl;
+}
+
+void Test9()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    vector<int> data(5000);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    // 每次merge的暂存数组都从单调缓冲区分配, 排序以后一次释放
+    MonotonicBufferResource arena;
+    mergeSort(data.begin(), data.end(), std::less<int>(), &arena);
+    sort(compareData.begin(), compareData.end());
+    bool right = data == compareData && arena.bytesAllocated() >= data.size() * sizeof(int);
+    arena.release();
+    cout << "暂存数组从MemoryResource分配: " << (right && arena.bytesAllocated() == 0 ? "正确" : "错误") << endl;
+}
+
+void Test10()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000);
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(5).withGrain(100)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(5线程, 粒度100)"};
+    for (int p = 0; p != 4; ++p){
+        vector<Record> records(100000);
+        for (std::size_t i = 0; i != records.size(); ++i)
+            records[i] = Record{u(e), static_cast<int>(i)};
+        mergeSort(policies[p], records.begin(), records.end(), compareRecord);
+        cout << names[p] << " 稳定排序: " << (stableSorted(records) ? "正确" : "错误") << endl;
+    }
+}
+
 int main()
 {
     cout << "****************对C数组升序排列测试********************\n";
@@ -240,6 +413,24 @@ int main()
     
     cout << "****************对vector数组降序排列测试***************\n";
     Test4();
-    
+
+    cout << "****************自底向上归并排序测试*******************\n";
+    Test5();
+
+    cout << "****************多线程稳定归并排序测试*****************\n";
+    Test6();
+
+    cout << "****************自适应归并排序(timSort)测试************\n";
+    Test7();
+
+    cout << "****************键值对归并排序与argsort测试************\n";
+    Test8();
+
+    cout << "****************从MemoryResource分配暂存数组***********\n";
+    Test9();
+
+    cout << "****************执行策略测试***************************\n";
+    Test10();
+
     return 0;
 }
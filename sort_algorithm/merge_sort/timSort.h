@@ -0,0 +1,295 @@
+/*************************************************************************
+	> File Name: timSort.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 15时02分47秒
+ ************************************************************************/
+
+#ifndef _TIMSORT_H
+#define _TIMSORT_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+// TimSort: 探测有序段的自适应归并排序(Timsort)
+/*
+ * 算法基本思想: 假设对数组A[p,...,r]排序
+ *      --从左到右寻找天然有序的段(run): 非降序段保持不变, 严格降序段原地翻转(严格降序保证翻转不破坏稳定性);
+ *      --长度不足minRun的段用二分插入排序扩展到minRun;
+ *      --段依次压入栈中, 栈中相邻段的长度满足类似斐波那契数列的不变式, 不满足时归并栈顶附近的段,
+ *        使得每次归并的两段长度相近;
+ *      --归并前先用galloping(指数查找)去掉两端已经在正确位置上的元素; 归并过程中某一段连续"获胜"
+ *        min_gallop次以后进入galloping模式, 一次移动一整块元素.
+ *
+ * 算法性能: 最坏情况下为O(NlogN); 对于已经升序或降序的序列只需要N-1次比较, 为O(N);
+ *          稳定排序, 额外空间最多为N/2.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+class TimSort
+{
+public:
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef typename std::iterator_traits<Iterator>::difference_type DiffType;
+
+    TimSort(): min_gallop(initial_min_gallop) {  }
+    ~TimSort() = default;
+    // operator() 排序算法启动.
+    /*
+     * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+     * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+     * \parameter compare: 一个可调用对象,可用于两个对象的小于比较,默认std::less<T>;
+     * \return void.
+     *
+     * 同一个TimSort对象多次排序时, 辅助空间会被重复使用.
+     *
+     */
+    void operator() (const Iterator begin, const Iterator end, CompareType compare = CompareType())
+    {
+        DiffType size = std::distance(begin, end);
+        if (size < 2)
+            return;
+        from = begin;
+        min_gallop = initial_min_gallop;
+        run_base.clear();
+        run_length.clear();
+        DiffType min_run = minRunLength(size);
+        DiffType low = 0;
+        while (low < size){
+            DiffType run = countRunAndMakeAscending(from + low, end, compare);
+            if (run < min_run){
+                DiffType forced = std::min(min_run, size - low);
+                binaryInsertionSort(from + low, from + low + forced, from + low + run, compare);
+                run = forced;
+            }
+            run_base.push_back(low);
+            run_length.push_back(run);
+            mergeCollapse(compare);
+            low += run;
+        }
+        while (run_length.size() > 1){
+            std::size_t k = run_length.size() - 2;
+            if (k > 0 && run_length[k - 1] < run_length[k + 1])
+                --k;
+            mergeAt(k, compare);
+        }
+    }
+
+private:
+    static const DiffType min_merge = 32;       // 长度小于它的序列直接用二分插入排序
+    static const DiffType initial_min_gallop = 7;
+
+    // ReverseCompare: 把比较次序反过来, 用于从后往前的归并
+    struct ReverseCompare
+    {
+        explicit ReverseCompare(CompareType c): compare(c) {  }
+        template<typename U, typename V>
+        bool operator() (const U &u, const V &v) { return compare(v, u); }
+        CompareType compare;
+    };
+
+    //****************************数据结构*******************************
+    Iterator from;                      // 待排序序列的起点
+    DiffType min_gallop;                // 进入galloping模式的阈值, 随归并的效果自适应调整
+    std::vector<DiffType> run_base;     // 栈中各段的起点
+    std::vector<DiffType> run_length;   // 栈中各段的长度
+    std::vector<T> buffer;              // 归并用的辅助空间
+
+    // minRunLength: 计算最短段长, 使得N/minRun等于或略小于2的幂, 这样最后的归并比较平衡
+    static DiffType minRunLength(DiffType n)
+    {
+        DiffType r = 0;
+        while (n >= min_merge){
+            r |= (n & 1);
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // countRunAndMakeAscending: 返回从begin开始的有序段的长度, 严格降序段会被翻转为升序
+    static DiffType countRunAndMakeAscending(Iterator begin, Iterator end, CompareType &compare)
+    {
+        auto current = begin + 1;
+        if (current == end)
+            return 1;
+        if (compare(*current, *begin)){
+            while (current != end && compare(*current, *(current - 1)))
+                ++current;
+            std::reverse(begin, current);
+        }else{
+            while (current != end && !compare(*current, *(current - 1)))
+                ++current;
+        }
+        return std::distance(begin, current);
+    }
+
+    // binaryInsertionSort: [begin, start)已经有序, 用二分查找把[start, end)逐个插入(稳定)
+    static void binaryInsertionSort(Iterator begin, Iterator end, Iterator start, CompareType &compare)
+    {
+        for (; start != end; ++start){
+            T pivot = std::move(*start);
+            Iterator position = std::upper_bound(begin, start, pivot, compare);
+            std::move_backward(position, start, start + 1);
+            *position = std::move(pivot);
+        }
+    }
+
+    // gallopLeft: 在有序区间[first, last)中指数查找第一个不小于key的位置(lower_bound)
+    template<typename RunIterator, typename Compare>
+    static RunIterator gallopLeft(const T &key, RunIterator first, RunIterator last, Compare &compare)
+    {
+        auto n = std::distance(first, last);
+        if (n == 0 || !compare(first[0], key))
+            return first;
+        decltype(n) last_offset = 0, offset = 1;
+        while (offset < n && compare(first[offset], key)){
+            last_offset = offset;
+            offset = offset * 2 + 1;
+        }
+        if (offset > n)
+            offset = n;
+        return std::lower_bound(first + last_offset + 1, first + offset, key, compare);
+    }
+
+    // gallopRight: 在有序区间[first, last)中指数查找第一个大于key的位置(upper_bound)
+    template<typename RunIterator, typename Compare>
+    static RunIterator gallopRight(const T &key, RunIterator first, RunIterator last, Compare &compare)
+    {
+        auto n = std::distance(first, last);
+        if (n == 0 || compare(key, first[0]))
+            return first;
+        decltype(n) last_offset = 0, offset = 1;
+        while (offset < n && !compare(key, first[offset])){
+            last_offset = offset;
+            offset = offset * 2 + 1;
+        }
+        if (offset > n)
+            offset = n;
+        return std::upper_bound(first + last_offset + 1, first + offset, key, compare);
+    }
+
+    // mergeCollapse: 维持栈的不变式 len[i-2] > len[i-1] + len[i], len[i-1] > len[i]
+    void mergeCollapse(CompareType &compare)
+    {
+        while (run_length.size() > 1){
+            std::size_t k = run_length.size() - 2;
+            if ((k > 0 && run_length[k - 1] <= run_length[k] + run_length[k + 1])
+                || (k > 1 && run_length[k - 2] <= run_length[k - 1] + run_length[k])){
+                if (run_length[k - 1] < run_length[k + 1])
+                    --k;
+            }else if (run_length[k] > run_length[k + 1]){
+                break;
+            }
+            mergeAt(k, compare);
+        }
+    }
+
+    // mergeAt: 归并栈中第k段和第k+1段
+    void mergeAt(std::size_t k, CompareType &compare)
+    {
+        Iterator base1 = from + run_base[k];
+        Iterator base2 = from + run_base[k + 1];
+        Iterator end2 = base2 + run_length[k + 1];
+        run_length[k] += run_length[k + 1];
+        run_base.erase(run_base.begin() + k + 1);
+        run_length.erase(run_length.begin() + k + 1);
+        // 左段中不大于右段第一个元素的部分已经在正确的位置上
+        base1 = gallopRight(*base2, base1, base2, compare);
+        if (base1 == base2)
+            return;
+        // 右段中不小于左段最后一个元素的部分已经在正确的位置上
+        end2 = gallopLeft(*(base2 - 1), base2, end2, compare);
+        if (end2 == base2)
+            return;
+        DiffType length1 = std::distance(base1, base2), length2 = std::distance(base2, end2);
+        if (buffer.size() < static_cast<std::size_t>(std::min(length1, length2)))
+            buffer.resize(std::min(length1, length2));
+        if (length1 <= length2){
+            T *buffer_end = std::move(base1, base2, buffer.data());
+            mergeLow(buffer.data(), buffer_end, base2, end2, base1, compare);
+        }else{
+            // 从后往前的归并等价于在反向迭代器上以相反的次序从前往后归并
+            T *buffer_end = std::move(base2, end2, buffer.data());
+            ReverseCompare reverse(compare);
+            mergeLow(std::reverse_iterator<T *>(buffer_end), std::reverse_iterator<T *>(buffer.data()),
+                     std::reverse_iterator<Iterator>(base2), std::reverse_iterator<Iterator>(base1),
+                     std::reverse_iterator<Iterator>(end2), reverse);
+        }
+    }
+
+    // mergeLow: 把buffer中的段[a, a_end)与原位的段[b, b_end)归并到out开始的位置
+    /*
+     * out之后紧接着就是b, 相等的元素总是先取buffer中的元素.
+     * 当buffer中的段取完时, b中剩下的元素已经在正确的位置上.
+     *
+     */
+    template<typename BufferIterator, typename RunIterator, typename Compare>
+    void mergeLow(BufferIterator a, BufferIterator a_end, RunIterator b, RunIterator b_end,
+                  RunIterator out, Compare &compare)
+    {
+        while (a != a_end && b != b_end){
+            // 逐个比较模式
+            DiffType count_a = 0, count_b = 0;
+            while (a != a_end && b != b_end){
+                if (compare(*b, *a)){
+                    *out++ = std::move(*b++);
+                    count_a = 0;
+                    if (++count_b >= min_gallop)
+                        break;
+                }else{
+                    *out++ = std::move(*a++);
+                    count_b = 0;
+                    if (++count_a >= min_gallop)
+                        break;
+                }
+            }
+            if (a == a_end || b == b_end)
+                break;
+            // galloping模式: 某一段连续获胜后, 用指数查找一次移动一整块
+            do{
+                BufferIterator a_stop = gallopRight(*b, a, a_end, compare);
+                count_a = std::distance(a, a_stop);
+                out = std::move(a, a_stop, out);
+                a = a_stop;
+                if (a == a_end)
+                    break;
+                *out++ = std::move(*b++);
+                if (b == b_end)
+                    break;
+                RunIterator b_stop = gallopLeft(*a, b, b_end, compare);
+                count_b = std::distance(b, b_stop);
+                out = std::move(b, b_stop, out);
+                b = b_stop;
+                if (b == b_end)
+                    break;
+                *out++ = std::move(*a++);
+                if (a == a_end)
+                    break;
+                if (min_gallop > 1)
+                    --min_gallop;
+            }while (count_a >= initial_min_gallop || count_b >= initial_min_gallop);
+            if (a == a_end || b == b_end)
+                break;
+            min_gallop += 2;    // galloping效果不好, 提高进入它的门槛
+        }
+        std::move(a, a_end, out);
+    }
+};
+
+// timSort: 自适应归并排序
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组某元素的指针);
+ * \parameter compare: 一个可调用对象, 可用于比较两个对象小于, 默认std::less<T>;
+ * \return void.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void timSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    TimSort<Iterator, CompareType> sorter;
+    sorter(begin, end, compare);
+}
+#endif
@@ -0,0 +1,222 @@
+/*************************************************************************
+	> File Name: opCount.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时58分07秒
+ ************************************************************************/
+
+#ifndef _OPCOUNT_H
+#define _OPCOUNT_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+// 比较函数与元素的操作计数
+/*
+ * 排序, 选择算法与堆的CompareType模板参数可以换成CountingCompare<CompareType>, 元素类型T可以换成Counted<T>:
+ *      --CountingCompare: 每次调用比较函数记一次比较;
+ *      --Counted<T>: 记录拷贝构造, 拷贝赋值, 移动构造, 移动赋值与swap的次数(通过参数相关查找调用的swap,
+ *        包括std::iter_swap; 直接调用std::swap(a, b)记为一次移动构造与两次移动赋值). 从T构造与析构不计数,
+ *        比较运算符转发给T, 不计数(比较由CountingCompare统计);
+ *      --在某一个编译单元中包含这个头文件之前定义宏OP_COUNT_NEW时, 替换全局的operator new, 记分配的次数与字节数
+ *        (一个程序中只能有一个编译单元定义它, 统计的是整个程序的分配, 用opCountReset/opCountSnapshot框住被测的调用).
+ * 只有在包含这个头文件之前定义了宏OP_COUNT才计数; 否则CountingCompare<C>就是C, Counted<T>就是T(别名模板),
+ * 算法实例化出的是同一个函数, 生成的代码与不计数时完全相同. 同一个程序的所有编译单元必须使用相同的设置.
+ *
+ * 计数器是全局的原子变量(relaxed), 线程池中的工作线程的操作也计入; 计数会改变运行时间, 只用来比较操作次数.
+ * 例如:
+ *      opCountReset();
+ *      mergeSort(v.begin(), v.end(), makeCountingCompare(std::less<Counted<int>>()));
+ *      std::cout << opCountSnapshot().toJson();
+ *
+ */
+
+// OpCounts: 一段时间内的操作次数
+struct OpCounts
+{
+    OpCounts()
+        : counting(false), comparisons(0), swaps(0), copyConstructs(0), copyAssigns(0), moveConstructs(0),
+          moveAssigns(0), allocations(0), allocatedBytes(0) {  }
+    std::uint64_t copies() const { return copyConstructs + copyAssigns; }
+    std::uint64_t moves() const { return moveConstructs + moveAssigns; }
+    // 两次快照之差
+    OpCounts operator- (const OpCounts &before) const
+    {
+        OpCounts d(*this);
+        d.comparisons -= before.comparisons;
+        d.swaps -= before.swaps;
+        d.copyConstructs -= before.copyConstructs;
+        d.copyAssigns -= before.copyAssigns;
+        d.moveConstructs -= before.moveConstructs;
+        d.moveAssigns -= before.moveAssigns;
+        d.allocations -= before.allocations;
+        d.allocatedBytes -= before.allocatedBytes;
+        return d;
+    }
+    std::string toJson() const
+    {
+        std::ostringstream out;
+        out << "{\"counting\":" << (counting ? "true" : "false") << ",\"comparisons\":" << comparisons
+            << ",\"swaps\":" << swaps << ",\"copy_constructs\":" << copyConstructs << ",\"copy_assigns\":" << copyAssigns
+            << ",\"move_constructs\":" << moveConstructs << ",\"move_assigns\":" << moveAssigns
+            << ",\"allocations\":" << allocations << ",\"allocated_bytes\":" << allocatedBytes << "}";
+        return out.str();
+    }
+    bool counting;                  // 是否定义了OP_COUNT(为false时下面的计数都为0)
+    std::uint64_t comparisons;      // CountingCompare被调用的次数
+    std::uint64_t swaps;            // Counted<T>的swap次数
+    std::uint64_t copyConstructs;   // Counted<T>的拷贝构造次数(包括临时对象与缓冲区中的元素)
+    std::uint64_t copyAssigns;      // Counted<T>的拷贝赋值次数
+    std::uint64_t moveConstructs;   // Counted<T>的移动构造次数
+    std::uint64_t moveAssigns;      // Counted<T>的移动赋值次数
+    std::uint64_t allocations;      // operator new的次数(定义了OP_COUNT_NEW时)
+    std::uint64_t allocatedBytes;   // operator new申请的字节数(定义了OP_COUNT_NEW时)
+};
+
+#if defined(OP_COUNT)
+// OpCountRegistry: 全局的计数器
+struct OpCountRegistry
+{
+    std::atomic<std::uint64_t> comparisons;
+    std::atomic<std::uint64_t> swaps;
+    std::atomic<std::uint64_t> copyConstructs;
+    std::atomic<std::uint64_t> copyAssigns;
+    std::atomic<std::uint64_t> moveConstructs;
+    std::atomic<std::uint64_t> moveAssigns;
+    std::atomic<std::uint64_t> allocations;
+    std::atomic<std::uint64_t> allocatedBytes;
+};
+
+// opCountRegistry: 静态存储期的对象在任何构造之前清零, 在其它全局对象的构造函数中使用也是安全的
+inline OpCountRegistry& opCountRegistry()
+{
+    static OpCountRegistry registry;
+    return registry;
+}
+
+inline void opCountAdd(std::atomic<std::uint64_t> &counter, std::uint64_t n = 1)
+{
+    counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+// opCountSnapshot: 当前的计数
+inline OpCounts opCountSnapshot()
+{
+    OpCountRegistry &r = opCountRegistry();
+    OpCounts counts;
+    counts.counting = true;
+    counts.comparisons = r.comparisons.load(std::memory_order_relaxed);
+    counts.swaps = r.swaps.load(std::memory_order_relaxed);
+    counts.copyConstructs = r.copyConstructs.load(std::memory_order_relaxed);
+    counts.copyAssigns = r.copyAssigns.load(std::memory_order_relaxed);
+    counts.moveConstructs = r.moveConstructs.load(std::memory_order_relaxed);
+    counts.moveAssigns = r.moveAssigns.load(std::memory_order_relaxed);
+    counts.allocations = r.allocations.load(std::memory_order_relaxed);
+    counts.allocatedBytes = r.allocatedBytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+// opCountReset: 所有的计数清零
+inline void opCountReset()
+{
+    OpCountRegistry &r = opCountRegistry();
+    r.comparisons = r.swaps = r.copyConstructs = r.copyAssigns = 0;
+    r.moveConstructs = r.moveAssigns = r.allocations = r.allocatedBytes = 0;
+}
+
+// CountingCompare: 记录比较次数的比较函数包装
+template<typename CompareType>
+class CountingCompare
+{
+public:
+    CountingCompare() : compare() {  }
+    CountingCompare(CompareType c) : compare(c) {  }
+    template<typename A, typename B>
+    bool operator() (const A &a, const B &b) const
+    {
+        opCountAdd(opCountRegistry().comparisons);
+        return compare(a, b);
+    }
+private:
+    mutable CompareType compare;    // lambda与std::function以外的比较函数的operator()不一定是const的
+};
+
+// Counted: 记录拷贝, 移动与swap次数的元素包装
+template<typename T>
+class Counted
+{
+public:
+    Counted() : value() {  }
+    Counted(const T &v) : value(v) {  }
+    Counted(const Counted &other) : value(other.value) { opCountAdd(opCountRegistry().copyConstructs); }
+    Counted(Counted &&other) : value(std::move(other.value)) { opCountAdd(opCountRegistry().moveConstructs); }
+    Counted& operator= (const Counted &other)
+    {
+        value = other.value;
+        opCountAdd(opCountRegistry().copyAssigns);
+        return *this;
+    }
+    Counted& operator= (Counted &&other)
+    {
+        value = std::move(other.value);
+        opCountAdd(opCountRegistry().moveAssigns);
+        return *this;
+    }
+    friend void swap(Counted &a, Counted &b)
+    {
+        using std::swap;
+        swap(a.value, b.value);
+        opCountAdd(opCountRegistry().swaps);
+    }
+    friend bool operator< (const Counted &a, const Counted &b) { return a.value < b.value; }
+    friend bool operator> (const Counted &a, const Counted &b) { return b.value < a.value; }
+    friend bool operator<= (const Counted &a, const Counted &b) { return !(b.value < a.value); }
+    friend bool operator>= (const Counted &a, const Counted &b) { return !(a.value < b.value); }
+    friend bool operator== (const Counted &a, const Counted &b) { return a.value == b.value; }
+    friend bool operator!= (const Counted &a, const Counted &b) { return !(a.value == b.value); }
+    T value;
+};
+
+// opCountValue: 取出被包装的值
+template<typename T>
+inline const T& opCountValue(const Counted<T> &v) { return v.value; }
+template<typename T>
+inline const T& opCountValue(const T &v) { return v; }
+
+#if defined(OP_COUNT_NEW)
+void* operator new(std::size_t bytes)
+{
+    opCountAdd(opCountRegistry().allocations);
+    opCountAdd(opCountRegistry().allocatedBytes, bytes);
+    void *p = std::malloc(bytes == 0 ? 1 : bytes);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t bytes) { return ::operator new(bytes); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+#endif
+#else
+template<typename CompareType>
+using CountingCompare = CompareType;
+template<typename T>
+using Counted = T;
+
+template<typename T>
+inline const T& opCountValue(const T &v) { return v; }
+inline OpCounts opCountSnapshot() { return OpCounts(); }
+inline void opCountReset() {  }
+#endif
+
+// makeCountingCompare: 由比较函数(例如lambda)得到CountingCompare, 不计数时原样返回
+template<typename CompareType>
+inline CountingCompare<CompareType> makeCountingCompare(CompareType compare)
+{
+    return CountingCompare<CompareType>(compare);
+}
+#endif
@@ -0,0 +1,148 @@
+/*************************************************************************
+	> File Name: opCount_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时00分50秒
+ ************************************************************************/
+// Makefile把这个文件编译两次: Test定义了OP_COUNT(计数), Test_plain没有定义(CountingCompare与Counted是原来的类型)
+#if defined(OP_COUNT)
+#define OP_COUNT_NEW
+#endif
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "opCount.h"
+#include "../insert_sort/insertSort.h"
+#include "../merge_sort/mergeSort.h"
+#include "../heap_sort/heapSort.h"
+#include "../../select_algorithm/minimum/minimum.h"
+#include "../../queue_algorithm/min_queue/minqueue.h"
+
+typedef Counted<int> Element;
+typedef CountingCompare<std::less<Element>> Less;
+
+std::vector<Element> makeSequence(int n, bool reversed)
+{
+    std::vector<Element> v;
+    for (int i = 0; i != n; ++i)
+        v.push_back(Element(reversed ? n - 1 - i : i));
+    return v;
+}
+
+template<typename Iterator>
+bool sorted(Iterator begin, Iterator end)
+{
+    for (Iterator i = begin; i != end && i + 1 != end; ++i)
+        if (opCountValue(*(i + 1)) < opCountValue(*i))
+            return false;
+    return true;
+}
+
+#if defined(OP_COUNT)
+// element_test: 直接调用时每种操作各记一次
+void element_test()
+{
+    opCountReset();
+    Element a(1), b(2);
+    Less less;
+    bool correct = less(a, b) && !less(b, a);
+    Element c(a);
+    Element d(std::move(b));
+    c = d;
+    d = std::move(a);
+    swap(c, d);
+    std::iter_swap(&c, &d);
+    OpCounts counts = opCountSnapshot();
+    correct = correct && counts.counting && counts.comparisons == 2 && counts.swaps == 2;
+    correct = correct && counts.copyConstructs == 1 && counts.moveConstructs == 1;
+    correct = correct && counts.copyAssigns == 1 && counts.moveAssigns == 1 && counts.copies() == 2 && counts.moves() == 2;
+    std::string json = counts.toJson();
+    correct = correct && json.find("\"comparisons\":2") != std::string::npos && json[0] == '{';
+    std::cout << "直接调用的计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// insert_sort_test: 有序时n - 1次比较, 逆序时n(n - 1)/2次; 每个元素一次移动构造(key)与若干次移动赋值, 没有拷贝
+void insert_sort_test()
+{
+    const int n = 100;
+    std::vector<Element> v = makeSequence(n, false);
+    OpCounts before = opCountSnapshot();
+    insertSort(v.begin(), v.end(), Less());
+    OpCounts counts = opCountSnapshot() - before;
+    bool correct = counts.comparisons == n - 1 && counts.moveConstructs == n - 1 && counts.moveAssigns == n - 1;
+    correct = correct && counts.copies() == 0 && counts.swaps == 0 && counts.allocations == 0;
+    v = makeSequence(n, true);
+    before = opCountSnapshot();
+    insertSort(v.begin(), v.end(), Less());
+    counts = opCountSnapshot() - before;
+    correct = correct && sorted(v.begin(), v.end()) && counts.comparisons == n * (n - 1) / 2;
+    correct = correct && counts.moveAssigns == n * (n - 1) / 2 + n - 1 && counts.copies() == 0;
+    std::cout << "insertSort的比较与移动: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// merge_heap_test: merge拷贝到临时的vector(有拷贝与分配), HeapSort用iter_swap交换(没有分配)
+void merge_heap_test()
+{
+    const int n = 1000;
+    std::vector<Element> v = makeSequence(n, true);
+    opCountReset();
+    mergeSort(v.begin(), v.end(), Less());
+    OpCounts merge = opCountSnapshot();
+    bool correct = sorted(v.begin(), v.end()) && merge.comparisons > 0 && merge.copyConstructs >= n;
+    correct = correct && merge.allocations >= n / 2 && merge.allocatedBytes >= n * sizeof(Element);
+    v = makeSequence(n, true);
+    opCountReset();
+    HeapSort<std::vector<Element>::iterator, Less> heapSort;
+    heapSort(v.begin(), v.end(), Less());
+    OpCounts heap = opCountSnapshot();
+    correct = correct && sorted(v.begin(), v.end()) && heap.swaps >= n - 1 && heap.allocations == 0;
+    std::cout << "mergeSort与HeapSort的拷贝, 交换与分配: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// select_queue_test: minimum的比较次数; MinQueue的std::function中保存CountingCompare
+void select_queue_test()
+{
+    const int n = 101;
+    std::vector<Element> v = makeSequence(n, true);
+    opCountReset();
+    bool correct = opCountValue(minimum(v.begin(), v.end(), Less())) == 0;
+    correct = correct && opCountSnapshot().comparisons <= 3 * (n - 1) / 2 + 1;
+    auto compare = makeCountingCompare([](std::shared_ptr<int> a, std::shared_ptr<int> b){ return *a < *b; });
+    MinQueue<int, int> queue(compare, [](std::shared_ptr<int> p) -> int& { return *p; });
+    for (int i = 0; i != n; ++i)
+        queue.insert(std::make_shared<int>(n - i));
+    opCountReset();
+    correct = correct && *queue.extract_min() == 1 && opCountSnapshot().comparisons > 0;
+    std::cout << "minimum与MinQueue的比较: " << (correct ? "正确" : "错误") << std::endl;
+}
+#else
+// plain_test: 不计数时包装就是原来的类型, 算法的实例化与不包装时相同
+void plain_test()
+{
+    bool correct = std::is_same<Less, std::less<int>>::value && std::is_same<Element, int>::value;
+    auto compare = makeCountingCompare(std::greater<int>());
+    correct = correct && std::is_same<decltype(compare), std::greater<int>>::value;
+    std::vector<Element> v = makeSequence(100, true);
+    insertSort(v.begin(), v.end(), Less());
+    mergeSort(v.begin(), v.end(), Less());
+    OpCounts counts = opCountSnapshot();
+    correct = correct && sorted(v.begin(), v.end()) && !counts.counting && counts.comparisons == 0;
+    correct = correct && counts.toJson().find("\"counting\":false") != std::string::npos;
+    std::cout << "不计数时的类型与结果: " << (correct ? "正确" : "错误") << std::endl;
+}
+#endif
+
+int main()
+{
+#if defined(OP_COUNT)
+    element_test();
+    insert_sort_test();
+    merge_heap_test();
+    select_queue_test();
+#else
+    plain_test();
+#endif
+    return 0;
+}
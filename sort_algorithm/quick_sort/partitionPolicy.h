@@ -0,0 +1,164 @@
+/*************************************************************************
+	> File Name: partitionPolicy.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时20分05秒
+ ************************************************************************/
+
+#ifndef _PARTITIONPOLICY_H
+#define _PARTITIONPOLICY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+// 划分策略: 供quickSort, goodSelect, randomiezdSelect作为模板参数选择划分算法.
+/*
+ * 所有策略都是一个可调用对象:
+ *      std::pair<Iterator, Iterator> policy(begin, end, partitioned_iter, compare);
+ * \parameter begin: 待划分序列的起始迭代器;
+ * \parameter end: 待划分序列的终止迭代器;
+ * \parameter partitioned_iter: 指定划分元素(主元)对应的迭代器;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于;
+ * \return 划分后与主元相等的一段区间[first, last):
+ *      --A[begin,...,first-1]的所有元素都不大于主元;
+ *      --A[first,...,last-1]的所有元素都等于主元(两路划分时只有主元本身, last = first + 1);
+ *      --A[last,...,end-1]的所有元素都不小于主元.
+ * 调用者只需要在[begin, first)和[last, end)上继续递归.
+ *
+ */
+
+// LomutoPartition: 算法导论7.1中的划分算法(默认策略)
+/*
+ * 每个元素一次比较, 比较结果决定是否交换, 在随机输入上大约每两个元素就有一次分支预测失败;
+ * 元素全部相等时划分极不平衡.
+ *
+ */
+struct LomutoPartition
+{
+    template<typename Iterator, typename CompareType>
+    std::pair<Iterator, Iterator> operator() (const Iterator begin, const Iterator end,
+                                              const Iterator partitioned_iter, CompareType compare) const
+    {
+        auto last = end - 1;
+        std::iter_swap(partitioned_iter, last);
+        auto i = begin;
+        for (auto current = begin; current != last; ++current){
+            if (compare(*current, *last))
+                std::iter_swap(i++, current);
+        }
+        std::iter_swap(i, last);
+        return std::make_pair(i, i + 1);
+    }
+};
+
+// BlockPartition: 分块的无分支划分(BlockQuicksort, Edelkamp & Weiß)
+/*
+ * 算法基本思想: 主元交换到序列末尾, 左右两端各取一个大小为block_size的块:
+ *      --扫描块时只把"放错位置"元素的偏移量写入offsets数组, 写入位置由比较结果(0或1)累加得到,
+ *        比较和分支无关, 因此没有分支预测失败;
+ *      --然后对左右两个offsets数组中的元素成对交换;
+ *      --某一侧的块处理完后再取下一个块, 剩余不足两个块的部分用Hoare划分完成.
+ *
+ * 左侧把"不小于主元"的元素视为放错位置, 右侧把"不大于主元"的元素视为放错位置, 因此和主元相等的元素
+ * 会均匀地分到两侧, 重复元素很多时划分依然平衡.
+ *
+ * 算法性能: 时间复杂度为O(N), 原址操作, 额外空间为两个block_size字节的数组.
+ *
+ */
+struct BlockPartition
+{
+    static const std::size_t block_size = 128;     // 偏移量用unsigned char保存, 不能超过256
+
+    template<typename Iterator, typename CompareType>
+    std::pair<Iterator, Iterator> operator() (const Iterator begin, const Iterator end,
+                                              const Iterator partitioned_iter, CompareType compare) const
+    {
+        typedef typename std::iterator_traits<Iterator>::difference_type DiffType;
+        const DiffType block = static_cast<DiffType>(block_size);
+        auto last = end - 1;
+        std::iter_swap(partitioned_iter, last);
+        const auto &pivot = *last;      // 主元在划分过程中不会移动
+
+        unsigned char offsets_left[block_size];
+        unsigned char offsets_right[block_size];
+        std::size_t num_left = 0, num_right = 0;        // 尚未交换的偏移量个数
+        std::size_t start_left = 0, start_right = 0;    // 尚未交换的第一个偏移量
+        // 不变式: [begin, left)都不大于主元, [right, last)都不小于主元
+        auto left = begin;
+        auto right = last;
+        while (std::distance(left, right) > 2 * block){
+            if (num_left == 0){
+                start_left = 0;
+                for (DiffType i = 0; i != block; ++i){
+                    offsets_left[num_left] = static_cast<unsigned char>(i);
+                    num_left += !compare(left[i], pivot);
+                }
+            }
+            if (num_right == 0){
+                start_right = 0;
+                for (DiffType i = 0; i != block; ++i){
+                    offsets_right[num_right] = static_cast<unsigned char>(i);
+                    num_right += !compare(pivot, *(right - 1 - i));
+                }
+            }
+            std::size_t num = num_left < num_right ? num_left : num_right;
+            for (std::size_t j = 0; j != num; ++j)
+                std::iter_swap(left + offsets_left[start_left + j],
+                               right - 1 - offsets_right[start_right + j]);
+            num_left -= num;
+            num_right -= num;
+            start_left += num;
+            start_right += num;
+            if (num_left == 0)
+                left += block;
+            if (num_right == 0)
+                right -= block;
+        }
+        // 剩余部分(不超过3个块)用Hoare划分完成, 未交换的偏移量所指的元素都在[left, right)中.
+        // 两端遇到与主元相等的元素都停下来交换, 全部元素相等时划分依然平衡
+        auto i = left, j = right;
+        while (true){
+            while (i != j && compare(*i, pivot))
+                ++i;
+            while (i != j && compare(pivot, *(j - 1)))
+                --j;
+            if (std::distance(i, j) <= 1)
+                break;
+            std::iter_swap(i++, --j);
+        }
+        std::iter_swap(i, last);
+        return std::make_pair(i, i + 1);
+    }
+};
+
+// ThreeWayPartition: 三路划分(荷兰国旗问题, Dijkstra)
+/*
+ * 把序列划分为小于主元, 等于主元, 大于主元三段, 返回等于主元的一段.
+ * 重复元素很多时, 等于主元的元素不再参与后续的递归, 全部元素相等时一次划分即可完成排序.
+ *
+ * 算法性能: 时间复杂度为O(N), 原址操作.
+ *
+ */
+struct ThreeWayPartition
+{
+    template<typename Iterator, typename CompareType>
+    std::pair<Iterator, Iterator> operator() (const Iterator begin, const Iterator end,
+                                              const Iterator partitioned_iter, CompareType compare) const
+    {
+        auto pivot = *partitioned_iter;     // 主元会被移动, 需要拷贝
+        auto less_end = begin;      // [begin, less_end)小于主元
+        auto current = begin;       // [less_end, current)等于主元
+        auto greater_begin = end;   // [greater_begin, end)大于主元
+        while (current != greater_begin){
+            if (compare(*current, pivot))
+                std::iter_swap(less_end++, current++);
+            else if (compare(pivot, *current))
+                std::iter_swap(current, --greater_begin);
+            else
+                ++current;
+        }
+        return std::make_pair(less_end, greater_begin);
+    }
+};
+#endif
@@ -11,6 +11,12 @@
 #include <functional>
 #include <stdexcept>
 #include <utility>
+#include <algorithm>
+#include "partitionPolicy.h"
+#include "../insert_sort/insertSort.h"
+#include "../sorting_network/sortingNetwork.h"
+#include "../heap_sort/heapSort.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
 // partition: 算法导论第7章 快速排序算法中的划分算法.
 /*
  * \parameter begin: 待划分序列的起始迭代器(也可以是指向数组中某元素的指针);
@@ -41,12 +47,12 @@ Iterator partition(const Iterator begin, const Iterator end,
         throw std::invalid_argument("decreate_key error: 输入序列的范围有误");
     auto x = *partitioned_iter;
     auto i = begin;
-    std::swap(*partitioned_iter, *(end - 1));
+    std::iter_swap(partitioned_iter, end - 1);
     for (auto current = begin; current != end; ++current){
         if (compare(*current, x))
-            std::swap(*i++, *current);
+            std::iter_swap(i++, current);
     }
-    std::swap(*i, *(end - 1));
+    std::iter_swap(i, end - 1);
     return i;
 }
 // quickSort: 快速排序算法 算法导论第七章
@@ -54,6 +60,8 @@ Iterator partition(const Iterator begin, const Iterator end,
  * \parameter begin: 待划分序列的起始迭代器(也可以是指向数组中某元素的指针);
  * \parameter end: 待划分的终止迭代器(也可以是指向数组中某元素的指针);
  * \parameter compare: 一个可调用对象,可用于比较两个对象的小于(默认为std::less<T>);
+ * \parameter policy: 划分策略(见partitionPolicy.h), 默认为LomutoPartition(以最后一个元素为主元的划分),
+ *                    BlockPartition为无分支的分块划分, ThreeWayPartition适用于有大量重复元素的序列;
  * \return void.
  *
  * 算法基本思想: 
@@ -66,14 +74,216 @@ Iterator partition(const Iterator begin, const Iterator end,
  * 算法性能: 最坏情况下时间复杂度为O(N^2), 在元素互异的情况下,期望时间复杂度为O(NlogN).
  *
  */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename PartitionPolicy = LomutoPartition>
+void quickSort(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+               PartitionPolicy policy = PartitionPolicy())
+{
+    auto size = std::distance(begin, end);
+    if (size <= 1)
+        return;
+    auto equal_range = policy(begin, end, end - 1, compare);
+    quickSort(begin, equal_range.first, compare, policy);
+    quickSort(equal_range.second, end, compare, policy);
+}
+
+const std::ptrdiff_t intro_sort_threshold = 16;         // 小于该长度的子序列用smallSort完成
+const std::ptrdiff_t ninther_threshold = 128;           // 不小于该长度的子序列用ninther选取主元
+const std::ptrdiff_t parallel_sort_grain = 1 << 14;     // 小于该长度的子序列不再拆分成并行任务
+
+// medianOfThree: 返回三个位置中元素值居中的那个位置
+template<typename Iterator, typename CompareType>
+Iterator medianOfThree(Iterator a, Iterator b, Iterator c, CompareType compare)
+{
+    if (compare(*a, *b)){
+        if (compare(*b, *c))    return b;
+        return compare(*a, *c) ? c : a;
+    }
+    if (compare(*a, *c))    return a;
+    return compare(*b, *c) ? c : b;
+}
+
+// choosePivot: 选取主元的位置
+/*
+ * 较短的序列取首,中,尾三个元素的中值; 较长的序列取ninther(Tukey): 把序列上均匀分布的9个元素分为3组,
+ * 取3组中值的中值. 对于升序,降序,organ-pipe等输入都能得到接近中位数的主元.
+ *
+ */
+template<typename Iterator, typename CompareType>
+Iterator choosePivot(const Iterator begin, const Iterator end, CompareType compare)
+{
+    auto size = std::distance(begin, end);
+    auto last = end - 1;
+    auto middle = begin + size / 2;
+    if (size < ninther_threshold)
+        return medianOfThree(begin, middle, last, compare);
+    auto step = size / 8;
+    auto m1 = medianOfThree(begin, begin + step, begin + 2 * step, compare);
+    auto m2 = medianOfThree(middle - step, middle, middle + step, compare);
+    auto m3 = medianOfThree(last - 2 * step, last - step, last, compare);
+    return medianOfThree(m1, m2, m3, compare);
+}
+
+// hoarePartition: 以*begin为主元的Hoare划分  算法导论思考题7-1
+/*
+ * \parameter begin: 待划分序列的起始迭代器, *begin为主元;
+ * \parameter end: 待划分序列的终止迭代器;
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于;
+ * \return 主元最终的位置q, 满足A[begin,...,q-1] <= A[q] <= A[q+1,...,end-1].
+ *
+ * 与partition不同, 左右两个指针遇到与主元相等的元素都会停下并交换, 所以全部元素相等时划分依然是平衡的.
+ *
+ */
+template<typename Iterator, typename CompareType>
+Iterator hoarePartition(const Iterator begin, const Iterator end, CompareType compare)
+{
+    auto pivot = *begin;
+    auto i = begin;
+    auto j = end;
+    while (true){
+        do ++i; while (i != end && compare(*i, pivot));
+        do --j; while (compare(pivot, *j));     // 至多停在begin处
+        if (!(i < j))
+            break;
+        std::iter_swap(i, j);
+    }
+    std::iter_swap(begin, j);
+    return j;
+}
+
+// introSortLoop: 内省排序的主循环
+/*
+ * 在较短的一侧递归, 在较长的一侧循环, 因此栈深度为O(logN);
+ * 递归深度超过depth_limit时说明主元选取持续失败, 改用4叉堆排序(DaryHeapSort)保证O(NlogN);
+ * 长度不超过intro_sort_threshold的子序列用smallSort完成(算术类型为排序网络, 其余为插入排序).
+ *
+ */
+template<typename Iterator, typename CompareType>
+void introSortLoop(Iterator begin, Iterator end, std::size_t depth_limit, CompareType compare)
+{
+    while (std::distance(begin, end) > intro_sort_threshold){
+        if (depth_limit == 0){
+            DaryHeapSort<Iterator, CompareType> sorter;
+            sorter(begin, end, compare);
+            return;
+        }
+        --depth_limit;
+        std::iter_swap(begin, choosePivot(begin, end, compare));
+        auto middle = hoarePartition(begin, end, compare);
+        if (std::distance(begin, middle) < std::distance(middle, end)){
+            introSortLoop(begin, middle, depth_limit, compare);
+            begin = middle + 1;
+        }else{
+            introSortLoop(middle + 1, end, depth_limit, compare);
+            end = middle;
+        }
+    }
+    smallSort(begin, end, compare);
+}
+
+// introDepthLimit: 内省排序的递归深度上限 2*floor(log2(N))
+inline std::size_t introDepthLimit(std::ptrdiff_t size)
+{
+    std::size_t depth = 0;
+    for (; size > 1; size >>= 1)
+        depth += 2;
+    return depth;
+}
+
+// introSort: 内省排序(快速排序 + 堆排序 + 插入排序)
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于(默认为std::less<T>);
+ * \return void.
+ *
+ * 算法性能: 最坏情况下时间复杂度为O(NlogN), 栈深度为O(logN); 不稳定, 原址排序.
+ *
+ */
 template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
-void quickSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+void introSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
 {
     auto size = std::distance(begin, end);
     if (size <= 1)
         return;
-    auto partitioned_iter = partition(begin, end, end - 1, compare);
-    quickSort(begin, partitioned_iter, compare);
-    quickSort(partitioned_iter + 1, end, compare);
+    introSortLoop(begin, end, introDepthLimit(size), compare);
+}
+
+// parallelIntroSortTask: 并行内省排序的一个任务
+/*
+ * 划分以后左侧子序列作为新任务放入线程池(空闲线程可以窃取), 右侧子序列由当前任务继续处理;
+ * 长度不超过grain的子序列直接串行排序.
+ *
+ */
+template<typename Iterator, typename CompareType>
+void parallelIntroSortTask(TaskGroup &group, Iterator begin, Iterator end,
+                           std::size_t depth_limit, std::ptrdiff_t grain, CompareType compare)
+{
+    while (std::distance(begin, end) > grain){
+        if (depth_limit == 0){
+            DaryHeapSort<Iterator, CompareType> sorter;
+            sorter(begin, end, compare);
+            return;
+        }
+        --depth_limit;
+        std::iter_swap(begin, choosePivot(begin, end, compare));
+        auto middle = hoarePartition(begin, end, compare);
+        Iterator left_end = middle;
+        group.run([&group, begin, left_end, depth_limit, grain, compare]{
+            parallelIntroSortTask(group, begin, left_end, depth_limit, grain, compare);
+        });
+        begin = middle + 1;
+    }
+    introSortLoop(begin, end, depth_limit, compare);
+}
+
+// quickSort: 按执行策略排序的内省排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为parallel_sort_grain;
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于(默认为std::less<T>);
+ * \return void.
+ *
+ * 串行策略或序列长度小于exec.grain(parallel_sort_grain)时调用introSort; 否则划分得到的子序列作为任务
+ * 在exec.pool()中并行排序, 长度不超过grain的子序列不再拆分.
+ * 与quickSort(begin, end)不同, 策略版本总是内省排序(主元为三数取中/ninther, Hoare划分, 深度超限时改用堆排序),
+ * 串行与并行的结果相同, 最坏情况下时间复杂度都是O(NlogN).
+ * compare会被拷贝到各个任务中, 多个线程会同时调用它.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void quickSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    auto size = std::distance(begin, end);
+    if (size <= 1)
+        return;
+    if (!exec.runParallel(static_cast<std::size_t>(size), parallel_sort_grain)){
+        introSort(begin, end, compare);
+        return;
+    }
+    TaskGroup group(exec.pool());   // 调用线程在wait中也会执行任务
+    parallelIntroSortTask(group, begin, end, introDepthLimit(size),
+                          static_cast<std::ptrdiff_t>(exec.grain(parallel_sort_grain)), compare);
+    group.wait();
+}
+
+// parallelQuickSort: 基于工作窃取线程池的并行内省排序
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于(默认为std::less<T>);
+ * \parameter threads: 参与排序的线程个数(包括调用线程), 默认为硬件线程数;
+ * \return void.
+ *
+ * 等价于quickSort(execution::par.withThreads(threads), begin, end, compare), 任务在共享的线程池中执行.
+ * 算法性能: 与introSort相同, 最坏情况下时间复杂度为O(NlogN), 不会退化为O(N^2).
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void parallelQuickSort(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+                       std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    quickSort(execution::par.withThreads(threads), begin, end, compare);
 }
 #endif
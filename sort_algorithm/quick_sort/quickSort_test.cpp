@@ -12,6 +12,7 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <random>
 #include "quickSort.h"
 
 // 数组输出函数
@@ -227,6 +228,91 @@ void Test4()
     print(compareData4.begin(), compareData4.end());
 }
 
+// 检查两个序列是否相同
+template<typename Iterator1, typename Iterator2>
+bool sameSequence(Iterator1 begin1, Iterator1 end1, Iterator2 begin2)
+{
+    for (; begin1 != end1; ++begin1, ++begin2)
+        if (*begin1 != *begin2)
+            return false;
+    return true;
+}
+
+void Test5()
+{
+    const std::size_t N = 200000;
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000000);
+    vector<int> random(N), ascending(N), descending(N), equal(N, 7), organ(N);
+    for (std::size_t i = 0; i != N; ++i){
+        random[i] = u(e);
+        ascending[i] = static_cast<int>(i);
+        descending[i] = static_cast<int>(N - i);
+        organ[i] = static_cast<int>(i < N / 2 ? i : N - i);
+    }
+    vector<vector<int>> inputs{random, ascending, descending, equal, organ};
+    const char *names[] = {"随机序列", "升序序列", "降序序列", "全部相等", "organ-pipe"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        vector<int> data1(inputs[k]), data2(inputs[k]), data3(inputs[k]), compareData(inputs[k]);
+        sort(compareData.begin(), compareData.end());
+        introSort(data1.begin(), data1.end());
+        parallelQuickSort(data2.begin(), data2.end(), std::less<int>(), 4);
+        parallelQuickSort(data3.begin(), data3.end(), compareInt, 2);
+        std::reverse(data3.begin(), data3.end());
+        cout << names[k] << ": introSort " << (sameSequence(data1.begin(), data1.end(), compareData.begin()) ? "正确" : "错误")
+             << ", parallelQuickSort " << (sameSequence(data2.begin(), data2.end(), compareData.begin()) ? "正确" : "错误")
+             << ", parallelQuickSort(降序) " << (sameSequence(data3.begin(), data3.end(), compareData.begin()) ? "正确" : "错误")
+             << endl;
+    }
+}
+
+void Test6()
+{
+    const std::size_t N = 100000;
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 1000000);
+    std::uniform_int_distribution<int> few(0, 3);
+    vector<int> random(N), duplicates(N);
+    for (std::size_t i = 0; i != N; ++i){
+        random[i] = u(e);
+        duplicates[i] = few(e);
+    }
+    vector<vector<int>> inputs{random, duplicates};
+    const char *names[] = {"随机序列", "大量重复元素"};
+    for (std::size_t k = 0; k != inputs.size(); ++k){
+        vector<int> data1(inputs[k]), data2(inputs[k]), compareData(inputs[k]);
+        sort(compareData.begin(), compareData.end(), compareInt);
+        quickSort(data1.begin(), data1.end(), compareInt, BlockPartition());
+        quickSort(data2.begin(), data2.end(), compareInt, ThreeWayPartition());
+        cout << names[k] << ": BlockPartition " << (sameSequence(data1.begin(), data1.end(), compareData.begin()) ? "正确" : "错误")
+             << ", ThreeWayPartition " << (sameSequence(data2.begin(), data2.end(), compareData.begin()) ? "正确" : "错误")
+             << endl;
+    }
+}
+
+void Test7()
+{
+    const std::size_t N = 200000;
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(0, 100);
+    vector<int> data(N);
+    for (auto &x : data)
+        x = u(e);
+    vector<int> compareData(data);
+    sort(compareData.begin(), compareData.end(), compareInt);
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(2).withGrain(64)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(2线程, 粒度64)"};
+    for (int p = 0; p != 4; ++p){
+        vector<int> sorted(data);
+        quickSort(policies[p], sorted.begin(), sorted.end(), compareInt);
+        cout << names[p] << " 降序: " << (sameSequence(sorted.begin(), sorted.end(), compareData.begin()) ? "正确" : "错误") << endl;
+    }
+    int small[5] = {3, 1, 2, 5, 4};
+    quickSort(execution::par, small, small + 5);
+    cout << "短序列直接串行排序: " << (std::is_sorted(small, small + 5) ? "正确" : "错误") << endl;
+}
+
 int main()
 {
     cout << "****************对C数组升序排列测试********************\n";
@@ -240,6 +326,15 @@ int main()
     
     cout << "****************对vector数组降序排列测试***************\n";
     Test4();
+
+    cout << "****************内省排序与并行快速排序测试*************\n";
+    Test5();
+
+    cout << "****************不同划分策略的快速排序测试*************\n";
+    Test6();
+
+    cout << "****************执行策略测试***************************\n";
+    Test7();
     
     return 0;
 }
@@ -11,7 +11,13 @@
 #include <functional>
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
 // digi_on_N: 获取正整数指定位数上的数字.
 /*
  * \parameter num: 待抽取数字的正整数;
@@ -66,6 +72,145 @@ void countingSort(const Iterator begin, const Iterator end,
     // 把排序好的元素返回到数组中
     std::copy(tempResult.begin(), tempResult.end(), begin);
 }
+// RadixKeyTraits: 把待排序元素映射为一个无符号整数键, 使得无符号键的大小次序与元素的大小次序一致.
+/*
+ *      --无符号整数: 键就是它本身;
+ *      --有符号整数: 把符号位取反, 负数映射到键的低半区, 非负数映射到键的高半区;
+ *      --IEEE浮点数: 符号位为0时把符号位置1; 符号位为1时把所有位取反(负数的绝对值越大,键越小).
+ *        于是 -inf < 负数 < -0.0 < +0.0 < 正数 < +inf, 符号位为1的NaN排在最前, 其余NaN排在最后.
+ *
+ */
+template<typename T, bool = std::is_floating_point<T>::value>
+struct RadixKeyTraits
+{
+    static_assert(std::is_integral<T>::value, "sequence to be sorted must be integer or floating point!");
+    typedef typename std::make_unsigned<T>::type KeyType;
+    static KeyType toKey(T value)
+    {
+        KeyType key = static_cast<KeyType>(value);
+        if (std::is_signed<T>::value)
+            key ^= static_cast<KeyType>(KeyType(1) << (sizeof(KeyType) * 8 - 1));
+        return key;
+    }
+};
+
+template<typename T>
+struct RadixKeyTraits<T, true>
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only 32-bit and 64-bit floating point are supported!");
+    typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type KeyType;
+    static KeyType toKey(T value)
+    {
+        KeyType bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        const KeyType sign = KeyType(1) << (sizeof(KeyType) * 8 - 1);
+        return (bits & sign) ? static_cast<KeyType>(~bits) : static_cast<KeyType>(bits | sign);
+    }
+};
+
+const std::size_t radix_bits = 8;                       // 每一趟排序使用的位数(基数为256)
+const std::size_t radix_buckets = 1 << radix_bits;      // 每一趟的桶个数
+
+// radixScatter: 基数排序的一趟分配
+/*
+ * \parameter src: 本趟的输入序列;
+ * \parameter size: 序列长度;
+ * \parameter dst: 本趟的输出序列;
+ * \parameter offsets: 每个桶在输出序列中的起始位置(分配过程中会被修改);
+ * \parameter shift: 本趟使用的键的最低位;
+ * \return void.
+ *
+ */
+template<typename SrcIterator, typename DstIterator>
+void radixScatter(SrcIterator src, std::size_t size, DstIterator dst, std::size_t *offsets, std::size_t shift)
+{
+    typedef typename std::iterator_traits<SrcIterator>::value_type T;
+    typedef RadixKeyTraits<T> Traits;
+    for (std::size_t i = 0; i != size; ++i){
+        std::size_t digit = (Traits::toKey(src[i]) >> shift) & (radix_buckets - 1);
+        dst[offsets[digit]++] = std::move(src[i]);
+    }
+}
+
+// lsdRadixSort: 以字节为单位的低位优先基数排序  算法导论8.3
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter buffer: 至少能存放distance(begin, end)个元素的辅助空间;
+ * \return void.
+ *
+ * 算法基本思想: 
+ *      --把每个元素映射为无符号键(见RadixKeyTraits), 每8位作为一"位"数字, 从低位到高位依次做稳定的计数排序;
+ *      --只读一遍输入, 同时得到所有趟的直方图;
+ *      --输入序列与buffer交替作为每一趟的输入和输出(ping-pong), 最后结果若在buffer中再移回原序列;
+ *      --如果所有元素在某一"位"上的数字都相同, 则跳过这一趟.
+ *
+ * 算法性能: 时间复杂度为O(d(N+256)), d为元素的字节数; 额外空间为O(N). 稳定排序.
+ *
+ */
+template<typename Iterator>
+void lsdRadixSort(const Iterator begin, const Iterator end,
+                  typename std::iterator_traits<Iterator>::value_type *buffer)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef RadixKeyTraits<T> Traits;
+    typedef typename Traits::KeyType KeyType;
+    const std::size_t passes = sizeof(KeyType);
+    auto distance = std::distance(begin, end);
+    if (distance <= 1)
+        return;
+    std::size_t size = static_cast<std::size_t>(distance);
+    // 一次读入得到所有趟的直方图
+    std::size_t counts[sizeof(KeyType)][radix_buckets] = {};
+    for (auto current = begin; current != end; ++current){
+        KeyType key = Traits::toKey(*current);
+        for (std::size_t pass = 0; pass != passes; ++pass)
+            ++counts[pass][(key >> (pass * radix_bits)) & (radix_buckets - 1)];
+    }
+    bool in_buffer = false;     // 当前结果是否存放在buffer中
+    for (std::size_t pass = 0; pass != passes; ++pass){
+        std::size_t shift = pass * radix_bits;
+        std::size_t *offsets = counts[pass];
+        KeyType first_key = Traits::toKey(in_buffer ? buffer[0] : *begin);
+        if (offsets[(first_key >> shift) & (radix_buckets - 1)] == size)
+            continue;   // 所有元素在这一位上相同
+        // 由直方图计算每个桶的起始位置
+        std::size_t sum = 0;
+        for (std::size_t digit = 0; digit != radix_buckets; ++digit){
+            std::size_t count = offsets[digit];
+            offsets[digit] = sum;
+            sum += count;
+        }
+        if (in_buffer)
+            radixScatter(buffer, size, begin, offsets, shift);
+        else
+            radixScatter(begin, size, buffer, offsets, shift);
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer)
+        std::move(buffer, buffer + size, begin);
+}
+
+// radixSort: 基数排序 算法导论8.3.
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \return void.
+ *
+ * 适用于任意整数类型以及float/double, 使用lsdRadixSort完成排序, 辅助空间在函数内分配.
+ *
+ */
+template<typename Iterator>
+void radixSort(const Iterator begin, const Iterator end)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T; 
+    auto size = std::distance(begin, end);
+    if (size <= 1)
+        return;
+    std::vector<T> buffer(size);
+    lsdRadixSort(begin, end, buffer.data());
+}
+
 // radixSort: 基数排序 算法导论8.3.
 /*
  * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
@@ -78,6 +223,9 @@ void countingSort(const Iterator begin, const Iterator end,
  * 算法的基本思想: 依次对所给数字中的个位, 十位,...排序(注意,一定要使用稳定的排序算法).
  * 此算法不属于比较排序算法, 是否是原址排序取决于你对每一位数所使用的排序算法.
  *
+ * 实现上不再逐个十进制位调用countingSort(每个元素每一趟都要做一次pow和两次除法), 而是交给以字节为
+ * 单位的lsdRadixSort, radix_width只用于检查参数, 负数也能正确排序.
+ *
  */
 template<typename Iterator>
 void radixSort(const Iterator begin, const Iterator end, std::size_t radix_width)
@@ -87,11 +235,388 @@ void radixSort(const Iterator begin, const Iterator end, std::size_t radix_width
     assert(radix_width != 0);   // 检测位数为有效位, 0属于无效位
     // 在编译的时候确保 (基数排序只适合对整数类型的数据进行排序)
     static_assert(std::is_integral<T>::value, "sequence to be sorted must be integer!");
-    auto size = std::distance(begin, end);
-    if (size <= 1)
+    radixSort(begin, end);
+}
+
+// radixScatterPairs: 键值对基数排序的一趟分配, 键和值分别存放在两个平行的数组中(SoA)
+template<typename KeySrc, typename ValueSrc, typename KeyDst, typename ValueDst>
+void radixScatterPairs(KeySrc keys, ValueSrc values, std::size_t size, KeyDst key_dst, ValueDst value_dst,
+                       std::size_t *offsets, std::size_t shift)
+{
+    typedef typename std::iterator_traits<KeySrc>::value_type K;
+    typedef RadixKeyTraits<K> Traits;
+    for (std::size_t i = 0; i != size; ++i){
+        std::size_t position = offsets[(Traits::toKey(keys[i]) >> shift) & (radix_buckets - 1)]++;
+        key_dst[position] = std::move(keys[i]);
+        value_dst[position] = std::move(values[i]);
+    }
+}
+
+// lsdRadixSortPairs: 按键排序, 值跟随键一起移动(与lsdRadixSort相同, 只是每一趟同时分配两个数组)
+/*
+ * \parameter keys_begin: 键序列的起始迭代器;
+ * \parameter keys_end: 键序列的终止迭代器;
+ * \parameter values_begin: 值序列的起始迭代器, 与键一一对应;
+ * \parameter key_buffer: 至少能存放distance(keys_begin, keys_end)个键的辅助空间;
+ * \parameter value_buffer: 至少能存放distance(keys_begin, keys_end)个值的辅助空间;
+ * \return void.
+ *
+ */
+template<typename KeyIterator, typename ValueIterator>
+void lsdRadixSortPairs(const KeyIterator keys_begin, const KeyIterator keys_end, const ValueIterator values_begin,
+                       typename std::iterator_traits<KeyIterator>::value_type *key_buffer,
+                       typename std::iterator_traits<ValueIterator>::value_type *value_buffer)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    typedef RadixKeyTraits<K> Traits;
+    typedef typename Traits::KeyType KeyType;
+    const std::size_t passes = sizeof(KeyType);
+    auto distance = std::distance(keys_begin, keys_end);
+    if (distance <= 1)
         return;
-    // 对每一位都使用计数排序方法进行排序
-    for (int i = 0; i <= radix_width; ++i)
-        countingSort(begin, end, 9, i);
+    std::size_t size = static_cast<std::size_t>(distance);
+    std::size_t counts[sizeof(KeyType)][radix_buckets] = {};
+    for (auto current = keys_begin; current != keys_end; ++current){
+        KeyType key = Traits::toKey(*current);
+        for (std::size_t pass = 0; pass != passes; ++pass)
+            ++counts[pass][(key >> (pass * radix_bits)) & (radix_buckets - 1)];
+    }
+    bool in_buffer = false;
+    for (std::size_t pass = 0; pass != passes; ++pass){
+        std::size_t shift = pass * radix_bits;
+        std::size_t *offsets = counts[pass];
+        KeyType first_key = Traits::toKey(in_buffer ? key_buffer[0] : *keys_begin);
+        if (offsets[(first_key >> shift) & (radix_buckets - 1)] == size)
+            continue;
+        std::size_t sum = 0;
+        for (std::size_t digit = 0; digit != radix_buckets; ++digit){
+            std::size_t count = offsets[digit];
+            offsets[digit] = sum;
+            sum += count;
+        }
+        if (in_buffer)
+            radixScatterPairs(key_buffer, value_buffer, size, keys_begin, values_begin, offsets, shift);
+        else
+            radixScatterPairs(keys_begin, values_begin, size, key_buffer, value_buffer, offsets, shift);
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer){
+        std::move(key_buffer, key_buffer + size, keys_begin);
+        std::move(value_buffer, value_buffer + size, values_begin);
+    }
+}
+
+// radixPermutation: 对键排序, 同时得到排序后第i个键原来的下标
+template<typename KeyIterator, typename IndexType>
+void radixPermutation(const KeyIterator keys_begin, const KeyIterator keys_end, std::vector<IndexType> &permutation)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    std::size_t size = std::distance(keys_begin, keys_end);
+    permutation.resize(size);
+    for (std::size_t i = 0; i != size; ++i)
+        permutation[i] = static_cast<IndexType>(i);
+    std::vector<K> key_buffer(size);
+    std::vector<IndexType> index_buffer(size);
+    lsdRadixSortPairs(keys_begin, keys_end, permutation.begin(), key_buffer.data(), index_buffer.data());
+}
+
+// applyPermutation: 按照permutation重排值序列, values[i] = 原来的values[permutation[i]]
+template<typename ValueIterator, typename IndexType>
+void applyPermutation(const ValueIterator values_begin, const std::vector<IndexType> &permutation)
+{
+    typedef typename std::iterator_traits<ValueIterator>::value_type V;
+    std::vector<V> gathered;
+    gathered.reserve(permutation.size());
+    for (auto index : permutation)
+        gathered.push_back(std::move(values_begin[index]));
+    std::move(gathered.begin(), gathered.end(), values_begin);
+}
+
+// radixSortPairs: 键值对基数排序(键和值存放在两个平行的数组中)
+/*
+ * \parameter keys_begin: 键序列的起始迭代器(键必须是整数或float/double);
+ * \parameter keys_end: 键序列的终止迭代器;
+ * \parameter values_begin: 值序列的起始迭代器, 第i个值属于第i个键;
+ * \return void.
+ *
+ * 排序后键有序, 值随键重排, 相同的键保持原来的次序(稳定). 不需要把键和值打包为std::pair.
+ *      --值不大于4字节时, 每一趟直接和键一起分配;
+ *      --值较大时, 每一趟只移动键和32位(序列很长时为64位)的下标, 最后按下标把每个值移动一次.
+ *
+ * 算法性能: 时间复杂度为O(d(N+256)), d为键的字节数; 额外空间为O(N).
+ *
+ */
+template<typename KeyIterator, typename ValueIterator>
+void radixSortPairs(const KeyIterator keys_begin, const KeyIterator keys_end, const ValueIterator values_begin)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type K;
+    typedef typename std::iterator_traits<ValueIterator>::value_type V;
+    auto distance = std::distance(keys_begin, keys_end);
+    if (distance <= 1)
+        return;
+    std::size_t size = static_cast<std::size_t>(distance);
+    if (sizeof(V) <= sizeof(std::uint32_t)){
+        std::vector<K> key_buffer(size);
+        std::vector<V> value_buffer(size);
+        lsdRadixSortPairs(keys_begin, keys_end, values_begin, key_buffer.data(), value_buffer.data());
+    }else if (size <= UINT32_MAX){
+        std::vector<std::uint32_t> permutation;
+        radixPermutation(keys_begin, keys_end, permutation);
+        applyPermutation(values_begin, permutation);
+    }else{
+        std::vector<std::size_t> permutation;
+        radixPermutation(keys_begin, keys_end, permutation);
+        applyPermutation(values_begin, permutation);
+    }
+}
+
+// radixArgsort: 返回使序列有序的下标序列(序列本身不变)
+/*
+ * \parameter begin: 序列的起始迭代器(元素必须是整数或float/double);
+ * \parameter end: 序列的终止迭代器;
+ * \return 下标序列p, 使得*(begin + p[0]) <= *(begin + p[1]) <= ..., 相等元素的下标保持升序.
+ *
+ */
+template<typename Iterator>
+std::vector<std::size_t> radixArgsort(const Iterator begin, const Iterator end)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    std::vector<T> keys(begin, end);
+    std::vector<std::size_t> permutation;
+    radixPermutation(keys.begin(), keys.end(), permutation);
+    return permutation;
+}
+
+const std::size_t radix_parallel_threshold = 1 << 16;  // 小于该长度的序列不并行排序
+const std::size_t radix_combine_bytes = 64;             // 每个桶的写合并缓冲区大小(一个缓存行)
+
+// radixScatterCombined: 带写合并缓冲区的一趟分配
+/*
+ * \parameter src: 本趟的输入序列;
+ * \parameter from, to: 本线程负责的输入区间[from, to);
+ * \parameter dst: 本趟的输出序列;
+ * \parameter offsets: 本线程每个桶在输出序列中的起始位置(分配过程中会被修改);
+ * \parameter shift: 本趟使用的键的最低位;
+ * \parameter combine: 本线程的写合并缓冲区, 每个桶radix_combine_bytes字节;
+ * \return void.
+ *
+ * 元素先写入对应桶的小缓冲区, 缓冲区满了再一次性写到输出序列: 同一时刻只有256个缓存行在被写,
+ * 输出序列的写入都是整个缓存行的连续写, 减少了缓存和TLB缺失.
+ *
+ */
+template<typename SrcIterator, typename DstIterator>
+void radixScatterCombined(SrcIterator src, std::size_t from, std::size_t to, DstIterator dst,
+                          std::size_t *offsets, std::size_t shift,
+                          typename std::iterator_traits<SrcIterator>::value_type *combine)
+{
+    typedef typename std::iterator_traits<SrcIterator>::value_type T;
+    typedef RadixKeyTraits<T> Traits;
+    const std::size_t per_bucket = sizeof(T) >= radix_combine_bytes ? 1 : radix_combine_bytes / sizeof(T);
+    std::size_t fill[radix_buckets] = {};
+    for (std::size_t i = from; i != to; ++i){
+        std::size_t digit = (Traits::toKey(src[i]) >> shift) & (radix_buckets - 1);
+        T *slot = combine + digit * per_bucket;
+        slot[fill[digit]++] = std::move(src[i]);
+        if (fill[digit] == per_bucket){
+            std::size_t offset = offsets[digit];
+            for (std::size_t k = 0; k != per_bucket; ++k)
+                dst[offset + k] = std::move(slot[k]);
+            offsets[digit] += per_bucket;
+            fill[digit] = 0;
+        }
+    }
+    for (std::size_t digit = 0; digit != radix_buckets; ++digit){
+        T *slot = combine + digit * per_bucket;
+        for (std::size_t k = 0; k != fill[digit]; ++k)
+            dst[offsets[digit] + k] = std::move(slot[k]);
+    }
+}
+
+// parallelRadixPass: 并行基数排序的一趟
+/*
+ * 输入序列被均分为chunks段, 每段由一个任务处理:
+ *      --每个任务统计自己那一段的局部直方图;
+ *      --按"数字优先,段次之"的次序对所有局部直方图求前缀和, 得到每段每个桶在输出序列中的起始位置,
+ *        这样同一个桶中, 前面段的元素依然排在后面段的元素之前, 保证了稳定性;
+ *      --每个任务把自己那一段分配到预先计算好的位置上, 各任务写入的区域互不重叠.
+ *
+ */
+template<typename SrcIterator, typename DstIterator>
+void parallelRadixPass(WorkStealingPool &pool, SrcIterator src, DstIterator dst, std::size_t size,
+                       std::size_t chunks, std::size_t shift, std::vector<std::size_t> &local_counts,
+                       std::vector<typename std::iterator_traits<SrcIterator>::value_type> &combine)
+{
+    typedef typename std::iterator_traits<SrcIterator>::value_type T;
+    typedef RadixKeyTraits<T> Traits;
+    const std::size_t per_bucket = sizeof(T) >= radix_combine_bytes ? 1 : radix_combine_bytes / sizeof(T);
+    const std::size_t chunk_size = (size + chunks - 1) / chunks;
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != chunks; ++c){
+            group.run([=, &local_counts]{
+                std::size_t *counts = &local_counts[c * radix_buckets];
+                std::fill(counts, counts + radix_buckets, 0);
+                std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+                for (std::size_t i = from; i < to; ++i)
+                    ++counts[(Traits::toKey(src[i]) >> shift) & (radix_buckets - 1)];
+            });
+        }
+        group.wait();
+    }
+    std::size_t sum = 0;
+    for (std::size_t digit = 0; digit != radix_buckets; ++digit){
+        for (std::size_t c = 0; c != chunks; ++c){
+            std::size_t count = local_counts[c * radix_buckets + digit];
+            local_counts[c * radix_buckets + digit] = sum;
+            sum += count;
+        }
+    }
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != chunks; ++c){
+            group.run([=, &local_counts, &combine]{
+                std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+                if (from < to)
+                    radixScatterCombined(src, from, to, dst, &local_counts[c * radix_buckets], shift,
+                                         &combine[c * radix_buckets * per_bucket]);
+            });
+        }
+        group.wait();
+    }
+}
+
+// parallelRadixSort: 按执行策略的字节基数排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为radix_parallel_threshold;
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter scratch: 调用者提供的辅助空间, 长度不足时会被扩大, 多次排序时重复使用它可以避免每次分配;
+ * \return void.
+ *
+ * 算法基本思想: 与lsdRadixSort相同, 输入被均分为exec.threads()段, 每一趟由parallelRadixPass并行完成;
+ *              先并行地读一遍输入得到全局直方图, 用于跳过所有元素在某一位上都相同的趟.
+ *              串行策略或序列长度小于exec.grain(radix_parallel_threshold)时退化为lsdRadixSort.
+ *
+ * 算法性能: 时间复杂度为O(d(N/P + 256P)), P为线程个数; 额外空间为O(N + 256P). 稳定排序.
+ *
+ */
+template<typename Iterator>
+void parallelRadixSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &scratch)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef RadixKeyTraits<T> Traits;
+    typedef typename Traits::KeyType KeyType;
+    const std::size_t passes = sizeof(KeyType);
+    auto distance = std::distance(begin, end);
+    if (distance <= 1)
+        return;
+    std::size_t size = static_cast<std::size_t>(distance);
+    if (scratch.size() < size)
+        scratch.resize(size);
+    if (!exec.runParallel(size, radix_parallel_threshold)){
+        lsdRadixSort(begin, end, scratch.data());
+        return;
+    }
+    const std::size_t chunks = exec.threads();
+    const std::size_t chunk_size = (size + chunks - 1) / chunks;
+    const std::size_t per_bucket = sizeof(T) >= radix_combine_bytes ? 1 : radix_combine_bytes / sizeof(T);
+    WorkStealingPool &pool = exec.pool();
+    // 并行读一遍输入, 统计所有趟的全局直方图
+    std::vector<std::size_t> all_counts(chunks * passes * radix_buckets, 0);
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != chunks; ++c){
+            group.run([=, &all_counts]{
+                std::size_t *counts = &all_counts[c * passes * radix_buckets];
+                std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+                for (std::size_t i = from; i < to; ++i){
+                    KeyType key = Traits::toKey(begin[i]);
+                    for (std::size_t pass = 0; pass != passes; ++pass)
+                        ++counts[pass * radix_buckets + ((key >> (pass * radix_bits)) & (radix_buckets - 1))];
+                }
+            });
+        }
+        group.wait();
+    }
+    std::vector<std::size_t> local_counts(chunks * radix_buckets);
+    std::vector<T> combine(chunks * radix_buckets * per_bucket);
+    T *buffer = scratch.data();
+    bool in_buffer = false;
+    for (std::size_t pass = 0; pass != passes; ++pass){
+        std::size_t shift = pass * radix_bits;
+        KeyType first_key = Traits::toKey(in_buffer ? buffer[0] : *begin);
+        std::size_t digit = (first_key >> shift) & (radix_buckets - 1);
+        std::size_t total = 0;
+        for (std::size_t c = 0; c != chunks; ++c)
+            total += all_counts[(c * passes + pass) * radix_buckets + digit];
+        if (total == size)
+            continue;   // 所有元素在这一位上相同
+        if (in_buffer)
+            parallelRadixPass(pool, buffer, begin, size, chunks, shift, local_counts, combine);
+        else
+            parallelRadixPass(pool, begin, buffer, size, chunks, shift, local_counts, combine);
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer){
+        TaskGroup group(pool);
+        for (std::size_t c = 0; c != chunks; ++c){
+            group.run([=]{
+                std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+                if (from < to)
+                    std::move(buffer + from, buffer + to, begin + from);
+            });
+        }
+        group.wait();
+    }
+}
+
+// parallelRadixSort: 多线程的字节基数排序, 等价于parallelRadixSort(execution::par.withThreads(threads), ...)
+/*
+ * \parameter threads: 参与排序的线程个数(包括调用线程), 任务在共享的线程池中执行.
+ *
+ */
+template<typename Iterator>
+void parallelRadixSort(const Iterator begin, const Iterator end, std::size_t threads,
+                       std::vector<typename std::iterator_traits<Iterator>::value_type> &scratch)
+{
+    parallelRadixSort(execution::par.withThreads(threads), begin, end, scratch);
+}
+
+// radixSort: 按执行策略的基数排序
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h);
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \return void.
+ *
+ * 适用于任意整数类型以及float/double, 由parallelRadixSort完成, 辅助空间在函数内分配.
+ *
+ */
+template<typename Iterator>
+void radixSort(const ExecutionPolicy &exec, const Iterator begin, const Iterator end)
+{
+    std::vector<typename std::iterator_traits<Iterator>::value_type> scratch;
+    parallelRadixSort(exec, begin, end, scratch);
+}
+
+// radixSort: 多线程基数排序
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter radix_width: 待排序元素(必须是整数)的最大位宽, 必须非0;
+ * \parameter threads: 参与排序的线程个数(包括调用线程);
+ * \return void.
+ *
+ * 等价于radixSort(execution::par.withThreads(threads), begin, end); 需要重复使用辅助空间时直接调用parallelRadixSort.
+ *
+ */
+template<typename Iterator>
+void radixSort(const Iterator begin, const Iterator end, std::size_t radix_width, std::size_t threads)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T; 
+    assert(radix_width != 0);
+    static_assert(std::is_integral<T>::value, "sequence to be sorted must be integer!");
+    radixSort(execution::par.withThreads(threads), begin, end);
 }
 #endif
@@ -15,6 +15,10 @@ using std::begin;   using std::end;
 using std::vector;
 #include <algorithm>
 using std::sort;
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
 #include "radixSort.h"
 
 // 数组输出函数
@@ -161,6 +165,118 @@ void Test3()
     print(compareData5.begin(), compareData5.end());
 }
 
+// 对有符号整数, 64位整数以及浮点数的字节基数排序与sort比较
+template<typename T, typename Distribution>
+void checkRadixSort(const char *name, Distribution distribution, std::size_t size)
+{
+    std::default_random_engine e(2018);
+    vector<T> data(size);
+    for (auto &value : data)
+        value = static_cast<T>(distribution(e));
+    vector<T> compareData(data);
+    radixSort(data.begin(), data.end());
+    sort(compareData.begin(), compareData.end());
+    cout << name << ": " << (data == compareData ? "正确" : "错误") << endl;
+}
+
+void Test4()
+{
+    checkRadixSort<int>("int(含负数)", std::uniform_int_distribution<int>(-1000000, 1000000), 100000);
+    checkRadixSort<std::int64_t>("int64_t", std::uniform_int_distribution<std::int64_t>(INT64_MIN, INT64_MAX), 100000);
+    checkRadixSort<std::uint32_t>("uint32_t(只有低字节不同)", std::uniform_int_distribution<std::uint32_t>(0, 255), 100000);
+    checkRadixSort<float>("float", std::uniform_real_distribution<float>(-1e6f, 1e6f), 100000);
+    checkRadixSort<double>("double", std::normal_distribution<double>(0.0, 1e10), 100000);
+
+    vector<double> special{3.5, -0.0, 0.0, -1e300, 1e300, -2.25, 1e-300, -1e-300};
+    radixSort(special.begin(), special.end());
+    cout << "浮点数特殊值排序结果:\n";
+    print(special.begin(), special.end());
+}
+
+void Test5()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<std::uint64_t> u64;
+    std::uniform_int_distribution<int> u32(-1000000, 1000000);
+    vector<std::uint64_t> scratch;      // 两次排序重复使用同一块辅助空间
+    bool correct = true;
+    for (int round = 0; round != 2; ++round){
+        vector<std::uint64_t> data(300000);
+        for (auto &value : data)
+            value = u64(e);
+        vector<std::uint64_t> compareData(data);
+        parallelRadixSort(data.begin(), data.end(), 4, scratch);
+        sort(compareData.begin(), compareData.end());
+        correct = correct && data == compareData;
+    }
+    cout << "uint64_t(重复使用辅助空间): " << (correct ? "正确" : "错误") << endl;
+
+    vector<int> data(200000);
+    for (auto &value : data)
+        value = u32(e);
+    vector<int> compareData(data);
+    radixSort(data.begin(), data.end(), 7, 3);
+    sort(compareData.begin(), compareData.end());
+    cout << "int(3个线程): " << (data == compareData ? "正确" : "错误") << endl;
+}
+
+void Test6()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-50, 50);
+    // 列式数据: 键列与两个不同宽度的值列
+    vector<int> keys(100000);
+    for (auto &key : keys)
+        key = u(e);
+    vector<std::uint16_t> rows(keys.size());
+    vector<std::string> names(keys.size());
+    for (std::size_t i = 0; i != keys.size(); ++i){
+        rows[i] = static_cast<std::uint16_t>(i);
+        names[i] = "row" + std::to_string(i);
+    }
+    vector<std::pair<int, std::size_t>> compareData;
+    for (std::size_t i = 0; i != keys.size(); ++i)
+        compareData.push_back(std::make_pair(keys[i], i));
+    std::stable_sort(compareData.begin(), compareData.end(),
+                     [](const std::pair<int, std::size_t> &a, const std::pair<int, std::size_t> &b){ return a.first < b.first; });
+
+    vector<std::size_t> permutation = radixArgsort(keys.begin(), keys.end());
+    bool argsort_right = true;
+    for (std::size_t i = 0; i != keys.size(); ++i)
+        argsort_right = argsort_right && permutation[i] == compareData[i].second;
+    cout << "radixArgsort(稳定): " << (argsort_right ? "正确" : "错误") << endl;
+
+    vector<int> keys2(keys);
+    radixSortPairs(keys.begin(), keys.end(), rows.begin());
+    radixSortPairs(keys2.begin(), keys2.end(), names.begin());
+    bool pairs_right = true;
+    for (std::size_t i = 0; i != keys.size(); ++i){
+        pairs_right = pairs_right && keys[i] == compareData[i].first && keys2[i] == keys[i]
+                      && rows[i] == static_cast<std::uint16_t>(compareData[i].second)
+                      && names[i] == "row" + std::to_string(compareData[i].second);
+    }
+    cout << "radixSortPairs(短值与字符串值): " << (pairs_right ? "正确" : "错误") << endl;
+}
+
+void Test7()
+{
+    std::default_random_engine e(2018);
+    std::uniform_real_distribution<double> u(-1000.0, 1000.0);
+    vector<double> data(200000);
+    for (auto &value : data)
+        value = u(e);
+    vector<double> compareData(data);
+    sort(compareData.begin(), compareData.end());
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(3).withGrain(1000)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(3线程, 粒度1000)"};
+    for (int p = 0; p != 4; ++p){
+        vector<double> sorted(data);
+        radixSort(policies[p], sorted.begin(), sorted.end());
+        cout << names[p] << " double: " << (sorted == compareData ? "正确" : "错误") << endl;
+    }
+}
+
 int main()
 {
     cout << "******************对C数组升序排列测试******************\n";
@@ -171,5 +287,17 @@ int main()
     cout << "******************对vector数组升序排列测试*************\n";
     Test3();
 
+    cout << "******************字节基数排序测试*********************\n";
+    Test4();
+
+    cout << "******************多线程基数排序测试*******************\n";
+    Test5();
+
+    cout << "******************键值对基数排序测试*******************\n";
+    Test6();
+
+    cout << "******************执行策略测试*************************\n";
+    Test7();
+
     return 0;
 }
@@ -0,0 +1,427 @@
+/*************************************************************************
+	> File Name: sortBench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 20时05分37秒
+ ************************************************************************/
+// 排序算法性能测试: 对各个排序算法在不同分布, 长度, 元素类型上计时, 以CSV格式输出
+/*
+ * 用法: ./sort_bench [最大长度(默认1000000)] [重复次数(默认3)] [数据集文件]
+ *      长度从1e3开始每次乘10, 直到最大长度(最大可到1e9, 需要足够的内存);
+ *      给出数据集文件(格式见Binary-search/binaryDataset.h)时只测试文件中的数据, 分布一栏为file,
+ *      文件用mmap映射, 不需要解析.
+ *
+ * 输出的每一行:
+ *      algorithm,type,distribution,size,ns_per_element,comparisons,moves,cycles,branch_misses,llc_misses,verified
+ *      --ns_per_element: 多次运行中最快一次的每个元素平均纳秒数;
+ *      --comparisons, moves: 比较排序在单线程下用Counted<T>包装元素后统计的比较次数与移动(拷贝)次数,
+ *        长度超过count_max_size或者不是比较排序时为空;
+ *      --cycles, branch_misses, llc_misses: 最快一次运行的硬件计数器(Linux perf_event), 无法使用时为空;
+ *      --verified: 排序结果是否有序.
+ * 平方复杂度的算法只在较短的序列上测试.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "../insert_sort/insertSort.h"
+#include "../merge_sort/mergeSort.h"
+#include "../merge_sort/timSort.h"
+#include "../quick_sort/quickSort.h"
+#include "../heap_sort/heapSort.h"
+#include "../counting_sort/countingSort.h"
+#include "../radix_sort/radixSort.h"
+#include "../bucket_sort/bucketSort.h"
+#include "../../Binary-search/binaryDataset.h"
+
+const std::size_t count_max_size = 1000000;     // 统计比较次数与移动次数的最大长度
+
+//****************************元素类型*******************************
+// Record64: 64字节的记录, 按key排序
+struct Record64
+{
+    std::uint64_t key;
+    char payload[56];
+};
+
+inline bool operator< (const Record64 &a, const Record64 &b) { return a.key < b.key; }
+
+template<typename T>
+T makeElement(std::uint64_t value) { return static_cast<T>(value); }
+
+template<>
+Record64 makeElement<Record64>(std::uint64_t value)
+{
+    Record64 record;
+    record.key = value;
+    std::memset(record.payload, static_cast<int>(value & 0xff), sizeof(record.payload));
+    return record;
+}
+
+// Counted: 统计比较次数与移动次数的元素包装(只用于单线程)
+template<typename T>
+struct Counted
+{
+    static std::uint64_t comparisons;
+    static std::uint64_t moves;
+    T value;
+
+    Counted(): value() {  }
+    Counted(const T &v): value(v) {  }
+    Counted(const Counted &other): value(other.value) { ++moves; }
+    Counted& operator= (const Counted &other) { value = other.value; ++moves; return *this; }
+    friend bool operator< (const Counted &a, const Counted &b) { ++comparisons; return a.value < b.value; }
+};
+template<typename T> std::uint64_t Counted<T>::comparisons = 0;
+template<typename T> std::uint64_t Counted<T>::moves = 0;
+
+//****************************数据分布*******************************
+// generate: 生成长度为size的输入, 基本值在[0, size)中
+std::vector<std::uint64_t> generate(const std::string &distribution, std::size_t size)
+{
+    std::vector<std::uint64_t> values(size);
+    std::mt19937_64 e(size);
+    if (distribution == "uniform"){
+        std::uniform_int_distribution<std::uint64_t> u(0, size - 1);
+        for (auto &v : values)
+            v = u(e);
+    }else if (distribution == "sorted"){
+        for (std::size_t i = 0; i != size; ++i)
+            values[i] = i;
+    }else if (distribution == "reversed"){
+        for (std::size_t i = 0; i != size; ++i)
+            values[i] = size - 1 - i;
+    }else if (distribution == "organ_pipe"){
+        for (std::size_t i = 0; i != size; ++i)
+            values[i] = i < size / 2 ? i : size - 1 - i;
+    }else if (distribution == "few_unique"){
+        std::uniform_int_distribution<std::uint64_t> u(0, 15);
+        for (auto &v : values)
+            v = u(e);
+    }else if (distribution == "zipf"){
+        // 取值个数为min(size, 2^16), 第k个值出现的概率正比于1/k
+        std::size_t ranks = std::min<std::size_t>(size, 1 << 16);
+        std::vector<double> cdf(ranks);
+        double sum = 0;
+        for (std::size_t k = 0; k != ranks; ++k)
+            cdf[k] = (sum += 1.0 / (k + 1));
+        std::uniform_real_distribution<double> u(0, sum);
+        for (auto &v : values)
+            v = std::lower_bound(cdf.begin(), cdf.end(), u(e)) - cdf.begin();
+    }else{  // all_equal
+        for (auto &v : values)
+            v = 42;
+    }
+    return values;
+}
+
+//****************************硬件计数器*****************************
+// PerfCounters: 通过perf_event_open读取cycles, branch-misses, LLC misses; 不可用时available()为false
+class PerfCounters
+{
+public:
+    PerfCounters()
+    {
+        for (int i = 0; i != events; ++i)
+            fds[i] = open(i);
+    }
+    ~PerfCounters()
+    {
+        for (int i = 0; i != events; ++i)
+            if (fds[i] >= 0)
+                closeFd(fds[i]);
+    }
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters& operator= (const PerfCounters &) = delete;
+
+    bool available(int i) const { return fds[i] >= 0; }
+    void start()
+    {
+#ifdef __linux__
+        for (int i = 0; i != events; ++i){
+            if (fds[i] >= 0){
+                ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+    void stop(long long values[])
+    {
+        for (int i = 0; i != events; ++i){
+            values[i] = -1;
+#ifdef __linux__
+            if (fds[i] >= 0){
+                ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fds[i], &values[i], sizeof(long long)) != sizeof(long long))
+                    values[i] = -1;
+            }
+#endif
+        }
+    }
+    static const int events = 3;
+private:
+    int fds[events];
+#ifdef __linux__
+    // open: 打开第i个计数器(cycles, branch-misses, LLC misses)
+    static int open(int i)
+    {
+        const unsigned long long configs[events] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES,
+                                                    PERF_COUNT_HW_CACHE_MISSES};
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;       // 统计线程池中的工作线程
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    static void closeFd(int fd) { close(fd); }
+#else
+    static int open(int) { return -1; }
+    static void closeFd(int) {  }
+#endif
+};
+
+//****************************排序算法*******************************
+template<typename T>
+struct BenchAlgorithm
+{
+    std::string name;
+    std::function<void (std::vector<T> &)> sort;
+    std::function<void (std::vector<Counted<T>> &)> counted_sort;   // 为空表示不统计比较/移动次数
+    std::size_t max_size;           // 超过该长度不测试
+    std::size_t adversarial_max;    // 非均匀分布上超过该长度不测试(对这些输入为平方复杂度)
+};
+
+struct InsertSortRun { template<typename It> void operator() (It b, It e) const { insertSort(b, e); } };
+struct MergeSortRun { template<typename It> void operator() (It b, It e) const { mergeSort(b, e); } };
+struct BottomUpMergeSortRun { template<typename It> void operator() (It b, It e) const { bottomUpMergeSort(b, e); } };
+struct TimSortRun { template<typename It> void operator() (It b, It e) const { timSort(b, e); } };
+struct QuickSortRun { template<typename It> void operator() (It b, It e) const { quickSort(b, e); } };
+struct IntroSortRun { template<typename It> void operator() (It b, It e) const { introSort(b, e); } };
+struct HeapSortRun { template<typename It> void operator() (It b, It e) const { HeapSort<It> s; s(b, e); } };
+struct DaryHeapSortRun { template<typename It> void operator() (It b, It e) const { DaryHeapSort<It> s; s(b, e); } };
+struct ParallelQuickSortRun
+{
+    std::size_t threads;
+    template<typename It> void operator() (It b, It e) const
+    {
+        typedef typename std::iterator_traits<It>::value_type V;
+        parallelQuickSort(b, e, std::less<V>(), threads);
+    }
+};
+struct SampleSortRun
+{
+    std::size_t threads;
+    template<typename It> void operator() (It b, It e) const
+    {
+        typedef typename std::iterator_traits<It>::value_type V;
+        sampleSort(b, e, std::less<V>(), threads);
+    }
+};
+
+// comparisonAlgorithm: 比较排序, 计数版本在Counted<T>上单线程运行
+template<typename T, typename Sorter, typename CountedSorter>
+BenchAlgorithm<T> comparisonAlgorithm(const std::string &name, Sorter sorter, CountedSorter counted,
+                                      std::size_t max_size = SIZE_MAX, std::size_t adversarial_max = SIZE_MAX)
+{
+    BenchAlgorithm<T> algorithm;
+    algorithm.name = name;
+    algorithm.sort = [sorter](std::vector<T> &v){ sorter(v.begin(), v.end()); };
+    algorithm.counted_sort = [counted](std::vector<Counted<T>> &v){ counted(v.begin(), v.end()); };
+    algorithm.max_size = max_size;
+    algorithm.adversarial_max = adversarial_max;
+    return algorithm;
+}
+
+template<typename T>
+BenchAlgorithm<T> plainAlgorithm(const std::string &name, std::function<void (std::vector<T> &)> sort)
+{
+    BenchAlgorithm<T> algorithm;
+    algorithm.name = name;
+    algorithm.sort = sort;
+    algorithm.max_size = SIZE_MAX;
+    algorithm.adversarial_max = SIZE_MAX;
+    return algorithm;
+}
+
+// 非比较排序只用于算术类型: 整数使用countingSort与radixSort, 浮点数使用radixSort与bucketSort
+template<typename T>
+void addDistributionSorts(std::vector<BenchAlgorithm<T>> &, std::false_type, std::false_type) {  }
+
+template<typename T>
+void addDistributionSorts(std::vector<BenchAlgorithm<T>> &algorithms, std::true_type, std::true_type)
+{
+    algorithms.push_back(plainAlgorithm<T>("countingSort", [](std::vector<T> &v){
+        countingSort(v.begin(), v.end(), *std::max_element(v.begin(), v.end()));
+    }));
+    algorithms.push_back(plainAlgorithm<T>("radixSort", [](std::vector<T> &v){ radixSort(v.begin(), v.end()); }));
+}
+
+template<typename T>
+void addDistributionSorts(std::vector<BenchAlgorithm<T>> &algorithms, std::true_type, std::false_type)
+{
+    algorithms.push_back(plainAlgorithm<T>("radixSort", [](std::vector<T> &v){ radixSort(v.begin(), v.end()); }));
+    algorithms.push_back(plainAlgorithm<T>("bucketSort", [](std::vector<T> &v){
+        auto range = std::minmax_element(v.begin(), v.end());
+        // bucketSort要求元素严格小于上界
+        bucketSort(v.begin(), v.end(), *range.first, *range.second + 1);
+    }));
+}
+
+template<typename T>
+std::vector<BenchAlgorithm<T>> algorithms()
+{
+    std::size_t threads = WorkStealingPool::defaultThreads();
+    std::vector<BenchAlgorithm<T>> result;
+    result.push_back(comparisonAlgorithm<T>("insertSort", InsertSortRun(), InsertSortRun(), 10000));
+    result.push_back(comparisonAlgorithm<T>("mergeSort", MergeSortRun(), MergeSortRun()));
+    result.push_back(comparisonAlgorithm<T>("bottomUpMergeSort", BottomUpMergeSortRun(), BottomUpMergeSortRun()));
+    result.push_back(comparisonAlgorithm<T>("timSort", TimSortRun(), TimSortRun()));
+    result.push_back(comparisonAlgorithm<T>("quickSort", QuickSortRun(), QuickSortRun(), SIZE_MAX, 10000));
+    result.push_back(comparisonAlgorithm<T>("introSort", IntroSortRun(), IntroSortRun()));
+    result.push_back(comparisonAlgorithm<T>("parallelQuickSort", ParallelQuickSortRun{threads}, ParallelQuickSortRun{1}));
+    result.push_back(comparisonAlgorithm<T>("HeapSort", HeapSortRun(), HeapSortRun()));
+    result.push_back(comparisonAlgorithm<T>("DaryHeapSort", DaryHeapSortRun(), DaryHeapSortRun()));
+    result.push_back(comparisonAlgorithm<T>("sampleSort", SampleSortRun{threads}, SampleSortRun{1}));
+    addDistributionSorts(result, std::integral_constant<bool, std::is_arithmetic<T>::value>(),
+                         std::integral_constant<bool, std::is_integral<T>::value>());
+    return result;
+}
+
+//****************************测试过程*******************************
+template<typename T>
+bool sorted(const std::vector<T> &v)
+{
+    for (std::size_t i = 1; i < v.size(); ++i)
+        if (v[i] < v[i - 1])
+            return false;
+    return true;
+}
+
+std::string field(long long value) { return value < 0 ? std::string() : std::to_string(value); }
+
+// runCase: 在input上测试所有算法, 每个算法输出一行
+template<typename T>
+void runCase(std::vector<BenchAlgorithm<T>> &list, const std::string &type, const std::string &distribution,
+             const std::vector<T> &input, int repeat, PerfCounters &perf)
+{
+    const std::size_t size = input.size();
+    for (auto &algorithm : list){
+        bool adversarial = distribution != "uniform";
+        if (size > algorithm.max_size || (adversarial && size > algorithm.adversarial_max))
+            continue;
+        double best = -1;
+        long long counters[PerfCounters::events] = {-1, -1, -1};
+        bool verified = true;
+        for (int r = 0; r != repeat; ++r){
+            std::vector<T> data(input);
+            long long current[PerfCounters::events];
+            perf.start();
+            auto start = std::chrono::steady_clock::now();
+            algorithm.sort(data);
+            auto stop = std::chrono::steady_clock::now();
+            perf.stop(current);
+            verified = verified && sorted(data);
+            double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            if (best < 0 || ns < best){
+                best = ns;
+                std::copy(current, current + PerfCounters::events, counters);
+            }
+        }
+        long long comparisons = -1, moves = -1;
+        if (algorithm.counted_sort && size <= count_max_size){
+            std::vector<Counted<T>> data(input.begin(), input.end());
+            Counted<T>::comparisons = Counted<T>::moves = 0;
+            algorithm.counted_sort(data);
+            comparisons = static_cast<long long>(Counted<T>::comparisons);
+            moves = static_cast<long long>(Counted<T>::moves);
+        }
+        std::cout << algorithm.name << "," << type << "," << distribution << "," << size << ","
+                  << best / size << "," << field(comparisons) << "," << field(moves) << ","
+                  << field(counters[0]) << "," << field(counters[1]) << "," << field(counters[2]) << ","
+                  << (verified ? "yes" : "no") << std::endl;
+    }
+}
+
+template<typename T>
+void runSuite(const std::string &type, std::size_t max_size, int repeat, PerfCounters &perf)
+{
+    const char *distributions[] = {"uniform", "sorted", "reversed", "organ_pipe", "few_unique", "zipf", "all_equal"};
+    std::vector<BenchAlgorithm<T>> list = algorithms<T>();
+    for (std::size_t size = 1000; size <= max_size; size *= 10){
+        for (const char *distribution : distributions){
+            std::vector<std::uint64_t> values = generate(distribution, size);
+            std::vector<T> input;
+            input.reserve(size);
+            for (auto v : values)
+                input.push_back(makeElement<T>(v));
+            runCase(list, type, distribution, input, repeat, perf);
+        }
+    }
+}
+
+// runDataset: 测试数据集文件中的前max_size个元素
+template<typename T>
+void runDataset(const std::string &filename, const std::string &type, std::size_t max_size, int repeat, PerfCounters &perf)
+{
+    MappedDataset<T> dataset(filename, dataset_sequential);
+    std::vector<T> input(dataset.begin(), dataset.begin() + std::min(max_size, dataset.size()));
+    std::vector<BenchAlgorithm<T>> list = algorithms<T>();
+    // countingSort只能排序取值范围不大的非负整数, 文件中的数据不满足时不测试它
+    if (!input.empty()){
+        auto range = std::minmax_element(input.begin(), input.end());
+        if (*range.first < T() || *range.second >= static_cast<T>(counting_sort_max_range)){
+            list.erase(std::remove_if(list.begin(), list.end(), [](const BenchAlgorithm<T> &algorithm){
+                return algorithm.name == "countingSort";
+            }), list.end());
+        }
+    }
+    runCase(list, type, "file", input, repeat, perf);
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t max_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int repeat = argc > 2 ? std::atoi(argv[2]) : 3;
+    if (repeat < 1)
+        repeat = 1;
+    PerfCounters perf;
+    if (!perf.available(0))
+        std::cerr << "perf_event不可用, 硬件计数器一栏为空" << std::endl;
+    std::cout << "algorithm,type,distribution,size,ns_per_element,comparisons,moves,"
+                 "cycles,branch_misses,llc_misses,verified" << std::endl;
+    if (argc > 3){
+        switch (readDatasetHeader(argv[3]).type){
+        case dataset_int32: runDataset<std::int32_t>(argv[3], "int32", max_size, repeat, perf); break;
+        case dataset_int64: runDataset<std::int64_t>(argv[3], "int64", max_size, repeat, perf); break;
+        case dataset_double: runDataset<double>(argv[3], "double", max_size, repeat, perf); break;
+        default: std::cerr << "sort_bench只测试int32, int64与double类型的数据集" << std::endl; return 1;
+        }
+        return 0;
+    }
+    runSuite<std::int32_t>("int32", max_size, repeat, perf);
+    runSuite<std::int64_t>("int64", max_size, repeat, perf);
+    runSuite<double>("double", max_size, repeat, perf);
+    runSuite<Record64>("record64", max_size, repeat, perf);
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/*************************************************************************
+	> File Name: sortingNetwork.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 16时40分12秒
+ ************************************************************************/
+
+#ifndef _SORTINGNETWORK_H
+#define _SORTINGNETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "../insert_sort/insertSort.h"
+// 排序网络: 用于小序列(不超过64个元素)的排序  算法导论(第一版)第27章, Knuth 5.3.4
+/*
+ * 排序网络由固定次序的"比较-交换"组成, 比较的次序与数据无关, 所以:
+ *      --没有数据相关的分支, 不会发生分支预测失败;
+ *      --同一层中互不相关的比较-交换可以用SIMD的min/max一次完成.
+ *
+ * 这里使用双调排序网络(bitonic sort): 长度为N(2的幂)的序列需要log(N)(log(N)+1)/2层, 每层N/2次比较-交换.
+ * 在同一层中, 下标差为j的元素两两比较; 当j不小于SIMD寄存器的宽度时, 一块连续的j个元素可以与
+ * 另一块连续的j个元素做"竖直"的min/max, 这部分用AVX2/AVX-512完成(编译时加-mavx2或-mavx512f),
+ * 其余部分是无分支的标量min/max.
+ *
+ */
+
+// compareExchangeBlock: 对lo[0..len)与hi[0..len)逐个做比较-交换, ascending为true时较小值放到lo
+template<typename T>
+inline void compareExchangeBlock(T *lo, T *hi, std::size_t len, bool ascending)
+{
+    for (std::size_t i = 0; i != len; ++i){
+        T a = lo[i], b = hi[i];
+        T small = b < a ? b : a;
+        T large = b < a ? a : b;
+        lo[i] = ascending ? small : large;
+        hi[i] = ascending ? large : small;
+    }
+}
+
+#if defined(__AVX512F__)
+inline void compareExchangeBlock(std::int32_t *lo, std::int32_t *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16){
+        __m512i a = _mm512_loadu_si512(lo + i), b = _mm512_loadu_si512(hi + i);
+        __m512i small = _mm512_min_epi32(a, b), large = _mm512_max_epi32(a, b);
+        _mm512_storeu_si512(lo + i, ascending ? small : large);
+        _mm512_storeu_si512(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<std::int32_t>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(std::int64_t *lo, std::int64_t *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8){
+        __m512i a = _mm512_loadu_si512(lo + i), b = _mm512_loadu_si512(hi + i);
+        __m512i small = _mm512_min_epi64(a, b), large = _mm512_max_epi64(a, b);
+        _mm512_storeu_si512(lo + i, ascending ? small : large);
+        _mm512_storeu_si512(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<std::int64_t>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(float *lo, float *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16){
+        __m512 a = _mm512_loadu_ps(lo + i), b = _mm512_loadu_ps(hi + i);
+        __m512 small = _mm512_min_ps(a, b), large = _mm512_max_ps(a, b);
+        _mm512_storeu_ps(lo + i, ascending ? small : large);
+        _mm512_storeu_ps(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<float>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(double *lo, double *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8){
+        __m512d a = _mm512_loadu_pd(lo + i), b = _mm512_loadu_pd(hi + i);
+        __m512d small = _mm512_min_pd(a, b), large = _mm512_max_pd(a, b);
+        _mm512_storeu_pd(lo + i, ascending ? small : large);
+        _mm512_storeu_pd(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<double>(lo + i, hi + i, len - i, ascending);
+}
+#elif defined(__AVX2__)
+inline void compareExchangeBlock(std::int32_t *lo, std::int32_t *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lo + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hi + i));
+        __m256i small = _mm256_min_epi32(a, b), large = _mm256_max_epi32(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lo + i), ascending ? small : large);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hi + i), ascending ? large : small);
+    }
+    compareExchangeBlock<std::int32_t>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(std::int64_t *lo, std::int64_t *hi, std::size_t len, bool ascending)
+{
+    // AVX2没有64位整数的min/max, 用比较结果做掩码混合
+    std::size_t i = 0;
+    for (; i + 4 <= len; i += 4){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lo + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hi + i));
+        __m256i greater = _mm256_cmpgt_epi64(a, b);
+        __m256i small = _mm256_blendv_epi8(a, b, greater), large = _mm256_blendv_epi8(b, a, greater);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lo + i), ascending ? small : large);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(hi + i), ascending ? large : small);
+    }
+    compareExchangeBlock<std::int64_t>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(float *lo, float *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= len; i += 8){
+        __m256 a = _mm256_loadu_ps(lo + i), b = _mm256_loadu_ps(hi + i);
+        __m256 small = _mm256_min_ps(a, b), large = _mm256_max_ps(a, b);
+        _mm256_storeu_ps(lo + i, ascending ? small : large);
+        _mm256_storeu_ps(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<float>(lo + i, hi + i, len - i, ascending);
+}
+inline void compareExchangeBlock(double *lo, double *hi, std::size_t len, bool ascending)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= len; i += 4){
+        __m256d a = _mm256_loadu_pd(lo + i), b = _mm256_loadu_pd(hi + i);
+        __m256d small = _mm256_min_pd(a, b), large = _mm256_max_pd(a, b);
+        _mm256_storeu_pd(lo + i, ascending ? small : large);
+        _mm256_storeu_pd(hi + i, ascending ? large : small);
+    }
+    compareExchangeBlock<double>(lo + i, hi + i, len - i, ascending);
+}
+#endif
+
+// bitonicSort: 对长度为N(2的幂)的数组做双调排序, 结果为升序
+template<std::size_t N, typename T>
+void bitonicSort(T *data)
+{
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N must be a power of two!");
+    for (std::size_t k = 2; k <= N; k <<= 1){
+        for (std::size_t j = k >> 1; j != 0; j >>= 1){
+            // 每2j个元素为一块, 前j个与后j个比较; 块内方向相同, 由块在长度为k的双调序列中的位置决定
+            for (std::size_t block = 0; block != N; block += 2 * j)
+                compareExchangeBlock(data + block, data + block + j, j, (block & k) == 0);
+        }
+    }
+}
+
+// NetworkCompare: 判断比较函数能否用min/max代替(std::less与std::greater), 以及填充用的值
+template<typename T, typename CompareType>
+struct NetworkCompare
+{
+    static const bool supported = false;
+};
+template<typename T>
+struct NetworkCompare<T, std::less<T>>
+{
+    static const bool supported = true;
+    static const bool descending = false;
+    static T padding() { return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                                      : std::numeric_limits<T>::max(); }
+};
+template<typename T>
+struct NetworkCompare<T, std::greater<T>>
+{
+    static const bool supported = true;
+    static const bool descending = true;
+    static T padding() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                                      : std::numeric_limits<T>::lowest(); }
+};
+
+// networkElement: 排序网络支持的元素类型(32/64位的整数与浮点数), 统一映射到对应的有符号类型
+template<typename T, bool = std::is_integral<T>::value>
+struct NetworkElement
+{
+    typedef T type;
+};
+template<typename T>
+struct NetworkElement<T, true>
+{
+    typedef typename std::conditional<sizeof(T) == 4, std::int32_t, std::int64_t>::type type;
+};
+
+// IsContiguousIterator: 迭代器指向的元素是否连续存放(指针与std::vector<T>::iterator)
+template<typename Iterator>
+struct IsContiguousIterator
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    static const bool value = std::is_pointer<Iterator>::value
+                              || std::is_same<Iterator, typename std::vector<T>::iterator>::value;
+};
+
+// UseSortingNetwork: 编译时决定是否使用排序网络
+/*
+ * 元素必须是算术类型(std::is_arithmetic), 4字节或8字节, 有符号整数或浮点数(无符号整数用有符号的min/max会出错);
+ * 比较函数必须是std::less<T>或std::greater<T>; 迭代器必须连续存放元素.
+ *
+ */
+template<typename Iterator, typename CompareType>
+struct UseSortingNetwork
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    static const bool value = std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+                              && (std::is_floating_point<T>::value || std::is_signed<T>::value)
+                              && NetworkCompare<T, CompareType>::supported
+                              && IsContiguousIterator<Iterator>::value;
+};
+
+const std::size_t sorting_network_max = 64;     // 排序网络能处理的最大长度
+
+// networkSort: 用长度为N的排序网络对不超过N个元素排序(不足的部分用填充值补齐)
+template<std::size_t N, typename T, typename CompareType>
+void networkSort(T *data, std::size_t size)
+{
+    typedef typename NetworkElement<T>::type ElementType;
+    typedef NetworkCompare<T, CompareType> Traits;
+    ElementType buffer[N];
+    T padding = Traits::padding();
+    for (std::size_t i = 0; i != N; ++i)
+        buffer[i] = static_cast<ElementType>(i < size ? data[i] : padding);
+    bitonicSort<N>(buffer);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = static_cast<T>(Traits::descending ? buffer[N - 1 - i] : buffer[i]);
+}
+
+template<typename Iterator, typename CompareType>
+void smallSortDispatch(const Iterator begin, const Iterator end, CompareType compare, std::true_type)
+{
+    auto size = static_cast<std::size_t>(std::distance(begin, end));
+    if (size > sorting_network_max){
+        insertSort(begin, end, compare);
+        return;
+    }
+    auto data = &*begin;
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    if (size <= 8)
+        networkSort<8, T, CompareType>(data, size);
+    else if (size <= 16)
+        networkSort<16, T, CompareType>(data, size);
+    else if (size <= 32)
+        networkSort<32, T, CompareType>(data, size);
+    else
+        networkSort<64, T, CompareType>(data, size);
+}
+
+template<typename Iterator, typename CompareType>
+void smallSortDispatch(const Iterator begin, const Iterator end, CompareType compare, std::false_type)
+{
+    insertSort(begin, end, compare);
+}
+
+// smallSort: 小序列排序
+/*
+ * \parameter begin: 待排序序列的起始迭代器(也可以是指向数组中某元素的指针);
+ * \parameter end: 待排序序列的终止迭代器(也可以是指向数组中某元素的指针);
+ * \parameter compare: 一个可调用对象,可用于比较两个对象的小于比较,默认为std::less<T>;
+ * \return void.
+ *
+ * 满足UseSortingNetwork时(编译时决定), 不超过64个元素的序列用8/16/32/64的双调排序网络排序;
+ * 其它情况(一般的元素类型,自定义的比较函数,或序列较长)使用insertSort.
+ * 排序网络不是稳定的, 但对于std::less/std::greater比较的算术类型, 相等的元素无法区分.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+void smallSort(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    if (std::distance(begin, end) <= 1)
+        return;
+    smallSortDispatch(begin, end, compare,
+                      std::integral_constant<bool, UseSortingNetwork<Iterator, CompareType>::value>());
+}
+#endif
@@ -0,0 +1,83 @@
+/*************************************************************************
+	> File Name: sortingNetwork_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 17时25分09秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <algorithm>
+using std::sort;
+#include <cstdint>
+#include <random>
+#include <string>
+#include "sortingNetwork.h"
+
+template<typename Iterator>
+void print(const Iterator begin, const Iterator end)
+{
+    for (auto current = begin; current != end; ++current)
+        cout << *current << " ";
+    cout << endl;
+}
+
+// 对长度0~64的随机序列分别用smallSort和sort排序并比较
+template<typename T, typename CompareType>
+bool checkAllSizes(CompareType compare)
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-50, 50);
+    for (std::size_t size = 0; size <= sorting_network_max; ++size){
+        for (int round = 0; round != 20; ++round){
+            vector<T> data(size);
+            for (auto &value : data)
+                value = static_cast<T>(u(e)) / static_cast<T>(3);
+            vector<T> compareData(data);
+            smallSort(data.begin(), data.end(), compare);
+            sort(compareData.begin(), compareData.end(), compare);
+            if (data != compareData)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool compareInt(int num1, int num2)
+{
+    return num1 > num2;
+}
+
+void Test1()
+{
+    cout << "int32_t 升序(排序网络): " << (checkAllSizes<std::int32_t>(std::less<std::int32_t>()) ? "正确" : "错误") << endl;
+    cout << "int64_t 降序(排序网络): " << (checkAllSizes<std::int64_t>(std::greater<std::int64_t>()) ? "正确" : "错误") << endl;
+    cout << "float 升序(排序网络): " << (checkAllSizes<float>(std::less<float>()) ? "正确" : "错误") << endl;
+    cout << "double 降序(排序网络): " << (checkAllSizes<double>(std::greater<double>()) ? "正确" : "错误") << endl;
+    cout << "int 自定义比较函数(插入排序): " << (checkAllSizes<int>(compareInt) ? "正确" : "错误") << endl;
+    cout << "是否使用排序网络: int/std::less " << UseSortingNetwork<int *, std::less<int>>::value
+         << ", unsigned/std::less " << UseSortingNetwork<unsigned *, std::less<unsigned>>::value
+         << ", int/函数指针 " << UseSortingNetwork<int *, bool (*)(int, int)>::value << endl;
+}
+
+void Test2()
+{
+    int data[10] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    smallSort(data, data + 10);
+    print(data, data + 10);
+    vector<std::string> words{"network", "bitonic", "sort", "simd", "min", "max"};
+    smallSort(words.begin(), words.end());
+    print(words.begin(), words.end());
+}
+
+int main()
+{
+    cout << "****************排序网络与各种长度的测试***************\n";
+    Test1();
+    cout << "****************数组与非算术类型的测试*****************\n";
+    Test2();
+
+    return 0;
+}
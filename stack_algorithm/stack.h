@@ -11,6 +11,10 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 // Stack: 栈 算法导论10.1
 /*
  * 在栈中,被删除的是最近插入的元素:栈的实现是一种后进先出的数据结构
@@ -18,30 +22,38 @@
  *      --empty(S): 检查栈是否为空;
  *      --push(S,x): 向栈中压入一个元素;
  *      --pop(S): 栈中弹出一个元素.
+ *
+ * Alloc: 存放元素指针的数组的分配器(rebind为std::shared_ptr<T>的分配器, 默认的std::allocator与原来相同);
+ * 例如ResourceAllocator<T>(tree_algorithm/NodeArena/MemoryResource.h)使数组来自MonotonicBufferResource.
+ * 元素由调用者创建, 可以用std::allocate_shared<T>(stack.get_allocator(), ...)从同一个来源分配.
  */
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class Stack{
 public:
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<std::shared_ptr<T>> AllocatorType;
     //*************************构造函数**************************
     Stack(): size(0) {data.resize(0);}
-    explicit Stack(std::size_t reverse_size): size(0) {data.resize(reverse_size);}
+    explicit Stack(const Alloc &alloc): data(AllocatorType(alloc)), size(0) {  }
+    explicit Stack(std::size_t reverse_size, const Alloc &alloc = Alloc()): data(AllocatorType(alloc)), size(0)
+    {data.resize(reverse_size);}
     // 拷贝构造函数
     Stack(const Stack& stack)
-    {
-        size = stack.size;
-        std::copy(stack.data.begin(), stack.data.begin() + stack.size, data.begin());
-    }
+        : data(stack.data.begin(), stack.data.begin() + stack.size, stack.data.get_allocator()), size(stack.size) {  }
     // 拷贝赋值运算符
     Stack& operator=(const Stack& stack)
     {
+        data.assign(stack.data.begin(), stack.data.begin() + stack.size);
         size = stack.size;
-        std::copy(stack.data.begin(), stack.data.begin() + stack.size, data.begin());
         return *this;   // 返回一个此对象的引用
     }
     // 析构函数
     ~Stack() = default;
     //*************************成员函数**************************
     // empty: 检查栈是否为空.
+    /*
+     * 注意: 返回的是栈中元素的个数是否非0(栈不空时为true), 与名字相反; 已有的调用者依赖这一行为, 所以保留.
+     * 新代码请使用InlineStack::empty().
+    */
     bool empty()
     {
         assert(size >= 0);
@@ -79,9 +91,197 @@ public:
             data.resize(size * 2 + 2);      // 内存管理
         return data[size];
     }
+    AllocatorType get_allocator() const { return data.get_allocator(); }
 private:
     //*************************数据结构**************************
-    std::vector<std::shared_ptr<T>> data;   // 栈的数据
+    std::vector<std::shared_ptr<T>, AllocatorType> data;   // 栈的数据
     std::size_t size;   // 栈的大小
 };
+// StackHeapArena: InlineStack默认的内存来源(全局的operator new)
+/*
+ * 调用者可以提供自己的arena(例如tree_algorithm/NodeArena中的NodeArena), 只需要两个成员函数:
+ *      void* allocate(std::size_t bytes, std::size_t align);
+ *      void deallocate(void *p, std::size_t bytes, std::size_t align);
+ */
+struct StackHeapArena
+{
+    void* allocate(std::size_t bytes, std::size_t) { return ::operator new(bytes); }
+    void deallocate(void *p, std::size_t, std::size_t) { ::operator delete(p); }
+};
+// InlineStack: 按值存放元素, 带有内联小缓冲区的栈
+/*
+ * Stack为每个元素make_shared一次; pop()在size <= data.size() / 4时把容量改为size * 2 + 2, 之后再push一个元素
+ * 就又要扩容, 在这个边界附近交替地push与pop时每次都重新分配.
+ *
+ * InlineStack:
+ *      --元素按值连续存放, push复制或移动, emplace原地构造, pop直接析构栈顶的元素;
+ *      --前N个元素放在对象内部的缓冲区中, 元素个数超过N时才第一次分配内存(迭代的DFS, 解析器的栈通常很浅);
+ *      --扩容与缩容的阈值分开: 满时容量加倍, 元素个数降到容量的1/4以下时容量减半(降到N以下时回到内联缓冲区).
+ *        缩容以后至少还要push容量的1/4个元素才会再次扩容, 所以任何push/pop的序列的均摊代价都是O(1);
+ *      --堆上的内存来自调用者提供的arena(见StackHeapArena), 没有提供时使用operator new.
+ *        arena必须比栈活得长; 移动构造与交换时内存与arena一起转移.
+ *
+ * 算法性能: push, emplace, pop, top为均摊O(1).
+ *
+ */
+template<typename T, std::size_t N = 16, typename Arena = StackHeapArena>
+class InlineStack
+{
+    static_assert(N > 0, "InlineStack requires an inline buffer of at least one element");
+public:
+    //*************************构造函数**************************
+    explicit InlineStack(Arena *a = nullptr) : items(inlineItems()), count(0), cap(N), arena(a) {  }
+    InlineStack(const InlineStack &other) : items(inlineItems()), count(0), cap(N), arena(other.arena)
+    {
+        reserve(other.count);
+        for (std::size_t i = 0; i != other.count; ++i)
+            ::new (static_cast<void *>(items + i)) T(other.items[i]);
+        count = other.count;
+    }
+    InlineStack(InlineStack &&other) : items(inlineItems()), count(0), cap(N), arena(other.arena)
+    {
+        steal(other);
+    }
+    InlineStack& operator=(const InlineStack &other)
+    {
+        if (this != &other){
+            InlineStack copy(other);
+            clear();
+            release();
+            arena = copy.arena;
+            steal(copy);
+        }
+        return *this;
+    }
+    InlineStack& operator=(InlineStack &&other)
+    {
+        if (this != &other){
+            clear();
+            release();
+            arena = other.arena;
+            steal(other);
+        }
+        return *this;
+    }
+    ~InlineStack()
+    {
+        clear();
+        release();
+    }
+    //*************************成员函数**************************
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+    // onHeap: 元素是否已经不在内联缓冲区中
+    bool onHeap() const { return items != inlineItems(); }
+    // top: 栈顶的元素, 调用者保证非空
+    T& top() { return items[count - 1]; }
+    const T& top() const { return items[count - 1]; }
+    void push(const T &element) { emplace(element); }
+    void push(T &&element) { emplace(std::move(element)); }
+    // emplace: 用args在栈顶原地构造一个元素, 返回它的引用
+    template<typename... Args>
+    T& emplace(Args&&... args)
+    {
+        if (count == cap){
+            // 先构造新元素再搬移: args可能引用栈中的元素
+            T element(std::forward<Args>(args)...);
+            relocate(cap * 2);
+            ::new (static_cast<void *>(items + count)) T(std::move(element));
+        }else
+            ::new (static_cast<void *>(items + count)) T(std::forward<Args>(args)...);
+        return items[count++];
+    }
+    // pop: 弹出栈顶的元素, 调用者保证非空
+    void pop()
+    {
+        items[--count].~T();
+        if (onHeap() && count < cap / 4)
+            relocate(cap / 2);
+    }
+    // pop_value: 弹出并返回栈顶的元素, 调用者保证非空
+    T pop_value()
+    {
+        T element(std::move(items[count - 1]));
+        pop();
+        return element;
+    }
+    // reserve: 保证至少能放n个元素而不再分配
+    void reserve(std::size_t n)
+    {
+        if (n > cap)
+            relocate(n);
+    }
+    // clear: 删除所有元素(保留容量)
+    void clear()
+    {
+        while (count != 0)
+            items[--count].~T();
+    }
+    // shrink_to_fit: 把容量减为size(), 元素不超过N时回到内联缓冲区
+    void shrink_to_fit()
+    {
+        if (onHeap() && cap > std::max(count, N))
+            relocate(count);
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+    T* inlineItems() { return reinterpret_cast<T *>(buffer); }
+    const T* inlineItems() const { return reinterpret_cast<const T *>(buffer); }
+    // relocate: 把元素搬到能放capacity个元素的存储中(不超过N时为内联缓冲区)
+    void relocate(std::size_t capacity)
+    {
+        T *target = inlineItems();
+        if (capacity > N)
+            target = static_cast<T *>(arena ? arena->allocate(capacity * sizeof(T), alignof(T))
+                                            : ::operator new(capacity * sizeof(T)));
+        else
+            capacity = N;
+        for (std::size_t i = 0; i != count; ++i){
+            ::new (static_cast<void *>(target + i)) T(std::move_if_noexcept(items[i]));
+            items[i].~T();
+        }
+        release();
+        items = target;
+        cap = capacity;
+    }
+    // release: 归还堆上的存储(元素已经析构或搬走)
+    void release()
+    {
+        if (onHeap()){
+            if (arena)
+                arena->deallocate(items, cap * sizeof(T), alignof(T));
+            else
+                ::operator delete(items);
+        }
+        items = inlineItems();
+        cap = N;
+    }
+    // steal: 从other取得所有元素, 本栈为空并且使用内联缓冲区; other变为空栈
+    void steal(InlineStack &other)
+    {
+        if (other.onHeap()){
+            items = other.items;
+            cap = other.cap;
+            count = other.count;
+        }else{
+            for (std::size_t i = 0; i != other.count; ++i){
+                ::new (static_cast<void *>(items + i)) T(std::move(other.items[i]));
+                other.items[i].~T();
+            }
+            count = other.count;
+        }
+        other.items = other.inlineItems();
+        other.cap = N;
+        other.count = 0;
+    }
+
+    //*************************数据结构**************************
+    T *items;               // 当前的存储(内联缓冲区或堆)
+    std::size_t count;      // 元素个数
+    std::size_t cap;        // 容量
+    Arena *arena;           // 堆上的内存来源, nullptr表示operator new
+    Slot buffer[N];         // 内联缓冲区
+};
 #endif
@@ -0,0 +1,93 @@
+/*************************************************************************
+	> File Name: stack_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时14分58秒
+ ************************************************************************/
+// Stack(shared_ptr), std::vector与InlineStack在DFS式的push/pop序列上的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [操作次数(默认20000000)]
+ *      --shallow: 深度在0到12之间随机游走(解析器的栈), InlineStack<int, 16>不分配内存;
+ *      --deep: 先压入到深度100000, 再在这个深度附近随机游走, 然后全部弹出(大图的迭代DFS);
+ *      --boundary: 深度在1024与1025之间交替(正好是InlineStack扩容的边界, 分支可以预测, 只测量push/pop本身).
+ *
+ * 输出的每一行: stack,pattern,operations,ns_per_op
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "stack.h"
+
+typedef std::chrono::steady_clock Clock;
+std::int64_t bench_sink = 0;    // 弹出的元素之和, 使编译器不能省略
+
+// Adapters: 三种栈的相同接口
+struct SharedStack
+{
+    Stack<int> stack;
+    void push(int v) { stack.push(std::make_shared<int>(v)); }
+    int pop() { return *stack.pop(); }
+};
+struct VectorStack
+{
+    std::vector<int> stack;
+    void push(int v) { stack.push_back(v); }
+    int pop() { int v = stack.back(); stack.pop_back(); return v; }
+};
+struct SmallStack
+{
+    InlineStack<int, 16> stack;
+    void push(int v) { stack.push(v); }
+    int pop() { return stack.pop_value(); }
+};
+
+// run: 深度在[low, high]之间随机游走operations步
+template<typename S>
+void run(const char *name, const char *pattern, std::size_t low, std::size_t high, std::size_t operations)
+{
+    S s;
+    std::size_t depth = 0;
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    auto begin = Clock::now();
+    for (; depth != low; ++depth)
+        s.push(static_cast<int>(depth));
+    bool boundary = high == low + 1;
+    for (std::size_t i = 0; i != operations; ++i){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        bool up = boundary ? (i % 2 == 0) : ((state >> 40) & 1) != 0;
+        if ((up && depth != high) || depth == low){
+            s.push(static_cast<int>(i));
+            ++depth;
+        }else{
+            bench_sink += s.pop();
+            --depth;
+        }
+    }
+    while (depth-- != 0)
+        bench_sink += s.pop();
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / (operations + 2 * low);
+    std::cout << name << ',' << pattern << ',' << operations << ',' << ns << '\n';
+}
+template<typename S>
+void patterns(const char *name, std::size_t operations)
+{
+    run<S>(name, "shallow", 0, 12, operations);
+    run<S>(name, "deep", 100000, 100064, operations);
+    run<S>(name, "boundary", 1024, 1025, operations);
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::cout << "stack,pattern,operations,ns_per_op\n";
+    patterns<SharedStack>("Stack", operations);
+    patterns<VectorStack>("std::vector", operations);
+    patterns<SmallStack>("InlineStack", operations);
+    return bench_sink == 0 ? 1 : 0;
+}
@@ -7,7 +7,9 @@
 
 #include <iostream>
 using std::cout;    using std::endl;
+#include <string>
 #include "stack.h"
+#include "../tree_algorithm/NodeArena/MemoryResource.h"
 
 typedef Stack<int> IntStack;
 typedef Stack<double> DoubleStack;
@@ -50,6 +52,103 @@ void doubleTest()
     cout << endl;
 }
 
+int alive = 0;
+// Tracked: 记录存活的对象个数, 检查元素既没有泄漏也没有重复析构
+struct Tracked
+{
+    Tracked(int v = 0) : value(v), name(std::to_string(v)) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value), name(other.name) { ++alive; }
+    Tracked(Tracked &&other) noexcept : value(other.value), name(std::move(other.name)) { ++alive; }
+    Tracked& operator=(const Tracked &other) { value = other.value; name = other.name; return *this; }
+    ~Tracked() { --alive; }
+    int value;
+    std::string name;
+};
+// CountingArena: 记录分配次数的arena
+struct CountingArena
+{
+    CountingArena() : allocations(0), live(0) {  }
+    void* allocate(std::size_t bytes, std::size_t) { ++allocations; ++live; return ::operator new(bytes); }
+    void deallocate(void *p, std::size_t, std::size_t) { --live; ::operator delete(p); }
+    int allocations, live;
+};
+
+// inlineTest: 后进先出, 内联缓冲区, 扩容与缩容的阈值, 复制与移动, 调用者提供的arena
+void inlineTest()
+{
+    bool correct = true;
+    CountingArena arena;
+    {
+        InlineStack<Tracked, 8, CountingArena> stack(&arena);
+        correct = correct && stack.empty() && stack.capacity() == 8;
+        for (int i = 0; i != 8; ++i)
+            stack.emplace(i);
+        correct = correct && !stack.onHeap() && arena.allocations == 0;
+        for (int i = 8; i != 100; ++i)
+            stack.push(Tracked(i));
+        correct = correct && stack.onHeap() && stack.size() == 100 && stack.top().value == 99;
+        // 在扩容的边界附近交替push与pop, 不再分配
+        int before = arena.allocations;
+        for (int i = 0; i != 10000; ++i){
+            stack.push(stack.top());
+            stack.pop();
+            stack.pop();
+            stack.emplace(99);
+        }
+        correct = correct && arena.allocations == before && stack.top().value == 99;
+        for (int i = 99; i >= 50; --i)
+            correct = correct && stack.pop_value().value == i;
+        InlineStack<Tracked, 8, CountingArena> copy(stack), moved(std::move(copy));
+        correct = correct && copy.empty() && moved.size() == 50 && moved.top().name == "49";
+        // 弹出到2个元素: 容量逐次减半, 最后回到内联缓冲区
+        while (moved.size() != 2)
+            moved.pop();
+        correct = correct && !moved.onHeap() && moved.top().value == 1 && arena.live == 1;
+        copy = moved;
+        moved = std::move(stack);
+        correct = correct && copy.size() == 2 && moved.size() == 50 && stack.empty();
+        for (int i = 1; i >= 0; --i){
+            correct = correct && copy.top().value == i;
+            copy.pop();
+        }
+        moved.clear();
+        moved.shrink_to_fit();
+        correct = correct && !moved.onHeap() && moved.empty();
+        // 正好在扩容的边界上交替push与pop: 只扩容一次, 不缩容
+        InlineStack<int, 8, CountingArena> ints(&arena);
+        while (ints.size() != 64)
+            ints.push(static_cast<int>(ints.size()));
+        int allocations = arena.allocations;
+        for (int i = 0; i != 10000; ++i){
+            ints.push(i);
+            ints.pop();
+        }
+        correct = correct && arena.allocations == allocations + 1 && ints.capacity() == 128;
+        // args引用栈中的元素时扩容
+        InlineStack<std::string, 2> words;
+        words.push("parser");
+        words.push(words.top());
+        words.emplace(words.top());
+        correct = correct && words.size() == 3 && words.top() == "parser" && words.onHeap();
+    }
+    cout << "InlineStack: " << (correct && alive == 0 && arena.live == 0 ? "正确" : "错误") << endl;
+}
+
+// resourceTest: 指针数组与元素都从同一个MonotonicBufferResource分配
+void resourceTest()
+{
+    MonotonicBufferResource arena;
+    bool correct = true;
+    {
+        Stack<int, ResourceAllocator<int>> stack(4, &arena);
+        for (int i = 0; i != 100; ++i)
+            stack.push(std::allocate_shared<int>(stack.get_allocator(), i));
+        for (int i = 99; i >= 0; --i)
+            correct = *stack.pop() == i && correct;
+        correct = correct && stack.get_allocator().resource() == &arena;
+    }
+    cout << "从MemoryResource分配: " << (correct && arena.bytesAllocated() >= 100 * sizeof(int) ? "正确" : "错误") << endl;
+}
 
 int main()
 {
@@ -57,6 +156,10 @@ int main()
     intTest();
     cout << "*****************对double型数据测试**************************\n";
     doubleTest();
+    cout << "*****************InlineStack的测试***************************\n";
+    inlineTest();
+    cout << "*****************MemoryResource的测试************************\n";
+    resourceTest();
 
     return 0;
 }
@@ -26,37 +26,41 @@
 */
 #include <iostream>
 #include <functional>
+#include "../parallel_subset_sum/parallelSubsetSum.h"
 template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
 typename std::iterator_traits<Iterator>::value_type
 megre(Iterator begin, Iterator end, CompareType compare=CompareType())
 {
     typedef typename std::iterator_traits<Iterator>::value_type T;
+    auto size = std::distance(begin, end);
     // 基准情形
-    if (std::distance(begin, end) <= 1)
+    if (size <= 1)
         return *begin;
-    // 递归情形
-    auto center = begin + (std::distance(begin, end)) / 2;
+    // 递归情形: 左右两段[begin, center), [center, end)都不为空
+    auto center = begin + size / 2;
     T maxLeftSum = megre(begin, center, compare);
-    T maxRightSum = megre(center+1, end, compare);
+    T maxRightSum = megre(center, end, compare);
 
-    // 左侧
-    T maxLeftBounderSum = *center;
-    T leftBounderSum = *center - *center;
-    for (auto middle = center; middle != begin-1; --middle){
+    // 左侧: 以center-1结尾的最大和
+    auto middle = center - 1;
+    T leftBounderSum = *middle;
+    T maxLeftBounderSum = leftBounderSum;
+    while (middle != begin){
+        --middle;
         leftBounderSum += *middle;
-        if (compare(maxLeftSum, leftBounderSum))
+        if (compare(maxLeftBounderSum, leftBounderSum))
             maxLeftBounderSum = leftBounderSum;
     }
 
-    // 右侧
-    T maxRightBounderSum = *(center+1);
-    T rightBounderSum = *(center+1) - *(center+1);
-    for (auto middle = center+1; middle != end; ++middle){
-        rightBounderSum += *middle;
-        if (compare(maxRightSum, rightBounderSum))
+    // 右侧: 以center开头的最大和
+    T rightBounderSum = *center;
+    T maxRightBounderSum = rightBounderSum;
+    for (auto current = center + 1; current != end; ++current){
+        rightBounderSum += *current;
+        if (compare(maxRightBounderSum, rightBounderSum))
             maxRightBounderSum = rightBounderSum;
     }
-    
+
     // 返回三种情况的最大值
     auto max = maxLeftSum;
     if (compare(max, maxRightSum))
@@ -66,4 +70,51 @@ megre(Iterator begin, Iterator end, CompareType compare=CompareType())
 
     return max;
 }
+
+// megreSummary: megre的一层递归, 返回[begin, end)的摘要(见parallelSubsetSum.h中的SubsetSummary)
+/*
+ * 左半段作为任务放入线程池, 右半段由当前任务继续递归; 不超过leaf个元素的段由subsetSummary一次扫描完成.
+ * 两半的摘要由combineSummary合并, 横跨中点的最大和就是左半段的最大后缀和加上右半段的最大前缀和,
+ * 与megre中从中点向两侧的扫描相同, 但不需要再扫描一遍.
+ *
+ */
+template<typename Iterator, typename CompareType>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+megreSummary(WorkStealingPool &pool, Iterator begin, Iterator end, std::size_t leaf, CompareType &compare)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    if (size <= leaf)
+        return subsetSummary(begin, end, compare);
+    Iterator center = begin + size / 2;
+    SubsetSummary<T> left;
+    TaskGroup group(pool);
+    group.run([&]{ left = megreSummary(pool, begin, center, leaf, compare); });
+    SubsetSummary<T> right = megreSummary(pool, center, end, leaf, compare);
+    group.wait();
+    return combineSummary(left, right, compare);
+}
+
+// megre: 按执行策略的分治算法
+/*
+ *\parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为subset_parallel_threshold;
+ *\parameter begin: 待计算序列的起始迭代器(随机访问迭代器);
+ *\parameter end: 待计算序列的终止迭代器;
+ *\parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ *\return std::iterator_traits<Iterator>::value_type;
+ *
+ * 串行策略或序列较短时调用megre. 否则左右两半并行地递归(见megreSummary), 段长不超过N/exec.threads()时
+ * 不再拆分. 算法性能: O(N/P + logP).
+ *
+*/
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+typename std::iterator_traits<Iterator>::value_type
+megre(const ExecutionPolicy &exec, Iterator begin, Iterator end, CompareType compare=CompareType())
+{
+    std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    if (!exec.runParallel(size, subset_parallel_threshold))
+        return megre(begin, end, compare);
+    std::size_t leaf = (size + exec.threads() - 1) / exec.threads();
+    return megreSummary(exec.pool(), begin, end, leaf, compare).best;
+}
 #endif
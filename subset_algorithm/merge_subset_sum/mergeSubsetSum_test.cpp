@@ -11,6 +11,7 @@ using std::cout;    using std::endl;
 using std::vector;
 #include <array>
 using std::array;
+#include <random>
 #include "mergeSubsetSum.h"
 
 bool compare(int num1, int num2)
@@ -51,9 +52,30 @@ void Test1()
         << "最小相连子序列和:\t" << min << endl;
 }
 
+void Test2()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-1000, 999);
+    vector<int> data(1 << 19);
+    for (auto &x : data)
+        x = u(e);
+    int expectedMax = megre(data.begin(), data.end());
+    int expectedMin = megre(data.begin(), data.end(), compare);
+    const ExecutionPolicy policies[] = {execution::seq, execution::par, execution::par.withThreads(4),
+                                        execution::par_unseq.withThreads(3).withGrain(100)};
+    const char *names[] = {"seq", "par", "par(4线程)", "par_unseq(3线程, 粒度100)"};
+    for (int p = 0; p != 4; ++p){
+        bool right = megre(policies[p], data.begin(), data.end()) == expectedMax
+                     && megre(policies[p], data.begin(), data.end(), compare) == expectedMin;
+        cout << names[p] << " 最大和与最小和: " << (right ? "正确" : "错误") << endl;
+    }
+}
+
 int main()
 {
     Test1();
+    cout << "*********************执行策略的测试*************************\n";
+    Test2();
 
     return 0;
 }
@@ -23,6 +23,8 @@
 */
 #include <iostream>
 #include <functional>
+#include <iterator>
+#include "../parallel_subset_sum/parallelSubsetSum.h"
 template<typename Iterator, typename compareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
 typename std::iterator_traits<Iterator>::value_type
 online(Iterator begin, Iterator end, compareType compare=compareType())
@@ -35,16 +37,41 @@ online(Iterator begin, Iterator end, compareType compare=compareType())
 
     typedef typename std::iterator_traits<Iterator>::value_type T;
     T maxSum = *begin;
-    T thisSum = *begin - *begin;
-    for (auto index = begin; index != end; ++index){
-        thisSum += *index;
+    T thisSum = *begin;     // 以当前元素结尾的最大相连子序列和
+    const T zero = *begin - *begin;
+    for (auto index = std::next(begin); index != end; ++index){
+        // 以前一个元素结尾的和为负数时, 不如从当前元素重新开始
+        if (compare(thisSum, zero))
+            thisSum = *index;
+        else
+            thisSum += *index;
         if (compare(maxSum, thisSum))
             maxSum = thisSum;
-        else if (compare(thisSum, maxSum) && compare(thisSum, *begin - *begin))
-                thisSum = *begin - *begin;
     }
 
     return maxSum;
 }
 
+// online: 按执行策略求最大相连子序列和
+/*
+ *\parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为subset_parallel_threshold;
+ *\parameter begin: 待计算序列的起始迭代器(随机访问迭代器);
+ *\parameter end: 待计算序列的终止迭代器;
+ *\parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ *\return std::iterator_traits<Iterator>::value_type;
+ *
+ * 串行策略或序列较短时调用online. 否则每段在线程池中各自做一遍在线扫描, 得到(总和, 最大前缀和, 最大后缀和,
+ * 最大相连子序列和), 再按顺序合并(见parallelSubsetSum.h中的subsetSummary). 算法性能: O(N/P + P).
+ *
+*/
+template<typename Iterator, typename compareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+typename std::iterator_traits<Iterator>::value_type
+online(const ExecutionPolicy &exec, Iterator begin, Iterator end, compareType compare=compareType())
+{
+    auto size = std::distance(begin, end);
+    if (size < 1 || !exec.runParallel(static_cast<std::size_t>(size), subset_parallel_threshold))
+        return online(begin, end, compare);
+    return subsetSummary(exec, begin, end, compare).best;
+}
+
 #endif
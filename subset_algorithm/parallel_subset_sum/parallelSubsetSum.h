@@ -0,0 +1,195 @@
+/*************************************************************************
+	> File Name: parallelSubsetSum.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 22时56分20秒
+ ************************************************************************/
+
+#ifndef _PARALLELSUBSETSUM_H
+#define _PARALLELSUBSETSUM_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+
+const std::size_t kadane_lanes = 8;                                         // 同时扫描的子段个数
+const std::size_t subset_parallel_threshold = std::size_t(1) << 18;         // 不小于该长度的序列才使用多线程
+
+// SubsetSummary: 一段序列关于最大相连子序列和的摘要(所有子序列都非空)
+/*
+ * 两段相邻序列的摘要可以用combineSummary合并为整段的摘要, 合并满足结合律, 因此可以任意分段并行计算,
+ * 最后按顺序合并.
+ *
+ */
+template<typename T>
+struct SubsetSummary
+{
+    T total;    // 整段之和
+    T prefix;   // 最大前缀和
+    T suffix;   // 最大后缀和
+    T best;     // 最大相连子序列和
+};
+
+// betterOf: compare意义下较大的一个(compare为std::greater时求最小相连子序列和)
+template<typename T, typename CompareType>
+inline T betterOf(const T &a, const T &b, CompareType &compare)
+{
+    return compare(a, b) ? b : a;
+}
+
+// combineSummary: 合并左段left与右段right的摘要
+/*
+ * 整段的最大前缀要么是左段的最大前缀, 要么是左段加上右段的最大前缀; 后缀同理;
+ * 最大相连子序列要么完全在一段中, 要么由左段的最大后缀与右段的最大前缀拼成.
+ *
+ */
+template<typename T, typename CompareType>
+SubsetSummary<T> combineSummary(const SubsetSummary<T> &left, const SubsetSummary<T> &right, CompareType &compare)
+{
+    SubsetSummary<T> result;
+    result.total = left.total + right.total;
+    result.prefix = betterOf(left.prefix, left.total + right.prefix, compare);
+    result.suffix = betterOf(right.suffix, right.total + left.suffix, compare);
+    result.best = betterOf(betterOf(left.best, right.best, compare), left.suffix + right.prefix, compare);
+    return result;
+}
+
+// scalarSummary: Kadane算法一次扫描求出[begin, end)的摘要(序列非空)
+template<typename Iterator, typename CompareType>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+scalarSummary(Iterator begin, const Iterator end, CompareType &compare)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    SubsetSummary<T> s = {*begin, *begin, *begin, *begin};
+    for (++begin; begin != end; ++begin){
+        const T &x = *begin;
+        s.total += x;
+        s.prefix = betterOf(s.prefix, s.total, compare);
+        s.suffix = betterOf(s.suffix + x, x, compare);     // 以当前元素结尾的最大和
+        s.best = betterOf(s.best, s.suffix, compare);
+    }
+    return s;
+}
+
+// laneSummary: 把[begin, end)均分为kadane_lanes个子段, 在所有子段上同步地执行Kadane算法
+/*
+ * 单个Kadane扫描中每一步都依赖上一步的结果, 只能串行执行; 这里kadane_lanes条互不依赖的依赖链交错执行,
+ * 内层循环是对各子段同一位置的无分支更新(算术类型的?:编译为min/max或条件传送), 编译器可以把它向量化,
+ * 处理器也可以同时执行多条依赖链. 最后依次合并各子段和剩余部分的摘要.
+ *
+ */
+template<typename Iterator, typename CompareType>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+laneSummary(const Iterator begin, const Iterator end, CompareType &compare)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    const std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    const std::size_t block = size / kadane_lanes;
+    if (block < 2)
+        return scalarSummary(begin, end, compare);
+    T total[kadane_lanes], prefix[kadane_lanes], suffix[kadane_lanes], best[kadane_lanes];
+    for (std::size_t j = 0; j != kadane_lanes; ++j)
+        total[j] = prefix[j] = suffix[j] = best[j] = begin[j * block];
+    for (std::size_t i = 1; i != block; ++i){
+        for (std::size_t j = 0; j != kadane_lanes; ++j){
+            T x = begin[j * block + i];
+            total[j] += x;
+            prefix[j] = betterOf(prefix[j], total[j], compare);
+            suffix[j] = betterOf(suffix[j] + x, x, compare);
+            best[j] = betterOf(best[j], suffix[j], compare);
+        }
+    }
+    SubsetSummary<T> result = {total[0], prefix[0], suffix[0], best[0]};
+    for (std::size_t j = 1; j != kadane_lanes; ++j){
+        SubsetSummary<T> lane = {total[j], prefix[j], suffix[j], best[j]};
+        result = combineSummary(result, lane, compare);
+    }
+    if (block * kadane_lanes != size)
+        result = combineSummary(result, scalarSummary(begin + block * kadane_lanes, end, compare), compare);
+    return result;
+}
+
+// subsetSummary: [begin, end)的摘要, 算术类型与随机访问迭代器使用laneSummary
+template<typename Iterator, typename CompareType>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+subsetSummaryDispatch(const Iterator begin, const Iterator end, CompareType &compare, std::true_type)
+{
+    return laneSummary(begin, end, compare);
+}
+template<typename Iterator, typename CompareType>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+subsetSummaryDispatch(const Iterator begin, const Iterator end, CompareType &compare, std::false_type)
+{
+    return scalarSummary(begin, end, compare);
+}
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+subsetSummary(const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    typedef std::integral_constant<bool, std::is_arithmetic<T>::value && std::is_same<
+        typename std::iterator_traits<Iterator>::iterator_category, std::random_access_iterator_tag>::value> UseLanes;
+    assert(begin != end);
+    return subsetSummaryDispatch(begin, end, compare, UseLanes());
+}
+
+// subsetSummary: 按执行策略求[begin, end)的摘要
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为subset_parallel_threshold;
+ * \parameter begin: 待计算序列的起始迭代器(随机访问迭代器);
+ * \parameter end: 待计算序列的终止迭代器;
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \return 整段的摘要.
+ *
+ * 算法基本思想: 序列分为exec.threads()段, 每段在线程池中用subsetSummary归约为(总和, 最大前缀和, 最大后缀和,
+ * 最大相连子序列和), 然后按顺序用combineSummary合并. 串行策略或序列较短时直接调用subsetSummary.
+ *
+ * 算法性能: O(N/P + P), 额外空间O(P). 浮点数时求和的次序与串行算法不同, 结果可能有舍入误差.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+SubsetSummary<typename std::iterator_traits<Iterator>::value_type>
+subsetSummary(const ExecutionPolicy &exec, const Iterator begin, const Iterator end, CompareType compare = CompareType())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    assert(begin != end);
+    std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+    if (!exec.runParallel(size, subset_parallel_threshold))
+        return subsetSummary(begin, end, compare);
+    std::size_t chunk_size = (size + exec.threads() - 1) / exec.threads();
+    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    std::vector<SubsetSummary<T>> summaries(chunks);
+    parallelFor(exec, chunks, [&](std::size_t c){
+        std::size_t from = c * chunk_size, to = std::min(size, from + chunk_size);
+        summaries[c] = subsetSummary(begin + from, begin + to, compare);
+    });
+    SubsetSummary<T> result = summaries[0];
+    for (std::size_t c = 1; c != chunks; ++c)
+        result = combineSummary(result, summaries[c], compare);
+    return result;
+}
+
+// parallelSubsetSum: 多线程求最大相连子序列和(compare为std::greater时求最小相连子序列和)
+/*
+ * \parameter begin: 待计算序列的起始迭代器(随机访问迭代器);
+ * \parameter end: 待计算序列的终止迭代器;
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \parameter threads: 参与计算的线程个数(包括调用线程), 序列较短时不使用多线程;
+ * \return 最大相连子序列和(子序列非空, 全为负数时为最大的元素).
+ *
+ * 等价于subsetSummary(execution::par.withThreads(threads), begin, end, compare).best, 任务在共享的线程池中执行.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+typename std::iterator_traits<Iterator>::value_type
+parallelSubsetSum(const Iterator begin, const Iterator end, CompareType compare = CompareType(),
+                  std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    return subsetSummary(execution::par.withThreads(threads), begin, end, compare).best;
+}
+#endif
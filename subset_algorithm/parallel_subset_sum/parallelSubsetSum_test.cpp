@@ -0,0 +1,89 @@
+/*************************************************************************
+	> File Name: parallelSubsetSum_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 23时18分42秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <cmath>
+#include <functional>
+#include <list>
+#include <random>
+#include "parallelSubsetSum.h"
+#include "../online_subset_sum/onlineSubsetSum.h"
+
+// bruteForce: O(N^2)枚举所有非空子序列
+template<typename T, typename CompareType>
+T bruteForce(const vector<T> &data, CompareType compare)
+{
+    T best = data[0];
+    for (std::size_t i = 0; i != data.size(); ++i){
+        T sum = 0;
+        for (std::size_t j = i; j != data.size(); ++j){
+            sum += data[j];
+            if (compare(best, sum))
+                best = sum;
+        }
+    }
+    return best;
+}
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100, 100);
+    std::uniform_int_distribution<int> negative(-100, -1);
+    bool right = true;
+    // 各种长度, 覆盖子段长度不整除的情况
+    for (std::size_t size : {1, 2, 7, 8, 15, 16, 17, 100, 1001}){
+        vector<int> data(size), negatives(size);
+        for (std::size_t i = 0; i != size; ++i){
+            data[i] = u(e);
+            negatives[i] = negative(e);
+        }
+        std::list<int> list(data.begin(), data.end());
+        right = right && parallelSubsetSum(data.begin(), data.end()) == bruteForce(data, std::less<int>())
+                      && parallelSubsetSum(data.begin(), data.end(), std::greater<int>()) == bruteForce(data, std::greater<int>())
+                      && parallelSubsetSum(negatives.begin(), negatives.end()) == bruteForce(negatives, std::less<int>())
+                      && subsetSummary(list.begin(), list.end()).best == bruteForce(data, std::less<int>());
+    }
+    cout << "与O(N^2)的枚举比较(最大和, 最小和, 全为负数, 链表): " << (right ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    // 模拟每日盈亏序列
+    std::default_random_engine e(2018);
+    std::normal_distribution<double> pnl(0.01, 1.0);
+    vector<double> data(4000000);
+    for (auto &x : data)
+        x = pnl(e);
+    double serial = online(data.begin(), data.end());
+    double parallel = parallelSubsetSum(data.begin(), data.end(), std::less<double>(), 4);
+    double lanes = subsetSummary(data.begin(), data.end()).best;
+    cout << "最大盈利区间: " << parallel << endl;
+    bool right = std::fabs(serial - parallel) < 1e-6 * std::fabs(serial) && std::fabs(serial - lanes) < 1e-6 * std::fabs(serial);
+    cout << "4000000个元素, 4个线程与online的结果比较: " << (right ? "正确" : "错误") << endl;
+
+    vector<long long> integers(4000000);
+    std::uniform_int_distribution<long long> u(-1000, 999);
+    for (auto &x : integers)
+        x = u(e);
+    right = parallelSubsetSum(integers.begin(), integers.end(), std::less<long long>(), 4) == online(integers.begin(), integers.end())
+            && parallelSubsetSum(integers.begin(), integers.end(), std::greater<long long>(), 3)
+               == online(integers.begin(), integers.end(), std::greater<long long>());
+    cout << "整数序列的最大和与最小和(多线程): " << (right ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*****************分段摘要与合并*****************" << endl;
+    Test1();
+    cout << "*****************多线程最大子序列和*************" << endl;
+    Test2();
+    return 0;
+}
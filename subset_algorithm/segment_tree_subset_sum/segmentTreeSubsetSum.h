@@ -0,0 +1,153 @@
+/*************************************************************************
+	> File Name: segmentTreeSubsetSum.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时36分23秒
+ ************************************************************************/
+
+#ifndef _SEGMENTTREESUBSETSUM_H
+#define _SEGMENTTREESUBSETSUM_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../parallel_subset_sum/parallelSubsetSum.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+
+const std::size_t segment_tree_grain = std::size_t(1) << 14;    // 并行建树时每个任务至少处理的结点数
+
+// SubsetSumSegmentTree: 支持单点修改与区间查询的最大相连子序列和线段树
+/*
+ * 算法基本思想: 结点保存在一个长度为2N的数组中, 叶子tree[N + i]是第i个元素的摘要,
+ *      内部结点tree[i]是tree[2i]与tree[2i+1]按combineSummary合并的结果(见parallelSubsetSum.h);
+ *      --建树: 从下标N-1到1依次合并, 每个结点的孩子下标都比它大; 多线程时下标在[2^L, 2^(L+1))中的
+ *        同一层结点互不依赖, 逐层并行计算;
+ *      --查询[l, r): 从叶子开始自底向上, 左右两侧分别累积结果(合并不满足交换律, 左侧的结果只能在右边合并
+ *        新结点, 右侧的结果只能在左边合并新结点), 最后把两侧合并;
+ *      --修改: 修改叶子后重新计算它到根的路径; 批量修改时收集所有路径上的结点, 按下标从大到小只计算一次.
+ *
+ * 算法性能: 建树为O(N), 查询与单点修改为O(logN), 修改k个元素为O(klogN); 空间为2N个摘要.
+ * N不需要是2的幂.
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+class SubsetSumSegmentTree
+{
+public:
+    typedef SubsetSummary<T> Summary;
+    //****************************构造函数*******************************
+    // [begin, end): 初始序列(随机访问迭代器, 不能为空); threads: 建树的线程个数(包括调用线程)
+    template<typename Iterator>
+    SubsetSumSegmentTree(const Iterator begin, const Iterator end, CompareType c = CompareType(), std::size_t threads = 1)
+        : n(static_cast<std::size_t>(std::distance(begin, end))), tree(2 * n), compare(c)
+    {
+        assert(n > 0);
+        if (threads <= 1 || n < 2 * segment_tree_grain){
+            for (std::size_t i = 0; i != n; ++i)
+                tree[n + i] = leaf(begin[i]);
+            for (std::size_t i = n - 1; i >= 1; --i)
+                pull(i);
+            return;
+        }
+        // 在共享的线程池中建树
+        const ExecutionPolicy exec = execution::par.withThreads(threads);
+        parallelRange(exec, n, 2 * n, [&](std::size_t i){ tree[i] = leaf(begin[i - n]); });
+        // 从最深的一层开始, 每一层结点的孩子都在更深的层或者是叶子
+        std::size_t level = 1;
+        while ((level << 1) < n)
+            level <<= 1;
+        for (; level != 0; level >>= 1)
+            parallelRange(exec, level, std::min(n, level << 1), [this](std::size_t i){ pull(i); });
+    }
+    //****************************成员函数*******************************
+    std::size_t size() const { return n; }
+    // get: 第i个元素的值
+    T get(std::size_t i) const { assert(i < n); return tree[n + i].total; }
+
+    // summary: [l, r)的摘要(l < r)
+    Summary summary(std::size_t l, std::size_t r) const
+    {
+        assert(l < r && r <= n);
+        Summary left, right;
+        bool has_left = false, has_right = false;
+        for (l += n, r += n; l < r; l >>= 1, r >>= 1){
+            if (l & 1){
+                left = has_left ? combineSummary(left, tree[l], compare) : tree[l];
+                has_left = true;
+                ++l;
+            }
+            if (r & 1){
+                --r;
+                right = has_right ? combineSummary(tree[r], right, compare) : tree[r];
+                has_right = true;
+            }
+        }
+        if (!has_left)
+            return right;
+        if (!has_right)
+            return left;
+        return combineSummary(left, right, compare);
+    }
+
+    // query: [l, r)中的最大相连子序列和
+    T query(std::size_t l, std::size_t r) const { return summary(l, r).best; }
+
+    // update: 把第i个元素修改为value
+    void update(std::size_t i, const T &value)
+    {
+        assert(i < n);
+        std::size_t node = n + i;
+        tree[node] = leaf(value);
+        for (node >>= 1; node >= 1; node >>= 1)
+            pull(node);
+    }
+
+    // update: 批量修改, [begin, end)中的每一项为(下标, 新值); 同一下标出现多次时以最后一次为准
+    template<typename Iterator>
+    void update(Iterator begin, const Iterator end)
+    {
+        dirty.clear();
+        for (; begin != end; ++begin){
+            assert(begin->first < n);
+            std::size_t node = n + begin->first;
+            tree[node] = leaf(begin->second);
+            for (node >>= 1; node >= 1; node >>= 1)
+                dirty.push_back(node);
+        }
+        // 孩子的下标总比父结点大, 按下标从大到小计算保证孩子先于父结点更新
+        std::sort(dirty.begin(), dirty.end(), std::greater<std::size_t>());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        for (auto node : dirty)
+            pull(node);
+    }
+private:
+    //****************************数据结构*******************************
+    std::size_t n;                      // 元素个数
+    std::vector<Summary> tree;          // tree[1, ..., 2N-1], tree[0]不使用
+    std::vector<std::size_t> dirty;     // 批量修改时需要重新计算的结点
+    CompareType compare;
+
+    static Summary leaf(const T &x) { return Summary{x, x, x, x}; }
+
+    void pull(std::size_t i) { tree[i] = combineSummary(tree[2 * i], tree[2 * i + 1], compare); }
+
+    // parallelRange: 按执行策略对[first, last)中的每个下标调用f, 每个任务segment_tree_grain个下标
+    template<typename Function>
+    void parallelRange(const ExecutionPolicy &exec, std::size_t first, std::size_t last, Function f)
+    {
+        if (last - first < 2 * segment_tree_grain){
+            for (std::size_t i = first; i != last; ++i)
+                f(i);
+            return;
+        }
+        parallelFor(exec, (last - first + segment_tree_grain - 1) / segment_tree_grain, [&](std::size_t c){
+            for (std::size_t i = first + c * segment_tree_grain, to = std::min(last, i + segment_tree_grain); i != to; ++i)
+                f(i);
+        });
+    }
+};
+#endif
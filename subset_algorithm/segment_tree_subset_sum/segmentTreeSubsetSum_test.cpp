@@ -0,0 +1,91 @@
+/*************************************************************************
+	> File Name: segmentTreeSubsetSum_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 08时39分06秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <functional>
+#include <random>
+#include <utility>
+#include "segmentTreeSubsetSum.h"
+#include "../online_subset_sum/onlineSubsetSum.h"
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100, 100);
+    bool right = true;
+    // N不是2的幂
+    for (std::size_t size : {1, 2, 3, 5, 8, 13, 100, 1000}){
+        vector<int> data(size);
+        for (auto &x : data)
+            x = u(e);
+        SubsetSumSegmentTree<int> tree(data.begin(), data.end());
+        SubsetSumSegmentTree<int, std::greater<int>> minimum(data.begin(), data.end());
+        std::uniform_int_distribution<std::size_t> position(0, size - 1);
+        for (int round = 0; round != 300; ++round){
+            std::size_t i = position(e);
+            data[i] = u(e);
+            tree.update(i, data[i]);
+            minimum.update(i, data[i]);
+            std::size_t l = position(e), r = position(e);
+            if (l > r)
+                std::swap(l, r);
+            ++r;
+            right = right && tree.query(l, r) == online(data.begin() + l, data.begin() + r)
+                          && minimum.query(l, r) == online(data.begin() + l, data.begin() + r, std::greater<int>())
+                          && tree.get(i) == data[i];
+        }
+    }
+    cout << "随机单点修改后的区间查询(最大和与最小和)与online比较: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<long long> u(-1000, 1000);
+    vector<long long> data(1000003);
+    for (auto &x : data)
+        x = u(e);
+    SubsetSumSegmentTree<long long> serial(data.begin(), data.end());
+    SubsetSumSegmentTree<long long> parallel(data.begin(), data.end(), std::less<long long>(), 4);
+    bool right = serial.query(0, data.size()) == online(data.begin(), data.end())
+                 && parallel.query(0, data.size()) == serial.query(0, data.size());
+    // 批量修改, 包含重复的下标
+    std::uniform_int_distribution<std::size_t> position(0, data.size() - 1);
+    vector<std::pair<std::size_t, long long>> updates;
+    for (int k = 0; k != 5000; ++k){
+        std::size_t i = position(e);
+        updates.emplace_back(i, u(e));
+        if (k % 100 == 0)
+            updates.emplace_back(i, u(e));
+    }
+    for (const auto &update : updates){
+        data[update.first] = update.second;
+        serial.update(update.first, update.second);
+    }
+    parallel.update(updates.begin(), updates.end());
+    for (int round = 0; round != 200 && right; ++round){
+        std::size_t l = position(e), r = position(e);
+        if (l > r)
+            std::swap(l, r);
+        ++r;
+        long long expected = online(data.begin() + l, data.begin() + r);
+        right = serial.query(l, r) == expected && parallel.query(l, r) == expected;
+    }
+    cout << "1000003个元素的并行建树与批量修改: " << (right ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*****************单点修改与区间查询*************" << endl;
+    Test1();
+    cout << "*****************并行建树与批量修改*************" << endl;
+    Test2();
+    return 0;
+}
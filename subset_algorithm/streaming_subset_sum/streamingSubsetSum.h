@@ -0,0 +1,243 @@
+/*************************************************************************
+	> File Name: streamingSubsetSum.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 23时41分07秒
+ ************************************************************************/
+
+#ifndef _STREAMINGSUBSETSUM_H
+#define _STREAMINGSUBSETSUM_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// StreamingMaxSubarray: 数据流上的最大相连子序列和(可以限定为最近window个元素)
+/*
+ * 与online相比, 它保存扫描的状态, 可以不断地加入新元素, 并给出最优子序列的起止位置.
+ * 位置是元素在整个数据流中的编号(从0开始), 子序列为[begin, end), 所有子序列都非空.
+ *
+ * 算法基本思想:
+ *      --bestEnding: 以最新元素结尾, 长度不超过window的最大和等于P[t+1] - min{P[i] : t+1-window <= i <= t},
+ *        P为前缀和. 候选起点保存在前缀和单调递增的双端队列中, 新起点从尾部压入并弹出所有不优于它的起点,
+ *        过期的起点从头部弹出, 队首就是最优起点;
+ *      --best: 最近window个元素中的最大相连子序列和. 每个元素的摘要(总和,最大前缀,最大后缀,最大和, 带位置)
+ *        可以按结合律合并(见parallelSubsetSum.h的combineSummary), 窗口用两个栈实现的队列保存摘要,
+ *        前栈的每一项是从它到前栈底部所有元素的合并结果, 后栈只保存整体的合并结果;
+ *        前栈为空时把后栈的元素逆序合并搬入前栈; 查询时合并两个栈的结果;
+ *      --window为0时不限定长度, 只需保存所有元素的合并结果, 空间为O(1).
+ *
+ * 算法性能: push均摊为O(1), best与bestEnding为O(1); 空间为O(window).
+ *          批量加入的元素不少于window个时, 只有最后window个元素会留在窗口中, 前面的元素直接跳过,
+ *          然后一次逆序扫描重建窗口, 时间为O(window), 与批量的长度无关.
+ * 前缀和每加入window个元素就以当前值为基准重新计算一次, 浮点数的前缀和不会随数据流的长度无限增大.
+ *
+ */
+template<typename T, typename CompareType = std::less<T>>
+class StreamingMaxSubarray
+{
+public:
+    struct Segment
+    {
+        T sum;                  // 子序列和
+        std::uint64_t begin;    // 子序列[begin, end)在数据流中的位置
+        std::uint64_t end;
+    };
+
+    //****************************构造函数*******************************
+    // window: 只考虑最近window个元素(为0时考虑所有元素); compare为std::greater时求最小相连子序列和
+    explicit StreamingMaxSubarray(std::size_t window = 0, CompareType c = CompareType())
+        : window_size(window), ticks(0), prefix(), since_rebase(0), compare(c) {  }
+    //****************************成员函数*******************************
+    bool empty() const { return ticks == 0; }
+    // count: 加入的元素总数
+    std::uint64_t count() const { return ticks; }
+    // size: 当前窗口中的元素个数
+    std::size_t size() const
+    {
+        if (window_size == 0)
+            return static_cast<std::size_t>(ticks);
+        return front.size() + back.size();
+    }
+    std::size_t window() const { return window_size; }
+
+    // push: 加入一个元素
+    void push(const T &x)
+    {
+        std::uint64_t index = ticks++;
+        if (window_size == 0){
+            back_summary = (index == 0) ? leaf(x, index) : combine(back_summary, leaf(x, index));
+            return;
+        }
+        pushStart(index);
+        if (starts.front().first + window_size <= index)
+            starts.pop_front();
+        prefix += x;
+        ending = Segment{prefix - starts.front().second, starts.front().first, index + 1};
+        if (++since_rebase == window_size)
+            rebase();
+        if (front.size() + back.size() == window_size)
+            evict();
+        back.emplace_back(index, x);
+        back_summary = (back.size() == 1) ? leaf(x, index) : combine(back_summary, leaf(x, index));
+    }
+
+    // push: 批量加入[begin, end)中的元素
+    template<typename Iterator>
+    void push(Iterator begin, const Iterator end)
+    {
+        pushRange(begin, end, typename std::iterator_traits<Iterator>::iterator_category());
+    }
+
+    // best: 窗口中的最大相连子序列和及其位置
+    Segment best() const
+    {
+        assert(!empty());
+        if (window_size == 0 || front.empty())
+            return back_summary.best;
+        if (back.empty())
+            return front.back().best;
+        return combine(front.back(), back_summary).best;
+    }
+
+    // bestEnding: 以最新元素结尾, 且在窗口中的最大相连子序列和及其位置
+    Segment bestEnding() const
+    {
+        assert(!empty());
+        if (window_size == 0)
+            return back_summary.suffix;
+        return ending;
+    }
+
+    void clear()
+    {
+        ticks = 0;
+        resetWindow();
+    }
+private:
+    // Summary: 一段元素的摘要, 与SubsetSummary相同, 但是记录了位置
+    struct Summary
+    {
+        T total;
+        Segment prefix;
+        Segment suffix;
+        Segment best;
+    };
+
+    //****************************数据结构*******************************
+    std::size_t window_size;
+    std::uint64_t ticks;                                    // 加入的元素总数, 也是下一个元素的位置
+    std::vector<Summary> front;                             // 前栈, front.back()是窗口中最早的元素到前栈底部的合并结果
+    std::vector<std::pair<std::uint64_t, T>> back;          // 后栈中的元素(位置, 值)
+    Summary back_summary;                                   // 后栈中所有元素的合并结果(不限定窗口时为所有元素)
+    std::deque<std::pair<std::uint64_t, T>> starts;         // 候选起点(位置, 起点之前的前缀和), 前缀和单调
+    T prefix;                                               // 当前的前缀和(相对于最近一次重新计算的基准)
+    std::size_t since_rebase;
+    Segment ending;                                         // 以最新元素结尾的最优子序列
+    CompareType compare;
+
+    static Summary leaf(const T &x, std::uint64_t index)
+    {
+        Segment s = {x, index, index + 1};
+        return Summary{x, s, s, s};
+    }
+
+    const Segment& better(const Segment &a, const Segment &b) const
+    {
+        return compare(a.sum, b.sum) ? b : a;
+    }
+
+    // combine: 合并相邻的两段, left在前; 和相等时保留较早得到的子序列
+    Summary combine(const Summary &left, const Summary &right) const
+    {
+        Summary result;
+        result.total = left.total + right.total;
+        result.prefix = better(left.prefix, Segment{left.total + right.prefix.sum, left.prefix.begin, right.prefix.end});
+        result.suffix = better(right.suffix, Segment{right.total + left.suffix.sum, left.suffix.begin, right.suffix.end});
+        result.best = better(better(left.best, right.best),
+                             Segment{left.suffix.sum + right.prefix.sum, left.suffix.begin, right.prefix.end});
+        return result;
+    }
+
+    // pushStart: 把位置index作为候选起点压入单调队列, 起点之前的前缀和为prefix
+    void pushStart(std::uint64_t index)
+    {
+        // compare为std::less时, 前缀和越小的起点越好, 队列中的前缀和严格递增
+        while (!starts.empty() && !compare(starts.back().second, prefix))
+            starts.pop_back();
+        starts.emplace_back(index, prefix);
+    }
+
+    // rebase: 以当前的前缀和为基准重新计算, 队列中最多window个起点, 每window次push调用一次
+    void rebase()
+    {
+        const T base = prefix;
+        for (auto &start : starts)
+            start.second -= base;
+        prefix -= base;
+        since_rebase = 0;
+    }
+
+    // evict: 移出窗口中最早的元素
+    void evict()
+    {
+        if (front.empty()){
+            // 后栈的元素从新到旧依次合并到前栈
+            for (auto current = back.rbegin(); current != back.rend(); ++current){
+                Summary s = leaf(current->second, current->first);
+                front.push_back(front.empty() ? s : combine(s, front.back()));
+            }
+            back.clear();
+        }
+        front.pop_back();
+    }
+
+    void resetWindow()
+    {
+        front.clear();
+        back.clear();
+        starts.clear();
+        prefix = T();
+        since_rebase = 0;
+    }
+
+    template<typename Iterator>
+    void pushRange(Iterator begin, const Iterator end, std::input_iterator_tag)
+    {
+        for (; begin != end; ++begin)
+            push(*begin);
+    }
+
+    // pushRange: 随机访问迭代器, 批量的长度不小于window时只用最后window个元素重建窗口
+    template<typename Iterator>
+    void pushRange(Iterator begin, const Iterator end, std::random_access_iterator_tag)
+    {
+        std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+        if (window_size == 0 || n < window_size){
+            pushRange(begin, end, std::input_iterator_tag());
+            return;
+        }
+        resetWindow();
+        Iterator tail = end - window_size;
+        const std::uint64_t first = ticks + (n - window_size);     // tail在数据流中的位置
+        ticks += n;
+        // 窗口中的元素就是[tail, end), 它们都是合法的起点, 前缀和以tail为基准
+        for (std::size_t k = 0; k != window_size; ++k){
+            pushStart(first + k);
+            prefix += tail[k];
+        }
+        ending = Segment{prefix - starts.front().second, starts.front().first, ticks};
+        // 逆序扫描, 所有元素都放入前栈
+        front.reserve(window_size);
+        for (std::size_t k = window_size; k-- != 0; ){
+            Summary s = leaf(tail[k], first + k);
+            front.push_back(front.empty() ? s : combine(s, front.back()));
+        }
+    }
+};
+#endif
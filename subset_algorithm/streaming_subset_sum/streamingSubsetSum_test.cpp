@@ -0,0 +1,144 @@
+/*************************************************************************
+	> File Name: streamingSubsetSum_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 23时58分36秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include "streamingSubsetSum.h"
+#include "../online_subset_sum/onlineSubsetSum.h"
+
+// bruteForceWindow: 枚举[first, last)中的所有子序列, 返回最大和; ending为以last-1结尾的最大和
+template<typename T, typename CompareType>
+T bruteForceWindow(const vector<T> &data, std::size_t first, std::size_t last, T &ending, CompareType compare)
+{
+    T best = data[first];
+    ending = data[last - 1];
+    for (std::size_t i = first; i != last; ++i){
+        T sum = 0;
+        for (std::size_t j = i; j != last; ++j){
+            sum += data[j];
+            if (compare(best, sum))
+                best = sum;
+        }
+        if (compare(ending, sum))
+            ending = sum;
+    }
+    return best;
+}
+
+// validSegment: 子序列在窗口[first, last)中, 并且和与报告的一致
+template<typename T, typename Segment>
+bool validSegment(const vector<T> &data, const Segment &s, std::size_t first, std::size_t last)
+{
+    if (s.begin < first || s.end > last || s.begin >= s.end)
+        return false;
+    T sum = 0;
+    for (std::uint64_t i = s.begin; i != s.end; ++i)
+        sum += data[i];
+    return sum == s.sum;
+}
+
+void Test1()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100, 90);
+    vector<int> data(3000);
+    for (auto &x : data)
+        x = u(e);
+    bool right = true;
+    for (std::size_t window : {1, 2, 7, 50}){
+        StreamingMaxSubarray<int> stream(window);
+        StreamingMaxSubarray<int, std::greater<int>> minimum(window);
+        for (std::size_t t = 0; t != data.size(); ++t){
+            stream.push(data[t]);
+            minimum.push(data[t]);
+            std::size_t first = t + 1 >= window ? t + 1 - window : 0;
+            int ending, min_ending;
+            int best = bruteForceWindow(data, first, t + 1, ending, std::less<int>());
+            int min_best = bruteForceWindow(data, first, t + 1, min_ending, std::greater<int>());
+            right = right && stream.best().sum == best && stream.bestEnding().sum == ending
+                          && minimum.best().sum == min_best && minimum.bestEnding().sum == min_ending
+                          && validSegment(data, stream.best(), first, t + 1)
+                          && validSegment(data, stream.bestEnding(), first, t + 1) && stream.bestEnding().end == t + 1
+                          && validSegment(data, minimum.best(), first, t + 1);
+        }
+        right = right && stream.size() == window && stream.count() == data.size();
+    }
+    cout << "滑动窗口(长度1, 2, 7, 50)每次加入后与枚举比较: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100, 100);
+    vector<int> data(100000);
+    for (auto &x : data)
+        x = u(e);
+    // 不限定窗口: 与online的结果一致, 可以分多次加入
+    StreamingMaxSubarray<int> stream;
+    stream.push(data.begin(), data.begin() + 40000);
+    stream.push(data.begin() + 40000, data.end());
+    bool right = stream.best().sum == online(data.begin(), data.end()) && validSegment(data, stream.best(), 0, data.size());
+
+    // 批量加入(长度超过窗口时重建窗口)与逐个加入的结果一致
+    const std::size_t window = 1000;
+    StreamingMaxSubarray<int> batched(window), single(window);
+    std::size_t position = 0;
+    for (std::size_t burst : {10, 5000, 999, 1000, 1, 20000, 3}){
+        batched.push(data.begin() + position, data.begin() + position + burst);
+        for (std::size_t k = 0; k != burst; ++k)
+            single.push(data[position + k]);
+        position += burst;
+        std::size_t first = position >= window ? position - window : 0;
+        right = right && batched.best().sum == single.best().sum && batched.bestEnding().sum == single.bestEnding().sum
+                      && validSegment(data, batched.best(), first, position)
+                      && validSegment(data, batched.bestEnding(), first, position) && batched.count() == position;
+        // 批量加入之后继续逐个加入
+        batched.push(data[position]);
+        single.push(data[position]);
+        ++position;
+        right = right && batched.best().sum == single.best().sum && batched.bestEnding().sum == single.bestEnding().sum;
+    }
+    cout << "不限定窗口与online比较, 批量加入与逐个加入比较: " << (right ? "正确" : "错误") << endl;
+}
+
+void Test3()
+{
+    // 长数据流上的浮点数: 前缀和定期重新计算基准
+    std::default_random_engine e(2018);
+    std::normal_distribution<double> pnl(1000.0, 1.0);      // 前缀和增长很快
+    StreamingMaxSubarray<double, std::greater<double>> stream(64);     // 最近64个元素中的最小和
+    vector<double> recent;
+    bool right = true;
+    for (std::size_t t = 0; t != 2000000; ++t){
+        double x = pnl(e);
+        stream.push(x);
+        recent.push_back(x);
+        if (recent.size() > 64)
+            recent.erase(recent.begin());
+    }
+    double ending;
+    double best = bruteForceWindow(recent, 0, recent.size(), ending, std::greater<double>());
+    right = std::fabs(stream.best().sum - best) < 1e-6 && std::fabs(stream.bestEnding().sum - ending) < 1e-6;
+    cout << "2000000个浮点数的数据流, 窗口中的最小和: " << stream.best().sum << " " << (right ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    cout << "*****************滑动窗口最大子序列和*************" << endl;
+    Test1();
+    cout << "*****************批量加入与不限定窗口*************" << endl;
+    Test2();
+    cout << "*****************前缀和重新计算基准***************" << endl;
+    Test3();
+    return 0;
+}
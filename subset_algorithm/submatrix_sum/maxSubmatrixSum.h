@@ -0,0 +1,192 @@
+/*************************************************************************
+	> File Name: maxSubmatrixSum.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时04分36秒
+ ************************************************************************/
+
+#ifndef _MAXSUBMATRIXSUM_H
+#define _MAXSUBMATRIXSUM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include "../parallel_subset_sum/parallelSubsetSum.h"
+// maxSubmatrixSum: 二维矩阵中和最大的子矩阵(非空的相连矩形)
+/*
+ * 算法基本思想: 枚举上边界top与下边界bottom, 把[top, bottom)中的各行按列求和压缩为一行(列的部分和),
+ * 子矩阵之和就是压缩以后的行中相连子序列的和, 用online()的核心subsetSummary(多条Kadane依赖链交错执行,
+ * 见parallelSubsetSum.h)求出它的最大值. 下边界每增加一行, 压缩的行只需要加上新的一行, 所以每对边界是O(C).
+ *      --只有压缩的行的最大和超过当前的最优值时才用一次标量的Kadane扫描求出左右边界, 大部分行对只走向量化的核心;
+ *      --分块: 连续的若干个上边界为一个任务, 任务中的各个压缩行同时推进, 读入的每一行矩阵对所有的压缩行使用,
+ *        压缩行的总大小不超过submatrix_tile_bytes(在二级缓存中), 矩阵的读取量减少为1/块的大小;
+ *      --并行: O(R^2)个行对按上边界的块分给线程池(上边界小的块工作量大, 先提交), 各任务的结果按
+ *        (和, 上边界, 下边界)的次序归约, 因此结果与串行算法相同;
+ *      --行数大于列数时先转置(O(RC)的额外空间), 使枚举的一维是较短的一维.
+ * 矩阵按行存放: begin[r * cols + c]是第r行第c列. compare与online相同, 为std::greater时求和最小的子矩阵.
+ * 结果的行为[top, bottom), 列为[left, right); 和相同的子矩阵中取枚举的一维(没有转置时为行)的边界最小的一个.
+ *
+ * 算法性能: O(min(R, C)^2 * max(R, C) / P), 额外空间O(C * 块的大小 * P).
+ *
+ */
+const std::size_t submatrix_tile_bytes = std::size_t(1) << 18;              // 每个任务的压缩行的总大小
+const std::size_t submatrix_max_block = 64;                                 // 每个任务最多的上边界个数
+const std::size_t submatrix_parallel_threshold = std::size_t(1) << 22;      // 不小于该工作量(行对数 * 列数)才使用多线程
+
+// SubmatrixSum: 最优子矩阵的位置与和
+template<typename T>
+struct SubmatrixSum
+{
+    T sum;
+    std::size_t top;        // 行[top, bottom)
+    std::size_t bottom;
+    std::size_t left;       // 列[left, right)
+    std::size_t right;
+};
+
+// submatrixBetter: 按(和, top, bottom)的次序a是否优于b
+template<typename T, typename CompareType>
+inline bool submatrixBetter(const SubmatrixSum<T> &a, const SubmatrixSum<T> &b, CompareType &compare)
+{
+    if (compare(b.sum, a.sum))
+        return true;
+    if (compare(a.sum, b.sum))
+        return false;
+    return a.top != b.top ? a.top < b.top : a.bottom < b.bottom;
+}
+
+// kadaneRange: 标量的Kadane扫描, 求出row[0, cols)中最优的相连子序列[left, right)与它的和
+template<typename T, typename CompareType>
+void kadaneRange(const T *row, std::size_t cols, CompareType &compare, SubmatrixSum<T> &result)
+{
+    T best = row[0], suffix = row[0];
+    std::size_t start = 0;
+    result.left = 0;
+    result.right = 1;
+    for (std::size_t c = 1; c != cols; ++c){
+        // 以前一列结尾的和不如重新开始时, 从第c列开始
+        if (compare(suffix + row[c], row[c])){
+            suffix = row[c];
+            start = c;
+        }else{
+            suffix += row[c];
+        }
+        if (compare(best, suffix)){
+            best = suffix;
+            result.left = start;
+            result.right = c + 1;
+        }
+    }
+    result.sum = best;
+}
+
+// submatrixBlock: 上边界为[topBegin, topEnd)的所有行对, matrix为rows * cols的按行存放的矩阵
+/*
+ * compressed[k]是上边界为topBegin + k的压缩行, 下边界推进到bottom时, 上边界不超过bottom的压缩行加上第bottom行.
+ * 返回false表示还没有找到任何子矩阵(调用者的block为空时不会发生).
+ *
+ */
+template<typename T, typename CompareType>
+bool submatrixBlock(const T *matrix, std::size_t rows, std::size_t cols, std::size_t topBegin, std::size_t topEnd,
+                    CompareType compare, std::vector<T> &compressed, SubmatrixSum<T> &best)
+{
+    const std::size_t block = topEnd - topBegin;
+    compressed.assign(block * cols, T());
+    bool found = false;
+    SubmatrixSum<T> candidate;
+    for (std::size_t bottom = topBegin; bottom != rows; ++bottom){
+        const T *row = matrix + bottom * cols;
+        std::size_t active = std::min(block, bottom - topBegin + 1);
+        for (std::size_t k = 0; k != active; ++k){
+            T *line = compressed.data() + k * cols;
+            for (std::size_t c = 0; c != cols; ++c)
+                line[c] += row[c];
+            T value = subsetSummary(line, line + cols, compare).best;
+            // 不优于当前的最优值(和相同时(top, bottom)也不更小)时不需要求边界
+            if (found && (compare(value, best.sum) || (!compare(best.sum, value)
+                          && (topBegin + k != best.top ? topBegin + k > best.top : bottom + 1 > best.bottom))))
+                continue;
+            kadaneRange(line, cols, compare, candidate);
+            candidate.top = topBegin + k;
+            candidate.bottom = bottom + 1;
+            if (!found || submatrixBetter(candidate, best, compare)){
+                best = candidate;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+// submatrixBlockSize: 一个任务中的上边界个数
+inline std::size_t submatrixBlockSize(std::size_t rows, std::size_t rowBytes, std::size_t tasks)
+{
+    std::size_t block = std::max<std::size_t>(1, submatrix_tile_bytes / std::max<std::size_t>(1, rowBytes));
+    block = std::min(block, submatrix_max_block);
+    // 至少有tasks个任务, 使线程之间可以平衡负载
+    return std::max<std::size_t>(1, std::min(block, rows / std::max<std::size_t>(1, tasks)));
+}
+
+// maxSubmatrixSum: 按执行策略求rows * cols的矩阵(按行存放)中和最大的子矩阵
+/*
+ * \parameter exec: 执行策略(见executionPolicy.h), 默认的并行阈值为submatrix_parallel_threshold(行对数 * 列数);
+ * \parameter begin: 矩阵第一个元素的随机访问迭代器(或指针), 元素为算术类型;
+ * \parameter rows, cols: 行数与列数, 都必须大于0;
+ * \parameter compare: 一个可调用的对象,可用于比较两个对象的小于,默认为std::less<T>;
+ * \return 最优子矩阵的位置与和.
+ *
+ */
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+SubmatrixSum<typename std::iterator_traits<Iterator>::value_type>
+maxSubmatrixSum(const ExecutionPolicy &exec, Iterator begin, std::size_t rows, std::size_t cols,
+                CompareType compare = CompareType())
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    if (rows == 0 || cols == 0)
+        throw std::invalid_argument("maxSubmatrixSum error: the matrix is empty!");
+    // 复制为连续的数组, 行数大于列数时转置
+    const bool transposed = rows > cols;
+    const std::size_t r = transposed ? cols : rows, c = transposed ? rows : cols;
+    std::vector<T> matrix(r * c);
+    for (std::size_t i = 0; i != rows; ++i)
+        for (std::size_t j = 0; j != cols; ++j)
+            matrix[transposed ? j * c + i : i * c + j] = begin[i * cols + j];
+
+    const bool parallel = exec.runParallel(r * (r + 1) / 2 * c, submatrix_parallel_threshold);
+    const std::size_t threads = parallel ? exec.threads() : 1;
+    const std::size_t block = submatrixBlockSize(r, c * sizeof(T), parallel ? threads * 4 : 1);
+    const std::size_t blocks = (r + block - 1) / block;
+    std::vector<SubmatrixSum<T>> results(blocks);
+    std::vector<char> found(blocks, 0);
+    auto run = [&](std::size_t b){
+        std::vector<T> compressed;
+        found[b] = submatrixBlock(matrix.data(), r, c, b * block, std::min(r, (b + 1) * block), compare, compressed, results[b]);
+    };
+    if (parallel){
+        parallelFor(exec, blocks, run);
+    }else{
+        for (std::size_t b = 0; b != blocks; ++b)
+            run(b);
+    }
+    SubmatrixSum<T> best = results[0];
+    for (std::size_t b = 1; b != blocks; ++b)
+        if (found[b] && submatrixBetter(results[b], best, compare))
+            best = results[b];
+    if (transposed){
+        std::swap(best.top, best.left);
+        std::swap(best.bottom, best.right);
+    }
+    return best;
+}
+
+// maxSubmatrixSum: 单线程求和最大的子矩阵
+template<typename Iterator, typename CompareType = std::less<typename std::iterator_traits<Iterator>::value_type>>
+SubmatrixSum<typename std::iterator_traits<Iterator>::value_type>
+maxSubmatrixSum(Iterator begin, std::size_t rows, std::size_t cols, CompareType compare = CompareType())
+{
+    return maxSubmatrixSum(execution::seq, begin, rows, cols, compare);
+}
+#endif
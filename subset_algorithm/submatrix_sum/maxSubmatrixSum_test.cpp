@@ -0,0 +1,140 @@
+/*************************************************************************
+	> File Name: maxSubmatrixSum_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时26分53秒
+ ************************************************************************/
+
+#include <iostream>
+using std::cout;    using std::endl;
+#include <vector>
+using std::vector;
+#include <chrono>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include "maxSubmatrixSum.h"
+
+// rectangleSum: 直接求子矩阵的和
+template<typename T>
+T rectangleSum(const vector<T> &m, std::size_t cols, const SubmatrixSum<T> &s)
+{
+    T sum = 0;
+    for (std::size_t i = s.top; i != s.bottom; ++i)
+        for (std::size_t j = s.left; j != s.right; ++j)
+            sum += m[i * cols + j];
+    return sum;
+}
+
+// bruteForce: 用二维前缀和枚举所有O(R^2 C^2)个子矩阵
+template<typename T, typename CompareType>
+T bruteForce(const vector<T> &m, std::size_t rows, std::size_t cols, CompareType compare)
+{
+    vector<T> prefix((rows + 1) * (cols + 1), 0);
+    for (std::size_t i = 0; i != rows; ++i)
+        for (std::size_t j = 0; j != cols; ++j)
+            prefix[(i + 1) * (cols + 1) + j + 1] = m[i * cols + j] + prefix[i * (cols + 1) + j + 1]
+                                                   + prefix[(i + 1) * (cols + 1) + j] - prefix[i * (cols + 1) + j];
+    T best = m[0];
+    for (std::size_t t = 0; t != rows; ++t)
+        for (std::size_t b = t + 1; b <= rows; ++b)
+            for (std::size_t l = 0; l != cols; ++l)
+                for (std::size_t r = l + 1; r <= cols; ++r){
+                    T sum = prefix[b * (cols + 1) + r] - prefix[t * (cols + 1) + r]
+                            - prefix[b * (cols + 1) + l] + prefix[t * (cols + 1) + l];
+                    if (compare(best, sum))
+                        best = sum;
+                }
+    return best;
+}
+
+bool sameResult(const SubmatrixSum<int> &a, const SubmatrixSum<int> &b)
+{
+    return a.sum == b.sum && a.top == b.top && a.bottom == b.bottom && a.left == b.left && a.right == b.right;
+}
+
+void Test1()
+{
+    // 算法导论习题中常见的例子: 最优子矩阵为第1到3行, 第0到1列, 和为15
+    vector<int> m = { 0, -2, -7,  0,
+                      9,  2, -6,  2,
+                     -4,  1, -4,  1,
+                     -1,  8,  0, -2};
+    SubmatrixSum<int> s = maxSubmatrixSum(m.begin(), 4, 4);
+    cout << "4 * 4的例子: " << (s.sum == 15 && s.top == 1 && s.bottom == 4 && s.left == 0 && s.right == 2 ? "正确" : "错误") << endl;
+
+    std::default_random_engine e(2018);
+    std::uniform_int_distribution<int> u(-100, 100);
+    std::uniform_int_distribution<int> negative(-100, -1);
+    std::uniform_int_distribution<std::size_t> size(1, 12);
+    bool right = true, minimum = true, allNegative = true;
+    for (int round = 0; round != 300; ++round){
+        std::size_t rows = size(e), cols = size(e);
+        vector<int> a(rows * cols), neg(rows * cols);
+        for (std::size_t i = 0; i != a.size(); ++i){
+            a[i] = u(e);
+            neg[i] = negative(e);
+        }
+        SubmatrixSum<int> s = maxSubmatrixSum(a.begin(), rows, cols);
+        right = right && s.sum == bruteForce(a, rows, cols, std::less<int>()) && rectangleSum(a, cols, s) == s.sum
+                && s.top < s.bottom && s.bottom <= rows && s.left < s.right && s.right <= cols;
+        SubmatrixSum<int> least = maxSubmatrixSum(a.data(), rows, cols, std::greater<int>());
+        minimum = minimum && least.sum == bruteForce(a, rows, cols, std::greater<int>()) && rectangleSum(a, cols, least) == least.sum;
+        SubmatrixSum<int> n = maxSubmatrixSum(neg.begin(), rows, cols);
+        allNegative = allNegative && n.sum == *std::max_element(neg.begin(), neg.end())
+                      && n.bottom - n.top == 1 && n.right - n.left == 1;
+    }
+    cout << "随机矩阵与暴力算法比较: " << (right ? "正确" : "错误") << endl;
+    cout << "和最小的子矩阵(std::greater): " << (minimum ? "正确" : "错误") << endl;
+    cout << "全为负数时为最大的元素: " << (allNegative ? "正确" : "错误") << endl;
+
+    bool thrown = false;
+    try{
+        maxSubmatrixSum(m.begin(), 0, 4);
+    }catch (const std::invalid_argument &){
+        thrown = true;
+    }
+    cout << "空矩阵抛出异常: " << (thrown ? "正确" : "错误") << endl;
+}
+
+void Test2()
+{
+    // 多线程与单线程的结果(包括位置)相同, 宽矩阵与高矩阵(转置)
+    std::default_random_engine e(2026);
+    std::uniform_int_distribution<int> u(-1000, 1000);
+    const std::size_t shapes[][2] = {{300, 500}, {700, 90}, {1, 5000}, {3000, 1}, {257, 257}};
+    bool same = true;
+    for (auto &shape : shapes){
+        vector<int> a(shape[0] * shape[1]);
+        for (auto &x : a)
+            x = u(e);
+        SubmatrixSum<int> serial = maxSubmatrixSum(a.begin(), shape[0], shape[1]);
+        SubmatrixSum<int> parallel = maxSubmatrixSum(execution::par.withThreads(4).withGrain(1), a.begin(), shape[0], shape[1]);
+        same = same && sameResult(serial, parallel) && rectangleSum(a, shape[1], serial) == serial.sum;
+    }
+    cout << "多线程与单线程的结果相同: " << (same ? "正确" : "错误") << endl;
+
+    // 浮点数
+    std::uniform_real_distribution<double> d(-1.0, 1.0);
+    vector<double> f(120 * 80);
+    for (auto &x : f)
+        x = d(e);
+    SubmatrixSum<double> s = maxSubmatrixSum(execution::par.withThreads(4).withGrain(1), f.begin(), 120, 80);
+    double check = rectangleSum(f, 80, s);
+    cout << "浮点数: " << (check - s.sum < 1e-9 && s.sum - check < 1e-9 ? "正确" : "错误") << endl;
+
+    vector<int> big(1000 * 1000);
+    for (auto &x : big)
+        x = u(e);
+    auto begin = std::chrono::steady_clock::now();
+    SubmatrixSum<int> r = maxSubmatrixSum(execution::par, big.begin(), 1000, 1000);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    cout << "1000 * 1000的矩阵用时" << seconds << "秒: " << (rectangleSum(big, 1000, r) == r.sum ? "正确" : "错误") << endl;
+}
+
+int main()
+{
+    Test1();
+    Test2();
+    return 0;
+}
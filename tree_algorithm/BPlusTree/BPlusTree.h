@@ -0,0 +1,852 @@
+/*************************************************************************
+	> File Name: BPlusTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时41分40秒
+ ************************************************************************/
+
+#ifndef _BPLUSTREE_H
+#define _BPLUSTREE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <stdlib.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// BPlusTree: B+树 算法导论第18章(B树)的变形
+/*
+ * 所有关键字都在叶节点中, 内部节点只保存分隔关键字; 叶节点按关键字顺序组成双向链表, 区间扫描只在叶节点中顺序前进.
+ * 红黑树每一层都是一次依赖的缓存未命中(1600万个关键字约24次), B+树的每个节点有几十个关键字, 高度只有4到5.
+ *
+ *      --节点大小: NodeBytes(默认256字节, 4条缓存行), 叶节点能放(NodeBytes - 16) / sizeof(Key)个关键字,
+ *        内部节点能放(NodeBytes - 12) / (sizeof(Key) + 4)个关键字(都至少为4). 节点放在按64字节对齐的节点池中,
+ *        用32位下标链接(与PooledRedBlackTree相同), 关键字与子节点下标是节点中两个分开的数组;
+ *      --节点内查找: 关键字是32/64位整数且比较函数是std::less时, 用SSE2/AVX2一次比较4/8个关键字, 统计小于(不大于)
+ *        key的个数, 没有分支; 其它关键字用std::lower_bound/std::upper_bound;
+ *      --分隔关键字的性质: 第i个子树中的关键字 <= keys[i] <= 第i + 1个子树中的关键字, 允许相等的关键字
+ *        (与RedBlackTree一样, 相等的关键字插入到已有的之后);
+ *      --除根以外每个节点至少有容量的一半个关键字, 删除时先向相邻的兄弟借, 借不到时合并.
+ *        每个节点保存父节点的下标, 删除给定位置的关键字时不需要从根重新查找路径;
+ *      --build_from_sorted由有序的关键字自底向上建树, O(n), 叶节点是满的.
+ *
+ * 与RedBlackTree/PooledRedBlackTree相同的操作: insert, remove, erase, find, contains, minimum, maximum,
+ * successor, predecessor; 位置用iterator表示(叶节点下标与槽号), 插入或删除以后除了返回的迭代器以外都失效.
+ *
+ */
+
+const std::size_t bplus_cache_line = 64;
+
+namespace bplus_detail
+{
+// CacheAlignedAllocator: 按缓存行对齐的分配器(节点池用)
+template<typename T>
+struct CacheAlignedAllocator
+{
+    typedef T value_type;
+    CacheAlignedAllocator() {  }
+    template<typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {  }
+    T* allocate(std::size_t n)
+    {
+        void *p = nullptr;
+        if (::posix_memalign(&p, bplus_cache_line, std::max<std::size_t>(n * sizeof(T), 1)) != 0)
+            throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+    void deallocate(T *p, std::size_t) { std::free(p); }
+    template<typename U>
+    bool operator==(const CacheAlignedAllocator<U> &) const { return true; }
+    template<typename U>
+    bool operator!=(const CacheAlignedAllocator<U> &) const { return false; }
+};
+
+// GenericSearch: 一般的关键字, 二分查找
+template<typename Key, typename Compare>
+struct GenericSearch
+{
+    static std::uint32_t lower(const Key *keys, std::uint32_t n, const Key &key, const Compare &less)
+    {
+        return static_cast<std::uint32_t>(std::lower_bound(keys, keys + n, key, less) - keys);
+    }
+    static std::uint32_t upper(const Key *keys, std::uint32_t n, const Key &key, const Compare &less)
+    {
+        return static_cast<std::uint32_t>(std::upper_bound(keys, keys + n, key, less) - keys);
+    }
+};
+
+// IntegerSearch: 32/64位整数与std::less, 统计比key小(不大于key)的关键字个数
+/*
+ * 有序数组中比key小的个数就是lower_bound的位置. 无符号数先与符号位异或, 变成有符号数的比较.
+ * 整个节点都比较一遍(最多几十个关键字), 没有难以预测的分支.
+*/
+template<typename Key>
+struct IntegerSearch
+{
+    typedef std::integral_constant<std::size_t, sizeof(Key)> Width;
+    typedef typename std::conditional<sizeof(Key) == 4, std::int32_t, std::int64_t>::type Signed;
+    static Signed bias(Key key)
+    {
+        return std::is_signed<Key>::value ? static_cast<Signed>(key)
+                                          : static_cast<Signed>(key ^ (Key(1) << (sizeof(Key) * 8 - 1)));
+    }
+    template<typename Less>
+    static std::uint32_t lower(const Key *keys, std::uint32_t n, const Key &key, const Less &)
+    {
+        return countLess(keys, n, key, Width());
+    }
+    template<typename Less>
+    static std::uint32_t upper(const Key *keys, std::uint32_t n, const Key &key, const Less &)
+    {
+        return n - countGreater(keys, n, key, Width());
+    }
+    // countLess/countGreater: [0, n)中小于/大于key的个数
+    static std::uint32_t countLess(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 4>)
+    {
+        std::uint32_t i = 0, count = 0;
+        const Signed k = bias(key);
+#if defined(__AVX2__)
+        const __m256i flip = _mm256_set1_epi32(std::is_signed<Key>::value ? 0 : static_cast<int>(0x80000000u));
+        const __m256i v = _mm256_set1_epi32(k);
+        for (; i + 8 <= n; i += 8){
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, x))));
+        }
+#elif defined(__SSE2__)
+        const __m128i flip = _mm_set1_epi32(std::is_signed<Key>::value ? 0 : static_cast<int>(0x80000000u));
+        const __m128i v = _mm_set1_epi32(k);
+        for (; i + 4 <= n; i += 4){
+            __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, x))));
+        }
+#endif
+        for (; i < n; ++i)
+            count += bias(keys[i]) < k;
+        return count;
+    }
+    static std::uint32_t countGreater(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 4>)
+    {
+        std::uint32_t i = 0, count = 0;
+        const Signed k = bias(key);
+#if defined(__AVX2__)
+        const __m256i flip = _mm256_set1_epi32(std::is_signed<Key>::value ? 0 : static_cast<int>(0x80000000u));
+        const __m256i v = _mm256_set1_epi32(k);
+        for (; i + 8 <= n; i += 8){
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, v))));
+        }
+#elif defined(__SSE2__)
+        const __m128i flip = _mm_set1_epi32(std::is_signed<Key>::value ? 0 : static_cast<int>(0x80000000u));
+        const __m128i v = _mm_set1_epi32(k);
+        for (; i + 4 <= n; i += 4){
+            __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, v))));
+        }
+#endif
+        for (; i < n; ++i)
+            count += k < bias(keys[i]);
+        return count;
+    }
+    // 64位的比较需要AVX2(SSE2没有64位整数的比较指令), 否则是逐个比较(没有分支, 编译器可以展开)
+    static std::uint32_t countLess(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 8>)
+    {
+        std::uint32_t i = 0, count = 0;
+        const Signed k = bias(key);
+#if defined(__AVX2__)
+        const __m256i flip = _mm256_set1_epi64x(std::is_signed<Key>::value ? 0 : static_cast<long long>(0x8000000000000000ull));
+        const __m256i v = _mm256_set1_epi64x(k);
+        for (; i + 4 <= n; i += 4){
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, x))));
+        }
+#endif
+        for (; i < n; ++i)
+            count += bias(keys[i]) < k;
+        return count;
+    }
+    static std::uint32_t countGreater(const Key *keys, std::uint32_t n, Key key, std::integral_constant<std::size_t, 8>)
+    {
+        std::uint32_t i = 0, count = 0;
+        const Signed k = bias(key);
+#if defined(__AVX2__)
+        const __m256i flip = _mm256_set1_epi64x(std::is_signed<Key>::value ? 0 : static_cast<long long>(0x8000000000000000ull));
+        const __m256i v = _mm256_set1_epi64x(k);
+        for (; i + 4 <= n; i += 4){
+            __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), flip);
+            count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, v))));
+        }
+#endif
+        for (; i < n; ++i)
+            count += k < bias(keys[i]);
+        return count;
+    }
+};
+
+// NodeSearch: 选择节点内的查找方法
+template<typename Key, typename Compare>
+struct NodeSearch
+    : std::conditional<std::is_integral<Key>::value && !std::is_same<Key, bool>::value &&
+                       (sizeof(Key) == 4 || sizeof(Key) == 8) && std::is_same<Compare, std::less<Key>>::value,
+                       IntegerSearch<Key>, GenericSearch<Key, Compare>>::type
+{
+};
+}
+
+template<typename Key, typename Compare = std::less<Key>, std::size_t NodeBytes = 256>
+class BPlusTree
+{
+public:
+    typedef std::uint32_t Index;
+    typedef Key key_type;
+    typedef Compare key_compare;
+    static const Index none = 0xFFFFFFFFu;     // 空下标
+    static const std::uint32_t leaf_capacity =
+        (NodeBytes - 16) / sizeof(Key) < 4 ? 4 : static_cast<std::uint32_t>((NodeBytes - 16) / sizeof(Key));
+    static const std::uint32_t inner_capacity =
+        (NodeBytes - 12) / (sizeof(Key) + 4) < 4 ? 4 : static_cast<std::uint32_t>((NodeBytes - 12) / (sizeof(Key) + 4));
+    static const std::uint32_t leaf_minimum = leaf_capacity / 2;     // 除根以外叶节点的最少关键字数
+    static const std::uint32_t inner_minimum = inner_capacity / 2;   // 除根以外内部节点的最少关键字数
+
+    // iterator: 按关键字顺序的双向迭代器(叶节点下标与槽号), 关键字只读
+    class iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Key value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Key* pointer;
+        typedef const Key& reference;
+        iterator() : tree(nullptr), leaf(none), slot(0) {  }
+        reference operator*() const { return tree->leaves[leaf].keys[slot]; }
+        pointer operator->() const { return &tree->leaves[leaf].keys[slot]; }
+        iterator& operator++()
+        {
+            if (++slot == tree->leaves[leaf].count){
+                leaf = tree->leaves[leaf].next;
+                slot = 0;
+            }
+            return *this;
+        }
+        iterator& operator--()
+        {
+            if (leaf == none){
+                leaf = tree->last;
+                slot = tree->leaves[leaf].count - 1;
+            }else if (slot == 0){
+                leaf = tree->leaves[leaf].prev;
+                slot = tree->leaves[leaf].count - 1;
+            }else
+                --slot;
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        iterator operator--(int) { iterator old = *this; --*this; return old; }
+        bool operator==(const iterator &other) const { return leaf == other.leaf && slot == other.slot; }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+    private:
+        friend class BPlusTree;
+        iterator(const BPlusTree *t, Index l, std::uint32_t s) : tree(t), leaf(l), slot(s) {  }
+        const BPlusTree *tree;
+        Index leaf;             // none表示end()
+        std::uint32_t slot;
+    };
+    typedef iterator const_iterator;
+
+    //***************************构造函数*********************************
+    explicit BPlusTree(const Compare &comp = Compare())
+        : less(comp), root(none), first(none), last(none), height_(0), count(0), freeLeaves(none), freeInners(none) {  }
+    //***************************成员函数*********************************
+    iterator insert(const Key &key);        // 插入一个关键字(相等的关键字插入到已有的之后), 返回它的位置
+    void remove(iterator position);         // 删除position处的关键字
+    bool erase(const Key &key);             // 删除一个关键字为key的元素, 返回是否删除
+    iterator find(const Key &key) const;    // 第一个关键字为key的元素, 没有时返回end()
+    bool contains(const Key &key) const { return find(key) != end(); }
+    iterator lower_bound(const Key &key) const;    // 第一个不小于key的元素
+    iterator upper_bound(const Key &key) const;    // 第一个大于key的元素
+    iterator minimum() const { return begin(); }
+    iterator maximum() const { return empty() ? end() : iterator(this, last, leaves[last].count - 1); }
+    iterator successor(iterator position) const { return ++position; }     // 后继, 没有时为end()
+    iterator predecessor(iterator position) const { return position == begin() ? end() : --position; }
+    iterator begin() const { return iterator(this, first, 0); }
+    iterator end() const { return iterator(this, none, 0); }
+    // range: 按顺序对闭区间[lo, hi]中的每个关键字调用f(key), 只在叶节点的链表中前进
+    template<typename Function>
+    void range(const Key &lo, const Key &hi, Function f) const;
+    // build_from_sorted: 用有序的[first, last)建立B+树(替换原有的树), O(n); 序列无序时抛出std::invalid_argument
+    template<typename Iterator>
+    void build_from_sorted(Iterator first, Iterator last);
+    void clear();
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    unsigned height() const { return height_; }     // 从根到叶节点的层数(空树为0)
+    const Compare& key_comp() const { return less; }
+    // bytes: 节点池占用的字节数(包括空闲节点)
+    std::size_t bytes() const { return leaves.capacity() * sizeof(Leaf) + inners.capacity() * sizeof(Inner); }
+    bool validate() const;                  // 检查B+树的所有性质(测试用)
+private:
+    //***************************数据结构*********************************
+    typedef bplus_detail::NodeSearch<Key, Compare> Search;
+    struct Leaf
+    {
+        Key keys[leaf_capacity];
+        Index next;             // 后一个叶节点; 空闲时为空闲链表的下一个
+        Index prev;             // 前一个叶节点
+        Index parent;
+        std::uint32_t count;
+    };
+    struct Inner
+    {
+        Key keys[inner_capacity];
+        Index children[inner_capacity + 1];     // 空闲时children[0]为空闲链表的下一个
+        Index parent;
+        std::uint16_t count;
+        std::uint16_t level;    // 1表示子节点是叶节点
+    };
+    std::vector<Leaf, bplus_detail::CacheAlignedAllocator<Leaf>> leaves;
+    std::vector<Inner, bplus_detail::CacheAlignedAllocator<Inner>> inners;
+    Compare less;
+    Index root;                 // height_ == 1时是叶节点, 否则是内部节点
+    Index first;                // 第一个叶节点
+    Index last;                 // 最后一个叶节点
+    unsigned height_;
+    std::size_t count;
+    Index freeLeaves;
+    Index freeInners;
+    //***************************私有成员函数*****************************
+    Index allocateLeaf();
+    Index allocateInner();
+    void releaseLeaf(Index leaf) { leaves[leaf].next = freeLeaves; freeLeaves = leaf; }
+    void releaseInner(Index inner) { inners[inner].children[0] = freeInners; freeInners = inner; }
+    void setParent(Index child, bool leafChild, Index parent)
+    {
+        if (leafChild) leaves[child].parent = parent;
+        else inners[child].parent = parent;
+    }
+    std::uint32_t childPosition(Index parent, Index child) const;   // child是parent的第几个子节点
+    Index descend(const Key &key, bool upper) const;    // 从根走到可能包含key的叶节点
+    iterator normalize(Index leaf, std::uint32_t slot) const
+    {
+        return slot < leaves[leaf].count ? iterator(this, leaf, slot) : iterator(this, leaves[leaf].next, 0);
+    }
+    void insertIntoParent(Index left, const Key &separator, Index right, bool leafChildren);
+    void rebalanceLeaf(Index leaf);
+    void rebalanceInner(Index inner);
+    void removeChild(Index parent, std::uint32_t keyPosition);  // 删除keys[keyPosition]与它右侧的子节点
+    int validateNode(Index node, unsigned level, const Key *low, const Key *high, Index parent, std::size_t &keys) const;
+};
+template<typename Key, typename Compare, std::size_t NodeBytes>
+const typename BPlusTree<Key, Compare, NodeBytes>::Index BPlusTree<Key, Compare, NodeBytes>::none;
+template<typename Key, typename Compare, std::size_t NodeBytes>
+const std::uint32_t BPlusTree<Key, Compare, NodeBytes>::leaf_capacity;
+template<typename Key, typename Compare, std::size_t NodeBytes>
+const std::uint32_t BPlusTree<Key, Compare, NodeBytes>::inner_capacity;
+template<typename Key, typename Compare, std::size_t NodeBytes>
+const std::uint32_t BPlusTree<Key, Compare, NodeBytes>::leaf_minimum;
+template<typename Key, typename Compare, std::size_t NodeBytes>
+const std::uint32_t BPlusTree<Key, Compare, NodeBytes>::inner_minimum;
+//**********************************成员函数******************************
+// allocateLeaf/allocateInner: 取得一个节点(优先从空闲链表中取). 节点池可能扩充, 之前取得的节点引用会失效
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::Index BPlusTree<Key, Compare, NodeBytes>::allocateLeaf()
+{
+    Index leaf = freeLeaves;
+    if (leaf != none)
+        freeLeaves = leaves[leaf].next;
+    else{
+        if (leaves.size() >= none)
+            throw std::length_error("BPlusTree error: 叶节点数超过2^32 - 1");
+        leaf = static_cast<Index>(leaves.size());
+        leaves.push_back(Leaf());
+    }
+    leaves[leaf].next = leaves[leaf].prev = leaves[leaf].parent = none;
+    leaves[leaf].count = 0;
+    return leaf;
+}
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::Index BPlusTree<Key, Compare, NodeBytes>::allocateInner()
+{
+    Index inner = freeInners;
+    if (inner != none)
+        freeInners = inners[inner].children[0];
+    else{
+        if (inners.size() >= none)
+            throw std::length_error("BPlusTree error: 内部节点数超过2^32 - 1");
+        inner = static_cast<Index>(inners.size());
+        inners.push_back(Inner());
+    }
+    inners[inner].parent = none;
+    inners[inner].count = 0;
+    return inner;
+}
+// childPosition: 在父节点的子节点数组中查找child
+template<typename Key, typename Compare, std::size_t NodeBytes>
+std::uint32_t BPlusTree<Key, Compare, NodeBytes>::childPosition(Index parent, Index child) const
+{
+    const Inner &node = inners[parent];
+    std::uint32_t i = 0;
+    while (node.children[i] != child)
+        ++i;
+    return i;
+}
+// descend: 从根走到叶节点
+/*
+ * \parameter upper: 为false时进入第一个可能包含key的子树(分隔关键字中小于key的个数), 用于查找;
+ *                   为true时进入最后一个可能包含key的子树(不大于key的个数), 用于插入.
+*/
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::Index BPlusTree<Key, Compare, NodeBytes>::descend(const Key &key, bool upper) const
+{
+    Index node = root;
+    for (unsigned level = height_; level > 1; --level){
+        const Inner &inner = inners[node];
+        std::uint32_t i = upper ? Search::upper(inner.keys, inner.count, key, less)
+                                : Search::lower(inner.keys, inner.count, key, less);
+        node = inner.children[i];
+    }
+    return node;
+}
+// lower_bound: 第一个不小于key的元素
+/*
+ * 进入的子树i满足keys[i - 1] < key <= keys[i], 之前的子树中的关键字都小于key; 子树i中没有时,
+ * 答案是下一个叶节点的第一个关键字(它不小于keys[i]).
+*/
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::iterator BPlusTree<Key, Compare, NodeBytes>::lower_bound(const Key &key) const
+{
+    if (empty())
+        return end();
+    Index leaf = descend(key, false);
+    return normalize(leaf, Search::lower(leaves[leaf].keys, leaves[leaf].count, key, less));
+}
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::iterator BPlusTree<Key, Compare, NodeBytes>::upper_bound(const Key &key) const
+{
+    if (empty())
+        return end();
+    Index leaf = descend(key, true);
+    return normalize(leaf, Search::upper(leaves[leaf].keys, leaves[leaf].count, key, less));
+}
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::iterator BPlusTree<Key, Compare, NodeBytes>::find(const Key &key) const
+{
+    iterator position = lower_bound(key);
+    return (position != end() && !less(key, *position)) ? position : end();
+}
+// range: 从lower_bound(lo)开始沿叶节点链表扫描, 直到关键字大于hi
+template<typename Key, typename Compare, std::size_t NodeBytes>
+template<typename Function>
+void BPlusTree<Key, Compare, NodeBytes>::range(const Key &lo, const Key &hi, Function f) const
+{
+    if (empty() || less(hi, lo))
+        return;
+    Index leaf = descend(lo, false);
+    std::uint32_t slot = Search::lower(leaves[leaf].keys, leaves[leaf].count, lo, less);
+    for (; leaf != none; leaf = leaves[leaf].next, slot = 0){
+        const Leaf &node = leaves[leaf];
+        // 整个叶节点都不大于hi时不必逐个比较
+        std::uint32_t end = less(hi, node.keys[node.count - 1]) ? Search::upper(node.keys, node.count, hi, less) : node.count;
+        for (; slot < end; ++slot)
+            f(node.keys[slot]);
+        if (end < node.count)
+            return;
+    }
+}
+// insert: 插入关键字
+/*
+ * 算法基本思想: 找到最后一个可能包含key的叶节点, 插入到相等的关键字之后. 叶节点满时分裂成两半,
+ *      右半的第一个关键字作为分隔关键字插入父节点; 父节点满时也分裂, 中间的关键字上移, 直到根(根分裂时树长高一层).
+ * 算法性能: 时间复杂度为O(B log_B n), B为节点的容量.
+*/
+template<typename Key, typename Compare, std::size_t NodeBytes>
+typename BPlusTree<Key, Compare, NodeBytes>::iterator BPlusTree<Key, Compare, NodeBytes>::insert(const Key &key)
+{
+    if (root == none){
+        root = first = last = allocateLeaf();
+        height_ = 1;
+    }
+    Index leaf = descend(key, true);
+    std::uint32_t slot = Search::upper(leaves[leaf].keys, leaves[leaf].count, key, less);
+    ++count;
+    if (leaves[leaf].count < leaf_capacity){
+        Leaf &node = leaves[leaf];
+        std::copy_backward(node.keys + slot, node.keys + node.count, node.keys + node.count + 1);
+        node.keys[slot] = key;
+        ++node.count;
+        return iterator(this, leaf, slot);
+    }
+    // 分裂: 左半留mid个关键字, 其余移到新的叶节点
+    Index rightLeaf = allocateLeaf();
+    Leaf &left = leaves[leaf], &right = leaves[rightLeaf];
+    const std::uint32_t mid = leaf_capacity / 2;
+    std::copy(left.keys + mid, left.keys + leaf_capacity, right.keys);
+    left.count = mid;
+    right.count = leaf_capacity - mid;
+    Index target = leaf;
+    if (slot >= mid){
+        target = rightLeaf;
+        slot -= mid;
+    }
+    Leaf &node = leaves[target];
+    std::copy_backward(node.keys + slot, node.keys + node.count, node.keys + node.count + 1);
+    node.keys[slot] = key;
+    ++node.count;
+    right.next = left.next;
+    right.prev = leaf;
+    if (left.next != none)
+        leaves[left.next].prev = rightLeaf;
+    else
+        last = rightLeaf;
+    left.next = rightLeaf;
+    right.parent = left.parent;
+    insertIntoParent(leaf, right.keys[0], rightLeaf, true);
+    return iterator(this, target, slot);
+}
+// insertIntoParent: left分裂出right以后, 把分隔关键字separator与right插入left的父节点
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::insertIntoParent(Index left, const Key &separator, Index right, bool leafChildren)
+{
+    Index parent = leafChildren ? leaves[left].parent : inners[left].parent;
+    if (parent == none){
+        // 根分裂: 新的根
+        const Key up = separator;   // separator可能引用节点池中的关键字, 分配节点以前复制
+        Index top = allocateInner();
+        Inner &node = inners[top];
+        node.keys[0] = up;
+        node.children[0] = left;
+        node.children[1] = right;
+        node.count = 1;
+        node.level = static_cast<std::uint16_t>(height_);
+        setParent(left, leafChildren, top);
+        setParent(right, leafChildren, top);
+        root = top;
+        ++height_;
+        return;
+    }
+    std::uint32_t i = childPosition(parent, left);
+    if (inners[parent].count < inner_capacity){
+        Inner &node = inners[parent];
+        std::copy_backward(node.keys + i, node.keys + node.count, node.keys + node.count + 1);
+        std::copy_backward(node.children + i + 1, node.children + node.count + 1, node.children + node.count + 2);
+        node.keys[i] = separator;
+        node.children[i + 1] = right;
+        ++node.count;
+        setParent(right, leafChildren, parent);
+        return;
+    }
+    // 父节点满: 在临时数组中插入, 左边留mid个关键字, keys[mid]上移, 其余移到新的内部节点
+    Key keys[inner_capacity + 1];
+    Index children[inner_capacity + 2];
+    {
+        const Inner &node = inners[parent];
+        std::copy(node.keys, node.keys + i, keys);
+        keys[i] = separator;
+        std::copy(node.keys + i, node.keys + inner_capacity, keys + i + 1);
+        std::copy(node.children, node.children + i + 1, children);
+        children[i + 1] = right;
+        std::copy(node.children + i + 1, node.children + inner_capacity + 1, children + i + 2);
+    }
+    setParent(right, leafChildren, parent);
+    Index sibling = allocateInner();
+    Inner &node = inners[parent], &other = inners[sibling];
+    const std::uint32_t mid = (inner_capacity + 1) / 2;
+    std::copy(keys, keys + mid, node.keys);
+    std::copy(children, children + mid + 1, node.children);
+    node.count = static_cast<std::uint16_t>(mid);
+    std::copy(keys + mid + 1, keys + inner_capacity + 1, other.keys);
+    std::copy(children + mid + 1, children + inner_capacity + 2, other.children);
+    other.count = static_cast<std::uint16_t>(inner_capacity - mid);
+    other.level = node.level;
+    other.parent = node.parent;
+    for (std::uint32_t j = 0; j <= other.count; ++j)
+        setParent(other.children[j], leafChildren, sibling);
+    insertIntoParent(parent, keys[mid], sibling, false);
+}
+// erase: 删除一个关键字为key的元素
+template<typename Key, typename Compare, std::size_t NodeBytes>
+bool BPlusTree<Key, Compare, NodeBytes>::erase(const Key &key)
+{
+    iterator position = find(key);
+    if (position == end())
+        return false;
+    remove(position);
+    return true;
+}
+// remove: 删除position处的关键字
+/*
+ * 算法基本思想: 从叶节点中删除. 叶节点的关键字少于一半时, 若相邻的兄弟(同一个父节点)多于一半, 借一个过来并更新
+ *      父节点中的分隔关键字; 否则与兄弟合并, 从父节点中删除一个分隔关键字与一个子节点, 父节点也可能因此不足一半,
+ *      同样处理, 直到根. 根只剩一个子节点时, 子节点成为新的根(树变矮一层).
+ * 算法性能: 时间复杂度为O(B log_B n).
+*/
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::remove(iterator position)
+{
+    if (position.tree != this || position.leaf == none)
+        throw std::invalid_argument("BPlusTree error: remove的位置不在树中");
+    Index leaf = position.leaf;
+    Leaf &node = leaves[leaf];
+    std::copy(node.keys + position.slot + 1, node.keys + node.count, node.keys + position.slot);
+    --node.count;
+    --count;
+    if (height_ == 1){     // 叶节点是根(叶节点与内部节点的下标是分开编号的, 不能与root比较)
+        if (node.count == 0)
+            clear();
+        return;
+    }
+    if (node.count < leaf_minimum)
+        rebalanceLeaf(leaf);
+}
+// rebalanceLeaf: 叶节点的关键字不足一半时, 向兄弟借或者合并
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::rebalanceLeaf(Index leaf)
+{
+    Index parent = leaves[leaf].parent;
+    std::uint32_t i = childPosition(parent, leaf);
+    Inner &up = inners[parent];
+    Leaf &node = leaves[leaf];
+    if (i > 0 && leaves[up.children[i - 1]].count > leaf_minimum){
+        // 借左兄弟的最后一个关键字
+        Leaf &left = leaves[up.children[i - 1]];
+        std::copy_backward(node.keys, node.keys + node.count, node.keys + node.count + 1);
+        node.keys[0] = left.keys[--left.count];
+        ++node.count;
+        up.keys[i - 1] = node.keys[0];
+        return;
+    }
+    if (i < up.count && leaves[up.children[i + 1]].count > leaf_minimum){
+        // 借右兄弟的第一个关键字
+        Leaf &right = leaves[up.children[i + 1]];
+        node.keys[node.count++] = right.keys[0];
+        std::copy(right.keys + 1, right.keys + right.count, right.keys);
+        --right.count;
+        up.keys[i] = right.keys[0];
+        return;
+    }
+    // 合并: 右边的叶节点并入左边的, 从链表中摘下
+    std::uint32_t keyPosition = i > 0 ? i - 1 : i;
+    Index leftLeaf = up.children[keyPosition], rightLeaf = up.children[keyPosition + 1];
+    Leaf &left = leaves[leftLeaf], &right = leaves[rightLeaf];
+    std::copy(right.keys, right.keys + right.count, left.keys + left.count);
+    left.count += right.count;
+    left.next = right.next;
+    if (right.next != none)
+        leaves[right.next].prev = leftLeaf;
+    else
+        last = leftLeaf;
+    releaseLeaf(rightLeaf);
+    removeChild(parent, keyPosition);
+}
+// removeChild: 合并以后从内部节点中删除keys[keyPosition]与children[keyPosition + 1]
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::removeChild(Index parent, std::uint32_t keyPosition)
+{
+    Inner &node = inners[parent];
+    std::copy(node.keys + keyPosition + 1, node.keys + node.count, node.keys + keyPosition);
+    std::copy(node.children + keyPosition + 2, node.children + node.count + 1, node.children + keyPosition + 1);
+    --node.count;
+    if (parent == root){
+        if (node.count == 0){
+            // 根只剩一个子节点
+            root = node.children[0];
+            setParent(root, node.level == 1, none);
+            releaseInner(parent);
+            --height_;
+        }
+        return;
+    }
+    if (node.count < inner_minimum)
+        rebalanceInner(parent);
+}
+// rebalanceInner: 内部节点的关键字不足一半时, 经过父节点的分隔关键字向兄弟借(旋转)或者合并
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::rebalanceInner(Index inner)
+{
+    Index parent = inners[inner].parent;
+    std::uint32_t i = childPosition(parent, inner);
+    Inner &up = inners[parent];
+    Inner &node = inners[inner];
+    const bool leafChildren = node.level == 1;
+    if (i > 0 && inners[up.children[i - 1]].count > inner_minimum){
+        Inner &left = inners[up.children[i - 1]];
+        std::copy_backward(node.keys, node.keys + node.count, node.keys + node.count + 1);
+        std::copy_backward(node.children, node.children + node.count + 1, node.children + node.count + 2);
+        node.keys[0] = up.keys[i - 1];
+        node.children[0] = left.children[left.count];
+        setParent(node.children[0], leafChildren, inner);
+        up.keys[i - 1] = left.keys[left.count - 1];
+        --left.count;
+        ++node.count;
+        return;
+    }
+    if (i < up.count && inners[up.children[i + 1]].count > inner_minimum){
+        Inner &right = inners[up.children[i + 1]];
+        node.keys[node.count] = up.keys[i];
+        node.children[node.count + 1] = right.children[0];
+        setParent(right.children[0], leafChildren, inner);
+        up.keys[i] = right.keys[0];
+        std::copy(right.keys + 1, right.keys + right.count, right.keys);
+        std::copy(right.children + 1, right.children + right.count + 1, right.children);
+        --right.count;
+        ++node.count;
+        return;
+    }
+    // 合并: 左节点 + 分隔关键字 + 右节点
+    std::uint32_t keyPosition = i > 0 ? i - 1 : i;
+    Index leftInner = up.children[keyPosition], rightInner = up.children[keyPosition + 1];
+    Inner &left = inners[leftInner], &right = inners[rightInner];
+    left.keys[left.count] = up.keys[keyPosition];
+    std::copy(right.keys, right.keys + right.count, left.keys + left.count + 1);
+    std::copy(right.children, right.children + right.count + 1, left.children + left.count + 1);
+    for (std::uint32_t j = 0; j <= right.count; ++j)
+        setParent(right.children[j], leafChildren, leftInner);
+    left.count = static_cast<std::uint16_t>(left.count + 1 + right.count);
+    releaseInner(rightInner);
+    removeChild(parent, keyPosition);
+}
+// build_from_sorted: 由有序序列自底向上建立B+树
+/*
+ * \parameter first, last: 按Compare有序(允许相等)的关键字, Iterator至少是前向迭代器;
+ * \return void. 序列无序时抛出std::invalid_argument, 原有的树不变.
+ *
+ * 算法基本思想: 叶节点数为ceil(n / 容量), 关键字平均分到各个叶节点(每个至少容量的一半); 上一层同样把子节点平均分组,
+ *      每组之间的分隔关键字是右边子树的最小关键字, 直到只剩一个节点. 时间复杂度为O(n).
+*/
+template<typename Key, typename Compare, std::size_t NodeBytes>
+template<typename Iterator>
+void BPlusTree<Key, Compare, NodeBytes>::build_from_sorted(Iterator begin, Iterator end)
+{
+    std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n > 1){
+        Iterator previous = begin, current = begin;
+        for (++current; current != end; ++previous, ++current)
+            if (less(*current, *previous))
+                throw std::invalid_argument("BPlusTree error: build_from_sorted的序列不是有序的");
+    }
+    clear();
+    if (n == 0)
+        return;
+    std::size_t leafCount = (n + leaf_capacity - 1) / leaf_capacity;
+    leaves.reserve(leafCount);
+    std::vector<Index> level;       // 当前一层的节点
+    std::vector<Key> minimums;      // 当前一层每个节点的子树中的最小关键字
+    level.reserve(leafCount);
+    minimums.reserve(leafCount);
+    for (std::size_t j = 0; j != leafCount; ++j){
+        Index leaf = allocateLeaf();
+        Leaf &node = leaves[leaf];
+        std::uint32_t take = static_cast<std::uint32_t>(n / leafCount + (j < n % leafCount ? 1 : 0));
+        for (std::uint32_t k = 0; k != take; ++k, ++begin)
+            node.keys[k] = *begin;
+        node.count = take;
+        node.prev = level.empty() ? none : level.back();
+        if (!level.empty())
+            leaves[level.back()].next = leaf;
+        level.push_back(leaf);
+        minimums.push_back(node.keys[0]);
+    }
+    first = level.front();
+    last = level.back();
+    height_ = 1;
+    count = n;
+    while (level.size() > 1){
+        std::size_t groups = (level.size() + inner_capacity) / (inner_capacity + 1);
+        std::vector<Index> upper;
+        std::vector<Key> upperMinimums;
+        std::size_t next = 0;
+        for (std::size_t j = 0; j != groups; ++j){
+            std::size_t take = level.size() / groups + (j < level.size() % groups ? 1 : 0);
+            Index inner = allocateInner();
+            Inner &node = inners[inner];
+            node.level = static_cast<std::uint16_t>(height_);
+            node.count = static_cast<std::uint16_t>(take - 1);
+            for (std::size_t k = 0; k != take; ++k, ++next){
+                node.children[k] = level[next];
+                if (k != 0)
+                    node.keys[k - 1] = minimums[next];
+                setParent(level[next], height_ == 1, inner);
+            }
+            upper.push_back(inner);
+            upperMinimums.push_back(minimums[next - take]);
+        }
+        level.swap(upper);
+        minimums.swap(upperMinimums);
+        ++height_;
+    }
+    root = level.front();
+}
+// clear: 删除所有关键字, 保留节点池的空间
+template<typename Key, typename Compare, std::size_t NodeBytes>
+void BPlusTree<Key, Compare, NodeBytes>::clear()
+{
+    leaves.clear();
+    inners.clear();
+    root = first = last = freeLeaves = freeInners = none;
+    height_ = 0;
+    count = 0;
+}
+// validate: 检查关键字的顺序与分隔关键字的性质, 节点的最少关键字数, 父节点下标, 所有叶节点的深度相同, 叶节点链表
+template<typename Key, typename Compare, std::size_t NodeBytes>
+bool BPlusTree<Key, Compare, NodeBytes>::validate() const
+{
+    if (root == none)
+        return count == 0 && height_ == 0 && first == none && last == none;
+    std::size_t keys = 0;
+    if (validateNode(root, height_, nullptr, nullptr, none, keys) < 0 || keys != count)
+        return false;
+    // 叶节点链表按顺序连接所有叶节点, 关键字非递减
+    std::size_t linked = 0;
+    Index previous = none;
+    const Key *lastKey = nullptr;
+    for (Index leaf = first; leaf != none; previous = leaf, leaf = leaves[leaf].next){
+        if (leaves[leaf].prev != previous)
+            return false;
+        for (std::uint32_t i = 0; i != leaves[leaf].count; ++i){
+            if (lastKey && less(leaves[leaf].keys[i], *lastKey))
+                return false;
+            lastKey = &leaves[leaf].keys[i];
+        }
+        linked += leaves[leaf].count;
+    }
+    return previous == last && linked == count;
+}
+template<typename Key, typename Compare, std::size_t NodeBytes>
+int BPlusTree<Key, Compare, NodeBytes>::validateNode(Index node, unsigned level, const Key *low, const Key *high,
+                                                     Index parent, std::size_t &keys) const
+{
+    // [low, high]: 分隔关键字给出的范围(nullptr表示没有界)
+    if (level == 1){
+        const Leaf &leaf = leaves[node];
+        if (leaf.parent != parent || leaf.count == 0 || (level != height_ && leaf.count < leaf_minimum))
+            return -1;
+        for (std::uint32_t i = 0; i != leaf.count; ++i)
+            if ((i > 0 && less(leaf.keys[i], leaf.keys[i - 1])) || (low && less(leaf.keys[i], *low)) ||
+                (high && less(*high, leaf.keys[i])))
+                return -1;
+        keys += leaf.count;
+        return 0;
+    }
+    const Inner &inner = inners[node];
+    if (inner.parent != parent || inner.level != level - 1 || inner.count == 0 ||
+        (level != height_ && inner.count < inner_minimum))
+        return -1;
+    for (std::uint32_t i = 0; i <= inner.count; ++i){
+        if (i > 0 && i < inner.count && less(inner.keys[i], inner.keys[i - 1]))
+            return -1;
+        const Key *l = i == 0 ? low : &inner.keys[i - 1];
+        const Key *h = i == inner.count ? high : &inner.keys[i];
+        if (validateNode(inner.children[i], level - 1, l, h, node, keys) < 0)
+            return -1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,89 @@
+/*************************************************************************
+	> File Name: BPlusTree_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时44分23秒
+ ************************************************************************/
+// B+树与节点池中的红黑树(PooledRedBlackTree)的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [关键字个数(默认1000000)]
+ *      随机插入n个关键字, 以随机的次序查找每个关键字, 按顺序扫描所有关键字, 再由排好序的关键字批量建立.
+ *
+ * 输出的每一行: tree,n,insert_ns,find_ns,scan_ns,build_ns,bytes
+ *      --insert_ns/find_ns/scan_ns/build_ns: 每个关键字的平均时间;
+ *      --bytes: 插入n个关键字以后节点池占用的字节数.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "BPlusTree.h"
+#include "../RedBlackTree/PooledRedBlackTree.h"
+
+typedef std::chrono::steady_clock Clock;
+std::int64_t bench_sink = 0;
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<int> keys(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (auto &key : keys){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<int>(state >> 33);
+    }
+    std::vector<int> probes(keys), sorted(keys);
+    std::reverse(probes.begin(), probes.end());
+    std::sort(sorted.begin(), sorted.end());
+    std::cout << "tree,n,insert_ns,find_ns,scan_ns,build_ns,bytes\n";
+    {
+        PooledRedBlackTree<int> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(key);
+        double insert_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        for (int key : probes)
+            bench_sink += tree.find(key);
+        double find_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        for (auto node = tree.minimum(tree.root()); node != tree.nil; node = tree.successor(node))
+            bench_sink += tree.key(node);
+        double scan_ns = nanosecondsSince(begin, n);
+        std::size_t bytes = tree.bytes();
+        begin = Clock::now();
+        tree.build_from_sorted(sorted.begin(), sorted.end());
+        std::cout << "pooled_rbtree," << n << ',' << insert_ns << ',' << find_ns << ',' << scan_ns << ','
+                  << nanosecondsSince(begin, n) << ',' << bytes << std::endl;
+    }
+    {
+        BPlusTree<int> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(key);
+        double insert_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        for (int key : probes)
+            bench_sink += *tree.find(key);
+        double find_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        tree.range(sorted.front(), sorted.back(), [](const int &key){ bench_sink += key; });
+        double scan_ns = nanosecondsSince(begin, n);
+        std::size_t bytes = tree.bytes();
+        begin = Clock::now();
+        tree.build_from_sorted(sorted.begin(), sorted.end());
+        std::cout << "bplus_tree," << n << ',' << insert_ns << ',' << find_ns << ',' << scan_ns << ','
+                  << nanosecondsSince(begin, n) << ',' << bytes << std::endl;
+    }
+    return bench_sink == 0;
+}
@@ -0,0 +1,135 @@
+/*************************************************************************
+	> File Name: BPlusTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时47分06秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BPlusTree.h"
+
+// same: 树中的关键字(正向与反向遍历)与multiset相同
+template<typename Tree, typename Set>
+bool same(const Tree &tree, const Set &reference)
+{
+    if (tree.size() != reference.size() || !std::equal(reference.begin(), reference.end(), tree.begin()))
+        return false;
+    auto it = tree.end();
+    for (auto r = reference.rbegin(); r != reference.rend(); ++r)
+        if (*--it != *r)
+            return false;
+    return it == tree.begin();
+}
+
+// random_test: 随机插入与删除(有许多相等的关键字), 与std::multiset比较, 定期检查B+树的性质
+template<typename Tree>
+bool random_test(unsigned seed, int range)
+{
+    Tree tree;
+    std::multiset<typename Tree::key_type, typename Tree::key_compare> reference;
+    std::srand(seed);
+    bool correct = true;
+    for (int i = 0; i != 40000; ++i){
+        auto key = static_cast<typename Tree::key_type>(std::rand() % range);
+        // 前半段以插入为主, 后半段以删除为主, 树先长高再变矮
+        if (std::rand() % 10 < (i < 20000 ? 7 : 3)){
+            auto position = tree.insert(key);
+            reference.insert(key);
+            correct = correct && *position == key;
+        }else{
+            bool erased = tree.erase(key);
+            auto it = reference.find(key);
+            correct = correct && erased == (it != reference.end());
+            if (it != reference.end())
+                reference.erase(it);
+        }
+        if (i % 2000 == 0)
+            correct = correct && tree.validate() && same(tree, reference);
+    }
+    for (int i = 0; i != 500; ++i){
+        auto lo = static_cast<typename Tree::key_type>(std::rand() % range);
+        auto hi = static_cast<typename Tree::key_type>(lo + std::rand() % 50);
+        if (tree.key_comp()(hi, lo))
+            std::swap(lo, hi);
+        auto lower = tree.lower_bound(lo), upper = tree.upper_bound(hi);
+        auto rl = reference.lower_bound(lo), ru = reference.upper_bound(hi);
+        correct = correct && (rl == reference.end() ? lower == tree.end() : *lower == *rl);
+        correct = correct && (ru == reference.end() ? upper == tree.end() : *upper == *ru);
+        std::size_t visited = 0;
+        tree.range(lo, hi, [&](const typename Tree::key_type &key){ correct = correct && !tree.key_comp()(key, lo) && !tree.key_comp()(hi, key); ++visited; });
+        correct = correct && visited == static_cast<std::size_t>(std::distance(rl, ru));
+        correct = correct && tree.contains(lo) == (reference.count(lo) != 0);
+    }
+    while (!tree.empty()){
+        tree.remove(tree.minimum());
+        reference.erase(reference.begin());
+    }
+    return correct && tree.validate() && tree.height() == 0;
+}
+
+// api_test: 与RedBlackTree对应的操作
+void api_test()
+{
+    BPlusTree<int> tree;
+    for (int key : {15, 6, 7, 3, 4, 2, 13, 9, 18, 17, 20})
+        tree.insert(key);
+    bool correct = tree.validate() && *tree.minimum() == 2 && *tree.maximum() == 20 && tree.size() == 11;
+    correct = correct && *tree.successor(tree.find(9)) == 13 && *tree.predecessor(tree.find(9)) == 7;
+    correct = correct && tree.successor(tree.maximum()) == tree.end() && tree.predecessor(tree.minimum()) == tree.end();
+    correct = correct && tree.find(8) == tree.end() && tree.erase(13) && !tree.erase(13) && tree.size() == 10;
+    std::cout << "中序: ";
+    for (int key : tree)
+        std::cout << key << " ";
+    std::cout << "\n叶节点容量: " << BPlusTree<int>::leaf_capacity << ", 内部节点容量: " << BPlusTree<int>::inner_capacity
+              << "\n基本操作: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// build_test: 由有序序列建立的树满足B+树的性质, 之后可以继续插入与删除
+void build_test()
+{
+    bool correct = true;
+    for (int n : {0, 1, 2, 60, 61, 1000, 1831, 1860, 1861, 100000}){
+        std::vector<std::int64_t> keys;
+        for (int i = 0; i != n; ++i)
+            keys.push_back(i / 2 - 1000);
+        BPlusTree<std::int64_t> tree;
+        tree.build_from_sorted(keys.begin(), keys.end());
+        correct = correct && tree.validate() && std::equal(keys.begin(), keys.end(), tree.begin()) && tree.size() == keys.size();
+        for (int i = 0; i < n; i += 3)
+            correct = correct && tree.erase(i / 2 - 1000);
+        tree.insert(5);
+        correct = correct && tree.validate();
+    }
+    std::vector<int> unsorted = {1, 3, 2};
+    BPlusTree<int> tree;
+    tree.insert(7);
+    try{
+        tree.build_from_sorted(unsorted.begin(), unsorted.end());
+        correct = false;
+    }catch (const std::invalid_argument &){
+        correct = correct && tree.size() == 1;
+    }
+    std::cout << "由有序序列建立: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********b+ tree的基本操作测试********\n";
+    api_test();
+    std::cout << "********b+ tree的随机测试********\n";
+    bool correct = random_test<BPlusTree<int>>(1, 3000) && random_test<BPlusTree<std::uint32_t>>(2, 100000) &&
+                   random_test<BPlusTree<std::int64_t, std::less<std::int64_t>, 128>>(3, 500) &&
+                   random_test<BPlusTree<std::uint64_t>>(4, 20000) &&
+                   random_test<BPlusTree<double, std::less<double>, 64>>(5, 1000) &&
+                   random_test<BPlusTree<int, std::greater<int>>>(6, 2000);
+    std::cout << "随机插入与删除: " << (correct ? "正确" : "错误") << std::endl;
+    std::cout << "********b+ tree的批量建立测试********\n";
+    build_test();
+    return 0;
+}
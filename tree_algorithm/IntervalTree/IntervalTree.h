@@ -0,0 +1,151 @@
+/*************************************************************************
+	> File Name: IntervalTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时31分55秒
+ ************************************************************************/
+
+#ifndef _INTERVALTREE_H
+#define _INTERVALTREE_H
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "../RedBlackTree/PooledRedBlackTree.h"
+// Interval: 闭区间[low, high]
+template<typename T>
+struct Interval
+{
+    Interval() : low(), high() {  }
+    Interval(const T &l, const T &h) : low(l), high(h) {  }
+    bool overlaps(const T &lo, const T &hi) const { return !(hi < low) && !(high < lo); }
+    bool operator==(const Interval &other) const { return !(low < other.low) && !(other.low < low) &&
+                                                          !(high < other.high) && !(other.high < high); }
+    T low;
+    T high;
+};
+// IntervalLess: 区间按低端点排序, 低端点相同时按高端点排序
+template<typename T>
+struct IntervalLess
+{
+    bool operator()(const Interval<T> &a, const Interval<T> &b) const
+    {
+        return a.low < b.low || (!(b.low < a.low) && a.high < b.high);
+    }
+};
+// MaxEndpoint: 区间树的扩张数据, 每个节点保存以它为根的子树中所有区间的最大高端点(哨兵为空子树)
+template<typename T>
+struct MaxEndpoint
+{
+    static const bool enabled = true;
+    struct Data
+    {
+        Data() : max(), empty(true) {  }
+        T max;
+        bool empty;
+    };
+    static void update(Data &node, const Interval<T> &key, const Data &left, const Data &right)
+    {
+        node.max = key.high;
+        if (!left.empty && node.max < left.max)
+            node.max = left.max;
+        if (!right.empty && node.max < right.max)
+            node.max = right.max;
+        node.empty = false;
+    }
+};
+
+// IntervalTree: 区间树 算法导论第14.3节
+/*
+ * 以区间的低端点为关键字的红黑树(PooledRedBlackTree), 每个节点x扩张x.max = 子树中区间高端点的最大值,
+ * x.max只依赖x的区间与两个子节点的max, 旋转与插入删除时由PooledRedBlackTree维护, 插入删除仍为O(logn).
+ * 节点在连续的节点池中, 节点下标在删除之前不变, 可以作为调用者保存附加数据(例如IP段对应的路由)的数组下标.
+ *
+ * 查询(都是闭区间, [a, b]与[c, d]重叠当且仅当a <= d且c <= b):
+ *      --overlap_search(lo, hi): 任意一个与[lo, hi]重叠的区间(书中的INTERVAL-SEARCH), O(logn).
+ *        若左子树的max >= lo, 左子树中要么有重叠的区间, 要么所有区间的低端点都大于hi(于是右子树中也没有), 所以只需走一条路径;
+ *      --overlaps(lo, hi, f): 对每个重叠的区间调用f(node), 按低端点递增的次序, O(logn + k)(k为结果个数).
+ *        子树的max < lo时整棵子树都不重叠; 节点的低端点 > hi时它和右子树都不重叠, 其余访问的节点都在结果的路径上.
+ *        用显式的栈遍历(红黑树的高度不超过2log(n + 1)), 不递归;
+ *      --build_from_sorted: 由按IntervalLess有序的区间在O(n)时间内建立(见PooledRedBlackTree).
+ *
+ */
+template<typename T>
+class IntervalTree : public PooledRedBlackTree<Interval<T>, IntervalLess<T>, MaxEndpoint<T>>
+{
+    typedef PooledRedBlackTree<Interval<T>, IntervalLess<T>, MaxEndpoint<T>> Base;
+public:
+    typedef typename Base::Index Index;
+    typedef Interval<T> IntervalType;
+    //***************************成员函数*********************************
+    // insert: 插入区间, low > high时抛出std::invalid_argument
+    Index insert(const IntervalType &interval)
+    {
+        if (interval.high < interval.low)
+            throw std::invalid_argument("IntervalTree error: 区间的低端点大于高端点");
+        return Base::insert(interval);
+    }
+    Index insert(const T &low, const T &high) { return insert(IntervalType(low, high)); }
+    const IntervalType& interval(Index node) const { return this->key(node); }
+    // max_endpoint: 以node为根的子树中区间的最大高端点
+    const T& max_endpoint(Index node) const { return this->augment(node).max; }
+
+    Index overlap_search(const T &lo, const T &hi) const;   // 任意一个重叠的区间, 没有时为nil
+    template<typename Function>
+    void overlaps(const T &lo, const T &hi, Function f) const;  // 对所有重叠的区间调用f(node)
+    // overlapping: 所有重叠的区间的节点
+    std::vector<Index> overlapping(const T &lo, const T &hi) const
+    {
+        std::vector<Index> result;
+        overlaps(lo, hi, [&result](Index node){ result.push_back(node); });
+        return result;
+    }
+};
+//**********************************成员函数******************************
+// overlap_search: 查找一个与[lo, hi]重叠的区间
+/*
+ * 算法基本思想(INTERVAL-SEARCH): 从根开始, 当前区间不重叠时, 左子树非空且x.left.max >= lo则向左, 否则向右.
+ * 时间复杂度为O(logn).
+*/
+template<typename T>
+typename IntervalTree<T>::Index IntervalTree<T>::overlap_search(const T &lo, const T &hi) const
+{
+    Index x = this->root();
+    while (x != Base::nil && !interval(x).overlaps(lo, hi)){
+        Index l = this->left(x);
+        if (l != Base::nil && !(max_endpoint(l) < lo))
+            x = l;
+        else
+            x = this->right(x);
+    }
+    return x;
+}
+// overlaps: 枚举所有与[lo, hi]重叠的区间
+/*
+ * \parameter f: 对每个重叠的区间调用f(node)(node为节点下标), 按区间的次序.
+ *
+ * 中序遍历, 剪去两种不可能重叠的部分: max < lo的子树; 低端点 > hi的节点的右子树(以及它本身之后的所有节点).
+*/
+template<typename T>
+template<typename Function>
+void IntervalTree<T>::overlaps(const T &lo, const T &hi, Function f) const
+{
+    Index stack[128];   // 红黑树的高度不超过2log(n + 1) < 128
+    std::size_t top = 0;
+    Index x = this->root();
+    for (;;){
+        // 沿左子树下降, 只进入可能有重叠的子树
+        while (x != Base::nil && !(max_endpoint(x) < lo)){
+            stack[top++] = x;
+            x = this->left(x);
+        }
+        if (top == 0)
+            return;
+        x = stack[--top];
+        if (hi < interval(x).low)
+            return;     // 之后的节点低端点都不小于它
+        if (!(interval(x).high < lo))
+            f(x);
+        x = this->right(x);
+    }
+}
+#endif
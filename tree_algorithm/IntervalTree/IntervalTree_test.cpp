@@ -0,0 +1,95 @@
+/*************************************************************************
+	> File Name: IntervalTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时34分38秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "IntervalTree.h"
+typedef IntervalTree<int> IntTree;
+
+// validMax: 检查每个节点的max, 返回子树的最大高端点(空子树返回-1, 不正确时返回-2)
+int validMax(const IntTree &tree, IntTree::Index node)
+{
+    if (node == IntTree::nil)
+        return -1;
+    int l = validMax(tree, tree.left(node)), r = validMax(tree, tree.right(node));
+    int expected = std::max(tree.interval(node).high, std::max(l, r));
+    return (l == -2 || r == -2 || tree.max_endpoint(node) != expected) ? -2 : expected;
+}
+
+// clrs_test: 算法导论图14-4中的区间
+void clrs_test()
+{
+    IntTree tree;
+    const int intervals[][2] = {{16, 21}, {8, 9}, {25, 30}, {5, 8}, {15, 23}, {17, 19}, {26, 26}, {0, 3}, {6, 10}, {19, 20}};
+    for (auto &i : intervals)
+        tree.insert(i[0], i[1]);
+    IntTree::Index found = tree.overlap_search(22, 25);
+    bool correct = found != IntTree::nil && tree.interval(found) == Interval<int>(15, 23);
+    correct = correct && tree.overlap_search(11, 14) == IntTree::nil && tree.max_endpoint(tree.root()) == 30;
+    std::vector<IntTree::Index> all = tree.overlapping(8, 16);
+    std::cout << "与[8, 16]重叠的区间:";
+    for (auto node : all)
+        std::cout << " [" << tree.interval(node).low << ", " << tree.interval(node).high << "]";
+    correct = correct && all.size() == 5 && validMax(tree, tree.root()) == 30;
+    try{
+        tree.insert(3, 2);
+        correct = false;
+    }catch (const std::invalid_argument &){
+    }
+    std::cout << "\n区间查询: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// random_test: 随机插入删除(以及由有序区间建立)以后, 查询结果与逐个比较的结果相同
+void random_test()
+{
+    std::srand(5);
+    std::vector<Interval<int>> reference;
+    for (int i = 0; i != 2000; ++i){
+        int low = std::rand() % 100000;
+        reference.push_back(Interval<int>(low, low + std::rand() % 1000));
+    }
+    std::sort(reference.begin(), reference.end(), IntervalLess<int>());
+    IntTree tree;
+    tree.build_from_sorted(reference.begin(), reference.end());
+    bool correct = validMax(tree, tree.root()) >= 0;
+    for (int i = 0; i != 3000; ++i){
+        if (std::rand() % 2 == 0){
+            int low = std::rand() % 100000;
+            Interval<int> interval(low, low + std::rand() % 1000);
+            tree.insert(interval);
+            reference.insert(std::upper_bound(reference.begin(), reference.end(), interval, IntervalLess<int>()), interval);
+        }else{
+            std::size_t j = std::rand() % reference.size();
+            correct = tree.erase(reference[j]) && correct;
+            reference.erase(reference.begin() + j);
+        }
+    }
+    correct = correct && validMax(tree, tree.root()) >= 0 && tree.size() == reference.size();
+    for (int q = 0; q != 500; ++q){
+        int lo = std::rand() % 101000, hi = lo + std::rand() % 300;
+        std::vector<Interval<int>> expected, got;
+        for (auto &interval : reference)
+            if (interval.overlaps(lo, hi))
+                expected.push_back(interval);
+        tree.overlaps(lo, hi, [&](IntTree::Index node){ got.push_back(tree.interval(node)); });
+        IntTree::Index any = tree.overlap_search(lo, hi);
+        correct = correct && got == expected && (any == IntTree::nil) == expected.empty();
+        correct = correct && (any == IntTree::nil || tree.interval(any).overlaps(lo, hi));
+    }
+    std::cout << "随机插入删除与查询: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********interval tree的查询测试********\n";
+    clrs_test();
+    std::cout << "********interval tree的随机测试********\n";
+    random_test();
+    return 0;
+}
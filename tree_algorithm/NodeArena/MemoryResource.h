@@ -0,0 +1,211 @@
+/*************************************************************************
+	> File Name: MemoryResource.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 11时09分24秒
+ ************************************************************************/
+
+#ifndef _MEMORYRESOURCE_H
+#define _MEMORYRESOURCE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+// 可以在运行时选择的内存来源, 与C++17的std::pmr::memory_resource/polymorphic_allocator对应(本仓库基于C++11)
+/*
+ * MemoryResource: 内存来源的接口, allocate(bytes, align)与deallocate(p, bytes, align)是非虚函数, 转发给派生类的
+ * doAllocate/doDeallocate. 它的两个成员函数与InlineStack的Arena, NodeArena相同, 所以MemoryResource也可以直接
+ * 作为InlineStack<T, N, MemoryResource>的arena.
+ *      --newDeleteResource(): 全局的operator new/operator delete, 所有容器与算法默认的来源;
+ *      --MonotonicBufferResource: 单调增长的缓冲区, 只分配不回收. 按顺序从当前块中切出内存(只移动一个指针),
+ *        块用完时从上游分配一块更大的(每次加倍); deallocate什么也不做, release()或析构时把所有的块一次还给上游.
+ *        典型的用法是每个请求一个(放在栈上, 可以先用栈上的数组作为第一块), 请求内的容器与临时数组都从它分配,
+ *        请求结束时整体释放, 不经过malloc的锁. 不是线程安全的, 每个线程使用自己的对象.
+ *
+ * ResourceAllocator<T>: 从MemoryResource分配的分配器(对应std::pmr::polymorphic_allocator<T>), 可以作为std::vector,
+ * std::list, std::allocate_shared以及本仓库各个容器的Alloc模板参数. 只保存一个MemoryResource指针, 默认构造或者
+ * 由nullptr构造时使用newDeleteResource(). 容器拷贝时分配器随之拷贝(新容器使用同一个来源);
+ * 来源必须比所有从它分配的容器活得长.
+ *
+ */
+class MemoryResource
+{
+public:
+    virtual ~MemoryResource() {  }
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+    {
+        return doAllocate(bytes, align);
+    }
+    void deallocate(void *p, std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+    {
+        doDeallocate(p, bytes, align);
+    }
+protected:
+    virtual void* doAllocate(std::size_t bytes, std::size_t align) = 0;
+    virtual void doDeallocate(void *p, std::size_t bytes, std::size_t align) = 0;
+};
+
+// NewDeleteResource: 全局的operator new, 对齐要求超过max_align_t时多分配一些, 在返回地址之前保存原始地址
+class NewDeleteResource : public MemoryResource
+{
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t align)
+    {
+        if (align <= alignof(std::max_align_t))
+            return ::operator new(bytes);
+        char *raw = static_cast<char *>(::operator new(bytes + align + sizeof(void *)));
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void *));
+        char *aligned = reinterpret_cast<char *>((address + align - 1) & ~(std::uintptr_t(align) - 1));
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return aligned;
+    }
+    void doDeallocate(void *p, std::size_t, std::size_t align)
+    {
+        if (align <= alignof(std::max_align_t))
+            ::operator delete(p);
+        else
+            ::operator delete(static_cast<void **>(p)[-1]);
+    }
+};
+
+inline MemoryResource* newDeleteResource()
+{
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+const std::size_t monotonic_first_chunk = 1024;    // 没有给出初始大小时第一块的字节数
+
+// MonotonicBufferResource: 单调增长的缓冲区, 只有release()或析构时才把内存还给上游
+class MonotonicBufferResource : public MemoryResource
+{
+public:
+    //****************************构造函数*******************************
+    // upstream: 块的来源; initialSize: 第一块的字节数
+    explicit MonotonicBufferResource(MemoryResource *upstream = newDeleteResource())
+        : up(upstream), initialBuffer(nullptr), initialSize(0), current(nullptr), left(0),
+          nextChunk(monotonic_first_chunk), chunks(nullptr), used(0) {  }
+    explicit MonotonicBufferResource(std::size_t initial, MemoryResource *upstream = newDeleteResource())
+        : up(upstream), initialBuffer(nullptr), initialSize(0), current(nullptr), left(0),
+          nextChunk(std::max<std::size_t>(initial, 64)), chunks(nullptr), used(0) {  }
+    // buffer: 调用者提供的第一块(例如栈上的数组), 用完以后再从上游分配, release()以后重新从它开始
+    MonotonicBufferResource(void *buffer, std::size_t size, MemoryResource *upstream = newDeleteResource())
+        : up(upstream), initialBuffer(static_cast<char *>(buffer)), initialSize(size), current(initialBuffer),
+          left(size), nextChunk(std::max<std::size_t>(size * 2, monotonic_first_chunk)), chunks(nullptr), used(0) {  }
+    MonotonicBufferResource(const MonotonicBufferResource &) = delete;
+    MonotonicBufferResource& operator=(const MonotonicBufferResource &) = delete;
+    ~MonotonicBufferResource() { release(); }
+    //****************************成员函数*******************************
+    // release: 所有的块还给上游(块的个数为O(log(总字节数))), 之后的分配重新从初始缓冲区开始
+    void release()
+    {
+        while (chunks){
+            Chunk *prev = chunks->prev;
+            up->deallocate(chunks, chunks->bytes, alignof(Chunk));
+            chunks = prev;
+        }
+        current = initialBuffer;
+        left = initialSize;
+        used = 0;
+    }
+    MemoryResource* upstream() const { return up; }
+    // bytesAllocated: release()以后分配出去的字节数(不包括对齐的填充)
+    std::size_t bytesAllocated() const { return used; }
+    std::size_t chunkCount() const
+    {
+        std::size_t n = 0;
+        for (Chunk *c = chunks; c; c = c->prev)
+            ++n;
+        return n;
+    }
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t align)
+    {
+        void *p = carve(bytes, align);
+        if (!p){
+            grow(bytes, align);
+            p = carve(bytes, align);
+        }
+        used += bytes;
+        return p;
+    }
+    void doDeallocate(void *, std::size_t, std::size_t) {  }
+private:
+    // Chunk: 从上游分配的块的头部, 块连成单链表
+    struct Chunk
+    {
+        Chunk *prev;
+        std::size_t bytes;
+    };
+    // carve: 从当前块中切出bytes字节, 不够时返回nullptr
+    void* carve(std::size_t bytes, std::size_t align)
+    {
+        if (!current)
+            return nullptr;
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(current);
+        std::size_t padding = static_cast<std::size_t>(((address + align - 1) & ~(std::uintptr_t(align) - 1)) - address);
+        if (padding > left || bytes > left - padding)
+            return nullptr;
+        char *p = current + padding;
+        current = p + bytes;
+        left -= padding + bytes;
+        return p;
+    }
+    void grow(std::size_t bytes, std::size_t align)
+    {
+        std::size_t needed = sizeof(Chunk) + bytes + align;
+        if (needed < bytes)
+            throw std::bad_alloc();
+        std::size_t size = std::max(nextChunk, needed);
+        Chunk *c = static_cast<Chunk *>(up->allocate(size, alignof(Chunk)));
+        c->prev = chunks;
+        c->bytes = size;
+        chunks = c;
+        current = reinterpret_cast<char *>(c + 1);
+        left = size - sizeof(Chunk);
+        if (nextChunk <= std::numeric_limits<std::size_t>::max() / 2)
+            nextChunk *= 2;
+    }
+    MemoryResource *up;
+    char *initialBuffer;        // 调用者提供的第一块, 没有时为nullptr
+    std::size_t initialSize;
+    char *current;              // 当前块中下一个未用的字节
+    std::size_t left;           // 当前块中剩余的字节数
+    std::size_t nextChunk;      // 下一次从上游分配的字节数
+    Chunk *chunks;              // 最后分配的块
+    std::size_t used;           // 分配出去的字节数
+};
+
+// ResourceAllocator: 从MemoryResource分配的分配器, 分配器相等当且仅当来源相同
+template<typename T>
+class ResourceAllocator
+{
+public:
+    typedef T value_type;
+    ResourceAllocator() : res(newDeleteResource()) {  }
+    ResourceAllocator(MemoryResource *r) : res(r ? r : newDeleteResource()) {  }
+    template<typename U>
+    ResourceAllocator(const ResourceAllocator<U> &other) : res(other.resource()) {  }
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(res->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *p, std::size_t n) { res->deallocate(p, n * sizeof(T), alignof(T)); }
+    MemoryResource* resource() const { return res; }
+    template<typename U>
+    bool operator==(const ResourceAllocator<U> &other) const { return res == other.resource(); }
+    template<typename U>
+    bool operator!=(const ResourceAllocator<U> &other) const { return res != other.resource(); }
+private:
+    MemoryResource *res;
+};
+
+// ResourceVector: 从MemoryResource分配的std::vector, 算法的临时数组使用它(arena为nullptr时来自newDeleteResource())
+template<typename T>
+using ResourceVector = std::vector<T, ResourceAllocator<T>>;
+#endif
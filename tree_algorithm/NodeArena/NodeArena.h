@@ -0,0 +1,122 @@
+/*************************************************************************
+	> File Name: NodeArena.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时35分55秒
+ ************************************************************************/
+
+#ifndef _NODEARENA_H
+#define _NODEARENA_H
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <vector>
+// NodeArena: 为std::shared_ptr的树节点批量分配内存
+/*
+ * BinarySearchTree与RedBlackTree的节点是std::shared_ptr, 每个节点单独make_shared一次(一次全局的operator new).
+ * 批量建树时用std::allocate_shared<NodeType>(ArenaAllocator<NodeType>(arena), key): 控制块与节点一起从arena的
+ * 大块内存中按顺序切出, 按中序创建的节点在内存中也是连续的.
+ *
+ *      --第一次分配确定槽的大小(allocate_shared只分配一种类型: 控制块加节点), 第一块能放expected个槽, 之后每块加倍;
+ *      --节点释放时(最后一个shared_ptr与weak_ptr都消失)槽放入空闲链表重用, 大块内存在最后一个节点(以及arena
+ *        的其它shared_ptr)释放以后才归还: 每个控制块中的分配器副本都持有arena的shared_ptr;
+ *      --不是线程安全的, 与树本身一样只能由一个线程修改(包括释放节点).
+ *
+ */
+class NodeArena
+{
+public:
+    explicit NodeArena(std::size_t expected = 0)
+        : slot(0), alignment(0), next(nullptr), remaining(0), chunkSlots(std::max<std::size_t>(expected, 16)),
+          freeList(nullptr) {  }
+    NodeArena(const NodeArena &) = delete;
+    NodeArena& operator=(const NodeArena &) = delete;
+
+    // allocate: 分配bytes字节, 大于槽或对齐要求更高时改用operator new
+    void* allocate(std::size_t bytes, std::size_t align)
+    {
+        if (slot == 0){
+            alignment = std::max(align, alignof(void *));
+            slot = (std::max(bytes, sizeof(void *)) + alignment - 1) / alignment * alignment;
+        }
+        if (bytes > slot || align > alignment)
+            return ::operator new(bytes);
+        if (freeList){
+            void *p = freeList;
+            freeList = *static_cast<void **>(p);
+            return p;
+        }
+        if (remaining == 0){
+            std::size_t words = (chunkSlots * slot + sizeof(Word) - 1) / sizeof(Word);
+            chunks.emplace_back(new Word[words]);
+            next = reinterpret_cast<char *>(chunks.back().get());
+            remaining = chunkSlots;
+            chunkSlots *= 2;
+        }
+        void *p = next;
+        next += slot;
+        --remaining;
+        return p;
+    }
+    void deallocate(void *p, std::size_t bytes, std::size_t align)
+    {
+        if (bytes > slot || align > alignment){
+            ::operator delete(p);
+            return;
+        }
+        *static_cast<void **>(p) = freeList;
+        freeList = p;
+    }
+    std::size_t chunkCount() const { return chunks.size(); }
+    std::size_t slotSize() const { return slot; }
+private:
+    typedef std::max_align_t Word;
+    std::vector<std::unique_ptr<Word[]>> chunks;
+    std::size_t slot;           // 槽的字节数(0表示还没有分配过)
+    std::size_t alignment;      // 槽的对齐
+    char *next;                 // 当前块中下一个未用的槽
+    std::size_t remaining;      // 当前块中未用的槽数
+    std::size_t chunkSlots;     // 下一块的槽数
+    void *freeList;             // 释放的槽(链接存放在槽中)
+};
+
+// ArenaAllocator: 从NodeArena分配的分配器, 给std::allocate_shared使用
+/*
+ * 默认构造时创建一个新的NodeArena: 以ArenaAllocator为模板参数的链表, 默认构造时就有自己的节点池.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    ArenaAllocator() : arena(std::make_shared<NodeArena>()) {  }
+    explicit ArenaAllocator(const std::shared_ptr<NodeArena> &a) : arena(a) {  }
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {  }
+    T* allocate(std::size_t n) { return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *p, std::size_t n) { arena->deallocate(p, n * sizeof(T), alignof(T)); }
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const { return arena == other.arena; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return arena != other.arena; }
+
+    std::shared_ptr<NodeArena> arena;
+};
+
+// arenaNodes: 为[first, last)中的每个关键字按顺序创建一个节点, 节点来自同一个NodeArena
+template<typename NodeType, typename Iterator>
+std::vector<std::shared_ptr<NodeType>> arenaNodes(Iterator first, Iterator last)
+{
+    std::vector<std::shared_ptr<NodeType>> nodes;
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    if (n == 0)
+        return nodes;
+    nodes.reserve(n);
+    ArenaAllocator<NodeType> allocator(std::make_shared<NodeArena>(n));
+    for (; first != last; ++first)
+        nodes.push_back(std::allocate_shared<NodeType>(allocator, *first));
+    return nodes;
+}
+#endif
@@ -0,0 +1,109 @@
+/*************************************************************************
+	> File Name: NodeArena_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时38分38秒
+ ************************************************************************/
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "NodeArena.h"
+#include "MemoryResource.h"
+#include "../RedBlackTreeNode/RedBlackTreeNode.h"
+typedef RedBlackTreeNode<int> Node;
+
+// contiguous_test: arenaNodes创建的节点在同一块内存中按顺序等距排列
+void contiguous_test()
+{
+    std::vector<int> keys;
+    for (int i = 0; i != 1000; ++i)
+        keys.push_back(i);
+    auto nodes = arenaNodes<Node>(keys.begin(), keys.end());
+    bool correct = nodes.size() == 1000;
+    std::ptrdiff_t step = reinterpret_cast<char *>(nodes[1].get()) - reinterpret_cast<char *>(nodes[0].get());
+    for (std::size_t i = 1; i != nodes.size(); ++i){
+        correct = correct && nodes[i]->key == static_cast<int>(i) &&
+                  reinterpret_cast<char *>(nodes[i].get()) - reinterpret_cast<char *>(nodes[i - 1].get()) == step;
+    }
+    correct = correct && step > 0 && static_cast<std::size_t>(step) >= sizeof(Node);
+    nodes.clear();
+    std::cout << "连续分配: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// reuse_test: 释放的槽被重用; arena在最后一个节点(包括weak_ptr)释放以后才释放
+void reuse_test()
+{
+    auto arena = std::make_shared<NodeArena>(4);
+    std::weak_ptr<NodeArena> watch = arena;
+    ArenaAllocator<Node> allocator(arena);
+    arena.reset();
+    auto a = std::allocate_shared<Node>(allocator, 1);
+    auto b = std::allocate_shared<Node>(allocator, 2);
+    Node *address = a.get();
+    std::weak_ptr<Node> weak = a;
+    a.reset();
+    // 还有一个weak_ptr, 控制块没有释放, 槽不能重用
+    auto c = std::allocate_shared<Node>(allocator, 3);
+    bool correct = c.get() != address;
+    weak.reset();
+    auto d = std::allocate_shared<Node>(allocator, 4);
+    correct = correct && d.get() == address && watch.lock()->chunkCount() == 1;
+    for (int i = 0; i != 10; ++i)
+        std::allocate_shared<Node>(allocator, i);   // 临时的节点立即释放, 一直重用同一个槽
+    correct = correct && watch.lock()->chunkCount() == 1;
+    allocator.arena.reset();
+    b.reset();
+    c.reset();
+    correct = correct && !watch.expired();
+    d.reset();
+    correct = correct && watch.expired();
+    std::cout << "槽的重用与arena的释放: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// monotonic_test: 先用调用者的缓冲区, 用完以后块加倍增长; 对齐要求被满足; release()以后重新从缓冲区开始
+void monotonic_test()
+{
+    alignas(std::max_align_t) char buffer[256];
+    MonotonicBufferResource arena(buffer, sizeof(buffer));
+    void *first = arena.allocate(100, 8);
+    bool correct = first == buffer && arena.chunkCount() == 0;
+    void *aligned = arena.allocate(40, 64);
+    correct = correct && reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0;
+    for (int i = 0; i != 100; ++i)
+        arena.allocate(1000, 16);
+    correct = correct && arena.bytesAllocated() == 100 + 40 + 100000 && arena.chunkCount() < 10;
+    arena.release();
+    correct = correct && arena.chunkCount() == 0 && arena.bytesAllocated() == 0 && arena.allocate(8) == buffer;
+    void *wide = newDeleteResource()->allocate(100, 128);
+    correct = correct && reinterpret_cast<std::uintptr_t>(wide) % 128 == 0;
+    newDeleteResource()->deallocate(wide, 100, 128);
+    std::cout << "单调缓冲区: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// resource_allocator_test: 树的节点用allocate_shared从MemoryResource创建, 容器与节点使用同一个来源
+void resource_allocator_test()
+{
+    MonotonicBufferResource arena;
+    ResourceAllocator<Node> allocator(&arena);
+    ResourceVector<std::shared_ptr<Node>> nodes(allocator);
+    for (int i = 0; i != 1000; ++i)
+        nodes.push_back(std::allocate_shared<Node>(allocator, i));
+    bool correct = nodes.size() == 1000 && nodes[999]->key == 999 && arena.bytesAllocated() >= 1000 * sizeof(Node);
+    correct = correct && allocator == ResourceAllocator<int>(&arena) && ResourceAllocator<int>() != allocator;
+    correct = correct && ResourceAllocator<int>(nullptr).resource() == newDeleteResource();
+    nodes.clear();
+    std::cout << "ResourceAllocator: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********node arena的连续分配测试********\n";
+    contiguous_test();
+    std::cout << "********node arena的重用测试********\n";
+    reuse_test();
+    std::cout << "********单调缓冲区测试********\n";
+    monotonic_test();
+    std::cout << "********ResourceAllocator测试********\n";
+    resource_allocator_test();
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*************************************************************************
+	> File Name: OrderStatisticTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时30分09秒
+ ************************************************************************/
+
+#ifndef _ORDERSTATISTICTREE_H
+#define _ORDERSTATISTICTREE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "../RedBlackTree/PooledRedBlackTree.h"
+// SubtreeSize: 顺序统计树的扩张数据, 每个节点保存以它为根的子树的节点数(哨兵为0)
+struct SubtreeSize
+{
+    static const bool enabled = true;
+    struct Data
+    {
+        Data() : size(0) {  }
+        std::uint32_t size;
+    };
+    template<typename Key>
+    static void update(Data &node, const Key &, const Data &left, const Data &right)
+    {
+        node.size = left.size + right.size + 1;
+    }
+};
+
+// OrderStatisticTree: 顺序统计树 算法导论第14章
+/*
+ * 在PooledRedBlackTree的每个节点上保存子树大小x.size = x.left.size + x.right.size + 1:
+ *      --插入时新节点到根的路径上的节点, 删除时结构变化的位置到根的路径上的节点重新计算size;
+ *      --left_rotate/right_rotate只改变被旋转的两个节点的子树, 旋转以后重新计算这两个节点,
+ *        所以insert_fixup与delete_fixup中的旋转也保持size正确. 颜色的改变不影响size.
+ * 维护size不改变插入与删除的O(logn)复杂度.
+ *
+ * 查询都只沿一条从根到叶(或从节点到根)的路径, 为O(logn), 不需要像RedBlackTree那样调用k次successor():
+ *      --select(i): 第i小的节点(i从1开始, 与书中的OS-SELECT相同);
+ *      --rank(node): node在中序遍历中的位置(从1开始, 与书中的OS-RANK相同; 关键字相同时按树中的次序);
+ *      --count_less(key), count_not_greater(key): 关键字小于(不大于)key的节点数;
+ *      --count_range(lo, hi): 关键字在[lo, hi]中的节点数.
+ *
+ */
+template<typename Key, typename Compare = std::less<Key>>
+class OrderStatisticTree : public PooledRedBlackTree<Key, Compare, SubtreeSize>
+{
+    typedef PooledRedBlackTree<Key, Compare, SubtreeSize> Base;
+public:
+    typedef typename Base::Index Index;
+    //***************************构造函数*********************************
+    explicit OrderStatisticTree(const Compare &comp = Compare()) : Base(comp) {  }
+    //***************************成员函数*********************************
+    std::size_t subtree_size(Index node) const { return this->augment(node).size; }
+    Index select(std::size_t i) const;          // 第i小的节点, i不在[1, size()]中时返回nil
+    std::size_t rank(Index node) const;         // node是第几小的节点
+    std::size_t count_less(const Key &key) const;           // 关键字小于key的节点数
+    std::size_t count_not_greater(const Key &key) const;    // 关键字不大于key的节点数
+    // count_range: 关键字在[lo, hi]中的节点数, lo大于hi时为0
+    std::size_t count_range(const Key &lo, const Key &hi) const
+    {
+        return this->key_comp()(hi, lo) ? 0 : count_not_greater(hi) - count_less(lo);
+    }
+};
+//**********************************成员函数******************************
+// select: 查找第i小的节点
+/*
+ * \parameter i: 从1开始的序号;
+ * \return 第i小的节点, 不存在时为nil.
+ *
+ * 算法基本思想(OS-SELECT): 当前节点x的左子树有r - 1个节点, x是子树中第r小的节点; i等于r时x就是结果,
+ *      i小于r时在左子树中找第i小的节点, 否则在右子树中找第i - r小的节点. 时间复杂度为O(logn).
+*/
+template<typename Key, typename Compare>
+typename OrderStatisticTree<Key, Compare>::Index OrderStatisticTree<Key, Compare>::select(std::size_t i) const
+{
+    if (i == 0 || i > this->size())
+        return Base::nil;
+    Index x = this->root();
+    for (;;){
+        std::size_t r = subtree_size(this->left(x)) + 1;
+        if (i == r)
+            return x;
+        if (i < r)
+            x = this->left(x);
+        else{
+            x = this->right(x);
+            i -= r;
+        }
+    }
+}
+// rank: 节点的秩
+/*
+ * \parameter node: 树中的节点;
+ * \return node在中序遍历中的位置(从1开始).
+ *
+ * 算法基本思想(OS-RANK): 从node向上走到根, 每当当前节点是右孩子时, 父节点与父节点的左子树都排在node之前.
+ *      时间复杂度为O(logn).
+*/
+template<typename Key, typename Compare>
+std::size_t OrderStatisticTree<Key, Compare>::rank(Index node) const
+{
+    std::size_t r = subtree_size(this->left(node)) + 1;
+    for (Index y = node; y != this->root(); y = this->parent(y)){
+        Index p = this->parent(y);
+        if (y == this->right(p))
+            r += subtree_size(this->left(p)) + 1;
+    }
+    return r;
+}
+template<typename Key, typename Compare>
+std::size_t OrderStatisticTree<Key, Compare>::count_less(const Key &key) const
+{
+    std::size_t result = 0;
+    for (Index x = this->root(); x != Base::nil; ){
+        if (this->key_comp()(this->key(x), key)){
+            result += subtree_size(this->left(x)) + 1;
+            x = this->right(x);
+        }else
+            x = this->left(x);
+    }
+    return result;
+}
+template<typename Key, typename Compare>
+std::size_t OrderStatisticTree<Key, Compare>::count_not_greater(const Key &key) const
+{
+    std::size_t result = 0;
+    for (Index x = this->root(); x != Base::nil; ){
+        if (!this->key_comp()(key, this->key(x))){
+            result += subtree_size(this->left(x)) + 1;
+            x = this->right(x);
+        }else
+            x = this->left(x);
+    }
+    return result;
+}
+#endif
@@ -0,0 +1,86 @@
+/*************************************************************************
+	> File Name: OrderStatisticTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时32分52秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "OrderStatisticTree.h"
+typedef OrderStatisticTree<int> IntTree;
+
+// sizes: 检查每个节点的子树大小, 返回子树的节点数(不正确时返回-1)
+int sizes(const IntTree &tree, IntTree::Index node)
+{
+    if (node == IntTree::nil)
+        return tree.subtree_size(node) == 0 ? 0 : -1;
+    int l = sizes(tree, tree.left(node)), r = sizes(tree, tree.right(node));
+    if (l < 0 || r < 0 || tree.subtree_size(node) != static_cast<std::size_t>(l + r + 1))
+        return -1;
+    return l + r + 1;
+}
+
+// leaderboard_test: 算法导论图14-1中的关键字
+void leaderboard_test()
+{
+    IntTree tree;
+    const int keys[] = {26, 17, 41, 14, 21, 30, 47, 10, 16, 19, 21, 28, 38, 7, 12, 14, 20, 35, 39, 3};
+    for (int key : keys)
+        tree.insert(key);
+    bool correct = tree.key(tree.select(1)) == 3 && tree.key(tree.select(17)) == 38 && tree.select(21) == IntTree::nil;
+    correct = correct && tree.rank(tree.find(38)) == 17 && tree.rank(tree.find(3)) == 1;
+    correct = correct && tree.count_range(14, 21) == 8 && tree.count_range(22, 25) == 0 && tree.count_range(30, 1) == 0;
+    std::cout << "第17小的关键字: " << tree.key(tree.select(17)) << ", [14, 21]中的关键字个数: "
+              << tree.count_range(14, 21) << "\n顺序统计: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// random_test: 随机插入与删除以后, select/rank/count_range与有序数组的结果相同
+void random_test()
+{
+    IntTree tree;
+    std::vector<int> reference;
+    std::srand(11);
+    bool correct = true;
+    for (int i = 0; i != 20000; ++i){
+        int key = std::rand() % 5000;
+        if (std::rand() % 3 != 0){
+            tree.insert(key);
+            reference.insert(std::upper_bound(reference.begin(), reference.end(), key), key);
+        }else if (tree.erase(key))
+            reference.erase(std::lower_bound(reference.begin(), reference.end(), key));
+        if (i % 1000 == 0)
+            correct = correct && sizes(tree, tree.root()) == static_cast<int>(reference.size());
+    }
+    for (std::size_t i = 1; i <= reference.size(); i += 7){
+        IntTree::Index node = tree.select(i);
+        correct = correct && tree.key(node) == reference[i - 1] && tree.rank(node) == i;
+    }
+    for (int j = 0; j != 200; ++j){
+        int lo = std::rand() % 5000, hi = lo + std::rand() % 500;
+        std::size_t expected = std::upper_bound(reference.begin(), reference.end(), hi) -
+                               std::lower_bound(reference.begin(), reference.end(), lo);
+        correct = correct && tree.count_range(lo, hi) == expected;
+    }
+    // insert_many重新连接所有节点, 子树大小也要重新计算
+    std::vector<int> batch;
+    for (int j = 0; j != 3000; ++j)
+        batch.push_back(std::rand() % 5000);
+    tree.insert_many(batch.begin(), batch.end());
+    reference.insert(reference.end(), batch.begin(), batch.end());
+    std::sort(reference.begin(), reference.end());
+    correct = correct && sizes(tree, tree.root()) == static_cast<int>(reference.size());
+    for (std::size_t i = 1; i <= reference.size(); i += 13)
+        correct = correct && tree.key(tree.select(i)) == reference[i - 1];
+    std::cout << "随机插入与删除: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********order statistic tree的select/rank测试********\n";
+    leaderboard_test();
+    std::cout << "********order statistic tree的随机测试********\n";
+    random_test();
+    return 0;
+}
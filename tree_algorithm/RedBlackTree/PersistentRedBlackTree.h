@@ -0,0 +1,294 @@
+/*************************************************************************
+	> File Name: PersistentRedBlackTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时50分47秒
+ ************************************************************************/
+
+#ifndef _PERSISTENTREDBLACKTREE_H
+#define _PERSISTENTREDBLACKTREE_H
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include "../RedBlackTreeNode/RedBlackTreeNode.h"
+#include "../TreeIterator/TreeIterator.h"
+#include "../../parallel_algorithm/epoch_reclamation/epochReclamation.h"
+// PersistentRedBlackNode: 持久化红黑树的节点, 发布以后不再修改
+/*
+ * 没有父节点的weak_ptr: 一个节点可能同时属于多个版本, 在不同版本中有不同的父节点.
+ * 子节点是指向const节点的shared_ptr, 没有被修改的子树在新旧版本之间共享.
+ */
+template<typename KType>
+struct PersistentRedBlackNode
+{
+    typedef KType KeyType;
+    typedef std::shared_ptr<const PersistentRedBlackNode> Pointer;
+    PersistentRedBlackNode(COLOR c, const Pointer &l, const KeyType &k, const Pointer &r)
+        : lchild(l), rchild(r), key(k), color(c) {  }
+    const Pointer lchild;
+    const Pointer rchild;
+    const KeyType key;
+    const COLOR color;
+};
+
+// PersistentRedBlackTree: 路径复制的持久化红黑树, 一个写者更新, 任意多个读者无锁地读取快照
+/*
+ * 写者从不修改已经发布的节点:
+ *      --insert沿查找路径复制节点(Okasaki的平衡方法: 黑色节点下出现两个相连的红色节点时, 改成一个红色节点
+ *        与两个黑色子节点), 只新建O(logn)个节点, 其余的子树与旧版本共享;
+ *      --erase先按关键字split, 再用join2把两部分连接起来(与RedBlackTreeJoin.h中的算法相同, 但复制而不修改
+ *        脊上的节点), 也只新建O(logn)个节点;
+ *      --新的根与大小放在一个新的版本对象中, 用一次原子的exchange发布. 写者之间用互斥锁串行.
+ * 读者调用snapshot(): 在纪元临界区中读取当前版本, 复制它的根(增加一次引用计数)以后离开临界区.
+ * 之后快照一直有效, 遍历时不加锁, 也看不到之后的更新.
+ *
+ * 回收: 被替换的版本对象交给EpochDomain, 没有读者正在读取它以后释放. 节点由shared_ptr计数, 最后一个引用它的
+ * 版本或者快照释放时, 只属于旧版本的节点被释放.
+ *
+ * 与RedBlackTree一样, 关键字用operator<比较, 允许有相等的关键字(插入时相等的关键字向右).
+ */
+template<typename KeyType>
+class PersistentRedBlackTree
+{
+public:
+    typedef PersistentRedBlackNode<KeyType> Node;
+    typedef typename Node::Pointer NodePtr;
+    // Snapshot: 某一时刻的只读版本
+    class Snapshot
+    {
+    public:
+        Snapshot(): tree_root(), count(0) {  }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        NodePtr root() const { return tree_root; }
+        bool contains(const KeyType &key) const { return find(key) != nullptr; }
+        // find: 关键字等于key的一个节点中的关键字, 没有时为nullptr(快照存在期间有效)
+        const KeyType* find(const KeyType &key) const
+        {
+            const Node *node = tree_lower_bound(tree_root.get(), key);
+            return (node && !(key < node->key)) ? &node->key : nullptr;
+        }
+        const KeyType* minimum() const
+        {
+            const Node *node = tree_root.get();
+            while (node && node->lchild)
+                node = node->lchild.get();
+            return node ? &node->key : nullptr;
+        }
+        const KeyType* maximum() const
+        {
+            const Node *node = tree_root.get();
+            while (node && node->rchild)
+                node = node->rchild.get();
+            return node ? &node->key : nullptr;
+        }
+        // 非递归的中序遍历与闭区间[lo, hi]中的遍历, 对每个关键字调用f(key)
+        template<typename Function>
+        void inorder_visit(Function f) const { visit_inorder(tree_root.get(), f); }
+        template<typename Function>
+        void range(const KeyType &lo, const KeyType &hi, Function f) const { visit_range(tree_root.get(), lo, hi, f); }
+    private:
+        friend class PersistentRedBlackTree;
+        Snapshot(const NodePtr &r, std::size_t n): tree_root(r), count(n) {  }
+        NodePtr tree_root;
+        std::size_t count;
+    };
+    //***************************构造函数*********************************
+    PersistentRedBlackTree(): current(new Version(NodePtr(), 0, 0)) {  }
+    PersistentRedBlackTree(const PersistentRedBlackTree &) = delete;
+    PersistentRedBlackTree& operator=(const PersistentRedBlackTree &) = delete;
+    // 析构时不能有其它线程正在使用这棵树(已经取得的快照仍然有效)
+    ~PersistentRedBlackTree() { delete current.load(); }
+    //***************************成员函数*********************************
+    Snapshot snapshot() const
+    {
+        EpochDomain::Guard guard(domain);
+        const Version *version = current.load(std::memory_order_acquire);
+        return Snapshot(version->root, version->size);
+    }
+    std::size_t size() const { return snapshot().size(); }
+    bool empty() const { return size() == 0; }
+
+    // insert: 插入一个关键字, O(logn)
+    void insert(const KeyType &key)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        const Version *version = current.load(std::memory_order_relaxed);
+        NodePtr root = insertInto(version->root, key);
+        int height = version->height;
+        if (root->color == RED){
+            root = recolor(root, BLACK);
+            ++height;
+        }
+        publish(new Version(root, version->size + 1, height));
+    }
+    // erase: 删除一个等于key的关键字, 不存在时返回false, O(logn)
+    bool erase(const KeyType &key)
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        const Version *version = current.load(std::memory_order_relaxed);
+        if (!Snapshot(version->root, version->size).contains(key))
+            return false;
+        NodePtr less, greater;
+        int lessHeight, greaterHeight, height;
+        split(version->root, version->height, key, less, lessHeight, greater, greaterHeight);
+        NodePtr root = join2(less, lessHeight, greater, greaterHeight, height);
+        publish(new Version(root, version->size - 1, height));
+        return true;
+    }
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(writer);
+        publish(new Version(NodePtr(), 0, 0));
+    }
+    // reclaim: 尝试释放已经没有读者访问的旧版本(通常不需要调用, 写者会定期释放)
+    void reclaim() { domain.collect(); }
+private:
+    //***************************数据结构*********************************
+    struct Version
+    {
+        Version(const NodePtr &r, std::size_t n, int h): root(r), size(n), height(h) {  }
+        NodePtr root;
+        std::size_t size;
+        int height;     // 根的黑高(红色的根不计入), 空树为0
+    };
+    mutable EpochDomain domain;
+    std::mutex writer;
+    std::atomic<Version *> current;
+    //***************************私有成员函数*****************************
+    void publish(Version *version)
+    {
+        Version *old = current.exchange(version, std::memory_order_acq_rel);
+        domain.retire(old);
+    }
+
+    static NodePtr make(COLOR color, const NodePtr &l, const KeyType &key, const NodePtr &r)
+    {
+        return std::make_shared<const Node>(color, l, key, r);
+    }
+    static NodePtr recolor(const NodePtr &node, COLOR color)
+    {
+        return node->color == color ? node : make(color, node->lchild, node->key, node->rchild);
+    }
+    static bool isRed(const NodePtr &node) { return node && node->color == RED; }
+    static int childHeight(const NodePtr &node, int height) { return height - (node->color == BLACK ? 1 : 0); }
+
+    // balance: 黑色节点的子节点与孙节点都是红色时, 改成红色的根与两个黑色的子节点(黑高不变)
+    static NodePtr balance(COLOR color, const NodePtr &l, const KeyType &key, const NodePtr &r)
+    {
+        if (color == BLACK){
+            if (isRed(l) && isRed(l->lchild))
+                return make(RED, recolor(l->lchild, BLACK), l->key, make(BLACK, l->rchild, key, r));
+            if (isRed(l) && isRed(l->rchild))
+                return make(RED, make(BLACK, l->lchild, l->key, l->rchild->lchild), l->rchild->key,
+                            make(BLACK, l->rchild->rchild, key, r));
+            if (isRed(r) && isRed(r->lchild))
+                return make(RED, make(BLACK, l, key, r->lchild->lchild), r->lchild->key,
+                            make(BLACK, r->lchild->rchild, r->key, r->rchild));
+            if (isRed(r) && isRed(r->rchild))
+                return make(RED, make(BLACK, l, key, r->lchild), r->key, recolor(r->rchild, BLACK));
+        }
+        return make(color, l, key, r);
+    }
+    static NodePtr insertInto(const NodePtr &node, const KeyType &key)
+    {
+        if (!node)
+            return make(RED, NodePtr(), key, NodePtr());
+        if (key < node->key)
+            return balance(node->color, insertInto(node->lchild, key), node->key, node->rchild);
+        return balance(node->color, node->lchild, node->key, insertInto(node->rchild, key));
+    }
+
+    // joinRight: 沿t的右脊下降到黑高为rh的黑色节点, 在那里挂上红色的key与r; 脊上出现两个相连的红色节点时左旋
+    static NodePtr joinRight(const NodePtr &t, int th, const KeyType &key, const NodePtr &r, int rh)
+    {
+        if (!t || (t->color == BLACK && th == rh))
+            return make(RED, t, key, r);
+        NodePtr right = joinRight(t->rchild, childHeight(t, th), key, r, rh);
+        if (t->color == BLACK && isRed(right) && isRed(right->rchild))
+            return make(RED, make(BLACK, t->lchild, t->key, right->lchild), right->key, recolor(right->rchild, BLACK));
+        return make(t->color, t->lchild, t->key, right);
+    }
+    static NodePtr joinLeft(const NodePtr &l, int lh, const KeyType &key, const NodePtr &t, int th)
+    {
+        if (!t || (t->color == BLACK && th == lh))
+            return make(RED, l, key, t);
+        NodePtr left = joinLeft(l, lh, key, t->lchild, childHeight(t, th));
+        if (t->color == BLACK && isRed(left) && isRed(left->lchild))
+            return make(RED, recolor(left->lchild, BLACK), left->key, make(BLACK, left->rchild, t->key, t->rchild));
+        return make(t->color, left, t->key, t->rchild);
+    }
+    // join: 连接l, key, r(l中的关键字 <= key <= r中的关键字), height返回结果的黑高
+    static NodePtr join(NodePtr l, int lh, const KeyType &key, NodePtr r, int rh, int &height)
+    {
+        if (isRed(l)){
+            l = recolor(l, BLACK);
+            ++lh;
+        }
+        if (isRed(r)){
+            r = recolor(r, BLACK);
+            ++rh;
+        }
+        if (lh == rh){
+            height = lh + 1;
+            return make(BLACK, l, key, r);
+        }
+        height = lh > rh ? lh : rh;
+        return lh > rh ? joinRight(l, lh, key, r, rh) : joinLeft(l, lh, key, r, rh);
+    }
+    // splitLast: 去掉最大的关键字(放入last), 返回其余的关键字组成的树
+    static NodePtr splitLast(const NodePtr &t, int th, KeyType &last, int &height)
+    {
+        int ch = childHeight(t, th);
+        if (!t->rchild){
+            last = t->key;
+            height = ch;
+            return t->lchild;
+        }
+        int restHeight;
+        NodePtr rest = splitLast(t->rchild, ch, last, restHeight);
+        return join(t->lchild, ch, t->key, rest, restHeight, height);
+    }
+    static NodePtr join2(const NodePtr &l, int lh, const NodePtr &r, int rh, int &height)
+    {
+        if (!l || !r){
+            height = l ? lh : rh;
+            return l ? l : r;
+        }
+        KeyType last = l->key;
+        int restHeight;
+        NodePtr rest = splitLast(l, lh, last, restHeight);
+        return join(rest, restHeight, last, r, rh, height);
+    }
+    // split: 把t拆成less与greater, 去掉一个等于key的关键字, 返回是否找到了它
+    static bool split(const NodePtr &t, int th, const KeyType &key,
+                      NodePtr &less, int &lessHeight, NodePtr &greater, int &greaterHeight)
+    {
+        if (!t){
+            less = greater = NodePtr();
+            lessHeight = greaterHeight = 0;
+            return false;
+        }
+        int ch = childHeight(t, th);
+        if (key < t->key){
+            NodePtr middle;
+            int middleHeight;
+            bool found = split(t->lchild, ch, key, less, lessHeight, middle, middleHeight);
+            greater = join(middle, middleHeight, t->key, t->rchild, ch, greaterHeight);
+            return found;
+        }
+        if (t->key < key){
+            NodePtr middle;
+            int middleHeight;
+            bool found = split(t->rchild, ch, key, middle, middleHeight, greater, greaterHeight);
+            less = join(t->lchild, ch, t->key, middle, middleHeight, lessHeight);
+            return found;
+        }
+        less = t->lchild;
+        greater = t->rchild;
+        lessHeight = greaterHeight = ch;
+        return true;
+    }
+};
+#endif
@@ -0,0 +1,143 @@
+/*************************************************************************
+	> File Name: PersistentRedBlackTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时53分30秒
+ ************************************************************************/
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <vector>
+#include "PersistentRedBlackTree.h"
+typedef PersistentRedBlackTree<int> IntTree;
+
+// blackHeight: 检查以node为根的子树的红黑性质与关键字的次序, 返回黑高(不满足时返回-1)
+int blackHeight(const IntTree::Node *node)
+{
+    if (!node)
+        return 0;
+    const IntTree::Node *l = node->lchild.get(), *r = node->rchild.get();
+    if ((l && node->key < l->key) || (r && r->key < node->key))
+        return -1;
+    if (node->color == RED && ((l && l->color == RED) || (r && r->color == RED)))
+        return -1;
+    int lh = blackHeight(l), rh = blackHeight(r);
+    if (lh < 0 || lh != rh)
+        return -1;
+    return lh + (node->color == BLACK ? 1 : 0);
+}
+bool valid(const IntTree::Snapshot &snapshot)
+{
+    std::size_t count = 0;
+    snapshot.inorder_visit([&](int){ ++count; });
+    return count == snapshot.size() && blackHeight(snapshot.root().get()) >= 0;
+}
+std::vector<int> keys(const IntTree::Snapshot &snapshot)
+{
+    std::vector<int> result;
+    snapshot.inorder_visit([&](int key){ result.push_back(key); });
+    return result;
+}
+
+// random_test: 随机插入与删除, 与std::multiset比较, 每一步都检查红黑性质; 旧的快照保持不变
+void random_test()
+{
+    IntTree tree;
+    std::multiset<int> reference;
+    std::vector<IntTree::Snapshot> snapshots;
+    std::vector<std::vector<int>> expected;
+    std::srand(17);
+    bool correct = true;
+    for (int i = 0; i != 20000; ++i){
+        int key = std::rand() % 1000;
+        if (std::rand() % 3 != 0){
+            tree.insert(key);
+            reference.insert(key);
+        }else{
+            auto it = reference.find(key);
+            correct = correct && tree.erase(key) == (it != reference.end());
+            if (it != reference.end())
+                reference.erase(it);
+        }
+        if (i % 1000 == 0){
+            snapshots.push_back(tree.snapshot());
+            expected.push_back(std::vector<int>(reference.begin(), reference.end()));
+            correct = correct && valid(snapshots.back());
+        }
+    }
+    IntTree::Snapshot last = tree.snapshot();
+    correct = correct && valid(last) && keys(last) == std::vector<int>(reference.begin(), reference.end());
+    for (std::size_t i = 0; i != snapshots.size(); ++i)
+        correct = correct && keys(snapshots[i]) == expected[i] && valid(snapshots[i]);
+    correct = correct && *last.minimum() == *reference.begin() && *last.maximum() == *reference.rbegin();
+    correct = correct && (last.find(1000) == nullptr) && last.contains(*reference.begin());
+    std::size_t inRange = 0;
+    last.range(100, 199, [&](int key){ inRange += (key >= 100 && key <= 199); });
+    correct = correct && inRange == static_cast<std::size_t>(std::distance(reference.lower_bound(100),
+                                                                          reference.upper_bound(199)));
+    std::cout << "随机插入与删除, 旧快照不变: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// sharing_test: 一次插入只复制查找路径上的节点, 另一侧的子树与旧版本共享; 旧版本的节点在最后一个快照释放后回收
+void sharing_test()
+{
+    IntTree tree;
+    for (int i = 0; i != 1000; ++i)
+        tree.insert(2 * i);
+    IntTree::Snapshot before = tree.snapshot();
+    tree.insert(1);
+    IntTree::Snapshot after = tree.snapshot();
+    bool correct = before.root() != after.root() && before.root()->rchild == after.root()->rchild;
+    std::weak_ptr<const IntTree::Node> oldRoot = before.root();
+    before = IntTree::Snapshot();
+    for (int i = 0; i != 200; ++i){
+        tree.erase(2 * i);
+        tree.reclaim();
+    }
+    correct = correct && oldRoot.expired() && after.size() == 1001 && tree.size() == 801 && valid(tree.snapshot());
+    tree.clear();
+    correct = correct && tree.empty() && after.size() == 1001 && valid(after);
+    std::cout << "结构共享与回收: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// concurrent_test: 一个写者不断插入与删除, 读者不加锁地读取快照, 每个快照都是有序的合法红黑树且大小一致
+void concurrent_test()
+{
+    IntTree tree;
+    std::atomic<bool> done(false), correct(true);
+    std::vector<std::thread> readers;
+    for (int r = 0; r != 3; ++r)
+        readers.emplace_back([&]{
+            while (!done.load()){
+                IntTree::Snapshot snapshot = tree.snapshot();
+                if (!valid(snapshot))
+                    correct.store(false);
+            }
+        });
+    std::srand(23);
+    for (int i = 0; i != 20000; ++i){
+        int key = std::rand() % 3000;
+        if (std::rand() % 3 != 0)
+            tree.insert(key);
+        else
+            tree.erase(key);
+    }
+    done.store(true);
+    for (auto &reader : readers)
+        reader.join();
+    std::cout << "一个写者与多个读者: " << (correct.load() && valid(tree.snapshot()) ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********persistent red black tree的随机测试********\n";
+    random_test();
+    std::cout << "********persistent red black tree的路径复制测试********\n";
+    sharing_test();
+    std::cout << "********persistent red black tree的并发测试********\n";
+    concurrent_test();
+    return 0;
+}
@@ -0,0 +1,625 @@
+/*************************************************************************
+	> File Name: PooledRedBlackTree.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时26分07秒
+ ************************************************************************/
+
+#ifndef _POOLEDREDBLACKTREE_H
+#define _POOLEDREDBLACKTREE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../RedBlackTreeNode/RedBlackTreeNode.h"
+// PooledRedBlackTree: 节点放在连续的节点池中, 用32位下标链接的红黑树 算法导论第13章
+/*
+ * 与RedBlackTree的区别只在节点的存储方式, 插入, 删除与颜色修复的过程与RedBlackTree相同(都按算法导论第13章):
+ *      --所有节点放在一个std::vector中, 用32位下标互相引用, 没有shared_ptr的引用计数与weak_ptr::lock()的原子操作,
+ *        节点也没有虚函数表指针. 一个节点 = 关键字 + 左右子节点的下标 + 父节点的下标与颜色(关键字之外只有12字节);
+ *      --颜色放在父节点下标的最低位(parentColor = parent << 1 | color), 所以最多有2^31 - 1个节点;
+ *      --下标0是书中的哨兵T.nil(黑色), 叶节点与根的父节点都指向它, 边界条件不需要单独判断空指针;
+ *      --删除的节点放入空闲链表(用left链接), 之后的插入优先重用它们.
+ *
+ * 节点池扩充时节点的地址会变化, 所以对外只使用下标: insert返回新节点的下标, 在该节点被删除之前一直有效.
+ * Key需要可以默认构造(哨兵节点中保存一个Key()). 关键字相同的节点可以有多个(插在右子树中, 与RedBlackTree相同).
+ *
+ * 扩张(算法导论第14章): Augment给每个节点增加一个Augment::Data, 它只依赖于节点的关键字与两个子节点的Data,
+ * 由Augment::update(data, key, left, right)重新计算(哨兵的Data是默认构造的值, 应当是"空子树"的值).
+ * 旋转以后重新计算被旋转的两个节点, 插入与删除时重新计算修改位置到根的路径, 所以颜色修复的前后Data都正确,
+ * 代价为O(logn). 例如OrderStatisticTree中的子树大小, IntervalTree中子树的最大高端点.
+ * 默认的NoAugment没有数据(空基类优化使节点不变大), enabled为false, 不执行任何更新.
+ *
+ */
+// NoAugment: 不扩张
+struct NoAugment
+{
+    static const bool enabled = false;
+    struct Data {  };
+    template<typename Key>
+    static void update(Data &, const Key &, const Data &, const Data &) {  }
+};
+
+template<typename Key, typename Compare = std::less<Key>, typename Augment = NoAugment>
+class PooledRedBlackTree
+{
+public:
+    typedef Key KeyType;
+    typedef typename Augment::Data AugmentData;
+    typedef std::uint32_t Index;
+    static const Index nil = 0;     // 哨兵节点的下标
+    //***************************构造函数*********************************
+    explicit PooledRedBlackTree(const Compare &comp = Compare())
+        : less(comp), root_(nil), freeList(nil), count(0)
+    {
+        nodes.push_back(Node());    // 哨兵: 黑色, 左右子节点与父节点都是自己
+    }
+    //***************************成员函数*********************************
+    Index insert(const Key &key);       // 插入一个关键字, 返回新节点的下标
+    void remove(Index node);            // 删除一个节点
+    bool erase(const Key &key);         // 删除一个关键字为key的节点, 返回是否删除
+    Index find(const Key &key) const;   // 关键字为key的一个节点, 不存在时返回nil
+    bool contains(const Key &key) const { return find(key) != nil; }
+    Index minimum(Index node) const;    // 以node为根的子树中关键字最小的节点
+    Index maximum(Index node) const;    // 以node为根的子树中关键字最大的节点
+    Index successor(Index node) const;  // 后继节点, 没有时返回nil
+    Index predecessor(Index node) const;    // 前驱节点, 没有时返回nil
+    // build_from_sorted: 用有序的[first, last)建立一棵平衡的红黑树(替换原有的节点), O(n)
+    template<typename Iterator>
+    void build_from_sorted(Iterator first, Iterator last);
+    // insert_many: 批量插入任意次序的关键字, 与原有的节点一次归并成平衡的红黑树, O(mlogm + n)
+    template<typename Iterator>
+    void insert_many(Iterator first, Iterator last);
+    void clear();
+    void reserve(std::size_t n) { nodes.reserve(n + 1); }   // 预留n个节点的空间
+
+    Index root() const { return root_; }
+    const Key& key(Index node) const { return nodes[node].key; }
+    COLOR color(Index node) const { return static_cast<COLOR>(nodes[node].parentColor & 1); }
+    Index parent(Index node) const { return nodes[node].parentColor >> 1; }
+    Index left(Index node) const { return nodes[node].left; }
+    Index right(Index node) const { return nodes[node].right; }
+    const AugmentData& augment(Index node) const { return nodes[node]; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Compare& key_comp() const { return less; }
+    // bytes: 节点池占用的字节数(包括空闲节点)
+    std::size_t bytes() const { return nodes.capacity() * sizeof(Node); }
+private:
+    //***************************数据结构*********************************
+    struct Node : AugmentData
+    {
+        Node() : AugmentData(), key(), left(nil), right(nil), parentColor(BLACK) {  }
+        Key key;
+        Index left;
+        Index right;
+        std::uint32_t parentColor;      // 父节点的下标 << 1 | 颜色
+    };
+    std::vector<Node> nodes;    // 节点池, nodes[0]为哨兵
+    Compare less;
+    Index root_;                // 根节点, 空树时为nil
+    Index freeList;             // 空闲链表的第一个节点
+    std::size_t count;          // 节点个数
+    //***************************私有成员函数*****************************
+    void setParent(Index node, Index p) { nodes[node].parentColor = (p << 1) | (nodes[node].parentColor & 1); }
+    void setColor(Index node, COLOR c) { nodes[node].parentColor = (nodes[node].parentColor & ~std::uint32_t(1)) | c; }
+    // update: 由子节点重新计算node的扩张数据; updatePath: 从node到根依次重新计算
+    void update(Index node)
+    {
+        Augment::update(nodes[node], nodes[node].key, nodes[nodes[node].left], nodes[nodes[node].right]);
+    }
+    void updatePath(Index node)
+    {
+        if (!Augment::enabled)
+            return;
+        for (; node != nil; node = parent(node))
+            update(node);
+    }
+    Index allocate(const Key &key);
+    void release(Index node);
+    template<typename Iterator>
+    Index buildBalanced(Iterator &first, std::size_t n, unsigned depth, unsigned redDepth, Index &previous);
+    Index linkBalanced(const Index *order, std::size_t n, unsigned depth, unsigned redDepth);
+    static unsigned redDepthFor(std::size_t n);
+    void left_rotate(Index node);       // 左旋转
+    void right_rotate(Index node);      // 右旋转
+    void insert_fixup(Index node);      // 插入以后保持红黑性质
+    void delete_fixup(Index node);      // 删除以后保持红黑性质
+    void transplant(Index u, Index v);  // 用以v为根的子树替换以u为根的子树
+};
+template<typename Key, typename Compare, typename Augment>
+const typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::nil;
+//**********************************成员函数******************************
+// allocate: 取得一个节点(优先从空闲链表中取)
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::allocate(const Key &key)
+{
+    Index node = freeList;
+    if (node != nil){
+        freeList = nodes[node].left;
+        nodes[node].key = key;
+    }else{
+        if (nodes.size() > (std::uint32_t(0xFFFFFFFF) >> 1))
+            throw std::length_error("PooledRedBlackTree error: 节点数超过2^31 - 1");
+        node = static_cast<Index>(nodes.size());
+        nodes.push_back(Node());
+        nodes[node].key = key;
+    }
+    nodes[node].left = nodes[node].right = nil;
+    static_cast<AugmentData &>(nodes[node]) = AugmentData();
+    return node;
+}
+// release: 把节点放入空闲链表, 关键字换成Key()以释放它持有的资源
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::release(Index node)
+{
+    nodes[node].key = Key();
+    nodes[node].left = freeList;
+    freeList = node;
+}
+// left_rotate: 左旋转操作
+/*
+ * \parameter node: 待旋转的节点, 它的右子节点不是nil;
+ *
+ * 与RedBlackTree::left_rotate相同: node的右子节点r_node取代node的位置, node成为r_node的左子节点,
+ * r_node原来的左子树成为node的右子树. 时间复杂度为O(1).
+*/
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::left_rotate(Index node)
+{
+    Index r_node = nodes[node].right;
+    Index l_r_node = nodes[r_node].left;
+    nodes[node].right = l_r_node;
+    if (l_r_node != nil)
+        setParent(l_r_node, node);
+    Index p = parent(node);
+    setParent(r_node, p);
+    if (p == nil)
+        root_ = r_node;
+    else if (node == nodes[p].left)
+        nodes[p].left = r_node;
+    else
+        nodes[p].right = r_node;
+    nodes[r_node].left = node;
+    setParent(node, r_node);
+    if (Augment::enabled){
+        update(node);
+        update(r_node);
+    }
+}
+// right_rotate: 右旋转操作(left_rotate的对称)
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::right_rotate(Index node)
+{
+    Index l_node = nodes[node].left;
+    Index r_l_node = nodes[l_node].right;
+    nodes[node].left = r_l_node;
+    if (r_l_node != nil)
+        setParent(r_l_node, node);
+    Index p = parent(node);
+    setParent(l_node, p);
+    if (p == nil)
+        root_ = l_node;
+    else if (node == nodes[p].right)
+        nodes[p].right = l_node;
+    else
+        nodes[p].left = l_node;
+    nodes[l_node].right = node;
+    setParent(node, l_node);
+    if (Augment::enabled){
+        update(node);
+        update(l_node);
+    }
+}
+// insert_fixup: 插入操作保持红黑性质
+/*
+ * \parameter node: 新插入的红色节点.
+ *
+ * 三种情况与RedBlackTree::insert_fixup相同: 情况1叔节点为红色, 父节点与叔节点涂黑, 祖父节点涂红并上移;
+ * 情况2叔节点为黑色且node是右孩子, 左旋转转为情况3; 情况3父节点涂黑, 祖父节点涂红, 对祖父节点右旋转.
+ * 哨兵是黑色的, 所以node上移到根时循环自然结束. 旋转不超过两次.
+*/
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::insert_fixup(Index node)
+{
+    while (color(parent(node)) == RED){
+        Index node_p = parent(node);
+        Index node_p_p = parent(node_p);
+        if (node_p == nodes[node_p_p].left){
+            Index uncle = nodes[node_p_p].right;
+            if (color(uncle) == RED){       // 情况1
+                setColor(node_p, BLACK);
+                setColor(uncle, BLACK);
+                setColor(node_p_p, RED);
+                node = node_p_p;
+            }else{
+                if (node == nodes[node_p].right){       // 情况2
+                    node = node_p;
+                    left_rotate(node);
+                    node_p = parent(node);
+                }
+                setColor(node_p, BLACK);        // 情况3
+                setColor(node_p_p, RED);
+                right_rotate(node_p_p);
+            }
+        }else{      // 对称处理
+            Index uncle = nodes[node_p_p].left;
+            if (color(uncle) == RED){
+                setColor(node_p, BLACK);
+                setColor(uncle, BLACK);
+                setColor(node_p_p, RED);
+                node = node_p_p;
+            }else{
+                if (node == nodes[node_p].left){
+                    node = node_p;
+                    right_rotate(node);
+                    node_p = parent(node);
+                }
+                setColor(node_p, BLACK);
+                setColor(node_p_p, RED);
+                left_rotate(node_p_p);
+            }
+        }
+    }
+    setColor(root_, BLACK);
+}
+// insert: 红黑树的插入操作
+/*
+ * \parameter key: 待插入的关键字;
+ * \return 新节点的下标.
+ *
+ * 与RedBlackTree::insert相同: 从根向下, 关键字小于当前节点时向左, 否则向右, 到nil时挂载新节点,
+ * 新节点涂红以后调用insert_fixup. 时间复杂度为O(logn).
+*/
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::insert(const Key &key)
+{
+    Index node = allocate(key);
+    Index temp_parent = nil;
+    bool left = true;
+    for (Index temp = root_; temp != nil; ){
+        temp_parent = temp;
+        left = less(key, nodes[temp].key);
+        temp = left ? nodes[temp].left : nodes[temp].right;
+    }
+    nodes[node].parentColor = (temp_parent << 1) | RED;
+    if (temp_parent == nil)
+        root_ = node;
+    else if (left)
+        nodes[temp_parent].left = node;
+    else
+        nodes[temp_parent].right = node;
+    ++count;
+    updatePath(node);
+    insert_fixup(node);
+    return node;
+}
+// transplant: 用以v为根的子树替换以u为根的子树(v可以是nil, 这时设置哨兵的父节点, 供delete_fixup使用)
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::transplant(Index u, Index v)
+{
+    Index p = parent(u);
+    if (p == nil)
+        root_ = v;
+    else if (u == nodes[p].left)
+        nodes[p].left = v;
+    else
+        nodes[p].right = v;
+    setParent(v, p);
+}
+// delete_fixup: 删除操作保持红黑性质
+/*
+ * \parameter node: 取代被移走的黑色节点的节点(可能是nil, 它的父节点由transplant设置).
+ *
+ * 四种情况与RedBlackTree::delete_fixup相同: 情况1兄弟w为红色, 转为w为黑色的情况; 情况2 w的两个子节点都是黑色,
+ * w涂红, node上移; 情况3 w的远端子节点为黑色, 旋转w转为情况4; 情况4旋转父节点, 循环结束.
+ * 时间复杂度为O(logN), 旋转不超过三次.
+*/
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::delete_fixup(Index node)
+{
+    while (node != root_ && color(node) == BLACK){
+        Index node_p = parent(node);
+        if (node == nodes[node_p].left){
+            Index w = nodes[node_p].right;
+            if (color(w) == RED){       // 情况1
+                setColor(w, BLACK);
+                setColor(node_p, RED);
+                left_rotate(node_p);
+                w = nodes[node_p].right;
+            }
+            if (color(nodes[w].left) == BLACK && color(nodes[w].right) == BLACK){  // 情况2
+                setColor(w, RED);
+                node = node_p;
+            }else{
+                if (color(nodes[w].right) == BLACK){    // 情况3
+                    setColor(nodes[w].left, BLACK);
+                    setColor(w, RED);
+                    right_rotate(w);
+                    w = nodes[node_p].right;
+                }
+                setColor(w, color(node_p));     // 情况4
+                setColor(node_p, BLACK);
+                setColor(nodes[w].right, BLACK);
+                left_rotate(node_p);
+                node = root_;
+            }
+        }else{      // 对称处理
+            Index w = nodes[node_p].left;
+            if (color(w) == RED){
+                setColor(w, BLACK);
+                setColor(node_p, RED);
+                right_rotate(node_p);
+                w = nodes[node_p].left;
+            }
+            if (color(nodes[w].left) == BLACK && color(nodes[w].right) == BLACK){
+                setColor(w, RED);
+                node = node_p;
+            }else{
+                if (color(nodes[w].left) == BLACK){
+                    setColor(nodes[w].right, BLACK);
+                    setColor(w, RED);
+                    left_rotate(w);
+                    w = nodes[node_p].left;
+                }
+                setColor(w, color(node_p));
+                setColor(node_p, BLACK);
+                setColor(nodes[w].left, BLACK);
+                right_rotate(node_p);
+                node = root_;
+            }
+        }
+    }
+    setColor(node, BLACK);
+}
+// remove: 红黑树的删除操作
+/*
+ * \parameter node: 待删除的节点, 必须在树中(不能是已经删除的节点的下标).
+ *
+ * 与RedBlackTree::remove相同: 少于两个子节点时用子树取代node; 有两个子节点时用后继y取代node并换成node的颜色,
+ * y原来的位置由它的右子树x取代. 被移走的节点(node或y)原来是黑色时调用delete_fixup(x). 时间复杂度为O(logN).
+*/
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::remove(Index node)
+{
+    if (node == nil || node >= nodes.size())
+        throw std::invalid_argument("PooledRedBlackTree error: 删除的节点不在树中");
+    Index x;
+    Index y = node;
+    COLOR y_color = color(y);
+    if (nodes[node].left == nil){
+        x = nodes[node].right;
+        transplant(node, x);
+    }else if (nodes[node].right == nil){
+        x = nodes[node].left;
+        transplant(node, x);
+    }else{
+        y = minimum(nodes[node].right);
+        y_color = color(y);
+        x = nodes[y].right;
+        if (parent(y) == node)
+            setParent(x, y);
+        else{
+            transplant(y, x);
+            nodes[y].right = nodes[node].right;
+            setParent(nodes[y].right, y);
+        }
+        transplant(node, y);
+        nodes[y].left = nodes[node].left;
+        setParent(nodes[y].left, y);
+        setColor(y, color(node));
+    }
+    // parent(x)是结构发生变化的最低位置(x为nil时由transplant或setParent设置)
+    updatePath(parent(x));
+    if (y_color == BLACK)
+        delete_fixup(x);
+    setParent(nil, nil);
+    release(node);
+    --count;
+}
+template<typename Key, typename Compare, typename Augment>
+bool PooledRedBlackTree<Key, Compare, Augment>::erase(const Key &key)
+{
+    Index node = find(key);
+    if (node == nil)
+        return false;
+    remove(node);
+    return true;
+}
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::find(const Key &key) const
+{
+    Index temp = root_;
+    while (temp != nil){
+        if (less(key, nodes[temp].key))
+            temp = nodes[temp].left;
+        else if (less(nodes[temp].key, key))
+            temp = nodes[temp].right;
+        else
+            return temp;
+    }
+    return nil;
+}
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::minimum(Index node) const
+{
+    if (node == nil)
+        return nil;
+    while (nodes[node].left != nil)
+        node = nodes[node].left;
+    return node;
+}
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::maximum(Index node) const
+{
+    if (node == nil)
+        return nil;
+    while (nodes[node].right != nil)
+        node = nodes[node].right;
+    return node;
+}
+// successor: 后继节点, 与RedBlackTree::successor相同, 只是没有引用计数
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::successor(Index node) const
+{
+    if (nodes[node].right != nil)
+        return minimum(nodes[node].right);
+    Index p = parent(node);
+    while (p != nil && node == nodes[p].right){
+        node = p;
+        p = parent(p);
+    }
+    return p;
+}
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index PooledRedBlackTree<Key, Compare, Augment>::predecessor(Index node) const
+{
+    if (nodes[node].left != nil)
+        return maximum(nodes[node].left);
+    Index p = parent(node);
+    while (p != nil && node == nodes[p].left){
+        node = p;
+        p = parent(p);
+    }
+    return p;
+}
+// build_from_sorted: 由有序序列直接建立红黑树
+/*
+ * \parameter first, last: 按Compare有序(允许相等)的关键字, Iterator至少是前向迭代器;
+ * \return void. 序列无序时清空树并抛出std::invalid_argument.
+ *
+ * 算法基本思想: 对n个关键字, 左子树用前n / 2个, 根用下一个, 右子树用剩下的, 递归建立. 这样的树中所有空的叶节点
+ *      都在最深的两层之下: 若最深的一层(第D层)没有填满, 把第D层的节点涂红, 其余的涂黑, 每条路径上都恰好有D个
+ *      黑色节点, 红色节点的子节点都是nil, 满足红黑性质; 第D层填满时全部涂黑即可.
+ *      按中序顺序读取序列, 节点也按中序顺序连续分配, 之后的中序遍历按地址递增访问节点池.
+ *      不比较关键字的大小关系来决定位置, 不旋转, 时间复杂度为O(n)(检查有序需要n - 1次比较).
+*/
+template<typename Key, typename Compare, typename Augment>
+template<typename Iterator>
+void PooledRedBlackTree<Key, Compare, Augment>::build_from_sorted(Iterator first, Iterator last)
+{
+    clear();
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    reserve(n);
+    Index previous = nil;
+    root_ = buildBalanced(first, n, 0, redDepthFor(n), previous);
+    if (count != n){
+        clear();
+        throw std::invalid_argument("PooledRedBlackTree error: build_from_sorted的序列不是有序的");
+    }
+    setParent(root_, nil);
+}
+// buildBalanced: 用first开始的n个关键字建立深度为depth的子树, 返回子树的根
+template<typename Key, typename Compare, typename Augment>
+template<typename Iterator>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index
+PooledRedBlackTree<Key, Compare, Augment>::buildBalanced(Iterator &first, std::size_t n, unsigned depth,
+                                                         unsigned redDepth, Index &previous)
+{
+    if (n == 0)
+        return nil;
+    Index l = buildBalanced(first, n / 2, depth + 1, redDepth, previous);
+    Index node = allocate(*first);
+    ++first;
+    // 次序错误的节点不计数, 由build_from_sorted检查count
+    if (previous == nil || !less(nodes[node].key, nodes[previous].key))
+        ++count;
+    previous = node;
+    Index r = buildBalanced(first, n - n / 2 - 1, depth + 1, redDepth, previous);
+    nodes[node].left = l;
+    nodes[node].right = r;
+    nodes[node].parentColor = depth == redDepth ? RED : BLACK;
+    if (l != nil)
+        setParent(l, node);
+    if (r != nil)
+        setParent(r, node);
+    if (Augment::enabled)
+        update(node);
+    return node;
+}
+// insert_many: 批量插入关键字
+/*
+ * \parameter first, last: 任意次序的关键字;
+ * \return void.
+ *
+ * 算法基本思想: 复制并排序这一批关键字(m个). 若m * lg(n + m) < n, 逐个insert更快; 否则按中序遍历原有的n个节点,
+ *      与排好序的关键字归并(相等时原有的在前, 与insert相等时向右一致), 新关键字在归并时分配节点,
+ *      最后像build_from_sorted一样把n + m个节点的下标重新连接并着色. 原有节点的下标不变.
+ * 算法性能: 时间复杂度为O(mlogm + n + m).
+*/
+template<typename Key, typename Compare, typename Augment>
+template<typename Iterator>
+void PooledRedBlackTree<Key, Compare, Augment>::insert_many(Iterator first, Iterator last)
+{
+    std::vector<Key> keys(first, last);
+    if (keys.empty())
+        return;
+    std::sort(keys.begin(), keys.end(), less);
+    std::size_t total = count + keys.size(), lg = 0;
+    while ((total >> lg) > 1)
+        ++lg;
+    if (keys.size() * lg < count){
+        for (auto &key : keys)
+            insert(key);
+        return;
+    }
+    nodes.reserve(nodes.size() + keys.size());
+    std::vector<Index> order;
+    order.reserve(total);
+    std::size_t j = 0;
+    for (Index x = root_ == nil ? nil : minimum(root_); x != nil; x = successor(x)){
+        while (j != keys.size() && less(keys[j], nodes[x].key))
+            order.push_back(allocate(keys[j++]));
+        order.push_back(x);
+    }
+    while (j != keys.size())
+        order.push_back(allocate(keys[j++]));
+    count = total;
+    root_ = linkBalanced(order.data(), total, 0, redDepthFor(total));
+    setParent(root_, nil);
+}
+// linkBalanced: 把按中序排列的n个节点order[0, n)连接成深度为depth的子树, 返回子树的根
+template<typename Key, typename Compare, typename Augment>
+typename PooledRedBlackTree<Key, Compare, Augment>::Index
+PooledRedBlackTree<Key, Compare, Augment>::linkBalanced(const Index *order, std::size_t n, unsigned depth, unsigned redDepth)
+{
+    if (n == 0)
+        return nil;
+    Index node = order[n / 2];
+    Index l = linkBalanced(order, n / 2, depth + 1, redDepth);
+    Index r = linkBalanced(order + n / 2 + 1, n - n / 2 - 1, depth + 1, redDepth);
+    nodes[node].left = l;
+    nodes[node].right = r;
+    nodes[node].parentColor = depth == redDepth ? RED : BLACK;
+    if (l != nil)
+        setParent(l, node);
+    if (r != nil)
+        setParent(r, node);
+    if (Augment::enabled)
+        update(node);
+    return node;
+}
+// redDepthFor: 满二叉树有2^D - 1个节点(D为满的层数), n不是2^D - 1时第D层(从0开始)没有填满, 这一层涂红;
+// 否则没有涂红的层, 返回~0u
+template<typename Key, typename Compare, typename Augment>
+unsigned PooledRedBlackTree<Key, Compare, Augment>::redDepthFor(std::size_t n)
+{
+    unsigned full = 0;
+    while ((std::size_t(2) << full) - 1 <= n)
+        ++full;
+    return ((std::size_t(1) << full) - 1 == n) ? ~0u : full;
+}
+// clear: 删除所有节点, 保留节点池的空间
+template<typename Key, typename Compare, typename Augment>
+void PooledRedBlackTree<Key, Compare, Augment>::clear()
+{
+    nodes.resize(1);
+    nodes[nil] = Node();
+    root_ = freeList = nil;
+    count = 0;
+}
+#endif
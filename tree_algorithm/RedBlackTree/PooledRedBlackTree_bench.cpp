@@ -0,0 +1,120 @@
+/*************************************************************************
+	> File Name: PooledRedBlackTree_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时28分50秒
+ ************************************************************************/
+// 共享指针链接的RedBlackTree与节点池中的PooledRedBlackTree的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [关键字个数(默认1000000)]
+ *      随机插入n个关键字, 再按中序用successor遍历所有节点.
+ *
+ * 输出的每一行: tree,n,insert_ns,successor_ns
+ *      --insert_ns: 每次插入的平均时间(RedBlackTree包括make_shared分配节点);
+ *      --successor_ns: 遍历时每个节点的平均时间.
+ *
+ * 之后是有序关键字的建树时间: load,tree,n,method,load_ns
+ *      --method为insert(逐个插入)或build_from_sorted; load_ns为每个关键字的平均时间.
+ *
+ * 最后是RedBlackTree按中序扫描所有关键字的时间: scan,n,method,scan_ns
+ *      --method为successor(共享指针), iterator(TreeIterator)或range(非递归的visitor); scan_ns为每个关键字的平均时间.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "RedBlackTree.h"
+#include "PooledRedBlackTree.h"
+
+typedef std::chrono::steady_clock Clock;
+std::int64_t bench_sink = 0;    // 遍历得到的关键字之和, 使编译器不能省略遍历
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<int> keys(n);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (auto &key : keys){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<int>(state >> 33);
+    }
+    std::cout << "tree,n,insert_ns,successor_ns\n";
+    {
+        RedBlackTree<RedBlackTreeNode<int>> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(std::make_shared<RedBlackTreeNode<int>>(key));
+        double insert_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        for (auto node = tree.minimum(tree.root); node; node = tree.successor(node))
+            bench_sink += node->key;
+        std::cout << "shared_ptr," << n << ',' << insert_ns << ',' << nanosecondsSince(begin, n) << std::endl;
+    }
+    {
+        PooledRedBlackTree<int> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(key);
+        double insert_ns = nanosecondsSince(begin, n);
+        begin = Clock::now();
+        for (auto node = tree.minimum(tree.root()); node != tree.nil; node = tree.successor(node))
+            bench_sink += tree.key(node);
+        std::cout << "pooled," << n << ',' << insert_ns << ',' << nanosecondsSince(begin, n) << std::endl;
+    }
+    std::sort(keys.begin(), keys.end());
+    std::cout << "load,tree,n,method,load_ns\n";
+    {
+        RedBlackTree<RedBlackTreeNode<int>> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(std::make_shared<RedBlackTreeNode<int>>(key));
+        std::cout << "load,shared_ptr," << n << ",insert," << nanosecondsSince(begin, n) << std::endl;
+    }
+    {
+        RedBlackTree<RedBlackTreeNode<int>> tree;
+        auto begin = Clock::now();
+        tree.build_from_sorted(keys.begin(), keys.end());
+        std::cout << "load,shared_ptr," << n << ",build_from_sorted," << nanosecondsSince(begin, n) << std::endl;
+    }
+    {
+        PooledRedBlackTree<int> tree;
+        auto begin = Clock::now();
+        for (int key : keys)
+            tree.insert(key);
+        std::cout << "load,pooled," << n << ",insert," << nanosecondsSince(begin, n) << std::endl;
+    }
+    {
+        PooledRedBlackTree<int> tree;
+        auto begin = Clock::now();
+        tree.build_from_sorted(keys.begin(), keys.end());
+        std::cout << "load,pooled," << n << ",build_from_sorted," << nanosecondsSince(begin, n) << std::endl;
+    }
+    std::cout << "scan,n,method,scan_ns\n";
+    {
+        RedBlackTree<RedBlackTreeNode<int>> tree;
+        tree.build_from_sorted(keys.begin(), keys.end());
+        auto begin = Clock::now();
+        for (auto node = tree.minimum(tree.root); node; node = tree.successor(node))
+            bench_sink += node->key;
+        std::cout << "scan," << n << ",successor," << nanosecondsSince(begin, n) << std::endl;
+        begin = Clock::now();
+        for (int key : tree)
+            bench_sink += key;
+        std::cout << "scan," << n << ",iterator," << nanosecondsSince(begin, n) << std::endl;
+        begin = Clock::now();
+        tree.range(keys.front(), keys.back(), [](const int &key){ bench_sink += key; });
+        std::cout << "scan," << n << ",range," << nanosecondsSince(begin, n) << std::endl;
+    }
+    return bench_sink == 0;
+}
@@ -0,0 +1,180 @@
+/*************************************************************************
+	> File Name: PooledRedBlackTree_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时31分33秒
+ ************************************************************************/
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "PooledRedBlackTree.h"
+typedef PooledRedBlackTree<int> IntTree;
+
+// blackHeight: 检查以node为根的子树的红黑性质与父节点链接, 返回黑高(不满足时返回-1)
+template<typename Tree>
+int blackHeight(const Tree &tree, typename Tree::Index node)
+{
+    if (node == Tree::nil)
+        return 1;
+    auto l = tree.left(node), r = tree.right(node);
+    if ((l != Tree::nil && (tree.parent(l) != node || tree.key(node) < tree.key(l))) ||
+        (r != Tree::nil && (tree.parent(r) != node || tree.key(r) < tree.key(node))))
+        return -1;
+    if (tree.color(node) == RED && (tree.color(l) == RED || tree.color(r) == RED))
+        return -1;
+    int lh = blackHeight(tree, l), rh = blackHeight(tree, r);
+    if (lh < 0 || lh != rh)
+        return -1;
+    return lh + (tree.color(node) == BLACK ? 1 : 0);
+}
+template<typename Tree>
+bool valid(const Tree &tree)
+{
+    return tree.color(tree.root()) == BLACK && tree.parent(tree.root()) == Tree::nil &&
+           blackHeight(tree, tree.root()) > 0;
+}
+
+void insert_test()
+{
+    IntTree tree;
+    const int keys[] = {15, 6, 7, 3, 4, 2, 13, 9, 18, 17, 20};
+    for (int key : keys)
+        tree.insert(key);
+    bool correct = valid(tree) && tree.size() == 11 && tree.key(tree.root()) == 7;
+    std::cout << "中序: ";
+    for (auto node = tree.minimum(tree.root()); node != IntTree::nil; node = tree.successor(node))
+        std::cout << tree.key(node) << " ";
+    std::cout << "\n逆序: ";
+    for (auto node = tree.maximum(tree.root()); node != IntTree::nil; node = tree.predecessor(node))
+        std::cout << tree.key(node) << " ";
+    std::cout << "\n插入: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// random_test: 随机插入与删除, 与std::multiset比较, 每一步都检查红黑性质
+void random_test()
+{
+    IntTree tree;
+    std::multiset<int> reference;
+    std::srand(7);
+    bool correct = true;
+    for (int i = 0; i != 20000; ++i){
+        int key = std::rand() % 2000;
+        if (std::rand() % 3 != 0){
+            tree.insert(key);
+            reference.insert(key);
+        }else{
+            bool erased = tree.erase(key);
+            auto it = reference.find(key);
+            correct = correct && erased == (it != reference.end());
+            if (it != reference.end())
+                reference.erase(it);
+        }
+        if (i % 500 == 0)
+            correct = correct && valid(tree);
+    }
+    auto it = reference.begin();
+    for (auto node = tree.minimum(tree.root()); node != IntTree::nil; node = tree.successor(node), ++it)
+        correct = correct && it != reference.end() && *it == tree.key(node);
+    correct = correct && it == reference.end() && tree.size() == reference.size() && valid(tree);
+    std::cout << "随机插入与删除: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// pool_test: 删除的节点被重用, 删除全部节点以后是空树
+void pool_test()
+{
+    PooledRedBlackTree<std::string> tree;
+    for (int i = 0; i != 1000; ++i)
+        tree.insert("key" + std::to_string(i));
+    std::size_t bytes = tree.bytes();
+    for (int i = 0; i != 1000; i += 2)
+        tree.erase("key" + std::to_string(i));
+    for (int i = 0; i != 500; ++i)
+        tree.insert("new" + std::to_string(i));
+    bool correct = tree.bytes() == bytes && tree.size() == 1000 && valid(tree) && tree.contains("new7") &&
+                   !tree.contains("key8") && tree.contains("key9");
+    while (!tree.empty())
+        tree.remove(tree.root());
+    correct = correct && tree.root() == PooledRedBlackTree<std::string>::nil && tree.find("key9") == tree.nil;
+    tree.insert("again");
+    correct = correct && valid(tree) && tree.size() == 1;
+    tree.clear();
+    std::cout << "节点重用: " << (correct && tree.empty() ? "正确" : "错误") << std::endl;
+}
+
+// build_test: 由有序序列建立的树满足红黑性质, 之后可以继续插入与删除; 无序的序列抛出异常
+void build_test()
+{
+    bool correct = true;
+    for (int n = 0; n != 300; ++n){
+        std::vector<int> keys;
+        for (int i = 0; i != n; ++i)
+            keys.push_back(i / 3);
+        IntTree tree;
+        tree.build_from_sorted(keys.begin(), keys.end());
+        correct = correct && tree.size() == static_cast<std::size_t>(n) && (n == 0 || valid(tree));
+        int i = 0;
+        for (auto node = tree.minimum(tree.root()); node != IntTree::nil; node = tree.successor(node))
+            correct = correct && tree.key(node) == keys[i++];
+        tree.insert(n);
+        tree.erase(0);
+        correct = correct && valid(tree);
+    }
+    IntTree tree;
+    std::vector<int> unsorted = {1, 3, 2};
+    try{
+        tree.build_from_sorted(unsorted.begin(), unsorted.end());
+        correct = false;
+    }catch (const std::invalid_argument &){
+        correct = correct && tree.empty();
+    }
+    std::cout << "由有序序列建立: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// insert_many_test: 批量插入(小批量逐个插入, 大批量归并)以后与std::multiset相同, 原有节点的下标不变
+void insert_many_test()
+{
+    IntTree tree;
+    std::multiset<int> reference;
+    std::srand(11);
+    bool correct = true;
+    for (int round = 0; round != 40; ++round){
+        std::vector<int> batch;
+        for (int i = 0, m = round % 3 == 0 ? 2 : std::rand() % 400; i != m; ++i)
+            batch.push_back(std::rand() % 500);
+        IntTree::Index kept = tree.root();
+        int keptKey = kept == IntTree::nil ? 0 : tree.key(kept);
+        tree.insert_many(batch.begin(), batch.end());
+        reference.insert(batch.begin(), batch.end());
+        correct = correct && (kept == IntTree::nil || tree.key(kept) == keptKey) && valid(tree);
+        for (int i = 0; i != 30 && !reference.empty(); ++i){
+            int key = std::rand() % 500;
+            auto it = reference.find(key);
+            correct = correct && tree.erase(key) == (it != reference.end());
+            if (it != reference.end())
+                reference.erase(it);
+        }
+        auto it = reference.begin();
+        for (auto node = tree.minimum(tree.root()); node != IntTree::nil; node = tree.successor(node), ++it)
+            correct = correct && it != reference.end() && *it == tree.key(node);
+        correct = correct && it == reference.end() && tree.size() == reference.size() && valid(tree);
+    }
+    std::cout << "批量插入: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********pooled red black tree的插入测试********\n";
+    insert_test();
+    std::cout << "********pooled red black tree的随机测试********\n";
+    random_test();
+    std::cout << "********pooled red black tree的节点池测试********\n";
+    pool_test();
+    std::cout << "********pooled red black tree的build_from_sorted测试********\n";
+    build_test();
+    std::cout << "********pooled red black tree的insert_many测试********\n";
+    insert_many_test();
+    return 0;
+}
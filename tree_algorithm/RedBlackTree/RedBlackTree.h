@@ -7,8 +7,15 @@
 
 #ifndef _REDBLACKTREE_H
 #define _REDBLACKTREE_H
+#include <algorithm>
+#include <iostream>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
+#include "../NodeArena/NodeArena.h"
 #include "../RedBlackTreeNode/RedBlackTreeNode.h"
+#include "../TreeIterator/TreeIterator.h"
+#include "../TreeStats/TreeStats.h"
 // RedBlackTree: 红黑树 算法导论第13章
 /*
  * 由于没有采用书中所述的带哨兵的红黑树,所以边界条件的处理比较复杂.
@@ -30,6 +37,12 @@
  * 在O(lgn)时间内执行.
  *
  * INSERT和DELETE操作在红黑树上的在O(lgn)时间内执行.
+ *
+ * 批量操作: build_from_sorted由有序的关键字在O(n)时间内直接建立平衡的红黑树; insert_many先排序一批关键字,
+ * 再与树中原有的节点一次归并成平衡的红黑树. 它们创建的节点来自同一个NodeArena, 在内存中连续.
+ *
+ * 统计信息: stats()返回节点数, 高度, 黑高与节点占用的字节数; 在包含本头文件之前定义TREE_STATS时还有旋转次数,
+ * insert_fixup/delete_fixup的循环次数, lower_bound/upper_bound与successor访问的节点数(见TreeStats.h).
  */
 template<typename NodeType>
 class RedBlackTree
@@ -51,8 +64,55 @@ public:
     std::shared_ptr<NodeType> maximum(std::shared_ptr<NodeType>);   // 最大关键值元素
     std::shared_ptr<NodeType> successor(std::shared_ptr<NodeType>);     // 后继节点
     std::shared_ptr<NodeType> predecessor(std::shared_ptr<NodeType>);   // 前驱节点
+    template<typename Iterator>
+    void build_from_sorted(Iterator, Iterator);     // 由有序的关键字建立红黑树(替换原有的树), O(n)
+    template<typename Iterator>
+    void insert_many(Iterator, Iterator);   // 批量插入关键字, O(m logm + n)
+    //***************************迭代器与遍历(见TreeIterator.h)***********
+    typedef TreeIterator<NodeType> iterator;          // 按中序的双向迭代器, 关键字只读
+    typedef TreeIterator<NodeType> const_iterator;
+    iterator begin() const { return iterator(iterator::leftmost(root.get()), &root); }
+    iterator end() const { return iterator(nullptr, &root); }
+    iterator lower_bound(const KeyType &key) const
+    {
+        std::size_t visits = 0;
+        NodeType *node = tree_lower_bound(root.get(), key, &visits);
+        counters.recordSearch(visits);
+        return iterator(node, &root);
+    }
+    iterator upper_bound(const KeyType &key) const
+    {
+        std::size_t visits = 0;
+        NodeType *node = tree_upper_bound(root.get(), key, &visits);
+        counters.recordSearch(visits);
+        return iterator(node, &root);
+    }
+    // range: 关键字在闭区间[lo, hi]中的节点; 带f的版本对每个关键字调用f(key), 不使用引用计数
+    TreeRange<iterator> range(const KeyType &lo, const KeyType &hi) const
+    {
+        return hi < lo ? TreeRange<iterator>(end(), end()) : TreeRange<iterator>(lower_bound(lo), upper_bound(hi));
+    }
+    template<typename Function>
+    void range(const KeyType &lo, const KeyType &hi, Function f) const { visit_range(root.get(), lo, hi, f); }
+    // 非递归的中序/前序/后序遍历, 对每个关键字调用f(key)
+    template<typename Function>
+    void inorder_visit(Function f) const { visit_inorder(root.get(), f); }
+    template<typename Function>
+    void preorder_visit(Function f) const { visit_preorder(root.get(), f); }
+    template<typename Function>
+    void postorder_visit(Function f) const { visit_postorder(root.get(), f); }
+    //***************************统计信息(见TreeStats.h)*****************
+    TreeStats stats() const;
+    void resetStats() { counters.resetCounters(); }
     //***************************数据结构*********************************
     std::shared_ptr<NodeType> root;     // 红黑树的根节点
+private:
+    TreeStatsCounters counters;     // 运行时计数(定义TREE_STATS时)
+    static unsigned red_depth(std::size_t);   // n个节点的平衡树中涂红的一层
+    void inorder_nodes(std::vector<std::shared_ptr<NodeType>>&);   // 按中序取出树中所有的节点
+    std::shared_ptr<NodeType> link_balanced(const std::vector<std::shared_ptr<NodeType>>&, std::size_t,
+                                            std::size_t, unsigned, unsigned);   // 把有序的节点连接成平衡的红黑树
+    void link_all(const std::vector<std::shared_ptr<NodeType>>&);  // 用有序的节点替换整棵树
 };
 //**********************************成员函数******************************
 // left_rotate: 红黑树的左旋转操作
@@ -83,6 +143,7 @@ void RedBlackTree<NodeType>::left_rotate(std::shared_ptr<NodeType> node,
         throw std::invalid_argument("node is nullptr!!!");
         return;
     }
+    counters.recordLeftRotation();
     auto r_node = node->rchild;
     // r_node不是一个空指针
     if (r_node){
@@ -128,6 +189,7 @@ void RedBlackTree<NodeType>::right_rotate(std::shared_ptr<NodeType> node,
         throw std::invalid_argument("node is nullptr!!!");
         return;
     }
+    counters.recordRightRotation();
     auto l_node = node->lchild;
     // l_node不是一个空指针
     if (l_node){
@@ -195,6 +257,7 @@ void RedBlackTree<NodeType>::insert_fixup(std::shared_ptr<NodeType> node)
     }
     // 违反了性质4(进行修改)
     while (node_p->color == RED){
+        counters.recordInsertFixup();
         // 能进入这个循环暗含节点node的祖父节点一定存在
         auto uncle = std::shared_ptr<NodeType>();   // 叔叔节点
         auto node_p_p = node_p->parent.lock();
@@ -348,6 +411,7 @@ void RedBlackTree<NodeType>::delete_fixup(std::shared_ptr<NodeType> node)
 {
     std::shared_ptr<NodeType> w = std::shared_ptr<NodeType>();
     while (node != root && node && node->color == BLACK){
+        counters.recordDeleteFixup();
         if (node->is_left_child()){     // node是其父亲的左孩子
             auto node_p = node->parent.lock();  // 提取node的父亲节点
             w = node_p->rchild;
@@ -491,15 +555,12 @@ void RedBlackTree<NodeType>::remove(std::shared_ptr<NodeType> node)
 {
     if (!node)
         throw std::invalid_argument("node remove is nullptr!!!");
-    // 判定'node'必须在树中
-    auto temp = root;
-    while (temp && temp.get() != node.get()){
-        if (node->key < temp->key)
-            temp = temp->lchild;
-        else
-            temp = temp->rchild;
-    }
-    if (temp.get() != node.get())
+    // 判定'node'必须在树中: 沿父节点向上能到达根(有相等的关键字时, 旋转以后相等的关键字也可能在左子树中,
+    // 所以不能按关键字从根向下查找)
+    auto temp = node;
+    for (auto shared_p = temp->parent.lock(); shared_p; shared_p = shared_p->parent.lock())
+        temp = shared_p;
+    if (temp != root)
         throw std::invalid_argument("node removed must be in tree!!!");
     // 删除过程
     std::shared_ptr<NodeType> x = std::shared_ptr<NodeType>();
@@ -615,15 +676,23 @@ std::shared_ptr<NodeType> RedBlackTree<NodeType>::successor(std::shared_ptr<Node
 {
     if (!node)
         throw std::invalid_argument("successor() should not be aplied on nullptr!!!");
+    std::size_t visits = 1;     // 访问过的节点数(包括node)
     // 以右子节点为根的子树中的最小值就是'node'的后继节点
-    if (node->rchild)
-        return minimum(node->rchild);
+    if (node->rchild){
+        auto current = node->rchild;
+        for (++visits; current->lchild; ++visits)
+            current = current->lchild;
+        counters.recordSuccessor(visits);
+        return current;
+    }
     auto shared_p = node->parent.lock();    // 取出node的父亲节点
     auto current = node;
     while (shared_p && current->is_right_child()){
+        ++visits;
         current = shared_p;
         shared_p = current->parent.lock();
     }
+    counters.recordSuccessor(visits + (shared_p ? 1 : 0));
     return shared_p;
 }
 // predecessor: 红黑树的前驱节点
@@ -659,4 +728,131 @@ std::shared_ptr<NodeType> RedBlackTree<NodeType>::predecessor(std::shared_ptr<No
     }
     return shared_p;
 }
+// build_from_sorted: 由有序的关键字直接建立红黑树
+/*
+ * \parameter first, last: 非递减的关键字序列(KeyType), Iterator至少是前向迭代器;
+ * \return void. 原有的树被替换; 序列无序时抛出std::invalid_argument, 原有的树不变.
+ *
+ * 算法基本思想: 按顺序为每个关键字创建节点(来自同一个NodeArena, 控制块与节点连续分配), 再把第n / 2个节点作为根,
+ *      前n / 2个建立左子树, 其余的建立右子树. 这样的树中所有空的叶子都在最深的两层: 若最深的一层没有填满,
+ *      把这一层的节点涂成红色, 其余的涂成黑色, 每条路径上的黑色节点数相同, 满足红黑性质; 否则全部涂黑.
+ *      不比较关键字来决定位置, 不旋转, 不调用insert_fixup.
+ * 算法性能: 时间复杂度为O(n), 逐个insert需要O(nlogn).
+*/
+template<typename NodeType>
+template<typename Iterator>
+void RedBlackTree<NodeType>::build_from_sorted(Iterator first, Iterator last)
+{
+    auto nodes = arenaNodes<NodeType>(first, last);
+    for (std::size_t i = 1; i < nodes.size(); ++i)
+        if (nodes[i]->key < nodes[i - 1]->key)
+            throw std::invalid_argument("build_from_sorted() should be applied on sorted keys!!!");
+    link_all(nodes);
+}
+// insert_many: 批量插入关键字
+/*
+ * \parameter first, last: 任意次序的关键字;
+ * \return void.
+ *
+ * 算法基本思想: 复制并排序这一批关键字(m个), 按顺序创建节点. 若m相对于树中的节点数n很小(m * lg(n + m) < n),
+ *      逐个insert更快; 否则按中序取出原有的n个节点, 与新节点归并(相等的关键字原有的在前, 与insert相等时向右一致),
+ *      再像build_from_sorted一样重新连接并着色. 原有的节点对象保留(外部持有的shared_ptr仍然有效), 只改变链接与颜色.
+ * 算法性能: 时间复杂度为O(mlogm + n + m).
+*/
+template<typename NodeType>
+template<typename Iterator>
+void RedBlackTree<NodeType>::insert_many(Iterator first, Iterator last)
+{
+    std::vector<KeyType> keys(first, last);
+    if (keys.empty())
+        return;
+    std::sort(keys.begin(), keys.end());
+    auto batch = arenaNodes<NodeType>(keys.begin(), keys.end());
+    std::vector<std::shared_ptr<NodeType>> nodes;
+    inorder_nodes(nodes);
+    std::size_t total = nodes.size() + batch.size(), lg = 0;
+    while ((total >> lg) > 1)
+        ++lg;
+    if (batch.size() * lg < nodes.size()){
+        for (auto &node : batch){
+            node->color = BLACK;
+            insert(node);
+        }
+        return;
+    }
+    std::vector<std::shared_ptr<NodeType>> merged;
+    merged.reserve(total);
+    std::merge(nodes.begin(), nodes.end(), batch.begin(), batch.end(), std::back_inserter(merged),
+               [](const std::shared_ptr<NodeType> &a, const std::shared_ptr<NodeType> &b){ return a->key < b->key; });
+    nodes.clear();
+    link_all(merged);
+}
+// red_depth: n个节点按build_from_sorted的方式建立时, 最深的一层(从0开始)没有填满时返回这一层, 否则返回~0u
+template<typename NodeType>
+unsigned RedBlackTree<NodeType>::red_depth(std::size_t n)
+{
+    unsigned full = 0;  // 满的层数
+    while ((std::size_t(2) << full) - 1 <= n)
+        ++full;
+    return ((std::size_t(1) << full) - 1 == n) ? ~0u : full;
+}
+// inorder_nodes: 按中序把树中的节点放入nodes(显式的栈, 不递归)
+template<typename NodeType>
+void RedBlackTree<NodeType>::inorder_nodes(std::vector<std::shared_ptr<NodeType>> &nodes)
+{
+    std::vector<NodeType *> stack;
+    NodeType *current = root.get();
+    while (current || !stack.empty()){
+        while (current){
+            stack.push_back(current);
+            current = current->lchild.get();
+        }
+        current = stack.back();
+        stack.pop_back();
+        // 取得current的shared_ptr: 根由root持有, 其它节点由父节点持有
+        auto parent = current->parent.lock();
+        nodes.push_back(!parent ? root : (parent->lchild.get() == current ? parent->lchild : parent->rchild));
+        current = current->rchild.get();
+    }
+}
+// link_balanced: 把nodes[first, first + n)连接成深度为depth的平衡子树, 返回子树的根
+template<typename NodeType>
+std::shared_ptr<NodeType> RedBlackTree<NodeType>::link_balanced(const std::vector<std::shared_ptr<NodeType>> &nodes,
+                                                                std::size_t first, std::size_t n,
+                                                                unsigned depth, unsigned redDepth)
+{
+    if (n == 0)
+        return std::shared_ptr<NodeType>();
+    auto node = nodes[first + n / 2];
+    node->lchild = link_balanced(nodes, first, n / 2, depth + 1, redDepth);
+    node->rchild = link_balanced(nodes, first + n / 2 + 1, n - n / 2 - 1, depth + 1, redDepth);
+    if (node->lchild) node->lchild->parent = node;
+    if (node->rchild) node->rchild->parent = node;
+    node->color = depth == redDepth ? RED : BLACK;
+    return node;
+}
+// link_all: 用有序的nodes重新建立整棵树
+template<typename NodeType>
+void RedBlackTree<NodeType>::link_all(const std::vector<std::shared_ptr<NodeType>> &nodes)
+{
+    // 先断开原有的链接: 节点以后都由新的父节点持有
+    for (auto &node : nodes){
+        node->lchild.reset();
+        node->rchild.reset();
+    }
+    root = link_balanced(nodes, 0, nodes.size(), 0, red_depth(nodes.size()));
+    if (root)
+        root->parent.reset();
+}
+// stats: 统计信息. 黑高取最左侧的路径(满足红黑性质时每条路径相同)
+template<typename NodeType>
+TreeStats RedBlackTree<NodeType>::stats() const
+{
+    TreeStats result;
+    tree_shape_stats(root.get(), result);
+    for (const NodeType *node = root.get(); node; node = node->lchild.get())
+        result.blackHeight += node->color == BLACK ? 1 : 0;
+    counters.exportTo(result);
+    return result;
+}
 #endif
@@ -0,0 +1,371 @@
+/*************************************************************************
+	> File Name: RedBlackTreeJoin.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时45分35秒
+ ************************************************************************/
+
+#ifndef _REDBLACKTREEJOIN_H
+#define _REDBLACKTREEJOIN_H
+#include <memory>
+#include <stdexcept>
+#include "RedBlackTree.h"
+#include "../../parallel_algorithm/execution_policy/executionPolicy.h"
+// 基于join的红黑树集合操作 (Blelloch, Ferizovic, Sun: Just Join for Parallel Ordered Sets)
+/*
+ * 所有操作都只依赖一个基本操作join(L, k, R): L中的关键字 <= k <= R中的关键字, 把它们连接成一棵红黑树.
+ *      --join沿较高的树的右(左)脊下降到黑高与另一棵树相同的黑色节点, 在那里挂上红色的k, 再沿脊向上修复,
+ *        时间复杂度为O(|bh(L) - bh(R)| + 1);
+ *      --split(T, k)沿查找k的路径把T拆成小于k与大于k的两棵树, 路径上的子树用join重新连接, O(logn);
+ *      --union/intersection/difference用一棵树的根拆分另一棵树, 两边的子问题互不相交, 并行地递归, 再用join合并.
+ *        设m <= n为两棵树的大小, 总的工作量为O(m log(n / m + 1)), 关键路径长度为O(logn logm).
+ *
+ * 结果中的节点就是输入中的节点(只改变链接与颜色, 外部持有的shared_ptr仍然有效), 不复制关键字;
+ * 输入的树在操作以后为空. 集合操作把每棵树当作集合: 一棵树中有相等的关键字时结果仍然有序, 但保留的个数不确定.
+ *
+ */
+const int rb_parallel_height = 8;   // 黑高小于它的子树(少于255个节点)不再分出并行任务
+
+namespace rb_join_detail
+{
+    // Piece: 一棵独立的子树(根没有父节点)及其黑高, 空树的黑高为0
+    template<typename NodeType>
+    struct Piece
+    {
+        Piece(): root(), height(0) {  }
+        Piece(const std::shared_ptr<NodeType> &r, int h): root(r), height(h) {  }
+        std::shared_ptr<NodeType> root;
+        int height;
+    };
+
+    // blackHeight: 沿最左的路径数黑色节点
+    template<typename NodeType>
+    int blackHeight(const std::shared_ptr<NodeType> &root)
+    {
+        int height = 0;
+        for (NodeType *node = root.get(); node; node = node->lchild.get())
+            if (node->color == BLACK)
+                ++height;
+        return height;
+    }
+
+    // detach: 拆下树根的左右子树
+    template<typename NodeType>
+    void detach(const Piece<NodeType> &tree, Piece<NodeType> &left, Piece<NodeType> &right)
+    {
+        int height = tree.height - (tree.root->color == BLACK ? 1 : 0);
+        left = Piece<NodeType>(tree.root->lchild, height);
+        right = Piece<NodeType>(tree.root->rchild, height);
+        tree.root->lchild.reset();
+        tree.root->rchild.reset();
+        if (left.root) left.root->parent.reset();
+        if (right.root) right.root->parent.reset();
+    }
+
+    // join: 连接left, mid, right(left中的关键字 <= mid的关键字 <= right中的关键字)
+    /*
+     * 先把两棵树的根涂黑(黑高可能加1). 黑高相同时mid作为黑色的新根; 否则沿较高的树的右(左)脊下降到
+     * 黑高相同的黑色节点cur, 用红色的mid替换cur, cur与较矮的树分别成为mid的两个子树. 这时只可能在脊上出现
+     * 红色节点x的父节点p也是红色: 把x涂黑, 对p的(黑色)父节点g旋转, p取代g的位置且黑高不变, 再检查p的父节点.
+     * 最多修复到根, 结果的黑高等于较高的树的黑高(根可能是红色的). 不像insert_fixup那样把红色向上传递,
+     * 否则根的黑高可能增加, 需要重新计算.
+     */
+    template<typename NodeType>
+    Piece<NodeType> join(Piece<NodeType> left, const std::shared_ptr<NodeType> &mid, Piece<NodeType> right)
+    {
+        mid->parent.reset();
+        if (left.root && left.root->color == RED){
+            left.root->color = BLACK;
+            ++left.height;
+        }
+        if (right.root && right.root->color == RED){
+            right.root->color = BLACK;
+            ++right.height;
+        }
+        if (left.height == right.height){
+            mid->lchild = left.root;
+            mid->rchild = right.root;
+            if (left.root) left.root->parent = mid;
+            if (right.root) right.root->parent = mid;
+            mid->color = BLACK;
+            return Piece<NodeType>(mid, left.height + 1);
+        }
+        bool rightSpine = left.height > right.height;
+        Piece<NodeType> &taller = rightSpine ? left : right;
+        Piece<NodeType> &shorter = rightSpine ? right : left;
+        std::shared_ptr<NodeType> parent, cur = taller.root;
+        int height = taller.height;     // cur的黑高
+        while (cur && !(cur->color == BLACK && height == shorter.height)){
+            if (cur->color == BLACK)
+                --height;
+            parent = cur;
+            cur = rightSpine ? cur->rchild : cur->lchild;
+        }
+        // 树根的黑高大于shorter.height, 所以至少下降了一步, parent非空
+        if (rightSpine){
+            mid->lchild = cur;
+            mid->rchild = shorter.root;
+            parent->rchild = mid;
+        }else{
+            mid->lchild = shorter.root;
+            mid->rchild = cur;
+            parent->lchild = mid;
+        }
+        if (cur) cur->parent = mid;
+        if (shorter.root) shorter.root->parent = mid;
+        mid->parent = parent;
+        mid->color = RED;
+        RedBlackTree<NodeType> tree;
+        tree.root = taller.root;
+        for (std::shared_ptr<NodeType> x = mid; parent && parent->color == RED; parent = x->parent.lock()){
+            // 根是黑色的, 所以红色的parent一定有黑色的父节点grand
+            std::shared_ptr<NodeType> grand = parent->parent.lock();
+            x->color = BLACK;
+            if (rightSpine)
+                tree.left_rotate(grand, tree.root);
+            else
+                tree.right_rotate(grand, tree.root);
+            x = parent;
+        }
+        return Piece<NodeType>(tree.root, taller.height);
+    }
+
+    // splitLast: 拆下最大的节点, 其余的节点连接成一棵树
+    template<typename NodeType>
+    Piece<NodeType> splitLast(const Piece<NodeType> &tree, std::shared_ptr<NodeType> &last)
+    {
+        std::shared_ptr<NodeType> node = tree.root;
+        Piece<NodeType> left, right;
+        detach(tree, left, right);
+        if (!right.root){
+            last = node;
+            return left;
+        }
+        Piece<NodeType> rest = splitLast(right, last);
+        return join(left, node, rest);
+    }
+
+    // join2: 没有中间节点的连接(left中的关键字 <= right中的关键字)
+    template<typename NodeType>
+    Piece<NodeType> join2(const Piece<NodeType> &left, const Piece<NodeType> &right)
+    {
+        if (!left.root)
+            return right;
+        if (!right.root)
+            return left;
+        std::shared_ptr<NodeType> last;
+        Piece<NodeType> rest = splitLast(left, last);
+        return join(rest, last, right);
+    }
+
+    // split: 把tree拆成less与greater, 返回一个关键字等于key的节点(没有时为空)
+    template<typename NodeType>
+    std::shared_ptr<NodeType> split(const Piece<NodeType> &tree, const typename NodeType::KeyType &key,
+                                    Piece<NodeType> &less, Piece<NodeType> &greater)
+    {
+        if (!tree.root){
+            less = greater = Piece<NodeType>();
+            return std::shared_ptr<NodeType>();
+        }
+        std::shared_ptr<NodeType> node = tree.root;
+        Piece<NodeType> left, right;
+        detach(tree, left, right);
+        if (key < node->key){
+            Piece<NodeType> middle;
+            std::shared_ptr<NodeType> equal = split(left, key, less, middle);
+            greater = join(middle, node, right);
+            return equal;
+        }
+        if (node->key < key){
+            Piece<NodeType> middle;
+            std::shared_ptr<NodeType> equal = split(right, key, middle, greater);
+            less = join(left, node, middle);
+            return equal;
+        }
+        less = left;
+        greater = right;
+        return node;
+    }
+
+    // forkJoin: 子树足够大且有线程池时, f交给线程池, 当前线程执行g, 再等待f完成
+    template<typename FunctionF, typename FunctionG>
+    void forkJoin(WorkStealingPool *pool, int height, FunctionF f, FunctionG g)
+    {
+        if (pool && height >= rb_parallel_height){
+            TaskGroup group(*pool);
+            group.run(f);
+            g();
+            group.wait();
+        }else{
+            f();
+            g();
+        }
+    }
+
+    template<typename NodeType>
+    Piece<NodeType> unite(const Piece<NodeType> &a, const Piece<NodeType> &b, WorkStealingPool *pool)
+    {
+        if (!a.root)
+            return b;
+        if (!b.root)
+            return a;
+        std::shared_ptr<NodeType> node = a.root;
+        Piece<NodeType> al, ar, bl, br, l, r;
+        detach(a, al, ar);
+        split(b, node->key, bl, br);    // b中与node相等的节点被丢弃
+        forkJoin(pool, a.height, [&]{ l = unite(al, bl, pool); }, [&]{ r = unite(ar, br, pool); });
+        return join(l, node, r);
+    }
+
+    template<typename NodeType>
+    Piece<NodeType> intersect(const Piece<NodeType> &a, const Piece<NodeType> &b, WorkStealingPool *pool)
+    {
+        if (!a.root || !b.root)
+            return Piece<NodeType>();
+        std::shared_ptr<NodeType> node = a.root;
+        Piece<NodeType> al, ar, bl, br, l, r;
+        detach(a, al, ar);
+        bool found = static_cast<bool>(split(b, node->key, bl, br));
+        forkJoin(pool, a.height, [&]{ l = intersect(al, bl, pool); }, [&]{ r = intersect(ar, br, pool); });
+        return found ? join(l, node, r) : join2(l, r);
+    }
+
+    template<typename NodeType>
+    Piece<NodeType> subtract(const Piece<NodeType> &a, const Piece<NodeType> &b, WorkStealingPool *pool)
+    {
+        if (!a.root || !b.root)
+            return a;
+        std::shared_ptr<NodeType> node = b.root;
+        Piece<NodeType> al, ar, bl, br, l, r;
+        detach(b, bl, br);
+        split(a, node->key, al, ar);    // a中与node相等的节点被丢弃
+        forkJoin(pool, a.height, [&]{ l = subtract(al, bl, pool); }, [&]{ r = subtract(ar, br, pool); });
+        return join2(l, r);
+    }
+
+    // take: 取出一棵树的全部节点, 树变为空
+    template<typename NodeType>
+    Piece<NodeType> take(RedBlackTree<NodeType> &tree)
+    {
+        Piece<NodeType> piece(tree.root, blackHeight(tree.root));
+        tree.root.reset();
+        return piece;
+    }
+
+    template<typename NodeType>
+    RedBlackTree<NodeType> toTree(const Piece<NodeType> &piece)
+    {
+        RedBlackTree<NodeType> tree;
+        tree.root = piece.root;
+        if (tree.root)
+            tree.root->color = BLACK;
+        return tree;
+    }
+
+    // setOperation: threads > 1时足够大的树在共享的线程池(sharedWorkStealingPool)中执行
+    template<typename NodeType, typename Operation>
+    RedBlackTree<NodeType> setOperation(RedBlackTree<NodeType> &a, RedBlackTree<NodeType> &b,
+                                        std::size_t threads, Operation operation)
+    {
+        Piece<NodeType> pa = take(a), pb = take(b);
+        if (threads <= 1 || (pa.height < rb_parallel_height && pb.height < rb_parallel_height))
+            return toTree(operation(pa, pb, static_cast<WorkStealingPool *>(nullptr)));
+        return toTree(operation(pa, pb, &sharedWorkStealingPool()));
+    }
+}
+
+// rb_join: 连接两棵红黑树与一个节点
+/*
+ * \parameter left: 关键字都不大于node的关键字的树, 操作以后为空;
+ * \parameter node: 中间的节点(不在任何树中), 成为结果中的一个节点;
+ * \parameter right: 关键字都不小于node的关键字的树, 操作以后为空;
+ * \return 连接以后的红黑树. node为空或者关键字的次序不满足要求时抛出std::invalid_argument, 输入的树不变.
+ *
+ * 算法性能: 时间复杂度为O(logn)(检查次序需要找到left的最大值与right的最小值, 连接本身为O(|bh(left) - bh(right)| + 1)).
+ */
+template<typename NodeType>
+RedBlackTree<NodeType> rb_join(RedBlackTree<NodeType> &left, const std::shared_ptr<NodeType> &node,
+                               RedBlackTree<NodeType> &right)
+{
+    if (!node)
+        throw std::invalid_argument("node is nullptr!!!");
+    NodeType *max = left.root.get(), *min = right.root.get();
+    while (max && max->rchild)
+        max = max->rchild.get();
+    while (min && min->lchild)
+        min = min->lchild.get();
+    if ((max && node->key < max->key) || (min && min->key < node->key))
+        throw std::invalid_argument("rb_join() requires left keys <= node key <= right keys!!!");
+    node->lchild.reset();
+    node->rchild.reset();
+    rb_join_detail::Piece<NodeType> l = rb_join_detail::take(left), r = rb_join_detail::take(right);
+    return rb_join_detail::toTree(rb_join_detail::join(l, node, r));
+}
+
+// rb_join: 连接两棵红黑树(left中的关键字都不大于right中的关键字), 次序不满足要求时抛出std::invalid_argument
+template<typename NodeType>
+RedBlackTree<NodeType> rb_join(RedBlackTree<NodeType> &left, RedBlackTree<NodeType> &right)
+{
+    NodeType *max = left.root.get(), *min = right.root.get();
+    while (max && max->rchild)
+        max = max->rchild.get();
+    while (min && min->lchild)
+        min = min->lchild.get();
+    if (max && min && min->key < max->key)
+        throw std::invalid_argument("rb_join() requires left keys <= right keys!!!");
+    rb_join_detail::Piece<NodeType> l = rb_join_detail::take(left), r = rb_join_detail::take(right);
+    return rb_join_detail::toTree(rb_join_detail::join2(l, r));
+}
+
+// rb_split: 按关键字拆分一棵红黑树
+/*
+ * \parameter tree: 待拆分的树, 操作以后为空;
+ * \parameter key: 拆分的关键字;
+ * \parameter less: 返回关键字小于key的节点组成的树(原有的内容被替换);
+ * \parameter greater: 返回关键字大于key的节点组成的树(原有的内容被替换);
+ * \return 一个关键字等于key的节点(已从树中拆下), 没有时为空.
+ *
+ * tree中有多个等于key的关键字时, 只返回其中一个, 其余的可能在less或greater中.
+ * 算法性能: 时间复杂度为O(logn).
+ */
+template<typename NodeType>
+std::shared_ptr<NodeType> rb_split(RedBlackTree<NodeType> &tree, const typename NodeType::KeyType &key,
+                                   RedBlackTree<NodeType> &less, RedBlackTree<NodeType> &greater)
+{
+    rb_join_detail::Piece<NodeType> whole = rb_join_detail::take(tree), l, r;
+    std::shared_ptr<NodeType> equal = rb_join_detail::split(whole, key, l, r);
+    less = rb_join_detail::toTree(l);
+    greater = rb_join_detail::toTree(r);
+    return equal;
+}
+
+// rb_union / rb_intersection / rb_difference: 两棵红黑树的并集, 交集与差集(a - b)
+/*
+ * \parameter a, b: 输入的两棵树, 操作以后都为空(结果中没有用到的节点被释放);
+ * \parameter threads: 不大于1时单线程计算, 否则两棵树足够大时在共享的线程池中fork-join(并发的线程数不超过线程池的大小加1);
+ * \return 结果的红黑树.
+ *
+ * 关键字相等时并集与交集保留a中的节点.
+ * 算法性能: 设m <= n为两棵树的大小, 工作量为O(m log(n / m + 1)), 关键路径长度为O(logn logm).
+ */
+template<typename NodeType>
+RedBlackTree<NodeType> rb_union(RedBlackTree<NodeType> &a, RedBlackTree<NodeType> &b,
+                                std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    return rb_join_detail::setOperation(a, b, threads, rb_join_detail::unite<NodeType>);
+}
+
+template<typename NodeType>
+RedBlackTree<NodeType> rb_intersection(RedBlackTree<NodeType> &a, RedBlackTree<NodeType> &b,
+                                       std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    return rb_join_detail::setOperation(a, b, threads, rb_join_detail::intersect<NodeType>);
+}
+
+template<typename NodeType>
+RedBlackTree<NodeType> rb_difference(RedBlackTree<NodeType> &a, RedBlackTree<NodeType> &b,
+                                     std::size_t threads = WorkStealingPool::defaultThreads())
+{
+    return rb_join_detail::setOperation(a, b, threads, rb_join_detail::subtract<NodeType>);
+}
+#endif
@@ -0,0 +1,64 @@
+/*************************************************************************
+	> File Name: RedBlackTreeJoin_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时48分18秒
+ ************************************************************************/
+// 两棵红黑树的并集: 逐个insert与基于join的rb_union的对比, 以CSV格式输出
+/*
+ * 用法: ./JoinBench [较大的树的大小n(默认200000)]
+ *      a中有n个偶数关键字, b中有m个随机关键字(m = n / 1000, n / 30, n); b中与a相同的关键字在insert时也被插入.
+ *
+ * 输出的每一行: method,n,m,threads,ms
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "RedBlackTreeJoin.h"
+typedef RedBlackTreeNode<int> Node;
+typedef std::chrono::steady_clock Clock;
+
+double millisecondsSince(Clock::time_point begin)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    std::vector<int> x;
+    for (std::size_t i = 0; i != n; ++i)
+        x.push_back(static_cast<int>(2 * i));
+    std::srand(3);
+    std::cout << "method,n,m,threads,ms\n";
+    const std::size_t ms[] = {n / 1000, n / 30, n};
+    for (std::size_t m : ms){
+        std::vector<int> y;
+        for (std::size_t i = 0; i != m; ++i)
+            y.push_back(std::rand() % static_cast<int>(4 * n));
+        std::sort(y.begin(), y.end());
+        y.erase(std::unique(y.begin(), y.end()), y.end());
+        {
+            RedBlackTree<Node> a, b;
+            a.build_from_sorted(x.begin(), x.end());
+            b.build_from_sorted(y.begin(), y.end());
+            auto begin = Clock::now();
+            for (auto it = b.begin(); it != b.end(); ++it)
+                a.insert(std::make_shared<Node>(*it));
+            std::cout << "insert," << n << ',' << y.size() << ",1," << millisecondsSince(begin) << std::endl;
+        }
+        const std::size_t threads[] = {1, WorkStealingPool::defaultThreads()};
+        for (std::size_t t : threads){
+            RedBlackTree<Node> a, b;
+            a.build_from_sorted(x.begin(), x.end());
+            b.build_from_sorted(y.begin(), y.end());
+            auto begin = Clock::now();
+            auto result = rb_union(a, b, t);
+            std::cout << "rb_union," << n << ',' << y.size() << ',' << t << ',' << millisecondsSince(begin) << std::endl;
+        }
+    }
+    return 0;
+}
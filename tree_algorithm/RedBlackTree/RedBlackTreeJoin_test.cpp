@@ -0,0 +1,143 @@
+/*************************************************************************
+	> File Name: RedBlackTreeJoin_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时51分01秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "RedBlackTreeJoin.h"
+typedef RedBlackTreeNode<int> Node;
+typedef RedBlackTree<Node> IntTree;
+
+// blackHeight: 检查以node为根的子树的红黑性质与父节点链接, 返回黑高(不满足时返回-1)
+int blackHeight(const std::shared_ptr<Node> &node)
+{
+    if (!node)
+        return 0;
+    const std::shared_ptr<Node> &l = node->lchild, &r = node->rchild;
+    if ((l && (l->parent.lock() != node || node->key < l->key)) ||
+        (r && (r->parent.lock() != node || r->key < node->key)))
+        return -1;
+    if (node->color == RED && ((l && l->color == RED) || (r && r->color == RED)))
+        return -1;
+    int lh = blackHeight(l), rh = blackHeight(r);
+    if (lh < 0 || lh != rh)
+        return -1;
+    return lh + (node->color == BLACK ? 1 : 0);
+}
+bool valid(const IntTree &tree)
+{
+    return !tree.root || (tree.root->color == BLACK && !tree.root->parent.lock() && blackHeight(tree.root) > 0);
+}
+std::vector<int> keys(const IntTree &tree)
+{
+    std::vector<int> result;
+    tree.inorder_visit([&](int key){ result.push_back(key); });
+    return result;
+}
+// randomSet: n个互不相同的随机关键字(有序)
+std::vector<int> randomSet(std::size_t n, int range)
+{
+    std::set<int> set;
+    while (set.size() < n)
+        set.insert(std::rand() % range);
+    return std::vector<int>(set.begin(), set.end());
+}
+IntTree makeTree(const std::vector<int> &sorted)
+{
+    IntTree tree;
+    tree.build_from_sorted(sorted.begin(), sorted.end());
+    return tree;
+}
+
+// join_split_test: 不同黑高的树连接以后满足红黑性质; 在每个位置拆分以后两部分正确
+void join_split_test()
+{
+    bool correct = true;
+    for (int n = 0; n != 60; ++n){
+        for (int cut = 0; cut <= n; cut += 3){
+            std::vector<int> left, right;
+            for (int i = 0; i != cut; ++i)
+                left.push_back(i);
+            for (int i = cut + 1; i <= n; ++i)
+                right.push_back(i);
+            // 逐个插入得到与build_from_sorted不同形状(有红色节点)的树
+            IntTree l = makeTree(left), r;
+            for (int key : right)
+                r.insert(std::make_shared<Node>(key));
+            auto joined = rb_join(l, std::make_shared<Node>(cut), r);
+            std::vector<int> expected;
+            for (int i = 0; i <= n; ++i)
+                expected.push_back(i);
+            correct = correct && valid(joined) && keys(joined) == expected && !l.root && !r.root;
+
+            IntTree less, greater;
+            auto equal = rb_split(joined, cut, less, greater);
+            correct = correct && equal && equal->key == cut && valid(less) && valid(greater) && !joined.root;
+            correct = correct && keys(less) == left && keys(greater) == right;
+            auto absent = rb_split(less, -1, less, greater);
+            correct = correct && !absent && !less.root && keys(greater) == left;
+            auto rejoined = rb_join(greater, less);
+            correct = correct && valid(rejoined) && keys(rejoined) == left;
+        }
+    }
+    IntTree a = makeTree(std::vector<int>{1, 2, 3}), b = makeTree(std::vector<int>{5, 6});
+    try{
+        rb_join(a, std::make_shared<Node>(7), b);
+        correct = false;
+    }catch (const std::invalid_argument &){
+        correct = correct && keys(a).size() == 3 && keys(b).size() == 2;
+    }
+    std::cout << "join与split: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// set_test: 各种大小比例的集合操作与std::set_union等的结果相同, 结果中的节点来自输入
+void set_test(std::size_t threads)
+{
+    bool correct = true;
+    const std::size_t sizes[][2] = {{0, 0}, {0, 50}, {1, 1000}, {30, 20000}, {3000, 3000}, {20000, 500}, {50000, 40000}};
+    for (auto &size : sizes){
+        std::vector<int> x = randomSet(size[0], 200000), y = randomSet(size[1], 200000), expected;
+        for (int op = 0; op != 3; ++op){
+            IntTree a = makeTree(x), b = makeTree(y);
+            std::set<Node *> inputs;
+            for (auto it = a.begin(); it != a.end(); ++it)
+                inputs.insert(it.node());
+            for (auto it = b.begin(); it != b.end(); ++it)
+                inputs.insert(it.node());
+            expected.clear();
+            IntTree result;
+            if (op == 0){
+                std::set_union(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(expected));
+                result = rb_union(a, b, threads);
+            }else if (op == 1){
+                std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(expected));
+                result = rb_intersection(a, b, threads);
+            }else{
+                std::set_difference(x.begin(), x.end(), y.begin(), y.end(), std::back_inserter(expected));
+                result = rb_difference(a, b, threads);
+            }
+            correct = correct && !a.root && !b.root && valid(result) && keys(result) == expected;
+            for (auto it = result.begin(); it != result.end(); ++it)
+                correct = correct && inputs.count(it.node()) == 1;
+        }
+    }
+    std::cout << threads << "个线程的并集, 交集与差集: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::srand(5);
+    std::cout << "********red black tree的join/split测试********\n";
+    join_split_test();
+    std::cout << "********red black tree的集合操作测试********\n";
+    set_test(1);
+    set_test(4);
+    return 0;
+}
@@ -7,6 +7,10 @@
 
 #include <iostream>
 using std::cout;    using std::endl;
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
 #include "RedBlackTree.h"
 typedef RedBlackTree<RedBlackTreeNode<int>> IntTree;
 typedef RedBlackTreeNode<int> Node;
@@ -76,9 +80,99 @@ bool setUp()
         
     }
 }
+// blackHeight: 检查以node为根的子树的红黑性质与父节点链接, 返回黑高(不满足时返回-1)
+int blackHeight(const std::shared_ptr<Node> &node)
+{
+    if (!node)
+        return 1;
+    for (auto &child : {node->lchild, node->rchild})
+        if (child && (child->parent.lock() != node || (node->color == RED && child->color == RED)))
+            return -1;
+    if ((node->lchild && node->key < node->lchild->key) || (node->rchild && node->rchild->key < node->key))
+        return -1;
+    int l = blackHeight(node->lchild), r = blackHeight(node->rchild);
+    if (l < 0 || l != r)
+        return -1;
+    return l + (node->color == BLACK ? 1 : 0);
+}
+// inorderKeys: 按后继操作取出所有的关键字
+std::vector<int> inorderKeys(IntTree &tree)
+{
+    std::vector<int> keys;
+    if (!tree.root)
+        return keys;
+    for (auto node = tree.minimum(tree.root); node; node = tree.successor(node))
+        keys.push_back(node->key);
+    return keys;
+}
+// bulk_test: build_from_sorted与insert_many以后满足红黑性质, 关键字与逐个插入相同
+void bulk_test()
+{
+    cout << "**********************批量建立与批量插入测试**************************\n";
+    bool correct = true;
+    std::srand(3);
+    for (int n = 1; n != 200; ++n){
+        std::vector<int> keys;
+        for (int i = 0; i != n; ++i)
+            keys.push_back(std::rand() % 100);
+        std::sort(keys.begin(), keys.end());
+        IntTree tree;
+        tree.build_from_sorted(keys.begin(), keys.end());
+        correct = correct && !tree.root->parent.lock() && tree.root->color == BLACK &&
+                  blackHeight(tree.root) > 0 && inorderKeys(tree) == keys;
+        // 小批量逐个插入, 大批量归并
+        for (int m : {1, n}){
+            std::vector<int> batch;
+            for (int i = 0; i != m; ++i)
+                batch.push_back(std::rand() % 100);
+            auto kept = tree.root;
+            tree.insert_many(batch.begin(), batch.end());
+            keys.insert(keys.end(), batch.begin(), batch.end());
+            std::sort(keys.begin(), keys.end());
+            correct = correct && blackHeight(tree.root) > 0 && inorderKeys(tree) == keys;
+            // 原有的节点对象仍然在树中
+            auto top = kept;
+            while (top->parent.lock())
+                top = top->parent.lock();
+            correct = correct && top == tree.root;
+        }
+    }
+    IntTree tree;
+    int unsorted[] = {1, 3, 2};
+    try{
+        tree.build_from_sorted(unsorted, unsorted + 3);
+        correct = false;
+    }catch (const std::invalid_argument &){
+        correct = correct && !tree.root;
+    }
+    tree.insert_many(unsorted, unsorted + 3);
+    correct = correct && inorderKeys(tree) == std::vector<int>({1, 2, 3});
+    cout << "批量建立与批量插入: " << (correct ? "正确" : "错误") << endl;
+}
+// iterator_test: 迭代器, lower_bound/upper_bound与区间查询
+void iterator_test()
+{
+    cout << "**********************迭代器与区间查询测试****************************\n";
+    IntTree tree;
+    std::vector<int> keys;
+    for (int i = 0; i != 100; ++i)
+        keys.push_back(i * 2);
+    tree.build_from_sorted(keys.begin(), keys.end());
+    bool correct = std::vector<int>(tree.begin(), tree.end()) == keys && *--tree.end() == 198;
+    correct = correct && *tree.lower_bound(31) == 32 && *tree.lower_bound(32) == 32 && *tree.upper_bound(32) == 34;
+    correct = correct && tree.lower_bound(199) == tree.end() && tree.upper_bound(198) == tree.end();
+    int sum = 0, count = 0;
+    for (int key : tree.range(10, 20))
+        sum += key;
+    tree.range(10, 20, [&count](const int &){ ++count; });
+    correct = correct && sum == 10 + 12 + 14 + 16 + 18 + 20 && count == 6;
+    cout << "迭代器与区间查询: " << (correct ? "正确" : "错误") << endl;
+}
 int main()
 {
     setUp();
+    bulk_test();
+    iterator_test();
     return 0;
 }
 
@@ -0,0 +1,276 @@
+/*************************************************************************
+	> File Name: TreeIterator.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时38分21秒
+ ************************************************************************/
+
+#ifndef _TREEITERATOR_H
+#define _TREEITERATOR_H
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+// 共享指针链接的二叉搜索树(BinarySearchTree, RedBlackTree)的迭代器与遍历
+/*
+ * 节点类型NodeType需要有lchild/rchild(std::shared_ptr), parent(std::weak_ptr)与key成员.
+ *
+ *      --TreeIterator: 双向迭代器, 按中序访问关键字, 只保存裸指针, 不分配内存. 向下走用lchild.get()/rchild.get(),
+ *        没有引用计数的操作; 向上走需要lock父节点的weak_ptr(再立即释放), 完整的一次遍历中每条边只向上走一次,
+ *        平均每次++不到一次lock;
+ *      --tree_lower_bound/tree_upper_bound: 从根向下查找, O(h), 只要中序是非递减的就正确(允许相等的关键字在任意一侧);
+ *      --visit_inorder/visit_preorder/visit_postorder/visit_range: 用显式的栈遍历, 不递归(退化成链表的树也不会栈溢出),
+ *        只用裸指针, 没有任何引用计数的操作. 访问函数f是模板参数, 可以被内联, 可以是捕获状态的lambda.
+ *        栈的前tree_stack_inline个元素在栈上, 只有树的高度更大时才分配内存.
+ *
+ * 迭代器与遍历都不能在修改树的同时使用: 插入或删除以后, 除了指向被删除节点的迭代器以外,
+ * 迭代器仍然指向原来的节点, 但是遍历的顺序按照新的链接.
+ *
+ */
+
+const std::size_t tree_stack_inline = 64;      // 遍历用的栈放在对象内部的元素个数
+
+// TreeStack: 遍历用的栈, 不超过tree_stack_inline个元素时不分配内存
+template<typename T>
+class TreeStack
+{
+public:
+    TreeStack() : count(0) {  }
+    TreeStack(const TreeStack &) = delete;
+    TreeStack& operator=(const TreeStack &) = delete;
+    void push(const T &value)
+    {
+        if (count < tree_stack_inline)
+            local[count] = value;
+        else
+            overflow.push_back(value);
+        ++count;
+    }
+    T pop()
+    {
+        --count;
+        if (count < tree_stack_inline)
+            return local[count];
+        T value = overflow.back();
+        overflow.pop_back();
+        return value;
+    }
+    T& top() { return count <= tree_stack_inline ? local[count - 1] : overflow.back(); }
+    bool empty() const { return count == 0; }
+private:
+    T local[tree_stack_inline];
+    std::vector<T> overflow;
+    std::size_t count;
+};
+
+// TreeIterator: 按中序访问树中关键字的双向迭代器
+template<typename NodeType>
+class TreeIterator
+{
+public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename NodeType::KeyType value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;    // 修改关键字会破坏搜索树的性质, 只能读
+
+    TreeIterator() : current(nullptr), root(nullptr) {  }
+    // node为空时是end(), 从end()执行--需要root(树的根节点的地址)
+    TreeIterator(NodeType *node, const std::shared_ptr<NodeType> *treeRoot) : current(node), root(treeRoot) {  }
+
+    reference operator*() const { return current->key; }
+    pointer operator->() const { return &current->key; }
+    NodeType* node() const { return current; }  // 当前节点, end()为nullptr
+    TreeIterator& operator++()
+    {
+        if (current->rchild){
+            current = leftmost(current->rchild.get());
+            return *this;
+        }
+        // 向上直到从左子树上来
+        NodeType *child = current;
+        current = parentOf(child);
+        while (current && current->rchild.get() == child){
+            child = current;
+            current = parentOf(current);
+        }
+        return *this;
+    }
+    TreeIterator& operator--()
+    {
+        if (!current){
+            current = rightmost(root->get());
+            return *this;
+        }
+        if (current->lchild){
+            current = rightmost(current->lchild.get());
+            return *this;
+        }
+        NodeType *child = current;
+        current = parentOf(child);
+        while (current && current->lchild.get() == child){
+            child = current;
+            current = parentOf(current);
+        }
+        return *this;
+    }
+    TreeIterator operator++(int) { TreeIterator old = *this; ++*this; return old; }
+    TreeIterator operator--(int) { TreeIterator old = *this; --*this; return old; }
+    bool operator==(const TreeIterator &other) const { return current == other.current; }
+    bool operator!=(const TreeIterator &other) const { return current != other.current; }
+
+    static NodeType* leftmost(NodeType *node)
+    {
+        while (node && node->lchild)
+            node = node->lchild.get();
+        return node;
+    }
+    static NodeType* rightmost(NodeType *node)
+    {
+        while (node && node->rchild)
+            node = node->rchild.get();
+        return node;
+    }
+private:
+    // 父节点一定由树持有, lock得到的shared_ptr释放以后裸指针仍然有效
+    static NodeType* parentOf(NodeType *node) { return node->parent.lock().get(); }
+    NodeType *current;
+    const std::shared_ptr<NodeType> *root;
+};
+
+// TreeRange: 一对迭代器, 可以用于范围for语句
+template<typename Iterator>
+struct TreeRange
+{
+    TreeRange(Iterator b, Iterator e) : first(b), last(e) {  }
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+    bool empty() const { return first == last; }
+    Iterator first;
+    Iterator last;
+};
+
+// tree_lower_bound: 中序中第一个关键字不小于key的节点, 没有时为nullptr; visits非空时返回访问过的节点数
+template<typename NodeType>
+NodeType* tree_lower_bound(NodeType *node, const typename NodeType::KeyType &key, std::size_t *visits = nullptr)
+{
+    NodeType *result = nullptr;
+    std::size_t count = 0;
+    for (; node; ++count){
+        if (node->key < key)
+            node = node->rchild.get();
+        else{
+            result = node;
+            node = node->lchild.get();
+        }
+    }
+    if (visits)
+        *visits = count;
+    return result;
+}
+// tree_upper_bound: 中序中第一个关键字大于key的节点, 没有时为nullptr; visits非空时返回访问过的节点数
+template<typename NodeType>
+NodeType* tree_upper_bound(NodeType *node, const typename NodeType::KeyType &key, std::size_t *visits = nullptr)
+{
+    NodeType *result = nullptr;
+    std::size_t count = 0;
+    for (; node; ++count){
+        if (key < node->key){
+            result = node;
+            node = node->lchild.get();
+        }else
+            node = node->rchild.get();
+    }
+    if (visits)
+        *visits = count;
+    return result;
+}
+
+// visit_inorder: 中序遍历, 对每个关键字调用f(key)
+template<typename NodeType, typename Function>
+void visit_inorder(NodeType *node, Function f)
+{
+    TreeStack<NodeType *> stack;
+    for (;;){
+        while (node){
+            stack.push(node);
+            node = node->lchild.get();
+        }
+        if (stack.empty())
+            return;
+        node = stack.pop();
+        f(node->key);
+        node = node->rchild.get();
+    }
+}
+// visit_preorder: 前序遍历(先压入右子节点, 再压入左子节点)
+template<typename NodeType, typename Function>
+void visit_preorder(NodeType *node, Function f)
+{
+    if (!node)
+        return;
+    TreeStack<NodeType *> stack;
+    stack.push(node);
+    while (!stack.empty()){
+        node = stack.pop();
+        f(node->key);
+        if (node->rchild)
+            stack.push(node->rchild.get());
+        if (node->lchild)
+            stack.push(node->lchild.get());
+    }
+}
+// visit_postorder: 后序遍历
+/*
+ * 栈顶节点的右子树为空或者刚刚访问完(last是它的右子节点)时访问它, 否则转到右子树.
+*/
+template<typename NodeType, typename Function>
+void visit_postorder(NodeType *node, Function f)
+{
+    TreeStack<NodeType *> stack;
+    NodeType *last = nullptr;
+    for (;;){
+        while (node){
+            stack.push(node);
+            node = node->lchild.get();
+        }
+        if (stack.empty())
+            return;
+        NodeType *top = stack.top();
+        if (top->rchild && top->rchild.get() != last)
+            node = top->rchild.get();
+        else{
+            f(top->key);
+            last = stack.pop();
+        }
+    }
+}
+// visit_range: 按中序对关键字在闭区间[lo, hi]中的节点调用f(key)
+/*
+ * 关键字小于lo的节点不入栈, 直接转到右子树(它的左子树也都小于lo); 出栈的节点大于hi时结束.
+ * 访问的节点为O(h + k)个, k为结果的个数.
+*/
+template<typename NodeType, typename Function>
+void visit_range(NodeType *node, const typename NodeType::KeyType &lo, const typename NodeType::KeyType &hi,
+                 Function f)
+{
+    TreeStack<NodeType *> stack;
+    for (;;){
+        while (node){
+            if (node->key < lo)
+                node = node->rchild.get();
+            else{
+                stack.push(node);
+                node = node->lchild.get();
+            }
+        }
+        if (stack.empty())
+            return;
+        node = stack.pop();
+        if (hi < node->key)
+            return;
+        f(node->key);
+        node = node->rchild.get();
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+/*************************************************************************
+	> File Name: TreeIterator_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时41分04秒
+ ************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "../binary_search_tree/binary_search_tree.h"
+typedef BinaryTreeNode<int> Node;
+typedef BinarySearchTree<Node> IntTree;
+
+// 递归的参考实现
+void preorder(const std::shared_ptr<Node> &node, std::vector<int> &out)
+{
+    if (!node)
+        return;
+    out.push_back(node->key);
+    preorder(node->lchild, out);
+    preorder(node->rchild, out);
+}
+void postorder(const std::shared_ptr<Node> &node, std::vector<int> &out)
+{
+    if (!node)
+        return;
+    postorder(node->lchild, out);
+    postorder(node->rchild, out);
+    out.push_back(node->key);
+}
+
+// iterator_test: 正向, 反向遍历与lower_bound/upper_bound/range和有序数组的结果相同
+void iterator_test()
+{
+    IntTree tree;
+    std::vector<int> keys;
+    std::srand(17);
+    for (int i = 0; i != 3000; ++i){
+        keys.push_back(std::rand() % 1000);     // 有相等的关键字
+        tree.insert(std::make_shared<Node>(keys.back()));
+    }
+    std::sort(keys.begin(), keys.end());
+    bool correct = std::vector<int>(tree.begin(), tree.end()) == keys && std::distance(tree.begin(), tree.end()) == 3000;
+    std::vector<int> backward;
+    for (auto it = tree.end(); it != tree.begin(); )
+        backward.push_back(*--it);
+    correct = correct && std::equal(backward.rbegin(), backward.rend(), keys.begin());
+    for (int q = 0; q != 300; ++q){
+        int lo = std::rand() % 1100 - 50, hi = lo + std::rand() % 100;
+        auto first = std::lower_bound(keys.begin(), keys.end(), lo), last = std::upper_bound(keys.begin(), keys.end(), hi);
+        std::vector<int> expected(first, last), byIterator, byVisitor;
+        for (int key : tree.range(lo, hi))
+            byIterator.push_back(key);
+        tree.range(lo, hi, [&byVisitor](const int &key){ byVisitor.push_back(key); });
+        correct = correct && byIterator == expected && byVisitor == expected;
+        auto lower = tree.lower_bound(lo);
+        correct = correct && (first == keys.end() ? lower == tree.end() : *lower == *first);
+        auto upper = tree.upper_bound(hi);
+        correct = correct && (last == keys.end() ? upper == tree.end() : *upper == *last);
+    }
+    correct = correct && tree.range(5, 4).empty();
+    std::cout << "迭代器与区间查询: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// visitor_test: 非递归的遍历与递归的结果相同; 退化成链表的树(高度远大于栈的内部容量)也可以遍历
+void visitor_test()
+{
+    IntTree tree;
+    std::srand(19);
+    for (int i = 0; i != 500; ++i)
+        tree.insert(std::make_shared<Node>(std::rand() % 200));
+    std::vector<int> expected, got;
+    preorder(tree.root, expected);
+    tree.preorder_visit([&got](const int &key){ got.push_back(key); });
+    bool correct = got == expected;
+    expected.clear();
+    got.clear();
+    postorder(tree.root, expected);
+    tree.postorder_visit([&got](const int &key){ got.push_back(key); });
+    correct = correct && got == expected;
+    // 递减插入得到一条向左的链
+    IntTree chain;
+    const int n = 3000;
+    for (int i = n; i != 0; --i)
+        chain.insert(std::make_shared<Node>(i));
+    long long sum = 0, order = 0;
+    int previous = 0;
+    chain.inorder_visit([&](const int &key){ sum += key; order += key == previous + 1; previous = key; });
+    int last = 0;
+    chain.postorder_visit([&last](const int &key){ last = key; });
+    std::size_t count = 0;
+    chain.range(100, 199, [&count](const int &){ ++count; });
+    correct = correct && sum == 1LL * n * (n + 1) / 2 && order == n && last == n && count == 100;
+    std::cout << "非递归遍历: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********tree iterator的迭代器测试********\n";
+    iterator_test();
+    std::cout << "********tree iterator的遍历测试********\n";
+    visitor_test();
+    return 0;
+}
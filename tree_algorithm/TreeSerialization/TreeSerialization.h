@@ -0,0 +1,281 @@
+/*************************************************************************
+	> File Name: TreeSerialization.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时52分42秒
+ ************************************************************************/
+
+#ifndef _TREESERIALIZATION_H
+#define _TREESERIALIZATION_H
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../NodeArena/NodeArena.h"
+#include "../RedBlackTreeNode/RedBlackTreeNode.h"
+#include "../TreeIterator/TreeIterator.h"
+// 共享指针链接的二叉树(BinaryTree, BinarySearchTree, RedBlackTree)的紧凑二进制序列化
+/*
+ * to_xml()对每个节点递归地建立ostringstream并拼接子树的字符串, 输出的代价随深度成平方增长, 也无法读回.
+ * save_tree按前序一次遍历把树写入std::ostream(文件或内存缓冲区), load_tree读回形状完全相同的树.
+ *
+ * 格式(整数都按本机字节序):
+ *      --头部: "TRS1", 字节序标记0x01020304, 关键字的字节数(变长的关键字为0), 是否保存颜色;
+ *      --若干个块: 节点个数c(1..64), 左孩子位图, 右孩子位图, [红色位图], 然后是c个关键字.
+ *        位图的第i位描述块中按前序的第i个节点, 每个节点只占2位(红黑树3位)的结构信息, 没有指针与下标;
+ *      --结束块: c = 0.
+ * 写的时候不需要预先知道节点数(RedBlackTree不记录大小), 每个块在内存中拼好以后一次写出.
+ *
+ * 读的时候先读出全部关键字与位图, 由arenaNodes一次创建所有节点(同一个NodeArena, 与build_from_sorted相同的批量路径),
+ * 再按前序与位图直接连接: 不比较关键字, 不旋转, 不重新着色, 时间复杂度O(n). 读回的树的形状与颜色和写出时相同,
+ * 所以红黑树仍然满足红黑性质, 二叉搜索树(包括退化成链表的)仍然是同样的形状.
+ * 数据不完整或格式错误时抛出std::runtime_error, 原有的树不变.
+ *
+ * 关键字由TreeKeyCodec编码: 可平凡复制的类型直接复制字节(一个块的关键字一次读出), std::string先写长度.
+ * 其它类型可以特化TreeKeyCodec. 节点是否保存颜色由TreeNodeColor决定(RedBlackTreeNode保存).
+*/
+
+// TreeKeyCodec: 关键字的编码, size为定长关键字的字节数(变长为0)
+template<typename KeyType, bool = std::is_trivially_copyable<KeyType>::value>
+struct TreeKeyCodec;
+template<typename KeyType>
+struct TreeKeyCodec<KeyType, true>
+{
+    static const std::uint32_t size = sizeof(KeyType);
+    static void write(std::string &buffer, const KeyType &key)
+    {
+        buffer.append(reinterpret_cast<const char *>(&key), sizeof(KeyType));
+    }
+    // read: 读出count个连续的关键字
+    static bool read(std::istream &is, KeyType *keys, std::size_t count)
+    {
+        return static_cast<bool>(is.read(reinterpret_cast<char *>(keys), count * sizeof(KeyType)));
+    }
+};
+template<>
+struct TreeKeyCodec<std::string, false>
+{
+    static const std::uint32_t size = 0;
+    static void write(std::string &buffer, const std::string &key)
+    {
+        std::uint32_t length = static_cast<std::uint32_t>(key.size());
+        buffer.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        buffer.append(key);
+    }
+    static bool read(std::istream &is, std::string *keys, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i){
+            std::uint32_t length = 0;
+            if (!is.read(reinterpret_cast<char *>(&length), sizeof(length)))
+                return false;
+            keys[i].resize(length);
+            if (length != 0 && !is.read(&keys[i][0], length))
+                return false;
+        }
+        return true;
+    }
+};
+
+// TreeNodeColor: 节点的颜色是否需要保存, 以及读写颜色
+template<typename NodeType>
+struct TreeNodeColor
+{
+    static const bool stored = false;
+    static bool red(const NodeType &) { return false; }
+    static void set(NodeType &, bool) {  }
+};
+template<typename KeyType>
+struct TreeNodeColor<RedBlackTreeNode<KeyType>>
+{
+    static const bool stored = true;
+    static bool red(const RedBlackTreeNode<KeyType> &node) { return node.color == RED; }
+    static void set(RedBlackTreeNode<KeyType> &node, bool red) { node.color = red ? RED : BLACK; }
+};
+
+namespace tree_serial_detail
+{
+const char magic[4] = {'T', 'R', 'S', '1'};
+const std::uint32_t byte_order = 0x01020304;
+const unsigned block_nodes = 64;    // 一个块中的节点个数, 位图是一个64位的字
+
+template<typename T>
+void append(std::string &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+template<typename T>
+bool readValue(std::istream &is, T &value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+// Block: 写出时一个块的内容, 关键字已经编码在keys中
+struct Block
+{
+    Block() : count(0), left(0), right(0), red(0) {  }
+    std::uint32_t count;
+    std::uint64_t left, right, red;
+    std::string keys;
+};
+inline void flush(std::ostream &os, Block &block, bool colored)
+{
+    std::string bitmaps;
+    append(bitmaps, block.count);
+    append(bitmaps, block.left);
+    append(bitmaps, block.right);
+    if (colored)
+        append(bitmaps, block.red);
+    os.write(bitmaps.data(), static_cast<std::streamsize>(bitmaps.size()));
+    os.write(block.keys.data(), static_cast<std::streamsize>(block.keys.size()));
+    block.count = 0;
+    block.left = block.right = block.red = 0;
+    block.keys.clear();
+}
+
+// save: 按前序写出以root为根的树
+template<typename NodeType>
+void save(const std::shared_ptr<NodeType> &root, std::ostream &os)
+{
+    typedef typename NodeType::KeyType KeyType;
+    typedef TreeNodeColor<NodeType> Color;
+    std::string header(magic, sizeof(magic));
+    append(header, byte_order);
+    std::uint32_t keySize = TreeKeyCodec<KeyType>::size;
+    append(header, keySize);
+    append(header, static_cast<std::uint32_t>(Color::stored));
+    os.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    Block block;
+    TreeStack<const NodeType *> stack;
+    if (root)
+        stack.push(root.get());
+    while (!stack.empty()){
+        const NodeType *node = stack.pop();
+        std::uint64_t bit = std::uint64_t(1) << block.count;
+        if (node->lchild) block.left |= bit;
+        if (node->rchild) block.right |= bit;
+        if (Color::red(*node)) block.red |= bit;
+        TreeKeyCodec<KeyType>::write(block.keys, node->key);
+        if (++block.count == block_nodes)
+            flush(os, block, Color::stored);
+        // 先压入右孩子, 左子树先于右子树出栈
+        if (node->rchild) stack.push(node->rchild.get());
+        if (node->lchild) stack.push(node->lchild.get());
+    }
+    if (block.count != 0)
+        flush(os, block, Color::stored);
+    std::uint32_t end = 0;
+    os.write(reinterpret_cast<const char *>(&end), sizeof(end));
+    if (!os)
+        throw std::runtime_error("save_tree() failed to write the stream!!!");
+}
+
+// load: 读出一棵树并返回它的根, 格式错误时抛出std::runtime_error
+template<typename NodeType>
+std::shared_ptr<NodeType> load(std::istream &is)
+{
+    typedef typename NodeType::KeyType KeyType;
+    typedef TreeNodeColor<NodeType> Color;
+    char tag[sizeof(magic)];
+    std::uint32_t order = 0, keySize = 0, colored = 0;
+    if (!is.read(tag, sizeof(tag)) || std::memcmp(tag, magic, sizeof(magic)) != 0 ||
+        !readValue(is, order) || !readValue(is, keySize) || !readValue(is, colored))
+        throw std::runtime_error("load_tree() found no tree header!!!");
+    if (order != byte_order)
+        throw std::runtime_error("load_tree() cannot read a tree written with another byte order!!!");
+    if (keySize != TreeKeyCodec<KeyType>::size || colored != static_cast<std::uint32_t>(Color::stored))
+        throw std::runtime_error("load_tree() found a tree of another key or node type!!!");
+
+    std::vector<KeyType> keys;
+    std::vector<std::uint64_t> left, right, red;
+    for (;;){
+        std::uint32_t count = 0;
+        std::uint64_t l = 0, r = 0, c = 0;
+        if (!readValue(is, count))
+            throw std::runtime_error("load_tree() found a truncated tree!!!");
+        if (count == 0)
+            break;
+        // 只有最后一个块可以不满
+        if (count > block_nodes || keys.size() % block_nodes != 0)
+            throw std::runtime_error("load_tree() found a corrupt tree structure!!!");
+        if (!readValue(is, l) || !readValue(is, r) || (Color::stored && !readValue(is, c)))
+            throw std::runtime_error("load_tree() found a truncated tree!!!");
+        std::size_t old = keys.size();
+        keys.resize(old + count);
+        if (!TreeKeyCodec<KeyType>::read(is, &keys[old], count))
+            throw std::runtime_error("load_tree() found a truncated tree!!!");
+        left.push_back(l);
+        right.push_back(r);
+        red.push_back(c);
+    }
+
+    auto nodes = arenaNodes<NodeType>(keys.begin(), keys.end());
+    std::vector<KeyType>().swap(keys);
+    // pendingLeft: 下一个节点是它的左孩子(没有时为nodes.size()); rights: 还在等待右孩子的节点的下标
+    std::size_t pendingLeft = nodes.size();
+    std::vector<std::size_t> rights;
+    for (std::size_t i = 0; i != nodes.size(); ++i){
+        if (i != 0){
+            std::size_t parent = pendingLeft;
+            if (parent != nodes.size())
+                nodes[parent]->lchild = nodes[i];
+            else if (!rights.empty()){
+                parent = rights.back();
+                rights.pop_back();
+                nodes[parent]->rchild = nodes[i];
+            }else
+                throw std::runtime_error("load_tree() found a corrupt tree structure!!!");
+            nodes[i]->parent = nodes[parent];
+        }
+        std::uint64_t bit = std::uint64_t(1) << (i % block_nodes);
+        Color::set(*nodes[i], (red[i / block_nodes] & bit) != 0);
+        if (right[i / block_nodes] & bit)
+            rights.push_back(i);
+        pendingLeft = (left[i / block_nodes] & bit) ? i : nodes.size();
+    }
+    if (pendingLeft != nodes.size() || !rights.empty())
+        throw std::runtime_error("load_tree() found a corrupt tree structure!!!");
+    return nodes.empty() ? std::shared_ptr<NodeType>() : nodes[0];
+}
+}   // namespace tree_serial_detail
+
+// save_tree: 把树(有root成员)按前序写入os, 一次遍历, O(n); 写失败时抛出std::runtime_error
+template<typename Tree>
+void save_tree(const Tree &tree, std::ostream &os)
+{
+    tree_serial_detail::save(tree.root, os);
+}
+// load_tree: 从is读出save_tree写出的树并替换tree中原有的树, O(n); 格式错误时抛出std::runtime_error, 原有的树不变
+template<typename Tree>
+void load_tree(Tree &tree, std::istream &is)
+{
+    typedef typename std::remove_reference<decltype(*tree.root)>::type NodeType;
+    tree.root = tree_serial_detail::load<NodeType>(is);
+}
+// save_tree_file, load_tree_file: 写入或读出文件
+template<typename Tree>
+void save_tree_file(const Tree &tree, const std::string &path)
+{
+    std::ofstream os(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!os)
+        throw std::runtime_error("save_tree_file() cannot open " + path + "!!!");
+    save_tree(tree, os);
+    os.close();
+    if (!os)
+        throw std::runtime_error("save_tree_file() failed to write " + path + "!!!");
+}
+template<typename Tree>
+void load_tree_file(Tree &tree, const std::string &path)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    if (!is)
+        throw std::runtime_error("load_tree_file() cannot open " + path + "!!!");
+    load_tree(tree, is);
+}
+#endif
@@ -0,0 +1,85 @@
+/*************************************************************************
+	> File Name: TreeSerialization_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时55分25秒
+ ************************************************************************/
+// RedBlackTree的to_xml与save_tree/load_tree的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [关键字个数(默认1000000)] [to_xml的最大关键字个数(默认100000)]
+ *      随机插入n个关键字, 然后把树写入内存缓冲区再读回.
+ *
+ * 输出的每一行: method,n,ns_per_key,bytes
+ *      --to_xml: 生成整棵树的xml字符串(n不超过第二个参数时才运行, 它的代价随深度增长);
+ *      --save_tree: 写入std::ostringstream;
+ *      --load_tree: 从缓冲区读回(批量创建节点, 按位图连接);
+ *      --insert_reload: 读出同样的关键字后逐个insert重新建树, 是没有序列化格式时的做法.
+ *
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "TreeSerialization.h"
+#include "../RedBlackTree/RedBlackTree.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef RedBlackTree<RedBlackTreeNode<int>> Tree;
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t xmlLimit = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    std::vector<int> keys(n);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (auto &key : keys){
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = static_cast<int>(state >> 33);
+    }
+    Tree tree;
+    for (int key : keys)
+        tree.insert(std::make_shared<RedBlackTreeNode<int>>(key));
+
+    std::cout << "method,n,ns_per_key,bytes\n";
+    if (n <= xmlLimit){
+        auto begin = Clock::now();
+        std::string xml = tree.root->to_xml();
+        double ns = nanosecondsSince(begin, n);
+        std::cout << "to_xml," << n << ',' << ns << ',' << xml.size() << '\n';
+    }
+    std::ostringstream os;
+    auto begin = Clock::now();
+    save_tree(tree, os);
+    double saveNs = nanosecondsSince(begin, n);
+    std::string data = os.str();
+    std::cout << "save_tree," << n << ',' << saveNs << ',' << data.size() << '\n';
+
+    {
+        Tree copy;
+        std::istringstream is(data);
+        begin = Clock::now();
+        load_tree(copy, is);
+        double ns = nanosecondsSince(begin, n);
+        std::cout << "load_tree," << n << ',' << ns << ',' << data.size() << '\n';
+    }
+    {
+        Tree copy;
+        begin = Clock::now();
+        for (int key : keys)
+            copy.insert(std::make_shared<RedBlackTreeNode<int>>(key));
+        double ns = nanosecondsSince(begin, n);
+        std::cout << "insert_reload," << n << ',' << ns << ',' << n * sizeof(int) << '\n';
+    }
+    return 0;
+}
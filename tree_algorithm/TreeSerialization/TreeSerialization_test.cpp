@@ -0,0 +1,159 @@
+/*************************************************************************
+	> File Name: TreeSerialization_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 09时58分08秒
+ ************************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "TreeSerialization.h"
+#include "../binarytree/binarytree.h"
+#include "../binary_search_tree/binary_search_tree.h"
+#include "../RedBlackTree/RedBlackTree.h"
+typedef RedBlackTreeNode<int> RBNode;
+typedef BinaryTreeNode<int> BNode;
+
+// sameShape: 两棵树的形状, 关键字与颜色都相同, 且读回的树的parent指针正确
+template<typename NodeType>
+bool sameShape(const NodeType *a, const NodeType *b, const NodeType *parent)
+{
+    if (!a || !b)
+        return a == b;
+    if (!(a->key == b->key) || TreeNodeColor<NodeType>::red(*a) != TreeNodeColor<NodeType>::red(*b) ||
+        b->parent.lock().get() != parent)
+        return false;
+    return sameShape(a->lchild.get(), b->lchild.get(), b) && sameShape(a->rchild.get(), b->rchild.get(), b);
+}
+template<typename Tree>
+bool roundTrip(const Tree &tree, Tree &copy)
+{
+    std::stringstream buffer;
+    save_tree(tree, buffer);
+    load_tree(copy, buffer);
+    return sameShape(tree.root.get(), copy.root.get(), static_cast<decltype(tree.root.get())>(nullptr));
+}
+// blackHeight: 检查红黑性质与关键字的次序, 返回黑高(不满足时返回-1)
+int blackHeight(const RBNode *node)
+{
+    if (!node)
+        return 0;
+    const RBNode *l = node->lchild.get(), *r = node->rchild.get();
+    if ((l && node->key < l->key) || (r && r->key < node->key))
+        return -1;
+    if (node->color == RED && ((l && l->color == RED) || (r && r->color == RED)))
+        return -1;
+    int lh = blackHeight(l), rh = blackHeight(r);
+    if (lh < 0 || lh != rh)
+        return -1;
+    return lh + (node->color == BLACK ? 1 : 0);
+}
+
+// binary_tree_test: 任意形状的二叉树与退化成链表的二叉搜索树读回以后形状不变
+void binary_tree_test()
+{
+    bool correct = true;
+    BinaryTree<BNode> tree, copy;
+    correct = correct && roundTrip(tree, copy) && !copy.root;
+    // 一棵随机形状的树: 每个新节点挂到随机的空位置上
+    std::srand(5);
+    std::vector<std::shared_ptr<BNode>> nodes;
+    for (int i = 0; i != 1000; ++i){
+        auto node = std::make_shared<BNode>(i);
+        if (nodes.empty())
+            tree.root = node;
+        else{
+            for (;;){
+                auto &parent = nodes[std::rand() % nodes.size()];
+                auto &slot = std::rand() % 2 ? parent->lchild : parent->rchild;
+                if (!slot){
+                    slot = node;
+                    node->parent = parent;
+                    break;
+                }
+            }
+        }
+        nodes.push_back(node);
+    }
+    correct = correct && roundTrip(tree, copy);
+
+    BinarySearchTree<BNode> chain, chainCopy;
+    for (int i = 0; i != 5000; ++i)
+        chain.insert(std::make_shared<BNode>(i));
+    correct = correct && roundTrip(chain, chainCopy) && chainCopy.search(BNode(4321)) &&
+              chainCopy.root->lchild == nullptr;
+    std::cout << "二叉树与二叉搜索树的形状: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// red_black_tree_test: 红黑树读回以后形状与颜色不变, 仍然满足红黑性质; 字符串关键字与文件
+void red_black_tree_test()
+{
+    bool correct = true;
+    RedBlackTree<RBNode> tree, copy;
+    std::srand(11);
+    for (int i = 0; i != 20000; ++i)
+        tree.insert(std::make_shared<RBNode>(std::rand() % 5000));
+    correct = correct && roundTrip(tree, copy) && blackHeight(copy.root.get()) > 0;
+    copy.insert(std::make_shared<RBNode>(-1));
+    correct = correct && blackHeight(copy.root.get()) > 0 && *copy.begin() == -1;
+
+    RedBlackTree<RedBlackTreeNode<std::string>> words, wordsCopy;
+    for (int i = 0; i != 300; ++i)
+        words.insert(std::make_shared<RedBlackTreeNode<std::string>>(std::string(i % 7, 'a') + std::to_string(i)));
+    correct = correct && roundTrip(words, wordsCopy);
+
+    const std::string path = "TreeSerialization_test.bin";
+    save_tree_file(tree, path);
+    RedBlackTree<RBNode> fromFile;
+    load_tree_file(fromFile, path);
+    std::remove(path.c_str());
+    correct = correct && sameShape(tree.root.get(), fromFile.root.get(), static_cast<const RBNode *>(nullptr));
+    std::cout << "红黑树的形状与颜色: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// corrupt_test: 截断的数据, 错误的节点类型与错误的结构抛出std::runtime_error, 原有的树不变
+template<typename Tree>
+bool rejects(Tree &tree, const std::string &data)
+{
+    auto old = tree.root;
+    std::istringstream is(data);
+    try{
+        load_tree(tree, is);
+    }catch (std::runtime_error &){
+        return tree.root == old;
+    }
+    return false;
+}
+void corrupt_test()
+{
+    RedBlackTree<RBNode> tree;
+    for (int i = 0; i != 200; ++i)
+        tree.insert(std::make_shared<RBNode>(i));
+    std::ostringstream os;
+    save_tree(tree, os);
+    std::string data = os.str();
+    RedBlackTree<RBNode> target;
+    target.insert(std::make_shared<RBNode>(7));
+    bool correct = rejects(target, "") && rejects(target, data.substr(0, data.size() - 1)) &&
+                   rejects(target, data.substr(0, data.size() / 2)) && rejects(target, "XXXX" + data.substr(4));
+    BinaryTree<BNode> plain;
+    correct = correct && rejects(plain, data);
+    // 把第一个块中根的左孩子位清除: 节点比结构中的位置多
+    std::string broken = data;
+    broken[20] = static_cast<char>(broken[20] & ~1);
+    correct = correct && rejects(target, broken) && target.root->key == 7;
+    std::cout << "错误的数据: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********tree serialization的测试********\n";
+    binary_tree_test();
+    red_black_tree_test();
+    corrupt_test();
+    return 0;
+}
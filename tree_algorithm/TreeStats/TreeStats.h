@@ -0,0 +1,205 @@
+/*************************************************************************
+	> File Name: TreeStats.h
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时01分04秒
+ ************************************************************************/
+
+#ifndef _TREESTATS_H
+#define _TREESTATS_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+// 共享指针链接的搜索树(RedBlackTree, BinarySearchTree)的统计信息, 与hash_table/hash_stats的做法相同
+/*
+ * 每棵树的stats()返回TreeStats, 分为两部分:
+ *      --结构统计: 调用stats()时遍历树得到(节点数, 高度, 黑高, 节点占用的字节数), 不调用stats()时没有任何代价;
+ *      --运行时计数: 左旋与右旋的次数, insert_fixup/delete_fixup循环的次数, 替罪羊树重建的次数与重新连接的节点数,
+ *        每次查找(search/lower_bound/upper_bound)与后继(successor)访问过的节点数的直方图. 只有在包含树的头文件之前
+ *        定义了宏TREE_STATS才收集, 否则TreeStatsCounters是空类, 记录函数都是空的内联函数, 编译以后不留下任何指令,
+ *        每棵树只多一个空的成员. 同一个程序的所有编译单元必须使用相同的设置.
+ *
+ * toJson()输出一个JSON对象, 可以直接交给监控系统: 例如旋转次数相对于插入次数突然增加, 或者高度远大于2lg(n + 1),
+ * 或者查找访问的节点数的平均值变大时报警.
+ *
+ */
+
+const std::size_t tree_stats_bins = 64;    // 直方图的格数, 最后一格统计不小于tree_stats_bins - 1的次数
+
+// TreeVisitHistogram: 每次操作访问过的节点数的直方图
+struct TreeVisitHistogram
+{
+    TreeVisitHistogram() : total(0), sum(0), max(0) { std::fill(counts, counts + tree_stats_bins, 0); }
+    void add(std::size_t visits)
+    {
+        ++counts[std::min(visits, tree_stats_bins - 1)];
+        ++total;
+        sum += visits;
+        max = std::max<std::uint64_t>(max, visits);
+    }
+    double mean() const { return total == 0 ? 0.0 : static_cast<double>(sum) / total; }
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\"count\":" << total << ",\"mean\":" << mean() << ",\"max\":" << max << ",\"bins\":[";
+        for (std::size_t i = 0; i != tree_stats_bins; ++i)
+            out << (i == 0 ? "" : ",") << counts[i];
+        out << "]}";
+    }
+
+    std::uint64_t counts[tree_stats_bins];  // counts[i]: 访问i个节点的次数
+    std::uint64_t total;                    // 总次数
+    std::uint64_t sum;                      // 访问的节点数之和
+    std::uint64_t max;                      // 最多访问的节点数
+};
+
+// TreeStats: 一棵树的统计信息
+struct TreeStats
+{
+    TreeStats()
+        : size(0), height(0), blackHeight(0), allocatedBytes(0), counting(false), leftRotations(0),
+          rightRotations(0), insertFixups(0), deleteFixups(0), rebuilds(0), rebuiltNodes(0) {  }
+    std::string toJson() const
+    {
+        std::ostringstream out;
+        out << "{\"size\":" << size << ",\"height\":" << height << ",\"black_height\":" << blackHeight
+            << ",\"allocated_bytes\":" << allocatedBytes << ",\"counting\":" << (counting ? "true" : "false")
+            << ",\"left_rotations\":" << leftRotations << ",\"right_rotations\":" << rightRotations
+            << ",\"insert_fixups\":" << insertFixups << ",\"delete_fixups\":" << deleteFixups
+            << ",\"rebuilds\":" << rebuilds << ",\"rebuilt_nodes\":" << rebuiltNodes << ",\"searches\":";
+        searches.writeJson(out);
+        out << ",\"successors\":";
+        successors.writeJson(out);
+        out << "}";
+        return out.str();
+    }
+
+    //*************************结构统计***********************************
+    std::size_t size;               // 节点数
+    std::size_t height;             // 高度(根到最深的叶子的节点数, 空树为0)
+    std::size_t blackHeight;        // 红黑树根的黑高(根到空叶子的路径上黑色节点的个数), 其它树为0
+    std::size_t allocatedBytes;     // 节点占用的字节数(每个节点一次分配, 包括shared_ptr的控制块)
+    //*************************运行时计数*********************************
+    bool counting;                  // 是否定义了TREE_STATS(为false时下面的计数都为0)
+    std::uint64_t leftRotations;    // left_rotate的次数
+    std::uint64_t rightRotations;   // right_rotate的次数
+    std::uint64_t insertFixups;     // insert_fixup中循环的次数
+    std::uint64_t deleteFixups;     // delete_fixup中循环的次数
+    std::uint64_t rebuilds;         // 替罪羊树重建子树的次数
+    std::uint64_t rebuiltNodes;     // 重建时重新连接的节点数
+    TreeVisitHistogram searches;    // 每次查找访问过的节点数
+    TreeVisitHistogram successors;  // 每次successor访问过的节点数
+};
+
+// TreeCountingAllocator: 只记录分配的字节数, 用于得到make_shared/arenaNodes一次分配一个节点的实际大小
+template<typename T>
+struct TreeCountingAllocator
+{
+    typedef T value_type;
+    explicit TreeCountingAllocator(std::size_t *b) : bytes(b) {  }
+    template<typename U>
+    TreeCountingAllocator(const TreeCountingAllocator<U> &other) : bytes(other.bytes) {  }
+    T* allocate(std::size_t n)
+    {
+        *bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+    template<typename U>
+    bool operator==(const TreeCountingAllocator<U> &other) const { return bytes == other.bytes; }
+    template<typename U>
+    bool operator!=(const TreeCountingAllocator<U> &other) const { return bytes != other.bytes; }
+    std::size_t *bytes;
+};
+// tree_node_bytes: 用allocate_shared创建一个节点时分配的字节数(节点与控制块), 每种节点类型只计算一次
+template<typename NodeType>
+std::size_t tree_node_bytes()
+{
+    static const std::size_t bytes = []{
+        std::size_t total = 0;
+        std::allocate_shared<NodeType>(TreeCountingAllocator<NodeType>(&total));
+        return total;
+    }();
+    return bytes;
+}
+
+// tree_shape_stats: 遍历以root为根的树, 填写结构统计(不递归)
+template<typename NodeType>
+void tree_shape_stats(const NodeType *root, TreeStats &stats)
+{
+    std::vector<std::pair<const NodeType *, std::size_t>> stack;
+    if (root)
+        stack.push_back(std::make_pair(root, std::size_t(1)));
+    while (!stack.empty()){
+        auto top = stack.back();
+        stack.pop_back();
+        ++stats.size;
+        stats.height = std::max(stats.height, top.second);
+        if (top.first->lchild) stack.push_back(std::make_pair(top.first->lchild.get(), top.second + 1));
+        if (top.first->rchild) stack.push_back(std::make_pair(top.first->rchild.get(), top.second + 1));
+    }
+    stats.allocatedBytes = stats.size * tree_node_bytes<NodeType>();
+}
+
+// TreeStatsCounters: 树的运行时计数
+#if defined(TREE_STATS)
+class TreeStatsCounters
+{
+public:
+    TreeStatsCounters()
+        : leftRotations(0), rightRotations(0), insertFixups(0), deleteFixups(0), rebuilds(0), rebuiltNodes(0) {  }
+    void recordLeftRotation() { ++leftRotations; }
+    void recordRightRotation() { ++rightRotations; }
+    void recordInsertFixup() { ++insertFixups; }
+    void recordDeleteFixup() { ++deleteFixups; }
+    void recordRebuild(std::size_t nodes) { ++rebuilds; rebuiltNodes += nodes; }
+    void recordSearch(std::size_t visits) const { searches.add(visits); }
+    void recordSuccessor(std::size_t visits) const { successors.add(visits); }
+    void exportTo(TreeStats &stats) const
+    {
+        stats.counting = true;
+        stats.leftRotations = leftRotations;
+        stats.rightRotations = rightRotations;
+        stats.insertFixups = insertFixups;
+        stats.deleteFixups = deleteFixups;
+        stats.rebuilds = rebuilds;
+        stats.rebuiltNodes = rebuiltNodes;
+        stats.searches = searches;
+        stats.successors = successors;
+    }
+    void resetCounters()
+    {
+        leftRotations = rightRotations = insertFixups = deleteFixups = rebuilds = rebuiltNodes = 0;
+        searches = successors = TreeVisitHistogram();
+    }
+private:
+    std::uint64_t leftRotations;
+    std::uint64_t rightRotations;
+    std::uint64_t insertFixups;
+    std::uint64_t deleteFixups;
+    std::uint64_t rebuilds;
+    std::uint64_t rebuiltNodes;
+    // lower_bound/upper_bound是const成员函数, 计数也要在其中修改
+    mutable TreeVisitHistogram searches;
+    mutable TreeVisitHistogram successors;
+};
+#else
+class TreeStatsCounters
+{
+public:
+    void recordLeftRotation() {  }
+    void recordRightRotation() {  }
+    void recordInsertFixup() {  }
+    void recordDeleteFixup() {  }
+    void recordRebuild(std::size_t) {  }
+    void recordSearch(std::size_t) const {  }
+    void recordSuccessor(std::size_t) const {  }
+    void exportTo(TreeStats &) const {  }
+    void resetCounters() {  }
+};
+#endif
+#endif
@@ -0,0 +1,88 @@
+/*************************************************************************
+	> File Name: TreeStats_test.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时03分47秒
+ ************************************************************************/
+// 开启运行时计数: 必须在包含任何树的头文件之前定义
+#define TREE_STATS
+#include <iostream>
+#include <memory>
+#include <string>
+#include "TreeStats.h"
+#include "../RedBlackTree/RedBlackTree.h"
+#include "../binary_search_tree/binary_search_tree.h"
+typedef RedBlackTreeNode<int> RBNode;
+typedef BinaryTreeNode<int> BNode;
+
+void histogram_test()
+{
+    TreeVisitHistogram histogram;
+    histogram.add(3);
+    histogram.add(3);
+    histogram.add(10);
+    histogram.add(1000);
+    bool correct = histogram.total == 4 && histogram.counts[3] == 2 && histogram.counts[10] == 1;
+    // 超出范围的次数计入最后一格, 但平均值与最大值使用实际的节点数
+    correct = correct && histogram.counts[tree_stats_bins - 1] == 1 && histogram.max == 1000 && histogram.mean() == 254;
+    TreeStats stats;
+    stats.size = 3;
+    stats.height = 2;
+    std::string json = stats.toJson();
+    correct = correct && json.find("\"height\":2") != std::string::npos && json.front() == '{' && json.back() == '}';
+    std::cout << "直方图与JSON: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// red_black_test: 有序插入引起旋转与insert_fixup循环; 查找与后继访问的节点数不超过树高
+void red_black_test()
+{
+    RedBlackTree<RBNode> tree;
+    const int n = 1000;
+    for (int i = 0; i != n; ++i)
+        tree.insert(std::make_shared<RBNode>(i));
+    TreeStats stats = tree.stats();
+    bool correct = stats.counting && stats.size == n && stats.height <= 20 && stats.blackHeight > 0 &&
+                   stats.blackHeight <= stats.height && stats.leftRotations > 0 && stats.insertFixups > 0 &&
+                   stats.allocatedBytes == n * tree_node_bytes<RBNode>() && tree_node_bytes<RBNode>() > sizeof(RBNode);
+    // 有序插入时新节点总在最右侧, 只有左旋
+    correct = correct && stats.rightRotations == 0 && stats.leftRotations < stats.insertFixups * 2;
+    tree.resetStats();
+    for (int i = 0; i != n; ++i)
+        tree.lower_bound(i);
+    tree.upper_bound(n);
+    std::size_t steps = 0;
+    for (auto node = tree.minimum(tree.root); node; node = tree.successor(node))
+        ++steps;
+    stats = tree.stats();
+    correct = correct && stats.leftRotations == 0 && stats.insertFixups == 0 && stats.searches.total == n + 1 &&
+              stats.searches.max == stats.height && stats.searches.mean() > 1 && stats.successors.total == steps &&
+              stats.successors.max <= stats.height + 1 && stats.successors.mean() < 4;
+    std::cout << "红黑树的运行时计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+// binary_search_test: 替罪羊树的重建次数, 查找访问的节点数
+void binary_search_test()
+{
+    BinarySearchTree<BNode, ScapegoatBalance<>> tree;
+    const int n = 4096;
+    for (int i = 0; i != n; ++i)
+        tree.insert(std::make_shared<BNode>(i));
+    TreeStats stats = tree.stats();
+    bool correct = stats.size == n && stats.blackHeight == 0 && stats.rebuilds > 0 &&
+                   stats.rebuiltNodes >= stats.rebuilds && stats.leftRotations == 0;
+    tree.resetStats();
+    for (int i = 0; i != n; ++i)
+        tree.search(BNode(i));
+    stats = tree.stats();
+    correct = correct && stats.rebuilds == 0 && stats.searches.total == n && stats.searches.max == stats.height;
+    std::cout << "二叉搜索树的运行时计数: " << (correct ? "正确" : "错误") << std::endl;
+}
+
+int main()
+{
+    std::cout << "********tree stats的测试********\n";
+    histogram_test();
+    red_black_test();
+    binary_search_test();
+    return 0;
+}
@@ -7,9 +7,17 @@
 
 #ifndef _BINARY_SEARCH_TREE_H
 #define _BINARY_SEARCH_TREE_H
+#include <algorithm>
+#include <cmath>
+#include <iostream>
 #include <memory>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
+#include "../NodeArena/NodeArena.h"
+#include "../TreeIterator/TreeIterator.h"
+#include "../TreeStats/TreeStats.h"
 #include "../binarytreeNode/binarytreeNode.h"
 // BinarySearchTree: 二叉搜索树  算法导论12章
 /*
@@ -18,15 +26,47 @@
  * 
  * 定理12.4: 一棵有n个不同关键字的随机构建二叉搜索树的期望高度为O(logn).
  * 节点值的是节点处存储的数据的值.
+ *
+ * 批量操作: build_from_sorted由有序的关键字在O(n)时间内建立高度最小的二叉搜索树; insert_many先排序一批关键字,
+ * 再与树中原有的节点一次归并成平衡的树. 它们创建的节点来自同一个NodeArena, 在内存中连续.
+ *
+ * 平衡策略(第二个模板参数, 接口不变):
+ *      --NoBalance(默认): insert从不调整, 与原来的行为相同. 有序插入时树退化成链表, search/minimum/remove为O(n);
+ *      --ScapegoatBalance<Num, Den>: 替罪羊树, alpha = Num / Den(默认2/3)的重量平衡. 节点不需要额外的字段.
+ *        插入后若新节点的深度超过log_{1/alpha}(q)(q为上一次整体重建以来节点数的最大值), 沿父节点向上找到
+ *        第一个size(child) > alpha * size(parent)的祖先(替罪羊), 把它的子树按中序重新连接成高度最小的子树;
+ *        删除后若节点数少于alpha * q, 重建整棵树. 重建只改变链接, 外部持有的shared_ptr仍然有效.
+ *        树高不超过log_{1/alpha}(n) + 1(alpha = 2/3时约为1.71 * lgn + 1, 关键字互不相同时), 插入与删除的均摊时间为O(logn).
+ *        根被直接赋值(例如load_tree)以后节点数可能不准, 下一次在根上的重建会重新计数.
+ * 析构时逐个释放只被树持有的节点, 退化成链表的树也不会因递归析构而栈溢出.
+ *
+ * 统计信息: stats()返回节点数, 高度与节点占用的字节数; 在包含本头文件之前定义TREE_STATS时还有替罪羊树重建的次数,
+ * search/lower_bound/upper_bound与successor访问的节点数(见TreeStats.h).
 */
-template<typename NodeType>
+// NoBalance: 不调整树的形状
+struct NoBalance
+{
+    static const bool enabled = false;
+    static const unsigned numerator = 1, denominator = 1;
+};
+// ScapegoatBalance: 替罪羊树的重量平衡, alpha = Numerator / Denominator, 要求1/2 < alpha < 1
+template<unsigned Numerator = 2, unsigned Denominator = 3>
+struct ScapegoatBalance
+{
+    static_assert(2 * Numerator > Denominator && Numerator < Denominator, "alpha must be in (1/2, 1)");
+    static const bool enabled = true;
+    static const unsigned numerator = Numerator, denominator = Denominator;
+};
+
+template<typename NodeType, typename BalancePolicy = NoBalance>
 class BinarySearchTree
 {
 public:
     //*******************************构造函数*****************************
     typedef typename NodeType::KeyType KeyType;   // 树的节点存储数据的类型
-    BinarySearchTree(): root(std::shared_ptr<NodeType>()) {  } // 默认构造函数
-    ~BinarySearchTree() = default; // 析构函数
+    BinarySearchTree(): root(std::shared_ptr<NodeType>()), count(0), maxCount(0) {  } // 默认构造函数
+    ~BinarySearchTree();    // 析构函数, 不递归地释放节点
+    std::size_t size() const { return count; }     // 通过本类的接口插入的节点数
     //*******************************成员函数*****************************
     bool insert(std::shared_ptr<NodeType>);    // 二叉搜索树的插入操作
     void preorderWalk(std::shared_ptr<NodeType>, bool (*)(KeyType));    // 前序遍历
@@ -39,11 +79,80 @@ public:
     std::shared_ptr<NodeType> predecessor(const std::shared_ptr<NodeType> &);   // 前驱操作
     void remove(std::shared_ptr<NodeType>); // 二叉搜索树的删除操作(整个二叉搜索树最最最难的部分)
     void transplant(std::shared_ptr<NodeType> &, std::shared_ptr<NodeType> &); // 二叉搜索树剪切操作
+    template<typename Iterator>
+    void build_from_sorted(Iterator, Iterator);     // 由有序的关键字建立平衡的二叉搜索树(替换原有的树), O(n)
+    template<typename Iterator>
+    void insert_many(Iterator, Iterator);   // 批量插入关键字, O(m logm + n)
+    //***************************迭代器与遍历(见TreeIterator.h)***********
+    typedef TreeIterator<NodeType> iterator;          // 按中序的双向迭代器, 关键字只读
+    typedef TreeIterator<NodeType> const_iterator;
+    iterator begin() const { return iterator(iterator::leftmost(root.get()), &root); }
+    iterator end() const { return iterator(nullptr, &root); }
+    iterator lower_bound(const KeyType &key) const
+    {
+        std::size_t visits = 0;
+        NodeType *node = tree_lower_bound(root.get(), key, &visits);
+        counters.recordSearch(visits);
+        return iterator(node, &root);
+    }
+    iterator upper_bound(const KeyType &key) const
+    {
+        std::size_t visits = 0;
+        NodeType *node = tree_upper_bound(root.get(), key, &visits);
+        counters.recordSearch(visits);
+        return iterator(node, &root);
+    }
+    // range: 关键字在闭区间[lo, hi]中的节点; 带f的版本对每个关键字调用f(key), 不使用引用计数
+    TreeRange<iterator> range(const KeyType &lo, const KeyType &hi) const
+    {
+        return hi < lo ? TreeRange<iterator>(end(), end()) : TreeRange<iterator>(lower_bound(lo), upper_bound(hi));
+    }
+    template<typename Function>
+    void range(const KeyType &lo, const KeyType &hi, Function f) const { visit_range(root.get(), lo, hi, f); }
+    // 非递归的中序/前序/后序遍历, 对每个关键字调用f(key)
+    template<typename Function>
+    void inorder_visit(Function f) const { visit_inorder(root.get(), f); }
+    template<typename Function>
+    void preorder_visit(Function f) const { visit_preorder(root.get(), f); }
+    template<typename Function>
+    void postorder_visit(Function f) const { visit_postorder(root.get(), f); }
+    //***************************统计信息(见TreeStats.h)*****************
+    TreeStats stats() const;
+    void resetStats() { counters.resetCounters(); }
     //*******************************数据结构*****************************
     std::shared_ptr<NodeType> root;     // 树的根节点,是一个指向节点类型的强引用
+private:
+    TreeStatsCounters counters;     // 运行时计数(定义TREE_STATS时)
+    std::size_t count;      // 节点数
+    std::size_t maxCount;   // 上一次整体重建以来节点数的最大值(替罪羊树的q)
+    static std::size_t subtree_size(const NodeType *);     // 子树的节点数
+    void rebuild(std::shared_ptr<NodeType>);    // 把以node为根的子树重新连接成高度最小的子树
+    void inorder_nodes(std::vector<std::shared_ptr<NodeType>>&, const NodeType*);   // 按中序取出子树中所有的节点
+    void link_all(const std::vector<std::shared_ptr<NodeType>>&);  // 用有序的节点替换整棵树
+    std::shared_ptr<NodeType> link_nodes(const std::vector<std::shared_ptr<NodeType>>&);  // 把有序的节点连接成子树
+    std::shared_ptr<NodeType> link_balanced(const std::vector<std::shared_ptr<NodeType>>&,
+                                            const std::vector<std::size_t>&, std::size_t, std::size_t);
 };
 
 //************************************成员函数体*************************************************
+// ~BinarySearchTree: 析构函数
+/*
+ * 节点之间由shared_ptr链接, 默认的析构会沿着子树递归释放, 退化成链表的树会栈溢出. 这里用显式的栈,
+ * 先取出只被树持有的节点(use_count() == 1)的孩子再释放它; 外部仍然持有的节点与它的子树保持不变.
+*/
+template<typename NodeType, typename BalancePolicy>
+BinarySearchTree<NodeType, BalancePolicy>::~BinarySearchTree()
+{
+    std::vector<std::shared_ptr<NodeType>> stack;
+    if (root.use_count() == 1)
+        stack.push_back(std::move(root));
+    while (!stack.empty()){
+        std::shared_ptr<NodeType> node = std::move(stack.back());
+        stack.pop_back();
+        if (node->lchild.use_count() == 1) stack.push_back(std::move(node->lchild));
+        if (node->rchild.use_count() == 1) stack.push_back(std::move(node->rchild));
+    }
+}
 // insert: 向二叉搜索树中插入节点
 /*
  * \parameter node: 待插入的节点;
@@ -54,10 +163,11 @@ public:
  *
  * 算法时间复杂度为: O(h),其中h为树的高度.
 */
-template<typename NodeType>
-bool BinarySearchTree<NodeType>::insert(std::shared_ptr<NodeType> node)
+template<typename NodeType, typename BalancePolicy>
+bool BinarySearchTree<NodeType, BalancePolicy>::insert(std::shared_ptr<NodeType> node)
 {
     bool sign = true;
+    std::size_t depth = 0;  // 新节点的深度
     if (!root)
         root = node;
     else{
@@ -66,6 +176,7 @@ bool BinarySearchTree<NodeType>::insert(std::shared_ptr<NodeType> node)
         auto temp_parent = std::shared_ptr<NodeType>();
         while (temp){
             temp_parent = temp;     // 指向父节点
+            ++depth;
             if (node->key < temp->key){
                 temp = temp->lchild; // 向左侧遍历
                 left = true;
@@ -80,6 +191,26 @@ bool BinarySearchTree<NodeType>::insert(std::shared_ptr<NodeType> node)
         if (left) temp_parent->lchild = node;
         else temp_parent->rchild = node;
     }
+    maxCount = std::max(maxCount, ++count);
+    if (BalancePolicy::enabled && depth > 1){
+        const double alpha = static_cast<double>(BalancePolicy::numerator) / BalancePolicy::denominator;
+        if (depth <= static_cast<std::size_t>(std::log(static_cast<double>(maxCount)) / -std::log(alpha)))
+            return sign;
+        // 向上寻找替罪羊: 第一个size(child) > alpha * size(parent)的祖先
+        const NodeType *child = node.get();
+        std::size_t childSize = 1;
+        for (auto parent = node->parent.lock(); parent; parent = parent->parent.lock()){
+            const NodeType *sibling = parent->lchild.get() == child ? parent->rchild.get() : parent->lchild.get();
+            std::size_t parentSize = childSize + subtree_size(sibling) + 1;
+            if (childSize * BalancePolicy::denominator > parentSize * BalancePolicy::numerator){
+                rebuild(parent);
+                return sign;
+            }
+            child = parent.get();
+            childSize = parentSize;
+        }
+        rebuild(root);      // 节点数不准(根被直接赋值过)时没有替罪羊, 重建整棵树并重新计数
+    }
     return sign;
 }
 // preorderWalk: 二叉搜索树的前序遍历
@@ -93,16 +224,12 @@ bool BinarySearchTree<NodeType>::insert(std::shared_ptr<NodeType> node)
  *          --对左子节点前序遍历;
  *          --对右子节点前序遍历;
  *  --先序遍历中输出根的关键字在其左右子树的关键字值之后.
- * 算法性能: 时间复杂度为O(N), 空间复杂度为O(N).
+ * 算法性能: 时间复杂度为O(N), 空间复杂度为O(h). 用显式的栈实现(见TreeIterator.h), 不递归.
 */
-template<typename NodeType>
-void BinarySearchTree<NodeType>::preorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::preorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
 {
-    if (temp){
-        action(temp->key);
-        if (temp->lchild) preorderWalk(temp->lchild, action);
-        if (temp->rchild) preorderWalk(temp->rchild, action);
-    }
+    visit_preorder(temp.get(), action);
 }
 // inorderWalk: 二叉树的中序遍历
 /*
@@ -115,16 +242,12 @@ void BinarySearchTree<NodeType>::preorderWalk(std::shared_ptr<NodeType> temp, bo
  *          --对本节点执行操作;
  *          --对右子节点前序遍历;
  *  --输出的子树根的关键字位于其左子树的关键字和右子树的关键字值之间.
- * 算法性能: 时间复杂度为O(N), 空间复杂度为O(N).
+ * 算法性能: 时间复杂度为O(N), 空间复杂度为O(h). 用显式的栈实现(见TreeIterator.h), 不递归.
  */
-template<typename NodeType>
-void BinarySearchTree<NodeType>::inorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::inorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
 {
-    if (temp){
-        if (temp->lchild) inorderWalk(temp->lchild, action);
-        action(temp->key);
-        if (temp->rchild) inorderWalk(temp->rchild,action);
-    }
+    visit_inorder(temp.get(), action);
 }
 // postorderWalk: 二叉树的后序遍历
 /*
@@ -137,16 +260,12 @@ void BinarySearchTree<NodeType>::inorderWalk(std::shared_ptr<NodeType> temp, boo
  *          --对右子节点后续遍历;
  *          --对本节点执行操作.
  *  --输出的根的关键字在其左右子树的关键字值之后.
- * 算法性能: 时间复杂度为O(N), 空间复杂度为O(N).
+ * 算法性能: 时间复杂度为O(N), 空间复杂度为O(h). 用显式的栈实现(见TreeIterator.h), 不递归.
 */
-template<typename NodeType>
-void BinarySearchTree<NodeType>::postorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::postorderWalk(std::shared_ptr<NodeType> temp, bool (*action)(KeyType))
 {
-    if (temp){
-        if (temp->lchild) postorderWalk(temp->lchild, action);
-        if (temp->rchild) postorderWalk(temp->rchild, action);
-        action(temp->key);
-    }
+    visit_postorder(temp.get(), action);
 }
 // minimum: 以node为节点子树的最小关键值元素
 /*
@@ -156,8 +275,8 @@ void BinarySearchTree<NodeType>::postorderWalk(std::shared_ptr<NodeType> temp, b
  *      二叉搜索树的性质保证了这样做能找到树中的最小值.
  * 算法复杂度: 时间复杂度为O(h),其中h为树的高度.
 */
-template<typename NodeType>
-std::shared_ptr<NodeType> BinarySearchTree<NodeType>::minimum(const std::shared_ptr<NodeType> &node)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType> BinarySearchTree<NodeType, BalancePolicy>::minimum(const std::shared_ptr<NodeType> &node)
 {
     auto temp = node;
     auto temp_parent = std::shared_ptr<NodeType>();
@@ -177,8 +296,8 @@ std::shared_ptr<NodeType> BinarySearchTree<NodeType>::minimum(const std::shared_
  *      二叉搜索树的性质保证这这样做能够找到树中的最大值.
  * 算法复杂度: 时间复杂度为O(h), 其中h为树的高度.
 */
-template<typename NodeType>
-std::shared_ptr<NodeType> BinarySearchTree<NodeType>::maximum(const std::shared_ptr<NodeType> &node)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType> BinarySearchTree<NodeType, BalancePolicy>::maximum(const std::shared_ptr<NodeType> &node)
 {
     auto temp = node;
     auto temp_parent = std::shared_ptr<NodeType>();
@@ -201,18 +320,22 @@ std::shared_ptr<NodeType> BinarySearchTree<NodeType>::maximum(const std::shared_
  *
  * 算法性能: 算法的时间复杂度为: O(h),其中h为树的高度.
 */
-template<typename NodeType>
-std::shared_ptr<NodeType> BinarySearchTree<NodeType>::search(const NodeType value)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType> BinarySearchTree<NodeType, BalancePolicy>::search(const NodeType value)
 {
     auto temp = root;
-    while (temp){
+    std::size_t visits = 0;     // 访问过的节点数
+    for (; temp; ++visits){
         if (value.key < temp->key)
             temp = temp->lchild;
         else if (value.key > temp->key)
             temp = temp->rchild;
-        else
+        else{
+            counters.recordSearch(visits + 1);
             return temp;
+        }
     }
+    counters.recordSearch(visits);
     if (!temp)
     std::cerr << "此二叉搜索树中未找到你要查询的元素!!!" << std::endl;
     return std::shared_ptr<NodeType>();
@@ -235,21 +358,28 @@ std::shared_ptr<NodeType> BinarySearchTree<NodeType>::search(const NodeType valu
  * 
  * 算法时间复杂度:O(h),空间复杂度O(1).其中h为树的高度.
 */
-template<typename NodeType>
-std::shared_ptr<NodeType> BinarySearchTree<NodeType>::successor(const std::shared_ptr<NodeType> &node)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType> BinarySearchTree<NodeType, BalancePolicy>::successor(const std::shared_ptr<NodeType> &node)
 {
     if (!node)
         throw std::invalid_argument("successor() should not be aplied on nullptr");
+    std::size_t visits = 1;     // 访问过的节点数(包括node)
     // 以右子节点为根的子树中的最小值节点就是'node'的后继节点
     if(node->rchild){
-        return minimum(node->rchild);
+        auto current = node->rchild;
+        for (++visits; current->lchild; ++visits)
+            current = current->lchild;
+        counters.recordSuccessor(visits);
+        return current;
     }
     auto shared_p = node->parent.lock();    // 取出父节点
     auto temp = node;
     while (shared_p && temp->is_right_child()){
+        ++visits;
         temp = shared_p;
         shared_p = shared_p->parent.lock();
     }
+    counters.recordSuccessor(visits + (shared_p ? 1 : 0));
     return shared_p;
 }
 // predecessor: 二叉搜索树指定节点的前驱节点
@@ -270,8 +400,8 @@ std::shared_ptr<NodeType> BinarySearchTree<NodeType>::successor(const std::share
  *
  * 算法时间复杂度: O(h), 空间复杂度O(1).其中h为树的高度.
 */
-template<typename NodeType>
-std::shared_ptr<NodeType> BinarySearchTree<NodeType>::predecessor(const std::shared_ptr<NodeType> &node)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType> BinarySearchTree<NodeType, BalancePolicy>::predecessor(const std::shared_ptr<NodeType> &node)
 {
     if (!node)
         throw std::invalid_argument("predecessor() should not be aplied on nullptr");
@@ -308,8 +438,8 @@ std::shared_ptr<NodeType> BinarySearchTree<NodeType>::predecessor(const std::sha
  *
  * 算法性能: 时间复杂度为:O(h), 空间复杂度为O(1). 其中h为树的高度.
 */
-template<typename NodeType>
-void BinarySearchTree<NodeType>::remove(std::shared_ptr<NodeType> node)
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::remove(std::shared_ptr<NodeType> node)
 {
     if (!node)
         throw std::invalid_argument("node remove is nullptr!!!");
@@ -323,6 +453,8 @@ void BinarySearchTree<NodeType>::remove(std::shared_ptr<NodeType> node)
     }
     if (temp.get() != node.get())
         throw std::invalid_argument("node removed must be in tree!!!");
+    if (count != 0)
+        --count;
     // 删除过程
     // node是一个叶子节点(直接删除)
     if ((!node->lchild) && (!node->rchild)){
@@ -361,6 +493,9 @@ void BinarySearchTree<NodeType>::remove(std::shared_ptr<NodeType> node)
         next_node->lchild = node->lchild;
         node->lchild->parent = next_node;
     }
+    // 替罪羊树: 删除了足够多的节点以后重建整棵树
+    if (BalancePolicy::enabled && root && count * BalancePolicy::denominator < maxCount * BalancePolicy::numerator)
+        rebuild(root);
 }
 // transplant: 二叉搜索树的剪切操作
 /*
@@ -371,8 +506,8 @@ void BinarySearchTree<NodeType>::remove(std::shared_ptr<NodeType> node)
  * 算法基本思想: 用一棵以node2为根的子树替换一棵以node1为根的子树时,节点node1的双亲就变成节点node2
  *               的双亲,并且最后node2成为node1的双亲相应的孩子.
 */
-template<typename NodeType>
-void BinarySearchTree<NodeType>::transplant(std::shared_ptr<NodeType> &node1, 
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::transplant(std::shared_ptr<NodeType> &node1, 
                                             std::shared_ptr<NodeType> &node2)
 {
     if (!node1)
@@ -391,4 +526,170 @@ void BinarySearchTree<NodeType>::transplant(std::shared_ptr<NodeType> &node1,
     if (node2)
         node2->parent = parent_ptr;    
 }
+// build_from_sorted: 由有序的关键字直接建立二叉搜索树
+/*
+ * \parameter first, last: 非递减的关键字序列(KeyType), Iterator至少是前向迭代器;
+ * \return void. 原有的树被替换; 序列无序时抛出std::invalid_argument, 原有的树不变.
+ *
+ * 算法基本思想: 按顺序为每个关键字创建节点(来自同一个NodeArena), 取中间的节点为根, 两侧递归建立左右子树,
+ *      关键字互不相同时树的高度为floor(lgn). insert把相等的关键字放到右侧, remove与search也依赖
+ *      "左子树的关键字严格小于节点"这一性质, 所以根取中间节点所在的相等关键字段的第一个, 重复的关键字很多时树会变高.
+ * 算法性能: 时间复杂度为O(n), 逐个insert有序的关键字会得到一条链, 需要O(n^2).
+*/
+template<typename NodeType, typename BalancePolicy>
+template<typename Iterator>
+void BinarySearchTree<NodeType, BalancePolicy>::build_from_sorted(Iterator first, Iterator last)
+{
+    auto nodes = arenaNodes<NodeType>(first, last);
+    for (std::size_t i = 1; i < nodes.size(); ++i)
+        if (nodes[i]->key < nodes[i - 1]->key)
+            throw std::invalid_argument("build_from_sorted() should be applied on sorted keys!!!");
+    link_all(nodes);
+}
+// insert_many: 批量插入关键字
+/*
+ * \parameter first, last: 任意次序的关键字;
+ * \return void.
+ *
+ * 算法基本思想: 复制并排序这一批关键字(m个), 按顺序创建节点. 若m * lg(n + m) < n, 逐个insert;
+ *      否则按中序取出原有的n个节点, 与新节点归并(相等的关键字原有的在前), 再像build_from_sorted一样重新连接.
+ *      原有的节点对象保留(外部持有的shared_ptr仍然有效), 只改变链接. 批量插入同时把树重新平衡.
+ * 算法性能: 时间复杂度为O(mlogm + n + m).
+*/
+template<typename NodeType, typename BalancePolicy>
+template<typename Iterator>
+void BinarySearchTree<NodeType, BalancePolicy>::insert_many(Iterator first, Iterator last)
+{
+    std::vector<KeyType> keys(first, last);
+    if (keys.empty())
+        return;
+    std::sort(keys.begin(), keys.end());
+    auto batch = arenaNodes<NodeType>(keys.begin(), keys.end());
+    std::vector<std::shared_ptr<NodeType>> nodes;
+    inorder_nodes(nodes, root.get());
+    std::size_t total = nodes.size() + batch.size(), lg = 0;
+    while ((total >> lg) > 1)
+        ++lg;
+    if (batch.size() * lg < nodes.size()){
+        for (auto &node : batch)
+            insert(node);
+        return;
+    }
+    std::vector<std::shared_ptr<NodeType>> merged;
+    merged.reserve(total);
+    std::merge(nodes.begin(), nodes.end(), batch.begin(), batch.end(), std::back_inserter(merged),
+               [](const std::shared_ptr<NodeType> &a, const std::shared_ptr<NodeType> &b){ return a->key < b->key; });
+    nodes.clear();
+    link_all(merged);
+}
+// inorder_nodes: 按中序把以top为根的子树中的节点放入nodes(显式的栈, 不递归)
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::inorder_nodes(std::vector<std::shared_ptr<NodeType>> &nodes,
+                                                              const NodeType *top)
+{
+    std::vector<NodeType *> stack;
+    NodeType *current = const_cast<NodeType *>(top);
+    while (current || !stack.empty()){
+        while (current){
+            stack.push_back(current);
+            current = current->lchild.get();
+        }
+        current = stack.back();
+        stack.pop_back();
+        // 取得current的shared_ptr: 根由root持有, 其它节点由父节点持有
+        auto parent = current->parent.lock();
+        nodes.push_back(!parent ? root : (parent->lchild.get() == current ? parent->lchild : parent->rchild));
+        current = current->rchild.get();
+    }
+}
+// link_all: 用有序的nodes重新建立整棵树
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::link_all(const std::vector<std::shared_ptr<NodeType>> &nodes)
+{
+    root = link_nodes(nodes);
+    count = maxCount = nodes.size();
+}
+// link_nodes: 断开nodes原有的链接, 把它们连接成高度最小的子树, 返回子树的根(根的parent为空)
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType>
+BinarySearchTree<NodeType, BalancePolicy>::link_nodes(const std::vector<std::shared_ptr<NodeType>> &nodes)
+{
+    // runStart[i]: 与nodes[i]相等的一段关键字中第一个的下标
+    std::vector<std::size_t> runStart(nodes.size());
+    for (std::size_t i = 0; i != nodes.size(); ++i){
+        runStart[i] = (i != 0 && !(nodes[i - 1]->key < nodes[i]->key)) ? runStart[i - 1] : i;
+        nodes[i]->lchild.reset();
+        nodes[i]->rchild.reset();
+    }
+    return link_balanced(nodes, runStart, 0, nodes.size());
+}
+// subtree_size: 以node为根的子树的节点数(显式的栈, 不递归)
+template<typename NodeType, typename BalancePolicy>
+std::size_t BinarySearchTree<NodeType, BalancePolicy>::subtree_size(const NodeType *node)
+{
+    std::size_t size = 0;
+    TreeStack<const NodeType *> stack;
+    if (node)
+        stack.push(node);
+    while (!stack.empty()){
+        node = stack.pop();
+        ++size;
+        if (node->lchild) stack.push(node->lchild.get());
+        if (node->rchild) stack.push(node->rchild.get());
+    }
+    return size;
+}
+// rebuild: 替罪羊树的重建, 把以top为根的子树按中序重新连接成高度最小的子树, 挂回原来的位置
+/*
+ * 重建整棵树时同时重新计数(count = maxCount = n). 时间复杂度为O(size(top)).
+*/
+template<typename NodeType, typename BalancePolicy>
+void BinarySearchTree<NodeType, BalancePolicy>::rebuild(std::shared_ptr<NodeType> top)
+{
+    auto parent = top->parent.lock();
+    std::vector<std::shared_ptr<NodeType>> nodes;
+    inorder_nodes(nodes, top.get());
+    counters.recordRebuild(nodes.size());
+    if (!parent){
+        link_all(nodes);
+        return;
+    }
+    bool left = parent->lchild == top;
+    auto subtree = link_nodes(nodes);
+    subtree->parent = parent;
+    (left ? parent->lchild : parent->rchild) = subtree;
+}
+// link_balanced: 把nodes[first, last)连接成子树, 返回子树的根(根的parent为空)
+/*
+ * 左子树递归建立(不超过一半的节点, 递归深度为O(logn)), 右子树用循环: 相等的关键字很多时右侧可能是一条长链.
+*/
+template<typename NodeType, typename BalancePolicy>
+std::shared_ptr<NodeType>
+BinarySearchTree<NodeType, BalancePolicy>::link_balanced(const std::vector<std::shared_ptr<NodeType>> &nodes,
+                                                         const std::vector<std::size_t> &runStart,
+                                                         std::size_t first, std::size_t last)
+{
+    std::shared_ptr<NodeType> top, parent;
+    while (first != last){
+        std::size_t mid = std::max(first, runStart[first + (last - first) / 2]);
+        auto node = nodes[mid];
+        node->lchild = link_balanced(nodes, runStart, first, mid);
+        if (node->lchild) node->lchild->parent = node;
+        node->parent = parent;
+        if (parent) parent->rchild = node;
+        else top = node;
+        parent = node;
+        first = mid + 1;
+    }
+    return top;
+}
+// stats: 统计信息(blackHeight为0)
+template<typename NodeType, typename BalancePolicy>
+TreeStats BinarySearchTree<NodeType, BalancePolicy>::stats() const
+{
+    TreeStats result;
+    tree_shape_stats(root.get(), result);
+    counters.exportTo(result);
+    return result;
+}
 #endif
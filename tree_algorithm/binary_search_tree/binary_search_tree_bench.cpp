@@ -0,0 +1,94 @@
+/*************************************************************************
+	> File Name: binary_search_tree_bench.cpp
+	> Author: ZhirunZheng
+	> Mail: jiangxizhengzhirun@163.com
+	> Created Time: 2026年10月14日 星期三 10时01分07秒
+ ************************************************************************/
+// BinarySearchTree在默认策略(NoBalance)与替罪羊树策略(ScapegoatBalance)下的对比, 以CSV格式输出
+/*
+ * 用法: ./Bench [最大关键字个数(默认256000)] [NoBalance有序插入的最大关键字个数(默认32000)]
+ *      n从1000开始每次乘4. 关键字按三种次序插入: sorted(递增), nearly_sorted(每100个中交换一对相邻的), random.
+ *      NoBalance在有序的输入下退化成链表, 插入是O(n^2), 所以只运行到第二个参数为止.
+ *
+ * 输出的每一行: policy,order,n,insert_ns,search_ns,height
+ *      --insert_ns: 每次插入的平均时间(包括make_shared分配节点);
+ *      --search_ns: 按随机次序查找所有关键字, 每次查找的平均时间;
+ *      --height: 插入以后树的高度(节点数), 与2lgn比较.
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "binary_search_tree.h"
+
+typedef std::chrono::steady_clock Clock;
+typedef BinaryTreeNode<int> Node;
+std::int64_t bench_sink = 0;    // 查找得到的关键字之和, 使编译器不能省略查找
+
+double nanosecondsSince(Clock::time_point begin, std::size_t operations)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / operations;
+}
+std::size_t height(const Node *node)
+{
+    std::size_t result = 0;
+    std::vector<std::pair<const Node *, std::size_t>> stack;
+    if (node)
+        stack.push_back(std::make_pair(node, 1));
+    while (!stack.empty()){
+        auto top = stack.back();
+        stack.pop_back();
+        result = std::max(result, top.second);
+        if (top.first->lchild) stack.push_back(std::make_pair(top.first->lchild.get(), top.second + 1));
+        if (top.first->rchild) stack.push_back(std::make_pair(top.first->rchild.get(), top.second + 1));
+    }
+    return result;
+}
+
+template<typename Tree>
+void run(const char *policy, const char *order, const std::vector<int> &keys, const std::vector<int> &probes)
+{
+    Tree tree;
+    auto begin = Clock::now();
+    for (int key : keys)
+        tree.insert(std::make_shared<Node>(key));
+    double insert_ns = nanosecondsSince(begin, keys.size());
+    begin = Clock::now();
+    for (int key : probes)
+        bench_sink += tree.search(Node(key))->key;
+    double search_ns = nanosecondsSince(begin, probes.size());
+    std::cout << policy << ',' << order << ',' << keys.size() << ',' << insert_ns << ',' << search_ns << ','
+              << height(tree.root.get()) << '\n';
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t maxN = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256000;
+    std::size_t unbalancedSortedMax = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32000;
+    std::cout << "policy,order,n,insert_ns,search_ns,height\n";
+    std::srand(1);
+    for (std::size_t n = 1000; n <= maxN; n *= 4){
+        std::vector<int> sorted(n);
+        for (std::size_t i = 0; i != n; ++i)
+            sorted[i] = static_cast<int>(i);
+        std::vector<int> nearly = sorted;
+        for (std::size_t i = 0; i + 1 < n; i += 100)
+            std::swap(nearly[i], nearly[i + 1]);
+        std::vector<int> random = sorted;
+        std::random_shuffle(random.begin(), random.end());
+        const std::vector<int> &probes = random;
+        const char *orders[] = {"sorted", "nearly_sorted", "random"};
+        const std::vector<int> *inputs[] = {&sorted, &nearly, &random};
+        for (int o = 0; o != 3; ++o){
+            if (o == 2 || n <= unbalancedSortedMax)
+                run<BinarySearchTree<Node>>("none", orders[o], *inputs[o], probes);
+            run<BinarySearchTree<Node, ScapegoatBalance<>>>("scapegoat", orders[o], *inputs[o], probes);
+        }
+    }
+    return bench_sink == 42 ? 1 : 0;
+}
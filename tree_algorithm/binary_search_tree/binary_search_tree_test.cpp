@@ -7,7 +7,13 @@
 
 #include <iostream>
 using std::cout;    using std::endl;
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <set>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 #include "../binarytreeNode/binarytreeNode.h"
 #include "binary_search_tree.h"
 typedef BinarySearchTree<BinaryTreeNode<int>> IntBinarySearchTree;
@@ -150,6 +156,138 @@ void remove_test()
         cout << endl;
     }
 }
+// height: 以node为根的子树的高度(空树为0), 同时检查父节点链接与"左子树严格小于, 右子树不小于"(不满足时返回-1)
+int height(const std::shared_ptr<Node> &node)
+{
+    if (!node)
+        return 0;
+    if ((node->lchild && (node->lchild->parent.lock() != node || !(node->lchild->key < node->key))) ||
+        (node->rchild && (node->rchild->parent.lock() != node || node->rchild->key < node->key)))
+        return -1;
+    int l = height(node->lchild), r = height(node->rchild);
+    return (l < 0 || r < 0) ? -1 : std::max(l, r) + 1;
+}
+template<typename Tree>
+std::vector<int> inorderKeys(Tree &tree)
+{
+    std::vector<int> keys;
+    if (!tree.root)
+        return keys;
+    for (auto node = tree.minimum(tree.root); node; node = tree.successor(node))
+        keys.push_back(node->key);
+    return keys;
+}
+// bulk_test: build_from_sorted与insert_many得到的树有序且平衡, 之后可以正常删除
+void bulk_test()
+{
+    bool correct = true;
+    std::vector<int> keys;
+    for (int i = 0; i != 1023; ++i)
+        keys.push_back(i);
+    IntBinarySearchTree tree;
+    tree.build_from_sorted(keys.begin(), keys.end());
+    correct = height(tree.root) == 10 && inorderKeys(tree) == keys && !tree.root->parent.lock();
+    std::srand(7);
+    for (int round = 0; round != 20; ++round){
+        std::vector<int> batch;
+        for (int i = 0, m = round % 2 == 0 ? 3 : 500; i != m; ++i)
+            batch.push_back(std::rand() % 300);     // 有许多相等的关键字
+        tree.insert_many(batch.begin(), batch.end());
+        keys.insert(keys.end(), batch.begin(), batch.end());
+        std::sort(keys.begin(), keys.end());
+        correct = correct && height(tree.root) > 0 && inorderKeys(tree) == keys;
+        // 删除一部分关键字(remove按关键字从根向下确认节点在树中)
+        for (int i = 0; i != 50; ++i){
+            Node value(keys[std::rand() % keys.size()]);
+            auto node = tree.search(value);
+            tree.remove(node);
+            keys.erase(std::lower_bound(keys.begin(), keys.end(), value.key));
+        }
+        correct = correct && height(tree.root) > 0 && inorderKeys(tree) == keys;
+    }
+    int unsorted[] = {2, 1};
+    try{
+        tree.build_from_sorted(unsorted, unsorted + 2);
+        correct = false;
+    }catch (const std::invalid_argument &){
+        correct = correct && inorderKeys(tree) == keys;
+    }
+    cout << "批量建立与批量插入: " << (correct ? "正确" : "错误") << endl;
+}
+// iterator_test: 迭代器与visitor遍历的结果和中序遍历的结果相同
+void iterator_test()
+{
+    std::vector<int> walked, visited;
+    normalTree.inorder_visit([&visited](const int &key){ visited.push_back(key); });
+    for (auto it = normalTree.begin(); it != normalTree.end(); ++it)
+        walked.push_back(*it);
+    bool correct = walked == visited && walked == std::vector<int>({2, 3, 4, 6, 7, 9, 13, 15, 17, 18, 20});
+    std::vector<int> ranged(normalTree.range(5, 15).begin(), normalTree.range(5, 15).end());
+    correct = correct && ranged == std::vector<int>({6, 7, 9, 13, 15}) && *normalTree.upper_bound(20 - 1) == 20;
+    cout << "迭代器与区间查询: " << (correct ? "正确" : "错误") << endl;
+}
+// balance_test: 替罪羊树平衡策略下有序插入的树高不超过2lgn, 随机插入与删除的结果与std::multiset相同;
+// 默认策略下一条很长的链可以正常析构
+void balance_test()
+{
+    typedef BinarySearchTree<Node, ScapegoatBalance<>> BalancedTree;
+    bool correct = true;
+    {
+        BalancedTree tree;
+        const int n = 100000;
+        std::vector<std::shared_ptr<Node>> held;    // 外部持有的节点在重建以后仍然有效
+        for (int i = 0; i != n; ++i){
+            auto node = std::make_shared<Node>(i);
+            if (i % 1000 == 0)
+                held.push_back(node);
+            tree.insert(node);
+        }
+        correct = height(tree.root) > 0 && height(tree.root) <= 2 * std::log2(n) && tree.size() == n;
+        for (auto &node : held)
+            correct = correct && tree.search(*node) == node;
+        for (int i = n - 1; i >= 0; i -= 3)
+            tree.insert(std::make_shared<Node>(i));     // 逆序插入相等的关键字
+        correct = correct && height(tree.root) > 0 && height(tree.root) <= 2 * std::log2(tree.size()) + 1;
+    }
+    {
+        BalancedTree tree;
+        std::multiset<int> reference;
+        std::vector<std::shared_ptr<Node>> nodes;
+        std::srand(13);
+        for (int i = 0; i != 20000; ++i){
+            if (nodes.empty() || std::rand() % 3 != 0){
+                auto node = std::make_shared<Node>(i % 2 ? i : std::rand() % 5000);
+                tree.insert(node);
+                reference.insert(node->key);
+                nodes.push_back(node);
+            }else{
+                std::size_t victim = std::rand() % nodes.size();
+                tree.remove(nodes[victim]);
+                reference.erase(reference.find(nodes[victim]->key));
+                nodes[victim] = nodes.back();
+                nodes.pop_back();
+            }
+        }
+        correct = correct && inorderKeys(tree) == std::vector<int>(reference.begin(), reference.end()) &&
+                  tree.size() == reference.size() && height(tree.root) > 0 &&
+                  height(tree.root) <= 2 * std::log2(tree.size()) + 1;
+    }
+    {
+        IntBinarySearchTree chain;
+        std::shared_ptr<Node> last;
+        for (int i = 0; i != 1000000; ++i){
+            auto node = std::make_shared<Node>(i);
+            if (last){
+                last->rchild = node;
+                node->parent = last;
+            }else
+                chain.root = node;
+            last = node;
+        }
+        last.reset();
+    }
+    cout << "平衡策略与长链的析构: " << (correct ? "正确" : "错误") << endl;
+}
 int main()
 {
     cout << "新建二叉搜索树是否成功: " << setUp() << endl;
@@ -162,8 +300,14 @@ int main()
     maximum_test();
     cout << "*****************二叉树的查询操作测试*************************\n";
     search_test();
+    cout << "*****************二叉树的迭代器测试***************************\n";
+    iterator_test();
     cout << "*****************二叉树的删除操作测试*************************\n";
     remove_test();
+    cout << "*****************二叉树的批量建立测试*************************\n";
+    bulk_test();
+    cout << "*****************二叉树的平衡策略测试*************************\n";
+    balance_test();
     return 0;
 }
 
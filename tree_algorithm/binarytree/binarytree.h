@@ -7,6 +7,7 @@
 
 #ifndef _BINARYTREE_H
 #define _BINARYTREE_H
+#include <functional>
 #include <memory>
 #include "../binarytreeNode/binarytreeNode.h"
 // BinataryTree: 二叉树, 算法导论10.4